@@ -0,0 +1,201 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "harness/benchmark.h"
+#include "lumos/concurrency/concurrency.h"
+
+namespace lumos
+{
+  namespace
+  {
+    using benchmark::doNotOptimize;
+    using benchmark::Runner;
+    using benchmark::Throughput;
+    using concurrency::MpmcRingBuffer;
+    using concurrency::SpscRingBuffer;
+
+    constexpr size_t kCapacity = 1024U;
+    constexpr size_t kBatchSize = 64U;
+
+    int64_t nowNs()
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 std::chrono::steady_clock::now().time_since_epoch())
+          .count();
+    }
+
+    // Push and pop on one thread, the cost of the operations themselves
+    // without any cache line transfer
+    template <typename Queue>
+    void benchmarkUncontended(Runner &runner, const std::string &name)
+    {
+      const size_t n = 1U << 16U;
+      const Throughput items = Throughput::items(static_cast<double>(n));
+      Queue queue(kCapacity);
+      std::vector<uint64_t> batch(kBatchSize);
+      std::iota(batch.begin(), batch.end(), 0U);
+      std::vector<uint64_t> popped(kBatchSize);
+
+      runner.run(name + "/single_thread/push_pop", items, [&]()
+                 {
+                   uint64_t sum = 0U;
+                   uint64_t value = 0U;
+                   for (size_t i = 0; i < n; ++i)
+                   {
+                     queue.tryPush(static_cast<uint64_t>(i));
+                     queue.tryPop(value);
+                     sum += value;
+                   }
+                   doNotOptimize(sum); });
+      runner.run(name + "/single_thread/batch_" + std::to_string(kBatchSize), items, [&]()
+                 {
+                   for (size_t i = 0; i < n; i += kBatchSize)
+                   {
+                     queue.tryPushBatch(batch.begin(), kBatchSize);
+                     queue.tryPopBatch(popped.begin(), kBatchSize);
+                   }
+                   doNotOptimize(popped.data()); });
+    }
+
+    // One producer and one consumer thread streaming n values, thread start
+    // up is amortized over the stream
+    template <typename Queue>
+    void benchmarkStreaming(Runner &runner, const std::string &name, const bool batched)
+    {
+      const size_t n = runner.isSmokeRun() ? 1000U : 1U << 18U;
+      const Throughput items = Throughput::items(static_cast<double>(n));
+      std::vector<uint64_t> values(n);
+      std::iota(values.begin(), values.end(), 0U);
+
+      runner.run(name + "/producer_consumer/" + (batched ? "batch_64" : "single"), items, [&]()
+                 {
+                   Queue queue(kCapacity);
+                   uint64_t sum = 0U;
+                   std::thread consumer([&]()
+                                        {
+                                          std::vector<uint64_t> popped(kBatchSize);
+                                          size_t received = 0U;
+                                          while (received < n)
+                                          {
+                                            if (batched)
+                                            {
+                                              const size_t count = queue.popBatch(popped.begin(), kBatchSize);
+                                              sum = std::accumulate(popped.begin(), popped.begin() + count, sum);
+                                              received += count;
+                                            }
+                                            else
+                                            {
+                                              sum += queue.pop();
+                                              ++received;
+                                            }
+                                          }
+                                        });
+                   if (batched)
+                   {
+                     for (size_t i = 0; i < n; i += kBatchSize)
+                     {
+                       queue.pushBatch(values.begin() + i, std::min(kBatchSize, n - i));
+                     }
+                   }
+                   else
+                   {
+                     for (const uint64_t value : values)
+                     {
+                       queue.push(value);
+                     }
+                   }
+                   consumer.join();
+                   doNotOptimize(sum); });
+    }
+
+    void benchmarkMpmcContended(Runner &runner, const size_t num_threads)
+    {
+      const size_t n_per_thread = runner.isSmokeRun() ? 1000U : 1U << 16U;
+      const Throughput items = Throughput::items(static_cast<double>(n_per_thread * num_threads));
+
+      runner.run("mpmc/producers_consumers_" + std::to_string(num_threads), items, [&]()
+                 {
+                   MpmcRingBuffer<uint64_t> queue(kCapacity);
+                   std::vector<std::thread> threads;
+                   std::vector<uint64_t> sums(num_threads, 0U);
+                   for (size_t t = 0; t < num_threads; ++t)
+                   {
+                     threads.emplace_back([&queue, n_per_thread]()
+                                          {
+                                            for (size_t i = 0; i < n_per_thread; ++i)
+                                            {
+                                              queue.push(static_cast<uint64_t>(i));
+                                            }
+                                          });
+                     threads.emplace_back([&queue, &sums, t, n_per_thread]()
+                                          {
+                                            for (size_t i = 0; i < n_per_thread; ++i)
+                                            {
+                                              sums[t] += queue.pop();
+                                            }
+                                          });
+                   }
+                   for (std::thread &thread : threads)
+                   {
+                     thread.join();
+                   }
+                   doNotOptimize(sums.data()); });
+    }
+
+    // Round trip through a pair of queues to a thread that echoes the
+    // timestamp back, half of each round trip is one sample
+    template <typename Queue>
+    void benchmarkLatency(Runner &runner, const std::string &name)
+    {
+      const size_t num_messages = runner.isSmokeRun() ? 100U : 20000U;
+      runner.runSamples(name + "/latency/one_way", Throughput{}, [&]()
+                        {
+                          Queue request(kCapacity);
+                          Queue response(kCapacity);
+                          std::thread echo([&]()
+                                           {
+                                             for (size_t i = 0; i < num_messages; ++i)
+                                             {
+                                               response.push(request.pop());
+                                             }
+                                           });
+                          std::vector<double> samples_ns;
+                          samples_ns.reserve(num_messages);
+                          for (size_t i = 0; i < num_messages; ++i)
+                          {
+                            request.push(nowNs());
+                            const int64_t sent = response.pop();
+                            samples_ns.push_back(0.5 * static_cast<double>(nowNs() - sent));
+                          }
+                          echo.join();
+                          return samples_ns; });
+    }
+  } // namespace
+} // namespace lumos
+
+int main(int argc, char **argv)
+{
+  lumos::benchmark::Runner runner(argc, argv);
+
+  using lumos::concurrency::MpmcRingBuffer;
+  using lumos::concurrency::SpscRingBuffer;
+
+  lumos::benchmarkUncontended<SpscRingBuffer<uint64_t>>(runner, "spsc");
+  lumos::benchmarkUncontended<MpmcRingBuffer<uint64_t>>(runner, "mpmc");
+  for (const bool batched : {false, true})
+  {
+    lumos::benchmarkStreaming<SpscRingBuffer<uint64_t>>(runner, "spsc", batched);
+    lumos::benchmarkStreaming<MpmcRingBuffer<uint64_t>>(runner, "mpmc", batched);
+  }
+  lumos::benchmarkMpmcContended(runner, 2U);
+  lumos::benchmarkMpmcContended(runner, 4U);
+  lumos::benchmarkLatency<SpscRingBuffer<int64_t>>(runner, "spsc");
+  lumos::benchmarkLatency<MpmcRingBuffer<int64_t>>(runner, "mpmc");
+
+  return runner.finish();
+}
@@ -0,0 +1,63 @@
+#include <random>
+#include <string>
+
+#include "harness/benchmark.h"
+#include "lumos/csv/csv.impl.h"
+#include "lumos/number_conversion/number_conversion.h"
+
+namespace
+{
+  using lumos::benchmark::doNotOptimize;
+  using lumos::benchmark::Runner;
+  using lumos::benchmark::Throughput;
+
+  // Header plus rows of an integer, a label, two doubles and a quoted free
+  // text field
+  CSVData randomTable(const size_t num_rows)
+  {
+    std::mt19937 rng(16U);
+    std::uniform_real_distribution<double> value(-1000.0, 1000.0);
+    CSVData data;
+    data.reserve(num_rows + 1U);
+    data.push_back({"id", "label", "x", "y", "comment"});
+    for (size_t i = 0; i < num_rows; ++i)
+    {
+      data.push_back({std::to_string(i), "label_" + std::to_string(i % 17U),
+                      lumos::internal::formatNumber(value(rng)), lumos::internal::formatNumber(value(rng)),
+                      i % 4U == 0U ? "contains, a comma" : "plain"});
+    }
+    return data;
+  }
+
+  void benchmarkTable(Runner &runner, const size_t num_rows)
+  {
+    const CSVData data = randomTable(num_rows);
+    const std::string text = writeCSVToString(data);
+    const Throughput bytes = Throughput::bytes(static_cast<double>(text.size()));
+    const std::string size = std::to_string(num_rows);
+
+    CSVConfig header_config;
+    header_config.has_header = true;
+
+    runner.run("read/" + size, bytes, [&]()
+               { doNotOptimize(readCSVFromString(text)); });
+    runner.run("read_typed/" + size, bytes, [&]()
+               { doNotOptimize(readCSVTypedFromString<int64_t, std::string, double, double, std::string>(
+                     text, header_config)); });
+    runner.run("write/" + size, bytes, [&]()
+               { doNotOptimize(writeCSVToString(data)); });
+
+    const std::string line = formatCSVLine(data[1]);
+    runner.run("parse_line", Throughput::bytes(static_cast<double>(line.size())), [&]()
+               { doNotOptimize(parseCSVLine(line)); });
+  }
+} // namespace
+
+int main(int argc, char **argv)
+{
+  Runner runner(argc, argv);
+
+  benchmarkTable(runner, 10000U);
+
+  return runner.finish();
+}
@@ -0,0 +1,145 @@
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "harness/benchmark.h"
+#include "lumos/math/estimation/estimation.h"
+
+namespace lumos
+{
+  namespace
+  {
+    using benchmark::doNotOptimize;
+    using benchmark::Runner;
+    using benchmark::Throughput;
+
+    constexpr double kDt = 0.01;
+
+    // Constant velocity model in D dimensions, state [p, v], positions measured
+    template <uint16_t D>
+    struct ConstantVelocityModel
+    {
+      static constexpr uint16_t N = 2 * D;
+
+      FixedSizeMatrix<double, N, N> F = unitMatrix<double, N, N>();
+      FixedSizeMatrix<double, N, N> Q = unitMatrix<double, N, N>() * 1e-3;
+      FixedSizeMatrix<double, D, N> H = zerosMatrix<double, D, N>();
+      FixedSizeMatrix<double, D, D> R = unitMatrix<double, D, D>() * 0.05;
+      FixedSizeMatrix<double, D, 1> z = zerosMatrix<double, D, 1>();
+
+      ConstantVelocityModel()
+      {
+        for (size_t i = 0; i < D; ++i)
+        {
+          F(i, D + i) = kDt;
+          H(i, i) = 1.0;
+          z(i, 0) = 0.1 * static_cast<double>(i + 1U);
+        }
+      }
+    };
+
+    template <uint16_t D>
+    void benchmarkKalmanFilters(Runner &runner)
+    {
+      constexpr uint16_t N = ConstantVelocityModel<D>::N;
+      const ConstantVelocityModel<D> model;
+      const FixedSizeMatrix<double, N, 1> x0 = zerosMatrix<double, N, 1>();
+      const FixedSizeMatrix<double, N, N> P0 = unitMatrix<double, N, N>();
+      const auto f = [&model](const FixedSizeMatrix<double, N, 1> &x)
+      { return FixedSizeMatrix<double, N, 1>(model.F * x); };
+      const auto h = [&model](const FixedSizeMatrix<double, N, 1> &x)
+      { return FixedSizeMatrix<double, D, 1>(model.H * x); };
+      const std::string size = "state_" + std::to_string(N) + "/measurement_" + std::to_string(D);
+
+      KalmanFilter<double, N> kf(x0, P0);
+      runner.run("kalman/predict_update/" + size, [&]()
+                 {
+                   kf.predict(model.F, model.Q);
+                   doNotOptimize(kf.update(model.z, model.H, model.R)); });
+
+      ExtendedKalmanFilter<double, N> ekf(x0, P0);
+      runner.run("ekf/predict_update/" + size, [&]()
+                 {
+                   ekf.predict(f, model.F, model.Q);
+                   doNotOptimize(ekf.update(model.z, h, model.H, model.R)); });
+
+      UnscentedKalmanFilter<double, N> ukf(x0, P0);
+      runner.run("ukf/predict_update/" + size, [&]()
+                 {
+                   doNotOptimize(ukf.predict(f, model.Q));
+                   doNotOptimize(ukf.update(model.z, h, model.R)); });
+    }
+
+    // 2D position and velocity, a noisy motion model and a Gaussian position
+    // likelihood
+    void benchmarkParticleFilter(Runner &runner, const size_t num_particles,
+                                 const size_t num_threads)
+    {
+      ParticleFilter<double, 4> pf(num_particles, 5489U, num_threads);
+      pf.initialize(
+          [](ParticleBlock<double, 4> &block)
+          {
+            std::normal_distribution<double> spread(0.0, 1.0);
+            for (size_t d = 0; d < 4; ++d)
+            {
+              for (size_t i = 0; i < block.size; ++i)
+              {
+                block.state[d][i] = spread(*block.rng);
+              }
+            }
+          });
+
+      const auto motion = [](ParticleBlock<double, 4> &block)
+      {
+        std::normal_distribution<double> noise(0.0, 0.01);
+        for (size_t i = 0; i < block.size; ++i)
+        {
+          block.state[0][i] += kDt * block.state[2][i];
+          block.state[1][i] += kDt * block.state[3][i];
+          block.state[2][i] += noise(*block.rng);
+          block.state[3][i] += noise(*block.rng);
+        }
+      };
+      const auto likelihood = [](ParticleBlock<double, 4> &block)
+      {
+        for (size_t i = 0; i < block.size; ++i)
+        {
+          const double dx = block.state[0][i] - 0.5;
+          const double dy = block.state[1][i] + 0.5;
+          block.log_weights[i] += -0.5 * (dx * dx + dy * dy);
+        }
+      };
+
+      const std::string suffix = std::to_string(num_particles) + "/threads_" + std::to_string(num_threads);
+      const Throughput particles = Throughput::items(static_cast<double>(num_particles));
+      runner.run("particle_filter/predict/" + suffix, particles, [&]()
+                 { pf.predict(motion); });
+      runner.run("particle_filter/update/" + suffix, particles, [&]()
+                 { doNotOptimize(pf.update(likelihood)); });
+      runner.run("particle_filter/resample_systematic/" + suffix, particles, [&]()
+                 { pf.resample(ResamplingScheme::Systematic); });
+      runner.run("particle_filter/step/" + suffix, particles, [&]()
+                 {
+                   pf.predict(motion);
+                   pf.update(likelihood);
+                   pf.resample();
+                   doNotOptimize(pf.getMean()); });
+    }
+  } // namespace
+} // namespace lumos
+
+int main(int argc, char **argv)
+{
+  lumos::benchmark::Runner runner(argc, argv);
+
+  lumos::benchmarkKalmanFilters<2>(runner);
+  lumos::benchmarkKalmanFilters<3>(runner);
+  for (const size_t num_particles : {10000U, 100000U})
+  {
+    lumos::benchmarkParticleFilter(runner, num_particles, 1U);
+    lumos::benchmarkParticleFilter(runner, num_particles, 0U);
+  }
+
+  return runner.finish();
+}
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "harness/benchmark.h"
+#include "lumos/math/fft/fft.impl.h"
+#include "lumos/math/fft/fft2d.impl.h"
+#include "lumos/math/fft/spectral.impl.h"
+#include "lumos/math/fft/stft.impl.h"
+
+namespace
+{
+  using lumos::benchmark::doNotOptimize;
+  using lumos::benchmark::Runner;
+  using lumos::benchmark::Throughput;
+
+  RealVector noisySine(const size_t n)
+  {
+    std::mt19937 rng(42U);
+    std::normal_distribution<double> noise(0.0, 0.1);
+    RealVector signal(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+      signal[i] = std::sin(0.05 * static_cast<double>(i)) + noise(rng);
+    }
+    return signal;
+  }
+
+  // The input is copied into the work buffer before every transform, an
+  // unnormalized forward transform repeated in place would overflow
+  template <typename T>
+  void benchmarkPlan(Runner &runner, const std::string &type, const size_t n)
+  {
+    const RealVector signal = noisySine(n);
+    std::vector<std::complex<T>> input(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+      input[i] = std::complex<T>(static_cast<T>(signal[i]), T(0));
+    }
+    std::vector<std::complex<T>> data(n);
+    const fft::BasicFFTPlan<T> plan(n);
+
+    // 5 n log2(n) is the conventional flop count of a radix-2 FFT
+    const double flops = 5.0 * static_cast<double>(n) * std::log2(static_cast<double>(n));
+    runner.run("fft/forward/" + type + "/" + std::to_string(n), Throughput::items(flops), [&]()
+               {
+                 std::copy(input.begin(), input.end(), data.begin());
+                 plan.forward(data.data());
+                 doNotOptimize(data.data()); });
+    runner.run("fft/inverse/" + type + "/" + std::to_string(n), Throughput::items(flops), [&]()
+               {
+                 std::copy(input.begin(), input.end(), data.begin());
+                 plan.inverse(data.data());
+                 doNotOptimize(data.data()); });
+  }
+
+  void benchmarkPlanCreation(Runner &runner, const size_t n)
+  {
+    runner.run("fft/plan/double/" + std::to_string(n), [n]()
+               { doNotOptimize(fft::FFTPlan(n)); });
+  }
+
+  void benchmarkFft2d(Runner &runner, const size_t n)
+  {
+    const RealVector signal = noisySine(n * n);
+    ComplexVector input(signal.begin(), signal.end());
+    ComplexVector data(n * n);
+    runner.run("fft2d/" + std::to_string(n) + "x" + std::to_string(n),
+               Throughput::items(static_cast<double>(n * n)), [&]()
+               {
+                 std::copy(input.begin(), input.end(), data.begin());
+                 fft::fft2d(data.data(), n, n);
+                 doNotOptimize(data.data()); });
+  }
+
+  void benchmarkStft(Runner &runner, const size_t frame_size)
+  {
+    const size_t num_samples = 1U << 16U;
+    const RealVector signal = noisySine(num_samples);
+    fft::StftConfig config;
+    config.frame_size = frame_size;
+    config.hop_size = frame_size / 4U;
+    fft::Stft stft(config);
+
+    runner.run("stft/" + std::to_string(frame_size) + "/hop_" + std::to_string(config.hop_size),
+               Throughput::items(static_cast<double>(num_samples)), [&]()
+               {
+                 stft.reset();
+                 double sum = 0.0;
+                 stft.process(signal, [&sum](const ComplexVector &spectrum)
+                              { sum += std::abs(spectrum[1]); });
+                 doNotOptimize(sum); });
+  }
+
+  void benchmarkWelch(Runner &runner, const size_t segment_size, const size_t num_threads)
+  {
+    const size_t num_samples = 1U << 17U;
+    const RealVector signal = noisySine(num_samples);
+    fft::WelchConfig config;
+    config.segment_size = segment_size;
+    config.overlap = segment_size / 2U;
+    config.num_threads = num_threads;
+
+    const std::string name = "welch/" + std::to_string(segment_size) + "/threads_" + std::to_string(num_threads);
+    const Throughput samples = Throughput::items(static_cast<double>(num_samples));
+
+    runner.run(name, samples, [&]()
+               { doNotOptimize(fft::welch_psd(signal, config)); });
+    fft::Welch welch(config);
+    runner.run(name + "/reused", samples, [&]()
+               { doNotOptimize(welch.psd(signal)); });
+  }
+
+  void benchmarkCorrelation(Runner &runner, const size_t n)
+  {
+    const RealVector x = noisySine(n);
+    const RealVector y(x.begin(), x.begin() + static_cast<std::ptrdiff_t>(n / 4U));
+    runner.run("correlate/" + std::to_string(n), Throughput::items(static_cast<double>(n)), [&]()
+               { doNotOptimize(fft::correlate_fft(x, y)); });
+  }
+} // namespace
+
+int main(int argc, char **argv)
+{
+  Runner runner(argc, argv);
+
+  for (const size_t n : {64U, 1024U, 4096U, 65536U})
+  {
+    benchmarkPlan<double>(runner, "double", n);
+    benchmarkPlan<float>(runner, "float", n);
+  }
+  benchmarkPlanCreation(runner, 4096U);
+  benchmarkFft2d(runner, 256U);
+  for (const size_t frame_size : {256U, 1024U})
+  {
+    benchmarkStft(runner, frame_size);
+  }
+  benchmarkWelch(runner, 256U, 1U);
+  benchmarkWelch(runner, 256U, 0U);
+  benchmarkCorrelation(runner, 1U << 14U);
+
+  return runner.finish();
+}
@@ -0,0 +1,205 @@
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "harness/benchmark.h"
+#include "lumos/math/math.h"
+
+namespace lumos
+{
+  namespace
+  {
+    using benchmark::doNotOptimize;
+    using benchmark::Runner;
+    using benchmark::Throughput;
+
+    constexpr double kSampleRate = 1000.0;
+
+    template <typename T>
+    std::vector<T> noisySignal(const size_t n)
+    {
+      std::mt19937 rng(7U);
+      std::normal_distribution<double> noise(0.0, 0.2);
+      std::vector<T> signal(n);
+      for (size_t i = 0; i < n; ++i)
+      {
+        signal[i] = static_cast<T>(std::sin(0.02 * static_cast<double>(i)) + noise(rng));
+      }
+      return signal;
+    }
+
+    template <typename T>
+    std::vector<T> convolve(const std::vector<T> &a, const std::vector<T> &b)
+    {
+      std::vector<T> result(a.size() + b.size() - 1U, T(0));
+      for (size_t i = 0; i < a.size(); ++i)
+      {
+        for (size_t j = 0; j < b.size(); ++j)
+        {
+          result[i + j] += a[i] * b[j];
+        }
+      }
+      return result;
+    }
+
+    // Low-pass of even order as one direct form filter, made of cascaded
+    // biquads
+    template <typename T>
+    IIRFilter<T> cascadedLowPass(const size_t order)
+    {
+      const IIRFilter<T> biquad = IIRFilter<T>::secondOrderLowPass(T(100), T(0.707), T(kSampleRate));
+      std::vector<T> b{T(1)};
+      std::vector<T> a{T(1)};
+      for (size_t i = 0; i < order / 2U; ++i)
+      {
+        b = convolve(b, biquad.getNumeratorCoefficients());
+        a = convolve(a, biquad.getDenominatorCoefficients());
+      }
+      return IIRFilter<T>(b, a);
+    }
+
+    template <typename T>
+    void benchmarkStreaming(Runner &runner, const std::string &type)
+    {
+      const size_t n = 1U << 16U;
+      const std::vector<T> input = noisySignal<T>(n);
+      std::vector<T> output(n);
+      const Throughput samples = Throughput::items(static_cast<double>(n));
+
+      for (const size_t order : {8U, 64U})
+      {
+        FIRFilter<T> fir = FIRFilter<T>::lowPass(order, T(100), T(kSampleRate));
+        runner.run("fir/" + type + "/order_" + std::to_string(order) + "/block", samples, [&]()
+                   {
+                     fir.filter(input.data(), output.data(), n);
+                     doNotOptimize(output.data()); });
+        runner.run("fir/" + type + "/order_" + std::to_string(order) + "/per_sample", samples, [&]()
+                   {
+                     T sum = T(0);
+                     for (const T x : input)
+                     {
+                       sum += fir.filter(x);
+                     }
+                     doNotOptimize(sum); });
+      }
+
+      IIRFilter<T> biquad = IIRFilter<T>::secondOrderLowPass(T(100), T(0.707), T(kSampleRate));
+      runner.run("iir/" + type + "/biquad/block", samples, [&]()
+                 {
+                   biquad.filter(input.data(), output.data(), n);
+                   doNotOptimize(output.data()); });
+      IIRFilter<T> sixth_order = cascadedLowPass<T>(6U);
+      runner.run("iir/" + type + "/order_6/block", samples, [&]()
+                 {
+                   sixth_order.filter(input.data(), output.data(), n);
+                   doNotOptimize(output.data()); });
+    }
+
+    void benchmarkOffline(Runner &runner)
+    {
+      const size_t n = 1U << 18U;
+      const std::vector<double> input = noisySignal<double>(n);
+      const Throughput samples = Throughput::items(static_cast<double>(n));
+      const FIRFilterd fir = FIRFilterd::lowPass(64U, 100.0, kSampleRate);
+      const IIRFilterd iir = cascadedLowPass<double>(4U);
+
+      runner.run("filtfilt/fir_64", samples, [&]()
+                 { doNotOptimize(filtfilt(fir, input)); });
+      runner.run("filtfilt/iir_order_4", samples, [&]()
+                 { doNotOptimize(filtfilt(iir, input)); });
+      runner.run("filter_parallel/fir_64", samples, [&]()
+                 { doNotOptimize(filterParallel(fir, input, 16384U)); });
+      runner.run("filtfilt_parallel/fir_64", samples, [&]()
+                 { doNotOptimize(filtfiltParallel(fir, input, 16384U)); });
+    }
+
+    void benchmarkResampler(Runner &runner)
+    {
+      const size_t n = 1U << 16U;
+      const Throughput samples = Throughput::items(static_cast<double>(n));
+
+      const std::vector<double> input = noisySignal<double>(n);
+      PolyphaseResamplerd resampler(2, 5);
+      std::vector<double> output(resampler.maxOutputSize(n));
+      runner.run("resampler/double/2_over_5", samples, [&]()
+                 { doNotOptimize(resampler.process(input.data(), n, output.data())); });
+      PolyphaseResamplerd interpolator = PolyphaseResamplerd::interpolator(4);
+      std::vector<double> interpolated(interpolator.maxOutputSize(n));
+      runner.run("resampler/double/interpolate_4", samples, [&]()
+                 { doNotOptimize(interpolator.process(input.data(), n, interpolated.data())); });
+
+      const std::vector<float> input_f = noisySignal<float>(n);
+      PolyphaseResamplerf resampler_f(2, 5);
+      std::vector<float> output_f(resampler_f.maxOutputSize(n));
+      runner.run("resampler/float/2_over_5", samples, [&]()
+                 { doNotOptimize(resampler_f.process(input_f.data(), n, output_f.data())); });
+    }
+
+    void benchmarkNonlinear(Runner &runner)
+    {
+      const size_t n = 1U << 16U;
+      const std::vector<double> input = noisySignal<double>(n);
+      std::vector<double> output(n);
+      const Throughput samples = Throughput::items(static_cast<double>(n));
+
+      MedianFilterd median(9U);
+      runner.run("median/9", samples, [&]()
+                 {
+                   median.filter(input.data(), output.data(), n);
+                   doNotOptimize(output.data()); });
+      SavitzkyGolayFilterd savitzky_golay(11U, 2U);
+      runner.run("savitzky_golay/11_2", samples, [&]()
+                 {
+                   savitzky_golay.filter(input.data(), output.data(), n);
+                   doNotOptimize(output.data()); });
+      HampelFilterd hampel(4U, 3.0);
+      runner.run("hampel/4", samples, [&]()
+                 {
+                   hampel.filter(input.data(), output.data(), n);
+                   doNotOptimize(output.data()); });
+    }
+
+    void benchmarkFrequencyResponse(Runner &runner)
+    {
+      const size_t num_points = 1U << 16U;
+      const std::vector<double> frequencies = linearFrequencies(num_points, kSampleRate);
+      const Throughput points = Throughput::items(static_cast<double>(num_points));
+      const FIRFilterd fir = FIRFilterd::lowPass(128U, 100.0, kSampleRate);
+      const IIRFilterd iir = cascadedLowPass<double>(8U);
+
+      runner.run("frequency_response/fir_128/scalar", points, [&]()
+                 {
+                   double sum = 0.0;
+                   for (const double f : frequencies)
+                   {
+                     sum += std::abs(fir.frequencyResponse(f, kSampleRate));
+                   }
+                   doNotOptimize(sum); });
+      runner.run("frequency_response/fir_128/batch_1_thread", points, [&]()
+                 { doNotOptimize(frequencyResponse(fir, frequencies, kSampleRate, 1U)); });
+      runner.run("frequency_response/fir_128/batch", points, [&]()
+                 { doNotOptimize(frequencyResponse(fir, frequencies, kSampleRate)); });
+      runner.run("frequency_response/iir_order_8/batch", points, [&]()
+                 { doNotOptimize(frequencyResponse(iir, frequencies, kSampleRate)); });
+
+      const std::vector<IIRFilterd> bank(16U, iir);
+      runner.run("frequency_response/bank_16/batch", Throughput::items(16.0 * num_points), [&]()
+                 { doNotOptimize(frequencyResponses(bank, frequencies, kSampleRate)); });
+    }
+  } // namespace
+} // namespace lumos
+
+int main(int argc, char **argv)
+{
+  lumos::benchmark::Runner runner(argc, argv);
+
+  lumos::benchmarkStreaming<double>(runner, "double");
+  lumos::benchmarkStreaming<float>(runner, "float");
+  lumos::benchmarkOffline(runner);
+  lumos::benchmarkResampler(runner);
+  lumos::benchmarkNonlinear(runner);
+  lumos::benchmarkFrequencyResponse(runner);
+
+  return runner.finish();
+}
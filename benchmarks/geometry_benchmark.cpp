@@ -0,0 +1,155 @@
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "harness/benchmark.h"
+#include "lumos/math/math.h"
+
+namespace lumos
+{
+  namespace
+  {
+    using benchmark::doNotOptimize;
+    using benchmark::Runner;
+    using benchmark::Throughput;
+
+    PointArray3D<double> randomPoints3D(const size_t n, std::mt19937 &rng)
+    {
+      std::uniform_real_distribution<double> dist(-10.0, 10.0);
+      PointArray3D<double> points(n);
+      for (size_t i = 0; i < n; ++i)
+      {
+        points.setPoint(i, Point3<double>(dist(rng), dist(rng), dist(rng)));
+      }
+      return points;
+    }
+
+    std::vector<Point2<double>> randomPoints2D(const size_t n, std::mt19937 &rng)
+    {
+      std::normal_distribution<double> dist(0.0, 5.0);
+      std::vector<Point2<double>> points(n);
+      for (Point2<double> &p : points)
+      {
+        p = Point2<double>(dist(rng), dist(rng));
+      }
+      return points;
+    }
+
+    void benchmarkBatchPredicates(Runner &runner, const size_t n)
+    {
+      std::mt19937 rng(1U);
+      const PointArray3D<double> points = randomPoints3D(n, rng);
+      const PointArray3D<double> directions = randomPoints3D(n, rng);
+      const Plane<double> plane(Point3<double>(0.0, 0.0, 1.0), Vec3<double>(0.3, 0.4, 1.0));
+      const Triangle3D<double> triangle(Point3<double>(-5.0, -5.0, 2.0), Point3<double>(5.0, -5.0, 2.0),
+                                        Point3<double>(0.0, 5.0, 3.0));
+      const Triangle2D<double> triangle_2d(Point2<double>(-5.0, -5.0), Point2<double>(5.0, -5.0),
+                                           Point2<double>(0.0, 5.0));
+      const PointArray2D<double> points_2d(randomPoints2D(n, rng));
+
+      std::vector<double> distances(n);
+      std::vector<double> t(n);
+      std::vector<uint8_t> hit(n);
+
+      const Throughput items = Throughput::items(static_cast<double>(n));
+      const std::string size = std::to_string(n);
+      runner.run("batch/point_plane_distance/" + size, items, [&]()
+                 {
+                   pointPlaneDistances(plane, points.x.data(), points.y.data(), points.z.data(), n,
+                                       distances.data());
+                   doNotOptimize(distances.data()); });
+      runner.run("batch/ray_triangle/" + size, items, [&]()
+                 {
+                   rayTriangleIntersections(triangle, points, directions, t, hit);
+                   doNotOptimize(hit.data()); });
+      runner.run("batch/point_in_triangle/" + size, items, [&]()
+                 { doNotOptimize(pointsInTriangle(triangle_2d, points_2d)); });
+    }
+
+    void benchmarkFitting(Runner &runner, const size_t n)
+    {
+      // Points on a plane with noise and 30 % outliers
+      std::mt19937 rng(2U);
+      std::uniform_real_distribution<double> coordinate(-10.0, 10.0);
+      std::normal_distribution<double> noise(0.0, 0.02);
+      std::uniform_real_distribution<double> unit(0.0, 1.0);
+      PointArray3D<double> points(n);
+      for (size_t i = 0; i < n; ++i)
+      {
+        const double x = coordinate(rng);
+        const double y = coordinate(rng);
+        const double z = unit(rng) < 0.3 ? coordinate(rng) : 0.1 * x - 0.2 * y + 1.0 + noise(rng);
+        points.setPoint(i, Point3<double>(x, y, z));
+      }
+      RansacParameters<double> params;
+      params.inlier_threshold = 0.1;
+      params.seed = 3U;
+
+      const Throughput items = Throughput::items(static_cast<double>(n));
+      const std::string size = std::to_string(n);
+      runner.run("fit/plane_least_squares/" + size, items, [&]()
+                 { doNotOptimize(fitPlaneLeastSquares(points)); });
+      runner.run("fit/plane_ransac/" + size, items, [&]()
+                 { doNotOptimize(fitPlaneRansac(points, params)); });
+    }
+
+    void benchmarkHulls(Runner &runner, const size_t n)
+    {
+      std::mt19937 rng(4U);
+      const std::vector<Point2<double>> points_2d = randomPoints2D(n, rng);
+      const std::vector<Point3<double>> points_3d = randomPoints3D(n, rng).toPoints();
+
+      const Throughput items = Throughput::items(static_cast<double>(n));
+      const std::string size = std::to_string(n);
+      runner.run("hull/2d/" + size, items, [&]()
+                 { doNotOptimize(convexHull2DIndices(points_2d)); });
+      runner.run("hull/3d/" + size, items, [&]()
+                 { doNotOptimize(convexHull3D(points_3d)); });
+    }
+
+    void benchmarkPointInPolygon(Runner &runner, const size_t num_vertices, const size_t n)
+    {
+      // Star shaped polygon, concave
+      std::vector<Point2<double>> vertices(num_vertices);
+      for (size_t i = 0; i < num_vertices; ++i)
+      {
+        const double angle = 2.0 * M_PI * static_cast<double>(i) / static_cast<double>(num_vertices);
+        const double radius = i % 2U == 0U ? 10.0 : 6.0;
+        vertices[i] = Point2<double>(radius * std::cos(angle), radius * std::sin(angle));
+      }
+      const Polygon2D<double> polygon(vertices);
+      const PolygonPointLocator<double> locator(polygon);
+      std::mt19937 rng(6U);
+      const std::vector<Point2<double>> queries = randomPoints2D(n, rng);
+      const PointArray2D<double> query_array(queries);
+
+      const Throughput items = Throughput::items(static_cast<double>(n));
+      const std::string suffix = "vertices_" + std::to_string(num_vertices) + "/" + std::to_string(n);
+      runner.run("point_in_polygon/scalar/" + suffix, items, [&]()
+                 {
+                   size_t num_inside = 0U;
+                   for (const Point2<double> &q : queries)
+                   {
+                     num_inside += polygon.contains(q) ? 1U : 0U;
+                   }
+                   doNotOptimize(num_inside); });
+      runner.run("point_in_polygon/locator/" + suffix, items, [&]()
+                 { doNotOptimize(locator.contains(query_array)); });
+    }
+  } // namespace
+} // namespace lumos
+
+int main(int argc, char **argv)
+{
+  lumos::benchmark::Runner runner(argc, argv);
+
+  lumos::benchmarkBatchPredicates(runner, 1U << 16U);
+  lumos::benchmarkFitting(runner, 10000U);
+  lumos::benchmarkHulls(runner, 100000U);
+  lumos::benchmarkPointInPolygon(runner, 16U, 100000U);
+  lumos::benchmarkPointInPolygon(runner, 1024U, 100000U);
+
+  return runner.finish();
+}
@@ -0,0 +1,651 @@
+#ifndef LUMOS_BENCHMARKS_HARNESS_BENCHMARK_H_
+#define LUMOS_BENCHMARKS_HARNESS_BENCHMARK_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdint>
+#include <ctime>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "lumos/json/json.impl.h"
+#include "lumos/number_conversion.h"
+
+namespace lumos
+{
+  namespace benchmark
+  {
+    // Keeps the compiler from removing the computation of value
+    template <typename T>
+    inline void doNotOptimize(const T &value)
+    {
+#if defined(__GNUC__)
+      asm volatile("" : : "r,m"(value) : "memory");
+#else
+      static volatile const void *sink;
+      sink = &value;
+#endif
+    }
+
+    // Forces pending writes to memory, so stores are not optimized away
+    inline void clobberMemory()
+    {
+#if defined(__GNUC__)
+      asm volatile("" : : : "memory");
+#endif
+    }
+
+    // Work done by one call of a benchmarked function, reported per second
+    // of the median time
+    struct Throughput
+    {
+      enum class Unit
+      {
+        None,
+        Items,
+        Bytes
+      };
+
+      Unit unit = Unit::None;
+      double per_iteration = 0.0;
+
+      static Throughput items(const double num_items)
+      {
+        return Throughput{Unit::Items, num_items};
+      }
+
+      static Throughput bytes(const double num_bytes)
+      {
+        return Throughput{Unit::Bytes, num_bytes};
+      }
+    };
+
+    // Times in nanoseconds
+    struct Statistics
+    {
+      double min = 0.0;
+      double median = 0.0;
+      double mean = 0.0;
+      double p99 = 0.0;
+      double max = 0.0;
+    };
+
+    struct Result
+    {
+      std::string name;
+      size_t iterations;  // Calls per repetition
+      size_t repetitions; // Timed samples
+      Statistics time_ns; // Per call
+      Throughput throughput;
+      double allocations = -1.0; // Heap allocations per call, negative if not counted
+    };
+
+    namespace internal
+    {
+      // Heap allocations seen by the operator new of
+      // harness/count_allocations.h, installed if a benchmark includes it
+      struct AllocationCounter
+      {
+        std::atomic<uint64_t> count{0U};
+        bool installed = false;
+      };
+
+      inline AllocationCounter &allocationCounter()
+      {
+        static AllocationCounter counter;
+        return counter;
+      }
+
+      // Nearest rank percentile of sorted samples, p in [0, 100]
+      inline double percentile(const std::vector<double> &sorted, const double p)
+      {
+        const double rank = std::ceil(p / 100.0 * static_cast<double>(sorted.size()));
+        const size_t index = rank < 1.0 ? 0U : static_cast<size_t>(rank) - 1U;
+        return sorted[std::min(index, sorted.size() - 1U)];
+      }
+
+      inline Statistics computeStatistics(std::vector<double> samples)
+      {
+        Statistics statistics;
+        if (samples.empty())
+        {
+          return statistics;
+        }
+        std::sort(samples.begin(), samples.end());
+        const size_t n = samples.size();
+        statistics.min = samples.front();
+        statistics.max = samples.back();
+        statistics.median = n % 2U == 1U ? samples[n / 2U]
+                                         : 0.5 * (samples[n / 2U - 1U] + samples[n / 2U]);
+        double sum = 0.0;
+        for (const double sample : samples)
+        {
+          sum += sample;
+        }
+        statistics.mean = sum / static_cast<double>(n);
+        statistics.p99 = percentile(samples, 99.0);
+        return statistics;
+      }
+
+      inline std::string formatTime(const double ns)
+      {
+        if (ns < 1e3)
+        {
+          return lumos::internal::formatFixed(ns, 2) + " ns";
+        }
+        else if (ns < 1e6)
+        {
+          return lumos::internal::formatFixed(ns * 1e-3, 2) + " us";
+        }
+        else if (ns < 1e9)
+        {
+          return lumos::internal::formatFixed(ns * 1e-6, 2) + " ms";
+        }
+        return lumos::internal::formatFixed(ns * 1e-9, 2) + " s";
+      }
+
+      inline double perSecond(const Throughput &throughput, const double ns)
+      {
+        return ns > 0.0 ? throughput.per_iteration * 1e9 / ns : 0.0;
+      }
+
+      inline std::string formatThroughput(const Throughput &throughput, const double ns)
+      {
+        if (throughput.unit == Throughput::Unit::None)
+        {
+          return "";
+        }
+        const double per_second = perSecond(throughput, ns);
+        const char *const prefixes[] = {"", "k", "M", "G", "T"};
+        double value = per_second;
+        size_t prefix = 0U;
+        while (value >= 1000.0 && prefix < 4U)
+        {
+          value /= 1000.0;
+          ++prefix;
+        }
+        return lumos::internal::formatFixed(value, 2) + " " + prefixes[prefix] +
+               (throughput.unit == Throughput::Unit::Bytes ? "B/s" : "items/s");
+      }
+
+      inline std::string readFirstLine(const std::string &path)
+      {
+        std::ifstream file(path);
+        std::string line;
+        if (file)
+        {
+          std::getline(file, line);
+        }
+        return line;
+      }
+
+      inline std::string currentUtcTime()
+      {
+        const std::time_t now = std::time(nullptr);
+        std::tm utc{};
+        gmtime_r(&now, &utc);
+        char buffer[32];
+        std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", &utc);
+        return buffer;
+      }
+
+      // Value of "--key=value", false if arg is not that option
+      inline bool optionValue(const std::string_view arg, const std::string_view key,
+                              std::string_view &value)
+      {
+        if (arg.size() < key.size() + 3U || arg.substr(0U, 2U) != "--" ||
+            arg.substr(2U, key.size()) != key || arg[key.size() + 2U] != '=')
+        {
+          return false;
+        }
+        value = arg.substr(key.size() + 3U);
+        return true;
+      }
+    } // namespace internal
+
+    struct Options
+    {
+      std::string filter;       // Only names containing this
+      size_t repetitions = 15U; // Timed samples per benchmark
+      double min_time_ms = 20.0; // Minimum duration of one sample
+      double warmup_ms = 100.0; // Untimed calls before the first sample
+      std::string json_path;    // Results as JSON
+      std::string compare_path; // JSON results of an earlier run to compare to
+      std::string label;        // Stored with the results, e.g. a commit hash
+      bool smoke = false;       // One call per benchmark, checks that they run
+      bool list = false;        // Print the names only
+    };
+
+    // Runs benchmarks and collects their results. A benchmark is a function
+    // called repeatedly: the number of calls per sample is calibrated to take
+    // at least min_time_ms, after warmup_ms of untimed calls, and the time
+    // per call is reported as median, p99 and so on over the samples.
+    //
+    //   int main(int argc, char **argv)
+    //   {
+    //     lumos::benchmark::Runner runner(argc, argv);
+    //     runner.run("fft/4096", Throughput::items(4096), [&]() { plan.forward(data); });
+    //     return runner.finish();
+    //   }
+    class Runner
+    {
+    public:
+      Runner(const int argc, char **const argv) : has_failed_(false), exit_code_(-1)
+      {
+        const std::string path = argc > 0 ? argv[0] : "benchmark";
+        executable_ = path.substr(path.find_last_of('/') + 1U);
+
+        for (int i = 1; i < argc; ++i)
+        {
+          if (!parseArgument(argv[i]))
+          {
+            std::cerr << "Unknown argument: " << argv[i] << "\n";
+            printUsage(std::cerr);
+            exit_code_ = 2;
+          }
+        }
+
+        if (options_.smoke || options_.list || exit_code_ >= 0)
+        {
+          return;
+        }
+        warnAboutEnvironment();
+        if (!options_.compare_path.empty())
+        {
+          loadBaseline();
+        }
+        printHeader();
+      }
+
+      const Options &options() const
+      {
+        return options_;
+      }
+
+      bool isSmokeRun() const
+      {
+        return options_.smoke;
+      }
+
+      bool shouldRun(const std::string &name) const
+      {
+        return exit_code_ < 0 && name.find(options_.filter) != std::string::npos;
+      }
+
+      template <typename F>
+      void run(const std::string &name, F &&f)
+      {
+        run(name, Throughput(), std::forward<F>(f));
+      }
+
+      template <typename F>
+      void run(const std::string &name, const Throughput &throughput, F &&f)
+      {
+        if (!shouldRun(name))
+        {
+          return;
+        }
+        if (options_.list)
+        {
+          std::cout << name << "\n";
+          return;
+        }
+
+        try
+        {
+          if (options_.smoke)
+          {
+            f();
+            std::cout << "[ OK ] " << name << "\n";
+            return;
+          }
+
+          const size_t iterations = calibrate(f);
+          std::vector<double> samples(options_.repetitions);
+          for (double &sample : samples)
+          {
+            sample = timeCalls(f, iterations) / static_cast<double>(iterations);
+          }
+          addResult(Result{name, iterations, samples.size(),
+                           internal::computeStatistics(samples), throughput, countAllocations(f)});
+        }
+        catch (const std::exception &e)
+        {
+          has_failed_ = true;
+          std::cout << "[FAIL] " << name << ": " << e.what() << "\n";
+        }
+      }
+
+      // For benchmarks that time themselves, e.g. the latency of single
+      // messages: measure() returns one sample in nanoseconds per call
+      template <typename Measure>
+      void runSamples(const std::string &name, const Throughput &throughput, Measure &&measure)
+      {
+        if (!shouldRun(name))
+        {
+          return;
+        }
+        if (options_.list)
+        {
+          std::cout << name << "\n";
+          return;
+        }
+
+        try
+        {
+          const std::vector<double> samples_ns = measure();
+          if (options_.smoke)
+          {
+            std::cout << "[ OK ] " << name << "\n";
+            return;
+          }
+          addResult(Result{name, 1U, samples_ns.size(),
+                           internal::computeStatistics(samples_ns), throughput});
+        }
+        catch (const std::exception &e)
+        {
+          has_failed_ = true;
+          std::cout << "[FAIL] " << name << ": " << e.what() << "\n";
+        }
+      }
+
+      // Writes the JSON results, returns the exit code for main
+      int finish()
+      {
+        if (exit_code_ >= 0)
+        {
+          return exit_code_;
+        }
+        if (!options_.json_path.empty() && !options_.smoke && !options_.list)
+        {
+          toJson().ToFile(options_.json_path, true, 2U);
+        }
+        return has_failed_ ? 1 : 0;
+      }
+
+      const std::vector<Result> &results() const
+      {
+        return results_;
+      }
+
+    private:
+      using Clock = std::chrono::steady_clock;
+
+      static constexpr size_t kMaxIterations = static_cast<size_t>(1) << 30U;
+
+      bool parseArgument(const std::string_view arg)
+      {
+        std::string_view value;
+        if (arg == "--smoke")
+        {
+          options_.smoke = true;
+        }
+        else if (arg == "--list")
+        {
+          options_.list = true;
+        }
+        else if (arg == "--help")
+        {
+          printUsage(std::cout);
+          exit_code_ = 0;
+        }
+        else if (internal::optionValue(arg, "filter", value))
+        {
+          options_.filter = std::string(value);
+        }
+        else if (internal::optionValue(arg, "repetitions", value))
+        {
+          return lumos::internal::tryParseNumber(value, options_.repetitions) &&
+                 options_.repetitions > 0U;
+        }
+        else if (internal::optionValue(arg, "min-time-ms", value))
+        {
+          return lumos::internal::tryParseNumber(value, options_.min_time_ms);
+        }
+        else if (internal::optionValue(arg, "warmup-ms", value))
+        {
+          return lumos::internal::tryParseNumber(value, options_.warmup_ms);
+        }
+        else if (internal::optionValue(arg, "json", value))
+        {
+          options_.json_path = std::string(value);
+        }
+        else if (internal::optionValue(arg, "compare", value))
+        {
+          options_.compare_path = std::string(value);
+        }
+        else if (internal::optionValue(arg, "label", value))
+        {
+          options_.label = std::string(value);
+        }
+        else
+        {
+          return false;
+        }
+        return true;
+      }
+
+      void printUsage(std::ostream &os) const
+      {
+        os << "Usage: " << executable_ << " [options]\n"
+           << "  --filter=TEXT       run the benchmarks whose name contains TEXT\n"
+           << "  --repetitions=N     timed samples per benchmark (" << options_.repetitions << ")\n"
+           << "  --min-time-ms=MS    minimum duration of one sample (" << options_.min_time_ms << ")\n"
+           << "  --warmup-ms=MS      untimed calls before the first sample (" << options_.warmup_ms << ")\n"
+           << "  --json=PATH         write the results as JSON\n"
+           << "  --compare=PATH      compare to the JSON results of an earlier run\n"
+           << "  --label=TEXT        stored with the JSON results, e.g. a commit hash\n"
+           << "  --smoke             call every benchmark once without timing\n"
+           << "  --list              print the benchmark names\n";
+      }
+
+      // Frequency scaling and turbo boost change the clock between and
+      // during samples, the results are only comparable with both disabled
+      void warnAboutEnvironment()
+      {
+        governor_ = internal::readFirstLine("/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor");
+        if (!governor_.empty() && governor_ != "performance")
+        {
+          std::cerr << "WARNING: CPU frequency scaling is enabled (governor '" << governor_
+                    << "'), results will be noisy\n";
+        }
+
+        const std::string no_turbo = internal::readFirstLine("/sys/devices/system/cpu/intel_pstate/no_turbo");
+        const std::string boost = internal::readFirstLine("/sys/devices/system/cpu/cpufreq/boost");
+        turbo_boost_ = no_turbo == "0" || boost == "1";
+        if (turbo_boost_)
+        {
+          std::cerr << "WARNING: CPU turbo boost is enabled, results will be noisy\n";
+        }
+
+#if !defined(__OPTIMIZE__)
+        std::cerr << "WARNING: Benchmarks built without optimization\n";
+#endif
+      }
+
+      void loadBaseline()
+      {
+        try
+        {
+          const Json baseline = parseJsonFromFile(options_.compare_path);
+          for (const Json &result : baseline["benchmarks"].asArray())
+          {
+            baseline_[result["name"].asString()] = result["median_ns"].asNumber();
+          }
+        }
+        catch (const std::exception &e)
+        {
+          std::cerr << "WARNING: Could not read " << options_.compare_path << ": " << e.what() << "\n";
+        }
+      }
+
+      void printHeader() const
+      {
+        std::printf("%-52s %12s %12s %18s %12s%s%s\n", "Benchmark", "Median", "p99",
+                    "Throughput", "Iterations",
+                    internal::allocationCounter().installed ? "  Allocs/call" : "",
+                    baseline_.empty() ? "" : "   Baseline");
+      }
+
+      // Allocations of one more call after the timed samples, which are
+      // not slowed down by the counting
+      template <typename F>
+      static double countAllocations(F &f)
+      {
+        internal::AllocationCounter &counter = internal::allocationCounter();
+        if (!counter.installed)
+        {
+          return -1.0;
+        }
+        const uint64_t before = counter.count.load(std::memory_order_relaxed);
+        f();
+        return static_cast<double>(counter.count.load(std::memory_order_relaxed) - before);
+      }
+
+      template <typename F>
+      static double timeCalls(F &f, const size_t num_calls)
+      {
+        const Clock::time_point start = Clock::now();
+        for (size_t i = 0; i < num_calls; ++i)
+        {
+          f();
+        }
+        clobberMemory();
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+      }
+
+      // Calls per sample so that one sample takes at least min_time_ms, then
+      // warms up for warmup_ms. Calibration counts towards the warm-up
+      template <typename F>
+      size_t calibrate(F &f) const
+      {
+        const double min_time_ns = options_.min_time_ms * 1e6;
+        const double warmup_ns = options_.warmup_ms * 1e6;
+
+        size_t iterations = 1U;
+        double total_ns = 0.0;
+        while (iterations < kMaxIterations)
+        {
+          const double elapsed = timeCalls(f, iterations);
+          total_ns += elapsed;
+          if (elapsed >= min_time_ns)
+          {
+            break;
+          }
+          const double scale = elapsed > 0.0 ? 1.4 * min_time_ns / elapsed : 10.0;
+          iterations = std::max(iterations + 1U,
+                                static_cast<size_t>(static_cast<double>(iterations) *
+                                                    std::min(scale, 10.0)));
+        }
+
+        while (total_ns < warmup_ns)
+        {
+          total_ns += timeCalls(f, iterations);
+        }
+        return iterations;
+      }
+
+      void addResult(const Result &result)
+      {
+        std::string baseline;
+        const auto it = baseline_.find(result.name);
+        if (it != baseline_.end() && it->second > 0.0)
+        {
+          const double change = 100.0 * (result.time_ns.median / it->second - 1.0);
+          baseline = (change >= 0.0 ? "   +" : "   ") + lumos::internal::formatFixed(change, 1) + "%";
+        }
+        char allocations[32] = "";
+        if (internal::allocationCounter().installed)
+        {
+          if (result.allocations < 0.0)
+          {
+            std::snprintf(allocations, sizeof(allocations), "%13s", "");
+          }
+          else
+          {
+            std::snprintf(allocations, sizeof(allocations), "%13.0f", result.allocations);
+          }
+        }
+        std::printf("%-52s %12s %12s %18s %12zu%s%s\n", result.name.c_str(),
+                    internal::formatTime(result.time_ns.median).c_str(),
+                    internal::formatTime(result.time_ns.p99).c_str(),
+                    internal::formatThroughput(result.throughput, result.time_ns.median).c_str(),
+                    result.iterations, allocations, baseline.c_str());
+        std::fflush(stdout);
+        results_.push_back(result);
+      }
+
+      Json toJson() const
+      {
+        Json context = JsonObject{};
+        context["executable"] = executable_;
+        context["label"] = options_.label;
+        context["date"] = internal::currentUtcTime();
+        context["num_cpus"] = static_cast<unsigned long>(std::thread::hardware_concurrency());
+        context["cpu_scaling_governor"] = governor_;
+        context["turbo_boost"] = turbo_boost_;
+#if defined(__OPTIMIZE__)
+        context["optimized"] = true;
+#else
+        context["optimized"] = false;
+#endif
+        context["repetitions"] = static_cast<unsigned long>(options_.repetitions);
+        context["min_time_ms"] = options_.min_time_ms;
+
+        Json benchmarks = JsonArray{};
+        for (const Result &result : results_)
+        {
+          Json entry = JsonObject{};
+          entry["name"] = result.name;
+          entry["iterations"] = static_cast<unsigned long>(result.iterations);
+          entry["repetitions"] = static_cast<unsigned long>(result.repetitions);
+          entry["min_ns"] = result.time_ns.min;
+          entry["median_ns"] = result.time_ns.median;
+          entry["mean_ns"] = result.time_ns.mean;
+          entry["p99_ns"] = result.time_ns.p99;
+          entry["max_ns"] = result.time_ns.max;
+          if (result.throughput.unit == Throughput::Unit::Items)
+          {
+            entry["items_per_second"] = internal::perSecond(result.throughput, result.time_ns.median);
+          }
+          else if (result.throughput.unit == Throughput::Unit::Bytes)
+          {
+            entry["bytes_per_second"] = internal::perSecond(result.throughput, result.time_ns.median);
+          }
+          if (result.allocations >= 0.0)
+          {
+            entry["allocations_per_call"] = result.allocations;
+          }
+          benchmarks.push_back(entry);
+        }
+
+        Json root = JsonObject{};
+        root["context"] = context;
+        root["benchmarks"] = benchmarks;
+        return root;
+      }
+
+      Options options_;
+      std::string executable_;
+      std::string governor_;
+      bool turbo_boost_ = false;
+      bool has_failed_;
+      int exit_code_; // Set when main should return without running
+      std::map<std::string, double> baseline_;
+      std::vector<Result> results_;
+    };
+  } // namespace benchmark
+} // namespace lumos
+
+#endif // LUMOS_BENCHMARKS_HARNESS_BENCHMARK_H_
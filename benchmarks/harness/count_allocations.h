@@ -0,0 +1,66 @@
+#ifndef LUMOS_BENCHMARKS_HARNESS_COUNT_ALLOCATIONS_H_
+#define LUMOS_BENCHMARKS_HARNESS_COUNT_ALLOCATIONS_H_
+
+#include <cstdlib>
+#include <new>
+
+#include "harness/benchmark.h"
+
+// Replaces the global operator new and delete to count heap allocations,
+// the Runner then reports allocations per call of every benchmark. Defines
+// the operators, so it can only be included by one translation unit of an
+// executable. Aligned allocations are not counted
+
+namespace lumos
+{
+  namespace benchmark
+  {
+    namespace internal
+    {
+      inline void *countedAllocation(const std::size_t size)
+      {
+        allocationCounter().count.fetch_add(1U, std::memory_order_relaxed);
+        void *const pointer = std::malloc(size == 0U ? 1U : size);
+        if (pointer == nullptr)
+        {
+          throw std::bad_alloc();
+        }
+        return pointer;
+      }
+
+      static const bool kAllocationCounterInstalled = (allocationCounter().installed = true);
+    } // namespace internal
+  } // namespace benchmark
+} // namespace lumos
+
+void *operator new(const std::size_t size)
+{
+  return lumos::benchmark::internal::countedAllocation(size);
+}
+
+void *operator new[](const std::size_t size)
+{
+  return lumos::benchmark::internal::countedAllocation(size);
+}
+
+void operator delete(void *const pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete[](void *const pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void *const pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete[](void *const pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
+
+#endif // LUMOS_BENCHMARKS_HARNESS_COUNT_ALLOCATIONS_H_
@@ -0,0 +1,82 @@
+#include <random>
+#include <string>
+
+#include "harness/benchmark.h"
+#include "lumos/json/json.impl.h"
+
+namespace
+{
+  using lumos::benchmark::doNotOptimize;
+  using lumos::benchmark::Runner;
+  using lumos::benchmark::Throughput;
+
+  // Array of records mixing strings, numbers, booleans and a nested array,
+  // roughly what a log or telemetry export looks like
+  Json recordDocument(const size_t num_records)
+  {
+    std::mt19937 rng(14U);
+    std::uniform_real_distribution<double> value(-100.0, 100.0);
+    std::uniform_int_distribution<int> id(0, 1000000);
+    Json records = JsonArray{};
+    for (size_t i = 0; i < num_records; ++i)
+    {
+      Json samples = JsonArray{};
+      for (int k = 0; k < 8; ++k)
+      {
+        samples.push_back(value(rng));
+      }
+      JsonObject record;
+      record["id"] = id(rng);
+      record["name"] = "sensor_" + std::to_string(i);
+      record["active"] = i % 3U != 0U;
+      record["gain"] = value(rng);
+      record["samples"] = samples;
+      records.push_back(record);
+    }
+    JsonObject document;
+    document["version"] = 1;
+    document["records"] = records;
+    return document;
+  }
+
+  // One large flat numeric array, the shape of a plotted signal
+  Json numericDocument(const size_t num_values)
+  {
+    std::mt19937 rng(15U);
+    std::normal_distribution<double> value(0.0, 10.0);
+    Json values = JsonArray{};
+    for (size_t i = 0; i < num_values; ++i)
+    {
+      values.push_back(value(rng));
+    }
+    return values;
+  }
+
+  void benchmarkDocument(Runner &runner, const std::string &name, const Json &document)
+  {
+    const std::string compact = document.toString();
+    const std::string pretty = document.toString(true, 0, 2);
+    const Throughput compact_bytes = Throughput::bytes(static_cast<double>(compact.size()));
+
+    runner.run("parse/" + name, compact_bytes, [&]()
+               { doNotOptimize(parseJson(compact)); });
+    runner.run("parse_pretty/" + name, Throughput::bytes(static_cast<double>(pretty.size())), [&]()
+               { doNotOptimize(parseJson(pretty)); });
+    runner.run("validate/" + name, compact_bytes, [&]()
+               { doNotOptimize(isValidJson(compact)); });
+    runner.run("serialize/" + name, compact_bytes, [&]()
+               { doNotOptimize(document.toString()); });
+    runner.run("serialize_pretty/" + name, Throughput::bytes(static_cast<double>(pretty.size())), [&]()
+               { doNotOptimize(document.toString(true, 0, 2)); });
+  }
+} // namespace
+
+int main(int argc, char **argv)
+{
+  Runner runner(argc, argv);
+
+  benchmarkDocument(runner, "records_1000", recordDocument(1000U));
+  benchmarkDocument(runner, "numbers_100000", numericDocument(100000U));
+
+  return runner.finish();
+}
@@ -0,0 +1,110 @@
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "harness/benchmark.h"
+#include "lumos/math/math.h"
+
+namespace lumos
+{
+  namespace
+  {
+    using benchmark::doNotOptimize;
+    using benchmark::Runner;
+    using benchmark::Throughput;
+
+    template <uint16_t N>
+    FixedSizeMatrix<double, N, N> randomFixedMatrix(std::mt19937 &rng)
+    {
+      std::uniform_real_distribution<double> dist(-1.0, 1.0);
+      FixedSizeMatrix<double, N, N> m;
+      for (size_t r = 0; r < N; ++r)
+      {
+        for (size_t c = 0; c < N; ++c)
+        {
+          m(r, c) = dist(rng);
+        }
+      }
+      return m;
+    }
+
+    Matrix<double> randomMatrix(const size_t n, std::mt19937 &rng)
+    {
+      std::uniform_real_distribution<double> dist(-1.0, 1.0);
+      Matrix<double> m(n, n);
+      for (size_t r = 0; r < n; ++r)
+      {
+        for (size_t c = 0; c < n; ++c)
+        {
+          m(r, c) = dist(rng);
+        }
+      }
+      return m;
+    }
+
+    template <uint16_t N>
+    void benchmarkFixedSize(Runner &runner)
+    {
+      std::mt19937 rng(N);
+      const FixedSizeMatrix<double, N, N> a = randomFixedMatrix<N>(rng);
+      const FixedSizeMatrix<double, N, N> b = randomFixedMatrix<N>(rng);
+      // Symmetric positive definite for Cholesky
+      FixedSizeMatrix<double, N, N> spd = a * a.transposed();
+      for (size_t i = 0; i < N; ++i)
+      {
+        spd(i, i) += static_cast<double>(N);
+      }
+
+      const std::string size = std::to_string(N) + "x" + std::to_string(N);
+      const double flops = 2.0 * N * N * N;
+      runner.run("fixed/multiply/" + size, Throughput::items(flops), [&]()
+                 { doNotOptimize(a * b); });
+      runner.run("fixed/inverse/" + size, [&]()
+                 { doNotOptimize(a.inverse()); });
+      runner.run("fixed/determinant/" + size, [&]()
+                 { doNotOptimize(a.determinant()); });
+      runner.run("fixed/lu/" + size, [&]()
+                 { doNotOptimize(a.luDecomposition()); });
+      runner.run("fixed/qr/" + size, [&]()
+                 { doNotOptimize(a.qrDecomposition()); });
+      runner.run("fixed/cholesky/" + size, [&]()
+                 { doNotOptimize(spd.cholesky()); });
+    }
+
+    void benchmarkDynamic(Runner &runner, const size_t n)
+    {
+      std::mt19937 rng(static_cast<uint32_t>(n));
+      const Matrix<double> a = randomMatrix(n, rng);
+      const Matrix<double> b = randomMatrix(n, rng);
+      Vector<double> v(n);
+      for (size_t i = 0; i < n; ++i)
+      {
+        v(i) = static_cast<double>(i);
+      }
+
+      const std::string size = std::to_string(n) + "x" + std::to_string(n);
+      const double nd = static_cast<double>(n);
+      runner.run("dynamic/multiply/" + size, Throughput::items(2.0 * nd * nd * nd), [&]()
+                 { doNotOptimize(a * b); });
+      runner.run("dynamic/matrix_vector/" + size, Throughput::items(2.0 * nd * nd), [&]()
+                 { doNotOptimize(a * v); });
+      runner.run("dynamic/transpose/" + size, Throughput::bytes(2.0 * nd * nd * sizeof(double)), [&]()
+                 { doNotOptimize(a.getTranspose()); });
+    }
+  } // namespace
+} // namespace lumos
+
+int main(int argc, char **argv)
+{
+  lumos::benchmark::Runner runner(argc, argv);
+
+  lumos::benchmarkFixedSize<3>(runner);
+  lumos::benchmarkFixedSize<4>(runner);
+  lumos::benchmarkFixedSize<6>(runner);
+  for (const size_t n : {16U, 64U, 256U})
+  {
+    lumos::benchmarkDynamic(runner, n);
+  }
+
+  return runner.finish();
+}
@@ -0,0 +1,105 @@
+#include <ostream>
+#include <streambuf>
+
+#include "harness/benchmark.h"
+#include "lumos/logging/logging.h"
+
+namespace
+{
+  using lumos::benchmark::doNotOptimize;
+  using lumos::benchmark::Runner;
+  using lumos::benchmark::Throughput;
+
+  constexpr int kMessagesPerIteration = 1000;
+
+  // Discards everything but counts the bytes, so the benchmarks measure
+  // formatting and dispatch rather than a terminal or file
+  class CountingBuffer : public std::streambuf
+  {
+  public:
+    size_t numBytes() const { return num_bytes_; }
+
+  protected:
+    int_type overflow(const int_type c) override
+    {
+      ++num_bytes_;
+      return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char *, const std::streamsize n) override
+    {
+      num_bytes_ += static_cast<size_t>(n);
+      return n;
+    }
+
+  private:
+    size_t num_bytes_ = 0U;
+  };
+
+  void benchmarkLogging(Runner &runner)
+  {
+    CountingBuffer buffer;
+    std::ostream sink(&buffer);
+    lumos::logging::setOutputStream(&sink);
+    lumos::logging::useColors(false);
+    const Throughput messages = Throughput::items(kMessagesPerIteration);
+
+    // The same message written straight to the stream, the floor for
+    // everything below
+    runner.run("baseline/ostream", messages, [&]()
+               {
+                 for (int i = 0; i < kMessagesPerIteration; ++i)
+                 {
+                   sink << "value " << i << " of " << 3.25 << '\n';
+                 }
+               });
+    runner.run("info/stream", messages, [&]()
+               {
+                 for (int i = 0; i < kMessagesPerIteration; ++i)
+                 {
+                   LUMOS_LOG_INFO() << "value " << i << " of " << 3.25;
+                 }
+               });
+    runner.run("info/format", messages, [&]()
+               {
+                 for (int i = 0; i < kMessagesPerIteration; ++i)
+                 {
+                   LUMOS_LOG_INFOF("value %d of %f", i, 3.25);
+                 }
+               });
+
+    // Severity only, without location and thread id
+    lumos::logging::showFile(false);
+    lumos::logging::showFunction(false);
+    lumos::logging::showLineNumber(false);
+    lumos::logging::showThreadId(false);
+    runner.run("info/stream_minimal_prefix", messages, [&]()
+               {
+                 for (int i = 0; i < kMessagesPerIteration; ++i)
+                 {
+                   LUMOS_LOG_INFO() << "value " << i << " of " << 3.25;
+                 }
+               });
+
+    // What a macro compiled out by LUMOS_LOG_LEVEL expands to
+    runner.run("disabled_level", messages, [&]()
+               {
+                 for (int i = 0; i < kMessagesPerIteration; ++i)
+                 {
+                   lumos::logging::internal::Log(false).getStream() << "value " << i << " of " << 3.25;
+                 }
+               });
+
+    doNotOptimize(buffer.numBytes());
+    lumos::logging::resetToDefaults();
+  }
+} // namespace
+
+int main(int argc, char **argv)
+{
+  Runner runner(argc, argv);
+
+  benchmarkLogging(runner);
+
+  return runner.finish();
+}
@@ -0,0 +1,197 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "harness/benchmark.h"
+#include "lumos/number_conversion/number_conversion.h"
+
+namespace lumos
+{
+  namespace
+  {
+    using benchmark::doNotOptimize;
+    using benchmark::Runner;
+    using benchmark::Throughput;
+
+    constexpr size_t kNumValues = 10000U;
+
+    std::vector<int64_t> randomIntegers()
+    {
+      std::mt19937_64 rng(12U);
+      std::uniform_int_distribution<int64_t> magnitude(-1000000000000LL, 1000000000000LL);
+      std::vector<int64_t> values(kNumValues);
+      for (int64_t &value : values)
+      {
+        value = magnitude(rng) >> (rng() % 40U);
+      }
+      return values;
+    }
+
+    std::vector<double> randomDoubles()
+    {
+      std::mt19937_64 rng(13U);
+      std::normal_distribution<double> dist(0.0, 1000.0);
+      std::vector<double> values(kNumValues);
+      for (double &value : values)
+      {
+        value = dist(rng);
+      }
+      return values;
+    }
+
+    template <typename T>
+    std::vector<std::string> toStrings(const std::vector<T> &values)
+    {
+      std::vector<std::string> strings;
+      strings.reserve(values.size());
+      for (const T value : values)
+      {
+        strings.push_back(internal::formatNumber(value));
+      }
+      return strings;
+    }
+
+    void benchmarkParsing(Runner &runner)
+    {
+      const std::vector<std::string> integers = toStrings(randomIntegers());
+      const std::vector<std::string> doubles = toStrings(randomDoubles());
+      const Throughput items = Throughput::items(static_cast<double>(kNumValues));
+
+      runner.run("parse/int64/lumos", items, [&]()
+                 {
+                   int64_t sum = 0;
+                   for (const std::string &str : integers)
+                   {
+                     sum += internal::parseNumber<int64_t>(str);
+                   }
+                   doNotOptimize(sum); });
+      runner.run("parse/int64/try_parse", items, [&]()
+                 {
+                   int64_t sum = 0;
+                   int64_t value = 0;
+                   for (const std::string &str : integers)
+                   {
+                     sum += internal::tryParseNumber(str, value) ? value : 0;
+                   }
+                   doNotOptimize(sum); });
+      runner.run("parse/int64/strtoll", items, [&]()
+                 {
+                   int64_t sum = 0;
+                   for (const std::string &str : integers)
+                   {
+                     sum += std::strtoll(str.c_str(), nullptr, 10);
+                   }
+                   doNotOptimize(sum); });
+      runner.run("parse/int64/istringstream", items, [&]()
+                 {
+                   int64_t sum = 0;
+                   for (const std::string &str : integers)
+                   {
+                     std::istringstream stream(str);
+                     int64_t value = 0;
+                     stream >> value;
+                     sum += value;
+                   }
+                   doNotOptimize(sum); });
+
+      runner.run("parse/double/lumos", items, [&]()
+                 {
+                   double sum = 0.0;
+                   for (const std::string &str : doubles)
+                   {
+                     sum += internal::parseNumber<double>(str);
+                   }
+                   doNotOptimize(sum); });
+      runner.run("parse/double/strtod", items, [&]()
+                 {
+                   double sum = 0.0;
+                   for (const std::string &str : doubles)
+                   {
+                     sum += std::strtod(str.c_str(), nullptr);
+                   }
+                   doNotOptimize(sum); });
+      runner.run("parse/double/stod", items, [&]()
+                 {
+                   double sum = 0.0;
+                   for (const std::string &str : doubles)
+                   {
+                     sum += std::stod(str);
+                   }
+                   doNotOptimize(sum); });
+    }
+
+    void benchmarkFormatting(Runner &runner)
+    {
+      const std::vector<int64_t> integers = randomIntegers();
+      const std::vector<double> doubles = randomDoubles();
+      const Throughput items = Throughput::items(static_cast<double>(kNumValues));
+      std::string buffer;
+
+      runner.run("format/int64/append", items, [&]()
+                 {
+                   buffer.clear();
+                   for (const int64_t value : integers)
+                   {
+                     internal::appendNumber(buffer, value);
+                   }
+                   doNotOptimize(buffer.data()); });
+      runner.run("format/int64/to_string", items, [&]()
+                 {
+                   buffer.clear();
+                   for (const int64_t value : integers)
+                   {
+                     buffer += std::to_string(value);
+                   }
+                   doNotOptimize(buffer.data()); });
+
+      runner.run("format/double/shortest", items, [&]()
+                 {
+                   buffer.clear();
+                   for (const double value : doubles)
+                   {
+                     internal::appendNumber(buffer, value);
+                   }
+                   doNotOptimize(buffer.data()); });
+      runner.run("format/double/fixed_6", items, [&]()
+                 {
+                   buffer.clear();
+                   for (const double value : doubles)
+                   {
+                     internal::appendFixed(buffer, value, 6);
+                   }
+                   doNotOptimize(buffer.data()); });
+      runner.run("format/double/snprintf_g17", items, [&]()
+                 {
+                   buffer.clear();
+                   char chars[32];
+                   for (const double value : doubles)
+                   {
+                     const int length = std::snprintf(chars, sizeof(chars), "%.17g", value);
+                     buffer.append(chars, static_cast<size_t>(length));
+                   }
+                   doNotOptimize(buffer.data()); });
+      runner.run("format/double/ostringstream", items, [&]()
+                 {
+                   std::ostringstream stream;
+                   for (const double value : doubles)
+                   {
+                     stream << value;
+                   }
+                   doNotOptimize(stream.str()); });
+    }
+  } // namespace
+} // namespace lumos
+
+int main(int argc, char **argv)
+{
+  lumos::benchmark::Runner runner(argc, argv);
+
+  lumos::benchmarkParsing(runner);
+  lumos::benchmarkFormatting(runner);
+
+  return runner.finish();
+}
@@ -0,0 +1,189 @@
+#include <atomic>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "harness/benchmark.h"
+#include "lumos/parallel/parallel.h"
+
+namespace lumos
+{
+  namespace
+  {
+    using benchmark::doNotOptimize;
+    using benchmark::Runner;
+    using benchmark::Throughput;
+    using parallel::TaskGraph;
+    using parallel::TaskGroup;
+    using parallel::ThreadPool;
+
+    constexpr size_t kNumTasks = 1000U;
+
+    size_t fibonacci(const size_t n, ThreadPool &pool)
+    {
+      if (n < 2U)
+      {
+        return n;
+      }
+      size_t a = 0U;
+      TaskGroup group(pool);
+      group.run([&a, n, &pool]()
+                { a = fibonacci(n - 1U, pool); });
+      const size_t b = fibonacci(n - 2U, pool);
+      group.wait();
+      return a + b;
+    }
+
+    // Scheduling cost per task, the tasks themselves do nothing
+    void benchmarkTaskOverhead(Runner &runner, ThreadPool &pool, const std::string &threads)
+    {
+      const Throughput tasks = Throughput::items(static_cast<double>(kNumTasks));
+
+      runner.run("task_group/empty_tasks/" + threads, tasks, [&]()
+                 {
+                   TaskGroup group(pool);
+                   for (size_t i = 0; i < kNumTasks; ++i)
+                   {
+                     group.run([]() {});
+                   }
+                   group.wait(); });
+      runner.run("submit/empty_tasks/" + threads, tasks, [&]()
+                 {
+                   std::atomic<size_t> remaining(kNumTasks);
+                   for (size_t i = 0; i < kNumTasks; ++i)
+                   {
+                     pool.submit([&remaining]()
+                                 { remaining.fetch_sub(1U, std::memory_order_relaxed); });
+                   }
+                   pool.waitUntil([&remaining]()
+                                  { return remaining.load(std::memory_order_relaxed) == 0U; }); });
+      // fibonacci(16) spawns 1596 tasks through nested groups
+      runner.run("task_group/nested_fibonacci_16/" + threads, Throughput::items(1596.0), [&]()
+                 { doNotOptimize(fibonacci(16U, pool)); });
+    }
+
+    void benchmarkTaskGraph(Runner &runner, ThreadPool &pool, const std::string &threads)
+    {
+      const Throughput nodes = Throughput::items(static_cast<double>(kNumTasks));
+
+      TaskGraph chain;
+      TaskGraph fan;
+      const TaskGraph::TaskId source = fan.addTask([]() {});
+      const TaskGraph::TaskId sink = fan.addTask([]() {});
+      TaskGraph::TaskId previous = chain.addTask([]() {});
+      for (size_t i = 1; i < kNumTasks; ++i)
+      {
+        const TaskGraph::TaskId next = chain.addTask([]() {});
+        chain.precede(previous, next);
+        previous = next;
+      }
+      for (size_t i = 2; i < kNumTasks; ++i)
+      {
+        const TaskGraph::TaskId middle = fan.addTask([]() {});
+        fan.precede(source, middle);
+        fan.precede(middle, sink);
+      }
+
+      runner.run("task_graph/chain/" + threads, nodes, [&]()
+                 { chain.run(pool); });
+      runner.run("task_graph/fan_out_in/" + threads, nodes, [&]()
+                 { fan.run(pool); });
+    }
+
+    // Loop over a cheap body, where per chunk overhead matters, against the
+    // same loop run serially
+    void benchmarkLoops(Runner &runner, ThreadPool &pool, const std::string &threads)
+    {
+      const size_t n = 1U << 20U;
+      std::vector<double> values(n);
+      for (size_t i = 0; i < n; ++i)
+      {
+        values[i] = static_cast<double>(i);
+      }
+      std::vector<double> roots(n);
+      const Throughput items = Throughput::items(static_cast<double>(n));
+
+      runner.run("parallel_for/sqrt/" + threads, items, [&]()
+                 {
+                   parallel::parallelFor(0U, n, 4096U, [&](const size_t begin, const size_t end)
+                                         {
+                                           for (size_t i = begin; i < end; ++i)
+                                           {
+                                             roots[i] = std::sqrt(values[i]);
+                                           }
+                                         },
+                                         pool);
+                   doNotOptimize(roots.data()); });
+      runner.run("parallel_reduce/sum/" + threads, items, [&]()
+                 {
+                   doNotOptimize(parallel::parallelReduce(
+                       0U, n, 4096U, 0.0,
+                       [&](const size_t begin, const size_t end)
+                       {
+                         double sum = 0.0;
+                         for (size_t i = begin; i < end; ++i)
+                         {
+                           sum += values[i];
+                         }
+                         return sum;
+                       },
+                       [](const double a, const double b)
+                       { return a + b; },
+                       pool)); });
+    }
+
+    void benchmarkSerialBaselines(Runner &runner)
+    {
+      const size_t n = 1U << 20U;
+      std::vector<double> values(n);
+      for (size_t i = 0; i < n; ++i)
+      {
+        values[i] = static_cast<double>(i);
+      }
+      std::vector<double> roots(n);
+      const Throughput items = Throughput::items(static_cast<double>(n));
+
+      runner.run("serial/sqrt", items, [&]()
+                 {
+                   for (size_t i = 0; i < n; ++i)
+                   {
+                     roots[i] = std::sqrt(values[i]);
+                   }
+                   doNotOptimize(roots.data()); });
+      runner.run("serial/sum", items, [&]()
+                 {
+                   double sum = 0.0;
+                   for (const double value : values)
+                   {
+                     sum += value;
+                   }
+                   doNotOptimize(sum); });
+      // What each task would cost with a thread of its own
+      runner.run("thread_spawn_join", Throughput::items(1.0), [&]()
+                 {
+                   std::thread thread([]() {});
+                   thread.join(); });
+    }
+  } // namespace
+} // namespace lumos
+
+int main(int argc, char **argv)
+{
+  lumos::benchmark::Runner runner(argc, argv);
+
+  lumos::benchmarkSerialBaselines(runner);
+  lumos::parallel::ThreadPool single(1U);
+  // The default pool has one thread per CPU, the count is in the JSON context
+  lumos::parallel::ThreadPool &all = lumos::parallel::defaultThreadPool();
+  for (const auto &[pool, threads] : {std::make_pair(&single, std::string("threads_1")),
+                                      std::make_pair(&all, std::string("default_pool"))})
+  {
+    lumos::benchmarkTaskOverhead(runner, *pool, threads);
+    lumos::benchmarkTaskGraph(runner, *pool, threads);
+    lumos::benchmarkLoops(runner, *pool, threads);
+  }
+
+  return runner.finish();
+}
@@ -0,0 +1,92 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "harness/benchmark.h"
+#include "lumos/plotting/fillable_uint8_array.h"
+
+namespace
+{
+  using lumos::benchmark::doNotOptimize;
+  using lumos::benchmark::Runner;
+  using lumos::benchmark::Throughput;
+
+  // Fixed part of a plot command ahead of the payload
+  struct CommandHeader
+  {
+    uint8_t function;
+    uint8_t data_type;
+    uint32_t num_elements;
+    uint32_t num_bytes_per_element;
+    uint8_t num_buffers;
+  };
+
+  template <typename T>
+  void benchmarkSerialization(Runner &runner, const std::string &type, const size_t n)
+  {
+    std::vector<T> x(n);
+    std::vector<T> y(n);
+    std::vector<T> z(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+      x[i] = static_cast<T>(i);
+      y[i] = static_cast<T>(std::sin(0.01 * static_cast<double>(i)));
+      z[i] = static_cast<T>(std::cos(0.01 * static_cast<double>(i)));
+    }
+    const CommandHeader header{1U, 2U, static_cast<uint32_t>(n), sizeof(T), 3U};
+    const size_t num_bytes = sizeof(CommandHeader) + 3U * n * sizeof(T);
+    const Throughput bytes = Throughput::bytes(static_cast<double>(num_bytes));
+    const std::string suffix = type + "/" + std::to_string(n);
+
+    runner.run("serialize/plot3/" + suffix, bytes, [&]()
+               {
+                 FillableUInt8Array buffer(num_bytes);
+                 buffer.fillWithStaticType(header);
+                 buffer.fillWithDataFromPointer(x.data(), n);
+                 buffer.fillWithDataFromPointer(y.data(), n);
+                 buffer.fillWithDataFromPointer(z.data(), n);
+                 doNotOptimize(buffer.data()); });
+    // Element by element, as a serializer walking a container without
+    // contiguous storage would
+    runner.run("serialize/plot3_per_element/" + suffix, bytes, [&]()
+               {
+                 FillableUInt8Array buffer(num_bytes);
+                 buffer.fillWithStaticType(header);
+                 for (const std::vector<T> *const v : {&x, &y, &z})
+                 {
+                   for (const T value : *v)
+                   {
+                     buffer.fillWithStaticType(value);
+                   }
+                 }
+                 doNotOptimize(buffer.data()); });
+    // Plain copies into a reused buffer, the floor for the above
+    std::vector<uint8_t> raw(num_bytes);
+    runner.run("serialize/memcpy_baseline/" + suffix, bytes, [&]()
+               {
+                 uint8_t *dst = raw.data();
+                 std::memcpy(dst, &header, sizeof(header));
+                 dst += sizeof(header);
+                 for (const std::vector<T> *const v : {&x, &y, &z})
+                 {
+                   std::memcpy(dst, v->data(), n * sizeof(T));
+                   dst += n * sizeof(T);
+                 }
+                 doNotOptimize(raw.data()); });
+  }
+} // namespace
+
+int main(int argc, char **argv)
+{
+  Runner runner(argc, argv);
+
+  for (const size_t n : {1000U, 100000U})
+  {
+    benchmarkSerialization<float>(runner, "float", n);
+    benchmarkSerialization<double>(runner, "double", n);
+  }
+
+  return runner.finish();
+}
@@ -0,0 +1,120 @@
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "harness/benchmark.h"
+#include "lumos/math/math.h"
+
+namespace lumos
+{
+  namespace
+  {
+    using benchmark::doNotOptimize;
+    using benchmark::Runner;
+    using benchmark::Throughput;
+
+    std::vector<Point3d> randomCloud(const size_t n, const uint32_t seed)
+    {
+      std::mt19937 rng(seed);
+      std::uniform_real_distribution<double> dist(0.0, 10.0);
+      std::vector<Point3d> cloud(n);
+      for (Point3d &p : cloud)
+      {
+        p = Point3d(dist(rng), dist(rng), dist(rng));
+      }
+      return cloud;
+    }
+
+    void benchmarkKdTree(Runner &runner, const size_t n)
+    {
+      const std::vector<Point3d> cloud = randomCloud(n, 1U);
+      const std::vector<Point3d> queries = randomCloud(1000U, 2U);
+      const std::string size = std::to_string(n);
+      const Throughput points = Throughput::items(static_cast<double>(n));
+      const Throughput num_queries = Throughput::items(static_cast<double>(queries.size()));
+
+      runner.run("kd_tree/build/threads_1/" + size, points, [&]()
+                 { doNotOptimize(KDTreed(cloud, 16U, 1U)); });
+      runner.run("kd_tree/build/" + size, points, [&]()
+                 { doNotOptimize(KDTreed(cloud)); });
+      runner.run("kd_tree/insert/" + size, points, [&]()
+                 {
+                   KDTreed tree;
+                   tree.insert(cloud.data(), cloud.size());
+                   doNotOptimize(tree.size()); });
+
+      const KDTreed tree(cloud);
+      runner.run("kd_tree/nearest/" + size, num_queries, [&]()
+                 {
+                   for (const Point3d &q : queries)
+                   {
+                     doNotOptimize(tree.nearest(q));
+                   }
+                 });
+      runner.run("kd_tree/knn_8/" + size, num_queries, [&]()
+                 {
+                   for (const Point3d &q : queries)
+                   {
+                     doNotOptimize(tree.knnSearch(q, 8U));
+                   }
+                 });
+      runner.run("kd_tree/knn_8_batch/" + size, num_queries, [&]()
+                 { doNotOptimize(tree.knnSearch(queries.data(), queries.size(), 8U)); });
+      runner.run("kd_tree/radius_0.5/" + size, num_queries, [&]()
+                 {
+                   for (const Point3d &q : queries)
+                   {
+                     doNotOptimize(tree.radiusSearch(q, 0.5));
+                   }
+                 });
+    }
+
+    void benchmarkVoxelGrid(Runner &runner, const size_t n)
+    {
+      const std::vector<Point3d> cloud = randomCloud(n, 3U);
+      const std::vector<Point3d> queries = randomCloud(1000U, 4U);
+      const std::string size = std::to_string(n);
+      const Throughput num_queries = Throughput::items(static_cast<double>(queries.size()));
+
+      runner.run("voxel_grid/insert/" + size, Throughput::items(static_cast<double>(n)), [&]()
+                 {
+                   VoxelHashGridd grid(0.5);
+                   grid.insert(cloud.data(), cloud.size());
+                   doNotOptimize(grid.numOccupiedVoxels()); });
+
+      VoxelHashGridd grid(0.5);
+      grid.insert(cloud.data(), cloud.size());
+      runner.run("voxel_grid/radius_0.5/" + size, num_queries, [&]()
+                 {
+                   for (const Point3d &q : queries)
+                   {
+                     doNotOptimize(grid.radiusSearch(q, 0.5));
+                   }
+                 });
+      runner.run("voxel_grid/radius_0.5_batch/" + size, num_queries, [&]()
+                 { doNotOptimize(grid.radiusSearch(queries.data(), queries.size(), 0.5)); });
+      runner.run("voxel_grid/count_0.5/" + size, num_queries, [&]()
+                 {
+                   size_t count = 0U;
+                   for (const Point3d &q : queries)
+                   {
+                     count += grid.countWithinRadius(q, 0.5);
+                   }
+                   doNotOptimize(count); });
+    }
+  } // namespace
+} // namespace lumos
+
+int main(int argc, char **argv)
+{
+  lumos::benchmark::Runner runner(argc, argv);
+
+  for (const size_t n : {10000U, 200000U})
+  {
+    lumos::benchmarkKdTree(runner, n);
+    lumos::benchmarkVoxelGrid(runner, n);
+  }
+
+  return runner.finish();
+}
@@ -0,0 +1,204 @@
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "harness/benchmark.h"
+#include "harness/count_allocations.h"
+#include "lumos/string/string.impl.h"
+#include "lumos/string/string_interner.impl.h"
+
+namespace
+{
+  using lumos::benchmark::doNotOptimize;
+  using lumos::benchmark::Runner;
+  using lumos::benchmark::Throughput;
+
+  // Lines of comma separated random lowercase words
+  std::string randomText(const size_t num_bytes)
+  {
+    std::mt19937 rng(9U);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::uniform_int_distribution<int> word_length(2, 9);
+    std::string text;
+    text.reserve(num_bytes + 16U);
+    size_t words_in_line = 0U;
+    while (text.size() < num_bytes)
+    {
+      const int length = word_length(rng);
+      for (int i = 0; i < length; ++i)
+      {
+        text.push_back(static_cast<char>(letter(rng)));
+      }
+      text.push_back(++words_in_line % 12U == 0U ? '\n' : ',');
+    }
+    return text;
+  }
+
+  std::vector<std::string> patterns(const size_t num_patterns)
+  {
+    std::mt19937 rng(10U);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::vector<std::string> result(num_patterns);
+    for (std::string &pattern : result)
+    {
+      for (int i = 0; i < 4; ++i)
+      {
+        pattern.push_back(static_cast<char>(letter(rng)));
+      }
+    }
+    return result;
+  }
+
+  void benchmarkSplitAndTransform(Runner &runner, const std::string &text)
+  {
+    const Throughput bytes = Throughput::bytes(static_cast<double>(text.size()));
+    std::vector<std::string_view> tokens;
+
+    runner.run("split/string", bytes, [&]()
+               { doNotOptimize(split(text, ",")); });
+    runner.run("split/view", bytes, [&]()
+               { doNotOptimize(splitView(text, ",")); });
+    runner.run("split/into_reused", bytes, [&]()
+               { doNotOptimize(splitInto(text, ",", tokens)); });
+    runner.run("split/lazy", bytes, [&]()
+               {
+                 size_t total = 0U;
+                 for (const std::string_view token : splitLazy(text, ","))
+                 {
+                   total += token.size();
+                 }
+                 doNotOptimize(total); });
+
+    std::string work;
+    runner.run("to_upper/copy", bytes, [&]()
+               { doNotOptimize(toUpperCase(text)); });
+    runner.run("to_upper/in_place", bytes, [&]()
+               {
+                 work = text;
+                 toUpperCaseInPlace(work);
+                 doNotOptimize(work.data()); });
+    runner.run("replace/copy", bytes, [&]()
+               { doNotOptimize(replace(text, ",", ";;")); });
+    runner.run("replace/in_place", bytes, [&]()
+               {
+                 work = text;
+                 replaceInPlace(work, ",", ";;");
+                 doNotOptimize(work.data()); });
+  }
+
+  void benchmarkTrimAndJoin(Runner &runner, const std::string &text)
+  {
+    const std::vector<std::string> words = split(text, ",");
+    std::vector<std::string> padded;
+    padded.reserve(words.size());
+    for (const std::string &word : words)
+    {
+      padded.push_back("  " + word + " \t");
+    }
+    const std::vector<std::string_view> views(words.begin(), words.end());
+    const Throughput items = Throughput::items(static_cast<double>(words.size()));
+    const Throughput bytes = Throughput::bytes(static_cast<double>(text.size()));
+
+    runner.run("trim/copy", items, [&]()
+               {
+                 for (const std::string &word : padded)
+                 {
+                   doNotOptimize(trim(word));
+                 }
+               });
+    runner.run("trim/view", items, [&]()
+               {
+                 for (const std::string &word : padded)
+                 {
+                   doNotOptimize(trimView(word));
+                 }
+               });
+    std::string work;
+    runner.run("trim/in_place_reused", items, [&]()
+               {
+                 for (const std::string &word : padded)
+                 {
+                   work.assign(word);
+                   trimInPlace(work);
+                   doNotOptimize(work.data());
+                 }
+               });
+
+    runner.run("join/string", bytes, [&]()
+               { doNotOptimize(join(words, ",")); });
+    std::string joined;
+    runner.run("join/into_reused", bytes, [&]()
+               {
+                 joinInto(views, ",", joined);
+                 doNotOptimize(joined.data()); });
+  }
+
+  void benchmarkMultiPattern(Runner &runner, const std::string &text, const size_t num_patterns)
+  {
+    const std::vector<std::string> needles = patterns(num_patterns);
+    const std::vector<std::string> replacements(num_patterns, "XX");
+    const MultiPatternMatcher matcher(needles);
+    const Throughput bytes = Throughput::bytes(static_cast<double>(text.size()));
+    const std::string suffix = "/patterns_" + std::to_string(num_patterns);
+
+    runner.run("multi_pattern/compile" + suffix, [&]()
+               { doNotOptimize(MultiPatternMatcher(needles)); });
+    runner.run("multi_pattern/count_all" + suffix, bytes, [&]()
+               { doNotOptimize(matcher.countAll(text)); });
+    // One scan per pattern, what countAll replaces
+    runner.run("multi_pattern/count_each" + suffix, bytes, [&]()
+               {
+                 size_t total = 0U;
+                 for (const std::string &needle : needles)
+                 {
+                   total += count(text, needle);
+                 }
+                 doNotOptimize(total); });
+    runner.run("multi_pattern/replace_all" + suffix, bytes, [&]()
+               { doNotOptimize(matcher.replaceAll(text, replacements)); });
+  }
+
+  void benchmarkInterning(Runner &runner, const std::string &text)
+  {
+    const std::vector<std::string_view> words = splitView(text, ",");
+    const Throughput items = Throughput::items(static_cast<double>(words.size()));
+
+    StringInterner warm;
+    for (const std::string_view word : words)
+    {
+      warm.intern(word);
+    }
+    runner.run("intern/existing", items, [&]()
+               {
+                 for (const std::string_view word : words)
+                 {
+                   doNotOptimize(warm.intern(word));
+                 }
+               });
+    runner.run("intern/new_pool", items, [&]()
+               {
+                 StringInterner pool;
+                 for (const std::string_view word : words)
+                 {
+                   doNotOptimize(pool.intern(word));
+                 }
+               });
+  }
+} // namespace
+
+int main(int argc, char **argv)
+{
+  Runner runner(argc, argv);
+
+  const std::string text = randomText(1U << 20U);
+  benchmarkSplitAndTransform(runner, text);
+  benchmarkTrimAndJoin(runner, randomText(1U << 18U));
+  for (const size_t num_patterns : {1U, 8U, 64U})
+  {
+    benchmarkMultiPattern(runner, text, num_patterns);
+  }
+  benchmarkInterning(runner, randomText(1U << 18U));
+
+  return runner.finish();
+}
@@ -0,0 +1,185 @@
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "harness/benchmark.h"
+#include "lumos/math/math.h"
+
+namespace lumos
+{
+  namespace
+  {
+    using benchmark::doNotOptimize;
+    using benchmark::Runner;
+    using benchmark::Throughput;
+
+    Vec3d randomVector(std::mt19937 &rng, const double scale)
+    {
+      std::uniform_real_distribution<double> dist(-scale, scale);
+      return Vec3d(dist(rng), dist(rng), dist(rng));
+    }
+
+    void benchmarkLieGroups(Runner &runner)
+    {
+      std::mt19937 rng(3U);
+      const Vec3d omega = randomVector(rng, 1.0);
+      const SO3d rotation = SO3d::exp(omega);
+      const SO3d other_rotation = SO3d::exp(randomVector(rng, 1.0));
+
+      SE3d::Tangent xi;
+      Sim3d::Tangent zeta;
+      for (size_t i = 0; i < 6; ++i)
+      {
+        xi(i, 0) = 0.1 * static_cast<double>(i + 1U);
+        zeta(i, 0) = xi(i, 0);
+      }
+      zeta(6, 0) = 0.2;
+      const SE3d pose = SE3d::exp(xi);
+      const SE3d other_pose(other_rotation, Vec3d(1.0, 2.0, 3.0));
+      const Sim3d similarity = Sim3d::exp(zeta);
+
+      runner.run("so3/exp", [&]()
+                 { doNotOptimize(SO3d::exp(omega)); });
+      runner.run("so3/log", [&]()
+                 { doNotOptimize(rotation.log()); });
+      runner.run("so3/compose", [&]()
+                 { doNotOptimize(rotation * other_rotation); });
+      runner.run("so3/right_jacobian_inverse", [&]()
+                 { doNotOptimize(SO3d::rightJacobianInverse(omega)); });
+      runner.run("se3/exp", [&]()
+                 { doNotOptimize(SE3d::exp(xi)); });
+      runner.run("se3/log", [&]()
+                 { doNotOptimize(pose.log()); });
+      runner.run("se3/compose", [&]()
+                 { doNotOptimize(pose * other_pose); });
+      runner.run("se3/left_jacobian", [&]()
+                 { doNotOptimize(SE3d::leftJacobian(xi)); });
+      runner.run("sim3/exp", [&]()
+                 { doNotOptimize(Sim3d::exp(zeta)); });
+      runner.run("sim3/log", [&]()
+                 { doNotOptimize(similarity.log()); });
+    }
+
+    void benchmarkBatchPoses(Runner &runner, const size_t n)
+    {
+      std::mt19937 rng(5U);
+      std::vector<SE3d> a(n);
+      std::vector<SE3d> b(n);
+      std::vector<SE3d> composed(n);
+      std::vector<Vec3d> points(n);
+      std::vector<Vec3d> transformed(n);
+      for (size_t i = 0; i < n; ++i)
+      {
+        a[i] = SE3d(SO3d::exp(randomVector(rng, 1.0)), randomVector(rng, 10.0));
+        b[i] = SE3d(SO3d::exp(randomVector(rng, 1.0)), randomVector(rng, 10.0));
+        points[i] = randomVector(rng, 10.0);
+      }
+
+      const Throughput items = Throughput::items(static_cast<double>(n));
+      const std::string size = std::to_string(n);
+      runner.run("se3/batch_compose/" + size, items, [&]()
+                 {
+                   SE3d::compose(a.data(), b.data(), composed.data(), n);
+                   doNotOptimize(composed.data()); });
+      runner.run("se3/batch_transform/" + size, items, [&]()
+                 {
+                   SE3d::transform(a.data(), points.data(), transformed.data(), n);
+                   doNotOptimize(transformed.data()); });
+      runner.run("se3/transform_one_pose/" + size, items, [&]()
+                 {
+                   a[0].transform(points.data(), transformed.data(), n);
+                   doNotOptimize(transformed.data()); });
+    }
+
+    void benchmarkBatchRotations(Runner &runner, const size_t n)
+    {
+      std::mt19937 rng(11U);
+      std::uniform_real_distribution<double> angle(-3.0, 3.0);
+      EulerAnglesArray<double> euler(n);
+      PointArray3D<double> vectors(n);
+      PointArray3D<double> rotation_vectors(n);
+      std::vector<Quaternion<double>> aos_quaternions(n);
+      std::vector<Vec3d> aos_vectors(n);
+      for (size_t i = 0; i < n; ++i)
+      {
+        euler.setAngles(i, EulerAngles<double>(angle(rng), 0.5 * angle(rng), angle(rng)));
+        const Vec3d v = randomVector(rng, 1.0);
+        vectors.setPoint(i, v);
+        rotation_vectors.setPoint(i, randomVector(rng, 1.0));
+        aos_vectors[i] = v;
+      }
+
+      QuaternionArray<double> quaternions(n);
+      QuaternionArray<double> other(n);
+      QuaternionArray<double> out(n);
+      EulerAnglesArray<double> euler_out(n);
+      PointArray3D<double> rotated(n);
+      std::vector<FixedSizeMatrix<double, 3, 3>> matrices(n);
+      std::vector<Vec3d> aos_rotated(n);
+      eulerAnglesToQuaternions(euler, quaternions);
+      rotationVectorsToQuaternions(rotation_vectors, other);
+      for (size_t i = 0; i < n; ++i)
+      {
+        aos_quaternions[i] = quaternions.quaternion(i);
+      }
+
+      const Throughput items = Throughput::items(static_cast<double>(n));
+      const std::string size = std::to_string(n);
+      runner.run("batch/euler_to_quaternion/" + size, items, [&]()
+                 {
+                   eulerAnglesToQuaternions(euler, out);
+                   doNotOptimize(out.w.data()); });
+      runner.run("batch/quaternion_to_euler/" + size, items, [&]()
+                 {
+                   quaternionsToEulerAngles(quaternions, euler_out);
+                   doNotOptimize(euler_out.roll.data()); });
+      runner.run("batch/quaternion_to_matrix/" + size, items, [&]()
+                 {
+                   quaternionsToRotationMatrices(quaternions, matrices);
+                   doNotOptimize(matrices.data()); });
+      runner.run("batch/matrix_to_quaternion/" + size, items, [&]()
+                 {
+                   rotationMatricesToQuaternions(matrices, out);
+                   doNotOptimize(out.w.data()); });
+      runner.run("batch/rotation_vector_to_quaternion/" + size, items, [&]()
+                 {
+                   rotationVectorsToQuaternions(rotation_vectors, out);
+                   doNotOptimize(out.w.data()); });
+      runner.run("batch/multiply/" + size, items, [&]()
+                 {
+                   multiplyQuaternions(quaternions, other, out);
+                   doNotOptimize(out.w.data()); });
+      runner.run("batch/slerp/" + size, items, [&]()
+                 {
+                   slerpQuaternions(quaternions, other, 0.3, out);
+                   doNotOptimize(out.w.data()); });
+      runner.run("batch/rotate_vectors/" + size, items, [&]()
+                 {
+                   rotateVectors(quaternions, vectors, rotated);
+                   doNotOptimize(rotated.x.data()); });
+      // The same rotations one quaternion at a time on arrays of structs
+      runner.run("scalar/rotate_vectors/" + size, items, [&]()
+                 {
+                   for (size_t i = 0; i < n; ++i)
+                   {
+                     aos_rotated[i] = SO3d(aos_quaternions[i]) * aos_vectors[i];
+                   }
+                   doNotOptimize(aos_rotated.data()); });
+    }
+  } // namespace
+} // namespace lumos
+
+int main(int argc, char **argv)
+{
+  lumos::benchmark::Runner runner(argc, argv);
+
+  lumos::benchmarkLieGroups(runner);
+  lumos::benchmarkBatchPoses(runner, 4096U);
+  for (const size_t n : {1024U, 65536U})
+  {
+    lumos::benchmarkBatchRotations(runner, n);
+  }
+
+  return runner.finish();
+}
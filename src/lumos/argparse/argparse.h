@@ -9,6 +9,8 @@
 #include <string>
 #include <vector>
 
+#include "lumos/number_conversion.h"
+
 namespace lumos {
 namespace argparse {
 
@@ -82,8 +84,8 @@ private:
 
     // Type conversion helpers
     std::string toString(const std::string& val) const { return val; }
-    std::string toString(int val) const { return std::to_string(val); }
-    std::string toString(double val) const { return std::to_string(val); }
+    std::string toString(int val) const { return lumos::internal::formatNumber(val); }
+    std::string toString(double val) const { return lumos::internal::formatFixed(val, 6); }
     std::string toString(bool val) const { return val ? "true" : "false"; }
     std::string toString(const std::vector<std::string>& val) const {
         std::string result = "[";
@@ -105,7 +107,7 @@ private:
 
     int toInt(const std::string& val) const {
         try {
-            return std::stoi(val);
+            return lumos::internal::parseNumber<int>(val);
         } catch (const std::exception& e) {
             throw ArgumentTypeError("Cannot convert '" + val + "' to int");
         }
@@ -119,7 +121,7 @@ private:
 
     double toDouble(const std::string& val) const {
         try {
-            return std::stod(val);
+            return lumos::internal::parseNumber<double>(val);
         } catch (const std::exception& e) {
             throw ArgumentTypeError("Cannot convert '" + val + "' to double");
         }
@@ -429,7 +431,7 @@ private:
                 break;
             case Argument::Type::INT:
                 if (!arg->getDefaultValue().empty()) {
-                    int default_val = std::stoi(arg->getDefaultValue());
+                    int default_val = lumos::internal::parseNumber<int>(arg->getDefaultValue());
                     parsed_values_[canonical_name] = std::make_shared<TypedArgumentValue<int>>(default_val);
                 } else {
                     parsed_values_[canonical_name] = std::make_shared<TypedArgumentValue<int>>();
@@ -437,7 +439,7 @@ private:
                 break;
             case Argument::Type::DOUBLE:
                 if (!arg->getDefaultValue().empty()) {
-                    double default_val = std::stod(arg->getDefaultValue());
+                    double default_val = lumos::internal::parseNumber<double>(arg->getDefaultValue());
                     parsed_values_[canonical_name] = std::make_shared<TypedArgumentValue<double>>(default_val);
                 } else {
                     parsed_values_[canonical_name] = std::make_shared<TypedArgumentValue<double>>();
@@ -525,7 +527,7 @@ private:
             }
             case Argument::Type::INT: {
                 try {
-                    int int_value = std::stoi(value);
+                    int int_value = lumos::internal::parseNumber<int>(value);
                     auto typed_value = std::dynamic_pointer_cast<TypedArgumentValue<int>>(parsed_values_[canonical_name]);
                     typed_value->set(int_value);
                 } catch (const std::exception& e) {
@@ -535,7 +537,7 @@ private:
             }
             case Argument::Type::DOUBLE: {
                 try {
-                    double double_value = std::stod(value);
+                    double double_value = lumos::internal::parseNumber<double>(value);
                     auto typed_value = std::dynamic_pointer_cast<TypedArgumentValue<double>>(parsed_values_[canonical_name]);
                     typed_value->set(double_value);
                 } catch (const std::exception& e) {
@@ -0,0 +1,8 @@
+#ifndef LUMOS_CONCURRENCY_CONCURRENCY_H_
+#define LUMOS_CONCURRENCY_CONCURRENCY_H_
+
+#include "lumos/concurrency/mpmc_ring_buffer.h"
+#include "lumos/concurrency/spsc_ring_buffer.h"
+#include "lumos/concurrency/wait_strategy.h"
+
+#endif // LUMOS_CONCURRENCY_CONCURRENCY_H_
@@ -0,0 +1,380 @@
+#ifndef LUMOS_CONCURRENCY_MPMC_RING_BUFFER_H_
+#define LUMOS_CONCURRENCY_MPMC_RING_BUFFER_H_
+
+#include "lumos/concurrency/spsc_ring_buffer.h"
+#include "lumos/concurrency/wait_strategy.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace lumos
+{
+  namespace concurrency
+  {
+    // Bounded lock-free queue for any number of producer and consumer threads,
+    // after Dmitry Vyukov's bounded MPMC queue. The capacity is rounded up to
+    // a power of two, at least 2.
+    //
+    // Every slot carries a sequence number that says whose turn it is: a slot
+    // at position p is free for the producer of p when its sequence is p and
+    // holds data for the consumer of p when it is p + 1. Producers and
+    // consumers claim positions with a compare-exchange on their own index
+    // and then only touch their slots, so the two sides never contend with
+    // each other, and slots are padded to a cache line so that neighbours do
+    // not either. The batch functions claim a run of consecutive slots with
+    // one compare-exchange.
+    //
+    // If constructing an element in a claimed slot throws, the slot is
+    // published as empty and the exception rethrown. Consumers skip empty
+    // slots, so the position does not block the queue. size() counts them
+    // until they are skipped.
+    //
+    // try* functions never block. push / pop and the batch variants without
+    // try wait with a SpinThenParkWaiter. pop() needs a default
+    // constructible T
+    template <typename T>
+    class MpmcRingBuffer
+    {
+    public:
+      explicit MpmcRingBuffer(const size_t capacity)
+          : capacity_(internal::ringBufferCapacity(std::max<size_t>(capacity, 2U))),
+            mask_(capacity_ - 1U), slots_(new Slot[capacity_]), enqueue_index_(0U),
+            dequeue_index_(0U)
+      {
+        for (size_t i = 0; i < capacity_; ++i)
+        {
+          slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+      }
+
+      MpmcRingBuffer(const MpmcRingBuffer &) = delete;
+      MpmcRingBuffer &operator=(const MpmcRingBuffer &) = delete;
+
+      ~MpmcRingBuffer()
+      {
+        const size_t end = enqueue_index_.load(std::memory_order_relaxed);
+        for (size_t i = dequeue_index_.load(std::memory_order_relaxed); i != end; ++i)
+        {
+          Slot &slot = slots_[i & mask_];
+          if (slot.has_value)
+          {
+            slot.storage.get()->~T();
+          }
+        }
+      }
+
+      // Producer side
+
+      template <typename... Args>
+      bool tryEmplace(Args &&...args)
+      {
+        size_t index = 0U;
+        if (claim(enqueue_index_, 0U, 1U, index) == 0U)
+        {
+          return false;
+        }
+        try
+        {
+          construct(index, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+          publishEmpty(index, 1U);
+          throw;
+        }
+        not_empty_.notifyAll();
+        return true;
+      }
+
+      bool tryPush(const T &value)
+      {
+        return tryEmplace(value);
+      }
+
+      bool tryPush(T &&value)
+      {
+        return tryEmplace(std::move(value));
+      }
+
+      // Copies up to count elements from first (use std::make_move_iterator
+      // to move them) into consecutive slots and returns how many fit
+      template <typename InputIt>
+      size_t tryPushBatch(InputIt first, const size_t count)
+      {
+        size_t index = 0U;
+        const size_t num_pushed = claim(enqueue_index_, 0U, count, index);
+        for (size_t i = 0; i < num_pushed; ++i, ++first)
+        {
+          try
+          {
+            construct(index + i, *first);
+          }
+          catch (...)
+          {
+            // The rest of the claimed run is given up as well
+            publishEmpty(index + i, num_pushed - i);
+            throw;
+          }
+        }
+        if (num_pushed > 0U)
+        {
+          not_empty_.notifyAll();
+        }
+        return num_pushed;
+      }
+
+      void push(T value)
+      {
+        while (!tryPush(std::move(value)))
+        {
+          not_full_.wait([this]()
+                         { return !full(); });
+        }
+      }
+
+      // Pushes all count elements, waiting for space as needed. Elements of
+      // other producers can end up between them
+      template <typename ForwardIt>
+      void pushBatch(ForwardIt first, size_t count)
+      {
+        while (count > 0U)
+        {
+          const size_t num_pushed = tryPushBatch(first, count);
+          std::advance(first, num_pushed);
+          count -= num_pushed;
+          if (count > 0U)
+          {
+            not_full_.wait([this]()
+                           { return !full(); });
+          }
+        }
+      }
+
+      // Consumer side
+
+      bool tryPop(T &value)
+      {
+        size_t index = 0U;
+        while (claim(dequeue_index_, 1U, 1U, index) != 0U)
+        {
+          const bool has_value = release(index, value);
+          not_full_.notifyAll();
+          if (has_value)
+          {
+            return true;
+          }
+        }
+        return false;
+      }
+
+      // Moves up to max_count elements from consecutive slots to out and
+      // returns how many there were. Can return 0 after skipping empty slots
+      template <typename OutputIt>
+      size_t tryPopBatch(OutputIt out, const size_t max_count)
+      {
+        size_t index = 0U;
+        const size_t num_claimed = claim(dequeue_index_, 1U, max_count, index);
+        size_t num_popped = 0U;
+        for (size_t i = 0; i < num_claimed; ++i)
+        {
+          if (release(index + i, *out))
+          {
+            ++out;
+            ++num_popped;
+          }
+        }
+        if (num_claimed > 0U)
+        {
+          not_full_.notifyAll();
+        }
+        return num_popped;
+      }
+
+      T pop()
+      {
+        T value;
+        while (!tryPop(value))
+        {
+          not_empty_.wait([this]()
+                          { return !empty(); });
+        }
+        return value;
+      }
+
+      // Waits for at most timeout for an element
+      template <typename Rep, typename Period>
+      bool tryPopFor(T &value, const std::chrono::duration<Rep, Period> &timeout)
+      {
+        const std::chrono::steady_clock::time_point deadline =
+            std::chrono::steady_clock::now() + timeout;
+        while (!tryPop(value))
+        {
+          if (!not_empty_.waitUntil([this]()
+                                    { return !empty(); },
+                                    deadline))
+          {
+            return false;
+          }
+        }
+        return true;
+      }
+
+      // Waits for at least one element, then pops up to max_count
+      template <typename OutputIt>
+      size_t popBatch(OutputIt out, const size_t max_count)
+      {
+        size_t num_popped = 0U;
+        while (max_count > 0U && (num_popped = tryPopBatch(out, max_count)) == 0U)
+        {
+          not_empty_.wait([this]()
+                          { return !empty(); });
+        }
+        return num_popped;
+      }
+
+      // Snapshot of the number of claimed but not yet consumed elements,
+      // elements that are still being written count as present
+      size_t size() const
+      {
+        const size_t dequeue_index = dequeue_index_.load(std::memory_order_acquire);
+        const size_t enqueue_index = enqueue_index_.load(std::memory_order_acquire);
+        return enqueue_index > dequeue_index ? enqueue_index - dequeue_index : 0U;
+      }
+
+      bool empty() const
+      {
+        return size() == 0U;
+      }
+
+      bool full() const
+      {
+        return size() >= capacity_;
+      }
+
+      size_t capacity() const
+      {
+        return capacity_;
+      }
+
+    private:
+      struct alignas(kCacheLineSize) Slot
+      {
+        std::atomic<size_t> sequence;
+        bool has_value; // False if constructing the element threw
+        internal::RingBufferSlot<T> storage;
+      };
+
+      // Claims up to max_count consecutive positions from index, the ones
+      // whose slots have sequence position + offset (0 to write, 1 to read).
+      // Returns the number claimed and their first position in first_index
+      size_t claim(std::atomic<size_t> &index, const size_t offset,
+                   const size_t max_count, size_t &first_index)
+      {
+        if (max_count == 0U)
+        {
+          return 0U;
+        }
+
+        size_t position = index.load(std::memory_order_relaxed);
+        while (true)
+        {
+          // A slot whose sequence is behind its turn is still in use by the
+          // previous round, one that is ahead was taken by another thread
+          size_t count = 0U;
+          bool is_stale = false;
+          while (count < max_count)
+          {
+            const size_t expected = position + count + offset;
+            const size_t sequence =
+                slots_[(position + count) & mask_].sequence.load(std::memory_order_acquire);
+            if (sequence != expected)
+            {
+              is_stale = count == 0U &&
+                         static_cast<std::ptrdiff_t>(sequence - expected) > 0;
+              break;
+            }
+            ++count;
+          }
+
+          if (count == 0U && !is_stale)
+          {
+            return 0U;
+          }
+          if (count > 0U &&
+              index.compare_exchange_weak(position, position + count,
+                                          std::memory_order_relaxed,
+                                          std::memory_order_relaxed))
+          {
+            first_index = position;
+            return count;
+          }
+          if (is_stale)
+          {
+            position = index.load(std::memory_order_relaxed);
+          }
+        }
+      }
+
+      // Constructs the element at a claimed write position and hands the
+      // slot to its consumer
+      template <typename... Args>
+      void construct(const size_t position, Args &&...args)
+      {
+        Slot &slot = slots_[position & mask_];
+        new (slot.storage.bytes) T(std::forward<Args>(args)...);
+        slot.has_value = true;
+        slot.sequence.store(position + 1U, std::memory_order_release);
+      }
+
+      // Hands count claimed write positions to their consumers without
+      // elements
+      void publishEmpty(const size_t first_position, const size_t count)
+      {
+        for (size_t i = 0; i < count; ++i)
+        {
+          Slot &slot = slots_[(first_position + i) & mask_];
+          slot.has_value = false;
+          slot.sequence.store(first_position + i + 1U, std::memory_order_release);
+        }
+        not_empty_.notifyAll();
+      }
+
+      // Moves the element at a claimed read position out, if there is one,
+      // and hands the slot to the producer of the next round
+      template <typename Out>
+      bool release(const size_t position, Out &&out)
+      {
+        Slot &slot = slots_[position & mask_];
+        const bool has_value = slot.has_value;
+        if (has_value)
+        {
+          T *const element = slot.storage.get();
+          out = std::move(*element);
+          element->~T();
+        }
+        slot.sequence.store(position + capacity_, std::memory_order_release);
+        return has_value;
+      }
+
+      // Read-only after construction
+      const size_t capacity_;
+      const size_t mask_;
+      const std::unique_ptr<Slot[]> slots_;
+
+      alignas(kCacheLineSize) std::atomic<size_t> enqueue_index_;
+      alignas(kCacheLineSize) std::atomic<size_t> dequeue_index_;
+
+      SpinThenParkWaiter not_empty_;
+      SpinThenParkWaiter not_full_;
+    };
+  } // namespace concurrency
+} // namespace lumos
+
+#endif // LUMOS_CONCURRENCY_MPMC_RING_BUFFER_H_
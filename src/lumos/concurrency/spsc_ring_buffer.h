@@ -0,0 +1,299 @@
+#ifndef LUMOS_CONCURRENCY_SPSC_RING_BUFFER_H_
+#define LUMOS_CONCURRENCY_SPSC_RING_BUFFER_H_
+
+#include "lumos/concurrency/wait_strategy.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace lumos
+{
+  namespace concurrency
+  {
+    namespace internal
+    {
+      inline size_t ringBufferCapacity(const size_t requested_capacity)
+      {
+        if (requested_capacity == 0U)
+        {
+          throw std::invalid_argument("Ring buffer capacity must be greater than 0");
+        }
+        size_t capacity = 1U;
+        while (capacity < requested_capacity)
+        {
+          capacity <<= 1U;
+        }
+        return capacity;
+      }
+
+      // Uninitialized storage for one element
+      template <typename T>
+      struct RingBufferSlot
+      {
+        alignas(T) unsigned char bytes[sizeof(T)];
+
+        T *get()
+        {
+          return std::launder(reinterpret_cast<T *>(bytes));
+        }
+      };
+    } // namespace internal
+
+    // Bounded lock-free queue for exactly one producer thread and one consumer
+    // thread. The capacity is rounded up to a power of two.
+    //
+    // The write index is only written by the producer and the read index only
+    // by the consumer, each on its own cache line together with the side's
+    // cached copy of the other index. The other side's cache line is only
+    // read when the cached copy says the buffer looks full (or empty), so in
+    // steady streaming a push or pop touches no shared line at all. The batch
+    // functions move many elements with one index update.
+    //
+    // try* functions never block. push / pop and the batch variants without
+    // try wait with a SpinThenParkWaiter
+    template <typename T>
+    class SpscRingBuffer
+    {
+    public:
+      explicit SpscRingBuffer(const size_t capacity)
+          : capacity_(internal::ringBufferCapacity(capacity)), mask_(capacity_ - 1U),
+            slots_(new internal::RingBufferSlot<T>[capacity_]), write_index_(0U),
+            cached_read_index_(0U), read_index_(0U), cached_write_index_(0U)
+      {
+      }
+
+      SpscRingBuffer(const SpscRingBuffer &) = delete;
+      SpscRingBuffer &operator=(const SpscRingBuffer &) = delete;
+
+      ~SpscRingBuffer()
+      {
+        const size_t end = write_index_.load(std::memory_order_relaxed);
+        for (size_t i = read_index_.load(std::memory_order_relaxed); i != end; ++i)
+        {
+          slots_[i & mask_].get()->~T();
+        }
+      }
+
+      // Producer side
+
+      template <typename... Args>
+      bool tryEmplace(Args &&...args)
+      {
+        const size_t write_index = write_index_.load(std::memory_order_relaxed);
+        if (write_index - cached_read_index_ == capacity_)
+        {
+          cached_read_index_ = read_index_.load(std::memory_order_acquire);
+          if (write_index - cached_read_index_ == capacity_)
+          {
+            return false;
+          }
+        }
+        new (slots_[write_index & mask_].bytes) T(std::forward<Args>(args)...);
+        write_index_.store(write_index + 1U, std::memory_order_release);
+        not_empty_.notifyAll();
+        return true;
+      }
+
+      bool tryPush(const T &value)
+      {
+        return tryEmplace(value);
+      }
+
+      bool tryPush(T &&value)
+      {
+        return tryEmplace(std::move(value));
+      }
+
+      // Copies up to count elements from first (use std::make_move_iterator
+      // to move them) and returns how many fit
+      template <typename InputIt>
+      size_t tryPushBatch(InputIt first, const size_t count)
+      {
+        const size_t write_index = write_index_.load(std::memory_order_relaxed);
+        if (capacity_ - (write_index - cached_read_index_) < count)
+        {
+          cached_read_index_ = read_index_.load(std::memory_order_acquire);
+        }
+        const size_t num_pushed =
+            std::min(count, capacity_ - (write_index - cached_read_index_));
+        if (num_pushed == 0U)
+        {
+          return 0U;
+        }
+
+        for (size_t i = 0; i < num_pushed; ++i, ++first)
+        {
+          new (slots_[(write_index + i) & mask_].bytes) T(*first);
+        }
+        write_index_.store(write_index + num_pushed, std::memory_order_release);
+        not_empty_.notifyAll();
+        return num_pushed;
+      }
+
+      void push(T value)
+      {
+        while (!tryPush(std::move(value)))
+        {
+          not_full_.wait([this]()
+                         { return !full(); });
+        }
+      }
+
+      // Pushes all count elements, waiting for space as needed
+      template <typename ForwardIt>
+      void pushBatch(ForwardIt first, size_t count)
+      {
+        while (count > 0U)
+        {
+          const size_t num_pushed = tryPushBatch(first, count);
+          std::advance(first, num_pushed);
+          count -= num_pushed;
+          if (count > 0U)
+          {
+            not_full_.wait([this]()
+                           { return !full(); });
+          }
+        }
+      }
+
+      // Consumer side
+
+      bool tryPop(T &value)
+      {
+        const size_t read_index = read_index_.load(std::memory_order_relaxed);
+        if (read_index == cached_write_index_)
+        {
+          cached_write_index_ = write_index_.load(std::memory_order_acquire);
+          if (read_index == cached_write_index_)
+          {
+            return false;
+          }
+        }
+        T *const element = slots_[read_index & mask_].get();
+        value = std::move(*element);
+        element->~T();
+        read_index_.store(read_index + 1U, std::memory_order_release);
+        not_full_.notifyAll();
+        return true;
+      }
+
+      // Moves up to max_count elements to out and returns how many there were
+      template <typename OutputIt>
+      size_t tryPopBatch(OutputIt out, const size_t max_count)
+      {
+        const size_t read_index = read_index_.load(std::memory_order_relaxed);
+        if (cached_write_index_ - read_index < max_count)
+        {
+          cached_write_index_ = write_index_.load(std::memory_order_acquire);
+        }
+        const size_t num_popped = std::min(max_count, cached_write_index_ - read_index);
+        if (num_popped == 0U)
+        {
+          return 0U;
+        }
+
+        for (size_t i = 0; i < num_popped; ++i, ++out)
+        {
+          T *const element = slots_[(read_index + i) & mask_].get();
+          *out = std::move(*element);
+          element->~T();
+        }
+        read_index_.store(read_index + num_popped, std::memory_order_release);
+        not_full_.notifyAll();
+        return num_popped;
+      }
+
+      T pop()
+      {
+        T value;
+        while (!tryPop(value))
+        {
+          not_empty_.wait([this]()
+                          { return !empty(); });
+        }
+        return value;
+      }
+
+      // Waits for at most timeout for an element
+      template <typename Rep, typename Period>
+      bool tryPopFor(T &value, const std::chrono::duration<Rep, Period> &timeout)
+      {
+        const std::chrono::steady_clock::time_point deadline =
+            std::chrono::steady_clock::now() + timeout;
+        while (!tryPop(value))
+        {
+          if (!not_empty_.waitUntil([this]()
+                                    { return !empty(); },
+                                    deadline))
+          {
+            return false;
+          }
+        }
+        return true;
+      }
+
+      // Waits for at least one element, then pops up to max_count
+      template <typename OutputIt>
+      size_t popBatch(OutputIt out, const size_t max_count)
+      {
+        size_t num_popped = 0U;
+        while (max_count > 0U && (num_popped = tryPopBatch(out, max_count)) == 0U)
+        {
+          not_empty_.wait([this]()
+                          { return !empty(); });
+        }
+        return num_popped;
+      }
+
+      // Either side. Exact when called from the producer or consumer thread
+      // while the other side is idle, a snapshot otherwise
+
+      size_t size() const
+      {
+        const size_t read_index = read_index_.load(std::memory_order_acquire);
+        const size_t write_index = write_index_.load(std::memory_order_acquire);
+        return write_index - read_index;
+      }
+
+      bool empty() const
+      {
+        return size() == 0U;
+      }
+
+      bool full() const
+      {
+        return size() >= capacity_;
+      }
+
+      size_t capacity() const
+      {
+        return capacity_;
+      }
+
+    private:
+      // Read-only after construction
+      const size_t capacity_;
+      const size_t mask_;
+      const std::unique_ptr<internal::RingBufferSlot<T>[]> slots_;
+
+      // Producer's cache line
+      alignas(kCacheLineSize) std::atomic<size_t> write_index_;
+      size_t cached_read_index_;
+
+      // Consumer's cache line
+      alignas(kCacheLineSize) std::atomic<size_t> read_index_;
+      size_t cached_write_index_;
+
+      SpinThenParkWaiter not_empty_;
+      SpinThenParkWaiter not_full_;
+    };
+  } // namespace concurrency
+} // namespace lumos
+
+#endif // LUMOS_CONCURRENCY_SPSC_RING_BUFFER_H_
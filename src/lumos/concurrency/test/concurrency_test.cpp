@@ -0,0 +1,395 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lumos/concurrency/concurrency.h"
+
+namespace lumos
+{
+  namespace concurrency
+  {
+    namespace
+    {
+      // Counts live instances, so that tests can check that every element is
+      // destroyed exactly once
+      struct Tracked
+      {
+        static std::atomic<int> num_alive;
+
+        int value;
+
+        Tracked() : value(-1)
+        {
+          ++num_alive;
+        }
+        explicit Tracked(const int v) : value(v)
+        {
+          ++num_alive;
+        }
+        Tracked(const Tracked &other) : value(other.value)
+        {
+          ++num_alive;
+        }
+        Tracked &operator=(const Tracked &other) = default;
+        ~Tracked()
+        {
+          --num_alive;
+        }
+      };
+
+      std::atomic<int> Tracked::num_alive(0);
+
+      // Copying a negative value throws
+      struct ThrowsOnNegative
+      {
+        int value = 0;
+
+        ThrowsOnNegative() = default;
+        explicit ThrowsOnNegative(const int v) : value(v) {}
+        ThrowsOnNegative(const ThrowsOnNegative &other) : value(other.value)
+        {
+          if (value < 0)
+          {
+            throw std::runtime_error("negative");
+          }
+        }
+        ThrowsOnNegative &operator=(const ThrowsOnNegative &other) = default;
+      };
+
+      // Elements carry their producer and a per-producer sequence number
+      uint64_t encode(const uint64_t producer, const uint64_t sequence)
+      {
+        return (producer << 32U) | sequence;
+      }
+    } // namespace
+
+    TEST(SpscRingBufferTest, FifoOrderAndCapacity)
+    {
+      SpscRingBuffer<int> buffer(5);
+      EXPECT_EQ(buffer.capacity(), 8U);
+      EXPECT_TRUE(buffer.empty());
+      EXPECT_THROW(SpscRingBuffer<int>(0), std::invalid_argument);
+
+      for (int i = 0; i < 8; ++i)
+      {
+        EXPECT_TRUE(buffer.tryPush(i));
+      }
+      EXPECT_TRUE(buffer.full());
+      EXPECT_FALSE(buffer.tryPush(8));
+      EXPECT_EQ(buffer.size(), 8U);
+
+      // Wrap around the end of the storage several times
+      int expected = 0;
+      int next = 8;
+      for (int round = 0; round < 100; ++round)
+      {
+        int value = 0;
+        ASSERT_TRUE(buffer.tryPop(value));
+        EXPECT_EQ(value, expected++);
+        ASSERT_TRUE(buffer.tryPush(next++));
+      }
+      int value = 0;
+      while (buffer.tryPop(value))
+      {
+        EXPECT_EQ(value, expected++);
+      }
+      EXPECT_EQ(expected, next);
+      EXPECT_FALSE(buffer.tryPop(value));
+    }
+
+    TEST(SpscRingBufferTest, BatchesAndElementLifetime)
+    {
+      {
+        SpscRingBuffer<Tracked> buffer(16);
+        std::vector<Tracked> input;
+        for (int i = 0; i < 20; ++i)
+        {
+          input.emplace_back(i);
+        }
+
+        // Only the free slots are filled
+        EXPECT_EQ(buffer.tryPushBatch(input.begin(), input.size()), 16U);
+        EXPECT_EQ(buffer.tryPushBatch(input.begin(), 1U), 0U);
+
+        std::vector<Tracked> output;
+        EXPECT_EQ(buffer.tryPopBatch(std::back_inserter(output), 10U), 10U);
+        ASSERT_EQ(output.size(), 10U);
+        for (int i = 0; i < 10; ++i)
+        {
+          EXPECT_EQ(output[i].value, i);
+        }
+        EXPECT_EQ(buffer.tryPushBatch(input.begin() + 16, 4U), 4U);
+        EXPECT_TRUE(buffer.tryEmplace(99));
+        EXPECT_EQ(buffer.size(), 11U);
+
+        EXPECT_EQ(Tracked::num_alive.load(), 20 + 10 + 11);
+      }
+      // Elements left in the buffer are destroyed with it
+      EXPECT_EQ(Tracked::num_alive.load(), 0);
+
+      SpscRingBuffer<std::unique_ptr<int>> move_only(4);
+      EXPECT_TRUE(move_only.tryPush(std::make_unique<int>(7)));
+      std::unique_ptr<int> out;
+      EXPECT_TRUE(move_only.tryPop(out));
+      EXPECT_EQ(*out, 7);
+    }
+
+    TEST(SpscRingBufferTest, ProducerConsumerThreads)
+    {
+      const uint64_t num_items = 1000000U;
+      SpscRingBuffer<uint64_t> buffer(1024);
+
+      std::thread producer(
+          [&]()
+          {
+            std::vector<uint64_t> chunk(37);
+            uint64_t next = 0U;
+            while (next < num_items)
+            {
+              // Alternate single pushes and batches
+              if (next % 2U == 0U)
+              {
+                buffer.push(next++);
+                continue;
+              }
+              size_t count = 0U;
+              while (count < chunk.size() && next < num_items)
+              {
+                chunk[count++] = next++;
+              }
+              buffer.pushBatch(chunk.begin(), count);
+            }
+          });
+
+      uint64_t expected = 0U;
+      std::vector<uint64_t> chunk(64);
+      bool in_order = true;
+      while (expected < num_items)
+      {
+        const size_t count = buffer.popBatch(chunk.begin(), chunk.size());
+        for (size_t i = 0; i < count; ++i)
+        {
+          in_order = in_order && chunk[i] == expected;
+          ++expected;
+        }
+      }
+      producer.join();
+
+      EXPECT_TRUE(in_order);
+      EXPECT_TRUE(buffer.empty());
+    }
+
+    TEST(SpscRingBufferTest, BlockingPopParksAndTimesOut)
+    {
+      SpscRingBuffer<std::string> buffer(2);
+      std::string value;
+      const auto start = std::chrono::steady_clock::now();
+      EXPECT_FALSE(buffer.tryPopFor(value, std::chrono::milliseconds(20)));
+      EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+
+      // The consumer is parked long before the producer pushes
+      std::thread producer(
+          [&]()
+          {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            buffer.push("first");
+            buffer.push("second");
+            buffer.push("third");
+          });
+      EXPECT_EQ(buffer.pop(), "first");
+      EXPECT_TRUE(buffer.tryPopFor(value, std::chrono::seconds(5)));
+      EXPECT_EQ(value, "second");
+      EXPECT_EQ(buffer.pop(), "third");
+      producer.join();
+    }
+
+    TEST(MpmcRingBufferTest, SingleThreadSemantics)
+    {
+      MpmcRingBuffer<int> buffer(3);
+      EXPECT_EQ(buffer.capacity(), 4U);
+      EXPECT_EQ(MpmcRingBuffer<int>(1).capacity(), 2U);
+
+      const std::vector<int> input = {1, 2, 3, 4, 5, 6};
+      EXPECT_EQ(buffer.tryPushBatch(input.begin(), input.size()), 4U);
+      EXPECT_FALSE(buffer.tryPush(7));
+      EXPECT_TRUE(buffer.full());
+
+      int value = 0;
+      EXPECT_TRUE(buffer.tryPop(value));
+      EXPECT_EQ(value, 1);
+      EXPECT_TRUE(buffer.tryEmplace(5));
+
+      std::vector<int> output(10);
+      EXPECT_EQ(buffer.tryPopBatch(output.begin(), output.size()), 4U);
+      EXPECT_EQ(std::vector<int>(output.begin(), output.begin() + 4), std::vector<int>({2, 3, 4, 5}));
+      EXPECT_FALSE(buffer.tryPop(value));
+      EXPECT_EQ(buffer.tryPopBatch(output.begin(), output.size()), 0U);
+
+      {
+        MpmcRingBuffer<Tracked> tracked(8);
+        EXPECT_TRUE(tracked.tryEmplace(1));
+        EXPECT_TRUE(tracked.tryEmplace(2));
+        Tracked out;
+        EXPECT_TRUE(tracked.tryPop(out));
+        EXPECT_EQ(Tracked::num_alive.load(), 2);
+      }
+      EXPECT_EQ(Tracked::num_alive.load(), 0);
+    }
+
+    TEST(MpmcRingBufferTest, ThrowingConstructorDoesNotBlockQueue)
+    {
+      MpmcRingBuffer<ThrowsOnNegative> buffer(8);
+      EXPECT_TRUE(buffer.tryPush(ThrowsOnNegative(1)));
+      const ThrowsOnNegative bad(-1);
+      EXPECT_THROW(buffer.tryPush(bad), std::runtime_error);
+      EXPECT_TRUE(buffer.tryPush(ThrowsOnNegative(2)));
+
+      // The batch gives up the slots after the one that threw
+      std::vector<ThrowsOnNegative> batch;
+      batch.reserve(3U);
+      for (const int v : {3, -1, 4})
+      {
+        batch.emplace_back(v);
+      }
+      EXPECT_THROW(buffer.tryPushBatch(batch.begin(), batch.size()), std::runtime_error);
+      EXPECT_TRUE(buffer.tryPush(ThrowsOnNegative(5)));
+
+      ThrowsOnNegative value;
+      EXPECT_TRUE(buffer.tryPop(value));
+      EXPECT_EQ(value.value, 1);
+      EXPECT_EQ(buffer.pop().value, 2);
+
+      std::vector<ThrowsOnNegative> output(8);
+      size_t num_popped = 0U;
+      while (num_popped < 2U)
+      {
+        num_popped += buffer.tryPopBatch(output.begin() + static_cast<std::ptrdiff_t>(num_popped), 8U - num_popped);
+      }
+      EXPECT_EQ(output[0].value, 3);
+      EXPECT_EQ(output[1].value, 5);
+      EXPECT_TRUE(buffer.empty());
+      EXPECT_FALSE(buffer.tryPop(value));
+    }
+
+    TEST(MpmcRingBufferTest, ManyProducersManyConsumers)
+    {
+      const uint64_t num_producers = 4U;
+      const uint64_t num_consumers = 4U;
+      const uint64_t items_per_producer = 50000U;
+      MpmcRingBuffer<uint64_t> buffer(256);
+
+      std::vector<std::thread> threads;
+      for (uint64_t p = 0; p < num_producers; ++p)
+      {
+        threads.emplace_back(
+            [&, p]()
+            {
+              uint64_t batch[8];
+              for (uint64_t i = 0; i < items_per_producer;)
+              {
+                if (i % 3U == 0U)
+                {
+                  buffer.push(encode(p, i++));
+                  continue;
+                }
+                size_t count = 0U;
+                while (count < 8U && i < items_per_producer)
+                {
+                  batch[count++] = encode(p, i++);
+                }
+                buffer.pushBatch(batch, count);
+              }
+            });
+      }
+
+      // Each consumer sees the elements of a producer in increasing order
+      std::atomic<uint64_t> num_consumed(0U);
+      std::atomic<uint64_t> checksum(0U);
+      std::atomic<bool> in_order(true);
+      for (uint64_t c = 0; c < num_consumers; ++c)
+      {
+        threads.emplace_back(
+            [&, c]()
+            {
+              std::vector<int64_t> last(num_producers, -1);
+              uint64_t batch[16];
+              uint64_t local_sum = 0U;
+              while (num_consumed.load() < num_producers * items_per_producer)
+              {
+                size_t count = 0U;
+                if (c % 2U == 0U)
+                {
+                  count = buffer.tryPopBatch(batch, 16U);
+                }
+                else
+                {
+                  count = buffer.tryPopFor(batch[0], std::chrono::milliseconds(1)) ? 1U : 0U;
+                }
+                for (size_t i = 0; i < count; ++i)
+                {
+                  const uint64_t producer = batch[i] >> 32U;
+                  const int64_t sequence = static_cast<int64_t>(batch[i] & 0xFFFFFFFFU);
+                  if (sequence <= last[producer])
+                  {
+                    in_order = false;
+                  }
+                  last[producer] = sequence;
+                  local_sum += batch[i] & 0xFFFFFFFFU;
+                }
+                num_consumed += count;
+              }
+              checksum += local_sum;
+            });
+      }
+
+      for (std::thread &thread : threads)
+      {
+        thread.join();
+      }
+
+      EXPECT_EQ(num_consumed.load(), num_producers * items_per_producer);
+      EXPECT_EQ(checksum.load(),
+                num_producers * items_per_producer * (items_per_producer - 1U) / 2U);
+      EXPECT_TRUE(in_order.load());
+      EXPECT_TRUE(buffer.empty());
+    }
+
+    TEST(MpmcRingBufferTest, BlockingPushWaitsForSpace)
+    {
+      MpmcRingBuffer<int> buffer(2);
+      std::vector<int> received;
+      std::thread consumer(
+          [&]()
+          {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            while (received.size() < 100U)
+            {
+              int values[4];
+              const size_t count = buffer.popBatch(values, 4U);
+              received.insert(received.end(), values, values + count);
+            }
+          });
+
+      for (int i = 0; i < 100; ++i)
+      {
+        buffer.push(i);
+      }
+      consumer.join();
+
+      ASSERT_EQ(received.size(), 100U);
+      for (int i = 0; i < 100; ++i)
+      {
+        EXPECT_EQ(received[i], i);
+      }
+    }
+
+  } // namespace concurrency
+} // namespace lumos
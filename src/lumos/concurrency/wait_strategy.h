@@ -0,0 +1,148 @@
+#ifndef LUMOS_CONCURRENCY_WAIT_STRATEGY_H_
+#define LUMOS_CONCURRENCY_WAIT_STRATEGY_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace lumos
+{
+  namespace concurrency
+  {
+    // Size that separates data written by different threads, so that they do
+    // not invalidate each other's cache lines (false sharing)
+    constexpr size_t kCacheLineSize = 64;
+
+    // Hint to the CPU that the thread is busy waiting
+    inline void cpuRelax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+      __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+      asm volatile("yield" ::: "memory");
+#endif
+    }
+
+    // Waits for a condition by spinning first, then yielding the CPU and
+    // finally parking the thread on a condition variable. Short waits never
+    // leave user space, long ones do not burn a core.
+    //
+    // Whoever makes the condition true calls notifyAll() or notifyOne(),
+    // which cost a fence and one load while no thread is parked. A parking
+    // thread counts itself in num_parked_ and then checks the condition, the
+    // notifier publishes the condition and then reads num_parked_, each side
+    // with a full fence in between. At least one of them sees the other's
+    // write, so a wake-up cannot be missed and parked threads sleep until
+    // they are notified or their deadline passes
+    class SpinThenParkWaiter
+    {
+    public:
+      explicit SpinThenParkWaiter(const size_t spin_iterations = 256,
+                                  const size_t yield_iterations = 16)
+          : spin_iterations_(spin_iterations), yield_iterations_(yield_iterations),
+            num_parked_(0U)
+      {
+      }
+
+      SpinThenParkWaiter(const SpinThenParkWaiter &) = delete;
+      SpinThenParkWaiter &operator=(const SpinThenParkWaiter &) = delete;
+
+      // Returns when ready() is true
+      template <typename Ready>
+      void wait(const Ready &ready)
+      {
+        waitUntil(ready, std::chrono::steady_clock::time_point::max());
+      }
+
+      // Returns ready(), false only if deadline passed before it became true
+      template <typename Ready>
+      bool waitUntil(const Ready &ready, const std::chrono::steady_clock::time_point deadline)
+      {
+        for (size_t i = 0; i < spin_iterations_; ++i)
+        {
+          if (ready())
+          {
+            return true;
+          }
+          cpuRelax();
+        }
+        for (size_t i = 0; i < yield_iterations_; ++i)
+        {
+          if (ready())
+          {
+            return true;
+          }
+          std::this_thread::yield();
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        num_parked_.fetch_add(1U, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool is_ready = ready();
+        while (!is_ready)
+        {
+          bool is_timed_out = false;
+          if (deadline == std::chrono::steady_clock::time_point::max())
+          {
+            condition_.wait(lock);
+          }
+          else
+          {
+            is_timed_out = condition_.wait_until(lock, deadline) == std::cv_status::timeout;
+          }
+          is_ready = ready();
+          if (is_timed_out)
+          {
+            break;
+          }
+        }
+        num_parked_.fetch_sub(1U, std::memory_order_relaxed);
+        return is_ready;
+      }
+
+      void notifyAll()
+      {
+        // Pairs with the fence after a waiter counts itself as parked
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (num_parked_.load(std::memory_order_relaxed) != 0U)
+        {
+          // Taking the lock orders the notification after a waiter's last
+          // check of the condition
+          {
+            std::lock_guard<std::mutex> lock(mutex_);
+          }
+          condition_.notify_all();
+        }
+      }
+
+      // For conditions only one of the parked threads can act on, such as
+      // one new task for a pool of idle workers
+      void notifyOne()
+      {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (num_parked_.load(std::memory_order_relaxed) != 0U)
+        {
+          {
+            std::lock_guard<std::mutex> lock(mutex_);
+          }
+          condition_.notify_one();
+        }
+      }
+
+    private:
+      const size_t spin_iterations_;
+      const size_t yield_iterations_;
+
+      // Read by every notifyAll(), kept apart from the queue indices
+      alignas(kCacheLineSize) std::atomic<uint32_t> num_parked_;
+      std::mutex mutex_;
+      std::condition_variable condition_;
+    };
+  } // namespace concurrency
+} // namespace lumos
+
+#endif // LUMOS_CONCURRENCY_WAIT_STRATEGY_H_
@@ -9,6 +9,8 @@
 #include <functional>
 #include <map>
 
+#include "lumos/string/string_interner.h"
+
 // CSV Configuration struct
 struct CSVConfig {
     char delimiter = ',';
@@ -39,6 +41,8 @@ CSVData selectColumns(const CSVData& data, const std::vector<size_t>& column_ind
 CSVData selectColumnsByName(const CSVData& data, const std::vector<std::string>& column_names, bool has_header = true);
 CSVRow getColumn(const CSVData& data, size_t column_index);
 CSVRow getColumnByName(const CSVData& data, const std::string& column_name, bool has_header = true);
+// Categorical columns with few distinct values, each value is stored once in the interner
+std::vector<InternedString> getColumnInterned(const CSVData& data, size_t column_index, StringInterner& interner = StringInterner::global());
 
 // CSV utility functions
 size_t getRowCount(const CSVData& data);
@@ -54,9 +58,12 @@ bool needsQuoting(const std::string& field, const CSVConfig& config = CSVConfig{
 // CSV statistics and analysis
 std::vector<std::string> getUniqueValues(const CSVData& data, size_t column_index);
 std::map<std::string, size_t> getValueCounts(const CSVData& data, size_t column_index);
-CSVData sortByColumn(const CSVData& data, size_t column_index, bool ascending = true);
+// The first row stays in place if has_header
+CSVData sortByColumn(const CSVData& data, size_t column_index, bool ascending = true, bool has_header = true);
 
 // Template function for reading CSV into vector of tuples with type conversion
+// Supported column types are std::string, InternedString (interned in StringInterner::global()), float, double
+// and the fixed width integer types
 template<typename... Types>
 std::vector<std::tuple<Types...>> readCSVTyped(const std::string& filename, const CSVConfig& config = CSVConfig{});
 
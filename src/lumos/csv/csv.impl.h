@@ -2,7 +2,10 @@
 #define CSV_IMPL_H
 
 #include "lumos/csv.h"
+#include "lumos/number_conversion.h"
+#include "lumos/string/string_interner.impl.h"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <fstream>
 #include <sstream>
@@ -25,6 +28,19 @@
 // BASIC CSV OPERATIONS
 // =============================================================================
 
+namespace detail
+{
+    // std::getline splits on '\n' only, so lines of files with CRLF endings
+    // keep their '\r'
+    LUMOS_INLINE void stripCarriageReturn(std::string &line)
+    {
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+    }
+} // namespace detail
+
 LUMOS_INLINE CSVData readCSV(const std::string &filename, const CSVConfig &config)
 {
     std::ifstream file(filename);
@@ -38,6 +54,7 @@ LUMOS_INLINE CSVData readCSV(const std::string &filename, const CSVConfig &confi
 
     while (std::getline(file, line))
     {
+        detail::stripCarriageReturn(line);
         if (config.skip_empty_lines && line.empty())
         {
             continue;
@@ -61,6 +78,7 @@ LUMOS_INLINE CSVData readCSVFromString(const std::string &csv_content, const CSV
 
     while (std::getline(stream, line))
     {
+        detail::stripCarriageReturn(line);
         if (config.skip_empty_lines && line.empty())
         {
             continue;
@@ -126,7 +144,9 @@ LUMOS_INLINE CSVRow parseCSVLine(const std::string &line, const CSVConfig &confi
             continue;
         }
 
-        if (c == config.escape_char && in_quotes)
+        // With the default escape_char == quote_char, "" is an escaped quote
+        // and a single quote closes the field, both handled below
+        if (c == config.escape_char && config.escape_char != config.quote_char && in_quotes)
         {
             if (i + 1 < line.length() && line[i + 1] == config.quote_char)
             {
@@ -330,6 +350,19 @@ LUMOS_INLINE CSVRow getColumnByName(const CSVData &data, const std::string &colu
     return getColumn(data, column_index);
 }
 
+LUMOS_INLINE std::vector<InternedString> getColumnInterned(const CSVData &data, size_t column_index, StringInterner &interner)
+{
+    std::vector<InternedString> column;
+    column.reserve(data.size());
+
+    for (const auto &row : data)
+    {
+        column.push_back(column_index < row.size() ? interner.intern(row[column_index]) : InternedString());
+    }
+
+    return column;
+}
+
 // =============================================================================
 // CSV UTILITY FUNCTIONS
 // =============================================================================
@@ -457,7 +490,8 @@ LUMOS_INLINE bool needsQuoting(const std::string &field, const CSVConfig &config
            field.find(config.quote_char) != std::string::npos ||
            field.find('\n') != std::string::npos ||
            field.find('\r') != std::string::npos ||
-           (!field.empty() && (field.front() == ' ' || field.back() == ' '));
+           field.find(' ') != std::string::npos ||
+           field.find('\t') != std::string::npos;
 }
 
 // =============================================================================
@@ -494,11 +528,12 @@ LUMOS_INLINE std::map<std::string, size_t> getValueCounts(const CSVData &data, s
     return counts;
 }
 
-LUMOS_INLINE CSVData sortByColumn(const CSVData &data, size_t column_index, bool ascending)
+LUMOS_INLINE CSVData sortByColumn(const CSVData &data, size_t column_index, bool ascending, bool has_header)
 {
     CSVData sorted_data = data;
+    const auto first_row = sorted_data.begin() + ((has_header && !sorted_data.empty()) ? 1 : 0);
 
-    std::sort(sorted_data.begin(), sorted_data.end(),
+    std::sort(first_row, sorted_data.end(),
               [column_index, ascending](const CSVRow &a, const CSVRow &b)
               {
                   std::string val_a = (column_index < a.size()) ? a[column_index] : "";
@@ -530,6 +565,7 @@ namespace detail
         // Check if T is one of the supported types
         static_assert(
             std::is_same_v<T, std::string> ||
+                std::is_same_v<T, InternedString> ||
                 std::is_same_v<T, float> ||
                 std::is_same_v<T, double> ||
                 std::is_same_v<T, int8_t> ||
@@ -540,71 +576,24 @@ namespace detail
                 std::is_same_v<T, uint16_t> ||
                 std::is_same_v<T, uint32_t> ||
                 std::is_same_v<T, uint64_t>,
-            "Unsupported type for CSV conversion. Only std::string, float, double, and integer types (int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t, uint32_t, uint64_t) are supported.");
+            "Unsupported type for CSV conversion. Only std::string, InternedString, float, double, and integer types (int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t, uint32_t, uint64_t) are supported.");
 
         if constexpr (std::is_same_v<T, std::string>)
         {
             return str;
         }
-        else if constexpr (std::is_same_v<T, float>)
-        {
-            return std::stof(str);
-        }
-        else if constexpr (std::is_same_v<T, double>)
-        {
-            return std::stod(str);
-        }
-        else if constexpr (std::is_same_v<T, int8_t>)
-        {
-            int temp = std::stoi(str);
-            if (temp < INT8_MIN || temp > INT8_MAX)
-            {
-                throw std::out_of_range("Value out of range for int8_t");
-            }
-            return static_cast<int8_t>(temp);
-        }
-        else if constexpr (std::is_same_v<T, int16_t>)
-        {
-            int temp = std::stoi(str);
-            if (temp < INT16_MIN || temp > INT16_MAX)
-            {
-                throw std::out_of_range("Value out of range for int16_t");
-            }
-            return static_cast<int16_t>(temp);
-        }
-        else if constexpr (std::is_same_v<T, int32_t>)
-        {
-            return static_cast<int32_t>(std::stoi(str));
-        }
-        else if constexpr (std::is_same_v<T, int64_t>)
-        {
-            return static_cast<int64_t>(std::stoll(str));
-        }
-        else if constexpr (std::is_same_v<T, uint8_t>)
+        else if constexpr (std::is_same_v<T, InternedString>)
         {
-            unsigned long temp = std::stoul(str);
-            if (temp > UINT8_MAX)
-            {
-                throw std::out_of_range("Value out of range for uint8_t");
-            }
-            return static_cast<uint8_t>(temp);
-        }
-        else if constexpr (std::is_same_v<T, uint16_t>)
-        {
-            unsigned long temp = std::stoul(str);
-            if (temp > UINT16_MAX)
-            {
-                throw std::out_of_range("Value out of range for uint16_t");
-            }
-            return static_cast<uint16_t>(temp);
+            return StringInterner::global().intern(str);
         }
-        else if constexpr (std::is_same_v<T, uint32_t>)
-        {
-            return static_cast<uint32_t>(std::stoul(str));
-        }
-        else if constexpr (std::is_same_v<T, uint64_t>)
+        else
         {
-            return static_cast<uint64_t>(std::stoull(str));
+            // Surrounding whitespace is allowed, as with std::stod and friends,
+            // also when the fields are not trimmed
+            const size_t begin = str.find_first_not_of(" \t\r\n\f\v");
+            const size_t end = str.find_last_not_of(" \t\r\n\f\v");
+            return lumos::internal::parseNumber<T>(
+                begin == std::string::npos ? std::string_view() : std::string_view(str).substr(begin, end - begin + 1));
         }
     }
 
@@ -657,6 +646,11 @@ namespace detail
                     row, std::index_sequence_for<Types...>{});
                 result.push_back(tuple);
             }
+            catch (const std::invalid_argument &e)
+            {
+                // Rows with too few columns, conversion errors arrive as std::runtime_error
+                throw std::invalid_argument("Error processing row " + std::to_string(i + 1) + ": " + e.what());
+            }
             catch (const std::exception &e)
             {
                 throw std::runtime_error("Error processing row " + std::to_string(i + 1) + ": " + e.what());
@@ -508,7 +508,7 @@ namespace lumos
 
         // This should throw because "age" and "salary" strings can't be converted to numbers
         EXPECT_THROW(
-            readCSVTypedFromString<std::string, int32_t, double>(typed_csv),
+            (readCSVTypedFromString<std::string, int32_t, double>(typed_csv)),
             std::runtime_error);
     }
 
@@ -612,6 +612,33 @@ namespace lumos
         EXPECT_EQ(std::get<4>(data[1]), 0);
     }
 
+    TEST_F(CSVTest, InternedCategoricalColumns)
+    {
+        std::string category_csv = "id,color\n"
+                                   "1,red\n"
+                                   "2,green\n"
+                                   "3,red\n"
+                                   "4,red";
+        CSVConfig config;
+        config.has_header = true;
+
+        CSVData data = readCSVFromString(category_csv, config);
+        StringInterner interner;
+        std::vector<InternedString> colors = getColumnInterned(data, 1, interner);
+
+        ASSERT_EQ(colors.size(), 5U);
+        EXPECT_EQ(colors[1].view(), "red");
+        EXPECT_EQ(colors[1], colors[3]);
+        EXPECT_EQ(colors[1], colors[4]);
+        EXPECT_NE(colors[1], colors[2]);
+        EXPECT_EQ(interner.size(), 3U); // Header "color", "red" and "green"
+
+        auto typed = readCSVTypedFromString<int32_t, InternedString>(category_csv, config);
+        ASSERT_EQ(typed.size(), 4U);
+        EXPECT_EQ(std::get<1>(typed[0]), std::get<1>(typed[2]));
+        EXPECT_EQ(std::get<1>(typed[1]).view(), "green");
+    }
+
     TEST_F(CSVTest, ReadCSVTypedFromFile)
     {
         // Create test file
@@ -641,13 +668,13 @@ namespace lumos
         // Test with insufficient columns
         std::string insufficient_csv = "name,age\nJohn";
         EXPECT_THROW(
-            readCSVTypedFromString<std::string, int32_t, double>(insufficient_csv),
+            (readCSVTypedFromString<std::string, int32_t, double>(insufficient_csv)),
             std::invalid_argument);
 
         // Test with invalid number conversion
         std::string invalid_csv = "name,age\nJohn,not_a_number";
         EXPECT_THROW(
-            readCSVTypedFromString<std::string, int32_t>(invalid_csv),
+            (readCSVTypedFromString<std::string, int32_t>(invalid_csv)),
             std::runtime_error);
 
         // Test with out of range values
@@ -696,4 +723,28 @@ namespace lumos
         EXPECT_DOUBLE_EQ(std::get<2>(data[0]), 50000.5);
     }
 
+    TEST_F(CSVTest, ReadCSVTypedWithCrlfLineEndings)
+    {
+        CSVConfig config;
+        auto data = readCSVTypedFromString<int32_t, double>("1,2.5\r\n3,4.5\r\n", config);
+
+        ASSERT_EQ(data.size(), 2U);
+        EXPECT_EQ(std::get<0>(data[0]), 1);
+        EXPECT_DOUBLE_EQ(std::get<1>(data[0]), 2.5);
+        EXPECT_EQ(std::get<0>(data[1]), 3);
+        EXPECT_DOUBLE_EQ(std::get<1>(data[1]), 4.5);
+
+        CSVData rows = readCSVFromString("a,b\r\n\r\nc,d\r\n", config);
+        ASSERT_EQ(rows.size(), 2U);
+        EXPECT_EQ(rows[0][1], "b");
+        EXPECT_EQ(rows[1][1], "d");
+
+        // Numbers may be surrounded by whitespace, also in untrimmed fields
+        config.trim_whitespace = false;
+        auto padded = readCSVTypedFromString<int32_t, double>(" 7,\t8.5 \n", config);
+        ASSERT_EQ(padded.size(), 1U);
+        EXPECT_EQ(std::get<0>(padded[0]), 7);
+        EXPECT_DOUBLE_EQ(std::get<1>(padded[0]), 8.5);
+    }
+
 } // namespace lumos
\ No newline at end of file
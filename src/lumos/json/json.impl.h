@@ -2,7 +2,10 @@
 #define JSON_IMPL_H
 
 #include "lumos/json/json.h"
+#include "lumos/number_conversion.h"
+#include <limits>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <cctype>
 #include <stdexcept>
@@ -698,6 +701,21 @@ LUMOS_INLINE bool Json::operator!=(const Json &other) const
     return !(*this == other);
 }
 
+namespace detail
+{
+    // Integral values that fit an int are written without decimals, everything
+    // else with six decimals, the same output as std::to_string
+    LUMOS_INLINE std::string formatNumber(double num)
+    {
+        if ((num >= static_cast<double>(std::numeric_limits<int>::min())) &&
+            (num <= static_cast<double>(std::numeric_limits<int>::max())) && (num == static_cast<int>(num)))
+        {
+            return lumos::internal::formatNumber(static_cast<int>(num));
+        }
+        return lumos::internal::formatFixed(num, 6);
+    }
+} // namespace detail
+
 // String representation
 LUMOS_INLINE std::string Json::toString(bool pretty, int indent) const
 {
@@ -711,14 +729,7 @@ LUMOS_INLINE std::string Json::toString(bool pretty, int indent) const
     case JsonType::Boolean:
         return asBool() ? "true" : "false";
     case JsonType::Number:
-    {
-        double num = asNumber();
-        if (num == static_cast<int>(num))
-        {
-            return std::to_string(static_cast<int>(num));
-        }
-        return std::to_string(num);
-    }
+        return detail::formatNumber(asNumber());
     case JsonType::String:
     {
         std::string result = "\"";
@@ -832,14 +843,7 @@ LUMOS_INLINE std::string Json::toString(bool pretty, int indent, std::uint8_t in
     case JsonType::Boolean:
         return asBool() ? "true" : "false";
     case JsonType::Number:
-    {
-        double num = asNumber();
-        if (num == static_cast<int>(num))
-        {
-            return std::to_string(static_cast<int>(num));
-        }
-        return std::to_string(num);
-    }
+        return detail::formatNumber(asNumber());
     case JsonType::String:
     {
         std::string result = "\"";
@@ -1039,34 +1043,30 @@ namespace detail
 
     LUMOS_INLINE double parseNumber(const std::string &str, size_t &pos)
     {
-        size_t start = pos;
+        const std::string_view view(str);
+        const size_t start = pos;
 
         if (pos < str.length() && str[pos] == '-')
         {
             ++pos;
         }
 
-        if (pos >= str.length() || !std::isdigit(str[pos]))
+        size_t num_digits = lumos::internal::countLeadingDigits(view.substr(pos));
+        if (num_digits == 0)
         {
             throw std::runtime_error("Invalid number format at position " + std::to_string(start));
         }
-
-        while (pos < str.length() && std::isdigit(str[pos]))
-        {
-            ++pos;
-        }
+        pos += num_digits;
 
         if (pos < str.length() && str[pos] == '.')
         {
             ++pos;
-            if (pos >= str.length() || !std::isdigit(str[pos]))
+            num_digits = lumos::internal::countLeadingDigits(view.substr(pos));
+            if (num_digits == 0)
             {
                 throw std::runtime_error("Invalid number format at position " + std::to_string(start));
             }
-            while (pos < str.length() && std::isdigit(str[pos]))
-            {
-                ++pos;
-            }
+            pos += num_digits;
         }
 
         if (pos < str.length() && (str[pos] == 'e' || str[pos] == 'E'))
@@ -1076,17 +1076,15 @@ namespace detail
             {
                 ++pos;
             }
-            if (pos >= str.length() || !std::isdigit(str[pos]))
+            num_digits = lumos::internal::countLeadingDigits(view.substr(pos));
+            if (num_digits == 0)
             {
                 throw std::runtime_error("Invalid number format at position " + std::to_string(start));
             }
-            while (pos < str.length() && std::isdigit(str[pos]))
-            {
-                ++pos;
-            }
+            pos += num_digits;
         }
 
-        return std::stod(str.substr(start, pos - start));
+        return lumos::internal::parseNumber<double>(view.substr(start, pos - start));
     }
 
     LUMOS_INLINE Json parseValue(const std::string &str, size_t &pos);
@@ -0,0 +1,67 @@
+#ifndef LUMOS_MATH_ESTIMATION_CLASS_DEF_ERROR_STATE_KALMAN_FILTER_H_
+#define LUMOS_MATH_ESTIMATION_CLASS_DEF_ERROR_STATE_KALMAN_FILTER_H_
+
+#include <cstdint>
+
+#include "lumos/math/lin_alg/matrix_fixed/class_def/matrix_fixed.h"
+#include "lumos/math/transformations/class_def/quaternion.h"
+
+namespace lumos
+{
+
+  // Error-state Kalman filter for attitude and gyro bias. The nominal state is
+  // a unit Quaternion q (body to world) and the gyro bias b, integrated
+  // without approximation. The filter estimates the 6 dimensional error
+  // [dtheta; db], with the attitude error as a rotation vector in the body
+  // frame, q_true = q * exp(dtheta). After every update the error is injected
+  // into the nominal state and reset to zero, so the error covariance always
+  // describes small angles and the unit norm constraint never enters the
+  // filter.
+  template <typename T>
+  class ErrorStateKalmanFilter
+  {
+  public:
+    using Vector3 = FixedSizeMatrix<T, 3, 1>;
+    using Matrix3 = FixedSizeMatrix<T, 3, 3>;
+    using ErrorVector = FixedSizeMatrix<T, 6, 1>;
+    using ErrorMatrix = FixedSizeMatrix<T, 6, 6>;
+
+  private:
+    Quaternion<T> q_;
+    Vector3 bias_;
+    ErrorMatrix P_;
+    T gyro_noise_;      // Gyro white noise, rad/s standard deviation per sample
+    T bias_random_walk_; // Bias random walk, rad/s/sqrt(s)
+
+    void inject(const ErrorVector &error);
+
+  public:
+    ErrorStateKalmanFilter();
+    ErrorStateKalmanFilter(const Quaternion<T> &q0, const Vector3 &bias0,
+                           const ErrorMatrix &P0, T gyro_noise, T bias_random_walk);
+
+    // Integrates the bias corrected angular rate gyro (body frame, rad/s)
+    // over dt seconds
+    void predict(const Vector3 &gyro, T dt);
+
+    // Direction measurement: a known world vector (gravity, magnetic north)
+    // observed as measured in the body frame, with noise covariance R. Both
+    // should be unit vectors. Returns false if the innovation covariance is
+    // not positive definite
+    bool updateDirection(const Vector3 &reference_world, const Vector3 &measured_body,
+                         const Matrix3 &R);
+
+    // Generic update from a residual z - h(x) and its Jacobian H with respect
+    // to the error state [dtheta; db]
+    template <uint16_t M>
+    bool update(const FixedSizeMatrix<T, M, 1> &residual, const FixedSizeMatrix<T, M, 6> &H,
+                const FixedSizeMatrix<T, M, M> &R);
+
+    const Quaternion<T> &getAttitude() const;
+    const Vector3 &getGyroBias() const;
+    const ErrorMatrix &getCovariance() const;
+  };
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_ESTIMATION_CLASS_DEF_ERROR_STATE_KALMAN_FILTER_H_
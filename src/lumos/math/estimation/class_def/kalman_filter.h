@@ -0,0 +1,89 @@
+#ifndef LUMOS_MATH_ESTIMATION_CLASS_DEF_KALMAN_FILTER_H_
+#define LUMOS_MATH_ESTIMATION_CLASS_DEF_KALMAN_FILTER_H_
+
+#include <cstdint>
+
+#include "lumos/math/lin_alg/matrix_fixed/class_def/matrix_fixed.h"
+
+namespace lumos
+{
+
+  // Linear Kalman filter with an N dimensional state. All matrices have
+  // compile-time sizes, so the filter never allocates and the loops of the
+  // products have constant trip counts. The measurement dimension M is a
+  // template parameter of update, so one filter can fuse several sensors.
+  // The gain is solved through a Cholesky factorization of the innovation
+  // covariance, and the covariance is updated in Joseph form.
+  template <typename T, uint16_t N>
+  class KalmanFilter
+  {
+  public:
+    using StateVector = FixedSizeMatrix<T, N, 1>;
+    using StateMatrix = FixedSizeMatrix<T, N, N>;
+
+  private:
+    StateVector x_;
+    StateMatrix P_;
+
+  public:
+    // Zero state and unit covariance
+    KalmanFilter();
+    KalmanFilter(const StateVector &x0, const StateMatrix &P0);
+
+    // x = F x, P = F P F^T + Q
+    void predict(const StateMatrix &F, const StateMatrix &Q);
+    // x = F x + B u, P = F P F^T + Q
+    template <uint16_t U>
+    void predict(const StateMatrix &F, const FixedSizeMatrix<T, N, U> &B,
+                 const FixedSizeMatrix<T, U, 1> &u, const StateMatrix &Q);
+
+    // Measurement z = H x + v with v ~ N(0, R). Returns false and leaves the
+    // filter unchanged if H P H^T + R is not positive definite
+    template <uint16_t M>
+    bool update(const FixedSizeMatrix<T, M, 1> &z, const FixedSizeMatrix<T, M, N> &H,
+                const FixedSizeMatrix<T, M, M> &R);
+
+    const StateVector &getState() const;
+    const StateMatrix &getCovariance() const;
+    void setState(const StateVector &x);
+    void setCovariance(const StateMatrix &P);
+  };
+
+  // Extended Kalman filter with user supplied models and Jacobians. The
+  // process model f and measurement model h are any callables taking and
+  // returning FixedSizeMatrix column vectors, passed as template parameters
+  // so they are inlined. Jacobians are evaluated by the caller at the current
+  // estimate, see getState.
+  template <typename T, uint16_t N>
+  class ExtendedKalmanFilter
+  {
+  public:
+    using StateVector = FixedSizeMatrix<T, N, 1>;
+    using StateMatrix = FixedSizeMatrix<T, N, N>;
+
+  private:
+    StateVector x_;
+    StateMatrix P_;
+
+  public:
+    ExtendedKalmanFilter();
+    ExtendedKalmanFilter(const StateVector &x0, const StateMatrix &P0);
+
+    // x = f(x), P = F P F^T + Q with F the Jacobian of f at the prior x
+    template <typename ProcessModel>
+    void predict(const ProcessModel &f, const StateMatrix &F, const StateMatrix &Q);
+
+    // Residual z - h(x), H is the Jacobian of h at the prior x
+    template <uint16_t M, typename MeasurementModel>
+    bool update(const FixedSizeMatrix<T, M, 1> &z, const MeasurementModel &h,
+                const FixedSizeMatrix<T, M, N> &H, const FixedSizeMatrix<T, M, M> &R);
+
+    const StateVector &getState() const;
+    const StateMatrix &getCovariance() const;
+    void setState(const StateVector &x);
+    void setCovariance(const StateMatrix &P);
+  };
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_ESTIMATION_CLASS_DEF_KALMAN_FILTER_H_
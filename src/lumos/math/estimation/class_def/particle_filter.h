@@ -0,0 +1,117 @@
+#ifndef LUMOS_MATH_ESTIMATION_CLASS_DEF_PARTICLE_FILTER_H_
+#define LUMOS_MATH_ESTIMATION_CLASS_DEF_PARTICLE_FILTER_H_
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "lumos/math/lin_alg/matrix_fixed/class_def/matrix_fixed.h"
+#include "lumos/math/lin_alg/vector_dynamic/class_def/vector_dynamic.h"
+
+namespace lumos
+{
+
+  enum class ResamplingScheme
+  {
+    Systematic, // One uniform offset for all particles
+    Stratified  // One uniform offset per particle
+  };
+
+  // A contiguous block of particles handed to the user functors. state[d]
+  // points to dimension d of the first particle of the block, so loops over
+  // one dimension run over contiguous memory. Every block has its own random
+  // generator, seeded once from the filter seed and the block index, so
+  // results do not depend on the number of threads.
+  template <typename T, uint16_t D>
+  struct ParticleBlock
+  {
+    std::array<T *, D> state;
+    T *log_weights;
+    size_t size;
+    size_t offset; // Index of the first particle of the block
+    std::mt19937 *rng;
+  };
+
+  // Particle filter with the particles in structure-of-arrays layout, one
+  // Vector<T> per state dimension. The motion and measurement models are
+  // functors called on blocks of kBlockSize particles, distributed over
+  // threads. Weights are kept as logarithms and normalized with log-sum-exp,
+  // and resampling builds the cumulative weights with a blocked parallel
+  // prefix sum, then locates the ancestors of every output block with one
+  // binary search followed by a linear merge.
+  template <typename T, uint16_t D>
+  class ParticleFilter
+  {
+  public:
+    static constexpr size_t kBlockSize = 4096;
+
+  private:
+    size_t num_particles_;
+    size_t num_blocks_;
+    size_t num_threads_;
+    std::array<Vector<T>, D> particles_;
+    std::array<Vector<T>, D> resampled_; // Gather target, swapped with particles_
+    Vector<T> log_weights_;
+    Vector<T> cumulative_weights_;
+    std::vector<size_t> ancestors_;
+    std::vector<T> block_values_;
+    std::vector<std::mt19937> block_rngs_;
+    std::mt19937 rng_;
+    T effective_sample_size_;
+
+    ParticleBlock<T, D> makeBlock(size_t block);
+    template <typename F>
+    void forEachBlock(const F &f);
+    void setUniformWeights();
+    size_t findAncestor(T position, size_t first) const;
+
+  public:
+    ParticleFilter();
+    // num_threads == 0 means all hardware threads
+    explicit ParticleFilter(size_t num_particles, uint32_t seed = 5489U,
+                            size_t num_threads = 0);
+
+    // init(ParticleBlock<T, D> &) writes the initial states, weights are set
+    // to uniform
+    template <typename Initializer>
+    void initialize(const Initializer &init);
+
+    // motion(ParticleBlock<T, D> &) propagates the states of a block in place
+    template <typename MotionModel>
+    void predict(const MotionModel &motion);
+
+    // log_likelihood(ParticleBlock<T, D> &) adds the log-likelihood of the
+    // measurement to block.log_weights, after which the weights are
+    // normalized. Returns false, and resets to uniform weights, if every
+    // particle has zero likelihood
+    template <typename LogLikelihood>
+    bool update(const LogLikelihood &log_likelihood);
+
+    void resample(ResamplingScheme scheme = ResamplingScheme::Systematic);
+    // Resamples if the effective sample size is below ratio * num particles,
+    // returns true if it did
+    bool resampleIfNeeded(T ratio = T(0.5),
+                          ResamplingScheme scheme = ResamplingScheme::Systematic);
+
+    // Weighted mean of the particles
+    FixedSizeMatrix<T, D, 1> getMean() const;
+
+    const Vector<T> &getState(size_t dimension) const;
+    const Vector<T> &getLogWeights() const;
+    // Source index of every particle after the last resampling
+    const std::vector<size_t> &getAncestors() const;
+    // 1 / sum(w^2) of the normalized weights
+    T getEffectiveSampleSize() const;
+    size_t getNumParticles() const;
+  };
+
+  // Type aliases for common use cases
+  template <uint16_t D>
+  using ParticleFilterd = ParticleFilter<double, D>;
+  template <uint16_t D>
+  using ParticleFilterf = ParticleFilter<float, D>;
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_ESTIMATION_CLASS_DEF_PARTICLE_FILTER_H_
@@ -0,0 +1,66 @@
+#ifndef LUMOS_MATH_ESTIMATION_CLASS_DEF_UNSCENTED_KALMAN_FILTER_H_
+#define LUMOS_MATH_ESTIMATION_CLASS_DEF_UNSCENTED_KALMAN_FILTER_H_
+
+#include <array>
+#include <cstdint>
+
+#include "lumos/math/lin_alg/matrix_fixed/class_def/matrix_fixed.h"
+
+namespace lumos
+{
+
+  // Unscented Kalman filter with the scaled sigma point set of 2 N + 1
+  // points. The sigma point weights only depend on N, alpha, beta and kappa
+  // and are computed once in the constructor. Sigma points are spread along
+  // the columns of the Cholesky factor of the covariance and kept in
+  // std::array, so nothing is allocated. The defaults alpha = 1, kappa = 0
+  // give a zero center weight for the mean and avoid the large negative
+  // weights of small alpha, which lose precision in float.
+  template <typename T, uint16_t N>
+  class UnscentedKalmanFilter
+  {
+  public:
+    using StateVector = FixedSizeMatrix<T, N, 1>;
+    using StateMatrix = FixedSizeMatrix<T, N, N>;
+
+    static constexpr size_t kNumSigmaPoints = 2 * static_cast<size_t>(N) + 1;
+
+  private:
+    StateVector x_;
+    StateMatrix P_;
+    std::array<T, kNumSigmaPoints> weights_mean_;
+    std::array<T, kNumSigmaPoints> weights_covariance_;
+    T spread_; // sqrt(N + lambda)
+
+    // Returns false if P_ is not positive definite
+    bool computeSigmaPoints(std::array<StateVector, kNumSigmaPoints> &points) const;
+
+  public:
+    UnscentedKalmanFilter();
+    UnscentedKalmanFilter(const StateVector &x0, const StateMatrix &P0,
+                          T alpha = T(1), T beta = T(2), T kappa = T(0));
+
+    // Propagates the sigma points through the process model f, a callable
+    // taking and returning a StateVector. Returns false and leaves the filter
+    // unchanged if the covariance is not positive definite
+    template <typename ProcessModel>
+    bool predict(const ProcessModel &f, const StateMatrix &Q);
+
+    // Measurement z = h(x) + v with v ~ N(0, R), h is a callable from
+    // StateVector to FixedSizeMatrix<T, M, 1>
+    template <uint16_t M, typename MeasurementModel>
+    bool update(const FixedSizeMatrix<T, M, 1> &z, const MeasurementModel &h,
+                const FixedSizeMatrix<T, M, M> &R);
+
+    const StateVector &getState() const;
+    const StateMatrix &getCovariance() const;
+    void setState(const StateVector &x);
+    void setCovariance(const StateMatrix &P);
+
+    const std::array<T, kNumSigmaPoints> &getMeanWeights() const;
+    const std::array<T, kNumSigmaPoints> &getCovarianceWeights() const;
+  };
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_ESTIMATION_CLASS_DEF_UNSCENTED_KALMAN_FILTER_H_
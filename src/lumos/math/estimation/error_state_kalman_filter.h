@@ -0,0 +1,142 @@
+#ifndef LUMOS_MATH_ESTIMATION_ERROR_STATE_KALMAN_FILTER_H_
+#define LUMOS_MATH_ESTIMATION_ERROR_STATE_KALMAN_FILTER_H_
+
+#include "lumos/math/estimation/class_def/error_state_kalman_filter.h"
+#include "lumos/math/estimation/kalman_common.h"
+
+namespace lumos
+{
+
+  template <typename T>
+  ErrorStateKalmanFilter<T>::ErrorStateKalmanFilter()
+      : q_(), bias_(zerosMatrix<T, 3, 1>()), P_(unitMatrix<T, 6, 6>()),
+        gyro_noise_(T(0)), bias_random_walk_(T(0)) {}
+
+  template <typename T>
+  ErrorStateKalmanFilter<T>::ErrorStateKalmanFilter(const Quaternion<T> &q0,
+                                                    const Vector3 &bias0,
+                                                    const ErrorMatrix &P0,
+                                                    T gyro_noise,
+                                                    T bias_random_walk)
+      : q_(q0), bias_(bias0), P_(P0), gyro_noise_(gyro_noise),
+        bias_random_walk_(bias_random_walk)
+  {
+    q_.normalize();
+  }
+
+  template <typename T>
+  void ErrorStateKalmanFilter<T>::predict(const Vector3 &gyro, T dt)
+  {
+    const Vector3 rotation = (gyro - bias_) * dt;
+    const Quaternion<T> delta = internal::quaternionFromRotationVector(rotation);
+    q_ = q_ * delta;
+    q_.normalize();
+
+    // Error dynamics F = [R(w dt)^T, -I dt; 0, I]
+    const Matrix3 rotation_transposed = delta.conjugate().toRotationMatrix();
+    ErrorMatrix F = unitMatrix<T, 6, 6>();
+    for (size_t r = 0; r < 3; ++r)
+    {
+      for (size_t c = 0; c < 3; ++c)
+      {
+        F(r, c) = rotation_transposed(r, c);
+      }
+      F(r, r + 3) = -dt;
+    }
+
+    P_ = F * P_ * F.transposed();
+    const T angle_variance = gyro_noise_ * gyro_noise_ * dt * dt;
+    const T bias_variance = bias_random_walk_ * bias_random_walk_ * dt;
+    for (size_t i = 0; i < 3; ++i)
+    {
+      P_(i, i) += angle_variance;
+      P_(i + 3, i + 3) += bias_variance;
+    }
+  }
+
+  template <typename T>
+  bool ErrorStateKalmanFilter<T>::updateDirection(const Vector3 &reference_world,
+                                                  const Vector3 &measured_body,
+                                                  const Matrix3 &R)
+  {
+    // predicted = R(q)^T v, and to first order in dtheta the measurement is
+    // predicted + [predicted]x dtheta
+    const Vector3 predicted = q_.toRotationMatrix().transposed() * reference_world;
+    const Matrix3 skew = internal::skewSymmetric(predicted);
+
+    FixedSizeMatrix<T, 3, 6> H = zerosMatrix<T, 3, 6>();
+    for (size_t r = 0; r < 3; ++r)
+    {
+      for (size_t c = 0; c < 3; ++c)
+      {
+        H(r, c) = skew(r, c);
+      }
+    }
+
+    return update(measured_body - predicted, H, R);
+  }
+
+  template <typename T>
+  template <uint16_t M>
+  bool ErrorStateKalmanFilter<T>::update(const FixedSizeMatrix<T, M, 1> &residual,
+                                         const FixedSizeMatrix<T, M, 6> &H,
+                                         const FixedSizeMatrix<T, M, M> &R)
+  {
+    ErrorVector error;
+    if (!internal::linearizedUpdate(error, P_, residual, H, R))
+    {
+      return false;
+    }
+    inject(error);
+    return true;
+  }
+
+  template <typename T>
+  void ErrorStateKalmanFilter<T>::inject(const ErrorVector &error)
+  {
+    Vector3 dtheta;
+    for (size_t i = 0; i < 3; ++i)
+    {
+      dtheta(i, 0) = error(i, 0);
+      bias_(i, 0) += error(i + 3, 0);
+    }
+    q_ = q_ * internal::quaternionFromRotationVector(dtheta);
+    q_.normalize();
+
+    // Resetting the error to zero rotates its covariance, G = diag(I - [dtheta / 2]x, I)
+    const Matrix3 skew = internal::skewSymmetric(dtheta * T(0.5));
+    ErrorMatrix G = unitMatrix<T, 6, 6>();
+    for (size_t r = 0; r < 3; ++r)
+    {
+      for (size_t c = 0; c < 3; ++c)
+      {
+        G(r, c) -= skew(r, c);
+      }
+    }
+    P_ = G * P_ * G.transposed();
+    internal::symmetrize(P_);
+  }
+
+  template <typename T>
+  const Quaternion<T> &ErrorStateKalmanFilter<T>::getAttitude() const
+  {
+    return q_;
+  }
+
+  template <typename T>
+  const typename ErrorStateKalmanFilter<T>::Vector3 &
+  ErrorStateKalmanFilter<T>::getGyroBias() const
+  {
+    return bias_;
+  }
+
+  template <typename T>
+  const typename ErrorStateKalmanFilter<T>::ErrorMatrix &
+  ErrorStateKalmanFilter<T>::getCovariance() const
+  {
+    return P_;
+  }
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_ESTIMATION_ERROR_STATE_KALMAN_FILTER_H_
@@ -0,0 +1,9 @@
+#ifndef LUMOS_MATH_ESTIMATION_ESTIMATION_H_
+#define LUMOS_MATH_ESTIMATION_ESTIMATION_H_
+
+#include "lumos/math/estimation/error_state_kalman_filter.h"
+#include "lumos/math/estimation/kalman_filter.h"
+#include "lumos/math/estimation/particle_filter.h"
+#include "lumos/math/estimation/unscented_kalman_filter.h"
+
+#endif // LUMOS_MATH_ESTIMATION_ESTIMATION_H_
@@ -0,0 +1,164 @@
+#ifndef LUMOS_MATH_ESTIMATION_KALMAN_COMMON_H_
+#define LUMOS_MATH_ESTIMATION_KALMAN_COMMON_H_
+
+#include <cmath>
+#include <cstdint>
+
+#include "lumos/math/lin_alg/matrix_fixed/matrix_fixed.h"
+// Quaternion instantiates its conversions, which need the complete types
+#include "lumos/math/transformations/axis_angle.h"
+#include "lumos/math/transformations/euler_angles.h"
+#include "lumos/math/transformations/quaternion.h"
+
+namespace lumos
+{
+  namespace internal
+  {
+    template <typename T, uint16_t N>
+    void symmetrize(FixedSizeMatrix<T, N, N> &m)
+    {
+      for (size_t r = 0; r < N; ++r)
+      {
+        for (size_t c = r + 1; c < N; ++c)
+        {
+          const T mean = (m(r, c) + m(c, r)) / T(2);
+          m(r, c) = mean;
+          m(c, r) = mean;
+        }
+      }
+    }
+
+    template <typename T, uint16_t N>
+    bool isCholeskyFactor(const FixedSizeMatrix<T, N, N> &l)
+    {
+      for (size_t i = 0; i < N; ++i)
+      {
+        if (!(l(i, i) > T(0)))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    // Solves L * L^T * X = B in place of B, with L from FixedSizeMatrix::cholesky
+    template <typename T, uint16_t N, uint16_t K>
+    void choleskySolve(const FixedSizeMatrix<T, N, N> &l, FixedSizeMatrix<T, N, K> &b)
+    {
+      for (size_t k = 0; k < K; ++k)
+      {
+        for (size_t i = 0; i < N; ++i)
+        {
+          T sum = b(i, k);
+          for (size_t j = 0; j < i; ++j)
+          {
+            sum -= l(i, j) * b(j, k);
+          }
+          b(i, k) = sum / l(i, i);
+        }
+        for (size_t i = N; i-- > 0;)
+        {
+          T sum = b(i, k);
+          for (size_t j = i + 1; j < N; ++j)
+          {
+            sum -= l(j, i) * b(j, k);
+          }
+          b(i, k) = sum / l(i, i);
+        }
+      }
+    }
+
+    // Gain K = Pxz * S^-1 from the state-measurement cross covariance and the
+    // innovation covariance, solved through the Cholesky factor of S instead of
+    // an explicit inverse. Returns false if S is not positive definite
+    template <typename T, uint16_t N, uint16_t M>
+    bool kalmanGain(const FixedSizeMatrix<T, N, M> &cross_covariance,
+                    const FixedSizeMatrix<T, M, M> &innovation_covariance,
+                    FixedSizeMatrix<T, N, M> &gain)
+    {
+      const FixedSizeMatrix<T, M, M> l = innovation_covariance.cholesky();
+      if (!isCholeskyFactor(l))
+      {
+        return false;
+      }
+
+      // S is symmetric, so K^T = S^-1 * Pxz^T
+      FixedSizeMatrix<T, M, N> gain_transposed = cross_covariance.transposed();
+      choleskySolve(l, gain_transposed);
+      gain = gain_transposed.transposed();
+      return true;
+    }
+
+    // Joseph form covariance update (I - K H) P (I - K H)^T + K R K^T, which
+    // stays symmetric positive semi-definite for any gain K
+    template <typename T, uint16_t N, uint16_t M>
+    void josephUpdate(FixedSizeMatrix<T, N, N> &covariance,
+                      const FixedSizeMatrix<T, N, M> &gain,
+                      const FixedSizeMatrix<T, M, N> &measurement_matrix,
+                      const FixedSizeMatrix<T, M, M> &measurement_noise)
+    {
+      const FixedSizeMatrix<T, N, N> a =
+          unitMatrix<T, N, N>() - gain * measurement_matrix;
+      covariance = a * covariance * a.transposed() +
+                   gain * measurement_noise * gain.transposed();
+      symmetrize(covariance);
+    }
+
+    // Linear measurement update shared by the KF, EKF and ESKF, for the
+    // residual y = z - h(x) and measurement matrix H
+    template <typename T, uint16_t N, uint16_t M>
+    bool linearizedUpdate(FixedSizeMatrix<T, N, 1> &correction,
+                          FixedSizeMatrix<T, N, N> &covariance,
+                          const FixedSizeMatrix<T, M, 1> &residual,
+                          const FixedSizeMatrix<T, M, N> &measurement_matrix,
+                          const FixedSizeMatrix<T, M, M> &measurement_noise)
+    {
+      const FixedSizeMatrix<T, N, M> cross_covariance =
+          covariance * measurement_matrix.transposed();
+      const FixedSizeMatrix<T, M, M> innovation_covariance =
+          measurement_matrix * cross_covariance + measurement_noise;
+
+      FixedSizeMatrix<T, N, M> gain;
+      if (!kalmanGain(cross_covariance, innovation_covariance, gain))
+      {
+        return false;
+      }
+
+      correction = gain * residual;
+      josephUpdate(covariance, gain, measurement_matrix, measurement_noise);
+      return true;
+    }
+
+    template <typename T>
+    FixedSizeMatrix<T, 3, 3> skewSymmetric(const FixedSizeMatrix<T, 3, 1> &v)
+    {
+      FixedSizeMatrix<T, 3, 3> m;
+      m(0, 0) = T(0);
+      m(0, 1) = -v(2, 0);
+      m(0, 2) = v(1, 0);
+      m(1, 0) = v(2, 0);
+      m(1, 1) = T(0);
+      m(1, 2) = -v(0, 0);
+      m(2, 0) = -v(1, 0);
+      m(2, 1) = v(0, 0);
+      m(2, 2) = T(0);
+      return m;
+    }
+
+    // Unit quaternion of the rotation by |v| about v, the exponential map
+    template <typename T>
+    Quaternion<T> quaternionFromRotationVector(const FixedSizeMatrix<T, 3, 1> &v)
+    {
+      const T angle_sq = v(0, 0) * v(0, 0) + v(1, 0) * v(1, 0) + v(2, 0) * v(2, 0);
+      const T angle = std::sqrt(angle_sq);
+
+      // sin(a / 2) / a from its Taylor series near zero
+      const T half_sinc = angle < T(1e-4) ? T(0.5) - angle_sq / T(48)
+                                          : std::sin(angle / T(2)) / angle;
+      return Quaternion<T>(std::cos(angle / T(2)), half_sinc * v(0, 0),
+                           half_sinc * v(1, 0), half_sinc * v(2, 0));
+    }
+  } // namespace internal
+} // namespace lumos
+
+#endif // LUMOS_MATH_ESTIMATION_KALMAN_COMMON_H_
@@ -0,0 +1,135 @@
+#ifndef LUMOS_MATH_ESTIMATION_KALMAN_FILTER_H_
+#define LUMOS_MATH_ESTIMATION_KALMAN_FILTER_H_
+
+#include "lumos/math/estimation/class_def/kalman_filter.h"
+#include "lumos/math/estimation/kalman_common.h"
+
+namespace lumos
+{
+
+  // =============================================================================
+  // KalmanFilter
+  // =============================================================================
+
+  template <typename T, uint16_t N>
+  KalmanFilter<T, N>::KalmanFilter()
+      : x_(zerosMatrix<T, N, 1>()), P_(unitMatrix<T, N, N>()) {}
+
+  template <typename T, uint16_t N>
+  KalmanFilter<T, N>::KalmanFilter(const StateVector &x0, const StateMatrix &P0)
+      : x_(x0), P_(P0) {}
+
+  template <typename T, uint16_t N>
+  void KalmanFilter<T, N>::predict(const StateMatrix &F, const StateMatrix &Q)
+  {
+    x_ = F * x_;
+    P_ = F * P_ * F.transposed() + Q;
+  }
+
+  template <typename T, uint16_t N>
+  template <uint16_t U>
+  void KalmanFilter<T, N>::predict(const StateMatrix &F,
+                                   const FixedSizeMatrix<T, N, U> &B,
+                                   const FixedSizeMatrix<T, U, 1> &u,
+                                   const StateMatrix &Q)
+  {
+    x_ = F * x_ + B * u;
+    P_ = F * P_ * F.transposed() + Q;
+  }
+
+  template <typename T, uint16_t N>
+  template <uint16_t M>
+  bool KalmanFilter<T, N>::update(const FixedSizeMatrix<T, M, 1> &z,
+                                  const FixedSizeMatrix<T, M, N> &H,
+                                  const FixedSizeMatrix<T, M, M> &R)
+  {
+    StateVector correction;
+    if (!internal::linearizedUpdate(correction, P_, z - H * x_, H, R))
+    {
+      return false;
+    }
+    x_ = x_ + correction;
+    return true;
+  }
+
+  template <typename T, uint16_t N>
+  const typename KalmanFilter<T, N>::StateVector &KalmanFilter<T, N>::getState() const
+  {
+    return x_;
+  }
+
+  template <typename T, uint16_t N>
+  const typename KalmanFilter<T, N>::StateMatrix &KalmanFilter<T, N>::getCovariance() const
+  {
+    return P_;
+  }
+
+  template <typename T, uint16_t N>
+  void KalmanFilter<T, N>::setState(const StateVector &x) { x_ = x; }
+
+  template <typename T, uint16_t N>
+  void KalmanFilter<T, N>::setCovariance(const StateMatrix &P) { P_ = P; }
+
+  // =============================================================================
+  // ExtendedKalmanFilter
+  // =============================================================================
+
+  template <typename T, uint16_t N>
+  ExtendedKalmanFilter<T, N>::ExtendedKalmanFilter()
+      : x_(zerosMatrix<T, N, 1>()), P_(unitMatrix<T, N, N>()) {}
+
+  template <typename T, uint16_t N>
+  ExtendedKalmanFilter<T, N>::ExtendedKalmanFilter(const StateVector &x0,
+                                                   const StateMatrix &P0)
+      : x_(x0), P_(P0) {}
+
+  template <typename T, uint16_t N>
+  template <typename ProcessModel>
+  void ExtendedKalmanFilter<T, N>::predict(const ProcessModel &f,
+                                           const StateMatrix &F,
+                                           const StateMatrix &Q)
+  {
+    x_ = f(x_);
+    P_ = F * P_ * F.transposed() + Q;
+  }
+
+  template <typename T, uint16_t N>
+  template <uint16_t M, typename MeasurementModel>
+  bool ExtendedKalmanFilter<T, N>::update(const FixedSizeMatrix<T, M, 1> &z,
+                                          const MeasurementModel &h,
+                                          const FixedSizeMatrix<T, M, N> &H,
+                                          const FixedSizeMatrix<T, M, M> &R)
+  {
+    const FixedSizeMatrix<T, M, 1> predicted = h(x_);
+    StateVector correction;
+    if (!internal::linearizedUpdate(correction, P_, z - predicted, H, R))
+    {
+      return false;
+    }
+    x_ = x_ + correction;
+    return true;
+  }
+
+  template <typename T, uint16_t N>
+  const typename ExtendedKalmanFilter<T, N>::StateVector &
+  ExtendedKalmanFilter<T, N>::getState() const
+  {
+    return x_;
+  }
+
+  template <typename T, uint16_t N>
+  const typename ExtendedKalmanFilter<T, N>::StateMatrix &
+  ExtendedKalmanFilter<T, N>::getCovariance() const
+  {
+    return P_;
+  }
+
+  template <typename T, uint16_t N>
+  void ExtendedKalmanFilter<T, N>::setState(const StateVector &x) { x_ = x; }
+
+  template <typename T, uint16_t N>
+  void ExtendedKalmanFilter<T, N>::setCovariance(const StateMatrix &P) { P_ = P; }
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_ESTIMATION_KALMAN_FILTER_H_
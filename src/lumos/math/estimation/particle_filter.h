@@ -0,0 +1,393 @@
+#ifndef LUMOS_MATH_ESTIMATION_PARTICLE_FILTER_H_
+#define LUMOS_MATH_ESTIMATION_PARTICLE_FILTER_H_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "lumos/math/estimation/class_def/particle_filter.h"
+#include "lumos/math/lin_alg/matrix_fixed/matrix_fixed.h"
+#include "lumos/math/lin_alg/vector_dynamic/vector_dynamic.h"
+#include "lumos/math/misc/parallel_for.h"
+
+namespace lumos
+{
+
+  template <typename T, uint16_t D>
+  ParticleFilter<T, D>::ParticleFilter()
+      : num_particles_(0), num_blocks_(0), num_threads_(1),
+        effective_sample_size_(T(0)) {}
+
+  template <typename T, uint16_t D>
+  ParticleFilter<T, D>::ParticleFilter(size_t num_particles, uint32_t seed,
+                                       size_t num_threads)
+      : num_particles_(num_particles),
+        num_blocks_((num_particles + kBlockSize - 1) / kBlockSize),
+        num_threads_(num_threads), log_weights_(num_particles),
+        cumulative_weights_(num_particles), ancestors_(num_particles),
+        block_values_((num_particles + kBlockSize - 1) / kBlockSize), rng_(seed)
+  {
+    if (num_particles == 0)
+    {
+      throw std::invalid_argument("Number of particles must be greater than 0");
+    }
+
+    for (size_t d = 0; d < D; ++d)
+    {
+      particles_[d] = Vector<T>(num_particles);
+      resampled_[d] = Vector<T>(num_particles);
+    }
+
+    block_rngs_.reserve(num_blocks_);
+    for (size_t b = 0; b < num_blocks_; ++b)
+    {
+      std::seed_seq block_seed{seed, static_cast<uint32_t>(b)};
+      block_rngs_.emplace_back(block_seed);
+    }
+
+    for (size_t i = 0; i < num_particles; ++i)
+    {
+      ancestors_[i] = i;
+    }
+    setUniformWeights();
+  }
+
+  template <typename T, uint16_t D>
+  ParticleBlock<T, D> ParticleFilter<T, D>::makeBlock(size_t block)
+  {
+    const size_t offset = block * kBlockSize;
+
+    ParticleBlock<T, D> particle_block;
+    for (size_t d = 0; d < D; ++d)
+    {
+      particle_block.state[d] = particles_[d].data() + offset;
+    }
+    particle_block.log_weights = log_weights_.data() + offset;
+    particle_block.size = std::min(kBlockSize, num_particles_ - offset);
+    particle_block.offset = offset;
+    particle_block.rng = &block_rngs_[block];
+    return particle_block;
+  }
+
+  template <typename T, uint16_t D>
+  template <typename F>
+  void ParticleFilter<T, D>::forEachBlock(const F &f)
+  {
+    internal::parallelFor(
+        0, num_blocks_, 1,
+        [&](const size_t block_begin, const size_t block_end)
+        {
+          for (size_t block = block_begin; block < block_end; ++block)
+          {
+            f(block);
+          }
+        },
+        num_threads_);
+  }
+
+  template <typename T, uint16_t D>
+  void ParticleFilter<T, D>::setUniformWeights()
+  {
+    log_weights_.fill(-std::log(static_cast<T>(num_particles_)));
+    effective_sample_size_ = static_cast<T>(num_particles_);
+  }
+
+  template <typename T, uint16_t D>
+  template <typename Initializer>
+  void ParticleFilter<T, D>::initialize(const Initializer &init)
+  {
+    forEachBlock(
+        [&](const size_t block)
+        {
+          ParticleBlock<T, D> particle_block = makeBlock(block);
+          init(particle_block);
+        });
+    setUniformWeights();
+  }
+
+  template <typename T, uint16_t D>
+  template <typename MotionModel>
+  void ParticleFilter<T, D>::predict(const MotionModel &motion)
+  {
+    forEachBlock(
+        [&](const size_t block)
+        {
+          ParticleBlock<T, D> particle_block = makeBlock(block);
+          motion(particle_block);
+        });
+  }
+
+  template <typename T, uint16_t D>
+  template <typename LogLikelihood>
+  bool ParticleFilter<T, D>::update(const LogLikelihood &log_likelihood)
+  {
+    const T lowest = -std::numeric_limits<T>::infinity();
+
+    // Weighting and the block maxima in one pass over the weights
+    forEachBlock(
+        [&](const size_t block)
+        {
+          ParticleBlock<T, D> particle_block = makeBlock(block);
+          log_likelihood(particle_block);
+
+          T block_max = lowest;
+          for (size_t i = 0; i < particle_block.size; ++i)
+          {
+            block_max = std::max(block_max, particle_block.log_weights[i]);
+          }
+          block_values_[block] = block_max;
+        });
+
+    const T max_log_weight = *std::max_element(block_values_.begin(), block_values_.end());
+    if (!(max_log_weight > lowest) || !std::isfinite(max_log_weight))
+    {
+      setUniformWeights();
+      return false;
+    }
+
+    // log(sum(exp(w))) = max + log(sum(exp(w - max))), every term is <= 1
+    forEachBlock(
+        [&](const size_t block)
+        {
+          const size_t begin = block * kBlockSize;
+          const size_t end = std::min(begin + kBlockSize, num_particles_);
+          const T *const log_weights = log_weights_.data();
+
+          T sum = T(0);
+          for (size_t i = begin; i < end; ++i)
+          {
+            sum += std::exp(log_weights[i] - max_log_weight);
+          }
+          block_values_[block] = sum;
+        });
+
+    // Blocks are summed in a fixed order, so the result does not depend on
+    // the thread count
+    T total = T(0);
+    for (const T sum : block_values_)
+    {
+      total += sum;
+    }
+    const T log_normalizer = max_log_weight + std::log(total);
+
+    forEachBlock(
+        [&](const size_t block)
+        {
+          const size_t begin = block * kBlockSize;
+          const size_t end = std::min(begin + kBlockSize, num_particles_);
+          T *const log_weights = log_weights_.data();
+
+          T sum_squares = T(0);
+          for (size_t i = begin; i < end; ++i)
+          {
+            log_weights[i] -= log_normalizer;
+            const T w = std::exp(log_weights[i]);
+            sum_squares += w * w;
+          }
+          block_values_[block] = sum_squares;
+        });
+
+    T sum_squares = T(0);
+    for (const T s : block_values_)
+    {
+      sum_squares += s;
+    }
+    effective_sample_size_ = T(1) / sum_squares;
+
+    return true;
+  }
+
+  template <typename T, uint16_t D>
+  size_t ParticleFilter<T, D>::findAncestor(T position, size_t first) const
+  {
+    const T *const cdf = cumulative_weights_.data();
+    const size_t idx = static_cast<size_t>(
+        std::upper_bound(cdf + first, cdf + num_particles_, position) - cdf);
+    return std::min(idx, num_particles_ - 1);
+  }
+
+  template <typename T, uint16_t D>
+  void ParticleFilter<T, D>::resample(ResamplingScheme scheme)
+  {
+    if (num_particles_ == 0)
+    {
+      return;
+    }
+
+    // Cumulative weights: prefix sums within blocks, then a sequential scan
+    // over the block totals and a parallel pass adding the block offsets
+    T *const cdf = cumulative_weights_.data();
+    forEachBlock(
+        [&](const size_t block)
+        {
+          const size_t begin = block * kBlockSize;
+          const size_t end = std::min(begin + kBlockSize, num_particles_);
+          const T *const log_weights = log_weights_.data();
+
+          T sum = T(0);
+          for (size_t i = begin; i < end; ++i)
+          {
+            sum += std::exp(log_weights[i]);
+            cdf[i] = sum;
+          }
+          block_values_[block] = sum;
+        });
+
+    T offset = T(0);
+    for (T &value : block_values_)
+    {
+      const T block_sum = value;
+      value = offset;
+      offset += block_sum;
+    }
+    const T total = offset;
+
+    forEachBlock(
+        [&](const size_t block)
+        {
+          const size_t begin = block * kBlockSize;
+          const size_t end = std::min(begin + kBlockSize, num_particles_);
+          const T block_offset = block_values_[block];
+          for (size_t i = begin; i < end; ++i)
+          {
+            cdf[i] += block_offset;
+          }
+        });
+
+    // Positions (j + u_j) / N * total increase with j, so every output block
+    // searches for its first ancestor and then walks the cumulative weights
+    std::uniform_real_distribution<T> uniform(T(0), T(1));
+    const T systematic_offset = uniform(rng_);
+    const T step = total / static_cast<T>(num_particles_);
+
+    forEachBlock(
+        [&](const size_t block)
+        {
+          const size_t begin = block * kBlockSize;
+          const size_t end = std::min(begin + kBlockSize, num_particles_);
+          std::uniform_real_distribution<T> block_uniform(T(0), T(1));
+          std::mt19937 &block_rng = block_rngs_[block];
+
+          const auto position = [&](const size_t j)
+          {
+            const T u = scheme == ResamplingScheme::Systematic ? systematic_offset
+                                                               : block_uniform(block_rng);
+            return (static_cast<T>(j) + u) * step;
+          };
+
+          T pos = position(begin);
+          size_t ancestor = findAncestor(pos, 0);
+          for (size_t j = begin; j < end; ++j)
+          {
+            if (j > begin)
+            {
+              pos = position(j);
+            }
+            while ((ancestor + 1 < num_particles_) && !(pos < cdf[ancestor]))
+            {
+              ++ancestor;
+            }
+            ancestors_[j] = ancestor;
+          }
+
+          // Gather dimension by dimension
+          for (size_t d = 0; d < D; ++d)
+          {
+            const T *const src = particles_[d].data();
+            T *const dst = resampled_[d].data();
+            for (size_t j = begin; j < end; ++j)
+            {
+              dst[j] = src[ancestors_[j]];
+            }
+          }
+        });
+
+    std::swap(particles_, resampled_);
+    setUniformWeights();
+  }
+
+  template <typename T, uint16_t D>
+  bool ParticleFilter<T, D>::resampleIfNeeded(T ratio, ResamplingScheme scheme)
+  {
+    if (effective_sample_size_ < ratio * static_cast<T>(num_particles_))
+    {
+      resample(scheme);
+      return true;
+    }
+    return false;
+  }
+
+  template <typename T, uint16_t D>
+  FixedSizeMatrix<T, D, 1> ParticleFilter<T, D>::getMean() const
+  {
+    std::vector<std::array<T, D>> block_sums(num_blocks_);
+    internal::parallelFor(
+        0, num_blocks_, 1,
+        [&](const size_t block_begin, const size_t block_end)
+        {
+          for (size_t block = block_begin; block < block_end; ++block)
+          {
+            const size_t begin = block * kBlockSize;
+            const size_t end = std::min(begin + kBlockSize, num_particles_);
+            const T *const log_weights = log_weights_.data();
+
+            std::array<T, D> &sums = block_sums[block];
+            sums.fill(T(0));
+            for (size_t d = 0; d < D; ++d)
+            {
+              const T *const state = particles_[d].data();
+              for (size_t i = begin; i < end; ++i)
+              {
+                sums[d] += std::exp(log_weights[i]) * state[i];
+              }
+            }
+          }
+        },
+        num_threads_);
+
+    FixedSizeMatrix<T, D, 1> mean = zerosMatrix<T, D, 1>();
+    for (const std::array<T, D> &sums : block_sums)
+    {
+      for (size_t d = 0; d < D; ++d)
+      {
+        mean(d, 0) += sums[d];
+      }
+    }
+    return mean;
+  }
+
+  template <typename T, uint16_t D>
+  const Vector<T> &ParticleFilter<T, D>::getState(size_t dimension) const
+  {
+    return particles_[dimension];
+  }
+
+  template <typename T, uint16_t D>
+  const Vector<T> &ParticleFilter<T, D>::getLogWeights() const
+  {
+    return log_weights_;
+  }
+
+  template <typename T, uint16_t D>
+  const std::vector<size_t> &ParticleFilter<T, D>::getAncestors() const
+  {
+    return ancestors_;
+  }
+
+  template <typename T, uint16_t D>
+  T ParticleFilter<T, D>::getEffectiveSampleSize() const
+  {
+    return effective_sample_size_;
+  }
+
+  template <typename T, uint16_t D>
+  size_t ParticleFilter<T, D>::getNumParticles() const
+  {
+    return num_particles_;
+  }
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_ESTIMATION_PARTICLE_FILTER_H_
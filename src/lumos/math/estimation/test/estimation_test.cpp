@@ -0,0 +1,455 @@
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+
+#include "lumos/math/estimation/estimation.h"
+
+namespace lumos
+{
+
+  namespace
+  {
+    // Constant velocity model in 2D, state [px, py, vx, vy], position measured
+    constexpr double kDt = 0.1;
+
+    FixedSizeMatrix<double, 4, 4> constantVelocityTransition()
+    {
+      FixedSizeMatrix<double, 4, 4> F = unitMatrix<double, 4, 4>();
+      F(0, 2) = kDt;
+      F(1, 3) = kDt;
+      return F;
+    }
+
+    FixedSizeMatrix<double, 2, 4> positionMeasurementMatrix()
+    {
+      FixedSizeMatrix<double, 2, 4> H = zerosMatrix<double, 2, 4>();
+      H(0, 0) = 1.0;
+      H(1, 1) = 1.0;
+      return H;
+    }
+
+    FixedSizeMatrix<double, 2, 1> vector2(const double x, const double y)
+    {
+      FixedSizeMatrix<double, 2, 1> v;
+      v(0, 0) = x;
+      v(1, 0) = y;
+      return v;
+    }
+
+    FixedSizeMatrix<double, 3, 1> vector3(const double x, const double y, const double z)
+    {
+      FixedSizeMatrix<double, 3, 1> v;
+      v(0, 0) = x;
+      v(1, 0) = y;
+      v(2, 0) = z;
+      return v;
+    }
+  } // namespace
+
+  TEST(KalmanFilterTest, ScalarRandomConstant)
+  {
+    // Estimating a constant from noisy samples gives the sample mean with
+    // variance R / n once the prior is negligible
+    FixedSizeMatrix<double, 1, 1> x0;
+    x0(0, 0) = 0.0;
+    FixedSizeMatrix<double, 1, 1> P0;
+    P0(0, 0) = 1e12;
+    KalmanFilter<double, 1> kf(x0, P0);
+
+    const FixedSizeMatrix<double, 1, 1> F = unitMatrix<double, 1, 1>();
+    const FixedSizeMatrix<double, 1, 1> Q = zerosMatrix<double, 1, 1>();
+    FixedSizeMatrix<double, 1, 1> R;
+    R(0, 0) = 4.0;
+
+    const double samples[] = {3.1, 2.7, 3.4, 2.9, 3.0, 3.3, 2.6, 3.2};
+    double sum = 0.0;
+    for (const double s : samples)
+    {
+      FixedSizeMatrix<double, 1, 1> z;
+      z(0, 0) = s;
+      kf.predict(F, Q);
+      ASSERT_TRUE(kf.update(z, unitMatrix<double, 1, 1>(), R));
+      sum += s;
+    }
+
+    EXPECT_NEAR(kf.getState()(0, 0), sum / 8.0, 1e-9);
+    EXPECT_NEAR(kf.getCovariance()(0, 0), 4.0 / 8.0, 1e-9);
+  }
+
+  TEST(KalmanFilterTest, TracksConstantVelocityAndRejectsBadNoise)
+  {
+    KalmanFilter<double, 4> kf;
+    const auto F = constantVelocityTransition();
+    const auto H = positionMeasurementMatrix();
+    const FixedSizeMatrix<double, 4, 4> Q = unitMatrix<double, 4, 4>() * 1e-6;
+    const FixedSizeMatrix<double, 2, 2> R = unitMatrix<double, 2, 2>() * 0.01;
+
+    std::mt19937 gen(3);
+    std::normal_distribution<double> noise(0.0, 0.1);
+    for (size_t i = 1; i <= 400; ++i)
+    {
+      const double t = static_cast<double>(i) * kDt;
+      kf.predict(F, Q);
+      ASSERT_TRUE(kf.update(vector2(1.0 + 2.0 * t + noise(gen), -0.5 * t + noise(gen)), H, R));
+    }
+
+    EXPECT_NEAR(kf.getState()(2, 0), 2.0, 0.05);
+    EXPECT_NEAR(kf.getState()(3, 0), -0.5, 0.05);
+    for (size_t r = 0; r < 4; ++r)
+    {
+      for (size_t c = 0; c < 4; ++c)
+      {
+        EXPECT_DOUBLE_EQ(kf.getCovariance()(r, c), kf.getCovariance()(c, r));
+      }
+    }
+
+    // A negative definite measurement noise gives no valid gain
+    const auto state = kf.getState();
+    EXPECT_FALSE(kf.update(vector2(0.0, 0.0), H, FixedSizeMatrix<double, 2, 2>(R * -1e6)));
+    EXPECT_EQ(kf.getState()(0, 0), state(0, 0));
+
+    // Control input through B u
+    KalmanFilter<double, 4> controlled;
+    FixedSizeMatrix<double, 4, 2> B = zerosMatrix<double, 4, 2>();
+    B(2, 0) = kDt;
+    B(3, 1) = kDt;
+    controlled.predict(F, B, vector2(10.0, -20.0), Q);
+    EXPECT_NEAR(controlled.getState()(2, 0), 1.0, 1e-12);
+    EXPECT_NEAR(controlled.getState()(3, 0), -2.0, 1e-12);
+  }
+
+  TEST(KalmanFilterTest, LinearModelsAgreeAcrossFilters)
+  {
+    // For a linear system the EKF and UKF are exact, and match the KF
+    FixedSizeMatrix<double, 4, 1> x0 = zerosMatrix<double, 4, 1>();
+    x0(0, 0) = 1.0;
+    FixedSizeMatrix<double, 4, 4> P0 = unitMatrix<double, 4, 4>() * 2.0;
+    P0(0, 2) = 0.5;
+    P0(2, 0) = 0.5;
+
+    const auto F = constantVelocityTransition();
+    const auto H = positionMeasurementMatrix();
+    const FixedSizeMatrix<double, 4, 4> Q = unitMatrix<double, 4, 4>() * 1e-3;
+    const FixedSizeMatrix<double, 2, 2> R = unitMatrix<double, 2, 2>() * 0.05;
+    const auto f = [&F](const FixedSizeMatrix<double, 4, 1> &x) { return FixedSizeMatrix<double, 4, 1>(F * x); };
+    const auto h = [&H](const FixedSizeMatrix<double, 4, 1> &x) { return FixedSizeMatrix<double, 2, 1>(H * x); };
+
+    KalmanFilter<double, 4> kf(x0, P0);
+    ExtendedKalmanFilter<double, 4> ekf(x0, P0);
+    UnscentedKalmanFilter<double, 4> ukf(x0, P0, 0.5, 2.0, 1.0);
+
+    double weight_sum = 0.0;
+    for (const double w : ukf.getMeanWeights())
+    {
+      weight_sum += w;
+    }
+    EXPECT_NEAR(weight_sum, 1.0, 1e-12);
+
+    for (size_t i = 0; i < 50; ++i)
+    {
+      const auto z = vector2(std::sin(0.1 * static_cast<double>(i)), 0.3 * static_cast<double>(i));
+      kf.predict(F, Q);
+      ekf.predict(f, F, Q);
+      ASSERT_TRUE(ukf.predict(f, Q));
+      ASSERT_TRUE(kf.update(z, H, R));
+      ASSERT_TRUE(ekf.update(z, h, H, R));
+      ASSERT_TRUE(ukf.update(z, h, R));
+    }
+
+    for (size_t r = 0; r < 4; ++r)
+    {
+      EXPECT_NEAR(ekf.getState()(r, 0), kf.getState()(r, 0), 1e-12);
+      EXPECT_NEAR(ukf.getState()(r, 0), kf.getState()(r, 0), 1e-9);
+      for (size_t c = 0; c < 4; ++c)
+      {
+        EXPECT_NEAR(ekf.getCovariance()(r, c), kf.getCovariance()(r, c), 1e-12);
+        EXPECT_NEAR(ukf.getCovariance()(r, c), kf.getCovariance()(r, c), 1e-9);
+      }
+    }
+  }
+
+  TEST(KalmanFilterTest, NonlinearRangeBearing)
+  {
+    // Static 2D position observed by range and bearing from the origin
+    const double px = 3.0;
+    const double py = 4.0;
+    const auto h = [](const FixedSizeMatrix<double, 2, 1> &x)
+    {
+      return vector2(std::sqrt(x(0, 0) * x(0, 0) + x(1, 0) * x(1, 0)), std::atan2(x(1, 0), x(0, 0)));
+    };
+    const auto jacobian = [](const FixedSizeMatrix<double, 2, 1> &x)
+    {
+      const double r2 = x(0, 0) * x(0, 0) + x(1, 0) * x(1, 0);
+      const double r = std::sqrt(r2);
+      FixedSizeMatrix<double, 2, 2> H;
+      H(0, 0) = x(0, 0) / r;
+      H(0, 1) = x(1, 0) / r;
+      H(1, 0) = -x(1, 0) / r2;
+      H(1, 1) = x(0, 0) / r2;
+      return H;
+    };
+    const auto identity = [](const FixedSizeMatrix<double, 2, 1> &x) { return x; };
+
+    const FixedSizeMatrix<double, 2, 2> P0 = unitMatrix<double, 2, 2>();
+    const FixedSizeMatrix<double, 2, 2> Q = zerosMatrix<double, 2, 2>();
+    FixedSizeMatrix<double, 2, 2> R = zerosMatrix<double, 2, 2>();
+    R(0, 0) = 0.01;
+    R(1, 1) = 1e-4;
+
+    ExtendedKalmanFilter<double, 2> ekf(vector2(2.5, 4.5), P0);
+    UnscentedKalmanFilter<double, 2> ukf(vector2(2.5, 4.5), P0);
+    const auto z = vector2(5.0, std::atan2(py, px));
+    for (size_t i = 0; i < 20; ++i)
+    {
+      ekf.predict(identity, unitMatrix<double, 2, 2>(), Q);
+      ASSERT_TRUE(ekf.update(z, h, jacobian(ekf.getState()), R));
+      ASSERT_TRUE(ukf.predict(identity, Q));
+      ASSERT_TRUE(ukf.update(z, h, R));
+    }
+
+    EXPECT_NEAR(ekf.getState()(0, 0), px, 1e-2);
+    EXPECT_NEAR(ekf.getState()(1, 0), py, 1e-2);
+    EXPECT_NEAR(ukf.getState()(0, 0), px, 1e-2);
+    EXPECT_NEAR(ukf.getState()(1, 0), py, 1e-2);
+  }
+
+  TEST(ErrorStateKalmanFilterTest, EstimatesAttitudeAndGyroBias)
+  {
+    // Body rotating about a tilted axis with a biased gyro, corrected by
+    // gravity and magnetic north
+    const auto true_rate = vector3(0.2, -0.1, 0.3);
+    const auto true_bias = vector3(0.02, -0.01, 0.015);
+    const double dt = 0.01;
+
+    ErrorStateKalmanFilter<double>::ErrorMatrix P0 = unitMatrix<double, 6, 6>() * 0.01;
+    for (size_t i = 3; i < 6; ++i)
+    {
+      P0(i, i) = 1e-3;
+    }
+    ErrorStateKalmanFilter<double> eskf(Quaternion<double>(), zerosMatrix<double, 3, 1>(), P0, 1e-3, 1e-4);
+
+    const auto gravity = vector3(0.0, 0.0, 1.0);
+    const auto north = vector3(1.0, 0.0, 0.0);
+    const FixedSizeMatrix<double, 3, 3> R = unitMatrix<double, 3, 3>() * 1e-4;
+
+    Quaternion<double> truth;
+    for (size_t i = 0; i < 3000; ++i)
+    {
+      truth = truth * internal::quaternionFromRotationVector(FixedSizeMatrix<double, 3, 1>(true_rate * dt));
+      truth.normalize();
+
+      eskf.predict(true_rate + true_bias, dt);
+      if (i % 10 == 0)
+      {
+        const FixedSizeMatrix<double, 3, 3> world_to_body = truth.toRotationMatrix().transposed();
+        ASSERT_TRUE(eskf.updateDirection(gravity, world_to_body * gravity, R));
+        ASSERT_TRUE(eskf.updateDirection(north, world_to_body * north, R));
+      }
+    }
+
+    // Attitude error as the angle of truth^-1 * estimate
+    const Quaternion<double> error = truth.conjugate() * eskf.getAttitude();
+    EXPECT_LT(2.0 * std::acos(std::min(1.0, std::abs(error.w))), 1e-3);
+    for (size_t i = 0; i < 3; ++i)
+    {
+      EXPECT_NEAR(eskf.getGyroBias()(i, 0), true_bias(i, 0), 2e-3);
+    }
+  }
+
+  TEST(ErrorStateKalmanFilterTest, FloatFilterStaysNormalized)
+  {
+    ErrorStateKalmanFilter<float> eskf;
+    FixedSizeMatrix<float, 3, 1> gyro;
+    gyro(0, 0) = 1.0f;
+    gyro(1, 0) = 0.5f;
+    gyro(2, 0) = -0.25f;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      eskf.predict(gyro, 0.01f);
+    }
+
+    const Quaternion<float> &q = eskf.getAttitude();
+    EXPECT_NEAR(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z, 1.0f, 1e-5f);
+  }
+
+  TEST(ParticleFilterTest, StableLogWeightNormalization)
+  {
+    ParticleFilter<double, 1> pf(10000, 7, 4);
+    pf.initialize(
+        [](ParticleBlock<double, 1> &block)
+        {
+          for (size_t i = 0; i < block.size; ++i)
+          {
+            block.state[0][i] = static_cast<double>(block.offset + i);
+          }
+        });
+    EXPECT_DOUBLE_EQ(pf.getEffectiveSampleSize(), 10000.0);
+
+    // Log-likelihoods far below the range of exp, half the particles twice as likely
+    ASSERT_TRUE(pf.update(
+        [](ParticleBlock<double, 1> &block)
+        {
+          for (size_t i = 0; i < block.size; ++i)
+          {
+            block.log_weights[i] += -1e4 + ((block.offset + i) % 2 == 0 ? std::log(2.0) : 0.0);
+          }
+        }));
+
+    double sum = 0.0;
+    double sum_squares = 0.0;
+    for (size_t i = 0; i < pf.getNumParticles(); ++i)
+    {
+      const double w = std::exp(pf.getLogWeights()(i));
+      EXPECT_NEAR(w, (i % 2 == 0 ? 2.0 : 1.0) / 15000.0, 1e-15);
+      sum += w;
+      sum_squares += w * w;
+    }
+    EXPECT_NEAR(sum, 1.0, 1e-9);
+    EXPECT_NEAR(pf.getEffectiveSampleSize(), 1.0 / sum_squares, 1e-6);
+    EXPECT_NEAR(pf.getMean()(0, 0), (2.0 * 24995000.0 + 25000000.0) / 15000.0, 1e-6);
+
+    // No particle explains the measurement
+    EXPECT_FALSE(pf.update(
+        [](ParticleBlock<double, 1> &block)
+        {
+          std::fill(block.log_weights, block.log_weights + block.size, -std::numeric_limits<double>::infinity());
+        }));
+    EXPECT_DOUBLE_EQ(pf.getEffectiveSampleSize(), 10000.0);
+  }
+
+  TEST(ParticleFilterTest, ResamplingFollowsWeights)
+  {
+    const size_t num_particles = 20000;
+    const auto init = [](ParticleBlock<double, 2> &block)
+    {
+      for (size_t i = 0; i < block.size; ++i)
+      {
+        block.state[0][i] = static_cast<double>((block.offset + i) % 4);
+        block.state[1][i] = -static_cast<double>((block.offset + i) % 4);
+      }
+    };
+    // Weight proportional to 1, 2, 3, 4 for the four kinds of particle
+    const auto weight = [](ParticleBlock<double, 2> &block)
+    {
+      for (size_t i = 0; i < block.size; ++i)
+      {
+        block.log_weights[i] += std::log(block.state[0][i] + 1.0);
+      }
+    };
+
+    for (const ResamplingScheme scheme : {ResamplingScheme::Systematic, ResamplingScheme::Stratified})
+    {
+      ParticleFilter<double, 2> pf(num_particles, 11, 3);
+      pf.initialize(init);
+      ASSERT_TRUE(pf.update(weight));
+      EXPECT_FALSE(pf.resampleIfNeeded(0.5, scheme));
+      const Vector<double> log_weights = pf.getLogWeights();
+      pf.resample(scheme);
+
+      std::vector<size_t> copies(num_particles, 0);
+      size_t counts[4] = {0, 0, 0, 0};
+      for (size_t i = 0; i < num_particles; ++i)
+      {
+        const size_t ancestor = pf.getAncestors()[i];
+        ASSERT_EQ(pf.getState(0)(i), static_cast<double>(ancestor % 4));
+        ASSERT_EQ(pf.getState(1)(i), -pf.getState(0)(i));
+        ++copies[ancestor];
+        ++counts[ancestor % 4];
+      }
+
+      if (scheme == ResamplingScheme::Systematic)
+      {
+        // The number of copies of particles 0..k is within one of N * cdf(k)
+        double cdf = 0.0;
+        double num_copies = 0.0;
+        for (size_t i = 0; i < num_particles; ++i)
+        {
+          cdf += std::exp(log_weights(i));
+          num_copies += static_cast<double>(copies[i]);
+          ASSERT_LT(std::abs(num_copies - num_particles * cdf), 1.0 + 1e-9);
+        }
+      }
+      else
+      {
+        for (size_t k = 0; k < 4; ++k)
+        {
+          EXPECT_NEAR(static_cast<double>(counts[k]), num_particles * (k + 1.0) / 10.0, 300.0);
+        }
+      }
+      EXPECT_DOUBLE_EQ(pf.getEffectiveSampleSize(), static_cast<double>(num_particles));
+    }
+  }
+
+  TEST(ParticleFilterTest, TracksRandomWalkIndependentOfThreads)
+  {
+    // 2D position with noisy odometry and a noisy position fix every step
+    const auto run = [](const size_t num_threads)
+    {
+      ParticleFilter<double, 2> pf(30000, 1234, num_threads);
+      pf.initialize(
+          [](ParticleBlock<double, 2> &block)
+          {
+            std::uniform_real_distribution<double> uniform(-5.0, 5.0);
+            for (size_t i = 0; i < block.size; ++i)
+            {
+              block.state[0][i] = uniform(*block.rng);
+              block.state[1][i] = uniform(*block.rng);
+            }
+          });
+
+      double x = 1.0;
+      double y = -2.0;
+      std::mt19937 truth_rng(99);
+      std::normal_distribution<double> measurement_noise(0.0, 0.3);
+      for (size_t step = 0; step < 30; ++step)
+      {
+        x += 0.1;
+        y += 0.05;
+        pf.predict(
+            [](ParticleBlock<double, 2> &block)
+            {
+              std::normal_distribution<double> process_noise(0.0, 0.05);
+              for (size_t i = 0; i < block.size; ++i)
+              {
+                block.state[0][i] += 0.1 + process_noise(*block.rng);
+                block.state[1][i] += 0.05 + process_noise(*block.rng);
+              }
+            });
+
+        const double zx = x + measurement_noise(truth_rng);
+        const double zy = y + measurement_noise(truth_rng);
+        EXPECT_TRUE(pf.update(
+            [zx, zy](ParticleBlock<double, 2> &block)
+            {
+              const double *const px = block.state[0];
+              const double *const py = block.state[1];
+              for (size_t i = 0; i < block.size; ++i)
+              {
+                const double dx = px[i] - zx;
+                const double dy = py[i] - zy;
+                block.log_weights[i] += -(dx * dx + dy * dy) / (2.0 * 0.09);
+              }
+            }));
+        pf.resampleIfNeeded();
+      }
+
+      const auto mean = pf.getMean();
+      EXPECT_NEAR(mean(0, 0), x, 0.2);
+      EXPECT_NEAR(mean(1, 0), y, 0.2);
+      return mean;
+    };
+
+    const auto single = run(1);
+    const auto parallel = run(4);
+    EXPECT_EQ(single(0, 0), parallel(0, 0));
+    EXPECT_EQ(single(1, 0), parallel(1, 0));
+  }
+
+} // namespace lumos
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,175 @@
+#ifndef LUMOS_MATH_ESTIMATION_UNSCENTED_KALMAN_FILTER_H_
+#define LUMOS_MATH_ESTIMATION_UNSCENTED_KALMAN_FILTER_H_
+
+#include <cmath>
+#include <stdexcept>
+
+#include "lumos/math/estimation/class_def/unscented_kalman_filter.h"
+#include "lumos/math/estimation/kalman_common.h"
+
+namespace lumos
+{
+
+  template <typename T, uint16_t N>
+  UnscentedKalmanFilter<T, N>::UnscentedKalmanFilter()
+      : UnscentedKalmanFilter(zerosMatrix<T, N, 1>(), unitMatrix<T, N, N>()) {}
+
+  template <typename T, uint16_t N>
+  UnscentedKalmanFilter<T, N>::UnscentedKalmanFilter(const StateVector &x0,
+                                                     const StateMatrix &P0,
+                                                     T alpha, T beta, T kappa)
+      : x_(x0), P_(P0)
+  {
+    const T n = static_cast<T>(N);
+    const T lambda = alpha * alpha * (n + kappa) - n;
+    if (!(n + lambda > T(0)))
+    {
+      throw std::invalid_argument("Sigma point scaling requires N + lambda > 0");
+    }
+
+    spread_ = std::sqrt(n + lambda);
+    weights_mean_[0] = lambda / (n + lambda);
+    weights_covariance_[0] = weights_mean_[0] + T(1) - alpha * alpha + beta;
+    for (size_t i = 1; i < kNumSigmaPoints; ++i)
+    {
+      weights_mean_[i] = T(1) / (T(2) * (n + lambda));
+      weights_covariance_[i] = weights_mean_[i];
+    }
+  }
+
+  template <typename T, uint16_t N>
+  bool UnscentedKalmanFilter<T, N>::computeSigmaPoints(
+      std::array<StateVector, kNumSigmaPoints> &points) const
+  {
+    const StateMatrix l = P_.cholesky();
+    if (!internal::isCholeskyFactor(l))
+    {
+      return false;
+    }
+
+    points[0] = x_;
+    for (size_t j = 0; j < N; ++j)
+    {
+      for (size_t i = 0; i < N; ++i)
+      {
+        const T offset = spread_ * l(i, j);
+        points[1 + j](i, 0) = x_(i, 0) + offset;
+        points[1 + N + j](i, 0) = x_(i, 0) - offset;
+      }
+    }
+    return true;
+  }
+
+  template <typename T, uint16_t N>
+  template <typename ProcessModel>
+  bool UnscentedKalmanFilter<T, N>::predict(const ProcessModel &f, const StateMatrix &Q)
+  {
+    std::array<StateVector, kNumSigmaPoints> points;
+    if (!computeSigmaPoints(points))
+    {
+      return false;
+    }
+
+    StateVector mean = zerosMatrix<T, N, 1>();
+    for (size_t k = 0; k < kNumSigmaPoints; ++k)
+    {
+      points[k] = f(points[k]);
+      mean = mean + weights_mean_[k] * points[k];
+    }
+
+    StateMatrix covariance = Q;
+    for (size_t k = 0; k < kNumSigmaPoints; ++k)
+    {
+      const StateVector d = points[k] - mean;
+      covariance = covariance + weights_covariance_[k] * (d * d.transposed());
+    }
+    internal::symmetrize(covariance);
+
+    x_ = mean;
+    P_ = covariance;
+    return true;
+  }
+
+  template <typename T, uint16_t N>
+  template <uint16_t M, typename MeasurementModel>
+  bool UnscentedKalmanFilter<T, N>::update(const FixedSizeMatrix<T, M, 1> &z,
+                                           const MeasurementModel &h,
+                                           const FixedSizeMatrix<T, M, M> &R)
+  {
+    using MeasurementVector = FixedSizeMatrix<T, M, 1>;
+
+    std::array<StateVector, kNumSigmaPoints> points;
+    if (!computeSigmaPoints(points))
+    {
+      return false;
+    }
+
+    std::array<MeasurementVector, kNumSigmaPoints> measurements;
+    MeasurementVector predicted = zerosMatrix<T, M, 1>();
+    for (size_t k = 0; k < kNumSigmaPoints; ++k)
+    {
+      measurements[k] = h(points[k]);
+      predicted = predicted + weights_mean_[k] * measurements[k];
+    }
+
+    FixedSizeMatrix<T, M, M> innovation_covariance = R;
+    FixedSizeMatrix<T, N, M> cross_covariance = zerosMatrix<T, N, M>();
+    for (size_t k = 0; k < kNumSigmaPoints; ++k)
+    {
+      const MeasurementVector dz = measurements[k] - predicted;
+      const StateVector dx = points[k] - x_;
+      innovation_covariance =
+          innovation_covariance + weights_covariance_[k] * (dz * dz.transposed());
+      cross_covariance = cross_covariance + weights_covariance_[k] * (dx * dz.transposed());
+    }
+    internal::symmetrize(innovation_covariance);
+
+    FixedSizeMatrix<T, N, M> gain;
+    if (!internal::kalmanGain(cross_covariance, innovation_covariance, gain))
+    {
+      return false;
+    }
+
+    x_ = x_ + gain * (z - predicted);
+    P_ = P_ - gain * innovation_covariance * gain.transposed();
+    internal::symmetrize(P_);
+    return true;
+  }
+
+  template <typename T, uint16_t N>
+  const typename UnscentedKalmanFilter<T, N>::StateVector &
+  UnscentedKalmanFilter<T, N>::getState() const
+  {
+    return x_;
+  }
+
+  template <typename T, uint16_t N>
+  const typename UnscentedKalmanFilter<T, N>::StateMatrix &
+  UnscentedKalmanFilter<T, N>::getCovariance() const
+  {
+    return P_;
+  }
+
+  template <typename T, uint16_t N>
+  void UnscentedKalmanFilter<T, N>::setState(const StateVector &x) { x_ = x; }
+
+  template <typename T, uint16_t N>
+  void UnscentedKalmanFilter<T, N>::setCovariance(const StateMatrix &P) { P_ = P; }
+
+  template <typename T, uint16_t N>
+  const std::array<T, UnscentedKalmanFilter<T, N>::kNumSigmaPoints> &
+  UnscentedKalmanFilter<T, N>::getMeanWeights() const
+  {
+    return weights_mean_;
+  }
+
+  template <typename T, uint16_t N>
+  const std::array<T, UnscentedKalmanFilter<T, N>::kNumSigmaPoints> &
+  UnscentedKalmanFilter<T, N>::getCovarianceWeights() const
+  {
+    return weights_covariance_;
+  }
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_ESTIMATION_UNSCENTED_KALMAN_FILTER_H_
@@ -5,6 +5,8 @@
 #include <complex>
 #include <cstddef>
 
+#include "lumos/math/misc/forward_decl.h"
+
 #ifdef LUMOS_BUILD_FILE
 #define LUMOS_INLINE
 #else
@@ -16,6 +18,11 @@ using Complex = std::complex<double>;
 using ComplexVector = std::vector<Complex>;
 using RealVector = std::vector<double>;
 
+// Single precision counterparts
+using ComplexF = std::complex<float>;
+using ComplexVectorF = std::vector<ComplexF>;
+using RealVectorF = std::vector<float>;
+
 namespace fft {
 
 // =============================================================================
@@ -38,6 +45,75 @@ ComplexVector ifft(const ComplexVector& input);
 // Input should be conjugate symmetric
 RealVector ifft_real(const ComplexVector& input);
 
+// =============================================================================
+// FFT Plan
+// =============================================================================
+
+// Precomputed twiddle factors and bit-reversal permutation for one transform
+// size. Repeated transforms of that size then do no trigonometry and no
+// allocation, which is what streaming users such as Stft need. T is float or
+// double. Twiddles are computed in double precision and stored per stage, so
+// the butterflies of a stage read them contiguously, and the butterflies use
+// plain real arithmetic on the interleaved data, which the compiler vectorizes
+// (twice as many lanes for float)
+template <typename T>
+class BasicFFTPlan
+{
+public:
+    BasicFFTPlan();
+    // Size must be a power of 2
+    explicit BasicFFTPlan(size_t n);
+
+    size_t size() const;
+
+    // In-place transforms of size() elements, inverse is normalized like ifft
+    void forward(std::complex<T>* data) const;
+    void inverse(std::complex<T>* data) const;
+
+private:
+    size_t n_;
+    std::vector<size_t> bit_reversed_;
+    // exp(-2*pi*i*j/len) for j < len/2 of every stage len >= 8, stage len
+    // starting at index len/2 - 4
+    std::vector<T> twiddles_re_;
+    std::vector<T> twiddles_im_;
+
+    void transform(std::complex<T>* data, bool inverse) const;
+};
+
+using FFTPlan = BasicFFTPlan<double>;
+using FFTPlanF = BasicFFTPlan<float>;
+
+// =============================================================================
+// Generic-Type FFT Functions
+// =============================================================================
+
+// Transforms for any scalar type T supported by BasicFFTPlan. The double
+// versions above are used when the argument types match exactly
+
+// In-place transforms of n elements, n must be a power of 2
+template <typename T>
+void fft_inplace(std::complex<T>* data, size_t n);
+template <typename T>
+void ifft_inplace(std::complex<T>* data, size_t n);
+
+template <typename T>
+std::vector<std::complex<T>> fft(const std::vector<std::complex<T>>& input);
+template <typename T>
+std::vector<std::complex<T>> fft(const std::vector<T>& input);
+template <typename T>
+std::vector<std::complex<T>> fft(const lumos::Vector<std::complex<T>>& input);
+template <typename T>
+std::vector<std::complex<T>> fft(const lumos::Vector<T>& input);
+// n samples of complex or real input
+template <typename T>
+std::vector<std::complex<T>> fft(const std::complex<T>* input, size_t n);
+template <typename T>
+std::vector<std::complex<T>> fft(const T* input, size_t n);
+
+template <typename T>
+std::vector<std::complex<T>> ifft(const std::vector<std::complex<T>>& input);
+
 // =============================================================================
 // Utility Functions
 // =============================================================================
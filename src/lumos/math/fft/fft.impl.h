@@ -37,12 +37,95 @@ namespace fft
         return power;
     }
 
-    // Bit-reversal permutation for FFT
-    LUMOS_INLINE void bit_reverse_copy(ComplexVector &data)
+    // =============================================================================
+    // Core FFT Implementation
+    // =============================================================================
+
+    LUMOS_INLINE ComplexVector fft_internal(ComplexVector data, bool inverse = false)
     {
         const size_t n = data.size();
-        const size_t log_n = static_cast<size_t>(std::log2(n));
 
+        if (!is_power_of_2(n))
+        {
+            throw std::invalid_argument("FFT input size must be a power of 2");
+        }
+
+        const FFTPlan plan(n);
+        if (inverse)
+        {
+            plan.inverse(data.data());
+        }
+        else
+        {
+            plan.forward(data.data());
+        }
+
+        return data;
+    }
+
+    // =============================================================================
+    // Public FFT Functions
+    // =============================================================================
+
+    LUMOS_INLINE ComplexVector fft(const ComplexVector &input)
+    {
+        return fft_internal(input, false);
+    }
+
+    LUMOS_INLINE ComplexVector fft(const RealVector &input)
+    {
+        ComplexVector complex_input;
+        complex_input.reserve(input.size());
+
+        for (double val : input)
+        {
+            complex_input.emplace_back(val, 0.0);
+        }
+
+        return fft_internal(complex_input, false);
+    }
+
+    LUMOS_INLINE ComplexVector ifft(const ComplexVector &input)
+    {
+        return fft_internal(input, true);
+    }
+
+    LUMOS_INLINE RealVector ifft_real(const ComplexVector &input)
+    {
+        ComplexVector result = ifft(input);
+        RealVector real_result;
+        real_result.reserve(result.size());
+
+        for (const auto &c : result)
+        {
+            real_result.push_back(c.real());
+        }
+
+        return real_result;
+    }
+
+    // =============================================================================
+    // FFT Plan (iterative radix-2 Cooley-Tukey)
+    // =============================================================================
+
+    template <typename T>
+    BasicFFTPlan<T>::BasicFFTPlan() : n_(0) {}
+
+    template <typename T>
+    BasicFFTPlan<T>::BasicFFTPlan(size_t n) : n_(n)
+    {
+        if (!is_power_of_2(n))
+        {
+            throw std::invalid_argument("FFT plan size must be a power of 2");
+        }
+
+        size_t log_n = 0;
+        while ((size_t(1) << log_n) < n)
+        {
+            ++log_n;
+        }
+
+        bit_reversed_.resize(n);
         for (size_t i = 0; i < n; ++i)
         {
             size_t reversed = 0;
@@ -53,111 +136,207 @@ namespace fft
                 reversed = (reversed << 1) | (temp & 1);
                 temp >>= 1;
             }
+            bit_reversed_[i] = reversed;
+        }
 
-            if (i < reversed)
+        // The stages of length 2 and 4 only need the twiddles 1 and -i
+        for (size_t len = 8; len <= n; len <<= 1)
+        {
+            for (size_t j = 0; j < len / 2; ++j)
             {
-                std::swap(data[i], data[reversed]);
+                const double angle = -2.0 * M_PI * static_cast<double>(j) / static_cast<double>(len);
+                twiddles_re_.push_back(static_cast<T>(std::cos(angle)));
+                twiddles_im_.push_back(static_cast<T>(std::sin(angle)));
             }
         }
     }
 
-    // =============================================================================
-    // Core FFT Implementation (Cooley-Tukey Algorithm)
-    // =============================================================================
+    template <typename T>
+    size_t BasicFFTPlan<T>::size() const
+    {
+        return n_;
+    }
 
-    LUMOS_INLINE ComplexVector fft_internal(ComplexVector data, bool inverse = false)
+    template <typename T>
+    void BasicFFTPlan<T>::forward(std::complex<T> *data) const
     {
-        const size_t n = data.size();
+        transform(data, false);
+    }
 
-        if (!is_power_of_2(n))
+    template <typename T>
+    void BasicFFTPlan<T>::inverse(std::complex<T> *data) const
+    {
+        transform(data, true);
+    }
+
+    template <typename T>
+    void BasicFFTPlan<T>::transform(std::complex<T> *data, bool inverse) const
+    {
+        for (size_t i = 0; i < n_; ++i)
         {
-            throw std::invalid_argument("FFT input size must be a power of 2");
+            const size_t reversed = bit_reversed_[i];
+            if (i < reversed)
+            {
+                std::swap(data[i], data[reversed]);
+            }
         }
 
-        if (n <= 1)
+        // std::complex<T> is layout compatible with T[2], and working on the
+        // real and imaginary parts directly avoids the NaN handling of the
+        // complex product, which keeps the loops below vectorizable
+        T *const d = reinterpret_cast<T *>(data);
+        const T sign = inverse ? T(1) : T(-1);
+
+        if (n_ >= 2)
         {
-            return data;
+            for (size_t i = 0; i < 2 * n_; i += 4)
+            {
+                const T ar = d[i];
+                const T ai = d[i + 1];
+                const T br = d[i + 2];
+                const T bi = d[i + 3];
+
+                d[i] = ar + br;
+                d[i + 1] = ai + bi;
+                d[i + 2] = ar - br;
+                d[i + 3] = ai - bi;
+            }
         }
 
-        // Bit-reversal permutation
-        bit_reverse_copy(data);
-
-        // Cooley-Tukey FFT algorithm
-        const double sign = inverse ? 1.0 : -1.0;
+        if (n_ >= 4)
+        {
+            // Second butterfly of each group is multiplied by -i (forward) or i (inverse)
+            for (size_t i = 0; i < 2 * n_; i += 8)
+            {
+                const T ar0 = d[i];
+                const T ai0 = d[i + 1];
+                const T ar1 = d[i + 2];
+                const T ai1 = d[i + 3];
+                const T br0 = d[i + 4];
+                const T bi0 = d[i + 5];
+                const T vr1 = -sign * d[i + 7];
+                const T vi1 = sign * d[i + 6];
+
+                d[i] = ar0 + br0;
+                d[i + 1] = ai0 + bi0;
+                d[i + 4] = ar0 - br0;
+                d[i + 5] = ai0 - bi0;
+                d[i + 2] = ar1 + vr1;
+                d[i + 3] = ai1 + vi1;
+                d[i + 6] = ar1 - vr1;
+                d[i + 7] = ai1 - vi1;
+            }
+        }
 
-        for (size_t len = 2; len <= n; len <<= 1)
+        size_t twiddle_offset = 0;
+        for (size_t len = 8; len <= n_; len <<= 1)
         {
-            const double angle = sign * 2.0 * M_PI / len;
-            const Complex w_len(std::cos(angle), std::sin(angle));
+            const size_t half = len / 2;
+            const T *const w_re = twiddles_re_.data() + twiddle_offset;
+            const T *const w_im = twiddles_im_.data() + twiddle_offset;
 
-            for (size_t i = 0; i < n; i += len)
+            for (size_t i = 0; i < n_; i += len)
             {
-                Complex w(1.0, 0.0);
+                T *const a = d + 2 * i;
+                T *const b = d + 2 * (i + half);
 
-                for (size_t j = 0; j < len / 2; ++j)
+                for (size_t j = 0; j < half; ++j)
                 {
-                    const Complex u = data[i + j];
-                    const Complex v = data[i + j + len / 2] * w;
-
-                    data[i + j] = u + v;
-                    data[i + j + len / 2] = u - v;
-
-                    w *= w_len;
+                    const T wr = w_re[j];
+                    const T wi = -sign * w_im[j];
+                    const T br = b[2 * j];
+                    const T bi = b[2 * j + 1];
+                    const T vr = br * wr - bi * wi;
+                    const T vi = br * wi + bi * wr;
+                    const T ar = a[2 * j];
+                    const T ai = a[2 * j + 1];
+
+                    a[2 * j] = ar + vr;
+                    a[2 * j + 1] = ai + vi;
+                    b[2 * j] = ar - vr;
+                    b[2 * j + 1] = ai - vi;
                 }
             }
+
+            twiddle_offset += half;
         }
 
-        // Normalize for inverse FFT
         if (inverse)
         {
-            for (auto &x : data)
+            const T scale = T(1) / static_cast<T>(n_);
+            for (size_t i = 0; i < 2 * n_; ++i)
             {
-                x /= static_cast<double>(n);
+                d[i] *= scale;
             }
         }
-
-        return data;
     }
 
     // =============================================================================
-    // Public FFT Functions
+    // Generic-Type FFT Functions
     // =============================================================================
 
-    LUMOS_INLINE ComplexVector fft(const ComplexVector &input)
+    template <typename T>
+    void fft_inplace(std::complex<T> *data, size_t n)
     {
-        return fft_internal(input, false);
+        BasicFFTPlan<T>(n).forward(data);
     }
 
-    LUMOS_INLINE ComplexVector fft(const RealVector &input)
+    template <typename T>
+    void ifft_inplace(std::complex<T> *data, size_t n)
     {
-        ComplexVector complex_input;
-        complex_input.reserve(input.size());
+        BasicFFTPlan<T>(n).inverse(data);
+    }
 
-        for (double val : input)
+    template <typename T>
+    std::vector<std::complex<T>> fft(const std::complex<T> *input, size_t n)
+    {
+        std::vector<std::complex<T>> result(input, input + n);
+        fft_inplace(result.data(), n);
+        return result;
+    }
+
+    template <typename T>
+    std::vector<std::complex<T>> fft(const T *input, size_t n)
+    {
+        std::vector<std::complex<T>> result(n);
+        for (size_t i = 0; i < n; ++i)
         {
-            complex_input.emplace_back(val, 0.0);
+            result[i] = std::complex<T>(input[i], T(0));
         }
+        fft_inplace(result.data(), n);
+        return result;
+    }
 
-        return fft_internal(complex_input, false);
+    template <typename T>
+    std::vector<std::complex<T>> fft(const std::vector<std::complex<T>> &input)
+    {
+        return fft(input.data(), input.size());
     }
 
-    LUMOS_INLINE ComplexVector ifft(const ComplexVector &input)
+    template <typename T>
+    std::vector<std::complex<T>> fft(const std::vector<T> &input)
     {
-        return fft_internal(input, true);
+        return fft(input.data(), input.size());
     }
 
-    LUMOS_INLINE RealVector ifft_real(const ComplexVector &input)
+    template <typename T>
+    std::vector<std::complex<T>> fft(const lumos::Vector<std::complex<T>> &input)
     {
-        ComplexVector result = ifft(input);
-        RealVector real_result;
-        real_result.reserve(result.size());
+        return fft(static_cast<const std::complex<T> *>(input.data()), input.size());
+    }
 
-        for (const auto &c : result)
-        {
-            real_result.push_back(c.real());
-        }
+    template <typename T>
+    std::vector<std::complex<T>> fft(const lumos::Vector<T> &input)
+    {
+        return fft(static_cast<const T *>(input.data()), input.size());
+    }
 
-        return real_result;
+    template <typename T>
+    std::vector<std::complex<T>> ifft(const std::vector<std::complex<T>> &input)
+    {
+        std::vector<std::complex<T>> result(input);
+        ifft_inplace(result.data(), result.size());
+        return result;
     }
 
     // =============================================================================
@@ -0,0 +1,71 @@
+#ifndef FFT2D_H
+#define FFT2D_H
+
+#include <cstddef>
+#include <vector>
+
+#include "lumos/math/fft/fft.h"
+#include "lumos/math/image/image_gray.h"
+#include "lumos/math/lin_alg/matrix_dynamic/matrix_dynamic.h"
+
+namespace fft {
+
+// =============================================================================
+// Batched FFT
+// =============================================================================
+
+// In-place transforms of num_signals signals of length elements each, signal i
+// starting at data + i * stride. One plan is shared by all signals, and the
+// signals are split across threads. length must be a power of 2, and
+// num_threads == 0 uses all hardware threads
+void fft_batch(Complex* data, size_t num_signals, size_t length, size_t stride,
+               bool inverse = false, size_t num_threads = 0);
+
+// Transforms every row of a row-major matrix in place
+void fft_rows(lumos::Matrix<Complex>& m, bool inverse = false, size_t num_threads = 0);
+
+// dst (num_cols x num_rows) = transpose of src (num_rows x num_cols), copied
+// in square tiles that fit in L1 cache. src and dst must not overlap
+void transpose(const Complex* src, size_t num_rows, size_t num_cols, Complex* dst,
+               size_t num_threads = 0);
+
+// =============================================================================
+// 2D FFT
+// =============================================================================
+
+// In-place 2D transform of a row-major num_rows x num_cols array by row-column
+// decomposition: batched row transforms, a blocked transpose, batched
+// transforms of the former columns and a transpose back. Both dimensions must
+// be powers of 2, inverse is normalized like ifft
+void fft2d(Complex* data, size_t num_rows, size_t num_cols, bool inverse = false,
+           size_t num_threads = 0);
+
+lumos::Matrix<Complex> fft2d(const lumos::Matrix<Complex>& m, size_t num_threads = 0);
+
+template <typename T>
+lumos::Matrix<Complex> fft2d(const lumos::Matrix<T>& m, size_t num_threads = 0);
+
+template <typename T>
+lumos::Matrix<Complex> fft2d(const lumos::ImageGray<T>& image, size_t num_threads = 0);
+
+lumos::Matrix<Complex> ifft2d(const lumos::Matrix<Complex>& spectrum, size_t num_threads = 0);
+
+// Real part of the inverse, for spectra of real input
+lumos::Matrix<double> ifft2d_real(const lumos::Matrix<Complex>& spectrum, size_t num_threads = 0);
+
+// =============================================================================
+// 2D Convolution using FFT
+// =============================================================================
+
+// Filters an image with a kernel in the frequency domain. The output has the
+// size of the image, the kernel is centered at (kernel rows / 2, kernel cols / 2)
+// and the image is zero outside its borders. Any sizes are accepted, both are
+// zero-padded to powers of 2 internally. An empty image or kernel gives an
+// empty matrix
+lumos::Matrix<double> convolve2d_fft(const lumos::Matrix<double>& image,
+                                     const lumos::Matrix<double>& kernel,
+                                     size_t num_threads = 0);
+
+} // namespace fft
+
+#endif // FFT2D_H
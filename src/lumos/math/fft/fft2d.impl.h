@@ -0,0 +1,255 @@
+#ifndef FFT2D_IMPL_H
+#define FFT2D_IMPL_H
+
+#include "lumos/math/fft/fft2d.h"
+#include "lumos/math/fft/fft.impl.h"
+#include "lumos/math/misc/parallel_for.h"
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef LUMOS_BUILD_FILE
+#define LUMOS_INLINE
+#else
+#define LUMOS_INLINE inline
+#endif
+
+namespace fft
+{
+
+    // =============================================================================
+    // Batched FFT
+    // =============================================================================
+
+    // Smallest amount of work, in elements, worth handing to a thread
+    constexpr size_t kMinBatchElementsPerThread = 4096;
+
+    // Side of the square tiles of the blocked transpose, 32 x 32 complex doubles
+    // is 16 kB, so a source and a destination tile fit in L1 together
+    constexpr size_t kTransposeTileSize = 32;
+
+    LUMOS_INLINE void fft_batch(Complex *data, size_t num_signals, size_t length, size_t stride,
+                                bool inverse, size_t num_threads)
+    {
+        if (!is_power_of_2(length))
+        {
+            throw std::invalid_argument("FFT input size must be a power of 2");
+        }
+        if (stride < length && num_signals > 1)
+        {
+            throw std::invalid_argument("Batched FFT signals must not overlap");
+        }
+
+        const FFTPlan plan(length);
+        const size_t min_signals_per_thread = std::max<size_t>(1, kMinBatchElementsPerThread / length);
+
+        lumos::internal::parallelFor(
+            0, num_signals, min_signals_per_thread,
+            [&](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    if (inverse)
+                    {
+                        plan.inverse(data + i * stride);
+                    }
+                    else
+                    {
+                        plan.forward(data + i * stride);
+                    }
+                }
+            },
+            num_threads);
+    }
+
+    LUMOS_INLINE void fft_rows(lumos::Matrix<Complex> &m, bool inverse, size_t num_threads)
+    {
+        fft_batch(m.data(), m.numRows(), m.numCols(), m.numCols(), inverse, num_threads);
+    }
+
+    LUMOS_INLINE void transpose(const Complex *src, size_t num_rows, size_t num_cols, Complex *dst,
+                                size_t num_threads)
+    {
+        const size_t num_tile_rows = (num_rows + kTransposeTileSize - 1) / kTransposeTileSize;
+        const size_t min_tile_rows_per_thread =
+            std::max<size_t>(1, kMinBatchElementsPerThread / (kTransposeTileSize * std::max<size_t>(num_cols, 1)));
+
+        lumos::internal::parallelFor(
+            0, num_tile_rows, min_tile_rows_per_thread,
+            [&](size_t begin, size_t end)
+            {
+                for (size_t tile_row = begin; tile_row < end; ++tile_row)
+                {
+                    const size_t r0 = tile_row * kTransposeTileSize;
+                    const size_t r1 = std::min(r0 + kTransposeTileSize, num_rows);
+
+                    for (size_t c0 = 0; c0 < num_cols; c0 += kTransposeTileSize)
+                    {
+                        const size_t c1 = std::min(c0 + kTransposeTileSize, num_cols);
+
+                        for (size_t r = r0; r < r1; ++r)
+                        {
+                            for (size_t c = c0; c < c1; ++c)
+                            {
+                                dst[c * num_rows + r] = src[r * num_cols + c];
+                            }
+                        }
+                    }
+                }
+            },
+            num_threads);
+    }
+
+    // =============================================================================
+    // 2D FFT
+    // =============================================================================
+
+    LUMOS_INLINE void fft2d(Complex *data, size_t num_rows, size_t num_cols, bool inverse, size_t num_threads)
+    {
+        if (!is_power_of_2(num_rows) || !is_power_of_2(num_cols))
+        {
+            throw std::invalid_argument("2D FFT dimensions must be powers of 2");
+        }
+
+        fft_batch(data, num_rows, num_cols, num_cols, inverse, num_threads);
+
+        if (num_rows == 1)
+        {
+            return;
+        }
+
+        // The columns are transformed as rows of the transpose, so every
+        // transform runs over contiguous memory
+        ComplexVector transposed(num_rows * num_cols);
+        transpose(data, num_rows, num_cols, transposed.data(), num_threads);
+        fft_batch(transposed.data(), num_cols, num_rows, num_rows, inverse, num_threads);
+        transpose(transposed.data(), num_cols, num_rows, data, num_threads);
+    }
+
+    LUMOS_INLINE lumos::Matrix<Complex> fft2d(const lumos::Matrix<Complex> &m, size_t num_threads)
+    {
+        lumos::Matrix<Complex> result(m);
+        fft2d(result.data(), result.numRows(), result.numCols(), false, num_threads);
+        return result;
+    }
+
+    // Copies a real row-major array into a complex matrix and transforms it
+    template <typename T>
+    lumos::Matrix<Complex> fft2d_real_input(const T *data, size_t num_rows, size_t num_cols, size_t num_threads)
+    {
+        if (!is_power_of_2(num_rows) || !is_power_of_2(num_cols))
+        {
+            throw std::invalid_argument("2D FFT dimensions must be powers of 2");
+        }
+
+        lumos::Matrix<Complex> result(num_rows, num_cols);
+        for (size_t i = 0; i < num_rows * num_cols; ++i)
+        {
+            result.data()[i] = Complex(static_cast<double>(data[i]), 0.0);
+        }
+        fft2d(result.data(), num_rows, num_cols, false, num_threads);
+
+        return result;
+    }
+
+    template <typename T>
+    lumos::Matrix<Complex> fft2d(const lumos::Matrix<T> &m, size_t num_threads)
+    {
+        return fft2d_real_input(m.data(), m.numRows(), m.numCols(), num_threads);
+    }
+
+    template <typename T>
+    lumos::Matrix<Complex> fft2d(const lumos::ImageGray<T> &image, size_t num_threads)
+    {
+        return fft2d_real_input(image.data(), image.numRows(), image.numCols(), num_threads);
+    }
+
+    LUMOS_INLINE lumos::Matrix<Complex> ifft2d(const lumos::Matrix<Complex> &spectrum, size_t num_threads)
+    {
+        lumos::Matrix<Complex> result(spectrum);
+        fft2d(result.data(), result.numRows(), result.numCols(), true, num_threads);
+        return result;
+    }
+
+    LUMOS_INLINE lumos::Matrix<double> ifft2d_real(const lumos::Matrix<Complex> &spectrum, size_t num_threads)
+    {
+        const lumos::Matrix<Complex> inverse = ifft2d(spectrum, num_threads);
+        lumos::Matrix<double> result(inverse.numRows(), inverse.numCols());
+
+        for (size_t i = 0; i < inverse.numElements(); ++i)
+        {
+            result.data()[i] = inverse.data()[i].real();
+        }
+
+        return result;
+    }
+
+    // =============================================================================
+    // 2D Convolution using FFT
+    // =============================================================================
+
+    LUMOS_INLINE lumos::Matrix<double> convolve2d_fft(const lumos::Matrix<double> &image,
+                                                      const lumos::Matrix<double> &kernel,
+                                                      size_t num_threads)
+    {
+        if ((image.numElements() == 0) || (kernel.numElements() == 0))
+        {
+            return lumos::Matrix<double>();
+        }
+
+        const size_t num_rows = next_power_of_2(image.numRows() + kernel.numRows() - 1);
+        const size_t num_cols = next_power_of_2(image.numCols() + kernel.numCols() - 1);
+
+        // Image and kernel go through one complex transform, as real and
+        // imaginary part
+        ComplexVector work(num_rows * num_cols, Complex(0.0, 0.0));
+        for (size_t r = 0; r < image.numRows(); ++r)
+        {
+            for (size_t c = 0; c < image.numCols(); ++c)
+            {
+                work[r * num_cols + c].real(image(r, c));
+            }
+        }
+        for (size_t r = 0; r < kernel.numRows(); ++r)
+        {
+            for (size_t c = 0; c < kernel.numCols(); ++c)
+            {
+                work[r * num_cols + c].imag(kernel(r, c));
+            }
+        }
+        fft2d(work.data(), num_rows, num_cols, false, num_threads);
+
+        // Separate the two spectra with conj(Z[-k]) and multiply them
+        ComplexVector product(num_rows * num_cols);
+        for (size_t r = 0; r < num_rows; ++r)
+        {
+            const size_t r_neg = (num_rows - r) & (num_rows - 1);
+            for (size_t c = 0; c < num_cols; ++c)
+            {
+                const size_t c_neg = (num_cols - c) & (num_cols - 1);
+                const Complex z = work[r * num_cols + c];
+                const Complex z_conj = std::conj(work[r_neg * num_cols + c_neg]);
+
+                const Complex image_k = 0.5 * (z + z_conj);
+                const Complex kernel_k = Complex(0.0, -0.5) * (z - z_conj);
+                product[r * num_cols + c] = image_k * kernel_k;
+            }
+        }
+        fft2d(product.data(), num_rows, num_cols, true, num_threads);
+
+        const size_t row_offset = kernel.numRows() / 2;
+        const size_t col_offset = kernel.numCols() / 2;
+        lumos::Matrix<double> result(image.numRows(), image.numCols());
+        for (size_t r = 0; r < image.numRows(); ++r)
+        {
+            for (size_t c = 0; c < image.numCols(); ++c)
+            {
+                result(r, c) = product[(r + row_offset) * num_cols + c + col_offset].real();
+            }
+        }
+
+        return result;
+    }
+
+} // namespace fft
+
+#endif // FFT2D_IMPL_H
@@ -0,0 +1,93 @@
+#ifndef SPECTRAL_H
+#define SPECTRAL_H
+
+#include <cstddef>
+#include <vector>
+
+#include "lumos/math/fft/fft.h"
+#include "lumos/math/fft/stft.h"
+
+namespace fft {
+
+// =============================================================================
+// Welch spectral estimation
+// =============================================================================
+
+struct WelchConfig
+{
+    size_t segment_size = 256; // Must be a power of 2
+    size_t overlap = 128;      // Samples shared by two consecutive segments, less than segment_size
+    WindowType window = WindowType::Hann;
+    double kaiser_beta = 8.6;
+    double sample_rate = 1.0;
+    bool remove_mean = true;   // Subtract the mean of every segment before windowing
+    size_t num_threads = 0;    // Segments are processed in parallel, 0 uses all hardware threads
+};
+
+// One-sided power spectral density by Welch's method, averaging the modified
+// periodograms of overlapping windowed segments. Returns segment_size / 2 + 1
+// values in units of signal^2 / Hz, see welch_frequencies for the bins.
+// The signal must hold at least one segment
+RealVector welch_psd(const RealVector& signal, const WelchConfig& config);
+
+// One-sided cross power spectral density Pxy = E[conj(X) * Y]
+ComplexVector csd(const RealVector& x, const RealVector& y, const WelchConfig& config);
+
+// Magnitude squared coherence |Pxy|^2 / (Pxx * Pyy), in [0, 1]
+RealVector coherence(const RealVector& x, const RealVector& y, const WelchConfig& config);
+
+// Frequencies of the bins returned by the functions above
+RealVector welch_frequencies(const WelchConfig& config);
+
+// Welch estimator for many signals with the same config. The window, the FFT
+// plan and the work buffers are set up once and reused by every call, the free
+// functions above set up a new one per call. Segments are summed in chunks of
+// a fixed size, so the result does not depend on the number of threads.
+class Welch
+{
+public:
+    explicit Welch(const WelchConfig& config);
+
+    RealVector psd(const RealVector& signal);
+    ComplexVector csd(const RealVector& x, const RealVector& y);
+    RealVector coherence(const RealVector& x, const RealVector& y);
+
+    const WelchConfig& config() const;
+    size_t num_bins() const;
+
+private:
+    // Unscaled sums of |X|^2, |Y|^2 and conj(X) * Y
+    struct Sums
+    {
+        RealVector xx;
+        RealVector yy;
+        ComplexVector xy;
+    };
+
+    WelchConfig config_;
+    RealVector window_;
+    double window_power_;
+    FFTPlan plan_;
+    size_t num_threads_;
+
+    std::vector<ComplexVector> work_;  // FFT buffer of every thread
+    std::vector<Sums> partial_sums_;   // Sums of every chunk of segments
+    Sums sums_;
+
+    void computeSums(const RealVector& x, const RealVector* y);
+};
+
+// =============================================================================
+// Correlation using FFT
+// =============================================================================
+
+// Full cross-correlation c[k] = sum_n x[n + k] * y[n] for lags
+// k = -(y.size() - 1) ... x.size() - 1, lag k is at index k + y.size() - 1
+RealVector correlate_fft(const RealVector& x, const RealVector& y);
+
+// Autocorrelation for the non-negative lags 0 ... signal.size() - 1
+RealVector autocorrelate_fft(const RealVector& signal);
+
+} // namespace fft
+
+#endif // SPECTRAL_H
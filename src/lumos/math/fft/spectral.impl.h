@@ -0,0 +1,336 @@
+#ifndef SPECTRAL_IMPL_H
+#define SPECTRAL_IMPL_H
+
+#include "lumos/math/fft/spectral.h"
+#include "lumos/math/fft/fft.impl.h"
+#include "lumos/math/fft/stft.impl.h"
+#include "lumos/math/misc/parallel_for.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#ifdef LUMOS_BUILD_FILE
+#define LUMOS_INLINE
+#else
+#define LUMOS_INLINE inline
+#endif
+
+namespace fft
+{
+
+    // =============================================================================
+    // Welch spectral estimation
+    // =============================================================================
+
+    // Segments summed by one chunk. The chunks do not depend on the number of
+    // threads, so neither does the order of the additions
+    constexpr size_t kWelchSegmentsPerChunk = 16;
+
+    // Spectra of two real signals from one complex FFT of x + i * y, using
+    // X[k] = (Z[k] + conj(Z[n - k])) / 2 and Y[k] = (Z[k] - conj(Z[n - k])) / 2i
+    LUMOS_INLINE void split_real_spectra(const ComplexVector &z, size_t k, Complex &x, Complex &y)
+    {
+        const size_t n = z.size();
+        const Complex z_k = z[k];
+        const Complex z_conj = std::conj(z[(n - k) & (n - 1)]);
+
+        x = 0.5 * (z_k + z_conj);
+        y = Complex(0.0, -0.5) * (z_k - z_conj);
+    }
+
+    LUMOS_INLINE Welch::Welch(const WelchConfig &config)
+        : config_(config),
+          window_(make_window(config.window, config.segment_size, true, config.kaiser_beta)),
+          window_power_(0.0),
+          plan_(config.segment_size),
+          num_threads_(config.num_threads == 0 ? lumos::internal::defaultNumThreads() : config.num_threads),
+          work_(num_threads_, ComplexVector(config.segment_size))
+    {
+        if (config.overlap >= config.segment_size)
+        {
+            throw std::invalid_argument("Welch overlap must be smaller than the segment size");
+        }
+
+        for (double w : window_)
+        {
+            window_power_ += w * w;
+        }
+    }
+
+    LUMOS_INLINE void Welch::computeSums(const RealVector &x, const RealVector *y)
+    {
+        const size_t n = config_.segment_size;
+
+        if ((y != nullptr) && (y->size() != x.size()))
+        {
+            throw std::invalid_argument("Welch signals must have the same length");
+        }
+        if (x.size() < n)
+        {
+            throw std::invalid_argument("Signal is shorter than one Welch segment");
+        }
+
+        const size_t step = n - config_.overlap;
+        const size_t num_segments = (x.size() - n) / step + 1;
+        const size_t num_bins = n / 2 + 1;
+        const size_t num_cross_bins = y != nullptr ? num_bins : 0;
+        const size_t num_chunks = (num_segments + kWelchSegmentsPerChunk - 1) / kWelchSegmentsPerChunk;
+
+        if (partial_sums_.size() < num_chunks)
+        {
+            partial_sums_.resize(num_chunks);
+        }
+        for (size_t c = 0; c < num_chunks; ++c)
+        {
+            partial_sums_[c].xx.assign(num_bins, 0.0);
+            partial_sums_[c].yy.assign(num_cross_bins, 0.0);
+            partial_sums_[c].xy.assign(num_cross_bins, Complex(0.0, 0.0));
+        }
+
+        // Every thread takes a contiguous range of chunks and uses its own buffer
+        const size_t num_workers = std::min(num_chunks, num_threads_);
+
+        lumos::internal::parallelFor(
+            0, num_workers, 1,
+            [&](size_t worker_begin, size_t worker_end)
+            {
+                for (size_t t = worker_begin; t < worker_end; ++t)
+                {
+                    ComplexVector &work = work_[t];
+
+                    for (size_t c = t * num_chunks / num_workers; c < (t + 1) * num_chunks / num_workers; ++c)
+                    {
+                        Sums &sums = partial_sums_[c];
+                        const size_t segment_end = std::min(num_segments, (c + 1) * kWelchSegmentsPerChunk);
+
+                        for (size_t s = c * kWelchSegmentsPerChunk; s < segment_end; ++s)
+                        {
+                            const double *const x_segment = x.data() + s * step;
+                            const double *const y_segment = y != nullptr ? y->data() + s * step : nullptr;
+
+                            double x_mean = 0.0;
+                            double y_mean = 0.0;
+                            if (config_.remove_mean)
+                            {
+                                for (size_t i = 0; i < n; ++i)
+                                {
+                                    x_mean += x_segment[i];
+                                    y_mean += y_segment != nullptr ? y_segment[i] : 0.0;
+                                }
+                                x_mean /= static_cast<double>(n);
+                                y_mean /= static_cast<double>(n);
+                            }
+
+                            for (size_t i = 0; i < n; ++i)
+                            {
+                                const double y_value = y_segment != nullptr ? y_segment[i] - y_mean : 0.0;
+                                work[i] = Complex((x_segment[i] - x_mean) * window_[i], y_value * window_[i]);
+                            }
+
+                            plan_.forward(work.data());
+
+                            if (y == nullptr)
+                            {
+                                for (size_t k = 0; k < num_bins; ++k)
+                                {
+                                    sums.xx[k] += std::norm(work[k]);
+                                }
+                            }
+                            else
+                            {
+                                for (size_t k = 0; k < num_bins; ++k)
+                                {
+                                    Complex x_k;
+                                    Complex y_k;
+                                    split_real_spectra(work, k, x_k, y_k);
+
+                                    sums.xx[k] += std::norm(x_k);
+                                    sums.yy[k] += std::norm(y_k);
+                                    sums.xy[k] += std::conj(x_k) * y_k;
+                                }
+                            }
+                        }
+                    }
+                }
+            },
+            num_workers);
+
+        sums_.xx.assign(num_bins, 0.0);
+        sums_.yy.assign(num_cross_bins, 0.0);
+        sums_.xy.assign(num_cross_bins, Complex(0.0, 0.0));
+        for (size_t c = 0; c < num_chunks; ++c)
+        {
+            const Sums &partial = partial_sums_[c];
+            for (size_t k = 0; k < num_bins; ++k)
+            {
+                sums_.xx[k] += partial.xx[k];
+                if (y != nullptr)
+                {
+                    sums_.yy[k] += partial.yy[k];
+                    sums_.xy[k] += partial.xy[k];
+                }
+            }
+        }
+
+        // Density scaling, and doubling of the bins that also stand for the
+        // negative frequencies
+        const double scale = 1.0 / (config_.sample_rate * window_power_ * static_cast<double>(num_segments));
+
+        for (size_t k = 0; k < num_bins; ++k)
+        {
+            const double bin_scale = ((k == 0) || (2 * k == n)) ? scale : 2.0 * scale;
+            sums_.xx[k] *= bin_scale;
+            if (y != nullptr)
+            {
+                sums_.yy[k] *= bin_scale;
+                sums_.xy[k] *= bin_scale;
+            }
+        }
+    }
+
+    LUMOS_INLINE RealVector Welch::psd(const RealVector &signal)
+    {
+        computeSums(signal, nullptr);
+        return sums_.xx;
+    }
+
+    LUMOS_INLINE ComplexVector Welch::csd(const RealVector &x, const RealVector &y)
+    {
+        computeSums(x, &y);
+        return sums_.xy;
+    }
+
+    LUMOS_INLINE RealVector Welch::coherence(const RealVector &x, const RealVector &y)
+    {
+        computeSums(x, &y);
+        RealVector result(sums_.xx.size(), 0.0);
+
+        for (size_t k = 0; k < result.size(); ++k)
+        {
+            const double denominator = sums_.xx[k] * sums_.yy[k];
+            result[k] = denominator > 0.0 ? std::norm(sums_.xy[k]) / denominator : 0.0;
+        }
+
+        return result;
+    }
+
+    LUMOS_INLINE const WelchConfig &Welch::config() const
+    {
+        return config_;
+    }
+
+    LUMOS_INLINE size_t Welch::num_bins() const
+    {
+        return config_.segment_size / 2 + 1;
+    }
+
+    LUMOS_INLINE RealVector welch_psd(const RealVector &signal, const WelchConfig &config)
+    {
+        return Welch(config).psd(signal);
+    }
+
+    LUMOS_INLINE ComplexVector csd(const RealVector &x, const RealVector &y, const WelchConfig &config)
+    {
+        return Welch(config).csd(x, y);
+    }
+
+    LUMOS_INLINE RealVector coherence(const RealVector &x, const RealVector &y, const WelchConfig &config)
+    {
+        return Welch(config).coherence(x, y);
+    }
+
+    LUMOS_INLINE RealVector welch_frequencies(const WelchConfig &config)
+    {
+        RealVector frequencies(config.segment_size / 2 + 1);
+        const double resolution = config.sample_rate / static_cast<double>(config.segment_size);
+
+        for (size_t k = 0; k < frequencies.size(); ++k)
+        {
+            frequencies[k] = static_cast<double>(k) * resolution;
+        }
+
+        return frequencies;
+    }
+
+    // =============================================================================
+    // Correlation using FFT
+    // =============================================================================
+
+    LUMOS_INLINE RealVector correlate_fft(const RealVector &x, const RealVector &y)
+    {
+        if (x.empty() || y.empty())
+        {
+            return RealVector();
+        }
+
+        const size_t result_size = x.size() + y.size() - 1;
+        const size_t n = next_power_of_2(result_size);
+        const FFTPlan plan(n);
+
+        // Both signals go through one complex FFT
+        ComplexVector work(n, Complex(0.0, 0.0));
+        for (size_t i = 0; i < x.size(); ++i)
+        {
+            work[i].real(x[i]);
+        }
+        for (size_t i = 0; i < y.size(); ++i)
+        {
+            work[i].imag(y[i]);
+        }
+        plan.forward(work.data());
+
+        ComplexVector product(n);
+        for (size_t k = 0; k < n; ++k)
+        {
+            Complex x_k;
+            Complex y_k;
+            split_real_spectra(work, k, x_k, y_k);
+            product[k] = x_k * std::conj(y_k);
+        }
+        plan.inverse(product.data());
+
+        // Negative lags wrap around to the end of the circular correlation
+        RealVector result(result_size);
+        for (size_t i = 0; i < result_size; ++i)
+        {
+            result[i] = product[(i + n - (y.size() - 1)) & (n - 1)].real();
+        }
+
+        return result;
+    }
+
+    LUMOS_INLINE RealVector autocorrelate_fft(const RealVector &signal)
+    {
+        if (signal.empty())
+        {
+            return RealVector();
+        }
+
+        const size_t n = next_power_of_2(2 * signal.size() - 1);
+        const FFTPlan plan(n);
+
+        ComplexVector work(n, Complex(0.0, 0.0));
+        for (size_t i = 0; i < signal.size(); ++i)
+        {
+            work[i].real(signal[i]);
+        }
+        plan.forward(work.data());
+
+        for (Complex &c : work)
+        {
+            c = Complex(std::norm(c), 0.0);
+        }
+        plan.inverse(work.data());
+
+        RealVector result(signal.size());
+        for (size_t i = 0; i < result.size(); ++i)
+        {
+            result[i] = work[i].real();
+        }
+
+        return result;
+    }
+
+} // namespace fft
+
+#endif // SPECTRAL_IMPL_H
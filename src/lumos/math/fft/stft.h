@@ -0,0 +1,142 @@
+#ifndef STFT_H
+#define STFT_H
+
+#include <cstddef>
+#include <vector>
+
+#include "lumos/math/fft/fft.h"
+
+namespace fft {
+
+// =============================================================================
+// Windows
+// =============================================================================
+
+enum class WindowType
+{
+    Rectangular,
+    Hann,
+    Hamming,
+    Blackman,
+    Kaiser
+};
+
+// Window of the given length. Periodic windows (the default) are the ones to use
+// for spectral analysis with overlapping frames, symmetric ones for filter design.
+// kaiser_beta is only used by the Kaiser window
+RealVector make_window(WindowType type, size_t length, bool periodic = true, double kaiser_beta = 8.6);
+
+// =============================================================================
+// Short-time Fourier transform
+// =============================================================================
+
+struct StftConfig
+{
+    size_t frame_size = 1024; // Window and FFT length, must be a power of 2
+    size_t hop_size = 256;    // Samples between the start of two frames
+    WindowType window = WindowType::Hann;
+    double kaiser_beta = 8.6;
+};
+
+// Streaming STFT. Samples are pushed in chunks of any size, and every time a
+// frame is complete its one-sided spectrum (frame_size / 2 + 1 bins) is handed
+// to a callback. The window, the FFT plan and all buffers are set up once in the
+// constructor, so processing does not allocate. Frame k starts at sample
+// k * hop_size of the stream.
+class Stft
+{
+public:
+    explicit Stft(const StftConfig& config);
+
+    // Calls on_frame(const ComplexVector& spectrum) for every completed frame.
+    // The spectrum is only valid during the call. Returns the number of frames
+    template <typename F>
+    size_t process(const double* samples, size_t num_samples, F&& on_frame);
+    template <typename F>
+    size_t process(const RealVector& samples, F&& on_frame);
+
+    // Forgets buffered samples, the next sample starts a new stream
+    void reset();
+
+    const StftConfig& config() const;
+    const RealVector& window() const;
+    size_t num_bins() const;
+
+private:
+    StftConfig config_;
+    RealVector window_;
+    FFTPlan plan_;
+
+    RealVector buffer_;       // Samples of the frame being filled
+    size_t num_buffered_;
+    size_t num_to_skip_;      // Samples to drop before the next frame, when hop_size > frame_size
+    ComplexVector work_;      // FFT input and output
+    ComplexVector spectrum_;  // One-sided spectrum handed to the callback
+
+    void computeFrame();
+};
+
+// Inverse STFT by weighted overlap-add. Given the spectra of an Stft with the
+// same config, it reproduces the original stream. Every frame yields hop_size
+// output samples, which are aligned with the input stream of the Stft. The first
+// frame_size - hop_size output samples are only partially reconstructed, as
+// fewer frames overlap there.
+class Istft
+{
+public:
+    // hop_size must not be larger than frame_size
+    explicit Istft(const StftConfig& config);
+
+    // spectrum holds frame_size / 2 + 1 bins. Calls
+    // on_samples(const double* samples, size_t num_samples) with hop_size samples
+    template <typename F>
+    void process(const ComplexVector& spectrum, F&& on_samples);
+    // Appends the hop_size new samples to output
+    void process(const ComplexVector& spectrum, RealVector& output);
+
+    void reset();
+
+    const StftConfig& config() const;
+
+private:
+    StftConfig config_;
+    RealVector window_;
+    FFTPlan plan_;
+
+    RealVector overlap_;        // Overlap-add accumulator, frame_size samples
+    RealVector normalization_;  // 1 / sum of squared windows, periodic in hop_size
+    ComplexVector work_;
+};
+
+// Runs several channels through independent Stft instances, one channel per
+// thread. on_frame(channel, spectrum) is called concurrently for different
+// channels, but in order within one channel.
+class MultiChannelStft
+{
+public:
+    // num_threads == 0 uses all hardware threads
+    MultiChannelStft(size_t num_channels, const StftConfig& config, size_t num_threads = 0);
+
+    // channels[c] holds the new samples of channel c, chunks may differ in size
+    template <typename F>
+    void process(const std::vector<RealVector>& channels, F&& on_frame);
+
+    void reset();
+
+    size_t num_channels() const;
+    Stft& channel(size_t index);
+
+private:
+    std::vector<Stft> channels_;
+    size_t num_threads_;
+};
+
+// Spectrogram of a complete signal, one vector of frame_size / 2 + 1 bins per frame
+std::vector<ComplexVector> stft(const RealVector& signal, const StftConfig& config);
+
+// Inverse of stft(), returns frames.size() * hop_size samples
+RealVector istft(const std::vector<ComplexVector>& frames, const StftConfig& config);
+
+} // namespace fft
+
+#endif // STFT_H
@@ -0,0 +1,347 @@
+#ifndef STFT_IMPL_H
+#define STFT_IMPL_H
+
+#include "lumos/math/fft/stft.h"
+#include "lumos/math/fft/fft.impl.h"
+#include "lumos/math/misc/parallel_for.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#ifdef LUMOS_BUILD_FILE
+#define LUMOS_INLINE
+#else
+#define LUMOS_INLINE inline
+#endif
+
+namespace fft
+{
+
+    // =============================================================================
+    // Windows
+    // =============================================================================
+
+    // Zeroth order modified Bessel function of the first kind, power series
+    LUMOS_INLINE double bessel_i0(double x)
+    {
+        const double half_x = x / 2.0;
+        double term = 1.0;
+        double sum = 1.0;
+
+        for (size_t k = 1; term > 1e-17 * sum; ++k)
+        {
+            const double factor = half_x / static_cast<double>(k);
+            term *= factor * factor;
+            sum += term;
+        }
+
+        return sum;
+    }
+
+    LUMOS_INLINE RealVector make_window(WindowType type, size_t length, bool periodic, double kaiser_beta)
+    {
+        RealVector window(length, 1.0);
+        if (length <= 1)
+        {
+            return window;
+        }
+
+        const double denominator = static_cast<double>(periodic ? length : length - 1);
+        const double i0_beta = bessel_i0(kaiser_beta);
+
+        for (size_t n = 0; n < length; ++n)
+        {
+            const double phase = 2.0 * M_PI * static_cast<double>(n) / denominator;
+
+            switch (type)
+            {
+            case WindowType::Rectangular:
+                break;
+            case WindowType::Hann:
+                window[n] = 0.5 - 0.5 * std::cos(phase);
+                break;
+            case WindowType::Hamming:
+                window[n] = 0.54 - 0.46 * std::cos(phase);
+                break;
+            case WindowType::Blackman:
+                window[n] = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+                break;
+            case WindowType::Kaiser:
+            {
+                const double r = 2.0 * static_cast<double>(n) / denominator - 1.0;
+                window[n] = bessel_i0(kaiser_beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / i0_beta;
+                break;
+            }
+            }
+        }
+
+        return window;
+    }
+
+    // =============================================================================
+    // Stft
+    // =============================================================================
+
+    LUMOS_INLINE Stft::Stft(const StftConfig &config)
+        : config_(config),
+          window_(make_window(config.window, config.frame_size, true, config.kaiser_beta)),
+          plan_(config.frame_size),
+          buffer_(config.frame_size, 0.0),
+          num_buffered_(0),
+          num_to_skip_(0),
+          work_(config.frame_size),
+          spectrum_(config.frame_size / 2 + 1)
+    {
+        if (config.hop_size == 0)
+        {
+            throw std::invalid_argument("STFT hop size must be larger than 0");
+        }
+    }
+
+    LUMOS_INLINE void Stft::computeFrame()
+    {
+        for (size_t i = 0; i < config_.frame_size; ++i)
+        {
+            work_[i] = Complex(buffer_[i] * window_[i], 0.0);
+        }
+
+        plan_.forward(work_.data());
+        std::copy(work_.begin(), work_.begin() + spectrum_.size(), spectrum_.begin());
+    }
+
+    template <typename F>
+    size_t Stft::process(const double *samples, size_t num_samples, F &&on_frame)
+    {
+        const size_t frame_size = config_.frame_size;
+        const size_t hop_size = config_.hop_size;
+        size_t num_frames = 0;
+        size_t i = 0;
+
+        while (i < num_samples)
+        {
+            if (num_to_skip_ > 0)
+            {
+                const size_t n = std::min(num_to_skip_, num_samples - i);
+                num_to_skip_ -= n;
+                i += n;
+                continue;
+            }
+
+            const size_t n = std::min(frame_size - num_buffered_, num_samples - i);
+            std::copy(samples + i, samples + i + n, buffer_.begin() + num_buffered_);
+            num_buffered_ += n;
+            i += n;
+
+            if (num_buffered_ == frame_size)
+            {
+                computeFrame();
+                on_frame(static_cast<const ComplexVector &>(spectrum_));
+                ++num_frames;
+
+                if (hop_size < frame_size)
+                {
+                    std::copy(buffer_.begin() + hop_size, buffer_.end(), buffer_.begin());
+                    num_buffered_ = frame_size - hop_size;
+                }
+                else
+                {
+                    num_buffered_ = 0;
+                    num_to_skip_ = hop_size - frame_size;
+                }
+            }
+        }
+
+        return num_frames;
+    }
+
+    template <typename F>
+    size_t Stft::process(const RealVector &samples, F &&on_frame)
+    {
+        return process(samples.data(), samples.size(), std::forward<F>(on_frame));
+    }
+
+    LUMOS_INLINE void Stft::reset()
+    {
+        num_buffered_ = 0;
+        num_to_skip_ = 0;
+    }
+
+    LUMOS_INLINE const StftConfig &Stft::config() const
+    {
+        return config_;
+    }
+
+    LUMOS_INLINE const RealVector &Stft::window() const
+    {
+        return window_;
+    }
+
+    LUMOS_INLINE size_t Stft::num_bins() const
+    {
+        return spectrum_.size();
+    }
+
+    // =============================================================================
+    // Istft
+    // =============================================================================
+
+    LUMOS_INLINE Istft::Istft(const StftConfig &config)
+        : config_(config),
+          window_(make_window(config.window, config.frame_size, true, config.kaiser_beta)),
+          plan_(config.frame_size),
+          overlap_(config.frame_size, 0.0),
+          normalization_(config.hop_size, 0.0),
+          work_(config.frame_size)
+    {
+        if ((config.hop_size == 0) || (config.hop_size > config.frame_size))
+        {
+            throw std::invalid_argument("ISTFT hop size must be in [1, frame_size]");
+        }
+
+        // Output sample i of a hop is the sum of the frames whose window covers
+        // it at positions i, i + hop_size, i + 2 * hop_size, ...
+        for (size_t i = 0; i < config.hop_size; ++i)
+        {
+            double sum = 0.0;
+            for (size_t k = i; k < config.frame_size; k += config.hop_size)
+            {
+                sum += window_[k] * window_[k];
+            }
+            normalization_[i] = sum > 1e-12 ? 1.0 / sum : 0.0;
+        }
+    }
+
+    template <typename F>
+    void Istft::process(const ComplexVector &spectrum, F &&on_samples)
+    {
+        const size_t frame_size = config_.frame_size;
+        const size_t hop_size = config_.hop_size;
+        const size_t num_bins = frame_size / 2 + 1;
+
+        if (spectrum.size() != num_bins)
+        {
+            throw std::invalid_argument("ISTFT spectrum must have frame_size / 2 + 1 bins");
+        }
+
+        // Rebuild the full conjugate symmetric spectrum of the real frame
+        std::copy(spectrum.begin(), spectrum.end(), work_.begin());
+        for (size_t k = 1; k < frame_size - num_bins + 1; ++k)
+        {
+            work_[frame_size - k] = std::conj(spectrum[k]);
+        }
+        plan_.inverse(work_.data());
+
+        for (size_t i = 0; i < frame_size; ++i)
+        {
+            overlap_[i] += work_[i].real() * window_[i];
+        }
+
+        // The first hop_size samples have received all their frames
+        for (size_t i = 0; i < hop_size; ++i)
+        {
+            overlap_[i] *= normalization_[i];
+        }
+        on_samples(static_cast<const double *>(overlap_.data()), hop_size);
+
+        std::copy(overlap_.begin() + hop_size, overlap_.end(), overlap_.begin());
+        std::fill(overlap_.end() - hop_size, overlap_.end(), 0.0);
+    }
+
+    LUMOS_INLINE void Istft::process(const ComplexVector &spectrum, RealVector &output)
+    {
+        process(spectrum, [&output](const double *samples, size_t num_samples)
+                { output.insert(output.end(), samples, samples + num_samples); });
+    }
+
+    LUMOS_INLINE void Istft::reset()
+    {
+        std::fill(overlap_.begin(), overlap_.end(), 0.0);
+    }
+
+    LUMOS_INLINE const StftConfig &Istft::config() const
+    {
+        return config_;
+    }
+
+    // =============================================================================
+    // MultiChannelStft
+    // =============================================================================
+
+    LUMOS_INLINE MultiChannelStft::MultiChannelStft(size_t num_channels, const StftConfig &config, size_t num_threads)
+        : channels_(num_channels, Stft(config)), num_threads_(num_threads)
+    {
+    }
+
+    template <typename F>
+    void MultiChannelStft::process(const std::vector<RealVector> &channels, F &&on_frame)
+    {
+        if (channels.size() != channels_.size())
+        {
+            throw std::invalid_argument("Expected one chunk of samples per channel");
+        }
+
+        lumos::internal::parallelFor(
+            0, channels_.size(), 1,
+            [&](size_t begin, size_t end)
+            {
+                for (size_t c = begin; c < end; ++c)
+                {
+                    channels_[c].process(channels[c], [&on_frame, c](const ComplexVector &spectrum)
+                                         { on_frame(c, spectrum); });
+                }
+            },
+            num_threads_);
+    }
+
+    LUMOS_INLINE void MultiChannelStft::reset()
+    {
+        for (Stft &channel : channels_)
+        {
+            channel.reset();
+        }
+    }
+
+    LUMOS_INLINE size_t MultiChannelStft::num_channels() const
+    {
+        return channels_.size();
+    }
+
+    LUMOS_INLINE Stft &MultiChannelStft::channel(size_t index)
+    {
+        return channels_.at(index);
+    }
+
+    // =============================================================================
+    // One-shot transforms
+    // =============================================================================
+
+    LUMOS_INLINE std::vector<ComplexVector> stft(const RealVector &signal, const StftConfig &config)
+    {
+        Stft transform(config);
+        std::vector<ComplexVector> frames;
+        if (signal.size() >= config.frame_size)
+        {
+            frames.reserve((signal.size() - config.frame_size) / config.hop_size + 1);
+        }
+
+        transform.process(signal, [&frames](const ComplexVector &spectrum)
+                          { frames.push_back(spectrum); });
+        return frames;
+    }
+
+    LUMOS_INLINE RealVector istft(const std::vector<ComplexVector> &frames, const StftConfig &config)
+    {
+        Istft transform(config);
+        RealVector output;
+        output.reserve(frames.size() * config.hop_size);
+
+        for (const ComplexVector &spectrum : frames)
+        {
+            transform.process(spectrum, output);
+        }
+        return output;
+    }
+
+} // namespace fft
+
+#endif // STFT_IMPL_H
@@ -1,8 +1,14 @@
 #include <gtest/gtest.h>
 #include <cmath>
 #include <algorithm>
+#include <mutex>
+#include <random>
 
 #include "lumos/math/fft/fft.impl.h"
+#include "lumos/math/fft/fft2d.impl.h"
+#include "lumos/math/fft/stft.impl.h"
+#include "lumos/vo/phase_correlation.h"
+#include "lumos/math/fft/spectral.impl.h"
 
 namespace lumos
 {
@@ -293,4 +299,930 @@ namespace lumos
         EXPECT_EQ(fft_result.size(), N);
     }
 
-} // namespace lumos
\ No newline at end of file
+    // =============================================================================
+    // FFT Plan Tests
+    // =============================================================================
+
+    TEST_F(FFTTest, PlanMatchesFFT)
+    {
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+        for (size_t n : {1U, 2U, 8U, 64U, 512U})
+        {
+            ComplexVector input(n);
+            for (Complex &c : input)
+            {
+                c = Complex(dist(rng), dist(rng));
+            }
+
+            const fft::FFTPlan plan(n);
+            EXPECT_EQ(plan.size(), n);
+
+            ComplexVector data = input;
+            plan.forward(data.data());
+            ExpectComplexVectorNear(fft::fft(input), data, 1e-9);
+
+            plan.inverse(data.data());
+            ExpectComplexVectorNear(input, data, 1e-12);
+        }
+
+        EXPECT_THROW(fft::FFTPlan(12), std::invalid_argument);
+    }
+
+    // =============================================================================
+    // Window Tests
+    // =============================================================================
+
+    TEST_F(FFTTest, Windows)
+    {
+        const RealVector hann = fft::make_window(fft::WindowType::Hann, 8);
+        EXPECT_NEAR(hann[0], 0.0, tolerance);
+        EXPECT_NEAR(hann[4], 1.0, tolerance);
+        EXPECT_NEAR(hann[2], 0.5, tolerance);
+        EXPECT_NEAR(hann[1], hann[7], tolerance);
+
+        const RealVector symmetric = fft::make_window(fft::WindowType::Hann, 9, false);
+        EXPECT_NEAR(symmetric[0], 0.0, tolerance);
+        EXPECT_NEAR(symmetric[8], 0.0, tolerance);
+        EXPECT_NEAR(symmetric[4], 1.0, tolerance);
+
+        const RealVector hamming = fft::make_window(fft::WindowType::Hamming, 16);
+        EXPECT_NEAR(hamming[0], 0.08, tolerance);
+
+        const RealVector blackman = fft::make_window(fft::WindowType::Blackman, 16, false);
+        EXPECT_NEAR(blackman[0], 0.0, 1e-12);
+
+        // Kaiser with beta 0 is rectangular, otherwise it peaks at 1 in the middle
+        const RealVector kaiser_flat = fft::make_window(fft::WindowType::Kaiser, 16, true, 0.0);
+        ExpectRealVectorNear(RealVector(16, 1.0), kaiser_flat, tolerance);
+        const RealVector kaiser = fft::make_window(fft::WindowType::Kaiser, 17, false, 8.6);
+        EXPECT_NEAR(kaiser[8], 1.0, tolerance);
+        EXPECT_NEAR(kaiser[0], 1.0 / fft::bessel_i0(8.6), tolerance);
+        EXPECT_NEAR(kaiser[3], kaiser[13], tolerance);
+    }
+
+    // =============================================================================
+    // STFT Tests
+    // =============================================================================
+
+    TEST_F(FFTTest, StftSinusoidPeak)
+    {
+        fft::StftConfig config;
+        config.frame_size = 256;
+        config.hop_size = 64;
+
+        RealVector signal(2048);
+        for (size_t i = 0; i < signal.size(); ++i)
+        {
+            signal[i] = std::sin(2.0 * M_PI * 32.0 * static_cast<double>(i) / 256.0);
+        }
+
+        const std::vector<ComplexVector> frames = fft::stft(signal, config);
+        ASSERT_EQ(frames.size(), (2048U - 256U) / 64U + 1U);
+
+        for (const ComplexVector &frame : frames)
+        {
+            ASSERT_EQ(frame.size(), 129U);
+            const RealVector mag = fft::magnitude(frame);
+            EXPECT_EQ(std::distance(mag.begin(), std::max_element(mag.begin(), mag.end())), 32);
+        }
+    }
+
+    TEST_F(FFTTest, StftChunkedMatchesOneShot)
+    {
+        fft::StftConfig config;
+        config.frame_size = 64;
+        config.hop_size = 24;
+        config.window = fft::WindowType::Blackman;
+
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        std::uniform_int_distribution<size_t> chunk_size(1, 100);
+
+        RealVector signal(3000);
+        for (double &x : signal)
+        {
+            x = dist(rng);
+        }
+
+        const std::vector<ComplexVector> expected = fft::stft(signal, config);
+
+        fft::Stft transform(config);
+        std::vector<ComplexVector> frames;
+        size_t pos = 0;
+        while (pos < signal.size())
+        {
+            const size_t n = std::min(chunk_size(rng), signal.size() - pos);
+            transform.process(signal.data() + pos, n, [&frames](const ComplexVector &spectrum)
+                              { frames.push_back(spectrum); });
+            pos += n;
+        }
+
+        ASSERT_EQ(frames.size(), expected.size());
+        for (size_t k = 0; k < frames.size(); ++k)
+        {
+            ExpectComplexVectorNear(expected[k], frames[k], 1e-12);
+        }
+    }
+
+    TEST_F(FFTTest, StftHopLargerThanFrame)
+    {
+        fft::StftConfig config;
+        config.frame_size = 16;
+        config.hop_size = 40;
+        config.window = fft::WindowType::Rectangular;
+
+        RealVector signal(200);
+        for (size_t i = 0; i < signal.size(); ++i)
+        {
+            signal[i] = static_cast<double>(i);
+        }
+
+        const std::vector<ComplexVector> frames = fft::stft(signal, config);
+        ASSERT_EQ(frames.size(), 5U);
+
+        // The DC bin of a rectangular window frame is the sum of its samples
+        for (size_t k = 0; k < frames.size(); ++k)
+        {
+            const double start = static_cast<double>(k * 40);
+            EXPECT_NEAR(frames[k][0].real(), 16.0 * start + 120.0, 1e-9);
+        }
+    }
+
+    TEST_F(FFTTest, IstftReconstructs)
+    {
+        std::mt19937 rng(9);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+        RealVector signal(4096);
+        for (double &x : signal)
+        {
+            x = dist(rng);
+        }
+
+        const std::vector<std::pair<fft::WindowType, size_t>> setups = {
+            {fft::WindowType::Hann, 32}, {fft::WindowType::Hann, 64}, {fft::WindowType::Hamming, 48},
+            {fft::WindowType::Blackman, 16}, {fft::WindowType::Kaiser, 32}, {fft::WindowType::Rectangular, 128}};
+
+        for (const auto &setup : setups)
+        {
+            fft::StftConfig config;
+            config.frame_size = 128;
+            config.window = setup.first;
+            config.hop_size = setup.second;
+
+            const RealVector output = fft::istft(fft::stft(signal, config), config);
+            ASSERT_EQ(output.size(), ((signal.size() - 128) / setup.second + 1) * setup.second);
+
+            // Skip the start, where not all frames overlap yet
+            for (size_t i = 128 - setup.second; i < output.size(); ++i)
+            {
+                ASSERT_NEAR(output[i], signal[i], 1e-9) << "window " << static_cast<int>(setup.first) << " hop "
+                                                        << setup.second << " sample " << i;
+            }
+        }
+
+        fft::StftConfig config;
+        config.frame_size = 64;
+        config.hop_size = 128;
+        EXPECT_THROW(fft::Istft istft_transform(config), std::invalid_argument);
+    }
+
+    TEST_F(FFTTest, MultiChannelStft)
+    {
+        fft::StftConfig config;
+        config.frame_size = 128;
+        config.hop_size = 32;
+
+        constexpr size_t kNumChannels = 4;
+        std::mt19937 rng(13);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+        std::vector<RealVector> signals(kNumChannels, RealVector(1000));
+        for (RealVector &signal : signals)
+        {
+            for (double &x : signal)
+            {
+                x = dist(rng);
+            }
+        }
+
+        fft::MultiChannelStft transform(kNumChannels, config, 4);
+        EXPECT_EQ(transform.num_channels(), kNumChannels);
+
+        std::vector<std::vector<ComplexVector>> frames(kNumChannels);
+        std::mutex mutex;
+        const auto on_frame = [&](size_t channel, const ComplexVector &spectrum)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            frames[channel].push_back(spectrum);
+        };
+
+        // Two chunks of different sizes per channel
+        std::vector<RealVector> first(kNumChannels);
+        std::vector<RealVector> second(kNumChannels);
+        for (size_t c = 0; c < kNumChannels; ++c)
+        {
+            first[c].assign(signals[c].begin(), signals[c].begin() + 300 + 50 * c);
+            second[c].assign(signals[c].begin() + 300 + 50 * c, signals[c].end());
+        }
+        transform.process(first, on_frame);
+        transform.process(second, on_frame);
+
+        for (size_t c = 0; c < kNumChannels; ++c)
+        {
+            const std::vector<ComplexVector> expected = fft::stft(signals[c], config);
+            ASSERT_EQ(frames[c].size(), expected.size());
+            for (size_t k = 0; k < expected.size(); ++k)
+            {
+                ExpectComplexVectorNear(expected[k], frames[c][k], 1e-12);
+            }
+        }
+    }
+
+    // =============================================================================
+    // Spectral Estimation Tests
+    // =============================================================================
+
+    TEST_F(FFTTest, WelchFrequencies)
+    {
+        fft::WelchConfig config;
+        config.segment_size = 8;
+        config.sample_rate = 16.0;
+
+        ExpectRealVectorNear({0.0, 2.0, 4.0, 6.0, 8.0}, fft::welch_frequencies(config));
+    }
+
+    TEST_F(FFTTest, WelchPsdSinusoidPeak)
+    {
+        fft::WelchConfig config;
+        config.segment_size = 256;
+        config.overlap = 128;
+        config.sample_rate = 1000.0;
+
+        RealVector signal(4096);
+        for (size_t i = 0; i < signal.size(); ++i)
+        {
+            // 125 Hz is bin 32 of a 256 point segment at 1 kHz
+            signal[i] = std::sin(2.0 * M_PI * 125.0 * static_cast<double>(i) / config.sample_rate);
+        }
+
+        const RealVector psd = fft::welch_psd(signal, config);
+        ASSERT_EQ(psd.size(), 129U);
+        EXPECT_EQ(std::distance(psd.begin(), std::max_element(psd.begin(), psd.end())), 32);
+
+        // The PSD integrates to the signal power of 1/2
+        const double resolution = config.sample_rate / static_cast<double>(config.segment_size);
+        double power = 0.0;
+        for (double p : psd)
+        {
+            power += p * resolution;
+        }
+        EXPECT_NEAR(power, 0.5, 1e-3);
+    }
+
+    TEST_F(FFTTest, WelchPsdWhiteNoiseLevel)
+    {
+        fft::WelchConfig config;
+        config.segment_size = 128;
+        config.overlap = 64;
+        config.sample_rate = 10.0;
+
+        std::mt19937 rng(3);
+        std::normal_distribution<double> dist(0.0, 1.0);
+        RealVector signal(1 << 16);
+        for (double &x : signal)
+        {
+            x = dist(rng);
+        }
+
+        // One-sided density of unit variance white noise is 2 / fs
+        const RealVector psd = fft::welch_psd(signal, config);
+        double mean = 0.0;
+        for (size_t k = 1; k + 1 < psd.size(); ++k)
+        {
+            mean += psd[k];
+        }
+        mean /= static_cast<double>(psd.size() - 2);
+        EXPECT_NEAR(mean, 2.0 / config.sample_rate, 0.01);
+    }
+
+    TEST_F(FFTTest, WelchThreadCountDoesNotChangeResult)
+    {
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        RealVector x(5000);
+        RealVector y(5000);
+        for (size_t i = 0; i < x.size(); ++i)
+        {
+            x[i] = dist(rng);
+            y[i] = dist(rng);
+        }
+
+        fft::WelchConfig config;
+        config.segment_size = 64;
+        config.overlap = 48;
+        config.num_threads = 1;
+        const RealVector psd_single = fft::welch_psd(x, config);
+        const ComplexVector csd_single = fft::csd(x, y, config);
+
+        // Segments are summed in the same order for every thread count
+        for (const size_t num_threads : {2U, 3U, 4U, 7U})
+        {
+            config.num_threads = num_threads;
+            const RealVector psd = fft::welch_psd(x, config);
+            const ComplexVector cross = fft::csd(x, y, config);
+            ASSERT_EQ(psd.size(), psd_single.size());
+            for (size_t k = 0; k < psd.size(); ++k)
+            {
+                EXPECT_EQ(psd[k], psd_single[k]);
+                EXPECT_EQ(cross[k], csd_single[k]);
+            }
+        }
+    }
+
+    TEST_F(FFTTest, WelchObjectReusedForSeveralSignals)
+    {
+        std::mt19937 rng(6);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+        fft::WelchConfig config;
+        config.segment_size = 128;
+        config.overlap = 64;
+        config.num_threads = 2;
+        fft::Welch welch(config);
+        EXPECT_EQ(welch.num_bins(), 65U);
+
+        // Signals of different lengths, so the number of chunks changes between calls
+        for (const size_t length : {5000U, 300U, 2000U})
+        {
+            RealVector x(length);
+            RealVector y(length);
+            for (size_t i = 0; i < length; ++i)
+            {
+                x[i] = dist(rng);
+                y[i] = dist(rng);
+            }
+
+            ExpectRealVectorNear(fft::welch_psd(x, config), welch.psd(x), 0.0);
+            ExpectComplexVectorNear(fft::csd(x, y, config), welch.csd(x, y), 0.0);
+            ExpectRealVectorNear(fft::coherence(x, y, config), welch.coherence(x, y), 0.0);
+        }
+
+        EXPECT_THROW(welch.psd(RealVector(100, 0.0)), std::invalid_argument);
+    }
+
+    TEST_F(FFTTest, CsdOfSignalWithItselfIsPsd)
+    {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        RealVector x(3000);
+        for (double &v : x)
+        {
+            v = dist(rng);
+        }
+
+        fft::WelchConfig config;
+        config.segment_size = 128;
+        config.overlap = 96;
+        config.window = fft::WindowType::Hamming;
+
+        const RealVector psd = fft::welch_psd(x, config);
+        const ComplexVector cross = fft::csd(x, x, config);
+        ASSERT_EQ(cross.size(), psd.size());
+        for (size_t k = 0; k < psd.size(); ++k)
+        {
+            EXPECT_NEAR(cross[k].real(), psd[k], 1e-12);
+            EXPECT_NEAR(cross[k].imag(), 0.0, 1e-12);
+        }
+    }
+
+    TEST_F(FFTTest, CsdPhaseOfDelayedSignal)
+    {
+        fft::WelchConfig config;
+        config.segment_size = 256;
+        config.overlap = 128;
+
+        // y lags x by 2 samples, so Pxy = E[conj(X) * Y] has phase -2 * omega
+        RealVector x(4096);
+        RealVector y(4096);
+        const double omega = 2.0 * M_PI * 16.0 / 256.0;
+        for (size_t i = 0; i < x.size(); ++i)
+        {
+            x[i] = std::cos(omega * static_cast<double>(i));
+            y[i] = std::cos(omega * (static_cast<double>(i) - 2.0));
+        }
+
+        const ComplexVector cross = fft::csd(x, y, config);
+        EXPECT_NEAR(std::arg(cross[16]), -2.0 * omega, 1e-9);
+    }
+
+    TEST_F(FFTTest, Coherence)
+    {
+        std::mt19937 rng(11);
+        std::normal_distribution<double> dist(0.0, 1.0);
+        RealVector x(8192);
+        RealVector independent(8192);
+        for (size_t i = 0; i < x.size(); ++i)
+        {
+            x[i] = dist(rng);
+            independent[i] = dist(rng);
+        }
+
+        // A short FIR filter of x is fully coherent with x
+        RealVector filtered(x.size(), 0.0);
+        for (size_t i = 1; i < x.size(); ++i)
+        {
+            filtered[i] = 0.5 * x[i] + 0.3 * x[i - 1];
+        }
+
+        fft::WelchConfig config;
+        config.segment_size = 128;
+        config.overlap = 64;
+
+        const RealVector related = fft::coherence(x, filtered, config);
+        const RealVector unrelated = fft::coherence(x, independent, config);
+        ASSERT_EQ(related.size(), 65U);
+
+        double mean_related = 0.0;
+        double mean_unrelated = 0.0;
+        for (size_t k = 1; k < related.size(); ++k)
+        {
+            EXPECT_LE(related[k], 1.0 + 1e-12);
+            EXPECT_GE(unrelated[k], 0.0);
+            mean_related += related[k];
+            mean_unrelated += unrelated[k];
+        }
+        mean_related /= static_cast<double>(related.size() - 1);
+        mean_unrelated /= static_cast<double>(unrelated.size() - 1);
+
+        EXPECT_GT(mean_related, 0.95);
+        EXPECT_LT(mean_unrelated, 0.1);
+    }
+
+    TEST_F(FFTTest, WelchInvalidArguments)
+    {
+        fft::WelchConfig config;
+        config.segment_size = 64;
+        config.overlap = 64;
+        EXPECT_THROW(fft::welch_psd(RealVector(256, 0.0), config), std::invalid_argument);
+
+        config.overlap = 32;
+        EXPECT_THROW(fft::welch_psd(RealVector(63, 0.0), config), std::invalid_argument);
+        EXPECT_THROW(fft::csd(RealVector(256, 0.0), RealVector(255, 0.0), config), std::invalid_argument);
+    }
+
+    TEST_F(FFTTest, CorrelateFFTMatchesDirect)
+    {
+        std::mt19937 rng(17);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+        for (const auto &sizes : {std::make_pair(1, 1), std::make_pair(7, 3), std::make_pair(5, 12), std::make_pair(64, 64)})
+        {
+            RealVector x(sizes.first);
+            RealVector y(sizes.second);
+            for (double &v : x)
+            {
+                v = dist(rng);
+            }
+            for (double &v : y)
+            {
+                v = dist(rng);
+            }
+
+            const RealVector result = fft::correlate_fft(x, y);
+            ASSERT_EQ(result.size(), x.size() + y.size() - 1);
+
+            const int ny = static_cast<int>(y.size());
+            for (size_t i = 0; i < result.size(); ++i)
+            {
+                const int lag = static_cast<int>(i) - (ny - 1);
+                double expected = 0.0;
+                for (int n = 0; n < ny; ++n)
+                {
+                    const int j = n + lag;
+                    if ((j >= 0) && (j < static_cast<int>(x.size())))
+                    {
+                        expected += x[j] * y[n];
+                    }
+                }
+                EXPECT_NEAR(result[i], expected, 1e-10) << "lag " << lag;
+            }
+        }
+
+        EXPECT_TRUE(fft::correlate_fft(RealVector(), RealVector(3, 1.0)).empty());
+    }
+
+    TEST_F(FFTTest, AutocorrelateFFTMatchesDirect)
+    {
+        std::mt19937 rng(19);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        RealVector signal(37);
+        for (double &v : signal)
+        {
+            v = dist(rng);
+        }
+
+        const RealVector result = fft::autocorrelate_fft(signal);
+        ASSERT_EQ(result.size(), signal.size());
+        for (size_t k = 0; k < signal.size(); ++k)
+        {
+            double expected = 0.0;
+            for (size_t n = 0; n + k < signal.size(); ++n)
+            {
+                expected += signal[n + k] * signal[n];
+            }
+            EXPECT_NEAR(result[k], expected, 1e-10);
+        }
+    }
+
+    // =============================================================================
+    // Batched and 2D FFT Tests
+    // =============================================================================
+
+    TEST_F(FFTTest, BatchMatchesSingleTransforms)
+    {
+        constexpr size_t kNumSignals = 9;
+        constexpr size_t kLength = 64;
+        constexpr size_t kStride = 80;
+
+        std::mt19937 rng(23);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        ComplexVector data(kNumSignals * kStride);
+        for (Complex &c : data)
+        {
+            c = Complex(dist(rng), dist(rng));
+        }
+        const ComplexVector original = data;
+
+        fft::fft_batch(data.data(), kNumSignals, kLength, kStride, false, 4);
+
+        for (size_t i = 0; i < kNumSignals; ++i)
+        {
+            const ComplexVector signal(original.begin() + i * kStride, original.begin() + i * kStride + kLength);
+            const ComplexVector result(data.begin() + i * kStride, data.begin() + i * kStride + kLength);
+            ExpectComplexVectorNear(fft::fft(signal), result, 1e-12);
+
+            // The gap between two signals is left alone
+            for (size_t k = kLength; k < kStride; ++k)
+            {
+                EXPECT_EQ(data[i * kStride + k], original[i * kStride + k]);
+            }
+        }
+
+        fft::fft_batch(data.data(), kNumSignals, kLength, kStride, true, 4);
+        ExpectComplexVectorNear(original, data, 1e-12);
+
+        EXPECT_THROW(fft::fft_batch(data.data(), 2, 48, 48), std::invalid_argument);
+        EXPECT_THROW(fft::fft_batch(data.data(), 2, 64, 32), std::invalid_argument);
+    }
+
+    TEST_F(FFTTest, FftRowsOfMatrix)
+    {
+        lumos::Matrix<Complex> m(5, 16);
+        for (size_t r = 0; r < m.numRows(); ++r)
+        {
+            for (size_t c = 0; c < m.numCols(); ++c)
+            {
+                m(r, c) = Complex(std::sin(0.3 * static_cast<double>(r * c)), static_cast<double>(r));
+            }
+        }
+        const lumos::Matrix<Complex> original(m);
+
+        fft::fft_rows(m);
+        for (size_t r = 0; r < m.numRows(); ++r)
+        {
+            const ComplexVector row(original.data() + r * 16, original.data() + (r + 1) * 16);
+            ExpectComplexVectorNear(fft::fft(row), ComplexVector(m.data() + r * 16, m.data() + (r + 1) * 16), 1e-12);
+        }
+    }
+
+    TEST_F(FFTTest, BlockedTranspose)
+    {
+        constexpr size_t kNumRows = 37;
+        constexpr size_t kNumCols = 70;
+
+        ComplexVector src(kNumRows * kNumCols);
+        for (size_t i = 0; i < src.size(); ++i)
+        {
+            src[i] = Complex(static_cast<double>(i), -static_cast<double>(i));
+        }
+
+        ComplexVector dst(src.size());
+        fft::transpose(src.data(), kNumRows, kNumCols, dst.data(), 3);
+
+        for (size_t r = 0; r < kNumRows; ++r)
+        {
+            for (size_t c = 0; c < kNumCols; ++c)
+            {
+                EXPECT_EQ(dst[c * kNumRows + r], src[r * kNumCols + c]);
+            }
+        }
+    }
+
+    TEST_F(FFTTest, Fft2dMatchesDirectDFT)
+    {
+        constexpr size_t kNumRows = 8;
+        constexpr size_t kNumCols = 16;
+
+        std::mt19937 rng(29);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        lumos::Matrix<Complex> m(kNumRows, kNumCols);
+        for (size_t i = 0; i < m.numElements(); ++i)
+        {
+            m.data()[i] = Complex(dist(rng), dist(rng));
+        }
+
+        const lumos::Matrix<Complex> spectrum = fft::fft2d(m, 2);
+
+        for (size_t u = 0; u < kNumRows; ++u)
+        {
+            for (size_t v = 0; v < kNumCols; ++v)
+            {
+                Complex expected(0.0, 0.0);
+                for (size_t r = 0; r < kNumRows; ++r)
+                {
+                    for (size_t c = 0; c < kNumCols; ++c)
+                    {
+                        const double angle = -2.0 * M_PI *
+                                             (static_cast<double>(u * r) / kNumRows + static_cast<double>(v * c) / kNumCols);
+                        expected += m(r, c) * Complex(std::cos(angle), std::sin(angle));
+                    }
+                }
+                EXPECT_NEAR(spectrum(u, v).real(), expected.real(), 1e-10);
+                EXPECT_NEAR(spectrum(u, v).imag(), expected.imag(), 1e-10);
+            }
+        }
+
+        const lumos::Matrix<Complex> inverse = fft::ifft2d(spectrum);
+        for (size_t i = 0; i < m.numElements(); ++i)
+        {
+            EXPECT_NEAR(inverse.data()[i].real(), m.data()[i].real(), 1e-12);
+            EXPECT_NEAR(inverse.data()[i].imag(), m.data()[i].imag(), 1e-12);
+        }
+    }
+
+    TEST_F(FFTTest, Fft2dOfRealImage)
+    {
+        lumos::ImageGray<float> image(32, 64);
+        for (size_t r = 0; r < image.numRows(); ++r)
+        {
+            for (size_t c = 0; c < image.numCols(); ++c)
+            {
+                image(r, c) = static_cast<float>((r * 7 + c * 3) % 11);
+            }
+        }
+
+        const lumos::Matrix<Complex> spectrum = fft::fft2d(image);
+        const lumos::Matrix<double> restored = fft::ifft2d_real(spectrum);
+
+        ASSERT_EQ(restored.numRows(), 32U);
+        ASSERT_EQ(restored.numCols(), 64U);
+        for (size_t r = 0; r < image.numRows(); ++r)
+        {
+            for (size_t c = 0; c < image.numCols(); ++c)
+            {
+                EXPECT_NEAR(restored(r, c), image(r, c), 1e-10);
+            }
+        }
+
+        lumos::Matrix<double> not_power_of_2(6, 8);
+        not_power_of_2.fill(1.0);
+        EXPECT_THROW(fft::fft2d(not_power_of_2), std::invalid_argument);
+    }
+
+    TEST_F(FFTTest, Convolve2dMatchesDirect)
+    {
+        std::mt19937 rng(31);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+        lumos::Matrix<double> image(13, 11);
+        lumos::Matrix<double> kernel(3, 5);
+        for (size_t i = 0; i < image.numElements(); ++i)
+        {
+            image.data()[i] = dist(rng);
+        }
+        for (size_t i = 0; i < kernel.numElements(); ++i)
+        {
+            kernel.data()[i] = dist(rng);
+        }
+
+        const lumos::Matrix<double> result = fft::convolve2d_fft(image, kernel);
+        ASSERT_EQ(result.numRows(), image.numRows());
+        ASSERT_EQ(result.numCols(), image.numCols());
+
+        const int kr = static_cast<int>(kernel.numRows());
+        const int kc = static_cast<int>(kernel.numCols());
+        for (int r = 0; r < static_cast<int>(image.numRows()); ++r)
+        {
+            for (int c = 0; c < static_cast<int>(image.numCols()); ++c)
+            {
+                double expected = 0.0;
+                for (int i = 0; i < kr; ++i)
+                {
+                    for (int j = 0; j < kc; ++j)
+                    {
+                        const int ir = r + kr / 2 - i;
+                        const int ic = c + kc / 2 - j;
+                        if ((ir >= 0) && (ir < static_cast<int>(image.numRows())) && (ic >= 0) &&
+                            (ic < static_cast<int>(image.numCols())))
+                        {
+                            expected += image(ir, ic) * kernel(i, j);
+                        }
+                    }
+                }
+                EXPECT_NEAR(result(r, c), expected, 1e-10);
+            }
+        }
+    }
+
+    TEST_F(FFTTest, Convolve2dEmptyInputs)
+    {
+        lumos::Matrix<double> image(4, 6);
+        image.fill(1.0);
+        lumos::Matrix<double> kernel(3, 3);
+        kernel.fill(1.0);
+        const lumos::Matrix<double> empty;
+
+        EXPECT_EQ(fft::convolve2d_fft(empty, empty).numElements(), 0U);
+        EXPECT_EQ(fft::convolve2d_fft(empty, kernel).numElements(), 0U);
+        EXPECT_EQ(fft::convolve2d_fft(image, empty).numElements(), 0U);
+    }
+
+    TEST_F(FFTTest, PhaseCorrelationFindsShift)
+    {
+        // Two crops of one larger random image, offset by (dy, dx) = (3, -5)
+        std::mt19937 rng(37);
+        std::uniform_real_distribution<float> dist(0.0f, 255.0f);
+        lumos::ImageGray<float> scene(96, 96);
+        for (size_t i = 0; i < scene.numElements(); ++i)
+        {
+            scene.data()[i] = dist(rng);
+        }
+
+        lumos::ImageGray<float> reference(64, 64);
+        lumos::ImageGray<float> image(64, 64);
+        for (size_t r = 0; r < 64; ++r)
+        {
+            for (size_t c = 0; c < 64; ++c)
+            {
+                reference(r, c) = scene(r + 16, c + 16);
+                image(r, c) = scene(r + 13, c + 21);
+            }
+        }
+
+        const lumos::PhaseCorrelationResult result = lumos::phaseCorrelate(reference, image);
+        EXPECT_NEAR(result.dy, 3.0, 0.25);
+        EXPECT_NEAR(result.dx, -5.0, 0.25);
+        EXPECT_GT(result.response, 0.1);
+    }
+
+    TEST_F(FFTTest, PhaseCorrelationCircularShift)
+    {
+        std::mt19937 rng(41);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        lumos::Matrix<double> reference(32, 32);
+        for (size_t i = 0; i < reference.numElements(); ++i)
+        {
+            reference.data()[i] = dist(rng);
+        }
+
+        lumos::Matrix<double> image(32, 32);
+        for (size_t r = 0; r < 32; ++r)
+        {
+            for (size_t c = 0; c < 32; ++c)
+            {
+                image(r, c) = reference((r + 32 - 6) % 32, (c + 2) % 32);
+            }
+        }
+
+        // Without a window a circular shift gives a single peak of height 1
+        const lumos::PhaseCorrelationResult result = lumos::phaseCorrelate(reference, image, false);
+        EXPECT_NEAR(result.dy, 6.0, 1e-9);
+        EXPECT_NEAR(result.dx, -2.0, 1e-9);
+        EXPECT_NEAR(result.response, 1.0, 1e-9);
+    }
+
+    // =============================================================================
+    // Generic-Type FFT Tests
+    // =============================================================================
+
+    TEST_F(FFTTest, SmallSizesMatchDirectDFT)
+    {
+        for (size_t n = 1; n <= 64; n <<= 1)
+        {
+            ComplexVector input(n);
+            ComplexVectorF input_f(n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                input[i] = Complex(std::cos(0.7 * static_cast<double>(i)), 0.1 * static_cast<double>(i));
+                input_f[i] = ComplexF(static_cast<float>(input[i].real()), static_cast<float>(input[i].imag()));
+            }
+
+            ComplexVector expected(n, Complex(0.0, 0.0));
+            for (size_t k = 0; k < n; ++k)
+            {
+                for (size_t i = 0; i < n; ++i)
+                {
+                    const double angle = -2.0 * M_PI * static_cast<double>(k * i) / static_cast<double>(n);
+                    expected[k] += input[i] * Complex(std::cos(angle), std::sin(angle));
+                }
+            }
+
+            ExpectComplexVectorNear(expected, fft::fft(input), 1e-10);
+
+            const ComplexVectorF result_f = fft::fft(input_f);
+            ASSERT_EQ(result_f.size(), n);
+            for (size_t k = 0; k < n; ++k)
+            {
+                EXPECT_NEAR(result_f[k].real(), expected[k].real(), 1e-4);
+                EXPECT_NEAR(result_f[k].imag(), expected[k].imag(), 1e-4);
+            }
+        }
+    }
+
+    TEST_F(FFTTest, FloatMatchesDouble)
+    {
+        constexpr size_t kN = 1024;
+        std::mt19937 rng(43);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+        ComplexVectorF input(kN);
+        ComplexVector input_d(kN);
+        for (size_t i = 0; i < kN; ++i)
+        {
+            input[i] = ComplexF(dist(rng), dist(rng));
+            input_d[i] = Complex(input[i].real(), input[i].imag());
+        }
+
+        const ComplexVectorF result = fft::fft(input);
+        const ComplexVector expected = fft::fft(input_d);
+        for (size_t k = 0; k < kN; ++k)
+        {
+            EXPECT_NEAR(result[k].real(), expected[k].real(), 1e-3);
+            EXPECT_NEAR(result[k].imag(), expected[k].imag(), 1e-3);
+        }
+
+        const ComplexVectorF restored = fft::ifft(result);
+        for (size_t i = 0; i < kN; ++i)
+        {
+            EXPECT_NEAR(restored[i].real(), input[i].real(), 1e-5);
+            EXPECT_NEAR(restored[i].imag(), input[i].imag(), 1e-5);
+        }
+
+        fft::FFTPlanF plan(kN);
+        ComplexVectorF in_place = input;
+        plan.forward(in_place.data());
+        plan.inverse(in_place.data());
+        for (size_t i = 0; i < kN; ++i)
+        {
+            EXPECT_NEAR(in_place[i].real(), input[i].real(), 1e-5);
+        }
+
+        EXPECT_THROW(fft::FFTPlanF(12), std::invalid_argument);
+    }
+
+    TEST_F(FFTTest, GenericInputTypes)
+    {
+        const RealVectorF samples = {1.0f, -2.0f, 0.5f, 3.0f, 0.0f, -1.0f, 2.0f, 0.25f};
+
+        lumos::Vector<float> vector(samples.size());
+        lumos::Vector<ComplexF> complex_vector(samples.size());
+        ComplexVectorF complex_samples(samples.size());
+        for (size_t i = 0; i < samples.size(); ++i)
+        {
+            vector(i) = samples[i];
+            complex_vector(i) = ComplexF(samples[i], 0.0f);
+            complex_samples[i] = complex_vector(i);
+        }
+
+        const ComplexVectorF expected = fft::fft(samples);
+        const std::vector<ComplexVectorF> results = {fft::fft(vector), fft::fft(complex_vector),
+                                                     fft::fft(samples.data(), samples.size()),
+                                                     fft::fft(complex_samples.data(), complex_samples.size())};
+
+        for (const ComplexVectorF &result : results)
+        {
+            ASSERT_EQ(result.size(), expected.size());
+            for (size_t k = 0; k < expected.size(); ++k)
+            {
+                EXPECT_FLOAT_EQ(result[k].real(), expected[k].real());
+                EXPECT_FLOAT_EQ(result[k].imag(), expected[k].imag());
+            }
+        }
+
+        ComplexVectorF in_place = complex_samples;
+        fft::fft_inplace(in_place.data(), in_place.size());
+        fft::ifft_inplace(in_place.data(), in_place.size());
+        for (size_t i = 0; i < samples.size(); ++i)
+        {
+            EXPECT_NEAR(in_place[i].real(), samples[i], 1e-6);
+        }
+
+        // Double precision input still resolves to the non-template functions
+        const ComplexVector double_result = fft::fft(RealVector(samples.begin(), samples.end()));
+        EXPECT_NEAR(double_result[0].real(), 3.75, 1e-12);
+    }
+
+} // namespace lumos
@@ -0,0 +1,59 @@
+#ifndef LUMOS_MATH_FILTERS_CLASS_DEF_HAMPEL_FILTER_H_
+#define LUMOS_MATH_FILTERS_CLASS_DEF_HAMPEL_FILTER_H_
+
+#include "lumos/math/filters/class_def/median_filter.h"
+#include <cstddef>
+#include <vector>
+
+namespace lumos
+{
+
+  // Hampel outlier filter. Over a centered window of 2 * half_window + 1
+  // samples, the center sample is replaced by the window median if it lies
+  // more than n_sigmas robust standard deviations (1.4826 * median absolute
+  // deviation) away from it, and passed through otherwise. The median is kept
+  // by a MedianFilter in O(log window) per sample, the MAD needs a selection
+  // over the window deviations in O(window). The output for input n is the
+  // filtered sample n - half_window. Before the window is full the signal is
+  // taken as constant at its first sample. NaN samples are left out of the
+  // median, NaN and infinite samples out of the MAD, and both are replaced by
+  // the median when they reach the center.
+  template <typename T>
+  class HampelFilter
+  {
+  private:
+    size_t half_window_;
+    T n_sigmas_;
+    MedianFilter<T> median_filter_;
+    std::vector<T> deviations_; // Scratch space for the MAD selection
+    bool is_empty_;
+    size_t num_outliers_;
+
+  public:
+    HampelFilter();
+    explicit HampelFilter(size_t half_window, T n_sigmas = T(3));
+
+    // Core filtering operations
+    T filter(T input);
+    std::vector<T> filter(const std::vector<T> &input);
+
+    // Batch processing with output buffer
+    void filter(const T *input, T *output, size_t length);
+
+    void reset();
+
+    size_t getHalfWindow() const;
+    size_t getWindowSize() const;
+    T getNumSigmas() const;
+    // Number of samples replaced since construction or the last reset
+    size_t getNumOutliers() const;
+    T getGroupDelay() const;
+  };
+
+  // Type aliases for common use cases
+  using HampelFilterd = HampelFilter<double>;
+  using HampelFilterf = HampelFilter<float>;
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_FILTERS_CLASS_DEF_HAMPEL_FILTER_H_
@@ -20,6 +20,12 @@ namespace lumos
     std::deque<T> y_delay_line_;    // Output delay line
     size_t numerator_order_;
     size_t denominator_order_;
+    // Computed whenever the coefficients change, so that const queries are
+    // cheap and safe to call from several threads
+    std::vector<std::complex<T>> zeros_;
+    std::vector<std::complex<T>> poles_;
+
+    void computePolesAndZeros();
 
   public:
     // Constructors
@@ -68,8 +74,10 @@ namespace lumos
 
     // Utility methods
     void printCoefficients() const;
-    std::vector<std::complex<T>> getPoles() const;
-    std::vector<std::complex<T>> getZeros() const;
+    // Roots of H(z) = B(z^-1) / A(z^-1) in the z-plane, including the ones
+    // at the origin that make the numbers of poles and zeros equal
+    const std::vector<std::complex<T>> &getPoles() const;
+    const std::vector<std::complex<T>> &getZeros() const;
 
     // Static factory methods for common filters
     static IIRFilter<T> firstOrderLowPass(T cutoff_freq, T sample_rate);
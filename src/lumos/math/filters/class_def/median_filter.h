@@ -0,0 +1,63 @@
+#ifndef LUMOS_MATH_FILTERS_CLASS_DEF_MEDIAN_FILTER_H_
+#define LUMOS_MATH_FILTERS_CLASS_DEF_MEDIAN_FILTER_H_
+
+#include <cstddef>
+#include <deque>
+#include <set>
+#include <vector>
+
+namespace lumos
+{
+
+  // Running median of the last window_size samples. The window is kept as two
+  // balanced ordered halves, so a new sample costs O(log window_size) instead
+  // of sorting the window. Until window_size samples have been seen, the
+  // median of all samples so far is returned. For an even window the mean of
+  // the two middle values is used, rounded down for integer types. NaN samples take their place in the window
+  // but are left out of the median, which is the median of the other samples
+  // in the window, NaN if there are none. Infinities are ordered like any
+  // other value, so a saturated input gives an infinite median.
+  template <typename T>
+  class MedianFilter
+  {
+  private:
+    size_t window_size_;
+    std::deque<T> window_;   // Samples in arrival order, oldest first
+    std::multiset<T> lower_; // Smaller half, holds the extra element for odd sizes
+    std::multiset<T> upper_; // Larger half
+
+    // False for NaN, which has no place in the ordered halves
+    static bool isOrdered(T value);
+    void insert(T value);
+    void erase(T value);
+    void rebalance();
+
+  public:
+    MedianFilter();
+    explicit MedianFilter(size_t window_size);
+
+    // Core filtering operations
+    T filter(T input);
+    std::vector<T> filter(const std::vector<T> &input);
+
+    // Batch processing with output buffer
+    void filter(const T *input, T *output, size_t length);
+
+    void reset();
+
+    // Median of the samples in the current window that are not NaN, 0 if no
+    // sample has been seen
+    T median() const;
+    const std::deque<T> &getWindow() const;
+    size_t getWindowSize() const;
+    // Delay of the median of a full window for a linear trend, in samples
+    T getGroupDelay() const;
+  };
+
+  // Type aliases for common use cases
+  using MedianFilterd = MedianFilter<double>;
+  using MedianFilterf = MedianFilter<float>;
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_FILTERS_CLASS_DEF_MEDIAN_FILTER_H_
@@ -0,0 +1,118 @@
+#ifndef LUMOS_MATH_FILTERS_CLASS_DEF_POLYPHASE_RESAMPLER_H_
+#define LUMOS_MATH_FILTERS_CLASS_DEF_POLYPHASE_RESAMPLER_H_
+
+#include "lumos/math/filters/class_def/fir_filter.h"
+#include <cstddef>
+#include <vector>
+
+namespace lumos
+{
+
+  // Rational L/M resampler: conceptually upsamples by L (zero insertion),
+  // applies a low-pass FIR filter at L times the input rate and keeps every
+  // M-th sample. The filter is split into L phases, and only the kept outputs
+  // are computed, each from one phase and the last few input samples, so a
+  // decimator does 1/M of the multiply-adds of filtering at the input rate.
+  // Output n is the filtered upsampled signal at index n * M, i.e. output
+  // sample 0 is aligned with input sample 0.
+  template <typename T>
+  class PolyphaseResampler
+  {
+  private:
+    size_t up_;
+    size_t down_;
+    size_t taps_per_phase_;
+    size_t num_prototype_taps_;
+    // phases_[p * taps_per_phase_ + j] = L * h[p + (taps_per_phase_ - 1 - j) * L],
+    // reversed so that phase p is a dot product with the history, oldest first
+    std::vector<T> phases_;
+    // Last taps_per_phase_ input samples, stored twice so that they are always
+    // contiguous at history_[pos_ + 1 ... pos_ + taps_per_phase_]
+    std::vector<T> history_;
+    size_t pos_;
+    size_t phase_; // Phase of the next output
+    size_t delay_; // Input samples to push before the next output
+
+    void push(T sample);
+    T computeOutput() const;
+
+  public:
+    PolyphaseResampler();
+    // prototype runs at up * input rate and should have unity DC gain, the
+    // interpolation gain of up is applied internally. up and down are reduced
+    // by their greatest common divisor
+    PolyphaseResampler(size_t up, size_t down, const FIRFilter<T> &prototype);
+    // Uses the anti-aliasing filter from designLowPass
+    PolyphaseResampler(size_t up, size_t down, size_t half_length = 10);
+
+    // Resamples a chunk of a stream, output must hold maxOutputSize(length)
+    // samples. Returns the number of samples written
+    size_t process(const T *input, size_t length, T *output);
+    std::vector<T> process(const std::vector<T> &input);
+
+    // Upper bound on the outputs produced by a chunk of length input samples
+    size_t maxOutputSize(size_t length) const;
+
+    void reset();
+
+    size_t getUpFactor() const;
+    size_t getDownFactor() const;
+    size_t getTapsPerPhase() const;
+    // Delay of the linear phase prototype, in output samples
+    T getGroupDelay() const;
+
+    // Windowed sinc low-pass from FIRFilter::lowPass with a Blackman window,
+    // cutoff at half the lower of the two Nyquist frequencies and
+    // 2 * half_length * max(up, down) + 1 taps, for use at up * input rate
+    static FIRFilter<T> designLowPass(size_t up, size_t down, size_t half_length = 10);
+
+    static PolyphaseResampler<T> decimator(size_t factor, size_t half_length = 10);
+    static PolyphaseResampler<T> interpolator(size_t factor, size_t half_length = 10);
+  };
+
+  // Resamples several channels with the same filter and timing. Samples are
+  // interleaved (frame by frame), and the history is kept in the same layout,
+  // so the inner loop of every output runs over contiguous channels and is
+  // vectorized by the compiler
+  template <typename T>
+  class MultiChannelPolyphaseResampler
+  {
+  private:
+    size_t num_channels_;
+    size_t up_;
+    size_t down_;
+    size_t taps_per_phase_;
+    size_t num_prototype_taps_;
+    std::vector<T> phases_;  // Same layout as in PolyphaseResampler
+    std::vector<T> history_; // 2 * taps_per_phase_ frames
+    size_t pos_;
+    size_t phase_;
+    size_t delay_;
+
+  public:
+    MultiChannelPolyphaseResampler();
+    MultiChannelPolyphaseResampler(size_t num_channels, size_t up, size_t down,
+                                   const FIRFilter<T> &prototype);
+    MultiChannelPolyphaseResampler(size_t num_channels, size_t up, size_t down,
+                                   size_t half_length = 10);
+
+    // input holds num_frames interleaved frames, output must hold
+    // maxOutputFrames(num_frames) frames. Returns the number of frames written
+    size_t processInterleaved(const T *input, size_t num_frames, T *output);
+
+    size_t maxOutputFrames(size_t num_frames) const;
+
+    void reset();
+
+    size_t getNumChannels() const;
+    size_t getUpFactor() const;
+    size_t getDownFactor() const;
+  };
+
+  // Type aliases for common use cases
+  using PolyphaseResamplerd = PolyphaseResampler<double>;
+  using PolyphaseResamplerf = PolyphaseResampler<float>;
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_FILTERS_CLASS_DEF_POLYPHASE_RESAMPLER_H_
@@ -0,0 +1,66 @@
+#ifndef LUMOS_MATH_FILTERS_CLASS_DEF_SAVITZKY_GOLAY_FILTER_H_
+#define LUMOS_MATH_FILTERS_CLASS_DEF_SAVITZKY_GOLAY_FILTER_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace lumos
+{
+
+  // Savitzky-Golay smoother and differentiator. A polynomial of degree
+  // poly_order is fitted by least squares to every window of window_size
+  // samples, and its value (or derivative) at the window center is returned.
+  // The fit is a fixed linear combination of the window samples, so the
+  // convolution coefficients are computed once in the constructor and every
+  // sample costs window_size multiply-adds. The output for input n is the
+  // estimate at sample n - (window_size - 1) / 2. Before the window is full
+  // the signal is taken as constant at its first sample.
+  template <typename T>
+  class SavitzkyGolayFilter
+  {
+  private:
+    size_t window_size_;
+    size_t poly_order_;
+    size_t derivative_;
+    std::vector<T> coefficients_; // For the window samples, oldest first
+    // Window stored twice, always contiguous at history_[pos_ + 1 ... pos_ + window_size_]
+    std::vector<T> history_;
+    size_t pos_;
+    bool is_empty_;
+
+  public:
+    SavitzkyGolayFilter();
+    // window_size must be odd and larger than poly_order, derivative at most
+    // poly_order. sample_period scales derivatives to units per second
+    SavitzkyGolayFilter(size_t window_size, size_t poly_order,
+                        size_t derivative = 0, T sample_period = T(1));
+
+    // Core filtering operations
+    T filter(T input);
+    std::vector<T> filter(const std::vector<T> &input);
+
+    // Batch processing with output buffer
+    void filter(const T *input, T *output, size_t length);
+
+    void reset();
+
+    const std::vector<T> &getCoefficients() const;
+    size_t getWindowSize() const;
+    size_t getPolyOrder() const;
+    size_t getDerivative() const;
+    T getGroupDelay() const;
+
+    // Convolution coefficients for the window samples, oldest first
+    static std::vector<T> computeCoefficients(size_t window_size,
+                                              size_t poly_order,
+                                              size_t derivative = 0,
+                                              T sample_period = T(1));
+  };
+
+  // Type aliases for common use cases
+  using SavitzkyGolayFilterd = SavitzkyGolayFilter<double>;
+  using SavitzkyGolayFilterf = SavitzkyGolayFilter<float>;
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_FILTERS_CLASS_DEF_SAVITZKY_GOLAY_FILTER_H_
@@ -1,8 +1,14 @@
 #ifndef LUMOS_MATH_FILTERS_FILTERS_H_
 #define LUMOS_MATH_FILTERS_FILTERS_H_
 
+#include "lumos/math/filters/filtfilt.h"
 #include "lumos/math/filters/fir_filter.h"
+#include "lumos/math/filters/frequency_response.h"
+#include "lumos/math/filters/hampel_filter.h"
 #include "lumos/math/filters/iir_filter.h"
+#include "lumos/math/filters/median_filter.h"
+#include "lumos/math/filters/polyphase_resampler.h"
+#include "lumos/math/filters/savitzky_golay_filter.h"
 
 namespace lumos
 {
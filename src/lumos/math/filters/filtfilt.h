@@ -0,0 +1,308 @@
+#ifndef LUMOS_MATH_FILTERS_FILTFILT_H_
+#define LUMOS_MATH_FILTERS_FILTFILT_H_
+
+#include "lumos/math/filters/fir_filter.h"
+#include "lumos/math/filters/iir_filter.h"
+#include "lumos/math/misc/parallel_for.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace lumos
+{
+  namespace internal
+  {
+    // Puts a filter in the state it would have after a long run of a constant
+    // input value, so that a signal starting at value causes no transient
+    template <typename T>
+    void setSteadyState(FIRFilter<T> &filter, const T value)
+    {
+      filter.setInitialConditions(
+          std::vector<T>(filter.getNumCoefficients(), value));
+    }
+
+    template <typename T>
+    void setSteadyState(IIRFilter<T> &filter, const T value)
+    {
+      const std::vector<T> &b = filter.getNumeratorCoefficients();
+      const std::vector<T> &a = filter.getDenominatorCoefficients();
+
+      T sum_b = T(0);
+      T sum_a = T(0);
+      for (const T c : b)
+      {
+        sum_b += c;
+      }
+      for (const T c : a)
+      {
+        sum_a += c;
+      }
+
+      // Filters with a pole at z = 1 (integrators) have no steady state
+      if (std::abs(sum_a) <= T(1e-12) * std::abs(a[0]))
+      {
+        filter.reset();
+        return;
+      }
+
+      filter.setInitialConditions(std::vector<T>(b.size(), value),
+                                  std::vector<T>(a.size(), value * sum_b / sum_a));
+    }
+
+    template <typename T>
+    size_t defaultPadLength(const FIRFilter<T> &filter)
+    {
+      return 3 * filter.getNumCoefficients();
+    }
+
+    template <typename T>
+    size_t defaultPadLength(const IIRFilter<T> &filter)
+    {
+      return 3 * std::max(filter.getNumeratorCoefficients().size(),
+                          filter.getDenominatorCoefficients().size());
+    }
+
+    template <typename Filter, typename T>
+    void filterInPlace(Filter &filter, T *const data, const size_t length)
+    {
+      for (size_t i = 0; i < length; ++i)
+      {
+        data[i] = filter.filter(data[i]);
+      }
+    }
+
+    // Forward-backward filtering of [begin, end). The signal is extended at
+    // both ends by pad_length samples of odd reflection, and each pass starts
+    // in the steady state of its first sample
+    template <typename Filter, typename T>
+    std::vector<T> filtfiltRange(const Filter &filter, const T *const begin,
+                                 const T *const end, size_t pad_length)
+    {
+      const size_t length = static_cast<size_t>(end - begin);
+      if (length == 0)
+      {
+        return std::vector<T>();
+      }
+      pad_length = std::min(pad_length, length - 1);
+
+      std::vector<T> extended(length + 2 * pad_length);
+      const T first = begin[0];
+      const T last = begin[length - 1];
+      for (size_t k = 1; k <= pad_length; ++k)
+      {
+        extended[pad_length - k] = T(2) * first - begin[k];
+        extended[pad_length + length - 1 + k] = T(2) * last - begin[length - 1 - k];
+      }
+      std::copy(begin, end, extended.begin() + pad_length);
+
+      Filter forward(filter);
+      setSteadyState(forward, extended.front());
+      filterInPlace(forward, extended.data(), extended.size());
+
+      std::reverse(extended.begin(), extended.end());
+      Filter backward(filter);
+      setSteadyState(backward, extended.front());
+      filterInPlace(backward, extended.data(), extended.size());
+      std::reverse(extended.begin(), extended.end());
+
+      return std::vector<T>(extended.begin() + pad_length,
+                            extended.begin() + pad_length + length);
+    }
+
+    template <typename Filter, typename T>
+    std::vector<T> filterBlocks(const Filter &filter, const std::vector<T> &input,
+                                const size_t block_size, const size_t warm_up_length,
+                                const size_t num_threads)
+    {
+      if (block_size == 0)
+      {
+        throw std::invalid_argument("Block size must be greater than 0");
+      }
+
+      std::vector<T> output(input.size());
+      const size_t num_blocks = (input.size() + block_size - 1) / block_size;
+
+      parallelFor(
+          0, num_blocks, 1,
+          [&](const size_t block_begin, const size_t block_end)
+          {
+            for (size_t block = block_begin; block < block_end; ++block)
+            {
+              const size_t begin = block * block_size;
+              const size_t end = std::min(begin + block_size, input.size());
+
+              // Blocks continue from the filter's own state at the start of
+              // the signal, or from the steady state of the first warm-up sample
+              Filter block_filter(filter);
+              if (begin > 0)
+              {
+                size_t warm_up_begin = 0;
+                if (warm_up_length < begin)
+                {
+                  warm_up_begin = begin - warm_up_length;
+                  setSteadyState(block_filter, input[warm_up_begin]);
+                }
+                for (size_t i = warm_up_begin; i < begin; ++i)
+                {
+                  block_filter.filter(input[i]);
+                }
+              }
+
+              for (size_t i = begin; i < end; ++i)
+              {
+                output[i] = block_filter.filter(input[i]);
+              }
+            }
+          },
+          num_threads);
+
+      return output;
+    }
+
+    template <typename Filter, typename T>
+    std::vector<T> filtfiltBlocks(const Filter &filter, const std::vector<T> &input,
+                                  const size_t block_size, const size_t overlap,
+                                  const size_t num_threads)
+    {
+      if (block_size == 0)
+      {
+        throw std::invalid_argument("Block size must be greater than 0");
+      }
+
+      std::vector<T> output(input.size());
+      const size_t num_blocks = (input.size() + block_size - 1) / block_size;
+      const size_t pad_length = defaultPadLength(filter);
+      // Segments longer than the padding get the same padding as the whole
+      // signal at its ends
+      const size_t extension = std::max(overlap, pad_length + 1);
+
+      parallelFor(
+          0, num_blocks, 1,
+          [&](const size_t block_begin, const size_t block_end)
+          {
+            for (size_t block = block_begin; block < block_end; ++block)
+            {
+              const size_t begin = block * block_size;
+              const size_t end = std::min(begin + block_size, input.size());
+
+              // Blocks at the ends of the signal see the same padding as a
+              // filtfilt of the whole signal, inner edges are cut away
+              const size_t segment_begin = begin - std::min(extension, begin);
+              const size_t segment_end = std::min(end + extension, input.size());
+
+              const std::vector<T> segment =
+                  filtfiltRange(filter, input.data() + segment_begin,
+                                input.data() + segment_end, pad_length);
+              std::copy(segment.begin() + (begin - segment_begin),
+                        segment.begin() + (end - segment_begin),
+                        output.begin() + begin);
+            }
+          },
+          num_threads);
+
+      return output;
+    }
+  } // namespace internal
+
+  // =============================================================================
+  // Zero-phase filtering
+  // =============================================================================
+
+  // Filters the signal forwards and then backwards, which cancels the phase
+  // response and squares the magnitude response. The ends are extended by odd
+  // reflection of pad_length samples (default 3 * filter length, at most the
+  // signal length - 1), and each pass starts from the steady state of its first
+  // sample, so there are no start-up transients. The state of filter is not
+  // used or changed
+  template <typename T>
+  std::vector<T> filtfilt(const FIRFilter<T> &filter, const std::vector<T> &input)
+  {
+    return filtfilt(filter, input, internal::defaultPadLength(filter));
+  }
+
+  template <typename T>
+  std::vector<T> filtfilt(const FIRFilter<T> &filter, const std::vector<T> &input,
+                          const size_t pad_length)
+  {
+    return internal::filtfiltRange(filter, input.data(),
+                                   input.data() + input.size(), pad_length);
+  }
+
+  template <typename T>
+  std::vector<T> filtfilt(const IIRFilter<T> &filter, const std::vector<T> &input)
+  {
+    return filtfilt(filter, input, internal::defaultPadLength(filter));
+  }
+
+  template <typename T>
+  std::vector<T> filtfilt(const IIRFilter<T> &filter, const std::vector<T> &input,
+                          const size_t pad_length)
+  {
+    return internal::filtfiltRange(filter, input.data(),
+                                   input.data() + input.size(), pad_length);
+  }
+
+  // =============================================================================
+  // Block-parallel offline filtering
+  // =============================================================================
+
+  // Same as filter.filter(input) on a copy of filter, computed in blocks of
+  // block_size samples on num_threads threads (0 = all hardware threads).
+  // Every block after the first is warmed up on the getNumCoefficients() - 1
+  // samples before it, so the result is exact
+  template <typename T>
+  std::vector<T> filterParallel(const FIRFilter<T> &filter,
+                                const std::vector<T> &input,
+                                const size_t block_size,
+                                const size_t num_threads = 0)
+  {
+    return internal::filterBlocks(filter, input, block_size,
+                                  filter.getNumCoefficients() - 1, num_threads);
+  }
+
+  // IIR version. Blocks after the first start from the steady state of the
+  // sample warm_up_length samples before them and run up to the block, so the
+  // error at a block start decays like the slowest pole over warm_up_length
+  // samples. Choose warm_up_length as several time constants of the filter
+  template <typename T>
+  std::vector<T> filterParallel(const IIRFilter<T> &filter,
+                                const std::vector<T> &input,
+                                const size_t block_size,
+                                const size_t warm_up_length,
+                                const size_t num_threads = 0)
+  {
+    return internal::filterBlocks(filter, input, block_size, warm_up_length,
+                                  num_threads);
+  }
+
+  // filtfilt in blocks of block_size samples on num_threads threads. Each block
+  // is filtered together with the getNumCoefficients() - 1 samples on either
+  // side, which is all a zero-phase FIR output depends on, so the result equals
+  // filtfilt(filter, input)
+  template <typename T>
+  std::vector<T> filtfiltParallel(const FIRFilter<T> &filter,
+                                  const std::vector<T> &input,
+                                  const size_t block_size,
+                                  const size_t num_threads = 0)
+  {
+    return internal::filtfiltBlocks(filter, input, block_size,
+                                    filter.getNumCoefficients() - 1, num_threads);
+  }
+
+  // IIR version, each block is filtered together with overlap samples on either
+  // side, which are discarded. Like for filterParallel, overlap should span
+  // several time constants of the filter
+  template <typename T>
+  std::vector<T> filtfiltParallel(const IIRFilter<T> &filter,
+                                  const std::vector<T> &input,
+                                  const size_t block_size, const size_t overlap,
+                                  const size_t num_threads = 0)
+  {
+    return internal::filtfiltBlocks(filter, input, block_size, overlap,
+                                    num_threads);
+  }
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_FILTERS_FILTFILT_H_
@@ -173,14 +173,14 @@ namespace lumos
       return std::complex<T>(0, 0);
     }
 
-    T omega = 2 * M_PI * frequency / sample_rate;
+    // Horner's scheme in w = e^(-j * omega) needs one sin / cos pair
+    const T omega = T(2 * M_PI) * frequency / sample_rate;
+    const std::complex<T> w(std::cos(omega), -std::sin(omega));
     std::complex<T> response(0, 0);
 
-    for (size_t n = 0; n < coefficients_.size(); ++n)
+    for (size_t n = coefficients_.size(); n-- > 0;)
     {
-      T phase = -omega * n;
-      response +=
-          coefficients_[n] * std::complex<T>(std::cos(phase), std::sin(phase));
+      response = response * w + coefficients_[n];
     }
 
     return response;
@@ -0,0 +1,326 @@
+#ifndef LUMOS_MATH_FILTERS_FREQUENCY_RESPONSE_H_
+#define LUMOS_MATH_FILTERS_FREQUENCY_RESPONSE_H_
+
+#include "lumos/math/filters/fir_filter.h"
+#include "lumos/math/filters/iir_filter.h"
+#include "lumos/math/misc/parallel_for.h"
+#include "lumos/math/misc/sin_cos.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace lumos
+{
+
+  // Frequency response of a filter on a grid of frequencies, everything a
+  // Bode plot needs
+  template <typename T>
+  struct FrequencyResponse
+  {
+    std::vector<T> frequencies;
+    std::vector<std::complex<T>> response;
+    std::vector<T> magnitude;
+    // 20 * log10(magnitude), exact zeros give 20 * log10 of the smallest
+    // normal number instead of -inf
+    std::vector<T> magnitude_db;
+    // Radians, unwrapped along the frequencies in the order given
+    std::vector<T> phase;
+    // Samples, -d(phase) / d(omega). Zero where the response is zero, as
+    // the phase is undefined there
+    std::vector<T> group_delay;
+
+    size_t size() const
+    {
+      return frequencies.size();
+    }
+  };
+
+  namespace internal
+  {
+    // Frequencies are processed in blocks that keep the Horner state in L1
+    constexpr size_t kFrequencyResponseBlockSize = 256U;
+    constexpr size_t kFrequencyResponseMinChunkSize = 4096U;
+
+    // Points w = e^(-j * omega) of a block of frequencies
+    template <typename T>
+    struct UnitCircleBlock
+    {
+      T re[kFrequencyResponseBlockSize];
+      T im[kFrequencyResponseBlockSize];
+    };
+
+    // Polynomial P(w) and its weighted counterpart D(w) on a block. Keeping
+    // the arrays of a block in one object lets the compiler see that they do
+    // not overlap, raw pointers need more run-time alias checks than it does
+    template <typename T>
+    struct HornerBlock
+    {
+      T p_re[kFrequencyResponseBlockSize];
+      T p_im[kFrequencyResponseBlockSize];
+      T d_re[kFrequencyResponseBlockSize];
+      T d_im[kFrequencyResponseBlockSize];
+    };
+
+    // P(w) = c[0] + c[1] * w + ... and D(w) = 0 * c[0] + 1 * c[1] * w + ...
+    // for the first count points of w by Horner's scheme. The loop over w is
+    // the inner one, so that it is vectorized
+    template <typename T>
+    void hornerOnUnitCircle(const std::vector<T> &c, const UnitCircleBlock<T> &w,
+                            const size_t count, HornerBlock<T> &h)
+    {
+      std::fill(h.p_re, h.p_re + count, T(0));
+      std::fill(h.p_im, h.p_im + count, T(0));
+      std::fill(h.d_re, h.d_re + count, T(0));
+      std::fill(h.d_im, h.d_im + count, T(0));
+
+      for (size_t k = c.size(); k-- > 0;)
+      {
+        const T ck = c[k];
+        const T k_ck = static_cast<T>(k) * ck;
+        for (size_t i = 0; i < count; ++i)
+        {
+          const T pr = h.p_re[i] * w.re[i] - h.p_im[i] * w.im[i] + ck;
+          const T pi = h.p_re[i] * w.im[i] + h.p_im[i] * w.re[i];
+          const T dr = h.d_re[i] * w.re[i] - h.d_im[i] * w.im[i] + k_ck;
+          const T di = h.d_re[i] * w.im[i] + h.d_im[i] * w.re[i];
+          h.p_re[i] = pr;
+          h.p_im[i] = pi;
+          h.d_re[i] = dr;
+          h.d_im[i] = di;
+        }
+      }
+    }
+
+    // Re(D / P), the group delay of the polynomial P with weighted
+    // counterpart D, or 0 where |P|^2 <= tiny
+    template <typename T>
+    T polynomialGroupDelay(const T p_re, const T p_im, const T d_re, const T d_im,
+                           const T tiny)
+    {
+      const T norm = p_re * p_re + p_im * p_im;
+      const T valid = static_cast<T>(norm > tiny);
+      return valid * (d_re * p_re + d_im * p_im) / (norm > tiny ? norm : T(1));
+    }
+
+    template <typename T>
+    T groupDelayThreshold(const std::vector<T> &c)
+    {
+      T sum = T(0);
+      for (const T ck : c)
+      {
+        sum += std::abs(ck);
+      }
+      const T scaled = std::numeric_limits<T>::epsilon() * sum;
+      return scaled * scaled;
+    }
+
+    // Response of B(e^(-j * omega)) / A(e^(-j * omega)), a empty for FIR
+    // filters
+    template <typename T>
+    FrequencyResponse<T> evaluateFrequencyResponse(const std::vector<T> &b,
+                                                   const std::vector<T> &a,
+                                                   const std::vector<T> &frequencies,
+                                                   const T sample_rate,
+                                                   const size_t num_threads)
+    {
+      if (!(sample_rate > T(0)))
+      {
+        throw std::invalid_argument("Sample rate must be positive");
+      }
+
+      const size_t n = frequencies.size();
+      FrequencyResponse<T> result;
+      result.frequencies = frequencies;
+      result.response.resize(n);
+      result.magnitude.resize(n);
+      result.magnitude_db.resize(n);
+      result.phase.resize(n);
+      result.group_delay.resize(n);
+
+      const bool has_denominator = !a.empty();
+      const T tiny_b = groupDelayThreshold(b);
+      const T tiny_a = groupDelayThreshold(a);
+      const T omega_scale = T(2 * M_PI) / sample_rate;
+      const T min_magnitude = std::numeric_limits<T>::min();
+
+      parallelFor(
+          0U, n, kFrequencyResponseMinChunkSize,
+          [&](const size_t chunk_begin, const size_t chunk_end)
+          {
+            constexpr size_t kBlock = kFrequencyResponseBlockSize;
+            UnitCircleBlock<T> w;
+            HornerBlock<T> hb, ha;
+
+            for (size_t block = chunk_begin; block < chunk_end; block += kBlock)
+            {
+              const size_t count = std::min(kBlock, chunk_end - block);
+              const T *const f = frequencies.data() + block;
+
+              for (size_t i = 0; i < count; ++i)
+              {
+                T s, c;
+                sinCos(omega_scale * f[i], s, c);
+                w.re[i] = c;
+                w.im[i] = -s;
+              }
+
+              hornerOnUnitCircle(b, w, count, hb);
+              if (has_denominator)
+              {
+                hornerOnUnitCircle(a, w, count, ha);
+              }
+
+              for (size_t i = 0; i < count; ++i)
+              {
+                T h_re = hb.p_re[i];
+                T h_im = hb.p_im[i];
+                T tau = polynomialGroupDelay(hb.p_re[i], hb.p_im[i], hb.d_re[i], hb.d_im[i],
+                                             tiny_b);
+                if (has_denominator)
+                {
+                  const T inv_norm_a = T(1) / (ha.p_re[i] * ha.p_re[i] + ha.p_im[i] * ha.p_im[i]);
+                  h_re = (hb.p_re[i] * ha.p_re[i] + hb.p_im[i] * ha.p_im[i]) * inv_norm_a;
+                  h_im = (hb.p_im[i] * ha.p_re[i] - hb.p_re[i] * ha.p_im[i]) * inv_norm_a;
+                  tau -= polynomialGroupDelay(ha.p_re[i], ha.p_im[i], ha.d_re[i], ha.d_im[i],
+                                              tiny_a);
+                }
+
+                const size_t j = block + i;
+                const T magnitude = std::sqrt(h_re * h_re + h_im * h_im);
+                result.response[j] = std::complex<T>(h_re, h_im);
+                result.magnitude[j] = magnitude;
+                result.magnitude_db[j] = T(20) * std::log10(std::max(magnitude, min_magnitude));
+                result.phase[j] = std::atan2(h_im, h_re);
+                result.group_delay[j] = tau;
+              }
+            }
+          },
+          num_threads);
+
+      // Unwrapping is sequential, jumps larger than pi are taken as wraps
+      T offset = T(0);
+      for (size_t i = 1; i < n; ++i)
+      {
+        const T wrapped = result.phase[i] + offset;
+        const T jump = wrapped - result.phase[i - 1];
+        offset -= T(2 * M_PI) * std::round(jump / T(2 * M_PI));
+        result.phase[i] += offset;
+      }
+
+      return result;
+    }
+  } // namespace internal
+
+  // Response at each of frequencies (same unit as sample_rate), evaluated by
+  // Horner's scheme on blocks of frequencies instead of one frequency at a
+  // time. Grids of at least two chunks are spread over num_threads threads
+  // (0 = all hardware threads)
+  template <typename T>
+  FrequencyResponse<T> frequencyResponse(const FIRFilter<T> &filter,
+                                         const std::vector<T> &frequencies,
+                                         const T sample_rate,
+                                         const size_t num_threads = 0)
+  {
+    return internal::evaluateFrequencyResponse(filter.getCoefficients(), std::vector<T>(),
+                                               frequencies, sample_rate, num_threads);
+  }
+
+  template <typename T>
+  FrequencyResponse<T> frequencyResponse(const IIRFilter<T> &filter,
+                                         const std::vector<T> &frequencies,
+                                         const T sample_rate,
+                                         const size_t num_threads = 0)
+  {
+    const std::vector<T> &b = filter.getNumeratorCoefficients();
+    const std::vector<T> &a = filter.getDenominatorCoefficients();
+
+    // Empty filters respond with zero like IIRFilter::frequencyResponse, and
+    // a constant denominator is folded into the numerator
+    if (b.empty() || a.empty())
+    {
+      return internal::evaluateFrequencyResponse(std::vector<T>(), std::vector<T>(),
+                                                 frequencies, sample_rate, num_threads);
+    }
+    if (a.size() == 1)
+    {
+      std::vector<T> scaled_b(b);
+      for (T &c : scaled_b)
+      {
+        c /= a[0];
+      }
+      return internal::evaluateFrequencyResponse(scaled_b, std::vector<T>(), frequencies,
+                                                 sample_rate, num_threads);
+    }
+    return internal::evaluateFrequencyResponse(b, a, frequencies, sample_rate,
+                                               num_threads);
+  }
+
+  // Responses of a filter bank on a common grid, one filter per task
+  template <typename Filter, typename T>
+  std::vector<FrequencyResponse<T>> frequencyResponses(const std::vector<Filter> &filters,
+                                                       const std::vector<T> &frequencies,
+                                                       const T sample_rate,
+                                                       const size_t num_threads = 0)
+  {
+    std::vector<FrequencyResponse<T>> responses(filters.size());
+    internal::parallelFor(
+        0U, filters.size(), 1U,
+        [&](const size_t begin, const size_t end)
+        {
+          for (size_t i = begin; i < end; ++i)
+          {
+            responses[i] = frequencyResponse(filters[i], frequencies, sample_rate, 1U);
+          }
+        },
+        num_threads);
+    return responses;
+  }
+
+  // num_points frequencies from 0 to the Nyquist frequency, both included
+  template <typename T>
+  std::vector<T> linearFrequencies(const size_t num_points, const T sample_rate)
+  {
+    std::vector<T> frequencies(num_points, T(0));
+    const T step = num_points > 1
+                       ? sample_rate / (T(2) * static_cast<T>(num_points - 1))
+                       : T(0);
+    for (size_t i = 0; i < num_points; ++i)
+    {
+      frequencies[i] = step * static_cast<T>(i);
+    }
+    return frequencies;
+  }
+
+  // num_points logarithmically spaced frequencies from min_frequency to
+  // max_frequency, both included, the usual grid of Bode plots
+  template <typename T>
+  std::vector<T> logFrequencies(const T min_frequency, const T max_frequency,
+                                const size_t num_points)
+  {
+    if (!(min_frequency > T(0)) || !(max_frequency >= min_frequency))
+    {
+      throw std::invalid_argument(
+          "Frequencies must satisfy 0 < min_frequency <= max_frequency");
+    }
+
+    std::vector<T> frequencies(num_points, min_frequency);
+    if (num_points > 1)
+    {
+      const T log_min = std::log(min_frequency);
+      const T log_step =
+          (std::log(max_frequency) - log_min) / static_cast<T>(num_points - 1);
+      for (size_t i = 0; i < num_points; ++i)
+      {
+        frequencies[i] = std::exp(log_min + log_step * static_cast<T>(i));
+      }
+      frequencies.back() = max_frequency;
+    }
+    return frequencies;
+  }
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_FILTERS_FREQUENCY_RESPONSE_H_
@@ -0,0 +1,117 @@
+#ifndef LUMOS_MATH_FILTERS_HAMPEL_FILTER_H_
+#define LUMOS_MATH_FILTERS_HAMPEL_FILTER_H_
+
+#include "lumos/math/filters/class_def/hampel_filter.h"
+#include "lumos/math/filters/median_filter.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace lumos
+{
+
+  template <typename T>
+  HampelFilter<T>::HampelFilter()
+      : half_window_(0), n_sigmas_(T(3)), median_filter_(1), deviations_(1),
+        is_empty_(true), num_outliers_(0) {}
+
+  template <typename T>
+  HampelFilter<T>::HampelFilter(size_t half_window, T n_sigmas)
+      : half_window_(half_window), n_sigmas_(n_sigmas),
+        median_filter_(2 * half_window + 1), deviations_(2 * half_window + 1),
+        is_empty_(true), num_outliers_(0)
+  {
+    if (n_sigmas < T(0))
+    {
+      throw std::invalid_argument("Number of sigmas must not be negative");
+    }
+  }
+
+  template <typename T>
+  T HampelFilter<T>::filter(T input)
+  {
+    if (is_empty_)
+    {
+      for (size_t i = 0; i < 2 * half_window_; ++i)
+      {
+        median_filter_.filter(input);
+      }
+      is_empty_ = false;
+    }
+
+    const T median = median_filter_.filter(input);
+    const std::deque<T> &window = median_filter_.getWindow();
+    const T center = window[half_window_];
+
+    // A NaN or infinite center is always an outlier
+    if (!std::isfinite(center))
+    {
+      ++num_outliers_;
+      return median;
+    }
+
+    size_t num_finite = 0;
+    for (const T value : window)
+    {
+      if (std::isfinite(value))
+      {
+        deviations_[num_finite++] = std::abs(value - median);
+      }
+    }
+    const size_t middle = (num_finite - 1) / 2;
+    std::nth_element(deviations_.begin(), deviations_.begin() + middle,
+                     deviations_.begin() + num_finite);
+
+    // 1.4826 * MAD estimates the standard deviation of Gaussian noise
+    const T threshold = n_sigmas_ * T(1.4826) * deviations_[middle];
+    if (std::abs(center - median) > threshold)
+    {
+      ++num_outliers_;
+      return median;
+    }
+    return center;
+  }
+
+  template <typename T>
+  std::vector<T> HampelFilter<T>::filter(const std::vector<T> &input)
+  {
+    std::vector<T> output(input.size());
+    filter(input.data(), output.data(), input.size());
+    return output;
+  }
+
+  template <typename T>
+  void HampelFilter<T>::filter(const T *input, T *output, size_t length)
+  {
+    for (size_t i = 0; i < length; ++i)
+    {
+      output[i] = filter(input[i]);
+    }
+  }
+
+  template <typename T>
+  void HampelFilter<T>::reset()
+  {
+    median_filter_.reset();
+    is_empty_ = true;
+    num_outliers_ = 0;
+  }
+
+  template <typename T>
+  size_t HampelFilter<T>::getHalfWindow() const { return half_window_; }
+
+  template <typename T>
+  size_t HampelFilter<T>::getWindowSize() const { return 2 * half_window_ + 1; }
+
+  template <typename T>
+  T HampelFilter<T>::getNumSigmas() const { return n_sigmas_; }
+
+  template <typename T>
+  size_t HampelFilter<T>::getNumOutliers() const { return num_outliers_; }
+
+  template <typename T>
+  T HampelFilter<T>::getGroupDelay() const { return T(half_window_); }
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_FILTERS_HAMPEL_FILTER_H_
@@ -2,6 +2,7 @@
 #define LUMOS_MATH_FILTERS_IIR_FILTER_H_
 
 #include "lumos/math/filters/class_def/iir_filter.h"
+#include "lumos/math/misc/polynomial_roots.h"
 #include <algorithm>
 #include <cmath>
 #include <iostream>
@@ -29,6 +30,7 @@ namespace lumos
 
     x_delay_line_.resize(b_coefficients_.size(), T(0));
     y_delay_line_.resize(a_coefficients_.size(), T(0));
+    computePolesAndZeros();
   }
 
   template <typename T>
@@ -47,6 +49,7 @@ namespace lumos
 
     x_delay_line_.resize(b_coefficients_.size(), T(0));
     y_delay_line_.resize(a_coefficients_.size(), T(0));
+    computePolesAndZeros();
   }
 
   template <typename T>
@@ -65,6 +68,7 @@ namespace lumos
 
     x_delay_line_.resize(b_coefficients_.size(), T(0));
     y_delay_line_.resize(a_coefficients_.size(), T(0));
+    computePolesAndZeros();
   }
 
   template <typename T>
@@ -73,7 +77,8 @@ namespace lumos
         a_coefficients_(other.a_coefficients_),
         x_delay_line_(other.x_delay_line_), y_delay_line_(other.y_delay_line_),
         numerator_order_(other.numerator_order_),
-        denominator_order_(other.denominator_order_) {}
+        denominator_order_(other.denominator_order_), zeros_(other.zeros_),
+        poles_(other.poles_) {}
 
   template <typename T>
   IIRFilter<T>::IIRFilter(IIRFilter &&other) noexcept
@@ -82,7 +87,8 @@ namespace lumos
         x_delay_line_(std::move(other.x_delay_line_)),
         y_delay_line_(std::move(other.y_delay_line_)),
         numerator_order_(other.numerator_order_),
-        denominator_order_(other.denominator_order_) {}
+        denominator_order_(other.denominator_order_),
+        zeros_(std::move(other.zeros_)), poles_(std::move(other.poles_)) {}
 
   template <typename T>
   IIRFilter<T> &IIRFilter<T>::operator=(const IIRFilter &other)
@@ -95,6 +101,8 @@ namespace lumos
       y_delay_line_ = other.y_delay_line_;
       numerator_order_ = other.numerator_order_;
       denominator_order_ = other.denominator_order_;
+      zeros_ = other.zeros_;
+      poles_ = other.poles_;
     }
     return *this;
   }
@@ -110,6 +118,8 @@ namespace lumos
       y_delay_line_ = std::move(other.y_delay_line_);
       numerator_order_ = other.numerator_order_;
       denominator_order_ = other.denominator_order_;
+      zeros_ = std::move(other.zeros_);
+      poles_ = std::move(other.poles_);
     }
     return *this;
   }
@@ -226,6 +236,7 @@ namespace lumos
 
     x_delay_line_.resize(b_coefficients_.size(), T(0));
     y_delay_line_.resize(a_coefficients_.size(), T(0));
+    computePolesAndZeros();
   }
 
   template <typename T>
@@ -264,6 +275,19 @@ namespace lumos
     return b_coefficients_.empty() && a_coefficients_.empty();
   }
 
+  template <typename T>
+  bool IIRFilter<T>::isStable() const
+  {
+    for (const std::complex<T> &pole : poles_)
+    {
+      if (!(std::abs(pole) < T(1)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
   template <typename T>
   std::complex<T> IIRFilter<T>::frequencyResponse(T frequency,
                                                   T sample_rate) const
@@ -273,24 +297,20 @@ namespace lumos
       return std::complex<T>(0, 0);
     }
 
-    T omega = 2 * M_PI * frequency / sample_rate;
+    // Horner's scheme in w = e^(-j * omega) needs one sin / cos pair
+    const T omega = T(2 * M_PI) * frequency / sample_rate;
+    const std::complex<T> w(std::cos(omega), -std::sin(omega));
 
-    // Compute numerator response
     std::complex<T> numerator(0, 0);
-    for (size_t n = 0; n < b_coefficients_.size(); ++n)
+    for (size_t n = b_coefficients_.size(); n-- > 0;)
     {
-      T phase = -omega * n;
-      numerator +=
-          b_coefficients_[n] * std::complex<T>(std::cos(phase), std::sin(phase));
+      numerator = numerator * w + b_coefficients_[n];
     }
 
-    // Compute denominator response
     std::complex<T> denominator(0, 0);
-    for (size_t n = 0; n < a_coefficients_.size(); ++n)
+    for (size_t n = a_coefficients_.size(); n-- > 0;)
     {
-      T phase = -omega * n;
-      denominator +=
-          a_coefficients_[n] * std::complex<T>(std::cos(phase), std::sin(phase));
+      denominator = denominator * w + a_coefficients_[n];
     }
 
     return numerator / denominator;
@@ -318,6 +338,53 @@ namespace lumos
     std::cout << std::endl;
   }
 
+  template <typename T>
+  const std::vector<std::complex<T>> &IIRFilter<T>::getPoles() const
+  {
+    return poles_;
+  }
+
+  template <typename T>
+  const std::vector<std::complex<T>> &IIRFilter<T>::getZeros() const
+  {
+    return zeros_;
+  }
+
+  template <typename T>
+  void IIRFilter<T>::computePolesAndZeros()
+  {
+    // Multiplying B(z^-1) and A(z^-1) by z^L, L the larger order, gives
+    // polynomials in z whose coefficients are b and a in descending powers,
+    // times z^(L - M) and z^(L - N) for the numerator and denominator orders
+    // M and N. Leading zeros of b are zeros at infinity and trailing zeros
+    // of either are roots at the origin
+    const auto roots = [](const std::vector<T> &c, const size_t order)
+    {
+      size_t begin = 0;
+      size_t end = c.size();
+      while (begin < end && c[begin] == T(0))
+      {
+        ++begin;
+      }
+      while (end > begin && c[end - 1] == T(0))
+      {
+        --end;
+      }
+
+      std::vector<std::complex<T>> result = internal::polynomialRoots(
+          std::vector<T>(c.begin() + begin, c.begin() + end));
+      if (end > begin)
+      {
+        result.insert(result.end(), order + c.size() - end, std::complex<T>(0, 0));
+      }
+      return result;
+    };
+
+    const size_t order = getOrder();
+    zeros_ = roots(b_coefficients_, order - numerator_order_);
+    poles_ = roots(a_coefficients_, order - denominator_order_);
+  }
+
   template <typename T>
   IIRFilter<T> IIRFilter<T>::firstOrderLowPass(T cutoff_freq, T sample_rate)
   {
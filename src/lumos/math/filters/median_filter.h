@@ -0,0 +1,195 @@
+#ifndef LUMOS_MATH_FILTERS_MEDIAN_FILTER_H_
+#define LUMOS_MATH_FILTERS_MEDIAN_FILTER_H_
+
+#include "lumos/math/filters/class_def/median_filter.h"
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace lumos
+{
+
+  template <typename T>
+  MedianFilter<T>::MedianFilter() : window_size_(1) {}
+
+  template <typename T>
+  MedianFilter<T>::MedianFilter(size_t window_size) : window_size_(window_size)
+  {
+    if (window_size == 0)
+    {
+      throw std::invalid_argument("Window size must be greater than 0");
+    }
+  }
+
+  template <typename T>
+  bool MedianFilter<T>::isOrdered(const T value)
+  {
+    if constexpr (std::is_floating_point_v<T>)
+    {
+      return !std::isnan(value);
+    }
+    else
+    {
+      return true;
+    }
+  }
+
+  template <typename T>
+  void MedianFilter<T>::insert(T value)
+  {
+    if (!isOrdered(value))
+    {
+      return;
+    }
+    if (lower_.empty() || !(*lower_.rbegin() < value))
+    {
+      lower_.insert(value);
+    }
+    else
+    {
+      upper_.insert(value);
+    }
+    rebalance();
+  }
+
+  template <typename T>
+  void MedianFilter<T>::erase(T value)
+  {
+    if (!isOrdered(value) || lower_.empty())
+    {
+      return;
+    }
+    // Every element of lower_ is <= every element of upper_, so a value not
+    // above the largest of lower_ is in lower_. A value equal to it may also
+    // be in upper_, either copy can go
+    std::multiset<T> &first = !(*lower_.rbegin() < value) ? lower_ : upper_;
+    std::multiset<T> &second = &first == &lower_ ? upper_ : lower_;
+    auto it = first.find(value);
+    if (it != first.end())
+    {
+      first.erase(it);
+    }
+    else
+    {
+      it = second.find(value);
+      if (it == second.end())
+      {
+        throw std::logic_error("MedianFilter: sample leaving the window is not in the order statistics");
+      }
+      second.erase(it);
+    }
+    rebalance();
+  }
+
+  template <typename T>
+  void MedianFilter<T>::rebalance()
+  {
+    if (lower_.size() > upper_.size() + 1)
+    {
+      const auto largest = std::prev(lower_.end());
+      upper_.insert(*largest);
+      lower_.erase(largest);
+    }
+    else if (upper_.size() > lower_.size())
+    {
+      const auto smallest = upper_.begin();
+      lower_.insert(*smallest);
+      upper_.erase(smallest);
+    }
+  }
+
+  template <typename T>
+  T MedianFilter<T>::filter(T input)
+  {
+    if (window_.size() == window_size_)
+    {
+      erase(window_.front());
+      window_.pop_front();
+    }
+
+    window_.push_back(input);
+    insert(input);
+
+    return median();
+  }
+
+  template <typename T>
+  std::vector<T> MedianFilter<T>::filter(const std::vector<T> &input)
+  {
+    std::vector<T> output(input.size());
+    filter(input.data(), output.data(), input.size());
+    return output;
+  }
+
+  template <typename T>
+  void MedianFilter<T>::filter(const T *input, T *output, size_t length)
+  {
+    for (size_t i = 0; i < length; ++i)
+    {
+      output[i] = filter(input[i]);
+    }
+  }
+
+  template <typename T>
+  void MedianFilter<T>::reset()
+  {
+    window_.clear();
+    lower_.clear();
+    upper_.clear();
+  }
+
+  template <typename T>
+  T MedianFilter<T>::median() const
+  {
+    if (lower_.empty())
+    {
+      if constexpr (std::is_floating_point_v<T>)
+      {
+        if (!window_.empty())
+        {
+          return std::numeric_limits<T>::quiet_NaN();
+        }
+      }
+      return T(0);
+    }
+    if (lower_.size() > upper_.size())
+    {
+      return *lower_.rbegin();
+    }
+    const T low = *lower_.rbegin();
+    const T high = *upper_.begin();
+    if constexpr (std::is_integral_v<T>)
+    {
+      // low + (high - low) / 2 without overflow, high - low is computed
+      // unsigned as it may not fit in T. Rounds down
+      using Unsigned = std::make_unsigned_t<T>;
+      const Unsigned half_difference =
+          static_cast<Unsigned>(static_cast<Unsigned>(high) - static_cast<Unsigned>(low)) / 2U;
+      return static_cast<T>(static_cast<Unsigned>(low) + half_difference);
+    }
+    else
+    {
+      return (low + high) / T(2);
+    }
+  }
+
+  template <typename T>
+  const std::deque<T> &MedianFilter<T>::getWindow() const
+  {
+    return window_;
+  }
+
+  template <typename T>
+  size_t MedianFilter<T>::getWindowSize() const { return window_size_; }
+
+  template <typename T>
+  T MedianFilter<T>::getGroupDelay() const
+  {
+    return T(window_size_ - 1) / T(2);
+  }
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_FILTERS_MEDIAN_FILTER_H_
@@ -0,0 +1,346 @@
+#ifndef LUMOS_MATH_FILTERS_POLYPHASE_RESAMPLER_H_
+#define LUMOS_MATH_FILTERS_POLYPHASE_RESAMPLER_H_
+
+#include "lumos/math/filters/class_def/polyphase_resampler.h"
+#include "lumos/math/filters/fir_filter.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace lumos
+{
+  namespace internal
+  {
+    // Splits the prototype h into up phases of taps_per_phase taps, scaled by
+    // up and reversed, see PolyphaseResampler::phases_
+    template <typename T>
+    std::vector<T> makePolyphaseBank(const std::vector<T> &h, const size_t up,
+                                     const size_t taps_per_phase)
+    {
+      std::vector<T> phases(up * taps_per_phase, T(0));
+      for (size_t p = 0; p < up; ++p)
+      {
+        for (size_t j = 0; j < taps_per_phase; ++j)
+        {
+          const size_t idx = p + (taps_per_phase - 1 - j) * up;
+          if (idx < h.size())
+          {
+            phases[p * taps_per_phase + j] = static_cast<T>(up) * h[idx];
+          }
+        }
+      }
+      return phases;
+    }
+
+    inline void reduceResamplingRatio(size_t &up, size_t &down)
+    {
+      if ((up == 0) || (down == 0))
+      {
+        throw std::invalid_argument("Resampling factors must be greater than 0");
+      }
+      const size_t divisor = std::gcd(up, down);
+      up /= divisor;
+      down /= divisor;
+    }
+
+    // Outputs of a resampler whose next output is delay input samples and
+    // phase upsampled samples ahead, over a chunk of length input samples
+    inline size_t numResamplerOutputs(const size_t length, const size_t up,
+                                      const size_t down, const size_t phase,
+                                      const size_t delay)
+    {
+      const size_t first = delay * up + phase;
+      const size_t end = length * up;
+      return first < end ? (end - first + down - 1) / down : 0;
+    }
+  } // namespace internal
+
+  // =============================================================================
+  // PolyphaseResampler
+  // =============================================================================
+
+  template <typename T>
+  PolyphaseResampler<T>::PolyphaseResampler()
+      : up_(1), down_(1), taps_per_phase_(1), num_prototype_taps_(1),
+        phases_(1, T(1)), history_(2, T(0)), pos_(0), phase_(0), delay_(0) {}
+
+  template <typename T>
+  PolyphaseResampler<T>::PolyphaseResampler(size_t up, size_t down,
+                                            const FIRFilter<T> &prototype)
+  {
+    if (prototype.isEmpty())
+    {
+      throw std::invalid_argument("Prototype filter must have coefficients");
+    }
+    internal::reduceResamplingRatio(up, down);
+
+    up_ = up;
+    down_ = down;
+    num_prototype_taps_ = prototype.getNumCoefficients();
+    taps_per_phase_ = (num_prototype_taps_ + up - 1) / up;
+    phases_ = internal::makePolyphaseBank(prototype.getCoefficients(), up,
+                                          taps_per_phase_);
+    history_.assign(2 * taps_per_phase_, T(0));
+    reset();
+  }
+
+  template <typename T>
+  PolyphaseResampler<T>::PolyphaseResampler(size_t up, size_t down,
+                                            size_t half_length)
+      : PolyphaseResampler(up, down, designLowPass(up, down, half_length)) {}
+
+  template <typename T>
+  void PolyphaseResampler<T>::push(T sample)
+  {
+    pos_ = pos_ + 1 == taps_per_phase_ ? 0 : pos_ + 1;
+    history_[pos_] = sample;
+    history_[pos_ + taps_per_phase_] = sample;
+  }
+
+  template <typename T>
+  T PolyphaseResampler<T>::computeOutput() const
+  {
+    const T *const coeffs = phases_.data() + phase_ * taps_per_phase_;
+    const T *const window = history_.data() + pos_ + 1;
+
+    T output = T(0);
+    for (size_t j = 0; j < taps_per_phase_; ++j)
+    {
+      output += coeffs[j] * window[j];
+    }
+    return output;
+  }
+
+  template <typename T>
+  size_t PolyphaseResampler<T>::process(const T *input, size_t length,
+                                        T *output)
+  {
+    size_t num_outputs = 0;
+
+    for (size_t i = 0; i < length; ++i)
+    {
+      push(input[i]);
+
+      // Samples between two kept outputs only go into the history
+      while (delay_ == 0)
+      {
+        output[num_outputs++] = computeOutput();
+        phase_ += down_;
+        delay_ = phase_ / up_;
+        phase_ %= up_;
+      }
+      --delay_;
+    }
+
+    return num_outputs;
+  }
+
+  template <typename T>
+  std::vector<T> PolyphaseResampler<T>::process(const std::vector<T> &input)
+  {
+    std::vector<T> output(maxOutputSize(input.size()));
+    output.resize(process(input.data(), input.size(), output.data()));
+    return output;
+  }
+
+  template <typename T>
+  size_t PolyphaseResampler<T>::maxOutputSize(size_t length) const
+  {
+    return internal::numResamplerOutputs(length, up_, down_, phase_, delay_);
+  }
+
+  template <typename T>
+  void PolyphaseResampler<T>::reset()
+  {
+    std::fill(history_.begin(), history_.end(), T(0));
+    pos_ = 0;
+    phase_ = 0;
+    delay_ = 0;
+  }
+
+  template <typename T>
+  size_t PolyphaseResampler<T>::getUpFactor() const { return up_; }
+
+  template <typename T>
+  size_t PolyphaseResampler<T>::getDownFactor() const { return down_; }
+
+  template <typename T>
+  size_t PolyphaseResampler<T>::getTapsPerPhase() const
+  {
+    return taps_per_phase_;
+  }
+
+  template <typename T>
+  T PolyphaseResampler<T>::getGroupDelay() const
+  {
+    return T(num_prototype_taps_ - 1) / T(2 * down_);
+  }
+
+  template <typename T>
+  FIRFilter<T> PolyphaseResampler<T>::designLowPass(size_t up, size_t down,
+                                                    size_t half_length)
+  {
+    if (half_length == 0)
+    {
+      throw std::invalid_argument("Filter half length must be greater than 0");
+    }
+    internal::reduceResamplingRatio(up, down);
+
+    const size_t max_rate = std::max(up, down);
+    const size_t order = 2 * half_length * max_rate;
+    std::vector<T> coeffs =
+        FIRFilter<T>::lowPass(order, T(0.5) / T(max_rate), T(1)).getCoefficients();
+
+    // The plain windowed sinc only reaches about -21 dB in the stop band,
+    // a Blackman window brings that to about -74 dB
+    T sum = T(0);
+    for (size_t n = 0; n <= order; ++n)
+    {
+      const T phase = T(2 * M_PI) * T(n) / T(order);
+      coeffs[n] *= T(0.42) - T(0.5) * std::cos(phase) + T(0.08) * std::cos(T(2) * phase);
+      sum += coeffs[n];
+    }
+
+    for (T &c : coeffs)
+    {
+      c /= sum;
+    }
+
+    return FIRFilter<T>(coeffs);
+  }
+
+  template <typename T>
+  PolyphaseResampler<T> PolyphaseResampler<T>::decimator(size_t factor,
+                                                         size_t half_length)
+  {
+    return PolyphaseResampler<T>(1, factor, half_length);
+  }
+
+  template <typename T>
+  PolyphaseResampler<T> PolyphaseResampler<T>::interpolator(size_t factor,
+                                                            size_t half_length)
+  {
+    return PolyphaseResampler<T>(factor, 1, half_length);
+  }
+
+  // =============================================================================
+  // MultiChannelPolyphaseResampler
+  // =============================================================================
+
+  template <typename T>
+  MultiChannelPolyphaseResampler<T>::MultiChannelPolyphaseResampler()
+      : num_channels_(0), up_(1), down_(1), taps_per_phase_(1),
+        num_prototype_taps_(1), phases_(1, T(1)), pos_(0), phase_(0),
+        delay_(0) {}
+
+  template <typename T>
+  MultiChannelPolyphaseResampler<T>::MultiChannelPolyphaseResampler(
+      size_t num_channels, size_t up, size_t down, const FIRFilter<T> &prototype)
+  {
+    if (num_channels == 0)
+    {
+      throw std::invalid_argument("Number of channels must be greater than 0");
+    }
+    if (prototype.isEmpty())
+    {
+      throw std::invalid_argument("Prototype filter must have coefficients");
+    }
+    internal::reduceResamplingRatio(up, down);
+
+    num_channels_ = num_channels;
+    up_ = up;
+    down_ = down;
+    num_prototype_taps_ = prototype.getNumCoefficients();
+    taps_per_phase_ = (num_prototype_taps_ + up - 1) / up;
+    phases_ = internal::makePolyphaseBank(prototype.getCoefficients(), up,
+                                          taps_per_phase_);
+    history_.assign(2 * taps_per_phase_ * num_channels, T(0));
+    reset();
+  }
+
+  template <typename T>
+  MultiChannelPolyphaseResampler<T>::MultiChannelPolyphaseResampler(
+      size_t num_channels, size_t up, size_t down, size_t half_length)
+      : MultiChannelPolyphaseResampler(
+            num_channels, up, down,
+            PolyphaseResampler<T>::designLowPass(up, down, half_length)) {}
+
+  template <typename T>
+  size_t MultiChannelPolyphaseResampler<T>::processInterleaved(const T *input,
+                                                               size_t num_frames,
+                                                               T *output)
+  {
+    const size_t num_channels = num_channels_;
+    const size_t taps = taps_per_phase_;
+    size_t num_outputs = 0;
+
+    for (size_t i = 0; i < num_frames; ++i)
+    {
+      pos_ = pos_ + 1 == taps ? 0 : pos_ + 1;
+      const T *const frame = input + i * num_channels;
+      std::copy(frame, frame + num_channels, history_.data() + pos_ * num_channels);
+      std::copy(frame, frame + num_channels,
+                history_.data() + (pos_ + taps) * num_channels);
+
+      while (delay_ == 0)
+      {
+        const T *const coeffs = phases_.data() + phase_ * taps;
+        const T *const window = history_.data() + (pos_ + 1) * num_channels;
+        T *const out = output + num_outputs * num_channels;
+
+        std::fill(out, out + num_channels, T(0));
+        for (size_t j = 0; j < taps; ++j)
+        {
+          const T coeff = coeffs[j];
+          const T *const samples = window + j * num_channels;
+          for (size_t c = 0; c < num_channels; ++c)
+          {
+            out[c] += coeff * samples[c];
+          }
+        }
+        ++num_outputs;
+
+        phase_ += down_;
+        delay_ = phase_ / up_;
+        phase_ %= up_;
+      }
+      --delay_;
+    }
+
+    return num_outputs;
+  }
+
+  template <typename T>
+  size_t MultiChannelPolyphaseResampler<T>::maxOutputFrames(size_t num_frames) const
+  {
+    return internal::numResamplerOutputs(num_frames, up_, down_, phase_, delay_);
+  }
+
+  template <typename T>
+  void MultiChannelPolyphaseResampler<T>::reset()
+  {
+    std::fill(history_.begin(), history_.end(), T(0));
+    pos_ = 0;
+    phase_ = 0;
+    delay_ = 0;
+  }
+
+  template <typename T>
+  size_t MultiChannelPolyphaseResampler<T>::getNumChannels() const
+  {
+    return num_channels_;
+  }
+
+  template <typename T>
+  size_t MultiChannelPolyphaseResampler<T>::getUpFactor() const { return up_; }
+
+  template <typename T>
+  size_t MultiChannelPolyphaseResampler<T>::getDownFactor() const
+  {
+    return down_;
+  }
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_FILTERS_POLYPHASE_RESAMPLER_H_
@@ -0,0 +1,203 @@
+#ifndef LUMOS_MATH_FILTERS_SAVITZKY_GOLAY_FILTER_H_
+#define LUMOS_MATH_FILTERS_SAVITZKY_GOLAY_FILTER_H_
+
+#include "lumos/math/filters/class_def/savitzky_golay_filter.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace lumos
+{
+
+  template <typename T>
+  SavitzkyGolayFilter<T>::SavitzkyGolayFilter()
+      : window_size_(1), poly_order_(0), derivative_(0), coefficients_(1, T(1)),
+        history_(2, T(0)), pos_(0), is_empty_(true) {}
+
+  template <typename T>
+  SavitzkyGolayFilter<T>::SavitzkyGolayFilter(size_t window_size,
+                                              size_t poly_order,
+                                              size_t derivative,
+                                              T sample_period)
+      : window_size_(window_size), poly_order_(poly_order),
+        derivative_(derivative),
+        coefficients_(computeCoefficients(window_size, poly_order, derivative,
+                                          sample_period)),
+        history_(2 * window_size, T(0)), pos_(0), is_empty_(true) {}
+
+  template <typename T>
+  T SavitzkyGolayFilter<T>::filter(T input)
+  {
+    if (is_empty_)
+    {
+      std::fill(history_.begin(), history_.end(), input);
+      is_empty_ = false;
+    }
+
+    pos_ = pos_ + 1 == window_size_ ? 0 : pos_ + 1;
+    history_[pos_] = input;
+    history_[pos_ + window_size_] = input;
+
+    const T *const window = history_.data() + pos_ + 1;
+    T output = T(0);
+    for (size_t i = 0; i < window_size_; ++i)
+    {
+      output += coefficients_[i] * window[i];
+    }
+    return output;
+  }
+
+  template <typename T>
+  std::vector<T> SavitzkyGolayFilter<T>::filter(const std::vector<T> &input)
+  {
+    std::vector<T> output(input.size());
+    filter(input.data(), output.data(), input.size());
+    return output;
+  }
+
+  template <typename T>
+  void SavitzkyGolayFilter<T>::filter(const T *input, T *output, size_t length)
+  {
+    for (size_t i = 0; i < length; ++i)
+    {
+      output[i] = filter(input[i]);
+    }
+  }
+
+  template <typename T>
+  void SavitzkyGolayFilter<T>::reset()
+  {
+    std::fill(history_.begin(), history_.end(), T(0));
+    pos_ = 0;
+    is_empty_ = true;
+  }
+
+  template <typename T>
+  const std::vector<T> &SavitzkyGolayFilter<T>::getCoefficients() const
+  {
+    return coefficients_;
+  }
+
+  template <typename T>
+  size_t SavitzkyGolayFilter<T>::getWindowSize() const { return window_size_; }
+
+  template <typename T>
+  size_t SavitzkyGolayFilter<T>::getPolyOrder() const { return poly_order_; }
+
+  template <typename T>
+  size_t SavitzkyGolayFilter<T>::getDerivative() const { return derivative_; }
+
+  template <typename T>
+  T SavitzkyGolayFilter<T>::getGroupDelay() const
+  {
+    return T(window_size_ - 1) / T(2);
+  }
+
+  template <typename T>
+  std::vector<T> SavitzkyGolayFilter<T>::computeCoefficients(size_t window_size,
+                                                             size_t poly_order,
+                                                             size_t derivative,
+                                                             T sample_period)
+  {
+    if ((window_size % 2 == 0) || (window_size <= poly_order))
+    {
+      throw std::invalid_argument(
+          "Window size must be odd and larger than the polynomial order");
+    }
+    if (derivative > poly_order)
+    {
+      throw std::invalid_argument(
+          "Derivative order must not exceed the polynomial order");
+    }
+    if (!(sample_period > T(0)))
+    {
+      throw std::invalid_argument("Sample period must be positive");
+    }
+
+    const size_t half = (window_size - 1) / 2;
+    const size_t num_terms = poly_order + 1;
+    // Sample positions are scaled to [-1, 1] to keep the normal equations
+    // well conditioned
+    const double scale = half > 0 ? static_cast<double>(half) : 1.0;
+
+    std::vector<std::vector<double>> powers(window_size,
+                                            std::vector<double>(num_terms));
+    for (size_t i = 0; i < window_size; ++i)
+    {
+      const double x = (static_cast<double>(i) - static_cast<double>(half)) / scale;
+      double power = 1.0;
+      for (size_t j = 0; j < num_terms; ++j)
+      {
+        powers[i][j] = power;
+        power *= x;
+      }
+    }
+
+    // Normal equations A^T A z = e_derivative, augmented with the right hand side
+    std::vector<std::vector<double>> system(num_terms,
+                                            std::vector<double>(num_terms + 1, 0.0));
+    for (size_t j = 0; j < num_terms; ++j)
+    {
+      for (size_t k = 0; k < num_terms; ++k)
+      {
+        for (size_t i = 0; i < window_size; ++i)
+        {
+          system[j][k] += powers[i][j] * powers[i][k];
+        }
+      }
+      system[j][num_terms] = j == derivative ? 1.0 : 0.0;
+    }
+
+    // Gauss-Jordan elimination with partial pivoting
+    for (size_t col = 0; col < num_terms; ++col)
+    {
+      size_t pivot = col;
+      for (size_t row = col + 1; row < num_terms; ++row)
+      {
+        if (std::abs(system[row][col]) > std::abs(system[pivot][col]))
+        {
+          pivot = row;
+        }
+      }
+      std::swap(system[col], system[pivot]);
+
+      for (size_t row = 0; row < num_terms; ++row)
+      {
+        if (row != col)
+        {
+          const double factor = system[row][col] / system[col][col];
+          for (size_t k = col; k <= num_terms; ++k)
+          {
+            system[row][k] -= factor * system[col][k];
+          }
+        }
+      }
+    }
+
+    // d-th derivative of the fit at the center is d! * a_d, scaled back from
+    // the normalized positions to samples and then to time
+    double derivative_scale = 1.0;
+    for (size_t k = 2; k <= derivative; ++k)
+    {
+      derivative_scale *= static_cast<double>(k);
+    }
+    derivative_scale /= std::pow(scale * static_cast<double>(sample_period),
+                                 static_cast<double>(derivative));
+
+    std::vector<T> coefficients(window_size);
+    for (size_t i = 0; i < window_size; ++i)
+    {
+      double c = 0.0;
+      for (size_t j = 0; j < num_terms; ++j)
+      {
+        c += powers[i][j] * system[j][num_terms] / system[j][j];
+      }
+      coefficients[i] = static_cast<T>(derivative_scale * c);
+    }
+
+    return coefficients;
+  }
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_FILTERS_SAVITZKY_GOLAY_FILTER_H_
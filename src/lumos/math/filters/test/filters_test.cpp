@@ -1,7 +1,9 @@
 #include <algorithm>
 #include <cmath>
 #include <complex>
+#include <cstdint>
 #include <gtest/gtest.h>
+#include <limits>
 #include <sstream>
 #include <vector>
 
@@ -988,4 +990,774 @@ namespace lumos
     EXPECT_NEAR(output, 1e-10 * 1e10, 1e-15); // Should be 1.0
   }
 
+  // =============================================================================
+  // POLYPHASE RESAMPLER TESTS
+  // =============================================================================
+
+  namespace
+  {
+    // Reference resampler: zero insertion, full rate filtering, decimation
+    std::vector<double> naiveResample(const std::vector<double> &input,
+                                      const size_t up, const size_t down,
+                                      const std::vector<double> &h)
+    {
+      std::vector<double> scaled(h);
+      for (double &c : scaled)
+      {
+        c *= static_cast<double>(up);
+      }
+      FIRFilter<double> filter(scaled);
+
+      std::vector<double> output;
+      for (size_t i = 0; i < input.size() * up; ++i)
+      {
+        const double y = filter.filter(i % up == 0 ? input[i / up] : 0.0);
+        if (i % down == 0)
+        {
+          output.push_back(y);
+        }
+      }
+      return output;
+    }
+
+    std::vector<double> makeTestSignal(const size_t length)
+    {
+      std::vector<double> signal(length);
+      for (size_t i = 0; i < length; ++i)
+      {
+        signal[i] = std::sin(0.05 * static_cast<double>(i)) +
+                    0.3 * std::cos(0.71 * static_cast<double>(i) + 0.2);
+      }
+      return signal;
+    }
+  } // namespace
+
+  TEST(PolyphaseResamplerTest, MatchesNaiveResampling)
+  {
+    const std::vector<double> input = makeTestSignal(300);
+
+    for (const auto &ratio : {std::make_pair<size_t, size_t>(2, 5), std::make_pair<size_t, size_t>(1, 4),
+                              std::make_pair<size_t, size_t>(3, 1), std::make_pair<size_t, size_t>(5, 3)})
+    {
+      const FIRFilter<double> prototype =
+          PolyphaseResampler<double>::designLowPass(ratio.first, ratio.second, 4);
+      PolyphaseResampler<double> resampler(ratio.first, ratio.second, prototype);
+
+      const std::vector<double> expected =
+          naiveResample(input, ratio.first, ratio.second, prototype.getCoefficients());
+      const std::vector<double> output = resampler.process(input);
+
+      ASSERT_EQ(output.size(), expected.size()) << ratio.first << "/" << ratio.second;
+      for (size_t i = 0; i < output.size(); ++i)
+      {
+        EXPECT_NEAR(output[i], expected[i], 1e-12);
+      }
+    }
+  }
+
+  TEST(PolyphaseResamplerTest, ReducesRatio)
+  {
+    // 1 kHz to 400 Hz
+    PolyphaseResampler<double> resampler(400, 1000);
+    EXPECT_EQ(resampler.getUpFactor(), 2U);
+    EXPECT_EQ(resampler.getDownFactor(), 5U);
+    EXPECT_EQ(resampler.maxOutputSize(1000), 400U);
+
+    EXPECT_THROW(PolyphaseResampler<double>(0, 2), std::invalid_argument);
+    EXPECT_THROW(PolyphaseResampler<double>(1, 2, 0), std::invalid_argument);
+  }
+
+  TEST(PolyphaseResamplerTest, StreamingMatchesOneShot)
+  {
+    const std::vector<double> input = makeTestSignal(1000);
+
+    PolyphaseResampler<double> one_shot(2, 5);
+    const std::vector<double> expected = one_shot.process(input);
+
+    PolyphaseResampler<double> streaming(2, 5);
+    std::vector<double> output;
+    size_t offset = 0;
+    size_t chunk = 1;
+    while (offset < input.size())
+    {
+      const size_t length = std::min(chunk, input.size() - offset);
+      std::vector<double> buffer(streaming.maxOutputSize(length));
+      const size_t n = streaming.process(input.data() + offset, length, buffer.data());
+      EXPECT_EQ(n, buffer.size());
+      output.insert(output.end(), buffer.begin(), buffer.begin() + n);
+
+      offset += length;
+      chunk = chunk * 3 % 37 + 1;
+    }
+
+    ASSERT_EQ(output.size(), expected.size());
+    for (size_t i = 0; i < output.size(); ++i)
+    {
+      EXPECT_DOUBLE_EQ(output[i], expected[i]);
+    }
+
+    streaming.reset();
+    const std::vector<double> after_reset = streaming.process(input);
+    ASSERT_EQ(after_reset.size(), expected.size());
+    EXPECT_DOUBLE_EQ(after_reset.back(), expected.back());
+  }
+
+  TEST(PolyphaseResamplerTest, PassesLowAndRejectsHighFrequencies)
+  {
+    const double input_rate = 1000.0;
+    PolyphaseResampler<double> low_resampler(2, 5);
+    PolyphaseResampler<double> high_resampler(2, 5);
+
+    // 20 Hz is kept, 350 Hz is above the 200 Hz Nyquist frequency of 400 Hz
+    std::vector<double> low(4000);
+    std::vector<double> high(4000);
+    for (size_t i = 0; i < low.size(); ++i)
+    {
+      const double t = static_cast<double>(i) / input_rate;
+      low[i] = std::sin(2.0 * M_PI * 20.0 * t);
+      high[i] = std::sin(2.0 * M_PI * 350.0 * t);
+    }
+
+    const std::vector<double> low_out = low_resampler.process(low);
+    const std::vector<double> high_out = high_resampler.process(high);
+    ASSERT_EQ(low_out.size(), 1600U);
+
+    // Output n is at input time (n * 5 - delay * 5) / 2 samples
+    const double delay = low_resampler.getGroupDelay();
+    double max_error = 0.0;
+    double max_high = 0.0;
+    for (size_t n = 100; n < low_out.size(); ++n)
+    {
+      const double t = (static_cast<double>(n) - delay) * 5.0 / 2.0 / input_rate;
+      max_error = std::max(max_error, std::abs(low_out[n] - std::sin(2.0 * M_PI * 20.0 * t)));
+      max_high = std::max(max_high, std::abs(high_out[n]));
+    }
+    EXPECT_LT(max_error, 1e-3);
+    EXPECT_LT(max_high, 1e-3);
+  }
+
+  TEST(PolyphaseResamplerTest, DecimatorAndInterpolator)
+  {
+    const std::vector<double> input = makeTestSignal(400);
+
+    PolyphaseResampler<double> decimator = PolyphaseResampler<double>::decimator(4);
+    EXPECT_EQ(decimator.getTapsPerPhase(), 81U);
+    EXPECT_EQ(decimator.process(input).size(), 100U);
+
+    PolyphaseResampler<float> interpolator = PolyphaseResampler<float>::interpolator(3);
+    const std::vector<float> input_f(input.begin(), input.end());
+    const std::vector<float> output = interpolator.process(input_f);
+    ASSERT_EQ(output.size(), 1200U);
+
+    // Every third output of an interpolator is a delayed input sample, up to
+    // the filter's passband error
+    const size_t delay = static_cast<size_t>(interpolator.getGroupDelay());
+    for (size_t n = 60; n + delay < output.size(); n += 3)
+    {
+      EXPECT_NEAR(output[n + delay], input_f[n / 3], 2e-3);
+    }
+  }
+
+  TEST(PolyphaseResamplerTest, MultiChannelMatchesSingleChannel)
+  {
+    constexpr size_t kNumChannels = 5;
+    constexpr size_t kNumFrames = 700;
+
+    std::vector<std::vector<double>> channels(kNumChannels);
+    std::vector<double> interleaved(kNumChannels * kNumFrames);
+    for (size_t c = 0; c < kNumChannels; ++c)
+    {
+      channels[c] = makeTestSignal(kNumFrames + c * 13);
+      channels[c].erase(channels[c].begin(), channels[c].begin() + c * 13);
+      for (size_t i = 0; i < kNumFrames; ++i)
+      {
+        interleaved[i * kNumChannels + c] = channels[c][i];
+      }
+    }
+
+    MultiChannelPolyphaseResampler<double> resampler(kNumChannels, 2, 5);
+    EXPECT_EQ(resampler.getNumChannels(), kNumChannels);
+
+    // Two chunks to exercise the streaming state
+    std::vector<double> output(kNumChannels * (resampler.maxOutputFrames(kNumFrames) + 1));
+    const size_t first = resampler.processInterleaved(interleaved.data(), 333, output.data());
+    const size_t second = resampler.processInterleaved(interleaved.data() + 333 * kNumChannels,
+                                                       kNumFrames - 333,
+                                                       output.data() + first * kNumChannels);
+
+    for (size_t c = 0; c < kNumChannels; ++c)
+    {
+      PolyphaseResampler<double> single(2, 5);
+      const std::vector<double> expected = single.process(channels[c]);
+      ASSERT_EQ(first + second, expected.size());
+      for (size_t n = 0; n < expected.size(); ++n)
+      {
+        EXPECT_NEAR(output[n * kNumChannels + c], expected[n], 1e-12);
+      }
+    }
+  }
+
+  // =============================================================================
+  // FILTFILT AND BLOCK-PARALLEL FILTERING TESTS
+  // =============================================================================
+
+  TEST(FiltfiltTest, ConstantSignalHasNoTransient)
+  {
+    const std::vector<double> input(200, 3.0);
+
+    // Unity DC gain, so the output equals the input everywhere
+    const std::vector<double> iir_output =
+        filtfilt(IIRFilter<double>::secondOrderLowPass(50.0, 0.707, 1000.0), input);
+    const std::vector<double> fir_output =
+        filtfilt(FIRFilter<double>::movingAverage(7), input);
+
+    ASSERT_EQ(iir_output.size(), input.size());
+    ASSERT_EQ(fir_output.size(), input.size());
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+      EXPECT_NEAR(iir_output[i], 3.0, 1e-9);
+      EXPECT_NEAR(fir_output[i], 3.0, 1e-12);
+    }
+  }
+
+  TEST(FiltfiltTest, ZeroPhase)
+  {
+    const double sample_rate = 1000.0;
+    const IIRFilter<double> lpf = IIRFilter<double>::secondOrderLowPass(100.0, 0.707, sample_rate);
+
+    std::vector<double> input(2000);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+      input[i] = std::sin(2.0 * M_PI * 5.0 * static_cast<double>(i) / sample_rate);
+    }
+
+    // A one-way filter delays the 5 Hz tone, filtfilt does not
+    IIRFilter<double> one_way(lpf);
+    const std::vector<double> forward_only = one_way.filter(input);
+    const std::vector<double> output = filtfilt(lpf, input);
+
+    double max_error = 0.0;
+    double max_forward_error = 0.0;
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+      max_error = std::max(max_error, std::abs(output[i] - input[i]));
+      if (i > 200)
+      {
+        max_forward_error = std::max(max_forward_error, std::abs(forward_only[i] - input[i]));
+      }
+    }
+    EXPECT_LT(max_error, 1e-3);
+    EXPECT_GT(max_forward_error, 1e-2);
+  }
+
+  TEST(FiltfiltTest, FIRInteriorIsAutocorrelationFilter)
+  {
+    std::vector<double> input(300);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+      input[i] = std::sin(0.07 * static_cast<double>(i)) + 0.01 * static_cast<double>(i);
+    }
+
+    // Forward-backward filtering with h is filtering with the symmetric
+    // autocorrelation r[k] = sum_n h[n] * h[n + k]
+    const std::vector<double> h = {0.1, 0.3, 0.4, 0.15, 0.05};
+    const int num_taps = static_cast<int>(h.size());
+    const std::vector<double> output = filtfilt(FIRFilter<double>(h), input);
+
+    for (int n = num_taps; n + num_taps < static_cast<int>(input.size()); ++n)
+    {
+      double expected = 0.0;
+      for (int k = -(num_taps - 1); k < num_taps; ++k)
+      {
+        double r = 0.0;
+        for (int m = 0; m < num_taps; ++m)
+        {
+          if ((m + std::abs(k) >= 0) && (m + std::abs(k) < num_taps))
+          {
+            r += h[m] * h[m + std::abs(k)];
+          }
+        }
+        expected += r * input[n + k];
+      }
+      EXPECT_NEAR(output[n], expected, 1e-12);
+    }
+  }
+
+  TEST(FiltfiltTest, ShortSignals)
+  {
+    const FIRFilter<double> fir = FIRFilter<double>::movingAverage(5);
+    EXPECT_TRUE(filtfilt(fir, std::vector<double>()).empty());
+
+    const std::vector<double> single = filtfilt(fir, std::vector<double>{2.5});
+    ASSERT_EQ(single.size(), 1U);
+    EXPECT_NEAR(single[0], 2.5, 1e-12);
+
+    EXPECT_EQ(filtfilt(fir, std::vector<double>{1.0, 2.0, 3.0}, 100).size(), 3U);
+  }
+
+  TEST(FiltfiltTest, FilterParallelMatchesSequential)
+  {
+    std::vector<double> input(10007);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+      input[i] = std::sin(0.013 * static_cast<double>(i)) + 0.2 * std::cos(1.1 * static_cast<double>(i));
+    }
+
+    FIRFilter<double> fir = FIRFilter<double>::lowPass(30, 50.0, 1000.0);
+    const std::vector<double> fir_parallel = filterParallel(fir, input, 1000, 4);
+    const std::vector<double> fir_sequential = fir.filter(input);
+    ASSERT_EQ(fir_parallel.size(), input.size());
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+      EXPECT_NEAR(fir_parallel[i], fir_sequential[i], 1e-12);
+    }
+
+    // Poles well inside the unit circle, 400 samples of warm-up are plenty
+    IIRFilter<double> iir = IIRFilter<double>::secondOrderLowPass(50.0, 0.707, 1000.0);
+    const std::vector<double> iir_parallel = filterParallel(iir, input, 1000, 400, 4);
+    const std::vector<double> iir_sequential = iir.filter(input);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+      EXPECT_NEAR(iir_parallel[i], iir_sequential[i], 1e-9);
+    }
+
+    EXPECT_THROW(filterParallel(fir, input, 0), std::invalid_argument);
+  }
+
+  TEST(FiltfiltTest, FiltfiltParallelMatchesFiltfilt)
+  {
+    std::vector<double> input(8191);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+      input[i] = std::sin(0.021 * static_cast<double>(i)) + 0.5 * std::sin(0.9 * static_cast<double>(i)) +
+                 0.001 * static_cast<double>(i);
+    }
+
+    const FIRFilter<double> fir = FIRFilter<double>::lowPass(40, 80.0, 1000.0);
+    const std::vector<double> fir_expected = filtfilt(fir, input);
+    const std::vector<double> fir_parallel = filtfiltParallel(fir, input, 500, 4);
+    ASSERT_EQ(fir_parallel.size(), input.size());
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+      EXPECT_NEAR(fir_parallel[i], fir_expected[i], 1e-10);
+    }
+
+    const IIRFilter<double> iir = IIRFilter<double>::secondOrderLowPass(40.0, 0.707, 1000.0);
+    const std::vector<double> iir_expected = filtfilt(iir, input);
+    const std::vector<double> iir_parallel = filtfiltParallel(iir, input, 700, 500, 3);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+      EXPECT_NEAR(iir_parallel[i], iir_expected[i], 1e-8);
+    }
+  }
+
+  TEST(MedianFilterTest, MatchesSortedWindow)
+  {
+    std::vector<double> input(300);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+      // Few distinct values, so the window is full of duplicates
+      input[i] = static_cast<double>((i * 37 + 11) % 13) - 6.0;
+    }
+
+    for (const size_t window_size : {1U, 6U, 7U})
+    {
+      MedianFilter<double> filter(window_size);
+      const std::vector<double> output = filter.filter(input);
+      ASSERT_EQ(output.size(), input.size());
+
+      for (size_t i = 0; i < input.size(); ++i)
+      {
+        const size_t begin = i + 1 >= window_size ? i + 1 - window_size : 0;
+        std::vector<double> window(input.begin() + begin, input.begin() + i + 1);
+        std::sort(window.begin(), window.end());
+        const size_t n = window.size();
+        const double expected = n % 2 == 1 ? window[n / 2] : 0.5 * (window[n / 2 - 1] + window[n / 2]);
+        EXPECT_DOUBLE_EQ(output[i], expected) << "window " << window_size << ", sample " << i;
+      }
+    }
+
+    MedianFilter<double> filter(3);
+    filter.filter(5.0);
+    filter.reset();
+    EXPECT_TRUE(filter.getWindow().empty());
+    EXPECT_DOUBLE_EQ(filter.filter(2.0), 2.0);
+    EXPECT_THROW(MedianFilter<double>(0), std::invalid_argument);
+  }
+
+  TEST(MedianFilterTest, IgnoresNanSamples)
+  {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+    std::vector<double> input(200);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+      input[i] = static_cast<double>((i * 29 + 5) % 17) - 8.0;
+    }
+    input[20] = nan;
+    input[21] = inf;
+    input[60] = -inf;
+    input[100] = nan;
+    input[101] = nan;
+    input[102] = nan;
+    input[103] = nan;
+    input[104] = nan;
+
+    MedianFilter<double> filter(5);
+    const std::vector<double> output = filter.filter(input);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+      const size_t begin = i + 1 >= 5 ? i + 1 - 5 : 0;
+      std::vector<double> window;
+      for (size_t j = begin; j <= i; ++j)
+      {
+        if (!std::isnan(input[j]))
+        {
+          window.push_back(input[j]);
+        }
+      }
+      if (window.empty())
+      {
+        EXPECT_TRUE(std::isnan(output[i])) << "sample " << i;
+        continue;
+      }
+      std::sort(window.begin(), window.end());
+      const size_t n = window.size();
+      const double expected = n % 2 == 1 ? window[n / 2] : 0.5 * (window[n / 2 - 1] + window[n / 2]);
+      if (std::isinf(expected))
+      {
+        EXPECT_EQ(output[i], expected) << "sample " << i;
+      }
+      else
+      {
+        EXPECT_DOUBLE_EQ(output[i], expected) << "sample " << i;
+      }
+    }
+  }
+
+  TEST(MedianFilterTest, SaturatedSamplesGiveInfiniteMedian)
+  {
+    const double inf = std::numeric_limits<double>::infinity();
+    MedianFilter<double> filter(3);
+    filter.filter(1.0);
+    filter.filter(inf);
+    EXPECT_EQ(filter.filter(inf), inf);
+    EXPECT_EQ(filter.filter(-inf), inf);
+    EXPECT_EQ(filter.filter(-inf), -inf);
+  }
+
+  TEST(MedianFilterTest, IntegerMeanOfMiddleValuesDoesNotOverflow)
+  {
+    const int32_t max = std::numeric_limits<int32_t>::max();
+    const int32_t min = std::numeric_limits<int32_t>::min();
+
+    MedianFilter<int32_t> high(2);
+    high.filter(max);
+    EXPECT_EQ(high.filter(max - 2), max - 1);
+
+    MedianFilter<int32_t> spread(2);
+    spread.filter(min);
+    EXPECT_EQ(spread.filter(max), -1);
+
+    MedianFilter<uint8_t> bytes(4);
+    const std::vector<uint8_t> output = bytes.filter(std::vector<uint8_t>{250, 254, 200, 255});
+    EXPECT_EQ(output[1], 252);
+    EXPECT_EQ(output[3], 252);
+  }
+
+  TEST(SavitzkyGolayFilterTest, ClassicCoefficients)
+  {
+    // Tabulated quadratic smoothing weights for 5 points, (-3, 12, 17, 12, -3) / 35
+    const std::vector<double> smooth = SavitzkyGolayFilter<double>::computeCoefficients(5, 2);
+    const double expected_smooth[] = {-3.0, 12.0, 17.0, 12.0, -3.0};
+    ASSERT_EQ(smooth.size(), 5U);
+    for (size_t i = 0; i < 5; ++i)
+    {
+      EXPECT_NEAR(smooth[i], expected_smooth[i] / 35.0, 1e-12);
+    }
+
+    // First derivative weights for 5 points, (-2, -1, 0, 1, 2) / 10
+    const std::vector<double> slope = SavitzkyGolayFilter<double>::computeCoefficients(5, 2, 1);
+    for (size_t i = 0; i < 5; ++i)
+    {
+      EXPECT_NEAR(slope[i], (static_cast<double>(i) - 2.0) / 10.0, 1e-12);
+    }
+
+    EXPECT_THROW(SavitzkyGolayFilter<double>(4, 2), std::invalid_argument);
+    EXPECT_THROW(SavitzkyGolayFilter<double>(5, 5), std::invalid_argument);
+    EXPECT_THROW(SavitzkyGolayFilter<double>(5, 2, 3), std::invalid_argument);
+  }
+
+  TEST(SavitzkyGolayFilterTest, ReproducesPolynomialsWithDelay)
+  {
+    const double dt = 0.01;
+    const auto position = [](const double t) { return 1.0 - 2.0 * t + 3.0 * t * t - 0.5 * t * t * t; };
+    const auto velocity = [](const double t) { return -2.0 + 6.0 * t - 1.5 * t * t; };
+
+    std::vector<double> input(200);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+      input[i] = position(static_cast<double>(i) * dt);
+    }
+
+    SavitzkyGolayFilter<double> smoother(21, 3);
+    SavitzkyGolayFilter<double> differentiator(21, 3, 1, dt);
+    EXPECT_DOUBLE_EQ(smoother.getGroupDelay(), 10.0);
+
+    std::vector<double> smoothed(input.size());
+    smoother.filter(input.data(), smoothed.data(), input.size());
+    const std::vector<double> slope = differentiator.filter(input);
+
+    // Once the window is full, a cubic is reproduced exactly, 10 samples late
+    for (size_t i = 20; i < input.size(); ++i)
+    {
+      const double t = static_cast<double>(i - 10) * dt;
+      EXPECT_NEAR(smoothed[i], position(t), 1e-9);
+      EXPECT_NEAR(slope[i], velocity(t), 1e-7);
+    }
+
+    // A constant signal passes unchanged from the first sample
+    SavitzkyGolayFilter<float> constant(7, 2);
+    for (size_t i = 0; i < 20; ++i)
+    {
+      EXPECT_NEAR(constant.filter(4.0f), 4.0f, 1e-5f);
+    }
+  }
+
+  TEST(HampelFilterTest, ReplacesSpikesOnly)
+  {
+    std::vector<double> clean(400);
+    for (size_t i = 0; i < clean.size(); ++i)
+    {
+      clean[i] = std::sin(0.05 * static_cast<double>(i)) + 0.01 * std::sin(2.3 * static_cast<double>(i));
+    }
+
+    std::vector<double> input(clean);
+    const size_t spikes[] = {37, 120, 121, 250, 333};
+    for (const size_t i : spikes)
+    {
+      input[i] += 5.0;
+    }
+
+    HampelFilter<double> filter(4, 3.0);
+    const std::vector<double> output = filter.filter(input);
+    const size_t delay = static_cast<size_t>(filter.getGroupDelay());
+    ASSERT_EQ(delay, 4U);
+    EXPECT_EQ(filter.getNumOutliers(), 5U);
+
+    for (size_t i = 0; i + delay < output.size(); ++i)
+    {
+      // Samples are delayed, spikes are replaced by a local median close to the clean signal
+      EXPECT_NEAR(output[i + delay], clean[i], 0.1) << "sample " << i;
+      if (std::find(std::begin(spikes), std::end(spikes), i) == std::end(spikes))
+      {
+        EXPECT_DOUBLE_EQ(output[i + delay], input[i]) << "sample " << i;
+      }
+    }
+
+    filter.reset();
+    EXPECT_EQ(filter.getNumOutliers(), 0U);
+    EXPECT_THROW(HampelFilter<double>(2, -1.0), std::invalid_argument);
+  }
+
+  TEST(HampelFilterTest, ReplacesNonFiniteSamples)
+  {
+    std::vector<double> input(100);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+      input[i] = std::sin(0.05 * static_cast<double>(i));
+    }
+    const size_t bad[] = {10, 40, 41, 70};
+    input[10] = std::numeric_limits<double>::quiet_NaN();
+    input[40] = std::numeric_limits<double>::infinity();
+    input[41] = std::numeric_limits<double>::quiet_NaN();
+    input[70] = -std::numeric_limits<double>::infinity();
+
+    HampelFilter<double> filter(3, 3.0);
+    const std::vector<double> output = filter.filter(input);
+    EXPECT_EQ(filter.getNumOutliers(), 4U);
+    for (size_t i = 0; i + 3 < output.size(); ++i)
+    {
+      ASSERT_TRUE(std::isfinite(output[i + 3])) << "sample " << i;
+      if (std::find(std::begin(bad), std::end(bad), i) == std::end(bad))
+      {
+        EXPECT_DOUBLE_EQ(output[i + 3], input[i]) << "sample " << i;
+      }
+      else
+      {
+        EXPECT_NEAR(output[i + 3], std::sin(0.05 * static_cast<double>(i)), 0.1) << "sample " << i;
+      }
+    }
+  }
+
+  // =============================================================================
+  // BATCH FREQUENCY RESPONSE, POLE AND ZERO TESTS
+  // =============================================================================
+
+  TEST(FrequencyResponseTest, MatchesScalarFrequencyResponse)
+  {
+    const double sample_rate = 1000.0;
+    const std::vector<double> frequencies = linearFrequencies(1001, sample_rate);
+    const FIRFilter<double> fir = FIRFilter<double>::lowPass(64, 100.0, sample_rate);
+    const IIRFilter<double> iir({0.02, 0.04, 0.02, 0.01}, {1.0, -1.6, 0.9, -0.2});
+
+    const FrequencyResponse<double> fir_response = frequencyResponse(fir, frequencies, sample_rate);
+    const FrequencyResponse<double> iir_response = frequencyResponse(iir, frequencies, sample_rate);
+    ASSERT_EQ(fir_response.size(), frequencies.size());
+    ASSERT_EQ(iir_response.size(), frequencies.size());
+    EXPECT_DOUBLE_EQ(frequencies.front(), 0.0);
+    EXPECT_DOUBLE_EQ(frequencies.back(), 500.0);
+
+    for (size_t i = 0; i < frequencies.size(); ++i)
+    {
+      const std::complex<double> expected_fir = fir.frequencyResponse(frequencies[i], sample_rate);
+      EXPECT_NEAR(std::abs(fir_response.response[i] - expected_fir), 0.0, 1e-13);
+      EXPECT_NEAR(fir_response.magnitude[i], std::abs(expected_fir), 1e-13);
+
+      const std::complex<double> expected_iir = iir.frequencyResponse(frequencies[i], sample_rate);
+      EXPECT_NEAR(std::abs(iir_response.response[i] - expected_iir), 0.0, 1e-12);
+      EXPECT_NEAR(iir_response.magnitude_db[i], 20.0 * std::log10(std::abs(expected_iir)), 1e-10);
+
+      // Unwrapped phase differs from the principal value by multiples of 2 pi
+      const double turns = (iir_response.phase[i] - std::arg(expected_iir)) / (2.0 * M_PI);
+      EXPECT_NEAR(turns, std::round(turns), 1e-10);
+    }
+  }
+
+  TEST(FrequencyResponseTest, LinearPhaseFIRGroupDelay)
+  {
+    const double sample_rate = 1000.0;
+    const FIRFilter<double> fir = FIRFilter<double>::lowPass(40, 100.0, sample_rate);
+    const std::vector<double> frequencies = linearFrequencies(200, 80.0);
+    const FrequencyResponse<double> response = frequencyResponse(fir, frequencies, sample_rate);
+
+    // Symmetric coefficients: constant group delay, phase -omega * delay in the pass band
+    for (size_t i = 0; i < frequencies.size(); ++i)
+    {
+      const double omega = 2.0 * M_PI * frequencies[i] / sample_rate;
+      EXPECT_NEAR(response.group_delay[i], fir.getGroupDelay(), 1e-9);
+      EXPECT_NEAR(response.phase[i], -omega * fir.getGroupDelay(), 1e-9);
+    }
+
+    // Zeros of the response have no group delay, empty filters respond with zero
+    const FrequencyResponse<double> differencer =
+        frequencyResponse(FIRFilter<double>({1.0, -1.0}), std::vector<double>{0.0, 250.0}, sample_rate);
+    EXPECT_DOUBLE_EQ(differencer.group_delay[0], 0.0);
+    EXPECT_NEAR(differencer.group_delay[1], 0.5, 1e-12);
+
+    const FrequencyResponse<double> empty =
+        frequencyResponse(IIRFilter<double>(), std::vector<double>{10.0}, sample_rate);
+    EXPECT_DOUBLE_EQ(std::abs(empty.response[0]), 0.0);
+    EXPECT_THROW(frequencyResponse(fir, frequencies, 0.0), std::invalid_argument);
+  }
+
+  TEST(FrequencyResponseTest, IIRGroupDelayIsPhaseDerivative)
+  {
+    const double sample_rate = 1000.0;
+    const IIRFilter<double> iir = IIRFilter<double>::secondOrderLowPass(100.0, 2.0, sample_rate);
+    const std::vector<double> frequencies = logFrequencies(1.0, 499.0, 2000);
+    const FrequencyResponse<double> response = frequencyResponse(iir, frequencies, sample_rate);
+
+    EXPECT_DOUBLE_EQ(frequencies.front(), 1.0);
+    EXPECT_DOUBLE_EQ(frequencies.back(), 499.0);
+    for (size_t i = 1; i + 1 < frequencies.size(); ++i)
+    {
+      const double d_omega = 2.0 * M_PI * (frequencies[i + 1] - frequencies[i - 1]) / sample_rate;
+      const double derivative = -(response.phase[i + 1] - response.phase[i - 1]) / d_omega;
+      EXPECT_NEAR(response.group_delay[i], derivative, 1e-3 * (1.0 + std::abs(derivative)));
+    }
+  }
+
+  TEST(FrequencyResponseTest, ThreadsAndFilterBanksGiveSameResult)
+  {
+    const double sample_rate = 48000.0;
+    const std::vector<double> frequencies =
+        linearFrequencies(3 * internal::kFrequencyResponseMinChunkSize + 17, sample_rate);
+
+    std::vector<IIRFilter<double>> bank;
+    for (int i = 1; i <= 5; ++i)
+    {
+      bank.push_back(IIRFilter<double>::secondOrderBandPass(1000.0 * i, 5.0, sample_rate));
+    }
+
+    const FrequencyResponse<double> single = frequencyResponse(bank[2], frequencies, sample_rate, 1U);
+    const FrequencyResponse<double> multi = frequencyResponse(bank[2], frequencies, sample_rate, 4U);
+    EXPECT_EQ(single.response, multi.response);
+    EXPECT_EQ(single.phase, multi.phase);
+    EXPECT_EQ(single.group_delay, multi.group_delay);
+
+    const std::vector<FrequencyResponse<double>> responses =
+        frequencyResponses(bank, frequencies, sample_rate);
+    ASSERT_EQ(responses.size(), bank.size());
+    EXPECT_EQ(responses[2].response, single.response);
+    for (size_t i = 0; i < bank.size(); ++i)
+    {
+      // Band-pass peaks at the center frequency
+      const size_t peak = static_cast<size_t>(
+          std::max_element(responses[i].magnitude.begin(), responses[i].magnitude.end()) -
+          responses[i].magnitude.begin());
+      EXPECT_NEAR(frequencies[peak], 1000.0 * static_cast<double>(i + 1), 10.0);
+    }
+  }
+
+  TEST(FrequencyResponseTest, PolynomialRoots)
+  {
+    // (x - 1)(x - 2)(x + 3)(x^2 - x + 0.5), roots 1, 2, -3, 0.5 +- 0.5i
+    const std::vector<double> c = {1.0, -1.0, -6.5, 13.0, -9.5, 3.0};
+    const std::vector<std::complex<double>> roots = internal::polynomialRoots(c);
+    const std::vector<std::complex<double>> expected = {
+        {-3.0, 0.0}, {0.5, -0.5}, {0.5, 0.5}, {1.0, 0.0}, {2.0, 0.0}};
+
+    ASSERT_EQ(roots.size(), expected.size());
+    for (size_t i = 0; i < roots.size(); ++i)
+    {
+      EXPECT_NEAR(std::abs(roots[i] - expected[i]), 0.0, 1e-12);
+    }
+
+    // Closed form quadratics without cancellation
+    const std::vector<std::complex<double>> quadratic = internal::polynomialRoots(std::vector<double>{1.0, -1e8, 1.0});
+    ASSERT_EQ(quadratic.size(), 2U);
+    EXPECT_NEAR(quadratic[0].real(), 1e-8, 1e-22);
+    EXPECT_NEAR(quadratic[1].real(), 1e8, 1e-6);
+  }
+
+  TEST_F(IIRFilterTest, PolesZerosAndStability)
+  {
+    const IIRFilter<double> lp = IIRFilter<double>::secondOrderLowPass(cutoff_freq, q_factor, sample_rate);
+    const std::vector<double> &a = lp.getDenominatorCoefficients();
+
+    // Poles solve z^2 + a1 z + a2 = 0, zeros are a double zero at z = -1
+    const std::vector<std::complex<double>> &poles = lp.getPoles();
+    ASSERT_EQ(poles.size(), 2U);
+    const double re = -a[1] / 2.0;
+    const double im = std::sqrt(a[2] - re * re);
+    EXPECT_NEAR(poles[0].real(), re, 1e-14);
+    EXPECT_NEAR(poles[0].imag(), -im, 1e-14);
+    EXPECT_NEAR(poles[1].imag(), im, 1e-14);
+    ASSERT_EQ(lp.getZeros().size(), 2U);
+    for (const std::complex<double> &zero : lp.getZeros())
+    {
+      EXPECT_NEAR(std::abs(zero + 1.0), 0.0, 1e-7);
+    }
+    EXPECT_TRUE(lp.isStable());
+
+    // H(z) = (1 + 0.5 z^-1) / (1 - 0.5 z^-1): zero at -0.5, pole at 0.5
+    EXPECT_EQ(simple_filter.getZeros(), std::vector<std::complex<double>>{std::complex<double>(-0.5, 0.0)});
+    EXPECT_EQ(simple_filter.getPoles(), std::vector<std::complex<double>>{std::complex<double>(0.5, 0.0)});
+
+    // Orders are balanced with roots at the origin, H(z) = z / (z - 0.9)
+    IIRFilter<double> filter({0.1}, {1.0, -0.9});
+    EXPECT_EQ(filter.getZeros(), std::vector<std::complex<double>>{std::complex<double>(0.0, 0.0)});
+    EXPECT_NEAR(filter.getPoles()[0].real(), 0.9, 1e-15);
+
+    // Poles are recomputed with the coefficients and kept by copies
+    filter.setCoefficients({1.0}, {1.0, -1.5});
+    EXPECT_FALSE(filter.isStable());
+    const IIRFilter<double> copy(filter);
+    EXPECT_FALSE(copy.isStable());
+    EXPECT_NEAR(copy.getPoles()[0].real(), 1.5, 1e-15);
+    EXPECT_FALSE(IIRFilter<double>::integrator(sample_rate).isStable());
+    EXPECT_TRUE(IIRFilter<double>().isStable());
+  }
+
 } // namespace lumos
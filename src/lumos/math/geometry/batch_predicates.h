@@ -0,0 +1,329 @@
+#ifndef LUMOS_MATH_GEOMETRY_BATCH_PREDICATES_H_
+#define LUMOS_MATH_GEOMETRY_BATCH_PREDICATES_H_
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "lumos/logging.h"
+#include "lumos/math/geometry/line_2d.h"
+#include "lumos/math/geometry/line_3d.h"
+#include "lumos/math/geometry/plane.h"
+#include "lumos/math/geometry/point_array.h"
+#include "lumos/math/geometry/triangle.h"
+#include "lumos/math/lin_alg.h"
+#include "lumos/math/misc/parallel_for.h"
+
+// Batch versions of the single primitive geometry functions. All kernels work on
+// structure of arrays input (one pointer per coordinate) and contain no
+// data dependent branches in the inner loops, so that the compiler can
+// vectorize them. Inputs larger than two chunks of kBatchGeometryMinChunkSize
+// elements are split over num_threads threads (0 = all cores).
+// Boolean results are written as uint8_t (0 or 1).
+
+namespace lumos
+{
+  namespace internal
+  {
+    constexpr size_t kBatchGeometryMinChunkSize = 32768U;
+  } // namespace internal
+
+  // Signed euclidean distance from each point to the plane. The sign is
+  // positive on the side the plane normal (a, b, c) points to
+  template <typename T>
+  void pointPlaneDistances(const Plane<T> &plane, const T *const x,
+                           const T *const y, const T *const z,
+                           const size_t num_points, T *const distances,
+                           const size_t num_threads = 0U)
+  {
+    const T inv_norm = T(1) / std::sqrt(plane.a * plane.a + plane.b * plane.b +
+                                        plane.c * plane.c);
+    const T a = plane.a * inv_norm;
+    const T b = plane.b * inv_norm;
+    const T c = plane.c * inv_norm;
+    const T d = plane.d * inv_norm;
+
+    internal::parallelFor(
+        0U, num_points, internal::kBatchGeometryMinChunkSize,
+        [&](const size_t begin, const size_t end)
+        {
+          for (size_t i = begin; i < end; i++)
+          {
+            distances[i] = a * x[i] + b * y[i] + c * z[i] + d;
+          }
+        },
+        num_threads);
+  }
+
+  template <typename T>
+  std::vector<T> pointPlaneDistances(const Plane<T> &plane,
+                                     const PointArray3D<T> &points,
+                                     const size_t num_threads = 0U)
+  {
+    std::vector<T> distances(points.size());
+    pointPlaneDistances(plane, points.x.data(), points.y.data(), points.z.data(),
+                        points.size(), distances.data(), num_threads);
+    return distances;
+  }
+
+  // Evaluates a * x + b * y + c for each point, same as HomogeneousLine2D::eval
+  template <typename T>
+  void homogeneousLineEval(const HomogeneousLine2D<T> &line, const T *const x,
+                           const T *const y, const size_t num_points,
+                           T *const values, const size_t num_threads = 0U)
+  {
+    const T a = line.a;
+    const T b = line.b;
+    const T c = line.c;
+
+    internal::parallelFor(
+        0U, num_points, internal::kBatchGeometryMinChunkSize,
+        [&](const size_t begin, const size_t end)
+        {
+          for (size_t i = begin; i < end; i++)
+          {
+            values[i] = a * x[i] + b * y[i] + c;
+          }
+        },
+        num_threads);
+  }
+
+  template <typename T>
+  std::vector<T> homogeneousLineEval(const HomogeneousLine2D<T> &line,
+                                     const PointArray2D<T> &points,
+                                     const size_t num_threads = 0U)
+  {
+    std::vector<T> values(points.size());
+    homogeneousLineEval(line, points.x.data(), points.y.data(), points.size(),
+                        values.data(), num_threads);
+    return values;
+  }
+
+  // Batch version of Line3D::closestPointOnLineFromPoint
+  template <typename T>
+  void closestPointsOnLine(const Line3D<T> &line, const T *const x,
+                           const T *const y, const T *const z,
+                           const size_t num_points, T *const closest_x,
+                           T *const closest_y, T *const closest_z,
+                           const size_t num_threads = 0U)
+  {
+    const T px = line.p.x;
+    const T py = line.p.y;
+    const T pz = line.p.z;
+    const T inv_squared_norm =
+        T(1) / (line.v.x * line.v.x + line.v.y * line.v.y + line.v.z * line.v.z);
+    const T vx = line.v.x;
+    const T vy = line.v.y;
+    const T vz = line.v.z;
+
+    internal::parallelFor(
+        0U, num_points, internal::kBatchGeometryMinChunkSize,
+        [&](const size_t begin, const size_t end)
+        {
+          for (size_t i = begin; i < end; i++)
+          {
+            const T t = (vx * (x[i] - px) + vy * (y[i] - py) + vz * (z[i] - pz)) *
+                        inv_squared_norm;
+            closest_x[i] = px + t * vx;
+            closest_y[i] = py + t * vy;
+            closest_z[i] = pz + t * vz;
+          }
+        },
+        num_threads);
+  }
+
+  template <typename T>
+  PointArray3D<T> closestPointsOnLine(const Line3D<T> &line,
+                                      const PointArray3D<T> &points,
+                                      const size_t num_threads = 0U)
+  {
+    PointArray3D<T> closest_points(points.size());
+    closestPointsOnLine(line, points.x.data(), points.y.data(), points.z.data(),
+                        points.size(), closest_points.x.data(),
+                        closest_points.y.data(), closest_points.z.data(),
+                        num_threads);
+    return closest_points;
+  }
+
+  // Intersects the rays o + t * d, t >= 0, with the plane. For rays that miss
+  // (parallel or pointing away from the plane) hit is 0 and t is infinity
+  template <typename T>
+  void rayPlaneIntersections(const Plane<T> &plane, const T *const ox,
+                             const T *const oy, const T *const oz,
+                             const T *const dx, const T *const dy,
+                             const T *const dz, const size_t num_rays,
+                             T *const t, uint8_t *const hit,
+                             const size_t num_threads = 0U)
+  {
+    const T a = plane.a;
+    const T b = plane.b;
+    const T c = plane.c;
+    const T d = plane.d;
+    const T eps = std::numeric_limits<T>::epsilon();
+    const T inf = std::numeric_limits<T>::infinity();
+
+    internal::parallelFor(
+        0U, num_rays, internal::kBatchGeometryMinChunkSize,
+        [&](const size_t begin, const size_t end)
+        {
+          for (size_t i = begin; i < end; i++)
+          {
+            const T denom = a * dx[i] + b * dy[i] + c * dz[i];
+            const T num = -(a * ox[i] + b * oy[i] + c * oz[i] + d);
+            const bool valid = std::abs(denom) > eps;
+            const T t_hit = num / (valid ? denom : T(1));
+            const bool is_hit = valid && (t_hit >= T(0));
+            t[i] = is_hit ? t_hit : inf;
+            hit[i] = static_cast<uint8_t>(is_hit);
+          }
+        },
+        num_threads);
+  }
+
+  template <typename T>
+  void rayPlaneIntersections(const Plane<T> &plane,
+                             const PointArray3D<T> &origins,
+                             const PointArray3D<T> &directions,
+                             std::vector<T> &t, std::vector<uint8_t> &hit,
+                             const size_t num_threads = 0U)
+  {
+    ASSERT(origins.size() == directions.size())
+        << "Number of ray origins and directions must be equal!";
+    t.resize(origins.size());
+    hit.resize(origins.size());
+    rayPlaneIntersections(plane, origins.x.data(), origins.y.data(),
+                          origins.z.data(), directions.x.data(),
+                          directions.y.data(), directions.z.data(),
+                          origins.size(), t.data(), hit.data(), num_threads);
+  }
+
+  // Möller–Trumbore intersection of the rays o + t * d, t >= 0, with a single
+  // triangle. Both triangle sides count as hits. For rays that miss, hit is 0
+  // and t is infinity
+  template <typename T>
+  void rayTriangleIntersections(const Triangle3D<T> &triangle, const T *const ox,
+                                const T *const oy, const T *const oz,
+                                const T *const dx, const T *const dy,
+                                const T *const dz, const size_t num_rays,
+                                T *const t, uint8_t *const hit,
+                                const size_t num_threads = 0U)
+  {
+    const Vec3<T> e1 = triangle.p1 - triangle.p0;
+    const Vec3<T> e2 = triangle.p2 - triangle.p0;
+    const T p0x = triangle.p0.x;
+    const T p0y = triangle.p0.y;
+    const T p0z = triangle.p0.z;
+    const T e1x = e1.x;
+    const T e1y = e1.y;
+    const T e1z = e1.z;
+    const T e2x = e2.x;
+    const T e2y = e2.y;
+    const T e2z = e2.z;
+    const T eps = std::numeric_limits<T>::epsilon();
+    const T inf = std::numeric_limits<T>::infinity();
+
+    internal::parallelFor(
+        0U, num_rays, internal::kBatchGeometryMinChunkSize,
+        [&](const size_t begin, const size_t end)
+        {
+          for (size_t i = begin; i < end; i++)
+          {
+            // h = d x e2
+            const T hx = dy[i] * e2z - dz[i] * e2y;
+            const T hy = dz[i] * e2x - dx[i] * e2z;
+            const T hz = dx[i] * e2y - dy[i] * e2x;
+            const T det = e1x * hx + e1y * hy + e1z * hz;
+            const bool valid = std::abs(det) > eps;
+            const T inv_det = T(1) / (valid ? det : T(1));
+
+            const T sx = ox[i] - p0x;
+            const T sy = oy[i] - p0y;
+            const T sz = oz[i] - p0z;
+            const T u = inv_det * (sx * hx + sy * hy + sz * hz);
+
+            // q = s x e1
+            const T qx = sy * e1z - sz * e1y;
+            const T qy = sz * e1x - sx * e1z;
+            const T qz = sx * e1y - sy * e1x;
+            const T v = inv_det * (dx[i] * qx + dy[i] * qy + dz[i] * qz);
+            const T t_hit = inv_det * (e2x * qx + e2y * qy + e2z * qz);
+
+            const bool is_hit = valid && (u >= T(0)) && (v >= T(0)) &&
+                                (u + v <= T(1)) && (t_hit >= T(0));
+            t[i] = is_hit ? t_hit : inf;
+            hit[i] = static_cast<uint8_t>(is_hit);
+          }
+        },
+        num_threads);
+  }
+
+  template <typename T>
+  void rayTriangleIntersections(const Triangle3D<T> &triangle,
+                                const PointArray3D<T> &origins,
+                                const PointArray3D<T> &directions,
+                                std::vector<T> &t, std::vector<uint8_t> &hit,
+                                const size_t num_threads = 0U)
+  {
+    ASSERT(origins.size() == directions.size())
+        << "Number of ray origins and directions must be equal!";
+    t.resize(origins.size());
+    hit.resize(origins.size());
+    rayTriangleIntersections(triangle, origins.x.data(), origins.y.data(),
+                             origins.z.data(), directions.x.data(),
+                             directions.y.data(), directions.z.data(),
+                             origins.size(), t.data(), hit.data(), num_threads);
+  }
+
+  // Inside test for a triangle of any winding. Points on an edge count as inside
+  template <typename T>
+  void pointsInTriangle(const Triangle2D<T> &triangle, const T *const x,
+                        const T *const y, const size_t num_points,
+                        uint8_t *const inside, const size_t num_threads = 0U)
+  {
+    // Edge functions e_k(p) = a_k * x + b_k * y + c_k, oriented so that the
+    // interior is on the non negative side
+    const T area2 = (triangle.p1.x - triangle.p0.x) * (triangle.p2.y - triangle.p0.y) -
+                    (triangle.p2.x - triangle.p0.x) * (triangle.p1.y - triangle.p0.y);
+    const T s = area2 < T(0) ? T(-1) : T(1);
+
+    const T a0 = s * (triangle.p0.y - triangle.p1.y);
+    const T b0 = s * (triangle.p1.x - triangle.p0.x);
+    const T c0 = s * (triangle.p0.x * triangle.p1.y - triangle.p1.x * triangle.p0.y);
+    const T a1 = s * (triangle.p1.y - triangle.p2.y);
+    const T b1 = s * (triangle.p2.x - triangle.p1.x);
+    const T c1 = s * (triangle.p1.x * triangle.p2.y - triangle.p2.x * triangle.p1.y);
+    const T a2 = s * (triangle.p2.y - triangle.p0.y);
+    const T b2 = s * (triangle.p0.x - triangle.p2.x);
+    const T c2 = s * (triangle.p2.x * triangle.p0.y - triangle.p0.x * triangle.p2.y);
+
+    internal::parallelFor(
+        0U, num_points, internal::kBatchGeometryMinChunkSize,
+        [&](const size_t begin, const size_t end)
+        {
+          for (size_t i = begin; i < end; i++)
+          {
+            const T e0 = a0 * x[i] + b0 * y[i] + c0;
+            const T e1 = a1 * x[i] + b1 * y[i] + c1;
+            const T e2 = a2 * x[i] + b2 * y[i] + c2;
+            inside[i] = static_cast<uint8_t>((e0 >= T(0)) & (e1 >= T(0)) &
+                                             (e2 >= T(0)));
+          }
+        },
+        num_threads);
+  }
+
+  template <typename T>
+  std::vector<uint8_t> pointsInTriangle(const Triangle2D<T> &triangle,
+                                        const PointArray2D<T> &points,
+                                        const size_t num_threads = 0U)
+  {
+    std::vector<uint8_t> inside(points.size());
+    pointsInTriangle(triangle, points.x.data(), points.y.data(), points.size(),
+                     inside.data(), num_threads);
+    return inside;
+  }
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_GEOMETRY_BATCH_PREDICATES_H_
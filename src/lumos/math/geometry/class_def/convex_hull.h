@@ -0,0 +1,22 @@
+#ifndef LUMOS_MATH_GEOMETRY_CLASS_DEF_CONVEX_HULL_H_
+#define LUMOS_MATH_GEOMETRY_CLASS_DEF_CONVEX_HULL_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "lumos/math/misc/forward_decl.h"
+#include "lumos/math/structures/index_triplet.h"
+
+namespace lumos
+{
+  // Triangulated 3D convex hull. All indices refer to the input point set, and
+  // the vertices of every face are ordered counter clockwise seen from outside
+  struct ConvexHull3D
+  {
+    std::vector<uint32_t> vertex_indices;
+    std::vector<IndexTriplet> faces;
+  };
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_GEOMETRY_CLASS_DEF_CONVEX_HULL_H_
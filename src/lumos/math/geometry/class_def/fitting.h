@@ -0,0 +1,44 @@
+#ifndef LUMOS_MATH_GEOMETRY_CLASS_DEF_FITTING_H_
+#define LUMOS_MATH_GEOMETRY_CLASS_DEF_FITTING_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "lumos/math/misc/forward_decl.h"
+
+namespace lumos
+{
+  template <typename T>
+  struct RansacParameters
+  {
+    // Maximum point to model distance for a point to count as an inlier
+    T inlier_threshold = T(0.1);
+
+    // Upper bound on the number of hypotheses. Fewer are evaluated when the
+    // required number for the given confidence is reached earlier
+    size_t max_iterations = 1000U;
+    T confidence = T(0.99);
+
+    // Models supported by fewer inliers are rejected
+    size_t min_inliers = 0U;
+
+    // Refit the model to its inliers with least squares
+    bool refine = true;
+
+    // Hypotheses are evaluated on num_threads threads (0 = all cores). Results
+    // only depend on the seed, not on the number of threads
+    size_t num_threads = 0U;
+    uint64_t seed = 0U;
+  };
+
+  template <typename ModelType>
+  struct FitResult
+  {
+    ModelType model;
+    std::vector<size_t> inlier_indices;
+    size_t num_iterations;
+  };
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_GEOMETRY_CLASS_DEF_FITTING_H_
@@ -0,0 +1,59 @@
+#ifndef LUMOS_MATH_GEOMETRY_CLASS_DEF_POINT_ARRAY_H_
+#define LUMOS_MATH_GEOMETRY_CLASS_DEF_POINT_ARRAY_H_
+
+#include <vector>
+
+#include "lumos/math/misc/forward_decl.h"
+
+namespace lumos
+{
+  // Structure of arrays point storage, used by the batch geometry functions so
+  // that every coordinate is contiguous in memory
+  template <typename T>
+  struct PointArray2D
+  {
+    std::vector<T> x;
+    std::vector<T> y;
+
+    PointArray2D();
+    explicit PointArray2D(const size_t num_points);
+    explicit PointArray2D(const std::vector<Point2<T>> &points);
+    explicit PointArray2D(const Vector<Point2<T>> &points);
+
+    size_t size() const;
+    void resize(const size_t num_points);
+    void reserve(const size_t num_points);
+    void clear();
+    void append(const Point2<T> &p);
+
+    Point2<T> point(const size_t idx) const;
+    void setPoint(const size_t idx, const Point2<T> &p);
+    std::vector<Point2<T>> toPoints() const;
+  };
+
+  template <typename T>
+  struct PointArray3D
+  {
+    std::vector<T> x;
+    std::vector<T> y;
+    std::vector<T> z;
+
+    PointArray3D();
+    explicit PointArray3D(const size_t num_points);
+    explicit PointArray3D(const std::vector<Point3<T>> &points);
+    explicit PointArray3D(const Vector<Point3<T>> &points);
+
+    size_t size() const;
+    void resize(const size_t num_points);
+    void reserve(const size_t num_points);
+    void clear();
+    void append(const Point3<T> &p);
+
+    Point3<T> point(const size_t idx) const;
+    void setPoint(const size_t idx, const Point3<T> &p);
+    std::vector<Point3<T>> toPoints() const;
+  };
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_GEOMETRY_CLASS_DEF_POINT_ARRAY_H_
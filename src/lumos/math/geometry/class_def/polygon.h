@@ -0,0 +1,76 @@
+#ifndef LUMOS_MATH_GEOMETRY_CLASS_DEF_POLYGON_H_
+#define LUMOS_MATH_GEOMETRY_CLASS_DEF_POLYGON_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "lumos/math/misc/forward_decl.h"
+
+namespace lumos
+{
+  // Simple polygon given by its vertices in order, the closing edge from the
+  // last to the first vertex is implicit
+  template <typename T>
+  struct Polygon2D
+  {
+    std::vector<Point2<T>> vertices;
+
+    Polygon2D();
+    explicit Polygon2D(const std::vector<Point2<T>> &vertices_);
+    Polygon2D(const std::initializer_list<Point2<T>> &il);
+
+    size_t size() const;
+    // Positive for counter clockwise vertex order
+    T signedArea() const;
+    T area() const;
+    bool isCounterClockwise() const;
+    bool isConvex() const;
+    // Even-odd rule, see PolygonPointLocator for many queries against the same polygon
+    bool contains(const Point2<T> &p) const;
+  };
+
+  // Point in polygon acceleration structure. The polygon is cut into horizontal
+  // slabs and every slab stores the edges overlapping it, so a query only tests
+  // the few edges of one slab instead of all edges of the polygon.
+  template <typename T>
+  class PolygonPointLocator
+  {
+  private:
+    struct Edge
+    {
+      T x0;
+      T y0;
+      T y1;
+      T dx_dy; // Inverse slope (x1 - x0) / (y1 - y0)
+    };
+
+    T min_x_;
+    T max_x_;
+    T min_y_;
+    T max_y_;
+    T inv_slab_height_;
+    size_t num_slabs_;
+    size_t num_threads_;
+
+    // Edges of slab k are slab_edges_[slab_offsets_[k], slab_offsets_[k + 1])
+    std::vector<uint32_t> slab_offsets_;
+    std::vector<Edge> slab_edges_;
+
+  public:
+    PolygonPointLocator();
+    // num_slabs == 0 picks a slab count from the number of edges
+    explicit PolygonPointLocator(const Polygon2D<T> &polygon, const size_t num_slabs = 0U,
+                                 const size_t num_threads = 0U);
+
+    void setNumThreads(const size_t num_threads);
+    size_t numSlabs() const;
+
+    bool contains(const Point2<T> &p) const;
+    void contains(const T *const x, const T *const y, const size_t num_points,
+                  uint8_t *const inside) const;
+    std::vector<uint8_t> contains(const PointArray2D<T> &points) const;
+  };
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_GEOMETRY_CLASS_DEF_POLYGON_H_
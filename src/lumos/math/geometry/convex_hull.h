@@ -0,0 +1,523 @@
+#ifndef LUMOS_MATH_GEOMETRY_CONVEX_HULL_H_
+#define LUMOS_MATH_GEOMETRY_CONVEX_HULL_H_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "lumos/math/geometry/batch_predicates.h"
+#include "lumos/math/geometry/class_def/convex_hull.h"
+#include "lumos/math/geometry/polygon.h"
+#include "lumos/math/lin_alg.h"
+#include "lumos/math/misc/parallel_for.h"
+
+namespace lumos
+{
+  namespace internal
+  {
+    // Below this size the Akl–Toussaint pre filter does not pay off
+    constexpr size_t kConvexHullFilterMinSize = 1024U;
+
+    // Akl–Toussaint heuristic: points strictly inside the polygon spanned by the
+    // extreme points in eight directions can not be on the hull. Returns the
+    // indices of the remaining candidates
+    template <typename T>
+    std::vector<size_t> convexHull2DCandidates(const std::vector<Point2<T>> &points,
+                                               const size_t num_threads)
+    {
+      std::vector<size_t> candidates;
+
+      if (points.size() < kConvexHullFilterMinSize)
+      {
+        candidates.resize(points.size());
+        std::iota(candidates.begin(), candidates.end(), size_t{0});
+        return candidates;
+      }
+
+      // Directions in counter clockwise order, so the extremes form a convex polygon
+      constexpr std::array<int, 8> dx = {1, 1, 0, -1, -1, -1, 0, 1};
+      constexpr std::array<int, 8> dy = {0, 1, 1, 1, 0, -1, -1, -1};
+      std::array<size_t, 8> extremes;
+      extremes.fill(0U);
+      for (size_t i = 1; i < points.size(); i++)
+      {
+        for (size_t k = 0; k < 8U; k++)
+        {
+          const Point2<T> &e = points[extremes[k]];
+          if (dx[k] * points[i].x + dy[k] * points[i].y > dx[k] * e.x + dy[k] * e.y)
+          {
+            extremes[k] = i;
+          }
+        }
+      }
+
+      std::vector<Point2<T>> filter_polygon;
+      for (size_t k = 0; k < 8U; k++)
+      {
+        const Point2<T> &p = points[extremes[k]];
+        if (filter_polygon.empty() || (filter_polygon.back() != p))
+        {
+          filter_polygon.push_back(p);
+        }
+      }
+      while ((filter_polygon.size() > 1U) && (filter_polygon.back() == filter_polygon.front()))
+      {
+        filter_polygon.pop_back();
+      }
+
+      if (filter_polygon.size() < 3U)
+      {
+        candidates.resize(points.size());
+        std::iota(candidates.begin(), candidates.end(), size_t{0});
+        return candidates;
+      }
+
+      std::vector<uint8_t> is_candidate(points.size());
+      parallelFor(
+          0U, points.size(), kBatchGeometryMinChunkSize,
+          [&](const size_t begin, const size_t end)
+          {
+            for (size_t i = begin; i < end; i++)
+            {
+              bool strictly_inside = true;
+              for (size_t k = 0; k < filter_polygon.size(); k++)
+              {
+                strictly_inside =
+                    strictly_inside &&
+                    (orientation2D(filter_polygon[k],
+                                   filter_polygon[(k + 1U) % filter_polygon.size()],
+                                   points[i]) > T(0));
+              }
+              is_candidate[i] = static_cast<uint8_t>(!strictly_inside);
+            }
+          },
+          num_threads);
+
+      for (size_t i = 0; i < points.size(); i++)
+      {
+        if (is_candidate[i])
+        {
+          candidates.push_back(i);
+        }
+      }
+      return candidates;
+    }
+
+    template <typename T>
+    struct QuickHullFace
+    {
+      std::array<uint32_t, 3> v;
+      Vec3<T> normal;
+      T offset;
+      std::vector<uint32_t> outside_points;
+      bool is_alive;
+
+      T distance(const Point3<T> &p) const
+      {
+        return normal.x * p.x + normal.y * p.y + normal.z * p.z - offset;
+      }
+    };
+
+    inline uint64_t directedEdgeKey(const uint32_t from, const uint32_t to)
+    {
+      return (static_cast<uint64_t>(from) << 32U) | static_cast<uint64_t>(to);
+    }
+
+  } // namespace internal
+
+  // Andrew's monotone chain. Returns the indices of the hull vertices in counter
+  // clockwise order, starting at the point with the smallest x (and smallest y
+  // for ties). Collinear points on hull edges are not included. Large inputs are
+  // pre filtered on num_threads threads (0 = all cores)
+  template <typename T>
+  std::vector<size_t> convexHull2DIndices(const std::vector<Point2<T>> &points,
+                                          const size_t num_threads = 0U)
+  {
+    std::vector<size_t> candidates = internal::convexHull2DCandidates(points, num_threads);
+
+    std::sort(candidates.begin(), candidates.end(),
+              [&points](const size_t i0, const size_t i1)
+              {
+                return (points[i0].x < points[i1].x) ||
+                       ((points[i0].x == points[i1].x) && (points[i0].y < points[i1].y));
+              });
+    candidates.erase(std::unique(candidates.begin(), candidates.end(),
+                                 [&points](const size_t i0, const size_t i1)
+                                 { return points[i0] == points[i1]; }),
+                     candidates.end());
+
+    const size_t n = candidates.size();
+    if (n < 3U)
+    {
+      return candidates;
+    }
+
+    std::vector<size_t> hull(2U * n);
+    size_t k = 0U;
+
+    // Lower hull
+    for (size_t i = 0; i < n; i++)
+    {
+      while ((k >= 2U) && (internal::orientation2D(points[hull[k - 2U]], points[hull[k - 1U]],
+                                                   points[candidates[i]]) <= T(0)))
+      {
+        k--;
+      }
+      hull[k++] = candidates[i];
+    }
+
+    // Upper hull
+    const size_t lower_size = k + 1U;
+    for (size_t i = n - 1U; i > 0U; i--)
+    {
+      while ((k >= lower_size) &&
+             (internal::orientation2D(points[hull[k - 2U]], points[hull[k - 1U]],
+                                      points[candidates[i - 1U]]) <= T(0)))
+      {
+        k--;
+      }
+      hull[k++] = candidates[i - 1U];
+    }
+
+    // The first point is repeated at the end
+    hull.resize(k - 1U);
+    return hull;
+  }
+
+  template <typename T>
+  Polygon2D<T> convexHull2D(const std::vector<Point2<T>> &points,
+                            const size_t num_threads = 0U)
+  {
+    const std::vector<size_t> indices = convexHull2DIndices(points, num_threads);
+
+    Polygon2D<T> hull;
+    hull.vertices.reserve(indices.size());
+    for (const size_t idx : indices)
+    {
+      hull.vertices.push_back(points[idx]);
+    }
+    return hull;
+  }
+
+  // Quickhull. Returns std::nullopt if all points are coplanar (or there are
+  // fewer than four points). Points closer than a small tolerance, relative to
+  // the extent of the point set, to a hull face are treated as inside. The
+  // initial assignment of points to faces runs on num_threads threads
+  template <typename T>
+  std::optional<ConvexHull3D> convexHull3D(const std::vector<Point3<T>> &points,
+                                           const size_t num_threads = 0U)
+  {
+    using Face = internal::QuickHullFace<T>;
+
+    const size_t num_points = points.size();
+    if (num_points < 4U)
+    {
+      return std::nullopt;
+    }
+    ASSERT(num_points < std::numeric_limits<uint32_t>::max())
+        << "Too many points for convexHull3D!";
+
+    // Extreme points along the axes
+    std::array<uint32_t, 6> extremes;
+    extremes.fill(0U);
+    T max_abs = T(0);
+    for (uint32_t i = 0; i < num_points; i++)
+    {
+      const Point3<T> &p = points[i];
+      extremes[0] = p.x < points[extremes[0]].x ? i : extremes[0];
+      extremes[1] = p.x > points[extremes[1]].x ? i : extremes[1];
+      extremes[2] = p.y < points[extremes[2]].y ? i : extremes[2];
+      extremes[3] = p.y > points[extremes[3]].y ? i : extremes[3];
+      extremes[4] = p.z < points[extremes[4]].z ? i : extremes[4];
+      extremes[5] = p.z > points[extremes[5]].z ? i : extremes[5];
+      max_abs = std::max(max_abs, std::abs(p.x) + std::abs(p.y) + std::abs(p.z));
+    }
+
+    const T eps = T(3) * std::numeric_limits<T>::epsilon() * max_abs;
+
+    // Initial simplex: the two most distant extremes, the point farthest from
+    // their line and the point farthest from the plane through all three
+    uint32_t i0 = extremes[0];
+    uint32_t i1 = extremes[1];
+    T max_dist = T(-1);
+    for (size_t a = 0; a < 6U; a++)
+    {
+      for (size_t b = a + 1U; b < 6U; b++)
+      {
+        const T d = (points[extremes[a]] - points[extremes[b]]).squaredNorm();
+        if (d > max_dist)
+        {
+          max_dist = d;
+          i0 = extremes[a];
+          i1 = extremes[b];
+        }
+      }
+    }
+
+    const Vec3<T> line_dir = points[i1] - points[i0];
+    uint32_t i2 = i0;
+    max_dist = T(0);
+    for (uint32_t i = 0; i < num_points; i++)
+    {
+      const T d = line_dir.crossProduct(points[i] - points[i0]).squaredNorm();
+      if (d > max_dist)
+      {
+        max_dist = d;
+        i2 = i;
+      }
+    }
+    if (std::sqrt(max_dist) <= eps * line_dir.norm())
+    {
+      return std::nullopt;
+    }
+
+    const Vec3<T> base_normal =
+        line_dir.crossProduct(points[i2] - points[i0]).normalized();
+    uint32_t i3 = i0;
+    max_dist = T(0);
+    for (uint32_t i = 0; i < num_points; i++)
+    {
+      const T d = std::abs(base_normal * (points[i] - points[i0]));
+      if (d > max_dist)
+      {
+        max_dist = d;
+        i3 = i;
+      }
+    }
+    if (max_dist <= eps)
+    {
+      return std::nullopt;
+    }
+
+    // The centroid of the simplex stays strictly inside the hull
+    const Point3<T> interior_point =
+        (points[i0] + points[i1] + points[i2] + points[i3]) / T(4);
+
+    std::vector<Face> faces;
+    std::unordered_map<uint64_t, uint32_t> edge_to_face;
+
+    const auto add_face = [&](const uint32_t a, const uint32_t b, const uint32_t c)
+    {
+      Face face;
+      face.v = {a, b, c};
+      face.normal = (points[b] - points[a]).crossProduct(points[c] - points[a]).normalized();
+      face.offset = face.normal * points[a];
+      face.is_alive = true;
+
+      const uint32_t face_idx = static_cast<uint32_t>(faces.size());
+      edge_to_face[internal::directedEdgeKey(a, b)] = face_idx;
+      edge_to_face[internal::directedEdgeKey(b, c)] = face_idx;
+      edge_to_face[internal::directedEdgeKey(c, a)] = face_idx;
+      faces.push_back(std::move(face));
+      return face_idx;
+    };
+
+    // Orient the simplex faces outwards
+    const std::array<std::array<uint32_t, 3>, 4> simplex_faces = {
+        {{i0, i1, i2}, {i0, i3, i1}, {i1, i3, i2}, {i2, i3, i0}}};
+    const bool flip =
+        (points[i1] - points[i0]).crossProduct(points[i2] - points[i0]) *
+            (interior_point - points[i0]) >
+        T(0);
+    for (const std::array<uint32_t, 3> &f : simplex_faces)
+    {
+      if (flip)
+      {
+        add_face(f[0], f[2], f[1]);
+      }
+      else
+      {
+        add_face(f[0], f[1], f[2]);
+      }
+    }
+
+    // Assign every point to the simplex face it is farthest above
+    std::vector<int8_t> assigned_face(num_points);
+    internal::parallelFor(
+        0U, num_points, internal::kBatchGeometryMinChunkSize,
+        [&](const size_t begin, const size_t end)
+        {
+          for (size_t i = begin; i < end; i++)
+          {
+            int8_t best_face = -1;
+            T best_dist = eps;
+            for (size_t f = 0; f < 4U; f++)
+            {
+              const T d = faces[f].distance(points[i]);
+              if (d > best_dist)
+              {
+                best_dist = d;
+                best_face = static_cast<int8_t>(f);
+              }
+            }
+            assigned_face[i] = best_face;
+          }
+        },
+        num_threads);
+
+    for (uint32_t i = 0; i < num_points; i++)
+    {
+      if (assigned_face[i] >= 0)
+      {
+        faces[assigned_face[i]].outside_points.push_back(i);
+      }
+    }
+
+    std::vector<uint32_t> face_stack = {0U, 1U, 2U, 3U};
+    std::vector<uint32_t> visible_faces;
+    std::vector<uint32_t> bfs_queue;
+    std::vector<std::pair<uint32_t, uint32_t>> horizon;
+    std::vector<uint32_t> orphan_points;
+    std::vector<uint32_t> new_faces;
+    std::vector<uint8_t> is_visible;
+
+    while (!face_stack.empty())
+    {
+      const uint32_t face_idx = face_stack.back();
+      face_stack.pop_back();
+
+      if (!faces[face_idx].is_alive || faces[face_idx].outside_points.empty())
+      {
+        continue;
+      }
+
+      // Farthest point above the face becomes the next hull vertex
+      uint32_t eye = faces[face_idx].outside_points[0];
+      T eye_dist = faces[face_idx].distance(points[eye]);
+      for (const uint32_t i : faces[face_idx].outside_points)
+      {
+        const T d = faces[face_idx].distance(points[i]);
+        if (d > eye_dist)
+        {
+          eye_dist = d;
+          eye = i;
+        }
+      }
+
+      // Flood fill all faces visible from the eye point
+      is_visible.resize(faces.size(), 0U);
+      visible_faces.clear();
+      bfs_queue.assign(1U, face_idx);
+      is_visible[face_idx] = 1U;
+      while (!bfs_queue.empty())
+      {
+        const uint32_t f = bfs_queue.back();
+        bfs_queue.pop_back();
+        visible_faces.push_back(f);
+
+        for (size_t e = 0; e < 3U; e++)
+        {
+          const uint32_t from = faces[f].v[e];
+          const uint32_t to = faces[f].v[(e + 1U) % 3U];
+          const uint32_t neighbor = edge_to_face.at(internal::directedEdgeKey(to, from));
+          if (!is_visible[neighbor] && (faces[neighbor].distance(points[eye]) > eps))
+          {
+            is_visible[neighbor] = 1U;
+            bfs_queue.push_back(neighbor);
+          }
+        }
+      }
+
+      // Horizon: edges of visible faces whose neighbor is not visible
+      horizon.clear();
+      orphan_points.clear();
+      for (const uint32_t f : visible_faces)
+      {
+        for (size_t e = 0; e < 3U; e++)
+        {
+          const uint32_t from = faces[f].v[e];
+          const uint32_t to = faces[f].v[(e + 1U) % 3U];
+          if (!is_visible[edge_to_face.at(internal::directedEdgeKey(to, from))])
+          {
+            horizon.emplace_back(from, to);
+          }
+        }
+      }
+
+      for (const uint32_t f : visible_faces)
+      {
+        for (size_t e = 0; e < 3U; e++)
+        {
+          edge_to_face.erase(internal::directedEdgeKey(faces[f].v[e], faces[f].v[(e + 1U) % 3U]));
+        }
+        orphan_points.insert(orphan_points.end(), faces[f].outside_points.begin(),
+                             faces[f].outside_points.end());
+        faces[f].outside_points.clear();
+        faces[f].outside_points.shrink_to_fit();
+        faces[f].is_alive = false;
+        is_visible[f] = 0U;
+      }
+
+      // Cone from the horizon to the eye point
+      new_faces.clear();
+      for (const std::pair<uint32_t, uint32_t> &edge : horizon)
+      {
+        new_faces.push_back(add_face(edge.first, edge.second, eye));
+      }
+
+      for (const uint32_t i : orphan_points)
+      {
+        if (i == eye)
+        {
+          continue;
+        }
+
+        uint32_t best_face = 0U;
+        T best_dist = eps;
+        bool is_outside = false;
+        for (const uint32_t f : new_faces)
+        {
+          const T d = faces[f].distance(points[i]);
+          if (d > best_dist)
+          {
+            best_dist = d;
+            best_face = f;
+            is_outside = true;
+          }
+        }
+        if (is_outside)
+        {
+          faces[best_face].outside_points.push_back(i);
+        }
+      }
+
+      for (const uint32_t f : new_faces)
+      {
+        if (!faces[f].outside_points.empty())
+        {
+          face_stack.push_back(f);
+        }
+      }
+    }
+
+    ConvexHull3D hull;
+    std::vector<uint8_t> is_hull_vertex(num_points, 0U);
+    for (const Face &face : faces)
+    {
+      if (face.is_alive)
+      {
+        hull.faces.emplace_back(face.v[0], face.v[1], face.v[2]);
+        is_hull_vertex[face.v[0]] = 1U;
+        is_hull_vertex[face.v[1]] = 1U;
+        is_hull_vertex[face.v[2]] = 1U;
+      }
+    }
+    for (uint32_t i = 0; i < num_points; i++)
+    {
+      if (is_hull_vertex[i])
+      {
+        hull.vertex_indices.push_back(i);
+      }
+    }
+
+    return hull;
+  }
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_GEOMETRY_CONVEX_HULL_H_
@@ -0,0 +1,767 @@
+#ifndef LUMOS_MATH_GEOMETRY_FITTING_H_
+#define LUMOS_MATH_GEOMETRY_FITTING_H_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "lumos/math/geometry/batch_predicates.h"
+#include "lumos/math/geometry/class_def/fitting.h"
+#include "lumos/math/geometry/line_2d.h"
+#include "lumos/math/geometry/line_3d.h"
+#include "lumos/math/geometry/plane.h"
+#include "lumos/math/geometry/point_array.h"
+#include "lumos/math/lin_alg.h"
+#include "lumos/math/misc/parallel_for.h"
+
+// Least squares and RANSAC estimators for planes and lines. All fitted models
+// are normalized: Plane has a unit normal (a, b, c), Line3D has a unit direction
+// and HomogeneousLine2D has a unit normal (a, b), so that evaluating them gives
+// the signed euclidean distance.
+
+namespace lumos
+{
+  namespace internal
+  {
+    // Number of hypotheses evaluated between two updates of the stop criterion
+    constexpr size_t kRansacBatchSize = 64U;
+
+    inline size_t sampleIndex(const size_t k, const size_t *const indices)
+    {
+      return indices == nullptr ? k : indices[k];
+    }
+
+    // Index of the column of an SVD result with the smallest or largest singular value
+    template <typename T, uint16_t N>
+    uint16_t singularValueColumn(const FixedSizeMatrix<T, N, N> &sigma,
+                                 const bool smallest)
+    {
+      uint16_t idx = 0U;
+      for (uint16_t k = 1U; k < N; k++)
+      {
+        if (smallest ? (sigma(k, k) < sigma(idx, idx)) : (sigma(k, k) > sigma(idx, idx)))
+        {
+          idx = k;
+        }
+      }
+      return idx;
+    }
+
+    template <typename T>
+    std::optional<Plane<T>> fitPlaneLeastSquares(const T *const x, const T *const y,
+                                                 const T *const z,
+                                                 const size_t *const indices,
+                                                 const size_t num_points)
+    {
+      if (num_points < 3U)
+      {
+        return std::nullopt;
+      }
+
+      T cx = T(0), cy = T(0), cz = T(0);
+      for (size_t k = 0; k < num_points; k++)
+      {
+        const size_t i = sampleIndex(k, indices);
+        cx += x[i];
+        cy += y[i];
+        cz += z[i];
+      }
+      cx /= static_cast<T>(num_points);
+      cy /= static_cast<T>(num_points);
+      cz /= static_cast<T>(num_points);
+
+      T sxx = T(0), sxy = T(0), sxz = T(0), syy = T(0), syz = T(0), szz = T(0);
+      for (size_t k = 0; k < num_points; k++)
+      {
+        const size_t i = sampleIndex(k, indices);
+        const T dx = x[i] - cx;
+        const T dy = y[i] - cy;
+        const T dz = z[i] - cz;
+        sxx += dx * dx;
+        sxy += dx * dy;
+        sxz += dx * dz;
+        syy += dy * dy;
+        syz += dy * dz;
+        szz += dz * dz;
+      }
+
+      FixedSizeMatrix<T, 3, 3> covariance;
+      covariance(0, 0) = sxx;
+      covariance(0, 1) = sxy;
+      covariance(0, 2) = sxz;
+      covariance(1, 0) = sxy;
+      covariance(1, 1) = syy;
+      covariance(1, 2) = syz;
+      covariance(2, 0) = sxz;
+      covariance(2, 1) = syz;
+      covariance(2, 2) = szz;
+
+      const std::optional<SVDMatrices<T, 3, 3>> svd_result = covariance.svd();
+      if (!svd_result.has_value())
+      {
+        return std::nullopt;
+      }
+
+      const FixedSizeMatrix<T, 3, 3> &sigma = svd_result->sigma_matrix;
+      const uint16_t min_idx = singularValueColumn(sigma, true);
+      const uint16_t max_idx = singularValueColumn(sigma, false);
+      const uint16_t mid_idx = static_cast<uint16_t>(3U - min_idx - max_idx);
+
+      // Points on a line (or a single point) do not define a plane
+      if ((min_idx == max_idx) ||
+          (sigma(mid_idx, mid_idx) <=
+           std::numeric_limits<T>::epsilon() * sigma(max_idx, max_idx)))
+      {
+        return std::nullopt;
+      }
+
+      const FixedSizeMatrix<T, 3, 3> &v = svd_result->v_matrix;
+      const Vec3<T> normal =
+          Vec3<T>(v(0, min_idx), v(1, min_idx), v(2, min_idx)).normalized();
+
+      return Plane<T>(Point3<T>(cx, cy, cz), normal);
+    }
+
+    template <typename T>
+    std::optional<Line3D<T>> fitLine3DLeastSquares(const T *const x, const T *const y,
+                                                   const T *const z,
+                                                   const size_t *const indices,
+                                                   const size_t num_points)
+    {
+      if (num_points < 2U)
+      {
+        return std::nullopt;
+      }
+
+      T cx = T(0), cy = T(0), cz = T(0);
+      for (size_t k = 0; k < num_points; k++)
+      {
+        const size_t i = sampleIndex(k, indices);
+        cx += x[i];
+        cy += y[i];
+        cz += z[i];
+      }
+      cx /= static_cast<T>(num_points);
+      cy /= static_cast<T>(num_points);
+      cz /= static_cast<T>(num_points);
+
+      T sxx = T(0), sxy = T(0), sxz = T(0), syy = T(0), syz = T(0), szz = T(0);
+      for (size_t k = 0; k < num_points; k++)
+      {
+        const size_t i = sampleIndex(k, indices);
+        const T dx = x[i] - cx;
+        const T dy = y[i] - cy;
+        const T dz = z[i] - cz;
+        sxx += dx * dx;
+        sxy += dx * dy;
+        sxz += dx * dz;
+        syy += dy * dy;
+        syz += dy * dz;
+        szz += dz * dz;
+      }
+
+      if ((sxx + syy + szz) <= T(0))
+      {
+        return std::nullopt;
+      }
+
+      FixedSizeMatrix<T, 3, 3> covariance;
+      covariance(0, 0) = sxx;
+      covariance(0, 1) = sxy;
+      covariance(0, 2) = sxz;
+      covariance(1, 0) = sxy;
+      covariance(1, 1) = syy;
+      covariance(1, 2) = syz;
+      covariance(2, 0) = sxz;
+      covariance(2, 1) = syz;
+      covariance(2, 2) = szz;
+
+      const std::optional<SVDMatrices<T, 3, 3>> svd_result = covariance.svd();
+      if (!svd_result.has_value())
+      {
+        return std::nullopt;
+      }
+
+      const uint16_t max_idx = singularValueColumn(svd_result->sigma_matrix, false);
+      const FixedSizeMatrix<T, 3, 3> &v = svd_result->v_matrix;
+      const Vec3<T> direction =
+          Vec3<T>(v(0, max_idx), v(1, max_idx), v(2, max_idx)).normalized();
+
+      return Line3D<T>(Point3<T>(cx, cy, cz), direction);
+    }
+
+    template <typename T>
+    std::optional<HomogeneousLine2D<T>>
+    fitLine2DLeastSquares(const T *const x, const T *const y,
+                          const size_t *const indices, const size_t num_points)
+    {
+      if (num_points < 2U)
+      {
+        return std::nullopt;
+      }
+
+      T cx = T(0), cy = T(0);
+      for (size_t k = 0; k < num_points; k++)
+      {
+        const size_t i = sampleIndex(k, indices);
+        cx += x[i];
+        cy += y[i];
+      }
+      cx /= static_cast<T>(num_points);
+      cy /= static_cast<T>(num_points);
+
+      T sxx = T(0), sxy = T(0), syy = T(0);
+      for (size_t k = 0; k < num_points; k++)
+      {
+        const size_t i = sampleIndex(k, indices);
+        const T dx = x[i] - cx;
+        const T dy = y[i] - cy;
+        sxx += dx * dx;
+        sxy += dx * dy;
+        syy += dy * dy;
+      }
+
+      if ((sxx + syy) <= T(0))
+      {
+        return std::nullopt;
+      }
+
+      FixedSizeMatrix<T, 2, 2> covariance;
+      covariance(0, 0) = sxx;
+      covariance(0, 1) = sxy;
+      covariance(1, 0) = sxy;
+      covariance(1, 1) = syy;
+
+      const std::optional<SVDMatrices<T, 2, 2>> svd_result = covariance.svd();
+      if (!svd_result.has_value())
+      {
+        return std::nullopt;
+      }
+
+      const uint16_t min_idx = singularValueColumn(svd_result->sigma_matrix, true);
+      const FixedSizeMatrix<T, 2, 2> &v = svd_result->v_matrix;
+      const T norm = std::sqrt(v(0, min_idx) * v(0, min_idx) + v(1, min_idx) * v(1, min_idx));
+      const T a = v(0, min_idx) / norm;
+      const T b = v(1, min_idx) / norm;
+
+      return HomogeneousLine2D<T>(a, b, -(a * cx + b * cy));
+    }
+
+    // Number of hypotheses needed to draw at least one outlier free sample with
+    // the given confidence, when num_inliers of num_points are inliers
+    template <typename T>
+    size_t requiredRansacIterations(const size_t num_inliers, const size_t num_points,
+                                    const size_t sample_size, const T confidence)
+    {
+      const double inlier_ratio =
+          static_cast<double>(num_inliers) / static_cast<double>(num_points);
+      const double p_good_sample =
+          std::pow(inlier_ratio, static_cast<double>(sample_size));
+
+      if (p_good_sample >= 1.0)
+      {
+        return 1U;
+      }
+      else if (p_good_sample <= std::numeric_limits<double>::epsilon())
+      {
+        return std::numeric_limits<size_t>::max();
+      }
+
+      const double num_iterations =
+          std::log(1.0 - static_cast<double>(confidence)) / std::log(1.0 - p_good_sample);
+      return num_iterations >= static_cast<double>(std::numeric_limits<size_t>::max())
+                 ? std::numeric_limits<size_t>::max()
+                 : static_cast<size_t>(std::ceil(num_iterations));
+    }
+
+    // Generic RANSAC loop. make_model(sample) returns std::optional<ModelType>
+    // from sample_size point indices, count_inliers(model) returns the support.
+    // Every hypothesis uses its own generator seeded from its iteration number,
+    // so the result is independent of how hypotheses are distributed over threads.
+    template <typename T, typename ModelType, typename MakeModel, typename CountInliers>
+    std::optional<ModelType> runRansac(const size_t num_points, const size_t sample_size,
+                                       const RansacParameters<T> &params,
+                                       const MakeModel &make_model,
+                                       const CountInliers &count_inliers,
+                                       size_t &num_iterations)
+    {
+      num_iterations = 0U;
+      if (num_points < sample_size)
+      {
+        return std::nullopt;
+      }
+
+      std::optional<ModelType> best_model;
+      size_t best_num_inliers = 0U;
+      size_t required_iterations = params.max_iterations;
+
+      std::vector<std::optional<ModelType>> batch_models(kRansacBatchSize);
+      std::vector<size_t> batch_num_inliers(kRansacBatchSize);
+
+      // Keep each thread busy with roughly kBatchGeometryMinChunkSize point tests
+      const size_t min_hypotheses_per_thread =
+          std::max<size_t>(1U, kBatchGeometryMinChunkSize / num_points);
+
+      while (num_iterations < std::min(required_iterations, params.max_iterations))
+      {
+        const size_t batch_size =
+            std::min(kRansacBatchSize,
+                     std::min(required_iterations, params.max_iterations) - num_iterations);
+        const size_t first_iteration = num_iterations;
+
+        parallelFor(
+            0U, batch_size, min_hypotheses_per_thread,
+            [&](const size_t begin, const size_t end)
+            {
+              std::vector<size_t> sample(sample_size);
+              for (size_t h = begin; h < end; h++)
+              {
+                std::mt19937_64 gen(params.seed +
+                                    0x9E3779B97F4A7C15ULL * (first_iteration + h + 1U));
+                std::uniform_int_distribution<size_t> dist(0U, num_points - 1U);
+
+                for (size_t k = 0; k < sample_size; k++)
+                {
+                  bool is_duplicate = true;
+                  while (is_duplicate)
+                  {
+                    sample[k] = dist(gen);
+                    is_duplicate = std::find(sample.begin(), sample.begin() + k,
+                                             sample[k]) != sample.begin() + k;
+                  }
+                }
+
+                batch_models[h] = make_model(sample.data());
+                batch_num_inliers[h] =
+                    batch_models[h].has_value() ? count_inliers(*batch_models[h]) : 0U;
+              }
+            },
+            params.num_threads);
+
+        for (size_t h = 0; h < batch_size; h++)
+        {
+          if (batch_models[h].has_value() && (batch_num_inliers[h] > best_num_inliers))
+          {
+            best_num_inliers = batch_num_inliers[h];
+            best_model = batch_models[h];
+          }
+        }
+
+        num_iterations += batch_size;
+
+        if (best_num_inliers > 0U)
+        {
+          required_iterations = requiredRansacIterations(best_num_inliers, num_points,
+                                                         sample_size, params.confidence);
+        }
+      }
+
+      if (best_num_inliers < std::max(params.min_inliers, sample_size))
+      {
+        return std::nullopt;
+      }
+
+      return best_model;
+    }
+
+    template <typename T>
+    size_t countPlaneInliers(const Plane<T> &plane, const T *const x, const T *const y,
+                             const T *const z, const size_t num_points,
+                             const T threshold)
+    {
+      size_t num_inliers = 0U;
+      for (size_t i = 0; i < num_points; i++)
+      {
+        num_inliers += static_cast<size_t>(
+            std::abs(plane.a * x[i] + plane.b * y[i] + plane.c * z[i] + plane.d) <=
+            threshold);
+      }
+      return num_inliers;
+    }
+
+    template <typename T>
+    size_t countLine3DInliers(const Line3D<T> &line, const T *const x, const T *const y,
+                              const T *const z, const size_t num_points,
+                              const T threshold)
+    {
+      const T squared_threshold = threshold * threshold;
+      size_t num_inliers = 0U;
+      for (size_t i = 0; i < num_points; i++)
+      {
+        const T dx = x[i] - line.p.x;
+        const T dy = y[i] - line.p.y;
+        const T dz = z[i] - line.p.z;
+        const T cx = dy * line.v.z - dz * line.v.y;
+        const T cy = dz * line.v.x - dx * line.v.z;
+        const T cz = dx * line.v.y - dy * line.v.x;
+        num_inliers +=
+            static_cast<size_t>((cx * cx + cy * cy + cz * cz) <= squared_threshold);
+      }
+      return num_inliers;
+    }
+
+    template <typename T>
+    size_t countLine2DInliers(const HomogeneousLine2D<T> &line, const T *const x,
+                              const T *const y, const size_t num_points,
+                              const T threshold)
+    {
+      size_t num_inliers = 0U;
+      for (size_t i = 0; i < num_points; i++)
+      {
+        num_inliers +=
+            static_cast<size_t>(std::abs(line.a * x[i] + line.b * y[i] + line.c) <= threshold);
+      }
+      return num_inliers;
+    }
+
+  } // namespace internal
+
+  // Indices of all points within threshold of the plane
+  template <typename T>
+  std::vector<size_t> pointsNearPlane(const Plane<T> &plane, const PointArray3D<T> &points,
+                                      const T threshold)
+  {
+    std::vector<size_t> indices;
+    for (size_t i = 0; i < points.size(); i++)
+    {
+      if (std::abs(plane.a * points.x[i] + plane.b * points.y[i] + plane.c * points.z[i] +
+                   plane.d) <= threshold)
+      {
+        indices.push_back(i);
+      }
+    }
+    return indices;
+  }
+
+  // Least squares fits, std::nullopt for degenerate input
+  template <typename T>
+  std::optional<Plane<T>> fitPlaneLeastSquares(const PointArray3D<T> &points)
+  {
+    return internal::fitPlaneLeastSquares(points.x.data(), points.y.data(),
+                                          points.z.data(), nullptr, points.size());
+  }
+
+  template <typename T>
+  std::optional<Plane<T>> fitPlaneLeastSquares(const PointArray3D<T> &points,
+                                               const std::vector<size_t> &indices)
+  {
+    return internal::fitPlaneLeastSquares(points.x.data(), points.y.data(),
+                                          points.z.data(), indices.data(),
+                                          indices.size());
+  }
+
+  template <typename T>
+  std::optional<Plane<T>> fitPlaneLeastSquares(const std::vector<Point3<T>> &points)
+  {
+    return fitPlaneLeastSquares(PointArray3D<T>(points));
+  }
+
+  template <typename T>
+  std::optional<Line3D<T>> fitLine3DLeastSquares(const PointArray3D<T> &points)
+  {
+    return internal::fitLine3DLeastSquares(points.x.data(), points.y.data(),
+                                           points.z.data(), nullptr, points.size());
+  }
+
+  template <typename T>
+  std::optional<Line3D<T>> fitLine3DLeastSquares(const PointArray3D<T> &points,
+                                                 const std::vector<size_t> &indices)
+  {
+    return internal::fitLine3DLeastSquares(points.x.data(), points.y.data(),
+                                           points.z.data(), indices.data(),
+                                           indices.size());
+  }
+
+  template <typename T>
+  std::optional<Line3D<T>> fitLine3DLeastSquares(const std::vector<Point3<T>> &points)
+  {
+    return fitLine3DLeastSquares(PointArray3D<T>(points));
+  }
+
+  template <typename T>
+  std::optional<HomogeneousLine2D<T>> fitLine2DLeastSquares(const PointArray2D<T> &points)
+  {
+    return internal::fitLine2DLeastSquares(points.x.data(), points.y.data(), nullptr,
+                                           points.size());
+  }
+
+  template <typename T>
+  std::optional<HomogeneousLine2D<T>>
+  fitLine2DLeastSquares(const PointArray2D<T> &points, const std::vector<size_t> &indices)
+  {
+    return internal::fitLine2DLeastSquares(points.x.data(), points.y.data(),
+                                           indices.data(), indices.size());
+  }
+
+  template <typename T>
+  std::optional<HomogeneousLine2D<T>>
+  fitLine2DLeastSquares(const std::vector<Point2<T>> &points)
+  {
+    return fitLine2DLeastSquares(PointArray2D<T>(points));
+  }
+
+  // RANSAC fits, std::nullopt if no model with enough inliers was found
+  template <typename T>
+  std::optional<FitResult<Plane<T>>> fitPlaneRansac(const PointArray3D<T> &points,
+                                                    const RansacParameters<T> &params)
+  {
+    const T *const x = points.x.data();
+    const T *const y = points.y.data();
+    const T *const z = points.z.data();
+    const size_t num_points = points.size();
+
+    const auto make_model = [&](const size_t *const sample) -> std::optional<Plane<T>>
+    {
+      const Point3<T> p0(x[sample[0]], y[sample[0]], z[sample[0]]);
+      const Vec3<T> e1 = Point3<T>(x[sample[1]], y[sample[1]], z[sample[1]]) - p0;
+      const Vec3<T> e2 = Point3<T>(x[sample[2]], y[sample[2]], z[sample[2]]) - p0;
+      const Vec3<T> normal = e1.crossProduct(e2);
+      const T normal_norm = normal.norm();
+
+      if (normal_norm <= std::numeric_limits<T>::epsilon() * e1.norm() * e2.norm())
+      {
+        return std::nullopt;
+      }
+      return Plane<T>(p0, normal / normal_norm);
+    };
+    const auto count_inliers = [&](const Plane<T> &plane)
+    {
+      return internal::countPlaneInliers(plane, x, y, z, num_points,
+                                         params.inlier_threshold);
+    };
+
+    FitResult<Plane<T>> result;
+    const std::optional<Plane<T>> best_model = internal::runRansac<T, Plane<T>>(
+        num_points, 3U, params, make_model, count_inliers, result.num_iterations);
+    if (!best_model.has_value())
+    {
+      return std::nullopt;
+    }
+
+    result.model = *best_model;
+    result.inlier_indices = pointsNearPlane(result.model, points, params.inlier_threshold);
+
+    if (params.refine)
+    {
+      const std::optional<Plane<T>> refined =
+          fitPlaneLeastSquares(points, result.inlier_indices);
+      if (refined.has_value())
+      {
+        std::vector<size_t> refined_inliers =
+            pointsNearPlane(*refined, points, params.inlier_threshold);
+        if (refined_inliers.size() >= result.inlier_indices.size())
+        {
+          result.model = *refined;
+          result.inlier_indices = std::move(refined_inliers);
+        }
+      }
+    }
+
+    return result;
+  }
+
+  template <typename T>
+  std::optional<FitResult<Line3D<T>>> fitLine3DRansac(const PointArray3D<T> &points,
+                                                      const RansacParameters<T> &params)
+  {
+    const T *const x = points.x.data();
+    const T *const y = points.y.data();
+    const T *const z = points.z.data();
+    const size_t num_points = points.size();
+
+    const auto make_model = [&](const size_t *const sample) -> std::optional<Line3D<T>>
+    {
+      const Point3<T> p0(x[sample[0]], y[sample[0]], z[sample[0]]);
+      const Vec3<T> v = Point3<T>(x[sample[1]], y[sample[1]], z[sample[1]]) - p0;
+      const T v_norm = v.norm();
+
+      if (v_norm <= T(0))
+      {
+        return std::nullopt;
+      }
+      return Line3D<T>(p0, v / v_norm);
+    };
+    const auto count_inliers = [&](const Line3D<T> &line)
+    {
+      return internal::countLine3DInliers(line, x, y, z, num_points,
+                                          params.inlier_threshold);
+    };
+    const auto collect_inliers = [&](const Line3D<T> &line)
+    {
+      const T squared_threshold = params.inlier_threshold * params.inlier_threshold;
+      std::vector<size_t> inliers;
+      for (size_t i = 0; i < num_points; i++)
+      {
+        const Vec3<T> d = Point3<T>(x[i], y[i], z[i]) - line.p;
+        if (d.crossProduct(line.v).squaredNorm() <= squared_threshold)
+        {
+          inliers.push_back(i);
+        }
+      }
+      return inliers;
+    };
+
+    FitResult<Line3D<T>> result;
+    const std::optional<Line3D<T>> best_model = internal::runRansac<T, Line3D<T>>(
+        num_points, 2U, params, make_model, count_inliers, result.num_iterations);
+    if (!best_model.has_value())
+    {
+      return std::nullopt;
+    }
+
+    result.model = *best_model;
+    result.inlier_indices = collect_inliers(result.model);
+
+    if (params.refine)
+    {
+      const std::optional<Line3D<T>> refined =
+          fitLine3DLeastSquares(points, result.inlier_indices);
+      if (refined.has_value())
+      {
+        std::vector<size_t> refined_inliers = collect_inliers(*refined);
+        if (refined_inliers.size() >= result.inlier_indices.size())
+        {
+          result.model = *refined;
+          result.inlier_indices = std::move(refined_inliers);
+        }
+      }
+    }
+
+    return result;
+  }
+
+  template <typename T>
+  std::optional<FitResult<HomogeneousLine2D<T>>>
+  fitLine2DRansac(const PointArray2D<T> &points, const RansacParameters<T> &params)
+  {
+    const T *const x = points.x.data();
+    const T *const y = points.y.data();
+    const size_t num_points = points.size();
+
+    const auto make_model =
+        [&](const size_t *const sample) -> std::optional<HomogeneousLine2D<T>>
+    {
+      const T dx = x[sample[1]] - x[sample[0]];
+      const T dy = y[sample[1]] - y[sample[0]];
+      const T norm = std::sqrt(dx * dx + dy * dy);
+
+      if (norm <= T(0))
+      {
+        return std::nullopt;
+      }
+      const T a = -dy / norm;
+      const T b = dx / norm;
+      return HomogeneousLine2D<T>(a, b, -(a * x[sample[0]] + b * y[sample[0]]));
+    };
+    const auto count_inliers = [&](const HomogeneousLine2D<T> &line)
+    {
+      return internal::countLine2DInliers(line, x, y, num_points, params.inlier_threshold);
+    };
+    const auto collect_inliers = [&](const HomogeneousLine2D<T> &line)
+    {
+      std::vector<size_t> inliers;
+      for (size_t i = 0; i < num_points; i++)
+      {
+        if (std::abs(line.a * x[i] + line.b * y[i] + line.c) <= params.inlier_threshold)
+        {
+          inliers.push_back(i);
+        }
+      }
+      return inliers;
+    };
+
+    FitResult<HomogeneousLine2D<T>> result;
+    const std::optional<HomogeneousLine2D<T>> best_model =
+        internal::runRansac<T, HomogeneousLine2D<T>>(num_points, 2U, params, make_model,
+                                                     count_inliers, result.num_iterations);
+    if (!best_model.has_value())
+    {
+      return std::nullopt;
+    }
+
+    result.model = *best_model;
+    result.inlier_indices = collect_inliers(result.model);
+
+    if (params.refine)
+    {
+      const std::optional<HomogeneousLine2D<T>> refined =
+          fitLine2DLeastSquares(points, result.inlier_indices);
+      if (refined.has_value())
+      {
+        std::vector<size_t> refined_inliers = collect_inliers(*refined);
+        if (refined_inliers.size() >= result.inlier_indices.size())
+        {
+          result.model = *refined;
+          result.inlier_indices = std::move(refined_inliers);
+        }
+      }
+    }
+
+    return result;
+  }
+
+  // Sequential multi plane extraction: the best plane is found with RANSAC, its
+  // inliers are removed and the search is repeated on the remaining points.
+  // Inlier indices refer to the input array. Stops after max_num_planes planes
+  // or when no plane with at least params.min_inliers inliers is left
+  template <typename T>
+  std::vector<FitResult<Plane<T>>> extractPlanesRansac(const PointArray3D<T> &points,
+                                                       const RansacParameters<T> &params,
+                                                       const size_t max_num_planes)
+  {
+    std::vector<FitResult<Plane<T>>> planes;
+
+    std::vector<size_t> remaining_indices(points.size());
+    for (size_t i = 0; i < points.size(); i++)
+    {
+      remaining_indices[i] = i;
+    }
+    PointArray3D<T> remaining_points = points;
+
+    while (planes.size() < max_num_planes)
+    {
+      RansacParameters<T> plane_params = params;
+      plane_params.seed = params.seed + planes.size();
+
+      std::optional<FitResult<Plane<T>>> result =
+          fitPlaneRansac(remaining_points, plane_params);
+      if (!result.has_value())
+      {
+        break;
+      }
+
+      std::vector<uint8_t> is_inlier(remaining_points.size(), 0U);
+      for (size_t &idx : result->inlier_indices)
+      {
+        is_inlier[idx] = 1U;
+        idx = remaining_indices[idx];
+      }
+
+      // Compact the remaining points, keeping their relative order
+      size_t num_kept = 0U;
+      for (size_t i = 0; i < remaining_points.size(); i++)
+      {
+        if (!is_inlier[i])
+        {
+          remaining_points.x[num_kept] = remaining_points.x[i];
+          remaining_points.y[num_kept] = remaining_points.y[i];
+          remaining_points.z[num_kept] = remaining_points.z[i];
+          remaining_indices[num_kept] = remaining_indices[i];
+          num_kept++;
+        }
+      }
+      remaining_points.resize(num_kept);
+      remaining_indices.resize(num_kept);
+
+      planes.push_back(std::move(*result));
+    }
+
+    return planes;
+  }
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_GEOMETRY_FITTING_H_
@@ -0,0 +1,192 @@
+#ifndef LUMOS_MATH_GEOMETRY_POINT_ARRAY_H_
+#define LUMOS_MATH_GEOMETRY_POINT_ARRAY_H_
+
+#include <vector>
+
+#include "lumos/math/geometry/class_def/point_array.h"
+#include "lumos/math/lin_alg.h"
+
+namespace lumos
+{
+  template <typename T>
+  PointArray2D<T>::PointArray2D() {}
+
+  template <typename T>
+  PointArray2D<T>::PointArray2D(const size_t num_points)
+      : x(num_points), y(num_points)
+  {
+  }
+
+  template <typename T>
+  PointArray2D<T>::PointArray2D(const std::vector<Point2<T>> &points)
+  {
+    resize(points.size());
+    for (size_t k = 0; k < points.size(); k++)
+    {
+      setPoint(k, points[k]);
+    }
+  }
+
+  template <typename T>
+  PointArray2D<T>::PointArray2D(const Vector<Point2<T>> &points)
+  {
+    resize(points.size());
+    for (size_t k = 0; k < points.size(); k++)
+    {
+      setPoint(k, points(k));
+    }
+  }
+
+  template <typename T>
+  size_t PointArray2D<T>::size() const
+  {
+    return x.size();
+  }
+
+  template <typename T>
+  void PointArray2D<T>::resize(const size_t num_points)
+  {
+    x.resize(num_points);
+    y.resize(num_points);
+  }
+
+  template <typename T>
+  void PointArray2D<T>::reserve(const size_t num_points)
+  {
+    x.reserve(num_points);
+    y.reserve(num_points);
+  }
+
+  template <typename T>
+  void PointArray2D<T>::clear()
+  {
+    x.clear();
+    y.clear();
+  }
+
+  template <typename T>
+  void PointArray2D<T>::append(const Point2<T> &p)
+  {
+    x.push_back(p.x);
+    y.push_back(p.y);
+  }
+
+  template <typename T>
+  Point2<T> PointArray2D<T>::point(const size_t idx) const
+  {
+    return Point2<T>(x[idx], y[idx]);
+  }
+
+  template <typename T>
+  void PointArray2D<T>::setPoint(const size_t idx, const Point2<T> &p)
+  {
+    x[idx] = p.x;
+    y[idx] = p.y;
+  }
+
+  template <typename T>
+  std::vector<Point2<T>> PointArray2D<T>::toPoints() const
+  {
+    std::vector<Point2<T>> points(size());
+    for (size_t k = 0; k < points.size(); k++)
+    {
+      points[k] = point(k);
+    }
+    return points;
+  }
+
+  template <typename T>
+  PointArray3D<T>::PointArray3D() {}
+
+  template <typename T>
+  PointArray3D<T>::PointArray3D(const size_t num_points)
+      : x(num_points), y(num_points), z(num_points)
+  {
+  }
+
+  template <typename T>
+  PointArray3D<T>::PointArray3D(const std::vector<Point3<T>> &points)
+  {
+    resize(points.size());
+    for (size_t k = 0; k < points.size(); k++)
+    {
+      setPoint(k, points[k]);
+    }
+  }
+
+  template <typename T>
+  PointArray3D<T>::PointArray3D(const Vector<Point3<T>> &points)
+  {
+    resize(points.size());
+    for (size_t k = 0; k < points.size(); k++)
+    {
+      setPoint(k, points(k));
+    }
+  }
+
+  template <typename T>
+  size_t PointArray3D<T>::size() const
+  {
+    return x.size();
+  }
+
+  template <typename T>
+  void PointArray3D<T>::resize(const size_t num_points)
+  {
+    x.resize(num_points);
+    y.resize(num_points);
+    z.resize(num_points);
+  }
+
+  template <typename T>
+  void PointArray3D<T>::reserve(const size_t num_points)
+  {
+    x.reserve(num_points);
+    y.reserve(num_points);
+    z.reserve(num_points);
+  }
+
+  template <typename T>
+  void PointArray3D<T>::clear()
+  {
+    x.clear();
+    y.clear();
+    z.clear();
+  }
+
+  template <typename T>
+  void PointArray3D<T>::append(const Point3<T> &p)
+  {
+    x.push_back(p.x);
+    y.push_back(p.y);
+    z.push_back(p.z);
+  }
+
+  template <typename T>
+  Point3<T> PointArray3D<T>::point(const size_t idx) const
+  {
+    return Point3<T>(x[idx], y[idx], z[idx]);
+  }
+
+  template <typename T>
+  void PointArray3D<T>::setPoint(const size_t idx, const Point3<T> &p)
+  {
+    x[idx] = p.x;
+    y[idx] = p.y;
+    z[idx] = p.z;
+  }
+
+  template <typename T>
+  std::vector<Point3<T>> PointArray3D<T>::toPoints() const
+  {
+    std::vector<Point3<T>> points(size());
+    for (size_t k = 0; k < points.size(); k++)
+    {
+      points[k] = point(k);
+    }
+    return points;
+  }
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_GEOMETRY_POINT_ARRAY_H_
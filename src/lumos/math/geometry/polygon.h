@@ -0,0 +1,298 @@
+#ifndef LUMOS_MATH_GEOMETRY_POLYGON_H_
+#define LUMOS_MATH_GEOMETRY_POLYGON_H_
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "lumos/logging.h"
+#include "lumos/math/geometry/class_def/polygon.h"
+#include "lumos/math/geometry/point_array.h"
+#include "lumos/math/lin_alg.h"
+#include "lumos/math/misc/parallel_for.h"
+
+namespace lumos
+{
+  namespace internal
+  {
+    // Point in polygon queries test several edges per point, so smaller chunks
+    // than for the batch geometry kernels are worth a thread
+    constexpr size_t kPolygonQueryMinChunkSize = 4096U;
+
+    // z component of (b - a) x (p - a), positive if p is left of a -> b
+    template <typename T>
+    inline T orientation2D(const Point2<T> &a, const Point2<T> &b, const Point2<T> &p)
+    {
+      return (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+    }
+  } // namespace internal
+
+  template <typename T>
+  Polygon2D<T>::Polygon2D() {}
+
+  template <typename T>
+  Polygon2D<T>::Polygon2D(const std::vector<Point2<T>> &vertices_) : vertices(vertices_)
+  {
+  }
+
+  template <typename T>
+  Polygon2D<T>::Polygon2D(const std::initializer_list<Point2<T>> &il) : vertices(il)
+  {
+  }
+
+  template <typename T>
+  size_t Polygon2D<T>::size() const
+  {
+    return vertices.size();
+  }
+
+  template <typename T>
+  T Polygon2D<T>::signedArea() const
+  {
+    T double_area = T(0);
+    for (size_t i = 0, j = vertices.size() - 1; i < vertices.size(); j = i++)
+    {
+      double_area += vertices[j].x * vertices[i].y - vertices[i].x * vertices[j].y;
+    }
+    return double_area / T(2);
+  }
+
+  template <typename T>
+  T Polygon2D<T>::area() const
+  {
+    return std::abs(signedArea());
+  }
+
+  template <typename T>
+  bool Polygon2D<T>::isCounterClockwise() const
+  {
+    return signedArea() > T(0);
+  }
+
+  template <typename T>
+  bool Polygon2D<T>::isConvex() const
+  {
+    const size_t n = vertices.size();
+    if (n < 3U)
+    {
+      return false;
+    }
+
+    bool has_positive = false;
+    bool has_negative = false;
+    for (size_t i = 0; i < n; i++)
+    {
+      const T turn = internal::orientation2D(vertices[i], vertices[(i + 1U) % n],
+                                             vertices[(i + 2U) % n]);
+      has_positive = has_positive || (turn > T(0));
+      has_negative = has_negative || (turn < T(0));
+    }
+    return !(has_positive && has_negative);
+  }
+
+  template <typename T>
+  bool Polygon2D<T>::contains(const Point2<T> &p) const
+  {
+    bool inside = false;
+    for (size_t i = 0, j = vertices.size() - 1; i < vertices.size(); j = i++)
+    {
+      const Point2<T> &v0 = vertices[j];
+      const Point2<T> &v1 = vertices[i];
+      if ((v0.y > p.y) != (v1.y > p.y))
+      {
+        const T x_intersection = v0.x + (p.y - v0.y) * (v1.x - v0.x) / (v1.y - v0.y);
+        inside = inside != (p.x < x_intersection);
+      }
+    }
+    return inside;
+  }
+
+  template <typename T>
+  PolygonPointLocator<T>::PolygonPointLocator()
+      : min_x_(T(0)), max_x_(T(0)), min_y_(T(0)), max_y_(T(0)), inv_slab_height_(T(0)),
+        num_slabs_(1U), num_threads_(0U), slab_offsets_(2U, 0U)
+  {
+  }
+
+  template <typename T>
+  PolygonPointLocator<T>::PolygonPointLocator(const Polygon2D<T> &polygon,
+                                              const size_t num_slabs,
+                                              const size_t num_threads)
+      : num_threads_(num_threads)
+  {
+    const std::vector<Point2<T>> &vertices = polygon.vertices;
+    ASSERT(vertices.size() >= 3U) << "Polygon needs at least three vertices!";
+
+    min_x_ = max_x_ = vertices[0].x;
+    min_y_ = max_y_ = vertices[0].y;
+    for (const Point2<T> &v : vertices)
+    {
+      min_x_ = std::min(min_x_, v.x);
+      max_x_ = std::max(max_x_, v.x);
+      min_y_ = std::min(min_y_, v.y);
+      max_y_ = std::max(max_y_, v.y);
+    }
+
+    num_slabs_ = num_slabs == 0U ? vertices.size() : num_slabs;
+    inv_slab_height_ =
+        max_y_ > min_y_ ? static_cast<T>(num_slabs_) / (max_y_ - min_y_) : T(0);
+
+    const auto slab_index = [this](const T y)
+    {
+      const T k = std::floor((y - min_y_) * inv_slab_height_);
+      return static_cast<size_t>(
+          std::min(std::max(k, T(0)), static_cast<T>(num_slabs_ - 1U)));
+    };
+
+    // Two passes: count the edges per slab, then fill in compressed row order
+    slab_offsets_.assign(num_slabs_ + 1U, 0U);
+    for (size_t pass = 0; pass < 2U; pass++)
+    {
+      std::vector<uint32_t> fill_position(slab_offsets_.begin(), slab_offsets_.end() - 1);
+
+      for (size_t i = 0, j = vertices.size() - 1; i < vertices.size(); j = i++)
+      {
+        const Point2<T> &v0 = vertices[j];
+        const Point2<T> &v1 = vertices[i];
+
+        // Horizontal edges never cross a horizontal ray
+        if (v0.y == v1.y)
+        {
+          continue;
+        }
+
+        const size_t k0 = slab_index(std::min(v0.y, v1.y));
+        const size_t k1 = slab_index(std::max(v0.y, v1.y));
+        for (size_t k = k0; k <= k1; k++)
+        {
+          if (pass == 0U)
+          {
+            slab_offsets_[k + 1U]++;
+          }
+          else
+          {
+            slab_edges_[fill_position[k]++] = {v0.x, v0.y, v1.y,
+                                               (v1.x - v0.x) / (v1.y - v0.y)};
+          }
+        }
+      }
+
+      if (pass == 0U)
+      {
+        for (size_t k = 0; k < num_slabs_; k++)
+        {
+          slab_offsets_[k + 1U] += slab_offsets_[k];
+        }
+        slab_edges_.resize(slab_offsets_[num_slabs_]);
+      }
+    }
+  }
+
+  template <typename T>
+  void PolygonPointLocator<T>::setNumThreads(const size_t num_threads)
+  {
+    num_threads_ = num_threads;
+  }
+
+  template <typename T>
+  size_t PolygonPointLocator<T>::numSlabs() const
+  {
+    return num_slabs_;
+  }
+
+  template <typename T>
+  bool PolygonPointLocator<T>::contains(const Point2<T> &p) const
+  {
+    if ((p.x < min_x_) || (p.x > max_x_) || (p.y < min_y_) || (p.y > max_y_))
+    {
+      return false;
+    }
+
+    const T k = std::floor((p.y - min_y_) * inv_slab_height_);
+    const size_t slab = static_cast<size_t>(std::min(k, static_cast<T>(num_slabs_ - 1U)));
+
+    // Same even-odd rule as Polygon2D::contains
+    bool inside = false;
+    for (uint32_t e = slab_offsets_[slab]; e < slab_offsets_[slab + 1U]; e++)
+    {
+      const Edge &edge = slab_edges_[e];
+      const bool crosses = (edge.y0 > p.y) != (edge.y1 > p.y);
+      const T x_intersection = edge.x0 + (p.y - edge.y0) * edge.dx_dy;
+      inside = inside != (crosses && (p.x < x_intersection));
+    }
+    return inside;
+  }
+
+  template <typename T>
+  void PolygonPointLocator<T>::contains(const T *const x, const T *const y,
+                                        const size_t num_points,
+                                        uint8_t *const inside) const
+  {
+    internal::parallelFor(
+        0U, num_points, internal::kPolygonQueryMinChunkSize,
+        [&](const size_t begin, const size_t end)
+        {
+          for (size_t i = begin; i < end; i++)
+          {
+            inside[i] = static_cast<uint8_t>(contains(Point2<T>(x[i], y[i])));
+          }
+        },
+        num_threads_);
+  }
+
+  template <typename T>
+  std::vector<uint8_t> PolygonPointLocator<T>::contains(const PointArray2D<T> &points) const
+  {
+    std::vector<uint8_t> inside(points.size());
+    contains(points.x.data(), points.y.data(), points.size(), inside.data());
+    return inside;
+  }
+
+  // Sutherland–Hodgman clipping of an arbitrary polygon against a convex clip
+  // polygon of any winding. The result keeps the winding of the subject polygon
+  // and is empty if the polygons do not overlap
+  template <typename T>
+  Polygon2D<T> clipPolygon(const Polygon2D<T> &subject, const Polygon2D<T> &convex_clip)
+  {
+    ASSERT(convex_clip.size() >= 3U) << "Clip polygon needs at least three vertices!";
+
+    const T orientation = convex_clip.isCounterClockwise() ? T(1) : T(-1);
+    std::vector<Point2<T>> output = subject.vertices;
+    std::vector<Point2<T>> input;
+
+    for (size_t k = 0; (k < convex_clip.size()) && !output.empty(); k++)
+    {
+      const Point2<T> &a = convex_clip.vertices[k];
+      const Point2<T> &b = convex_clip.vertices[(k + 1U) % convex_clip.size()];
+
+      input.swap(output);
+      output.clear();
+
+      for (size_t i = 0, j = input.size() - 1; i < input.size(); j = i++)
+      {
+        const Point2<T> &prev = input[j];
+        const Point2<T> &curr = input[i];
+        const T side_prev = orientation * internal::orientation2D(a, b, prev);
+        const T side_curr = orientation * internal::orientation2D(a, b, curr);
+
+        if (side_curr >= T(0))
+        {
+          if (side_prev < T(0))
+          {
+            output.push_back(prev + (side_prev / (side_prev - side_curr)) * (curr - prev));
+          }
+          output.push_back(curr);
+        }
+        else if (side_prev >= T(0))
+        {
+          output.push_back(prev + (side_prev / (side_prev - side_curr)) * (curr - prev));
+        }
+      }
+    }
+
+    return Polygon2D<T>(output);
+  }
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_GEOMETRY_POLYGON_H_
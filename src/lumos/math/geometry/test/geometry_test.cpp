@@ -1,10 +1,15 @@
 #include <cmath>
 #include <gtest/gtest.h>
 #include <limits>
+#include <random>
 
+#include "lumos/math/geometry/batch_predicates.h"
+#include "lumos/math/geometry/convex_hull.h"
+#include "lumos/math/geometry/fitting.h"
 #include "lumos/math/geometry/line_2d.h"
 #include "lumos/math/geometry/line_3d.h"
 #include "lumos/math/geometry/plane.h"
+#include "lumos/math/geometry/polygon.h"
 #include "lumos/math/geometry/triangle.h"
 #include "lumos/math/lin_alg/vector_low_dim/vec2.h"
 #include "lumos/math/lin_alg/vector_low_dim/vec3.h"
@@ -543,6 +548,646 @@ namespace lumos
     EXPECT_NEAR(plane.eval(p5), 0.0, EPSILON);
   }
 
+  // Test fixture for batch geometry tests
+  class BatchGeometryTest : public ::testing::Test
+  {
+  protected:
+    void SetUp() override
+    {
+      std::mt19937 gen(3);
+      std::uniform_real_distribution<double> dist(-5.0, 5.0);
+
+      // Large enough to be split over several threads
+      for (size_t i = 0; i < 100000; i++)
+      {
+        points.append(Point3<double>(dist(gen), dist(gen), dist(gen)));
+        directions.append(Point3<double>(dist(gen), dist(gen), dist(gen)));
+      }
+    }
+
+    PointArray3D<double> points;
+    PointArray3D<double> directions;
+  };
+
+  TEST_F(BatchGeometryTest, PointArrayConversions)
+  {
+    const std::vector<Point3<double>> pts = points.toPoints();
+    const PointArray3D<double> points_copy(pts);
+
+    ASSERT_EQ(points_copy.size(), points.size());
+    EXPECT_EQ(points_copy.point(17).x, points.x[17]);
+    EXPECT_EQ(points_copy.point(17).y, points.y[17]);
+    EXPECT_EQ(points_copy.point(17).z, points.z[17]);
+  }
+
+  TEST_F(BatchGeometryTest, PointPlaneDistances)
+  {
+    const Plane<double> plane(Point3<double>(1.0, 2.0, 3.0), Vec3<double>(0.0, 0.0, 2.0));
+    const std::vector<double> distances = pointPlaneDistances(plane, points);
+
+    ASSERT_EQ(distances.size(), points.size());
+    for (size_t i = 0; i < points.size(); i += 101)
+    {
+      EXPECT_NEAR(distances[i], points.z[i] - 3.0, EPSILON);
+      EXPECT_NEAR(distances[i], plane.eval(points.point(i)) / 2.0, EPSILON);
+    }
+  }
+
+  TEST_F(BatchGeometryTest, HomogeneousLineEval)
+  {
+    const HomogeneousLine2D<double> line(1.0, -2.0, 0.5);
+    PointArray2D<double> points_2d;
+    for (size_t i = 0; i < 1000; i++)
+    {
+      points_2d.append(Point2<double>(points.x[i], points.y[i]));
+    }
+
+    const std::vector<double> values = homogeneousLineEval(line, points_2d);
+    for (size_t i = 0; i < points_2d.size(); i++)
+    {
+      EXPECT_NEAR(values[i], line.eval(points_2d.point(i)), EPSILON);
+    }
+  }
+
+  TEST_F(BatchGeometryTest, ClosestPointsOnLine)
+  {
+    const Line3D<double> line(Point3<double>(1.0, -1.0, 0.5), Vec3<double>(1.0, 2.0, -0.5));
+    const PointArray3D<double> closest = closestPointsOnLine(line, points);
+
+    ASSERT_EQ(closest.size(), points.size());
+    for (size_t i = 0; i < points.size(); i += 101)
+    {
+      const Point3<double> expected = line.closestPointOnLineFromPoint(points.point(i));
+      EXPECT_NEAR(closest.x[i], expected.x, EPSILON);
+      EXPECT_NEAR(closest.y[i], expected.y, EPSILON);
+      EXPECT_NEAR(closest.z[i], expected.z, EPSILON);
+    }
+  }
+
+  TEST_F(BatchGeometryTest, RayPlaneIntersections)
+  {
+    const Plane<double> plane(Point3<double>(0.0, 0.0, 1.0), Vec3<double>(0.0, 0.0, 1.0));
+    std::vector<double> t;
+    std::vector<uint8_t> hit;
+    rayPlaneIntersections(plane, points, directions, t, hit);
+
+    ASSERT_EQ(t.size(), points.size());
+    for (size_t i = 0; i < points.size(); i += 101)
+    {
+      const double expected_t = (1.0 - points.z[i]) / directions.z[i];
+      EXPECT_EQ(hit[i], expected_t >= 0.0 ? 1U : 0U);
+      if (hit[i])
+      {
+        EXPECT_NEAR(t[i], expected_t, 1e-6 * std::max(1.0, std::abs(expected_t)));
+        EXPECT_NEAR(points.z[i] + t[i] * directions.z[i], 1.0, 1e-6);
+      }
+      else
+      {
+        EXPECT_TRUE(std::isinf(t[i]));
+      }
+    }
+  }
+
+  TEST_F(BatchGeometryTest, RayPlaneParallelRay)
+  {
+    const Plane<double> plane(0.0, 0.0, 1.0, 0.0);
+    const double ox[1] = {0.0}, oy[1] = {0.0}, oz[1] = {1.0};
+    const double dx[1] = {1.0}, dy[1] = {0.0}, dz[1] = {0.0};
+    double t[1];
+    uint8_t hit[1];
+    rayPlaneIntersections(plane, ox, oy, oz, dx, dy, dz, 1, t, hit);
+
+    EXPECT_EQ(hit[0], 0U);
+  }
+
+  TEST_F(BatchGeometryTest, RayTriangleIntersections)
+  {
+    const Triangle3D<double> triangle(Point3<double>(0.0, 0.0, 0.0),
+                                      Point3<double>(1.0, 0.0, 0.0),
+                                      Point3<double>(0.0, 1.0, 0.0));
+
+    PointArray3D<double> origins;
+    PointArray3D<double> dirs;
+    origins.append(Point3<double>(0.2, 0.2, 1.0)); // Straight down, hits
+    dirs.append(Point3<double>(0.0, 0.0, -1.0));
+    origins.append(Point3<double>(0.8, 0.8, 1.0)); // Outside the hypotenuse
+    dirs.append(Point3<double>(0.0, 0.0, -1.0));
+    origins.append(Point3<double>(0.2, 0.2, 1.0)); // Pointing away
+    dirs.append(Point3<double>(0.0, 0.0, 1.0));
+    origins.append(Point3<double>(0.2, 0.2, -2.0)); // From below, hits the back side
+    dirs.append(Point3<double>(0.0, 0.0, 1.0));
+    origins.append(Point3<double>(-1.0, 0.25, 0.0)); // In the triangle plane
+    dirs.append(Point3<double>(1.0, 0.0, 0.0));
+
+    std::vector<double> t;
+    std::vector<uint8_t> hit;
+    rayTriangleIntersections(triangle, origins, dirs, t, hit);
+
+    ASSERT_EQ(hit.size(), 5U);
+    EXPECT_EQ(hit[0], 1U);
+    EXPECT_NEAR(t[0], 1.0, EPSILON);
+    EXPECT_EQ(hit[1], 0U);
+    EXPECT_EQ(hit[2], 0U);
+    EXPECT_EQ(hit[3], 1U);
+    EXPECT_NEAR(t[3], 2.0, EPSILON);
+    EXPECT_EQ(hit[4], 0U);
+  }
+
+  TEST_F(BatchGeometryTest, RayTriangleMatchesPlaneIntersection)
+  {
+    const Triangle3D<double> triangle(Point3<double>(-4.0, -4.0, 0.5),
+                                      Point3<double>(4.0, -4.0, 0.5),
+                                      Point3<double>(0.0, 4.0, 0.5));
+    const Plane<double> plane = planeFromThreePoints(triangle.p0, triangle.p1, triangle.p2);
+
+    std::vector<double> t_triangle, t_plane;
+    std::vector<uint8_t> hit_triangle, hit_plane;
+    rayTriangleIntersections(triangle, points, directions, t_triangle, hit_triangle);
+    rayPlaneIntersections(plane, points, directions, t_plane, hit_plane);
+
+    const Triangle2D<double> triangle_2d(Point2<double>(-4.0, -4.0),
+                                         Point2<double>(4.0, -4.0),
+                                         Point2<double>(0.0, 4.0));
+    size_t num_hits = 0;
+    for (size_t i = 0; i < points.size(); i++)
+    {
+      if (hit_triangle[i])
+      {
+        num_hits++;
+        ASSERT_EQ(hit_plane[i], 1U);
+        EXPECT_NEAR(t_triangle[i], t_plane[i], 1e-6 * std::max(1.0, t_plane[i]));
+
+        const double px = points.x[i] + t_triangle[i] * directions.x[i];
+        const double py = points.y[i] + t_triangle[i] * directions.y[i];
+        uint8_t inside;
+        pointsInTriangle(triangle_2d, &px, &py, 1, &inside);
+        EXPECT_EQ(inside, 1U);
+      }
+    }
+    EXPECT_GT(num_hits, 0U);
+  }
+
+  TEST_F(BatchGeometryTest, PointsInTriangle)
+  {
+    const Triangle2D<double> ccw(Point2<double>(0.0, 0.0), Point2<double>(2.0, 0.0),
+                                 Point2<double>(0.0, 2.0));
+    const Triangle2D<double> cw(ccw.p0, ccw.p2, ccw.p1);
+
+    PointArray2D<double> test_points;
+    test_points.append(Point2<double>(0.5, 0.5));  // Inside
+    test_points.append(Point2<double>(1.5, 1.5));  // Outside
+    test_points.append(Point2<double>(1.0, 0.0));  // On edge
+    test_points.append(Point2<double>(0.0, 0.0));  // On vertex
+    test_points.append(Point2<double>(-0.1, 0.5)); // Outside
+
+    const std::vector<uint8_t> inside_ccw = pointsInTriangle(ccw, test_points);
+    const std::vector<uint8_t> inside_cw = pointsInTriangle(cw, test_points);
+
+    const std::vector<uint8_t> expected = {1U, 0U, 1U, 1U, 0U};
+    EXPECT_EQ(inside_ccw, expected);
+    EXPECT_EQ(inside_cw, expected);
+  }
+
+  // Test fixture for plane and line fitting tests
+  class FittingTest : public ::testing::Test
+  {
+  protected:
+    void SetUp() override
+    {
+      gen.seed(11);
+    }
+
+    // Points on the plane z = 0.5 * x - 0.25 * y + 2 with noise, followed by outliers
+    PointArray3D<double> noisyPlanePoints(const size_t num_inliers, const size_t num_outliers)
+    {
+      std::uniform_real_distribution<double> dist(-10.0, 10.0);
+      std::normal_distribution<double> noise(0.0, 0.01);
+
+      PointArray3D<double> points;
+      for (size_t i = 0; i < num_inliers; i++)
+      {
+        const double x = dist(gen);
+        const double y = dist(gen);
+        points.append(Point3<double>(x, y, 0.5 * x - 0.25 * y + 2.0 + noise(gen)));
+      }
+      for (size_t i = 0; i < num_outliers; i++)
+      {
+        points.append(Point3<double>(dist(gen), dist(gen), dist(gen)));
+      }
+      return points;
+    }
+
+    std::mt19937 gen;
+  };
+
+  TEST_F(FittingTest, PlaneLeastSquares)
+  {
+    const PointArray3D<double> points = noisyPlanePoints(500, 0);
+    const std::optional<Plane<double>> plane = fitPlaneLeastSquares(points);
+    ASSERT_TRUE(plane.has_value());
+
+    // Unit normal parallel to (0.5, -0.25, -1)
+    const Vec3<double> expected_normal = Vec3<double>(0.5, -0.25, -1.0).normalized();
+    const Vec3<double> normal(plane->a, plane->b, plane->c);
+    EXPECT_NEAR(normal.norm(), 1.0, EPSILON);
+    EXPECT_NEAR(std::abs(normal * expected_normal), 1.0, 1e-5);
+    EXPECT_NEAR(plane->evalXY(1.0, 2.0), 0.5 - 0.5 + 2.0, 1e-2);
+  }
+
+  TEST_F(FittingTest, PlaneLeastSquaresDegenerate)
+  {
+    std::vector<Point3<double>> collinear;
+    for (size_t i = 0; i < 10; i++)
+    {
+      collinear.push_back(Point3<double>(i, 2.0 * i, -1.0 * i));
+    }
+
+    EXPECT_FALSE(fitPlaneLeastSquares(collinear).has_value());
+    EXPECT_FALSE(fitPlaneLeastSquares(std::vector<Point3<double>>(2)).has_value());
+  }
+
+  TEST_F(FittingTest, Line3DLeastSquares)
+  {
+    std::vector<Point3<double>> points;
+    for (size_t i = 0; i < 20; i++)
+    {
+      points.push_back(Point3<double>(1.0, 2.0, 3.0) + static_cast<double>(i) * Vec3<double>(1.0, -1.0, 2.0));
+    }
+
+    const std::optional<Line3D<double>> line = fitLine3DLeastSquares(points);
+    ASSERT_TRUE(line.has_value());
+    EXPECT_NEAR(std::abs(line->v * Vec3<double>(1.0, -1.0, 2.0).normalized()), 1.0, EPSILON);
+
+    const Point3<double> closest = line->closestPointOnLineFromPoint(points[7]);
+    EXPECT_NEAR((closest - points[7]).norm(), 0.0, 1e-9);
+  }
+
+  TEST_F(FittingTest, Line2DLeastSquares)
+  {
+    std::vector<Point2<double>> points;
+    for (size_t i = 0; i < 20; i++)
+    {
+      points.push_back(Point2<double>(i, 3.0 * i - 1.0));
+    }
+
+    const std::optional<HomogeneousLine2D<double>> line = fitLine2DLeastSquares(points);
+    ASSERT_TRUE(line.has_value());
+    EXPECT_NEAR(line->a * line->a + line->b * line->b, 1.0, EPSILON);
+    for (const Point2<double> &p : points)
+    {
+      EXPECT_NEAR(line->eval(p), 0.0, 1e-9);
+    }
+  }
+
+  TEST_F(FittingTest, PlaneRansacWithOutliers)
+  {
+    const PointArray3D<double> points = noisyPlanePoints(3000, 2000);
+
+    RansacParameters<double> params;
+    params.inlier_threshold = 0.05;
+    params.seed = 5;
+    const std::optional<FitResult<Plane<double>>> result = fitPlaneRansac(points, params);
+    ASSERT_TRUE(result.has_value());
+
+    const Vec3<double> expected_normal = Vec3<double>(0.5, -0.25, -1.0).normalized();
+    const Vec3<double> normal(result->model.a, result->model.b, result->model.c);
+    EXPECT_NEAR(std::abs(normal * expected_normal), 1.0, 1e-4);
+
+    // All true inliers found, and only a few outliers close to the plane by chance
+    size_t num_true_inliers = 0;
+    for (const size_t idx : result->inlier_indices)
+    {
+      num_true_inliers += idx < 3000 ? 1 : 0;
+    }
+    EXPECT_GE(num_true_inliers, 2990U);
+    EXPECT_LT(result->inlier_indices.size(), 3100U);
+    EXPECT_LE(result->num_iterations, params.max_iterations);
+  }
+
+  TEST_F(FittingTest, RansacIndependentOfThreadCount)
+  {
+    const PointArray3D<double> points = noisyPlanePoints(1000, 1000);
+
+    RansacParameters<double> params;
+    params.inlier_threshold = 0.05;
+    params.refine = false;
+
+    params.num_threads = 1;
+    const std::optional<FitResult<Plane<double>>> r0 = fitPlaneRansac(points, params);
+    params.num_threads = 4;
+    const std::optional<FitResult<Plane<double>>> r1 = fitPlaneRansac(points, params);
+
+    ASSERT_TRUE(r0.has_value());
+    ASSERT_TRUE(r1.has_value());
+    EXPECT_EQ(r0->model.a, r1->model.a);
+    EXPECT_EQ(r0->model.d, r1->model.d);
+    EXPECT_EQ(r0->inlier_indices, r1->inlier_indices);
+  }
+
+  TEST_F(FittingTest, RansacMinInliers)
+  {
+    const PointArray3D<double> points = noisyPlanePoints(0, 500);
+
+    RansacParameters<double> params;
+    params.inlier_threshold = 0.01;
+    params.min_inliers = 100;
+    EXPECT_FALSE(fitPlaneRansac(points, params).has_value());
+  }
+
+  TEST_F(FittingTest, LineRansac)
+  {
+    std::uniform_real_distribution<double> dist(-10.0, 10.0);
+    PointArray3D<double> points_3d;
+    PointArray2D<double> points_2d;
+    for (size_t i = 0; i < 400; i++)
+    {
+      const double t = dist(gen);
+      points_3d.append(Point3<double>(t, 2.0 * t + 1.0, -t));
+      points_2d.append(Point2<double>(t, 2.0 * t + 1.0));
+    }
+    for (size_t i = 0; i < 400; i++)
+    {
+      points_3d.append(Point3<double>(dist(gen), dist(gen), dist(gen)));
+      points_2d.append(Point2<double>(dist(gen), dist(gen)));
+    }
+
+    RansacParameters<double> params;
+    params.inlier_threshold = 0.01;
+
+    const std::optional<FitResult<Line3D<double>>> line_3d = fitLine3DRansac(points_3d, params);
+    ASSERT_TRUE(line_3d.has_value());
+    EXPECT_NEAR(std::abs(line_3d->model.v * Vec3<double>(1.0, 2.0, -1.0).normalized()), 1.0, 1e-9);
+    EXPECT_GE(line_3d->inlier_indices.size(), 400U);
+
+    const std::optional<FitResult<HomogeneousLine2D<double>>> line_2d =
+        fitLine2DRansac(points_2d, params);
+    ASSERT_TRUE(line_2d.has_value());
+    EXPECT_NEAR(line_2d->model.eval(Point2<double>(3.0, 7.0)), 0.0, 1e-3);
+    EXPECT_GE(line_2d->inlier_indices.size(), 400U);
+  }
+
+  TEST_F(FittingTest, ExtractMultiplePlanes)
+  {
+    std::uniform_real_distribution<double> dist(-5.0, 5.0);
+    PointArray3D<double> points;
+    for (size_t i = 0; i < 2000; i++)
+    {
+      points.append(Point3<double>(dist(gen), dist(gen), 0.0)); // Ground
+    }
+    for (size_t i = 0; i < 1000; i++)
+    {
+      points.append(Point3<double>(3.0, dist(gen), dist(gen))); // Wall
+    }
+    for (size_t i = 0; i < 200; i++)
+    {
+      points.append(Point3<double>(dist(gen), dist(gen), dist(gen))); // Clutter
+    }
+
+    RansacParameters<double> params;
+    params.inlier_threshold = 0.01;
+    params.min_inliers = 300;
+    const std::vector<FitResult<Plane<double>>> planes = extractPlanesRansac(points, params, 5);
+
+    ASSERT_EQ(planes.size(), 2U);
+    EXPECT_NEAR(std::abs(planes[0].model.c), 1.0, 1e-9);
+    EXPECT_NEAR(std::abs(planes[1].model.a), 1.0, 1e-9);
+
+    // Inliers refer to the input array and are not shared between planes
+    for (const size_t idx : planes[1].inlier_indices)
+    {
+      EXPECT_NEAR(points.x[idx], 3.0, 1e-9);
+      EXPECT_EQ(std::count(planes[0].inlier_indices.begin(), planes[0].inlier_indices.end(), idx), 0);
+    }
+  }
+
+  // Test fixture for polygon and convex hull tests
+  class PolygonTest : public ::testing::Test
+  {
+  protected:
+    void SetUp() override
+    {
+      gen.seed(17);
+
+      // Concave star with 12 vertices, counter clockwise
+      for (size_t i = 0; i < 12; i++)
+      {
+        const double angle = 2.0 * M_PI * static_cast<double>(i) / 12.0;
+        const double radius = (i % 2 == 0) ? 4.0 : 1.5;
+        star.vertices.push_back(Point2<double>(radius * std::cos(angle), radius * std::sin(angle)));
+      }
+
+      square = Polygon2D<double>({Point2<double>(0.0, 0.0), Point2<double>(2.0, 0.0),
+                                  Point2<double>(2.0, 2.0), Point2<double>(0.0, 2.0)});
+    }
+
+    std::mt19937 gen;
+    Polygon2D<double> star;
+    Polygon2D<double> square;
+  };
+
+  TEST_F(PolygonTest, AreaAndOrientation)
+  {
+    EXPECT_NEAR(square.signedArea(), 4.0, EPSILON);
+    EXPECT_TRUE(square.isCounterClockwise());
+    EXPECT_TRUE(square.isConvex());
+    EXPECT_FALSE(star.isConvex());
+
+    const Polygon2D<double> reversed(std::vector<Point2<double>>(square.vertices.rbegin(), square.vertices.rend()));
+    EXPECT_NEAR(reversed.signedArea(), -4.0, EPSILON);
+    EXPECT_NEAR(reversed.area(), 4.0, EPSILON);
+    EXPECT_TRUE(reversed.isConvex());
+  }
+
+  TEST_F(PolygonTest, Contains)
+  {
+    EXPECT_TRUE(square.contains(Point2<double>(1.0, 1.0)));
+    EXPECT_FALSE(square.contains(Point2<double>(3.0, 1.0)));
+    EXPECT_TRUE(star.contains(Point2<double>(0.0, 0.0)));
+    EXPECT_TRUE(star.contains(Point2<double>(3.5, 0.0)));
+    EXPECT_FALSE(star.contains(Point2<double>(2.5, 1.5)));
+  }
+
+  TEST_F(PolygonTest, PointLocatorMatchesBruteForce)
+  {
+    std::uniform_real_distribution<double> dist(-5.0, 5.0);
+    PointArray2D<double> points;
+    for (size_t i = 0; i < 20000; i++)
+    {
+      points.append(Point2<double>(dist(gen), dist(gen)));
+    }
+
+    for (const size_t num_slabs : {0U, 1U, 7U, 100U})
+    {
+      const PolygonPointLocator<double> locator(star, num_slabs, 4U);
+      const std::vector<uint8_t> inside = locator.contains(points);
+
+      ASSERT_EQ(inside.size(), points.size());
+      for (size_t i = 0; i < points.size(); i++)
+      {
+        EXPECT_EQ(inside[i] != 0U, star.contains(points.point(i)));
+      }
+    }
+
+    // Vertices and points at the top and bottom of the bounding box
+    const PolygonPointLocator<double> locator(star);
+    for (const Point2<double> &v : star.vertices)
+    {
+      EXPECT_EQ(locator.contains(v), star.contains(v));
+    }
+  }
+
+  TEST_F(PolygonTest, ClipPolygon)
+  {
+    const Polygon2D<double> shifted({Point2<double>(1.0, 1.0), Point2<double>(3.0, 1.0),
+                                     Point2<double>(3.0, 3.0), Point2<double>(1.0, 3.0)});
+    EXPECT_NEAR(clipPolygon(square, shifted).area(), 1.0, EPSILON);
+
+    // Clip polygon with clockwise winding gives the same result
+    const Polygon2D<double> shifted_cw(std::vector<Point2<double>>(shifted.vertices.rbegin(), shifted.vertices.rend()));
+    EXPECT_NEAR(clipPolygon(square, shifted_cw).area(), 1.0, EPSILON);
+
+    // Concave subject clipped by a large square is unchanged
+    const Polygon2D<double> large({Point2<double>(-10.0, -10.0), Point2<double>(10.0, -10.0),
+                                   Point2<double>(10.0, 10.0), Point2<double>(-10.0, 10.0)});
+    EXPECT_NEAR(clipPolygon(star, large).area(), star.area(), EPSILON);
+
+    // Clipping the star with the first quadrant gives a quarter of it
+    const Polygon2D<double> quadrant({Point2<double>(0.0, 0.0), Point2<double>(10.0, 0.0),
+                                      Point2<double>(10.0, 10.0), Point2<double>(0.0, 10.0)});
+    EXPECT_NEAR(clipPolygon(star, quadrant).area(), star.area() / 4.0, 1e-9);
+
+    // Disjoint polygons
+    const Polygon2D<double> far({Point2<double>(20.0, 20.0), Point2<double>(21.0, 20.0),
+                                 Point2<double>(21.0, 21.0)});
+    EXPECT_EQ(clipPolygon(square, far).size(), 0U);
+  }
+
+  TEST_F(PolygonTest, ConvexHull2D)
+  {
+    std::vector<Point2<double>> points = {Point2<double>(0.0, 0.0), Point2<double>(1.0, 0.0),
+                                          Point2<double>(2.0, 0.0), Point2<double>(2.0, 2.0),
+                                          Point2<double>(0.0, 2.0), Point2<double>(1.0, 1.0),
+                                          Point2<double>(0.5, 1.5), Point2<double>(2.0, 2.0)};
+
+    const std::vector<size_t> hull = convexHull2DIndices(points);
+    const std::vector<size_t> expected = {0U, 2U, 3U, 4U};
+    EXPECT_EQ(hull, expected);
+
+    const Polygon2D<double> hull_polygon = convexHull2D(points);
+    EXPECT_TRUE(hull_polygon.isCounterClockwise());
+    EXPECT_NEAR(hull_polygon.area(), 4.0, EPSILON);
+  }
+
+  TEST_F(PolygonTest, ConvexHull2DDegenerate)
+  {
+    EXPECT_TRUE(convexHull2DIndices(std::vector<Point2<double>>()).empty());
+    EXPECT_EQ(convexHull2DIndices(std::vector<Point2<double>>(5, Point2<double>(1.0, 1.0))).size(), 1U);
+
+    std::vector<Point2<double>> collinear;
+    for (size_t i = 0; i < 10; i++)
+    {
+      collinear.push_back(Point2<double>(i, 2.0 * i));
+    }
+    const std::vector<size_t> hull = convexHull2DIndices(collinear);
+    ASSERT_EQ(hull.size(), 2U);
+    EXPECT_EQ(hull[0], 0U);
+    EXPECT_EQ(hull[1], 9U);
+  }
+
+  TEST_F(PolygonTest, ConvexHull2DLargeInput)
+  {
+    std::normal_distribution<double> dist(0.0, 3.0);
+    std::vector<Point2<double>> points;
+    for (size_t i = 0; i < 200000; i++)
+    {
+      points.push_back(Point2<double>(dist(gen), dist(gen)));
+    }
+
+    const Polygon2D<double> hull = convexHull2D(points, 4U);
+    ASSERT_GE(hull.size(), 3U);
+    EXPECT_TRUE(hull.isConvex());
+    EXPECT_TRUE(hull.isCounterClockwise());
+
+    // Every point is inside or on the hull
+    for (size_t i = 0; i < points.size(); i += 13)
+    {
+      for (size_t k = 0; k < hull.size(); k++)
+      {
+        const Point2<double> &a = hull.vertices[k];
+        const Point2<double> &b = hull.vertices[(k + 1) % hull.size()];
+        EXPECT_GE((b.x - a.x) * (points[i].y - a.y) - (b.y - a.y) * (points[i].x - a.x), -1e-9);
+      }
+    }
+  }
+
+  TEST_F(PolygonTest, ConvexHull3DCube)
+  {
+    std::uniform_real_distribution<double> dist(-0.99, 0.99);
+    std::vector<Point3<double>> points;
+    for (size_t i = 0; i < 500; i++)
+    {
+      points.push_back(Point3<double>(dist(gen), dist(gen), dist(gen)));
+    }
+    for (size_t i = 0; i < 8; i++)
+    {
+      points.push_back(Point3<double>(i & 1 ? 1.0 : -1.0, i & 2 ? 1.0 : -1.0, i & 4 ? 1.0 : -1.0));
+    }
+
+    const std::optional<ConvexHull3D> hull = convexHull3D(points);
+    ASSERT_TRUE(hull.has_value());
+
+    // The cube corners, triangulated into 12 faces
+    ASSERT_EQ(hull->vertex_indices.size(), 8U);
+    EXPECT_EQ(hull->faces.size(), 12U);
+    for (const uint32_t idx : hull->vertex_indices)
+    {
+      EXPECT_GE(idx, 500U);
+    }
+
+    // Outward orientation: the divergence theorem gives the cube volume
+    double volume = 0.0;
+    for (const IndexTriplet &f : hull->faces)
+    {
+      volume += points[f.i0] * points[f.i1].crossProduct(points[f.i2]) / 6.0;
+    }
+    EXPECT_NEAR(volume, 8.0, 1e-9);
+  }
+
+  TEST_F(PolygonTest, ConvexHull3DSphere)
+  {
+    std::normal_distribution<double> dist(0.0, 1.0);
+    std::vector<Point3<double>> points;
+    for (size_t i = 0; i < 2000; i++)
+    {
+      points.push_back(Vec3<double>(dist(gen), dist(gen), dist(gen)).normalized());
+    }
+
+    const std::optional<ConvexHull3D> hull = convexHull3D(points, 4U);
+    ASSERT_TRUE(hull.has_value());
+
+    // All points on a sphere are hull vertices, and a closed triangulated
+    // surface of genus 0 has 2 * V - 4 faces
+    EXPECT_EQ(hull->vertex_indices.size(), points.size());
+    EXPECT_EQ(hull->faces.size(), 2U * points.size() - 4U);
+
+    for (const IndexTriplet &f : hull->faces)
+    {
+      const Vec3<double> normal = (points[f.i1] - points[f.i0]).crossProduct(points[f.i2] - points[f.i0]);
+      EXPECT_GT(normal * points[f.i0], 0.0);
+    }
+  }
+
+  TEST_F(PolygonTest, ConvexHull3DDegenerate)
+  {
+    std::vector<Point3<double>> coplanar;
+    for (size_t i = 0; i < 20; i++)
+    {
+      coplanar.push_back(Point3<double>(i % 5, i / 5, 1.0));
+    }
+    EXPECT_FALSE(convexHull3D(coplanar).has_value());
+    EXPECT_FALSE(convexHull3D(std::vector<Point3<double>>(3)).has_value());
+  }
+
 } // namespace lumos
 
 int main(int argc, char **argv)
@@ -16,7 +16,7 @@ namespace lumos
   class FixedSizeVector
   {
   private:
-    T data_[N];
+    T data_[N]{};
 
   public:
     constexpr FixedSizeVector() = default;
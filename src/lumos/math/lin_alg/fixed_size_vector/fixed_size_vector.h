@@ -1,3 +1,6 @@
+#ifndef LUMOS_MATH_LIN_ALG_FIXED_SIZE_VECTOR_FIXED_SIZE_VECTOR_H_
+#define LUMOS_MATH_LIN_ALG_FIXED_SIZE_VECTOR_FIXED_SIZE_VECTOR_H_
+
 #include "lumos/math/lin_alg/fixed_size_vector/class_def/fixed_size_vector.h"
 #include <cmath>
 #include <initializer_list>
@@ -104,3 +107,5 @@ namespace lumos
   }
 
 } // namespace lumos
+
+#endif // LUMOS_MATH_LIN_ALG_FIXED_SIZE_VECTOR_FIXED_SIZE_VECTOR_H_
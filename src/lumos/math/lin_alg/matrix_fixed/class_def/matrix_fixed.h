@@ -52,22 +52,24 @@ namespace lumos
   public:
     T data_[R * C];
 
-    FixedSizeMatrix();
+    // Elements are zero initialized, so that matrices can be built up in
+    // constant expressions
+    constexpr FixedSizeMatrix();
     template <typename Y>
-    FixedSizeMatrix(const FixedSizeMatrix<Y, R, C> &m);
+    constexpr FixedSizeMatrix(const FixedSizeMatrix<Y, R, C> &m);
 
     void fillBufferWithData(uint8_t *const buffer) const;
 
-    T &operator()(const size_t r, const size_t c);
-    const T &operator()(const size_t r, const size_t c) const;
+    constexpr T &operator()(const size_t r, const size_t c);
+    constexpr const T &operator()(const size_t r, const size_t c) const;
 
-    size_t numRows() const;
-    size_t numCols() const;
-    size_t size() const;
-    size_t numElements() const;
-    size_t numBytes() const;
+    constexpr size_t numRows() const;
+    constexpr size_t numCols() const;
+    constexpr size_t size() const;
+    constexpr size_t numElements() const;
+    constexpr size_t numBytes() const;
 
-    void fill(const T val);
+    constexpr void fill(const T val);
     T *data() const;
     // Matrix<T, C, R> getTranspose() const;
 
@@ -88,15 +90,18 @@ namespace lumos
       return matrix;
     }
 
-    FixedSizeMatrix<T, C, R> transposed() const;
+    constexpr FixedSizeMatrix<T, C, R> transposed() const;
 
-    std::optional<FixedSizeMatrix<T, R, C>> inverse() const;
-    std::optional<LUMatrices<T, R, C>> luDecomposition() const;
-    std::optional<SVDMatrices<T, R, C>> svd() const;
-    std::optional<QRResult<T, R, C>> qrDecomposition() const;
+    // The decompositions below can be evaluated at compile time, e.g. to
+    // invert a constant calibration matrix
+    constexpr T determinant() const;
+    constexpr std::optional<FixedSizeMatrix<T, R, C>> inverse() const;
+    constexpr std::optional<LUMatrices<T, R, C>> luDecomposition() const;
+    constexpr std::optional<SVDMatrices<T, R, C>> svd() const;
+    constexpr std::optional<QRResult<T, R, C>> qrDecomposition() const;
 
     EigenDecomposition<T, R, C> eigen() const;
-    FixedSizeMatrix<T, R, C> cholesky() const;
+    constexpr FixedSizeMatrix<T, R, C> cholesky() const;
 
     T frobeniusNorm() const;
     T oneNorm() const;
@@ -1,19 +1,44 @@
 #ifndef LUMOS_MATH_LIN_ALG_MATRIX_FIXED_MATRIX_FIXED_H_
 #define LUMOS_MATH_LIN_ALG_MATRIX_FIXED_MATRIX_FIXED_H_
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <limits>
 
 #include "lumos/logging.h"
+#include "lumos/math/lin_alg/fixed_size_vector/fixed_size_vector.h"
 #include "lumos/math/lin_alg/matrix_fixed/class_def/matrix_fixed.h"
+#include "lumos/math/misc/constexpr_math.h"
 #include "lumos/math/misc/math_macros.h"
 
 namespace lumos
 {
+  namespace internal
+  {
+    // inverse() fails for pivots smaller than this times the largest element
+    template <typename T>
+    constexpr T fixedSizeMatrixSingularTolerance()
+    {
+      return std::max(T(1e-12), T(10) * std::numeric_limits<T>::epsilon());
+    }
+
+    template <typename T, uint16_t R, uint16_t C>
+    constexpr T maxAbsElement(const FixedSizeMatrix<T, R, C> &m)
+    {
+      T max_abs = T(0);
+      for (size_t k = 0; k < R * C; k++)
+      {
+        max_abs = std::max(max_abs, constexprAbs(m.data_[k]));
+      }
+      return max_abs;
+    }
+  } // namespace internal
+
   template <typename T, uint16_t R, uint16_t C>
   template <typename Y>
-  FixedSizeMatrix<T, R, C>::FixedSizeMatrix(const FixedSizeMatrix<Y, R, C> &m)
+  constexpr FixedSizeMatrix<T, R, C>::FixedSizeMatrix(const FixedSizeMatrix<Y, R, C> &m)
+      : data_{}
   {
     for (size_t r = 0; r < R; r++)
     {
@@ -25,7 +50,7 @@ namespace lumos
   }
 
   template <typename T, uint16_t R, uint16_t C>
-  FixedSizeMatrix<T, R, C>::FixedSizeMatrix()
+  constexpr FixedSizeMatrix<T, R, C>::FixedSizeMatrix() : data_{}
   {
     static_assert((R * C) < 10001, "Too many elements!");
   }
@@ -39,7 +64,7 @@ namespace lumos
   }
 
   template <typename T, uint16_t R, uint16_t C>
-  size_t FixedSizeMatrix<T, R, C>::size() const
+  constexpr size_t FixedSizeMatrix<T, R, C>::size() const
   {
     return R * C;
   }
@@ -51,32 +76,32 @@ namespace lumos
   }
 
   template <typename T, uint16_t R, uint16_t C>
-  size_t FixedSizeMatrix<T, R, C>::numRows() const
+  constexpr size_t FixedSizeMatrix<T, R, C>::numRows() const
   {
     return R;
   }
 
   template <typename T, uint16_t R, uint16_t C>
-  size_t FixedSizeMatrix<T, R, C>::numCols() const
+  constexpr size_t FixedSizeMatrix<T, R, C>::numCols() const
   {
     return C;
   }
 
   template <typename T, uint16_t R, uint16_t C>
-  size_t FixedSizeMatrix<T, R, C>::numElements() const
+  constexpr size_t FixedSizeMatrix<T, R, C>::numElements() const
   {
     // Returns totalt number of elements in matrix
     return R * C;
   }
 
   template <typename T, uint16_t R, uint16_t C>
-  size_t FixedSizeMatrix<T, R, C>::numBytes() const
+  constexpr size_t FixedSizeMatrix<T, R, C>::numBytes() const
   {
     return R * C * sizeof(T);
   }
 
   template <typename T, uint16_t R, uint16_t C>
-  void FixedSizeMatrix<T, R, C>::fill(T val)
+  constexpr void FixedSizeMatrix<T, R, C>::fill(T val)
   {
     for (size_t k = 0; k < (R * C); k++)
     {
@@ -85,7 +110,7 @@ namespace lumos
   }
 
   template <typename T, uint16_t R, uint16_t C>
-  T &FixedSizeMatrix<T, R, C>::operator()(const size_t r, const size_t c)
+  constexpr T &FixedSizeMatrix<T, R, C>::operator()(const size_t r, const size_t c)
   {
     assert((r < R) && "Row index is larger than R - 1!");
     assert((c < C) && "Column index is larger than C - 1!");
@@ -94,8 +119,8 @@ namespace lumos
   }
 
   template <typename T, uint16_t R, uint16_t C>
-  const T &FixedSizeMatrix<T, R, C>::operator()(const size_t r,
-                                                const size_t c) const
+  constexpr const T &FixedSizeMatrix<T, R, C>::operator()(const size_t r,
+                                                          const size_t c) const
   {
     assert((r < R) && "Row index is larger than R - 1!");
     assert((c < C) && "Column index is larger than C - 1!");
@@ -104,7 +129,7 @@ namespace lumos
   }
 
   template <typename T, uint16_t R, uint16_t C>
-  FixedSizeMatrix<T, C, R> FixedSizeMatrix<T, R, C>::transposed() const
+  constexpr FixedSizeMatrix<T, C, R> FixedSizeMatrix<T, R, C>::transposed() const
   {
     FixedSizeMatrix<T, C, R> m_out;
 
@@ -120,8 +145,8 @@ namespace lumos
   }
 
   template <typename T, uint16_t R0, uint16_t C0, uint16_t R1, uint16_t C1>
-  FixedSizeMatrix<T, R0, C1> operator*(const FixedSizeMatrix<T, R0, C0> &m0,
-                                       const FixedSizeMatrix<T, R1, C1> &m1)
+  constexpr FixedSizeMatrix<T, R0, C1> operator*(const FixedSizeMatrix<T, R0, C0> &m0,
+                                                 const FixedSizeMatrix<T, R1, C1> &m1)
   {
     static_assert(C0 == R1);
     FixedSizeMatrix<T, R0, C1> res;
@@ -142,58 +167,229 @@ namespace lumos
   }
 
   template <typename T, uint16_t R, uint16_t C>
-  FixedSizeMatrix<T, R, C> unitMatrix();
+  constexpr FixedSizeMatrix<T, R, C> operator+(const FixedSizeMatrix<T, R, C> &m0,
+                                               const FixedSizeMatrix<T, R, C> &m1)
+  {
+    FixedSizeMatrix<T, R, C> res;
+    for (size_t i = 0; i < R * C; i++)
+    {
+      res.data_[i] = m0.data_[i] + m1.data_[i];
+    }
+    return res;
+  }
+
+  template <typename T, uint16_t R, uint16_t C>
+  constexpr FixedSizeMatrix<T, R, C> operator-(const FixedSizeMatrix<T, R, C> &m0,
+                                               const FixedSizeMatrix<T, R, C> &m1)
+  {
+    FixedSizeMatrix<T, R, C> res;
+    for (size_t i = 0; i < R * C; i++)
+    {
+      res.data_[i] = m0.data_[i] - m1.data_[i];
+    }
+    return res;
+  }
+
+  template <typename T, uint16_t R, uint16_t C>
+  constexpr FixedSizeMatrix<T, R, C> operator-(const FixedSizeMatrix<T, R, C> &m)
+  {
+    FixedSizeMatrix<T, R, C> res;
+    for (size_t i = 0; i < R * C; i++)
+    {
+      res.data_[i] = -m.data_[i];
+    }
+    return res;
+  }
+
+  template <typename T, uint16_t R, uint16_t C>
+  constexpr FixedSizeMatrix<T, R, C> operator*(const FixedSizeMatrix<T, R, C> &m, const T f)
+  {
+    FixedSizeMatrix<T, R, C> res;
+    for (size_t i = 0; i < R * C; i++)
+    {
+      res.data_[i] = m.data_[i] * f;
+    }
+    return res;
+  }
+
+  template <typename T, uint16_t R, uint16_t C>
+  constexpr FixedSizeMatrix<T, R, C> operator*(const T f, const FixedSizeMatrix<T, R, C> &m)
+  {
+    return m * f;
+  }
+
+  template <typename T, uint16_t R, uint16_t C>
+  constexpr FixedSizeMatrix<T, R, C> unitMatrix();
+
+  template <typename T, uint16_t R, uint16_t C>
+  constexpr FixedSizeMatrix<T, R, C> zerosMatrix();
+
+  template <typename T, uint16_t R, uint16_t C>
+  constexpr T FixedSizeMatrix<T, R, C>::determinant() const
+  {
+    static_assert(R == C, "Matrix must be square for the determinant.");
+    const FixedSizeMatrix<T, R, C> &m = *this;
+
+    if constexpr (R == 1)
+    {
+      return m(0, 0);
+    }
+    else if constexpr (R == 2)
+    {
+      return m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0);
+    }
+    else if constexpr (R == 3)
+    {
+      return m(0, 0) * (m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1)) -
+             m(0, 1) * (m(1, 0) * m(2, 2) - m(1, 2) * m(2, 0)) +
+             m(0, 2) * (m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0));
+    }
+    else
+    {
+      // Product of the pivots of PA = LU, negated for every transposition in P
+      const std::optional<LUMatrices<T, R, C>> lu = luDecomposition();
+      if (!lu.has_value())
+      {
+        return std::numeric_limits<T>::quiet_NaN();
+      }
+
+      T det = T(1);
+      for (uint16_t i = 0; i < R; ++i)
+      {
+        det *= lu->u_matrix(i, i);
+      }
+
+      FixedSizeVector<uint16_t, R> p = lu->row_permutation;
+      for (uint16_t i = 0; i < R; ++i)
+      {
+        while (p[i] != i)
+        {
+          internal::constexprSwap(p[i], p[p[i]]);
+          det = -det;
+        }
+      }
+      return det;
+    }
+  }
 
   template <typename T, uint16_t R, uint16_t C>
-  std::optional<FixedSizeMatrix<T, R, C>> FixedSizeMatrix<T, R, C>::inverse() const
+  constexpr std::optional<FixedSizeMatrix<T, R, C>> FixedSizeMatrix<T, R, C>::inverse() const
   {
     static_assert(R == C, "Matrix must be square to invert.");
-    FixedSizeMatrix<T, R, C> a(*this);
-    FixedSizeMatrix<T, R, C> inv = unitMatrix<T, R, C>();
+    const T max_abs = internal::maxAbsElement(*this);
 
-    for (size_t i = 0; i < R; ++i)
+    if constexpr (R <= 3)
     {
-      // Find pivot
-      const T pivot = a(i, i);
-      if (std::abs(pivot) < 1e-12)
+      // Adjugate divided by the determinant, straight-line code for the
+      // common 2x2 and 3x3 cases
+      T det_tolerance = internal::fixedSizeMatrixSingularTolerance<T>();
+      for (uint16_t i = 0; i < R; ++i)
+      {
+        det_tolerance *= max_abs;
+      }
+      const T det = determinant();
+      if (!(internal::constexprAbs(det) > det_tolerance))
       {
         return std::nullopt;
       }
-      // Normalize row
-      for (size_t j = 0; j < C; ++j)
+
+      const T inv_det = T(1) / det;
+      const FixedSizeMatrix<T, R, C> &m = *this;
+      FixedSizeMatrix<T, R, C> inv;
+      if constexpr (R == 1)
+      {
+        inv(0, 0) = inv_det;
+      }
+      else if constexpr (R == 2)
       {
-        a(i, j) /= pivot;
-        inv(i, j) /= pivot;
+        inv(0, 0) = m(1, 1) * inv_det;
+        inv(0, 1) = -m(0, 1) * inv_det;
+        inv(1, 0) = -m(1, 0) * inv_det;
+        inv(1, 1) = m(0, 0) * inv_det;
       }
-      // Eliminate other rows
-      for (size_t k = 0; k < R; ++k)
+      else
       {
-        if (k == i)
-          continue;
-        T factor = a(k, i);
+        inv(0, 0) = (m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1)) * inv_det;
+        inv(0, 1) = (m(0, 2) * m(2, 1) - m(0, 1) * m(2, 2)) * inv_det;
+        inv(0, 2) = (m(0, 1) * m(1, 2) - m(0, 2) * m(1, 1)) * inv_det;
+        inv(1, 0) = (m(1, 2) * m(2, 0) - m(1, 0) * m(2, 2)) * inv_det;
+        inv(1, 1) = (m(0, 0) * m(2, 2) - m(0, 2) * m(2, 0)) * inv_det;
+        inv(1, 2) = (m(0, 2) * m(1, 0) - m(0, 0) * m(1, 2)) * inv_det;
+        inv(2, 0) = (m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0)) * inv_det;
+        inv(2, 1) = (m(0, 1) * m(2, 0) - m(0, 0) * m(2, 1)) * inv_det;
+        inv(2, 2) = (m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0)) * inv_det;
+      }
+      return inv;
+    }
+    else
+    {
+      // Gauss-Jordan elimination with partial pivoting
+      const T tolerance = internal::fixedSizeMatrixSingularTolerance<T>() * max_abs;
+      FixedSizeMatrix<T, R, C> a(*this);
+      FixedSizeMatrix<T, R, C> inv = unitMatrix<T, R, C>();
+
+      for (size_t i = 0; i < R; ++i)
+      {
+        size_t pivot_row = i;
+        for (size_t k = i + 1; k < R; ++k)
+        {
+          if (internal::constexprAbs(a(k, i)) > internal::constexprAbs(a(pivot_row, i)))
+          {
+            pivot_row = k;
+          }
+        }
+        if (!(internal::constexprAbs(a(pivot_row, i)) > tolerance))
+        {
+          return std::nullopt;
+        }
+        if (pivot_row != i)
+        {
+          for (size_t j = 0; j < C; ++j)
+          {
+            internal::constexprSwap(a(i, j), a(pivot_row, j));
+            internal::constexprSwap(inv(i, j), inv(pivot_row, j));
+          }
+        }
+
+        // Normalize row
+        const T inv_pivot = T(1) / a(i, i);
         for (size_t j = 0; j < C; ++j)
         {
-          a(k, j) -= factor * a(i, j);
-          inv(k, j) -= factor * inv(i, j);
+          a(i, j) *= inv_pivot;
+          inv(i, j) *= inv_pivot;
+        }
+        // Eliminate other rows
+        for (size_t k = 0; k < R; ++k)
+        {
+          if (k == i)
+            continue;
+          const T factor = a(k, i);
+          for (size_t j = 0; j < C; ++j)
+          {
+            a(k, j) -= factor * a(i, j);
+            inv(k, j) -= factor * inv(i, j);
+          }
         }
       }
+      return inv;
     }
-    return inv;
   }
 
   template <typename T, uint16_t R, uint16_t C>
-  std::optional<LUMatrices<T, R, C>> FixedSizeMatrix<T, R, C>::luDecomposition() const
+  constexpr std::optional<LUMatrices<T, R, C>> FixedSizeMatrix<T, R, C>::luDecomposition() const
   {
+    // Gaussian elimination with partial pivoting, the multipliers are kept
+    // below the diagonal of a. A column without a nonzero pivot is skipped, so
+    // rank deficient matrices give zeros on the diagonal of U. Fails only for
+    // matrices with non-finite elements
     LUMatrices<T, R, C> result;
     constexpr uint16_t K = LUMatrices<T, R, C>::K;
     auto &L = result.l_matrix;
     auto &U = result.u_matrix;
     auto &P = result.row_permutation;
 
-    // Copy of A (mutable)
-    FixedSizeMatrix<T, R, C> A = *this;
+    FixedSizeMatrix<T, R, C> a(*this);
 
-    // Initialize permutation vector
     for (uint16_t i = 0; i < R; ++i)
     {
       P[i] = i;
@@ -201,79 +397,71 @@ namespace lumos
 
     for (uint16_t i = 0; i < K; ++i)
     {
-      // Partial pivoting: find max in column i
       uint16_t pivot_row = i;
-      T max_val = std::abs(A(P[i], i));
       for (uint16_t j = i + 1; j < R; ++j)
       {
-        T val = std::abs(A(P[j], i));
-        if (val > max_val)
+        if (internal::constexprAbs(a(j, i)) > internal::constexprAbs(a(pivot_row, i)))
         {
-          max_val = val;
           pivot_row = j;
         }
       }
 
-      // Failure if pivot is too small
-      if (max_val < T(1e-12))
+      if (pivot_row != i)
       {
-        return std::nullopt; // Matrix is singular or nearly singular
+        internal::constexprSwap(P[i], P[pivot_row]);
+        for (uint16_t c = 0; c < C; ++c)
+        {
+          internal::constexprSwap(a(i, c), a(pivot_row, c));
+        }
       }
 
-      // Swap rows in permutation vector
-      if (pivot_row != i)
+      const T pivot = a(i, i);
+      if (!(internal::constexprAbs(pivot) <= std::numeric_limits<T>::max()))
       {
-        std::swap(P[i], P[pivot_row]);
+        return std::nullopt;
       }
-
-      // Compute U(i, j)
-      for (uint16_t j = i; j < C; ++j)
+      if (pivot == T(0))
       {
-        T sum = 0;
-        for (uint16_t k = 0; k < i; ++k)
-        {
-          sum += L(i, k) * U(k, j);
-        }
-
-        U(i, j) = A(P[i], j) - sum;
+        continue;
       }
 
-      // Compute L(j, i)
       for (uint16_t j = i + 1; j < R; ++j)
       {
-        T sum = 0;
-        for (uint16_t k = 0; k < i; ++k)
+        const T factor = a(j, i) / pivot;
+        a(j, i) = factor;
+        for (uint16_t c = i + 1; c < C; ++c)
         {
-          sum += L(j, k) * U(k, i);
+          a(j, c) -= factor * a(i, c);
         }
-
-        T u_ii = U(i, i);
-        if (std::abs(u_ii) < T(1e-12))
-        {
-          return std::nullopt; // division by zero risk
-        }
-
-        L(j, i) = (A(P[j], i) - sum) / u_ii;
       }
     }
 
-    // Set unit diagonal in L
-    for (uint16_t i = 0; i < K; ++i)
+    for (uint16_t r = 0; r < R; ++r)
+    {
+      for (uint16_t k = 0; k < K; ++k)
+      {
+        L(r, k) = (r > k) ? a(r, k) : ((r == k) ? T(1) : T(0));
+      }
+    }
+    for (uint16_t k = 0; k < K; ++k)
     {
-      L(i, i) = 1;
+      for (uint16_t c = 0; c < C; ++c)
+      {
+        U(k, c) = (c >= k) ? a(k, c) : T(0);
+      }
     }
 
     return result;
   }
 
   template <typename T, uint16_t R, uint16_t C>
-  std::optional<SVDMatrices<T, R, C>> FixedSizeMatrix<T, R, C>::svd() const
+  constexpr std::optional<SVDMatrices<T, R, C>> FixedSizeMatrix<T, R, C>::svd() const
   {
     constexpr uint16_t M = R;
     constexpr uint16_t N = C;
 
     constexpr uint16_t max_iterations{100U};
-    constexpr T tol{1e-9};
+    const T tol = std::max(static_cast<T>(1e-9), std::numeric_limits<T>::epsilon());
 
     // Working copy
     FixedSizeMatrix<T, M, N> A = *this;
@@ -316,15 +504,15 @@ namespace lumos
             gamma += A(i, p) * A(i, q);
           }
 
-          if (std::abs(gamma) <= tol * std::sqrt(alpha * beta))
+          if (internal::constexprAbs(gamma) <= tol * internal::constexprSqrt(alpha * beta))
             continue;
 
           converged = false;
 
           T zeta = (beta - alpha) / (2 * gamma);
           T t = ((zeta >= 0) ? 1 : -1) /
-                (std::abs(zeta) + std::sqrt(1 + zeta * zeta));
-          T c = 1 / std::sqrt(1 + t * t);
+                (internal::constexprAbs(zeta) + internal::constexprSqrt(1 + zeta * zeta));
+          T c = 1 / internal::constexprSqrt(1 + t * t);
           T s = c * t;
 
           for (uint16_t i = 0; i < M; ++i)
@@ -353,12 +541,13 @@ namespace lumos
 
     // Compute singular values and U
     FixedSizeMatrix<T, M, N> S_diag;
+    S_diag.fill(T(0));
     for (uint16_t j = 0; j < N; ++j)
     {
       T norm = T(0);
       for (uint16_t i = 0; i < M; ++i)
         norm += A(i, j) * A(i, j);
-      norm = std::sqrt(norm);
+      norm = internal::constexprSqrt(norm);
 
       for (uint16_t i = 0; i < M; ++i)
         U(i, j) = (norm > tol) ? A(i, j) / norm : 0;
@@ -368,18 +557,16 @@ namespace lumos
     }
 
     // Fill result
+    // A = U * S * V^T
     SVDMatrices<T, R, C> result;
-    result.U = U;
-    result.S = S_diag;
-    // V in Jacobi method is actually V, but we want Vt
-    for (uint16_t i = 0; i < N; ++i)
-      for (uint16_t j = 0; j < N; ++j)
-        result.Vt(i, j) = V(j, i);
+    result.u_matrix = U;
+    result.sigma_matrix = S_diag;
+    result.v_matrix = V;
 
     return result;
   }
   template <typename T, uint16_t R, uint16_t C>
-  std::optional<QRResult<T, R, C>> FixedSizeMatrix<T, R, C>::qrDecomposition() const
+  constexpr std::optional<QRResult<T, R, C>> FixedSizeMatrix<T, R, C>::qrDecomposition() const
   {
     static_assert(R >= C, "QR decomposition requires R >= C.");
 
@@ -399,7 +586,7 @@ namespace lumos
       {
         norm_x += A_work(i, k) * A_work(i, k);
       }
-      norm_x = std::sqrt(norm_x);
+      norm_x = internal::constexprSqrt(norm_x);
 
       if (norm_x == T(0))
       {
@@ -590,11 +777,40 @@ namespace lumos
   }
 
   template <typename T, uint16_t R, uint16_t C>
-  FixedSizeMatrix<T, R, C> FixedSizeMatrix<T, R, C>::cholesky() const
+  constexpr FixedSizeMatrix<T, R, C> FixedSizeMatrix<T, R, C>::cholesky() const
   {
     static_assert(R == C, "Matrix must be square for Cholesky decomposition.");
-    // Dummy implementation: returns a unit matrix of the same size
-    return unitMatrix<T, R, C>();
+    // Lower triangular L with L * L^T = A, only the lower triangle of A is
+    // read. Columns after a non-positive pivot are left zero, so the result of
+    // a matrix that is not positive definite has a zero on the diagonal
+    FixedSizeMatrix<T, R, C> l = zerosMatrix<T, R, C>();
+
+    for (size_t j = 0; j < R; ++j)
+    {
+      T diag = (*this)(j, j);
+      for (size_t k = 0; k < j; ++k)
+      {
+        diag -= l(j, k) * l(j, k);
+      }
+      if (!(diag > T(0)))
+      {
+        return l;
+      }
+      l(j, j) = internal::constexprSqrt(diag);
+
+      const T inv_diag = T(1) / l(j, j);
+      for (size_t i = j + 1; i < R; ++i)
+      {
+        T sum = (*this)(i, j);
+        for (size_t k = 0; k < j; ++k)
+        {
+          sum -= l(i, k) * l(j, k);
+        }
+        l(i, j) = sum * inv_diag;
+      }
+    }
+
+    return l;
   }
 
   /*template <typename T, uint16_t R, uint16_t C>
@@ -885,7 +1101,7 @@ namespace lumos
   }*/
 
   template <typename T, uint16_t R, uint16_t C>
-  FixedSizeMatrix<T, R, C> unitMatrix()
+  constexpr FixedSizeMatrix<T, R, C> unitMatrix()
   {
     FixedSizeMatrix<T, R, C> unit_matrix;
     for (size_t r = 0; r < R; r++)
@@ -906,7 +1122,7 @@ namespace lumos
   }
 
   template <typename T, uint16_t R, uint16_t C>
-  FixedSizeMatrix<T, R, C> zerosMatrix()
+  constexpr FixedSizeMatrix<T, R, C> zerosMatrix()
   {
     FixedSizeMatrix<T, R, C> zero_matrix;
     for (size_t r = 0; r < R; r++)
@@ -920,7 +1136,7 @@ namespace lumos
   }
 
   template <typename T, uint16_t R, uint16_t C>
-  FixedSizeMatrix<T, R, C> onesMatrix()
+  constexpr FixedSizeMatrix<T, R, C> onesMatrix()
   {
     FixedSizeMatrix<T, R, C> ones_matrix;
     for (size_t r = 0; r < R; r++)
@@ -1091,7 +1307,7 @@ namespace lumos
   }
 
   template <typename T, uint16_t R, uint16_t C>
-  FixedSizeMatrix<T, R, C> unitFixedSizeMatrix()
+  constexpr FixedSizeMatrix<T, R, C> unitFixedSizeMatrix()
   {
     FixedSizeMatrix<T, R, C> unit_mat;
 
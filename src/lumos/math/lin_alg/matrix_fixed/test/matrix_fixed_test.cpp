@@ -179,6 +179,57 @@ namespace lumos
         EXPECT_DOUBLE_EQ(result(1, 1), 154.0); // 4*8 + 5*10 + 6*12
     }
 
+    TEST_F(FixedSizeMatrixTest, ElementwiseArithmetic)
+    {
+        FixedSizeMatrix<double, 2, 2> a;
+        a(0, 0) = 1.0; a(0, 1) = 2.0;
+        a(1, 0) = 3.0; a(1, 1) = 4.0;
+        FixedSizeMatrix<double, 2, 2> b;
+        b(0, 0) = 0.5; b(0, 1) = -1.0;
+        b(1, 0) = 2.0; b(1, 1) = 0.0;
+
+        const auto sum = a + b;
+        const auto diff = a - b;
+        const auto neg = -a;
+        const auto scaled = 2.0 * a * 0.5;
+
+        for (size_t r = 0; r < 2; r++)
+        {
+            for (size_t c = 0; c < 2; c++)
+            {
+                EXPECT_DOUBLE_EQ(sum(r, c), a(r, c) + b(r, c));
+                EXPECT_DOUBLE_EQ(diff(r, c), a(r, c) - b(r, c));
+                EXPECT_DOUBLE_EQ(neg(r, c), -a(r, c));
+                EXPECT_DOUBLE_EQ(scaled(r, c), a(r, c));
+            }
+        }
+    }
+
+    TEST_F(FixedSizeMatrixTest, Cholesky)
+    {
+        FixedSizeMatrix<double, 3, 3> A;
+        A(0, 0) = 4.0;  A(0, 1) = 12.0;  A(0, 2) = -16.0;
+        A(1, 0) = 12.0; A(1, 1) = 37.0;  A(1, 2) = -43.0;
+        A(2, 0) = -16.0; A(2, 1) = -43.0; A(2, 2) = 98.0;
+
+        // Textbook example, L = [2 0 0; 6 1 0; -8 5 3]
+        const auto L = A.cholesky();
+        const double expected[3][3] = {{2.0, 0.0, 0.0}, {6.0, 1.0, 0.0}, {-8.0, 5.0, 3.0}};
+        for (size_t r = 0; r < 3; r++)
+        {
+            for (size_t c = 0; c < 3; c++)
+            {
+                EXPECT_NEAR(L(r, c), expected[r][c], epsilon);
+            }
+        }
+
+        // Not positive definite, the failing pivot is left at zero
+        FixedSizeMatrix<double, 2, 2> B;
+        B(0, 0) = 1.0; B(0, 1) = 2.0;
+        B(1, 0) = 2.0; B(1, 1) = 1.0;
+        EXPECT_EQ(B.cholesky()(1, 1), 0.0);
+    }
+
     // ==============================================================================
     // Statistical Operations Tests
     // ==============================================================================
@@ -1178,6 +1229,192 @@ namespace lumos
         EXPECT_NEAR(A(P[0], 0), L(0, 0) * U(0, 0), epsilon);
     }
 
+    TEST_F(FixedSizeMatrixTest, SVD_ReconstructsMatrix)
+    {
+        FixedSizeMatrix<double, 3, 3> A;
+        A(0, 0) = 4.0; A(0, 1) = 1.0; A(0, 2) = -2.0;
+        A(1, 0) = 1.0; A(1, 1) = 3.0; A(1, 2) = 0.5;
+        A(2, 0) = -2.0; A(2, 1) = 0.5; A(2, 2) = 5.0;
+
+        const auto svd_result = A.svd();
+        ASSERT_TRUE(svd_result.has_value());
+
+        const auto &U = svd_result->u_matrix;
+        const auto &S = svd_result->sigma_matrix;
+        const auto &V = svd_result->v_matrix;
+
+        // A = U * S * V^T
+        for (size_t r = 0; r < 3; r++)
+        {
+            for (size_t c = 0; c < 3; c++)
+            {
+                double val = 0.0;
+                for (size_t k = 0; k < 3; k++)
+                {
+                    val += U(r, k) * S(k, k) * V(c, k);
+                }
+                EXPECT_NEAR(val, A(r, c), 1e-9);
+            }
+        }
+
+        // Off diagonal singular value entries are zero
+        EXPECT_EQ(S(0, 1), 0.0);
+        EXPECT_EQ(S(2, 0), 0.0);
+    }
+
+    TEST_F(FixedSizeMatrixTest, SVD_FloatType)
+    {
+        FixedSizeMatrix<float, 2, 2> A;
+        A(0, 0) = 2.0f; A(0, 1) = 0.0f;
+        A(1, 0) = 0.0f; A(1, 1) = 0.5f;
+
+        const auto svd_result = A.svd();
+        ASSERT_TRUE(svd_result.has_value());
+        EXPECT_NEAR(svd_result->sigma_matrix(0, 0) * svd_result->sigma_matrix(1, 1), 1.0f, 1e-5f);
+    }
+
+    // ==============================================================================
+    // Compile-time Decomposition Tests
+    // ==============================================================================
+
+    namespace
+    {
+        // Pinhole camera intrinsics, known at compile time
+        constexpr FixedSizeMatrix<double, 3, 3> cameraMatrix()
+        {
+            FixedSizeMatrix<double, 3, 3> k;
+            k(0, 0) = 500.0;
+            k(0, 2) = 320.0;
+            k(1, 1) = 400.0;
+            k(1, 2) = 240.0;
+            k(2, 2) = 1.0;
+            return k;
+        }
+
+        // Needs pivoting, the first diagonal element is zero
+        constexpr FixedSizeMatrix<double, 4, 4> permutedMatrix()
+        {
+            FixedSizeMatrix<double, 4, 4> m;
+            m(0, 1) = 2.0;
+            m(0, 3) = 1.0;
+            m(1, 0) = 1.0;
+            m(1, 1) = 1.0;
+            m(2, 2) = 4.0;
+            m(2, 3) = 1.0;
+            m(3, 0) = 3.0;
+            m(3, 2) = 1.0;
+            m(3, 3) = 2.0;
+            return m;
+        }
+
+        constexpr FixedSizeMatrix<double, 3, 3> spdMatrix()
+        {
+            FixedSizeMatrix<double, 3, 3> m;
+            m(0, 0) = 4.0;
+            m(0, 1) = 2.0;
+            m(0, 2) = 0.4;
+            m(1, 0) = 2.0;
+            m(1, 1) = 5.0;
+            m(1, 2) = 1.0;
+            m(2, 0) = 0.4;
+            m(2, 1) = 1.0;
+            m(2, 2) = 3.0;
+            return m;
+        }
+
+        template <uint16_t R, uint16_t C>
+        constexpr double maxDifference(const FixedSizeMatrix<double, R, C> &a,
+                                       const FixedSizeMatrix<double, R, C> &b)
+        {
+            return internal::maxAbsElement(a - b);
+        }
+    } // namespace
+
+    TEST_F(FixedSizeMatrixTest, ConstexprInverse)
+    {
+        constexpr FixedSizeMatrix<double, 3, 3> k_inv = cameraMatrix().inverse().value();
+        static_assert(k_inv(0, 0) == 1.0 / 500.0, "fx is inverted at compile time");
+        static_assert(maxDifference(cameraMatrix() * k_inv, unitMatrix<double, 3, 3>()) < 1e-12,
+                      "K * K^-1 = I");
+
+        constexpr FixedSizeMatrix<double, 4, 4> m_inv = permutedMatrix().inverse().value();
+        static_assert(maxDifference(permutedMatrix() * m_inv, unitMatrix<double, 4, 4>()) < 1e-14,
+                      "Gauss-Jordan with pivoting");
+        static_assert(!zerosMatrix<double, 4, 4>().inverse().has_value(), "singular matrix");
+
+        EXPECT_NEAR(k_inv(1, 2), -240.0 / 400.0, epsilon);
+    }
+
+    TEST_F(FixedSizeMatrixTest, ConstexprDeterminant)
+    {
+        static_assert(cameraMatrix().determinant() == 500.0 * 400.0, "3x3 closed form");
+        constexpr double det = permutedMatrix().determinant();
+        // Cofactor expansion of permutedMatrix()
+        static_assert(internal::constexprAbs(det - (-26.0)) < 1e-12, "determinant from LU");
+
+        FixedSizeMatrix<double, 4, 4> scaled = permutedMatrix() * 2.0;
+        EXPECT_NEAR(scaled.determinant(), 16.0 * det, 1e-10);
+    }
+
+    TEST_F(FixedSizeMatrixTest, ConstexprLUDecomposition)
+    {
+        constexpr LUMatrices<double, 4, 4> lu = permutedMatrix().luDecomposition().value();
+        static_assert(lu.row_permutation[0] == 3, "largest pivot in the first column");
+
+        FixedSizeMatrix<double, 4, 4> pa;
+        for (uint16_t r = 0; r < 4; ++r)
+        {
+            for (uint16_t c = 0; c < 4; ++c)
+            {
+                pa(r, c) = permutedMatrix()(lu.row_permutation[r], c);
+            }
+        }
+        EXPECT_LT(maxDifference(pa, lu.l_matrix * lu.u_matrix), epsilon);
+    }
+
+    TEST_F(FixedSizeMatrixTest, ConstexprCholeskyQRAndSVD)
+    {
+        constexpr FixedSizeMatrix<double, 3, 3> l = spdMatrix().cholesky();
+        static_assert(maxDifference(l * l.transposed(), spdMatrix()) < 1e-14, "L * L^T = A");
+
+        constexpr QRResult<double, 3, 3> qr = spdMatrix().qrDecomposition().value();
+        static_assert(maxDifference(qr.q * qr.r, spdMatrix()) < 1e-14, "Q * R = A");
+
+        constexpr SVDMatrices<double, 3, 3> svd = spdMatrix().svd().value();
+        static_assert(maxDifference(svd.u_matrix * svd.sigma_matrix * svd.v_matrix.transposed(),
+                                    spdMatrix()) < 1e-12,
+                      "U * S * V^T = A");
+
+        // Compile time square roots are within an ulp of std::sqrt
+        static_assert(internal::constexprAbs(internal::constexprSqrt(2.0) - 1.4142135623730951) < 3e-16,
+                      "sqrt(2)");
+        constexpr double tiny_root = internal::constexprSqrt(1e-300);
+        EXPECT_NEAR(tiny_root, std::sqrt(1e-300), 1e-165);
+        EXPECT_NEAR(l(0, 0), 2.0, epsilon);
+    }
+
+    TEST_F(FixedSizeMatrixTest, InverseNeedsPivotingAndScaling)
+    {
+        // Zero on the diagonal, failed without row exchanges
+        FixedSizeMatrix<double, 2, 2> swap;
+        swap(0, 1) = 1.0;
+        swap(1, 0) = 1.0;
+        const auto swap_inv = swap.inverse();
+        ASSERT_TRUE(swap_inv.has_value());
+        EXPECT_NEAR((*swap_inv)(0, 1), 1.0, epsilon);
+
+        // Small but well conditioned, e.g. a covariance of small variances
+        FixedSizeMatrix<double, 3, 3> small = spdMatrix() * 1e-8;
+        const auto small_inv = small.inverse();
+        ASSERT_TRUE(small_inv.has_value());
+        EXPECT_LT(maxDifference(small * (*small_inv), unitMatrix<double, 3, 3>()), epsilon);
+
+        FixedSizeMatrix<double, 5, 5> big = unitMatrix<double, 5, 5>() * 1e-9;
+        big(0, 4) = 2e-9;
+        ASSERT_TRUE(big.inverse().has_value());
+        EXPECT_NEAR((*big.inverse())(0, 0), 1e9, 1e-3);
+    }
+
 } // namespace lumos
 
 int main(int argc, char **argv)
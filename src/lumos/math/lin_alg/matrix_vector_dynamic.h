@@ -12,24 +12,6 @@
 
 namespace lumos
 {
-  template <typename T>
-  Matrix<T> Vec3<T>::toCrossProductMatrix() const
-  {
-    Matrix<T> m(3, 3);
-    m(0, 0) = 0.0;
-    m(0, 1) = -z;
-    m(0, 2) = y;
-
-    m(1, 0) = z;
-    m(1, 1) = 0.0;
-    m(1, 2) = -x;
-
-    m(2, 0) = -y;
-    m(2, 1) = x;
-    m(2, 2) = 0.0;
-    return m;
-  }
-
   template <typename T>
   Matrix<T> diagMatrix(const Vec3<T> &v)
   {
@@ -12,20 +12,24 @@ namespace lumos
     T y;
     T z;
 
-    Vec3(const T x_, const T y_, const T z_);
+    constexpr Vec3(const T x_, const T y_, const T z_);
     template <typename Y>
-    Vec3(const Vec3<Y> &v);
+    constexpr Vec3(const Vec3<Y> &v);
     Vec3();
 
     Vec3<T> normalized() const;
     Vec3<T> vectorBetweenPoints(const Point3<T> &end_point) const;
     Vec3<T> normalizedVectorBetweenPoints(const Point3<T> &end_point) const;
-    T squaredNorm() const;
+    constexpr T squaredNorm() const;
     T norm() const;
-    Vec3<T> elementWiseMultiply(const Vec3<T> &factor_vector) const;
-    Vec3<T> elementWiseDivide(const Vec3<T> &numerator_vector) const;
-    Vec3<T> crossProduct(const Vec3<T> &right_vector) const;
-    Matrix<T> toCrossProductMatrix() const;
+    constexpr Vec3<T> elementWiseMultiply(const Vec3<T> &factor_vector) const;
+    constexpr Vec3<T> elementWiseDivide(const Vec3<T> &numerator_vector) const;
+    constexpr Vec3<T> crossProduct(const Vec3<T> &right_vector) const;
+    // [v]x with [v]x * u = v x u, on the stack
+    FixedSizeMatrix<T, 3, 3> toCrossProductMatrix() const;
+    FixedSizeVector<T, 3> toFixedSizeVector() const;
+    // As a 3 x 1 column, for use with FixedSizeMatrix arithmetic
+    FixedSizeMatrix<T, 3, 1> toColumnMatrix() const;
     T angleBetweenVectors(const Vec3<T> &v) const;
   };
 
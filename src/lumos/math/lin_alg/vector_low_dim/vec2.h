@@ -3,6 +3,7 @@
 
 #include <cmath>
 
+#include "lumos/math/lin_alg/matrix_fixed/matrix_fixed.h"
 #include "lumos/math/lin_alg/vector_low_dim/class_def/vec2.h"
 
 namespace lumos
@@ -149,6 +150,24 @@ namespace lumos
     return res;
   }
 
+  template <typename T>
+  Vec2<T> operator*(const FixedSizeMatrix<T, 2, 2> &m, const Vec2<T> &v)
+  {
+    Vec2<T> res;
+    res.x = m(0, 0) * v.x + m(0, 1) * v.y;
+    res.y = m(1, 0) * v.x + m(1, 1) * v.y;
+    return res;
+  }
+
+  template <typename T>
+  Vec2<T> operator*(const Vec2<T> &v, const FixedSizeMatrix<T, 2, 2> &m)
+  {
+    Vec2<T> res;
+    res.x = v.x * m(0, 0) + v.y * m(1, 0);
+    res.y = v.x * m(0, 1) + v.y * m(1, 1);
+    return res;
+  }
+
   template <typename T>
   Vec2<T> operator+(const Vec2<T> &v, const T f)
   {
@@ -3,20 +3,21 @@
 
 #include <cmath>
 
+#include "lumos/math/lin_alg/fixed_size_vector/fixed_size_vector.h"
 #include "lumos/math/lin_alg/matrix_fixed/matrix_fixed.h"
 #include "lumos/math/lin_alg/vector_low_dim/class_def/vec3.h"
 
 namespace lumos
 {
   template <typename T>
-  Vec3<T>::Vec3(const T x_, const T y_, const T z_) : x{x_}, y{y_}, z{z_} {}
+  constexpr Vec3<T>::Vec3(const T x_, const T y_, const T z_) : x{x_}, y{y_}, z{z_} {}
 
   template <typename T>
   Vec3<T>::Vec3() {}
 
   template <typename T>
   template <typename Y>
-  Vec3<T>::Vec3(const Vec3<Y> &v) : x{static_cast<T>(v.x)},
+  constexpr Vec3<T>::Vec3(const Vec3<Y> &v) : x{static_cast<T>(v.x)},
                                     y{static_cast<T>(v.y)},
                                     z{static_cast<T>(v.z)}
   {
@@ -44,7 +45,7 @@ namespace lumos
   }
 
   template <typename T>
-  T Vec3<T>::squaredNorm() const
+  constexpr T Vec3<T>::squaredNorm() const
   {
     return x * x + y * y + z * z;
   }
@@ -56,26 +57,60 @@ namespace lumos
   }
 
   template <typename T>
-  Vec3<T> Vec3<T>::elementWiseMultiply(const Vec3<T> &factor_vector) const
+  constexpr Vec3<T> Vec3<T>::elementWiseMultiply(const Vec3<T> &factor_vector) const
   {
     return Vec3<T>(x * factor_vector.x, y * factor_vector.y, z * factor_vector.z);
   }
 
   template <typename T>
-  Vec3<T> Vec3<T>::elementWiseDivide(const Vec3<T> &denominator_vector) const
+  constexpr Vec3<T> Vec3<T>::elementWiseDivide(const Vec3<T> &denominator_vector) const
   {
     return Vec3<T>(x / denominator_vector.x, y / denominator_vector.y,
                    z / denominator_vector.z);
   }
 
   template <typename T>
-  Vec3<T> Vec3<T>::crossProduct(const Vec3<T> &right_vector) const
+  constexpr Vec3<T> Vec3<T>::crossProduct(const Vec3<T> &right_vector) const
   {
     return Vec3<T>(y * right_vector.z - z * right_vector.y,
                    z * right_vector.x - x * right_vector.z,
                    x * right_vector.y - y * right_vector.x);
   }
 
+  template <typename T>
+  FixedSizeMatrix<T, 3, 3> Vec3<T>::toCrossProductMatrix() const
+  {
+    FixedSizeMatrix<T, 3, 3> m;
+    m(0, 0) = T(0);
+    m(0, 1) = -z;
+    m(0, 2) = y;
+
+    m(1, 0) = z;
+    m(1, 1) = T(0);
+    m(1, 2) = -x;
+
+    m(2, 0) = -y;
+    m(2, 1) = x;
+    m(2, 2) = T(0);
+    return m;
+  }
+
+  template <typename T>
+  FixedSizeVector<T, 3> Vec3<T>::toFixedSizeVector() const
+  {
+    return FixedSizeVector<T, 3>{x, y, z};
+  }
+
+  template <typename T>
+  FixedSizeMatrix<T, 3, 1> Vec3<T>::toColumnMatrix() const
+  {
+    FixedSizeMatrix<T, 3, 1> m;
+    m(0, 0) = x;
+    m(1, 0) = y;
+    m(2, 0) = z;
+    return m;
+  }
+
   template <typename T>
   T Vec3<T>::angleBetweenVectors(const Vec3<T> &v) const
   {
@@ -86,55 +121,55 @@ namespace lumos
   // Non class functions
 
   template <typename T>
-  bool operator==(const Vec3<T> &v0, const Vec3<T> &v1)
+  constexpr bool operator==(const Vec3<T> &v0, const Vec3<T> &v1)
   {
     return (v0.x == v1.x) && (v0.y == v1.y) && (v0.z == v1.z);
   }
 
   template <typename T>
-  bool operator!=(const Vec3<T> &v0, const Vec3<T> &v1)
+  constexpr bool operator!=(const Vec3<T> &v0, const Vec3<T> &v1)
   {
     return !(v0 == v1);
   }
 
   template <typename T>
-  Vec3<T> operator*(const T f, const Vec3<T> &v)
+  constexpr Vec3<T> operator*(const T f, const Vec3<T> &v)
   {
     return Vec3<T>(f * v.x, f * v.y, f * v.z);
   }
 
   template <typename T>
-  Vec3<T> operator*(const Vec3<T> &v, const T f)
+  constexpr Vec3<T> operator*(const Vec3<T> &v, const T f)
   {
     return Vec3<T>(f * v.x, f * v.y, f * v.z);
   }
 
   template <typename T>
-  T operator*(const Vec3<T> &v0, const Vec3<T> &v1)
+  constexpr T operator*(const Vec3<T> &v0, const Vec3<T> &v1)
   {
     return v0.x * v1.x + v0.y * v1.y + v0.z * v1.z;
   }
 
   template <typename T>
-  Vec3<T> operator/(const Vec3<T> &v, const T f)
+  constexpr Vec3<T> operator/(const Vec3<T> &v, const T f)
   {
     return Vec3<T>(v.x / f, v.y / f, v.z / f);
   }
 
   template <typename T>
-  Vec3<T> operator/(const Vec3<T> &v0, const Vec3<T> &v1)
+  constexpr Vec3<T> operator/(const Vec3<T> &v0, const Vec3<T> &v1)
   {
     return Vec3<T>(v0.x / v1.x, v0.y / v1.y, v0.z / v1.z);
   }
 
   template <typename T>
-  Vec3<T> operator+(const Vec3<T> &v0, const Vec3<T> &v1)
+  constexpr Vec3<T> operator+(const Vec3<T> &v0, const Vec3<T> &v1)
   {
     return Vec3<T>(v0.x + v1.x, v0.y + v1.y, v0.z + v1.z);
   }
 
   template <typename T>
-  Vec3<T> operator-(const Vec3<T> &v0, const Vec3<T> &v1)
+  constexpr Vec3<T> operator-(const Vec3<T> &v0, const Vec3<T> &v1)
   {
     return Vec3<T>(v0.x - v1.x, v0.y - v1.y, v0.z - v1.z);
   }
@@ -174,37 +209,47 @@ namespace lumos
   }
 
   template <typename T>
-  Vec3<T> operator+(const Vec3<T> &v, const T f)
+  Vec3<T> operator*(const Vec3<T> &v, const FixedSizeMatrix<T, 3, 3> &m)
+  {
+    Vec3<T> res;
+    res.x = v.x * m(0, 0) + v.y * m(1, 0) + v.z * m(2, 0);
+    res.y = v.x * m(0, 1) + v.y * m(1, 1) + v.z * m(2, 1);
+    res.z = v.x * m(0, 2) + v.y * m(1, 2) + v.z * m(2, 2);
+    return res;
+  }
+
+  template <typename T>
+  constexpr Vec3<T> operator+(const Vec3<T> &v, const T f)
   {
     return Vec3<T>(v.x + f, v.y + f, v.z + f);
   }
 
   template <typename T>
-  Vec3<T> operator+(const T f, const Vec3<T> &v)
+  constexpr Vec3<T> operator+(const T f, const Vec3<T> &v)
   {
     return Vec3<T>(v.x + f, v.y + f, v.z + f);
   }
 
   template <typename T>
-  Vec3<T> operator-(const Vec3<T> &v, const T f)
+  constexpr Vec3<T> operator-(const Vec3<T> &v, const T f)
   {
     return Vec3<T>(v.x - f, v.y - f, v.z - f);
   }
 
   template <typename T>
-  Vec3<T> operator-(const T f, const Vec3<T> &v)
+  constexpr Vec3<T> operator-(const T f, const Vec3<T> &v)
   {
     return Vec3<T>(f - v.x, f - v.y, f - v.z);
   }
 
   template <typename T>
-  Vec3<T> operator/(const T f, const Vec3<T> &v)
+  constexpr Vec3<T> operator/(const T f, const Vec3<T> &v)
   {
     return Vec3<T>(f / v.x, f / v.y, f / v.z);
   }
 
   template <typename T>
-  Vec3<T> operator-(const Vec3<T> &v)
+  constexpr Vec3<T> operator-(const Vec3<T> &v)
   {
     return Vec3<T>(-v.x, -v.y, -v.z);
   }
@@ -3,6 +3,7 @@
 
 #include <cmath>
 
+#include "lumos/math/lin_alg/matrix_fixed/matrix_fixed.h"
 #include "lumos/math/lin_alg/vector_low_dim/class_def/vec4.h"
 
 namespace lumos
@@ -159,6 +160,28 @@ namespace lumos
     return res;
   }
 
+  template <typename T>
+  Vec4<T> operator*(const FixedSizeMatrix<T, 4, 4> &m, const Vec4<T> &v)
+  {
+    Vec4<T> res;
+    res.x = m(0, 0) * v.x + m(0, 1) * v.y + m(0, 2) * v.z + m(0, 3) * v.w;
+    res.y = m(1, 0) * v.x + m(1, 1) * v.y + m(1, 2) * v.z + m(1, 3) * v.w;
+    res.z = m(2, 0) * v.x + m(2, 1) * v.y + m(2, 2) * v.z + m(2, 3) * v.w;
+    res.w = m(3, 0) * v.x + m(3, 1) * v.y + m(3, 2) * v.z + m(3, 3) * v.w;
+    return res;
+  }
+
+  template <typename T>
+  Vec4<T> operator*(const Vec4<T> &v, const FixedSizeMatrix<T, 4, 4> &m)
+  {
+    Vec4<T> res;
+    res.x = m(0, 0) * v.x + m(1, 0) * v.y + m(2, 0) * v.z + m(3, 0) * v.w;
+    res.y = m(0, 1) * v.x + m(1, 1) * v.y + m(2, 1) * v.z + m(3, 1) * v.w;
+    res.z = m(0, 2) * v.x + m(1, 2) * v.y + m(2, 2) * v.z + m(3, 2) * v.w;
+    res.w = m(0, 3) * v.x + m(1, 3) * v.y + m(2, 3) * v.z + m(3, 3) * v.w;
+    return res;
+  }
+
   template <typename T>
   Vec4<T> operator+(const Vec4<T> &v, const T f)
   {
@@ -23,6 +23,11 @@
 #include "lumos/math/geometry/line_3d.h"
 #include "lumos/math/geometry/plane.h"
 #include "lumos/math/geometry/triangle.h"
+#include "lumos/math/geometry/point_array.h"
+#include "lumos/math/geometry/batch_predicates.h"
+#include "lumos/math/geometry/fitting.h"
+#include "lumos/math/geometry/polygon.h"
+#include "lumos/math/geometry/convex_hull.h"
 
 #include "lumos/math/structures/index_triplet.h"
 
@@ -32,8 +37,14 @@
 #include "lumos/math/image/image_rgba.h"
 
 #include "lumos/math/transformations/quaternion.h"
+#include "lumos/math/transformations/so3.h"
+#include "lumos/math/transformations/se3.h"
+#include "lumos/math/transformations/sim3.h"
+#include "lumos/math/transformations/batch_rotations.h"
 #include "lumos/math/curves/curves.h"
 #include "lumos/math/filters/filters.h"
+#include "lumos/math/estimation/estimation.h"
+#include "lumos/math/spatial/spatial.h"
 
 #include "lumos/math/pre_defs.h"
 // clang-format on
@@ -0,0 +1,79 @@
+#ifndef LUMOS_MATH_MISC_CONSTEXPR_MATH_H_
+#define LUMOS_MATH_MISC_CONSTEXPR_MATH_H_
+
+#include <cmath>
+#include <limits>
+
+// __builtin_is_constant_evaluated is the C++17 spelling of
+// std::is_constant_evaluated in GCC >= 9 and Clang >= 9
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define LUMOS_HAS_IS_CONSTANT_EVALUATED
+#endif
+#endif
+
+namespace lumos
+{
+  namespace internal
+  {
+    template <typename T>
+    constexpr T constexprAbs(const T x)
+    {
+      return x < T(0) ? -x : x;
+    }
+
+    // std::swap is only constexpr from C++20
+    template <typename T>
+    constexpr void constexprSwap(T &a, T &b)
+    {
+      const T tmp = a;
+      a = b;
+      b = tmp;
+    }
+
+    // std::sqrt at runtime, Newton's method when evaluated at compile time.
+    // Negative and NaN arguments give NaN like std::sqrt
+    template <typename T>
+    constexpr T constexprSqrt(const T x)
+    {
+#ifdef LUMOS_HAS_IS_CONSTANT_EVALUATED
+      if (!__builtin_is_constant_evaluated())
+      {
+        return std::sqrt(x);
+      }
+#endif
+      if (!(x >= T(0)))
+      {
+        return std::numeric_limits<T>::quiet_NaN();
+      }
+      if (x == T(0) || x > std::numeric_limits<T>::max())
+      {
+        return x;
+      }
+
+      // Scale x to [0.25, 4) by powers of 4, so that Newton's method from 1
+      // converges in a few iterations
+      T y = x;
+      T scale = T(1);
+      while (y >= T(4))
+      {
+        y *= T(0.25);
+        scale *= T(2);
+      }
+      while (y < T(0.25))
+      {
+        y *= T(4);
+        scale *= T(0.5);
+      }
+
+      T root = T(1);
+      for (int i = 0; i < 8; ++i)
+      {
+        root = T(0.5) * (root + y / root);
+      }
+      return root * scale;
+    }
+  } // namespace internal
+} // namespace lumos
+
+#endif // LUMOS_MATH_MISC_CONSTEXPR_MATH_H_
@@ -54,6 +54,14 @@ namespace lumos
     template <typename T>
     struct Triangle3D;
 
+    template <typename T>
+    struct PointArray2D;
+    template <typename T>
+    struct PointArray3D;
+
+    template <typename T>
+    struct Polygon2D;
+
     template <typename T>
     using Point2 = Vec2<T>;
     template <typename T>
@@ -76,6 +84,12 @@ namespace lumos
     class EulerAngles;
     template <typename T>
     struct AxisAngle;
+    template <typename T>
+    struct SO3;
+    template <typename T>
+    struct SE3;
+    template <typename T>
+    struct Sim3;
 
 } // namespace lumos
 
@@ -0,0 +1,68 @@
+#ifndef LUMOS_MATH_MISC_PARALLEL_FOR_H_
+#define LUMOS_MATH_MISC_PARALLEL_FOR_H_
+
+#include "lumos/parallel/thread_pool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+
+namespace lumos
+{
+  namespace internal
+  {
+    inline size_t defaultNumThreads()
+    {
+      return parallel::hardwareConcurrency();
+    }
+
+    // Splits [begin, end) into contiguous chunks and calls f(chunk_begin, chunk_end)
+    // for each of them, one chunk per thread. Ranges shorter than two chunks of
+    // min_chunk_size are run on the calling thread. num_threads == 0 means
+    // "use all hardware threads". The chunks run as tasks of the library's
+    // default thread pool, the calling thread takes the first one and helps
+    // with the others while it waits, so calls can be nested
+    template <typename F>
+    void parallelFor(const size_t begin, const size_t end,
+                     const size_t min_chunk_size, const F &f,
+                     size_t num_threads = 0)
+    {
+      if (end <= begin)
+      {
+        return;
+      }
+
+      const size_t num_elements = end - begin;
+      const size_t chunk_size_lower_bound = std::max<size_t>(min_chunk_size, 1U);
+
+      if (num_threads == 0U)
+      {
+        num_threads = defaultNumThreads();
+      }
+      num_threads = std::min(num_threads, num_elements / chunk_size_lower_bound);
+
+      if (num_threads <= 1U)
+      {
+        f(begin, end);
+        return;
+      }
+
+      const size_t chunk_size = (num_elements + num_threads - 1U) / num_threads;
+
+      parallel::TaskGroup group(parallel::defaultThreadPool());
+      for (size_t chunk_begin = begin + chunk_size; chunk_begin < end; chunk_begin += chunk_size)
+      {
+        const size_t chunk_end = std::min(chunk_begin + chunk_size, end);
+        group.run([&f, chunk_begin, chunk_end]()
+                  { f(chunk_begin, chunk_end); });
+      }
+
+      // The calling thread takes the first chunk
+      f(begin, std::min(begin + chunk_size, end));
+      group.wait();
+    }
+
+  } // namespace internal
+} // namespace lumos
+
+#endif // LUMOS_MATH_MISC_PARALLEL_FOR_H_
@@ -0,0 +1,151 @@
+#ifndef LUMOS_MATH_MISC_POLYNOMIAL_ROOTS_H_
+#define LUMOS_MATH_MISC_POLYNOMIAL_ROOTS_H_
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace lumos
+{
+  namespace internal
+  {
+    // Roots of c[0] * x^n + c[1] * x^(n - 1) + ... + c[n] for real
+    // coefficients with c[0] != 0, sorted by real and then imaginary part.
+    // Degrees 1 and 2 are solved in closed form, higher degrees with the
+    // Aberth-Ehrlich iteration, which converges cubically to simple roots.
+    // Roots of multiplicity m are found to about eps^(1 / m) like with any
+    // method working on the expanded polynomial
+    template <typename T>
+    std::vector<std::complex<T>> polynomialRoots(const std::vector<T> &c)
+    {
+      using Complex = std::complex<T>;
+      const auto less = [](const Complex &l, const Complex &r)
+      { return l.real() < r.real() || (l.real() == r.real() && l.imag() < r.imag()); };
+
+      std::vector<Complex> roots;
+      if (c.size() < 2)
+      {
+        return roots;
+      }
+      const size_t n = c.size() - 1;
+      roots.reserve(n);
+
+      if (n == 1)
+      {
+        roots.emplace_back(-c[1] / c[0], T(0));
+        return roots;
+      }
+
+      if (n == 2)
+      {
+        // Citardauq form for the root of smaller magnitude, which avoids
+        // cancellation when b^2 >> 4ac
+        const T a = c[0];
+        const T b = c[1];
+        const T cc = c[2];
+        const T discriminant = b * b - T(4) * a * cc;
+        if (discriminant >= T(0))
+        {
+          const T q = T(-0.5) * (b + std::copysign(std::sqrt(discriminant), b));
+          roots.emplace_back(q / a, T(0));
+          roots.emplace_back(q != T(0) ? cc / q : T(0), T(0));
+        }
+        else
+        {
+          const T re = -b / (T(2) * a);
+          const T im = std::sqrt(-discriminant) / (T(2) * std::abs(a));
+          roots.emplace_back(re, -im);
+          roots.emplace_back(re, im);
+        }
+        std::sort(roots.begin(), roots.end(), less);
+        return roots;
+      }
+
+      // Monic coefficients
+      std::vector<T> monic(n + 1);
+      for (size_t k = 0; k <= n; ++k)
+      {
+        monic[k] = c[k] / c[0];
+      }
+
+      // Start on a circle with the geometric mean of the root magnitudes as
+      // radius, rotated off the real axis so that real coefficient
+      // polynomials do not keep conjugate starting points on it
+      const T constant_magnitude = std::abs(monic[n]);
+      const T radius = constant_magnitude > T(0)
+                           ? std::pow(constant_magnitude, T(1) / static_cast<T>(n))
+                           : T(1);
+      const T two_pi = T(6.283185307179586476925286766559);
+      for (size_t k = 0; k < n; ++k)
+      {
+        const T angle = two_pi * static_cast<T>(k) / static_cast<T>(n) + T(0.4);
+        roots.push_back(std::polar(radius, angle));
+      }
+
+      const T tolerance = T(4) * std::numeric_limits<T>::epsilon();
+      const size_t max_iterations = 100 + 10 * n;
+      for (size_t iteration = 0; iteration < max_iterations; ++iteration)
+      {
+        bool converged = true;
+        for (size_t i = 0; i < n; ++i)
+        {
+          const Complex z = roots[i];
+          Complex p(monic[0], T(0));
+          Complex dp(T(0), T(0));
+          for (size_t k = 1; k <= n; ++k)
+          {
+            dp = dp * z + p;
+            p = p * z + monic[k];
+          }
+          if (p == Complex(T(0), T(0)))
+          {
+            continue;
+          }
+
+          Complex repulsion(T(0), T(0));
+          for (size_t j = 0; j < n; ++j)
+          {
+            if (j != i)
+            {
+              const Complex difference = z - roots[j];
+              if (difference != Complex(T(0), T(0)))
+              {
+                repulsion += T(1) / difference;
+              }
+            }
+          }
+
+          // Newton step p / p' corrected for the roots already found
+          Complex step;
+          if (dp == Complex(T(0), T(0)))
+          {
+            step = Complex(radius * tolerance, radius * tolerance);
+          }
+          else
+          {
+            const Complex newton = p / dp;
+            step = newton / (T(1) - newton * repulsion);
+          }
+          roots[i] = z - step;
+
+          if (!(std::abs(step) <= tolerance * std::max(std::abs(roots[i]), radius)))
+          {
+            converged = false;
+          }
+        }
+        if (converged)
+        {
+          break;
+        }
+      }
+
+      std::sort(roots.begin(), roots.end(), less);
+      return roots;
+    }
+  } // namespace internal
+} // namespace lumos
+
+#endif // LUMOS_MATH_MISC_POLYNOMIAL_ROOTS_H_
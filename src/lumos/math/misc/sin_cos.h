@@ -0,0 +1,80 @@
+#ifndef LUMOS_MATH_MISC_SIN_COS_H_
+#define LUMOS_MATH_MISC_SIN_COS_H_
+
+#include <cstdint>
+
+namespace lumos
+{
+  namespace internal
+  {
+    // Constants of the Cody-Waite reduction x = k * pi / 2 + r. pi / 2 is
+    // split in parts whose products with k are exact for the supported range
+    template <typename T>
+    struct SinCosConstants;
+
+    template <>
+    struct SinCosConstants<double>
+    {
+      static constexpr double kRoundingShift = 6755399441055744.0; // 1.5 * 2^52
+      static constexpr double kPiOver2Part1 = 1.57079632673412561417e+00;
+      static constexpr double kPiOver2Part2 = 6.07710050630396597660e-11;
+      static constexpr double kPiOver2Part3 = 2.02226624879595063154e-21;
+    };
+
+    template <>
+    struct SinCosConstants<float>
+    {
+      static constexpr float kRoundingShift = 12582912.0f; // 1.5 * 2^23
+      static constexpr float kPiOver2Part1 = 1.5703125f;
+      static constexpr float kPiOver2Part2 = 4.837512969970703125e-4f;
+      static constexpr float kPiOver2Part3 = 7.54978995489188216e-8f;
+    };
+
+    // Sine and cosine without branches or library calls, so that loops over
+    // arrays calling it are vectorized by the compiler. Polynomials are the
+    // fdlibm kernels on [-pi / 4, pi / 4], the error is a few ulp for
+    // |x| < 1e5 (double) or |x| < 1e3 (float)
+    template <typename T>
+    inline void sinCos(const T x, T &s, T &c)
+    {
+      using Constants = SinCosConstants<T>;
+
+      // Round to nearest by adding and removing 1.5 * 2^(mantissa bits)
+      const T k = (x * T(0.63661977236758134308) + Constants::kRoundingShift) -
+                  Constants::kRoundingShift;
+      const T r = ((x - k * Constants::kPiOver2Part1) - k * Constants::kPiOver2Part2) -
+                  k * Constants::kPiOver2Part3;
+      const int32_t quadrant = static_cast<int32_t>(k);
+
+      const T z = r * r;
+      const T sin_r =
+          r + r * z *
+                  (T(-1.66666666666666324348e-01) +
+                   z * (T(8.33333333332248946124e-03) +
+                        z * (T(-1.98412698298579493134e-04) +
+                             z * (T(2.75573137070700676789e-06) +
+                                  z * (T(-2.50507602534068634195e-08) +
+                                       z * T(1.58969099521155010221e-10))))));
+      const T cos_r =
+          T(1) - T(0.5) * z +
+          z * z *
+              (T(4.16666666666666019037e-02) +
+               z * (T(-1.38888888888741095749e-03) +
+                    z * (T(2.48015872894767294178e-05) +
+                         z * (T(-2.75573143513906633035e-07) +
+                              z * (T(2.08757232129817482790e-09) +
+                                   z * T(-1.13596475577881948265e-11))))));
+
+      // Quadrant q maps (sin, cos) to (sin_r, cos_r), (cos_r, -sin_r),
+      // (-sin_r, -cos_r) and (-cos_r, sin_r) for q = 0, 1, 2, 3. Selected
+      // with multiplications by 0 / 1, which are exact and never become jumps
+      const T swap = static_cast<T>(quadrant & 1);
+      const T sin_sign = T(1) - T(2) * static_cast<T>((quadrant >> 1) & 1);
+      const T cos_sign = T(1) - T(2) * static_cast<T>(((quadrant + 1) >> 1) & 1);
+      s = sin_sign * (swap * cos_r + (T(1) - swap) * sin_r);
+      c = cos_sign * (swap * sin_r + (T(1) - swap) * cos_r);
+    }
+  } // namespace internal
+} // namespace lumos
+
+#endif // LUMOS_MATH_MISC_SIN_COS_H_
@@ -60,6 +60,12 @@ namespace lumos
     template <typename T>
     class IIRFilter;
 
+    // Forward declarations for spatial indices
+    template <typename T>
+    class KDTree;
+    template <typename T>
+    class VoxelHashGrid;
+
 } // namespace lumos
 
 #endif // LUMOS_MATH_PRE_DEFS_H_
@@ -0,0 +1,124 @@
+#ifndef LUMOS_MATH_SPATIAL_CLASS_DEF_KD_TREE_H_
+#define LUMOS_MATH_SPATIAL_CLASS_DEF_KD_TREE_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "lumos/math/misc/forward_decl.h"
+
+namespace lumos
+{
+
+  template <typename T>
+  struct NeighborResult
+  {
+    size_t index;       // Index of the point in insertion order
+    T squared_distance; // Squared euclidean distance to the query point
+  };
+
+  template <typename T>
+  class KDTree
+  {
+  private:
+    static constexpr uint8_t kLeafAxis = 3U;
+
+    // Nodes are stored depth first, so the left child of node i is always i + 1
+    struct Node
+    {
+      T split_value;
+      uint32_t begin;       // First point of the leaf in StaticTree::points
+      uint32_t end;         // One past the last point of the leaf
+      uint32_t right_child; // Index of the right child (inner nodes only)
+      uint8_t axis;         // Split axis 0, 1, 2 or kLeafAxis for leaves
+    };
+
+    // Immutable tree. Points are reordered so that every leaf is a contiguous
+    // block, and indices maps each reordered point back to its global index.
+    struct StaticTree
+    {
+      std::vector<Point3<T>> points;
+      std::vector<size_t> indices;
+      std::vector<Node> nodes;
+    };
+
+    // Bulk built tree
+    StaticTree base_tree_;
+
+    // Incremental mode (logarithmic method): level i holds either nothing or
+    // leaf_size_ * 2^i points, and full levels are merged upwards on overflow
+    std::vector<StaticTree> insertion_levels_;
+
+    // Most recent insertions that do not yet fill a leaf, searched linearly
+    std::vector<Point3<T>> pending_points_;
+
+    size_t num_points_;
+    size_t leaf_size_;
+    size_t num_threads_;
+
+    void buildTree(StaticTree &tree, const std::vector<Point3<T>> &points,
+                   const std::vector<size_t> &indices) const;
+    size_t countNodes(const size_t num_points) const;
+    void buildSubtree(StaticTree &tree, const size_t node_idx,
+                      uint32_t *const permutation, const uint32_t begin,
+                      const uint32_t end, const std::vector<Point3<T>> &points,
+                      const size_t num_threads) const;
+    void appendTreePoints(const StaticTree &tree, std::vector<Point3<T>> &points,
+                          std::vector<size_t> &indices) const;
+    void flushPendingPoints();
+
+    void searchKnn(const StaticTree &tree, const Point3<T> &query,
+                   const size_t k, std::vector<NeighborResult<T>> &heap) const;
+    void searchRadius(const StaticTree &tree, const Point3<T> &query,
+                      const T squared_radius,
+                      std::vector<NeighborResult<T>> &result) const;
+
+  public:
+    KDTree();
+    explicit KDTree(const Vector<Point3<T>> &points, const size_t leaf_size = 16U,
+                    const size_t num_threads = 0U);
+    explicit KDTree(const std::vector<Point3<T>> &points,
+                    const size_t leaf_size = 16U, const size_t num_threads = 0U);
+    KDTree(const Point3<T> *const points, const size_t num_points,
+           const size_t leaf_size = 16U, const size_t num_threads = 0U);
+
+    // Replaces the content of the tree. Construction runs on num_threads threads
+    void build(const Point3<T> *const points, const size_t num_points);
+    void build(const Vector<Point3<T>> &points);
+    void build(const std::vector<Point3<T>> &points);
+    void clear();
+
+    // Incremental mode. Inserted points get consecutive indices after the
+    // existing ones and are searchable immediately
+    void insert(const Point3<T> &point);
+    void insert(const Point3<T> *const points, const size_t num_points);
+    // Merges all inserted points into a single balanced tree
+    void rebuild();
+
+    void setNumThreads(const size_t num_threads);
+    size_t size() const;
+    size_t numInsertionLevels() const;
+    bool isEmpty() const;
+
+    // Single queries, results sorted by increasing distance
+    NeighborResult<T> nearest(const Point3<T> &query) const;
+    std::vector<NeighborResult<T>> knnSearch(const Point3<T> &query,
+                                             const size_t k) const;
+    std::vector<NeighborResult<T>> radiusSearch(const Point3<T> &query,
+                                                const T radius) const;
+
+    // Batched queries, distributed over num_threads threads (0 = all cores)
+    std::vector<std::vector<NeighborResult<T>>>
+    knnSearch(const Point3<T> *const queries, const size_t num_queries,
+              const size_t k) const;
+    std::vector<std::vector<NeighborResult<T>>>
+    knnSearch(const Vector<Point3<T>> &queries, const size_t k) const;
+    std::vector<std::vector<NeighborResult<T>>>
+    radiusSearch(const Point3<T> *const queries, const size_t num_queries,
+                 const T radius) const;
+    std::vector<std::vector<NeighborResult<T>>>
+    radiusSearch(const Vector<Point3<T>> &queries, const T radius) const;
+  };
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_SPATIAL_CLASS_DEF_KD_TREE_H_
@@ -0,0 +1,66 @@
+#ifndef LUMOS_MATH_SPATIAL_CLASS_DEF_VOXEL_GRID_H_
+#define LUMOS_MATH_SPATIAL_CLASS_DEF_VOXEL_GRID_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "lumos/math/misc/forward_decl.h"
+#include "lumos/math/spatial/class_def/kd_tree.h"
+
+namespace lumos
+{
+
+  // Sparse voxel hash for fixed radius queries on streaming point clouds.
+  // Insertion is O(1), and a radius query only visits the voxels overlapping
+  // the query sphere, which makes it a good fit when the query radius is known
+  // up front and close to the voxel size. Voxel coordinates are clamped to
+  // [-2^20, 2^20), and queries covering more voxels than are occupied scan
+  // all points instead.
+  template <typename T>
+  class VoxelHashGrid
+  {
+  private:
+    static constexpr int32_t kMinVoxelCoordinate = -(int32_t{1} << 20);
+    static constexpr int32_t kMaxVoxelCoordinate = (int32_t{1} << 20) - 1;
+
+    T voxel_size_;
+    T inv_voxel_size_;
+    std::vector<Point3<T>> points_;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> cells_;
+    size_t num_threads_;
+
+    int32_t voxelCoordinate(const T value) const;
+    static uint64_t voxelKey(const int32_t ix, const int32_t iy, const int32_t iz);
+
+  public:
+    VoxelHashGrid();
+    explicit VoxelHashGrid(const T voxel_size, const size_t num_threads = 0U);
+
+    void insert(const Point3<T> &point);
+    void insert(const Point3<T> *const points, const size_t num_points);
+    void insert(const Vector<Point3<T>> &points);
+    void clear();
+
+    void setNumThreads(const size_t num_threads);
+    size_t size() const;
+    size_t numOccupiedVoxels() const;
+    T voxelSize() const;
+    const Point3<T> &point(const size_t index) const;
+
+    // Results sorted by increasing distance
+    std::vector<NeighborResult<T>> radiusSearch(const Point3<T> &query,
+                                                const T radius) const;
+    size_t countWithinRadius(const Point3<T> &query, const T radius) const;
+
+    // Batched queries, distributed over num_threads threads (0 = all cores)
+    std::vector<std::vector<NeighborResult<T>>>
+    radiusSearch(const Point3<T> *const queries, const size_t num_queries,
+                 const T radius) const;
+    std::vector<std::vector<NeighborResult<T>>>
+    radiusSearch(const Vector<Point3<T>> &queries, const T radius) const;
+  };
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_SPATIAL_CLASS_DEF_VOXEL_GRID_H_
@@ -0,0 +1,610 @@
+#ifndef LUMOS_MATH_SPATIAL_KD_TREE_H_
+#define LUMOS_MATH_SPATIAL_KD_TREE_H_
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+#include "lumos/logging.h"
+#include "lumos/math/lin_alg.h"
+#include "lumos/math/misc/parallel_for.h"
+#include "lumos/math/spatial/class_def/kd_tree.h"
+
+namespace lumos
+{
+  namespace internal
+  {
+    template <typename T>
+    inline T pointCoordinate(const Point3<T> &p, const uint8_t axis)
+    {
+      return axis == 0U ? p.x : (axis == 1U ? p.y : p.z);
+    }
+
+    template <typename T>
+    inline T squaredDistance(const Point3<T> &p0, const Point3<T> &p1)
+    {
+      const T dx = p0.x - p1.x;
+      const T dy = p0.y - p1.y;
+      const T dz = p0.z - p1.z;
+      return dx * dx + dy * dy + dz * dz;
+    }
+
+    template <typename T>
+    inline bool neighborCompare(const NeighborResult<T> &n0,
+                                const NeighborResult<T> &n1)
+    {
+      return n0.squared_distance < n1.squared_distance;
+    }
+
+    // Pushes a candidate onto a bounded max-heap holding the k best neighbors
+    template <typename T>
+    inline void pushCandidate(std::vector<NeighborResult<T>> &heap,
+                              const size_t k, const size_t index,
+                              const T squared_distance)
+    {
+      if (heap.size() < k)
+      {
+        heap.push_back({index, squared_distance});
+        std::push_heap(heap.begin(), heap.end(), neighborCompare<T>);
+      }
+      else if (squared_distance < heap.front().squared_distance)
+      {
+        std::pop_heap(heap.begin(), heap.end(), neighborCompare<T>);
+        heap.back() = {index, squared_distance};
+        std::push_heap(heap.begin(), heap.end(), neighborCompare<T>);
+      }
+    }
+
+    // Subtrees larger than this are built by a separate task
+    constexpr size_t kKDTreeParallelBuildThreshold = 8192U;
+
+    // Batched queries are split into chunks of at least this many queries
+    constexpr size_t kSpatialQueryChunkSize = 64U;
+
+    // Depth first traversal stack, large enough for any tree with 32 bit indices
+    constexpr size_t kKDTreeMaxStackSize = 128U;
+
+  } // namespace internal
+
+  template <typename T>
+  KDTree<T>::KDTree() : num_points_(0U), leaf_size_(16U), num_threads_(0U) {}
+
+  template <typename T>
+  KDTree<T>::KDTree(const Vector<Point3<T>> &points, const size_t leaf_size,
+                    const size_t num_threads)
+      : num_points_(0U), leaf_size_(std::max<size_t>(leaf_size, 1U)),
+        num_threads_(num_threads)
+  {
+    build(points);
+  }
+
+  template <typename T>
+  KDTree<T>::KDTree(const std::vector<Point3<T>> &points,
+                    const size_t leaf_size, const size_t num_threads)
+      : num_points_(0U), leaf_size_(std::max<size_t>(leaf_size, 1U)),
+        num_threads_(num_threads)
+  {
+    build(points);
+  }
+
+  template <typename T>
+  KDTree<T>::KDTree(const Point3<T> *const points, const size_t num_points,
+                    const size_t leaf_size, const size_t num_threads)
+      : num_points_(0U), leaf_size_(std::max<size_t>(leaf_size, 1U)),
+        num_threads_(num_threads)
+  {
+    build(points, num_points);
+  }
+
+  template <typename T>
+  void KDTree<T>::build(const Point3<T> *const points, const size_t num_points)
+  {
+    ASSERT(num_points < std::numeric_limits<uint32_t>::max())
+        << "Too many points for KDTree!";
+
+    clear();
+
+    std::vector<Point3<T>> input_points(points, points + num_points);
+    std::vector<size_t> input_indices(num_points);
+    std::iota(input_indices.begin(), input_indices.end(), size_t{0});
+
+    buildTree(base_tree_, input_points, input_indices);
+    num_points_ = num_points;
+  }
+
+  template <typename T>
+  void KDTree<T>::build(const Vector<Point3<T>> &points)
+  {
+    build(points.data(), points.size());
+  }
+
+  template <typename T>
+  void KDTree<T>::build(const std::vector<Point3<T>> &points)
+  {
+    build(points.data(), points.size());
+  }
+
+  template <typename T>
+  void KDTree<T>::clear()
+  {
+    base_tree_ = StaticTree{};
+    insertion_levels_.clear();
+    pending_points_.clear();
+    num_points_ = 0U;
+  }
+
+  template <typename T>
+  size_t KDTree<T>::countNodes(const size_t num_points) const
+  {
+    if (num_points <= leaf_size_)
+    {
+      return 1U;
+    }
+    const size_t num_left = num_points / 2U;
+    return 1U + countNodes(num_left) + countNodes(num_points - num_left);
+  }
+
+  template <typename T>
+  void KDTree<T>::buildTree(StaticTree &tree,
+                            const std::vector<Point3<T>> &points,
+                            const std::vector<size_t> &indices) const
+  {
+    const size_t num_points = points.size();
+
+    tree.points.clear();
+    tree.indices.clear();
+    tree.nodes.clear();
+
+    if (num_points == 0U)
+    {
+      return;
+    }
+
+    std::vector<uint32_t> permutation(num_points);
+    std::iota(permutation.begin(), permutation.end(), uint32_t{0});
+
+    // The node layout only depends on the subtree sizes, so every subtree knows
+    // its node range up front and subtrees can be built concurrently
+    tree.nodes.resize(countNodes(num_points));
+
+    const size_t num_threads =
+        num_threads_ == 0U ? internal::defaultNumThreads() : num_threads_;
+    buildSubtree(tree, 0U, permutation.data(), 0U,
+                 static_cast<uint32_t>(num_points), points, num_threads);
+
+    tree.points.resize(num_points);
+    tree.indices.resize(num_points);
+    for (size_t k = 0; k < num_points; k++)
+    {
+      tree.points[k] = points[permutation[k]];
+      tree.indices[k] = indices[permutation[k]];
+    }
+  }
+
+  template <typename T>
+  void KDTree<T>::buildSubtree(StaticTree &tree, const size_t node_idx,
+                               uint32_t *const permutation,
+                               const uint32_t begin, const uint32_t end,
+                               const std::vector<Point3<T>> &points,
+                               const size_t num_threads) const
+  {
+    Node &node = tree.nodes[node_idx];
+    const size_t num_points = end - begin;
+
+    if (num_points <= leaf_size_)
+    {
+      node.split_value = T(0);
+      node.begin = begin;
+      node.end = end;
+      node.right_child = 0U;
+      node.axis = kLeafAxis;
+      return;
+    }
+
+    // Split along the axis with the largest extent
+    Point3<T> min_point = points[permutation[begin]];
+    Point3<T> max_point = min_point;
+    for (uint32_t k = begin + 1U; k < end; k++)
+    {
+      const Point3<T> &p = points[permutation[k]];
+      min_point.x = std::min(min_point.x, p.x);
+      min_point.y = std::min(min_point.y, p.y);
+      min_point.z = std::min(min_point.z, p.z);
+      max_point.x = std::max(max_point.x, p.x);
+      max_point.y = std::max(max_point.y, p.y);
+      max_point.z = std::max(max_point.z, p.z);
+    }
+
+    const Vec3<T> extent = max_point - min_point;
+    uint8_t axis = 0U;
+    if (extent.y > extent.x && extent.y >= extent.z)
+    {
+      axis = 1U;
+    }
+    else if (extent.z > extent.x && extent.z > extent.y)
+    {
+      axis = 2U;
+    }
+
+    // Median split, points left of mid are <= split value, the rest >= split value
+    const uint32_t mid = begin + static_cast<uint32_t>(num_points / 2U);
+    std::nth_element(permutation + begin, permutation + mid, permutation + end,
+                     [&points, axis](const uint32_t i0, const uint32_t i1)
+                     {
+                       return internal::pointCoordinate(points[i0], axis) <
+                              internal::pointCoordinate(points[i1], axis);
+                     });
+
+    const size_t left_idx = node_idx + 1U;
+    const size_t right_idx = left_idx + countNodes(mid - begin);
+
+    node.split_value = internal::pointCoordinate(points[permutation[mid]], axis);
+    node.begin = begin;
+    node.end = end;
+    node.right_child = static_cast<uint32_t>(right_idx);
+    node.axis = axis;
+
+    if ((num_threads > 1U) &&
+        (num_points > internal::kKDTreeParallelBuildThreshold))
+    {
+      const size_t num_left_threads = num_threads / 2U;
+      parallel::TaskGroup group(parallel::defaultThreadPool());
+      group.run(
+          [this, &tree, left_idx, permutation, begin, mid, &points,
+           num_left_threads]()
+          {
+            buildSubtree(tree, left_idx, permutation, begin, mid, points,
+                         num_left_threads);
+          });
+      buildSubtree(tree, right_idx, permutation, mid, end, points,
+                   num_threads - num_left_threads);
+      group.wait();
+    }
+    else
+    {
+      buildSubtree(tree, left_idx, permutation, begin, mid, points, 1U);
+      buildSubtree(tree, right_idx, permutation, mid, end, points, 1U);
+    }
+  }
+
+  template <typename T>
+  void KDTree<T>::appendTreePoints(const StaticTree &tree,
+                                   std::vector<Point3<T>> &points,
+                                   std::vector<size_t> &indices) const
+  {
+    points.insert(points.end(), tree.points.begin(), tree.points.end());
+    indices.insert(indices.end(), tree.indices.begin(), tree.indices.end());
+  }
+
+  template <typename T>
+  void KDTree<T>::insert(const Point3<T> &point)
+  {
+    pending_points_.push_back(point);
+    num_points_++;
+
+    if (pending_points_.size() >= leaf_size_)
+    {
+      flushPendingPoints();
+    }
+  }
+
+  template <typename T>
+  void KDTree<T>::insert(const Point3<T> *const points, const size_t num_points)
+  {
+    for (size_t k = 0; k < num_points; k++)
+    {
+      insert(points[k]);
+    }
+  }
+
+  template <typename T>
+  void KDTree<T>::flushPendingPoints()
+  {
+    std::vector<Point3<T>> carry_points(pending_points_);
+    std::vector<size_t> carry_indices(pending_points_.size());
+    std::iota(carry_indices.begin(), carry_indices.end(),
+              num_points_ - pending_points_.size());
+    pending_points_.clear();
+
+    // Binary counter: merge full levels until an empty level is found
+    size_t level = 0U;
+    while (level < insertion_levels_.size() &&
+           !insertion_levels_[level].points.empty())
+    {
+      appendTreePoints(insertion_levels_[level], carry_points, carry_indices);
+      insertion_levels_[level] = StaticTree{};
+      level++;
+    }
+
+    if (carry_points.size() >= base_tree_.points.size())
+    {
+      // The insertions outgrew the bulk tree, so merge everything into it
+      appendTreePoints(base_tree_, carry_points, carry_indices);
+      for (const StaticTree &tree : insertion_levels_)
+      {
+        appendTreePoints(tree, carry_points, carry_indices);
+      }
+      insertion_levels_.clear();
+      buildTree(base_tree_, carry_points, carry_indices);
+      return;
+    }
+
+    if (level == insertion_levels_.size())
+    {
+      insertion_levels_.emplace_back();
+    }
+    buildTree(insertion_levels_[level], carry_points, carry_indices);
+  }
+
+  template <typename T>
+  void KDTree<T>::rebuild()
+  {
+    std::vector<Point3<T>> all_points;
+    std::vector<size_t> all_indices;
+    all_points.reserve(num_points_);
+    all_indices.reserve(num_points_);
+
+    appendTreePoints(base_tree_, all_points, all_indices);
+    for (const StaticTree &tree : insertion_levels_)
+    {
+      appendTreePoints(tree, all_points, all_indices);
+    }
+    for (size_t k = 0; k < pending_points_.size(); k++)
+    {
+      all_points.push_back(pending_points_[k]);
+      all_indices.push_back(num_points_ - pending_points_.size() + k);
+    }
+
+    insertion_levels_.clear();
+    pending_points_.clear();
+    buildTree(base_tree_, all_points, all_indices);
+  }
+
+  template <typename T>
+  void KDTree<T>::setNumThreads(const size_t num_threads)
+  {
+    num_threads_ = num_threads;
+  }
+
+  template <typename T>
+  size_t KDTree<T>::size() const
+  {
+    return num_points_;
+  }
+
+  template <typename T>
+  size_t KDTree<T>::numInsertionLevels() const
+  {
+    size_t num_levels = 0U;
+    for (const StaticTree &tree : insertion_levels_)
+    {
+      if (!tree.points.empty())
+      {
+        num_levels++;
+      }
+    }
+    return num_levels;
+  }
+
+  template <typename T>
+  bool KDTree<T>::isEmpty() const
+  {
+    return num_points_ == 0U;
+  }
+
+  template <typename T>
+  void KDTree<T>::searchKnn(const StaticTree &tree, const Point3<T> &query,
+                            const size_t k,
+                            std::vector<NeighborResult<T>> &heap) const
+  {
+    if (tree.nodes.empty())
+    {
+      return;
+    }
+
+    // Stack entries are (node index, lower bound of squared distance to node)
+    std::array<std::pair<uint32_t, T>, internal::kKDTreeMaxStackSize> stack;
+    size_t stack_size = 0U;
+    stack[stack_size++] = {0U, T(0)};
+
+    while (stack_size > 0U)
+    {
+      const std::pair<uint32_t, T> entry = stack[--stack_size];
+
+      if ((heap.size() == k) && (entry.second >= heap.front().squared_distance))
+      {
+        continue;
+      }
+
+      const Node &node = tree.nodes[entry.first];
+
+      if (node.axis == kLeafAxis)
+      {
+        for (uint32_t i = node.begin; i < node.end; i++)
+        {
+          internal::pushCandidate(heap, k, tree.indices[i],
+                                  internal::squaredDistance(tree.points[i], query));
+        }
+        continue;
+      }
+
+      const T diff = internal::pointCoordinate(query, node.axis) - node.split_value;
+      const uint32_t left_child = entry.first + 1U;
+      const uint32_t near_child = diff < T(0) ? left_child : node.right_child;
+      const uint32_t far_child = diff < T(0) ? node.right_child : left_child;
+
+      // Far side first so that the near side is popped and searched first
+      stack[stack_size++] = {far_child, std::max(entry.second, diff * diff)};
+      stack[stack_size++] = {near_child, entry.second};
+    }
+  }
+
+  template <typename T>
+  void KDTree<T>::searchRadius(const StaticTree &tree, const Point3<T> &query,
+                               const T squared_radius,
+                               std::vector<NeighborResult<T>> &result) const
+  {
+    if (tree.nodes.empty())
+    {
+      return;
+    }
+
+    std::array<uint32_t, internal::kKDTreeMaxStackSize> stack;
+    size_t stack_size = 0U;
+    stack[stack_size++] = 0U;
+
+    while (stack_size > 0U)
+    {
+      const uint32_t node_idx = stack[--stack_size];
+      const Node &node = tree.nodes[node_idx];
+
+      if (node.axis == kLeafAxis)
+      {
+        for (uint32_t i = node.begin; i < node.end; i++)
+        {
+          const T d2 = internal::squaredDistance(tree.points[i], query);
+          if (d2 <= squared_radius)
+          {
+            result.push_back({tree.indices[i], d2});
+          }
+        }
+        continue;
+      }
+
+      const T diff = internal::pointCoordinate(query, node.axis) - node.split_value;
+
+      if ((diff <= T(0)) || (diff * diff <= squared_radius))
+      {
+        stack[stack_size++] = node_idx + 1U;
+      }
+      if ((diff >= T(0)) || (diff * diff <= squared_radius))
+      {
+        stack[stack_size++] = node.right_child;
+      }
+    }
+  }
+
+  template <typename T>
+  std::vector<NeighborResult<T>> KDTree<T>::knnSearch(const Point3<T> &query,
+                                                      const size_t k) const
+  {
+    std::vector<NeighborResult<T>> heap;
+    if (k == 0U)
+    {
+      return heap;
+    }
+    heap.reserve(std::min(k, num_points_));
+
+    searchKnn(base_tree_, query, k, heap);
+    for (const StaticTree &tree : insertion_levels_)
+    {
+      searchKnn(tree, query, k, heap);
+    }
+
+    const size_t first_pending_index = num_points_ - pending_points_.size();
+    for (size_t i = 0; i < pending_points_.size(); i++)
+    {
+      internal::pushCandidate(heap, k, first_pending_index + i,
+                              internal::squaredDistance(pending_points_[i], query));
+    }
+
+    std::sort_heap(heap.begin(), heap.end(), internal::neighborCompare<T>);
+    return heap;
+  }
+
+  template <typename T>
+  NeighborResult<T> KDTree<T>::nearest(const Point3<T> &query) const
+  {
+    ASSERT(num_points_ > 0U) << "Nearest neighbor search in empty KDTree!";
+    return knnSearch(query, 1U)[0];
+  }
+
+  template <typename T>
+  std::vector<NeighborResult<T>>
+  KDTree<T>::radiusSearch(const Point3<T> &query, const T radius) const
+  {
+    std::vector<NeighborResult<T>> result;
+    const T squared_radius = radius * radius;
+
+    searchRadius(base_tree_, query, squared_radius, result);
+    for (const StaticTree &tree : insertion_levels_)
+    {
+      searchRadius(tree, query, squared_radius, result);
+    }
+
+    const size_t first_pending_index = num_points_ - pending_points_.size();
+    for (size_t i = 0; i < pending_points_.size(); i++)
+    {
+      const T d2 = internal::squaredDistance(pending_points_[i], query);
+      if (d2 <= squared_radius)
+      {
+        result.push_back({first_pending_index + i, d2});
+      }
+    }
+
+    std::sort(result.begin(), result.end(), internal::neighborCompare<T>);
+    return result;
+  }
+
+  template <typename T>
+  std::vector<std::vector<NeighborResult<T>>>
+  KDTree<T>::knnSearch(const Point3<T> *const queries, const size_t num_queries,
+                       const size_t k) const
+  {
+    std::vector<std::vector<NeighborResult<T>>> results(num_queries);
+
+    internal::parallelFor(
+        0U, num_queries, internal::kSpatialQueryChunkSize,
+        [&](const size_t chunk_begin, const size_t chunk_end)
+        {
+          for (size_t i = chunk_begin; i < chunk_end; i++)
+          {
+            results[i] = knnSearch(queries[i], k);
+          }
+        },
+        num_threads_);
+
+    return results;
+  }
+
+  template <typename T>
+  std::vector<std::vector<NeighborResult<T>>>
+  KDTree<T>::knnSearch(const Vector<Point3<T>> &queries, const size_t k) const
+  {
+    return knnSearch(queries.data(), queries.size(), k);
+  }
+
+  template <typename T>
+  std::vector<std::vector<NeighborResult<T>>>
+  KDTree<T>::radiusSearch(const Point3<T> *const queries,
+                          const size_t num_queries, const T radius) const
+  {
+    std::vector<std::vector<NeighborResult<T>>> results(num_queries);
+
+    internal::parallelFor(
+        0U, num_queries, internal::kSpatialQueryChunkSize,
+        [&](const size_t chunk_begin, const size_t chunk_end)
+        {
+          for (size_t i = chunk_begin; i < chunk_end; i++)
+          {
+            results[i] = radiusSearch(queries[i], radius);
+          }
+        },
+        num_threads_);
+
+    return results;
+  }
+
+  template <typename T>
+  std::vector<std::vector<NeighborResult<T>>>
+  KDTree<T>::radiusSearch(const Vector<Point3<T>> &queries,
+                          const T radius) const
+  {
+    return radiusSearch(queries.data(), queries.size(), radius);
+  }
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_SPATIAL_KD_TREE_H_
@@ -0,0 +1,18 @@
+#ifndef LUMOS_MATH_SPATIAL_SPATIAL_H_
+#define LUMOS_MATH_SPATIAL_SPATIAL_H_
+
+#include "lumos/math/spatial/kd_tree.h"
+#include "lumos/math/spatial/voxel_grid.h"
+
+namespace lumos
+{
+
+    // Common type aliases for convenience
+    typedef KDTree<double> KDTreed;
+    typedef KDTree<float> KDTreef;
+    typedef VoxelHashGrid<double> VoxelHashGridd;
+    typedef VoxelHashGrid<float> VoxelHashGridf;
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_SPATIAL_SPATIAL_H_
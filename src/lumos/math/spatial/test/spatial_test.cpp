@@ -0,0 +1,344 @@
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include "lumos/math/spatial/spatial.h"
+
+namespace lumos
+{
+
+  class SpatialTest : public ::testing::Test
+  {
+  protected:
+    void SetUp() override
+    {
+      std::mt19937 gen(42);
+      std::uniform_real_distribution<double> dist(-10.0, 10.0);
+
+      points.resize(2000);
+      for (Point3<double> &p : points)
+      {
+        p = Point3<double>(dist(gen), dist(gen), dist(gen));
+      }
+
+      queries.resize(200);
+      for (Point3<double> &q : queries)
+      {
+        q = Point3<double>(dist(gen), dist(gen), dist(gen));
+      }
+    }
+
+    static std::vector<NeighborResult<double>>
+    bruteForceKnn(const std::vector<Point3<double>> &pts,
+                  const Point3<double> &q, const size_t k)
+    {
+      std::vector<NeighborResult<double>> all;
+      for (size_t i = 0; i < pts.size(); i++)
+      {
+        all.push_back({i, internal::squaredDistance(pts[i], q)});
+      }
+      std::sort(all.begin(), all.end(), internal::neighborCompare<double>);
+      all.resize(std::min(k, all.size()));
+      return all;
+    }
+
+    static std::vector<size_t>
+    bruteForceRadius(const std::vector<Point3<double>> &pts,
+                     const Point3<double> &q, const double r)
+    {
+      std::vector<size_t> result;
+      for (size_t i = 0; i < pts.size(); i++)
+      {
+        if (internal::squaredDistance(pts[i], q) <= r * r)
+        {
+          result.push_back(i);
+        }
+      }
+      return result;
+    }
+
+    static std::vector<size_t>
+    sortedIndices(const std::vector<NeighborResult<double>> &neighbors)
+    {
+      std::vector<size_t> result;
+      for (const NeighborResult<double> &n : neighbors)
+      {
+        result.push_back(n.index);
+      }
+      std::sort(result.begin(), result.end());
+      return result;
+    }
+
+    std::vector<Point3<double>> points;
+    std::vector<Point3<double>> queries;
+  };
+
+  TEST_F(SpatialTest, EmptyTree)
+  {
+    KDTreed tree;
+    EXPECT_TRUE(tree.isEmpty());
+    EXPECT_EQ(tree.size(), 0U);
+    EXPECT_TRUE(tree.knnSearch(Point3<double>(0.0, 0.0, 0.0), 5).empty());
+    EXPECT_TRUE(tree.radiusSearch(Point3<double>(0.0, 0.0, 0.0), 1.0).empty());
+  }
+
+  TEST_F(SpatialTest, KnnMatchesBruteForce)
+  {
+    const KDTreed tree(points, 8U, 1U);
+    ASSERT_EQ(tree.size(), points.size());
+
+    for (const Point3<double> &q : queries)
+    {
+      const std::vector<NeighborResult<double>> expected = bruteForceKnn(points, q, 7);
+      const std::vector<NeighborResult<double>> actual = tree.knnSearch(q, 7);
+
+      ASSERT_EQ(actual.size(), expected.size());
+      for (size_t i = 0; i < actual.size(); i++)
+      {
+        EXPECT_NEAR(actual[i].squared_distance, expected[i].squared_distance, 1e-12);
+        EXPECT_NEAR(internal::squaredDistance(points[actual[i].index], q),
+                    actual[i].squared_distance, 1e-12);
+      }
+    }
+  }
+
+  TEST_F(SpatialTest, NearestNeighbor)
+  {
+    const KDTreed tree(points);
+
+    for (size_t i = 0; i < 50; i++)
+    {
+      const NeighborResult<double> n = tree.nearest(points[i]);
+      EXPECT_EQ(n.index, i);
+      EXPECT_DOUBLE_EQ(n.squared_distance, 0.0);
+    }
+  }
+
+  TEST_F(SpatialTest, KLargerThanSize)
+  {
+    const std::vector<Point3<double>> few_points(points.begin(), points.begin() + 5);
+    const KDTreed tree(few_points, 2U);
+
+    const std::vector<NeighborResult<double>> result =
+        tree.knnSearch(Point3<double>(0.0, 0.0, 0.0), 10);
+    ASSERT_EQ(result.size(), 5U);
+    for (size_t i = 1; i < result.size(); i++)
+    {
+      EXPECT_LE(result[i - 1].squared_distance, result[i].squared_distance);
+    }
+  }
+
+  TEST_F(SpatialTest, RadiusMatchesBruteForce)
+  {
+    const KDTreed tree(points);
+
+    for (const Point3<double> &q : queries)
+    {
+      const std::vector<NeighborResult<double>> result = tree.radiusSearch(q, 2.5);
+      EXPECT_EQ(sortedIndices(result), bruteForceRadius(points, q, 2.5));
+
+      for (size_t i = 1; i < result.size(); i++)
+      {
+        EXPECT_LE(result[i - 1].squared_distance, result[i].squared_distance);
+      }
+    }
+  }
+
+  TEST_F(SpatialTest, DuplicatePoints)
+  {
+    std::vector<Point3<double>> duplicates(100, Point3<double>(1.0, 2.0, 3.0));
+    const KDTreed tree(duplicates, 4U);
+
+    EXPECT_EQ(tree.radiusSearch(Point3<double>(1.0, 2.0, 3.0), 1e-6).size(), 100U);
+    EXPECT_EQ(tree.knnSearch(Point3<double>(0.0, 0.0, 0.0), 10).size(), 10U);
+  }
+
+  TEST_F(SpatialTest, ParallelBuildMatchesSerialBuild)
+  {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> dist(-100.0, 100.0);
+    std::vector<Point3<double>> many_points(50000);
+    for (Point3<double> &p : many_points)
+    {
+      p = Point3<double>(dist(gen), dist(gen), dist(gen));
+    }
+
+    const KDTreed serial_tree(many_points, 16U, 1U);
+    const KDTreed parallel_tree(many_points, 16U, 4U);
+
+    for (const Point3<double> &q : queries)
+    {
+      const std::vector<NeighborResult<double>> r0 = serial_tree.knnSearch(q, 5);
+      const std::vector<NeighborResult<double>> r1 = parallel_tree.knnSearch(q, 5);
+      ASSERT_EQ(r0.size(), r1.size());
+      for (size_t i = 0; i < r0.size(); i++)
+      {
+        EXPECT_EQ(r0[i].index, r1[i].index);
+      }
+    }
+  }
+
+  TEST_F(SpatialTest, BatchedQueries)
+  {
+    const KDTreed tree(points, 16U, 4U);
+
+    const std::vector<std::vector<NeighborResult<double>>> knn_results =
+        tree.knnSearch(queries.data(), queries.size(), 4);
+    const std::vector<std::vector<NeighborResult<double>>> radius_results =
+        tree.radiusSearch(queries.data(), queries.size(), 2.0);
+
+    ASSERT_EQ(knn_results.size(), queries.size());
+    ASSERT_EQ(radius_results.size(), queries.size());
+
+    for (size_t i = 0; i < queries.size(); i++)
+    {
+      const std::vector<NeighborResult<double>> knn = tree.knnSearch(queries[i], 4);
+      ASSERT_EQ(knn_results[i].size(), knn.size());
+      for (size_t j = 0; j < knn.size(); j++)
+      {
+        EXPECT_EQ(knn_results[i][j].index, knn[j].index);
+      }
+      EXPECT_EQ(sortedIndices(radius_results[i]), bruteForceRadius(points, queries[i], 2.0));
+    }
+  }
+
+  TEST_F(SpatialTest, IncrementalInsertion)
+  {
+    const std::vector<Point3<double>> initial(points.begin(), points.begin() + 500);
+    KDTreed tree(initial, 8U, 1U);
+
+    for (size_t i = 500; i < points.size(); i++)
+    {
+      tree.insert(points[i]);
+    }
+    ASSERT_EQ(tree.size(), points.size());
+    EXPECT_GT(tree.numInsertionLevels(), 0U);
+
+    for (const Point3<double> &q : queries)
+    {
+      const std::vector<NeighborResult<double>> expected = bruteForceKnn(points, q, 5);
+      const std::vector<NeighborResult<double>> actual = tree.knnSearch(q, 5);
+      ASSERT_EQ(actual.size(), expected.size());
+      for (size_t i = 0; i < actual.size(); i++)
+      {
+        EXPECT_NEAR(actual[i].squared_distance, expected[i].squared_distance, 1e-12);
+      }
+      EXPECT_EQ(sortedIndices(tree.radiusSearch(q, 2.0)), bruteForceRadius(points, q, 2.0));
+    }
+
+    tree.rebuild();
+    EXPECT_EQ(tree.numInsertionLevels(), 0U);
+    EXPECT_EQ(tree.size(), points.size());
+    for (size_t i = 0; i < points.size(); i += 97)
+    {
+      EXPECT_EQ(tree.nearest(points[i]).index, i);
+    }
+  }
+
+  TEST_F(SpatialTest, InsertIntoEmptyTree)
+  {
+    KDTreed tree;
+    tree.insert(points.data(), 37U);
+    ASSERT_EQ(tree.size(), 37U);
+
+    const std::vector<Point3<double>> subset(points.begin(), points.begin() + 37);
+    for (const Point3<double> &q : queries)
+    {
+      EXPECT_EQ(sortedIndices(tree.radiusSearch(q, 8.0)), bruteForceRadius(subset, q, 8.0));
+    }
+  }
+
+  TEST_F(SpatialTest, FloatTree)
+  {
+    std::vector<Point3<float>> float_points;
+    for (const Point3<double> &p : points)
+    {
+      float_points.push_back(Point3<float>(p.x, p.y, p.z));
+    }
+    const KDTreef tree(float_points);
+
+    for (size_t i = 0; i < 20; i++)
+    {
+      EXPECT_EQ(tree.nearest(float_points[i]).index, i);
+    }
+  }
+
+  TEST_F(SpatialTest, VoxelGridRadiusSearch)
+  {
+    VoxelHashGridd grid(1.5);
+    grid.insert(points.data(), points.size());
+    ASSERT_EQ(grid.size(), points.size());
+    EXPECT_GT(grid.numOccupiedVoxels(), 0U);
+
+    for (const Point3<double> &q : queries)
+    {
+      const std::vector<NeighborResult<double>> result = grid.radiusSearch(q, 2.0);
+      EXPECT_EQ(sortedIndices(result), bruteForceRadius(points, q, 2.0));
+      EXPECT_EQ(grid.countWithinRadius(q, 2.0), result.size());
+    }
+  }
+
+  TEST_F(SpatialTest, VoxelGridBatchedQueries)
+  {
+    VoxelHashGridd grid(1.0, 4U);
+    for (const Point3<double> &p : points)
+    {
+      grid.insert(p);
+    }
+
+    const std::vector<std::vector<NeighborResult<double>>> results =
+        grid.radiusSearch(queries.data(), queries.size(), 1.7);
+    ASSERT_EQ(results.size(), queries.size());
+    for (size_t i = 0; i < queries.size(); i++)
+    {
+      EXPECT_EQ(sortedIndices(results[i]), bruteForceRadius(points, queries[i], 1.7));
+    }
+
+    grid.clear();
+    EXPECT_EQ(grid.size(), 0U);
+    EXPECT_EQ(grid.numOccupiedVoxels(), 0U);
+  }
+
+  TEST_F(SpatialTest, VoxelGridCoordinatesOutOfKeyRange)
+  {
+    // Voxel coordinates of 2^21 voxels apart used to share one key, and
+    // coordinates beyond the int32 range overflowed the cast
+    VoxelHashGridd grid(0.5);
+    const double wrap = 0.5 * static_cast<double>(1U << 21U);
+    const std::vector<Point3<double>> far_points = {{0.25, 0.25, 0.25},
+                                                    {wrap + 0.25, 0.25, 0.25},
+                                                    {0.25, -wrap + 0.25, 0.25},
+                                                    {1e12, 0.25, 0.25},
+                                                    {1e12 + 0.5, 0.25, 0.25},
+                                                    {0.25, 0.25, -1e30}};
+    grid.insert(far_points.data(), far_points.size());
+
+    const Point3<double> origin(0.0, 0.0, 0.0);
+    EXPECT_EQ(sortedIndices(grid.radiusSearch(origin, 1.0)), bruteForceRadius(far_points, origin, 1.0));
+
+    const Point3<double> far_query(1e12, 0.0, 0.0);
+    EXPECT_EQ(sortedIndices(grid.radiusSearch(far_query, 1.0)), bruteForceRadius(far_points, far_query, 1.0));
+
+    // A radius covering every voxel returns every point once
+    for (const double radius : {1e7, 1e13, 1e31})
+    {
+      EXPECT_EQ(sortedIndices(grid.radiusSearch(origin, radius)), bruteForceRadius(far_points, origin, radius));
+    }
+  }
+
+  TEST_F(SpatialTest, VoxelGridLargeRadius)
+  {
+    VoxelHashGridd grid(0.1);
+    grid.insert(points.data(), points.size());
+
+    for (const Point3<double> &q : queries)
+    {
+      const std::vector<NeighborResult<double>> result = grid.radiusSearch(q, 1e6);
+      EXPECT_EQ(result.size(), points.size());
+      EXPECT_EQ(sortedIndices(result), bruteForceRadius(points, q, 1e6));
+    }
+  }
+
+} // namespace lumos
@@ -0,0 +1,230 @@
+#ifndef LUMOS_MATH_SPATIAL_VOXEL_GRID_H_
+#define LUMOS_MATH_SPATIAL_VOXEL_GRID_H_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "lumos/logging.h"
+#include "lumos/math/lin_alg.h"
+#include "lumos/math/misc/parallel_for.h"
+#include "lumos/math/spatial/class_def/voxel_grid.h"
+#include "lumos/math/spatial/kd_tree.h"
+
+namespace lumos
+{
+  template <typename T>
+  VoxelHashGrid<T>::VoxelHashGrid()
+      : voxel_size_(T(1)), inv_voxel_size_(T(1)), num_threads_(0U)
+  {
+  }
+
+  template <typename T>
+  VoxelHashGrid<T>::VoxelHashGrid(const T voxel_size, const size_t num_threads)
+      : voxel_size_(voxel_size), inv_voxel_size_(T(1) / voxel_size),
+        num_threads_(num_threads)
+  {
+    ASSERT(voxel_size > T(0)) << "Voxel size must be positive!";
+  }
+
+  template <typename T>
+  int32_t VoxelHashGrid<T>::voxelCoordinate(const T value) const
+  {
+    // Clamped before the cast, which is undefined for values out of range.
+    // Points beyond the range share the voxels at its border, the queries
+    // compare exact distances, so this only costs speed. NaN goes to the
+    // lower border
+    const T scaled = std::floor(value * inv_voxel_size_);
+    if (!(scaled >= static_cast<T>(kMinVoxelCoordinate)))
+    {
+      return kMinVoxelCoordinate;
+    }
+    if (scaled > static_cast<T>(kMaxVoxelCoordinate))
+    {
+      return kMaxVoxelCoordinate;
+    }
+    return static_cast<int32_t>(scaled);
+  }
+
+  template <typename T>
+  uint64_t VoxelHashGrid<T>::voxelKey(const int32_t ix, const int32_t iy,
+                                      const int32_t iz)
+  {
+    // 21 bits per axis, two's complement truncated, gives unique keys for
+    // the voxel coordinates in [-2^20, 2^20) that voxelCoordinate returns
+    constexpr uint64_t kMask = (uint64_t{1} << 21U) - 1U;
+    return ((static_cast<uint64_t>(ix) & kMask) << 42U) |
+           ((static_cast<uint64_t>(iy) & kMask) << 21U) |
+           (static_cast<uint64_t>(iz) & kMask);
+  }
+
+  template <typename T>
+  void VoxelHashGrid<T>::insert(const Point3<T> &point)
+  {
+    ASSERT(points_.size() < std::numeric_limits<uint32_t>::max())
+        << "Too many points for VoxelHashGrid!";
+
+    const uint64_t key = voxelKey(voxelCoordinate(point.x),
+                                  voxelCoordinate(point.y),
+                                  voxelCoordinate(point.z));
+    cells_[key].push_back(static_cast<uint32_t>(points_.size()));
+    points_.push_back(point);
+  }
+
+  template <typename T>
+  void VoxelHashGrid<T>::insert(const Point3<T> *const points,
+                                const size_t num_points)
+  {
+    points_.reserve(points_.size() + num_points);
+    for (size_t k = 0; k < num_points; k++)
+    {
+      insert(points[k]);
+    }
+  }
+
+  template <typename T>
+  void VoxelHashGrid<T>::insert(const Vector<Point3<T>> &points)
+  {
+    insert(points.data(), points.size());
+  }
+
+  template <typename T>
+  void VoxelHashGrid<T>::clear()
+  {
+    points_.clear();
+    cells_.clear();
+  }
+
+  template <typename T>
+  void VoxelHashGrid<T>::setNumThreads(const size_t num_threads)
+  {
+    num_threads_ = num_threads;
+  }
+
+  template <typename T>
+  size_t VoxelHashGrid<T>::size() const
+  {
+    return points_.size();
+  }
+
+  template <typename T>
+  size_t VoxelHashGrid<T>::numOccupiedVoxels() const
+  {
+    return cells_.size();
+  }
+
+  template <typename T>
+  T VoxelHashGrid<T>::voxelSize() const
+  {
+    return voxel_size_;
+  }
+
+  template <typename T>
+  const Point3<T> &VoxelHashGrid<T>::point(const size_t index) const
+  {
+    return points_[index];
+  }
+
+  template <typename T>
+  std::vector<NeighborResult<T>>
+  VoxelHashGrid<T>::radiusSearch(const Point3<T> &query, const T radius) const
+  {
+    std::vector<NeighborResult<T>> result;
+    const T squared_radius = radius * radius;
+
+    const int32_t x0 = voxelCoordinate(query.x - radius);
+    const int32_t x1 = voxelCoordinate(query.x + radius);
+    const int32_t y0 = voxelCoordinate(query.y - radius);
+    const int32_t y1 = voxelCoordinate(query.y + radius);
+    const int32_t z0 = voxelCoordinate(query.z - radius);
+    const int32_t z1 = voxelCoordinate(query.z + radius);
+    if ((x1 < x0) || (y1 < y0) || (z1 < z0))
+    {
+      return result;
+    }
+
+    // Large radii cover more voxels than are occupied, a scan of all points
+    // is cheaper then
+    const uint64_t num_cells = static_cast<uint64_t>(x1 - x0 + 1) *
+                               static_cast<uint64_t>(y1 - y0 + 1) *
+                               static_cast<uint64_t>(z1 - z0 + 1);
+    if (num_cells > cells_.size())
+    {
+      for (size_t idx = 0; idx < points_.size(); idx++)
+      {
+        const T d2 = internal::squaredDistance(points_[idx], query);
+        if (d2 <= squared_radius)
+        {
+          result.push_back({static_cast<uint32_t>(idx), d2});
+        }
+      }
+      std::sort(result.begin(), result.end(), internal::neighborCompare<T>);
+      return result;
+    }
+
+    for (int32_t ix = x0; ix <= x1; ix++)
+    {
+      for (int32_t iy = y0; iy <= y1; iy++)
+      {
+        for (int32_t iz = z0; iz <= z1; iz++)
+        {
+          const auto it = cells_.find(voxelKey(ix, iy, iz));
+          if (it == cells_.end())
+          {
+            continue;
+          }
+          for (const uint32_t idx : it->second)
+          {
+            const T d2 = internal::squaredDistance(points_[idx], query);
+            if (d2 <= squared_radius)
+            {
+              result.push_back({idx, d2});
+            }
+          }
+        }
+      }
+    }
+
+    std::sort(result.begin(), result.end(), internal::neighborCompare<T>);
+    return result;
+  }
+
+  template <typename T>
+  size_t VoxelHashGrid<T>::countWithinRadius(const Point3<T> &query,
+                                             const T radius) const
+  {
+    return radiusSearch(query, radius).size();
+  }
+
+  template <typename T>
+  std::vector<std::vector<NeighborResult<T>>>
+  VoxelHashGrid<T>::radiusSearch(const Point3<T> *const queries,
+                                 const size_t num_queries, const T radius) const
+  {
+    std::vector<std::vector<NeighborResult<T>>> results(num_queries);
+
+    internal::parallelFor(
+        0U, num_queries, internal::kSpatialQueryChunkSize,
+        [&](const size_t chunk_begin, const size_t chunk_end)
+        {
+          for (size_t i = chunk_begin; i < chunk_end; i++)
+          {
+            results[i] = radiusSearch(queries[i], radius);
+          }
+        },
+        num_threads_);
+
+    return results;
+  }
+
+  template <typename T>
+  std::vector<std::vector<NeighborResult<T>>>
+  VoxelHashGrid<T>::radiusSearch(const Vector<Point3<T>> &queries,
+                                 const T radius) const
+  {
+    return radiusSearch(queries.data(), queries.size(), radius);
+  }
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_SPATIAL_VOXEL_GRID_H_
@@ -1,6 +1,9 @@
 #ifndef LUMOS_MATH_TRANSFORMATIONS_AXIS_ANGLE_H_
 #define LUMOS_MATH_TRANSFORMATIONS_AXIS_ANGLE_H_
 
+#include <algorithm>
+#include <cmath>
+
 #include "lumos/math/lin_alg.h"
 #include "lumos/math/transformations/class_def/axis_angle.h"
 #include "lumos/math/transformations/class_def/euler_angles.h"
@@ -96,11 +99,9 @@ namespace lumos
                 normalized_axis_angle.z)
             .toCrossProductMatrix();
 
-    const FixedSizeMatrix<T, 3, 3> unit_matrix = unitMatrix<T>(3, 3);
-
     const FixedSizeMatrix<T, 3, 3> rotation_matrix =
-        unit_matrix + std::sin(normalized_axis_angle.phi) * k_matrix +
-        (1.0 - std::cos(normalized_axis_angle.phi)) * k_matrix * k_matrix;
+        unitMatrix<T, 3, 3>() + k_matrix * std::sin(normalized_axis_angle.phi) +
+        (k_matrix * k_matrix) * (T(1) - std::cos(normalized_axis_angle.phi));
 
     return rotation_matrix;
   }
@@ -156,10 +157,10 @@ namespace lumos
     AxisAngle<T> axis_angle;
     const T epsilon = T(1e-8);
 
-    const T sin_half_angle = std::sqrt(q.x_ * q.x_ + q.y_ * q.y_ + q.z_ * q.z_);
+    const T sin_half_angle = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z);
 
     // Clamp w to [-1, 1] to avoid acos domain errors
-    const T w_clamped = std::clamp(q.w_, T(-1), T(1));
+    const T w_clamped = std::clamp(q.w, T(-1), T(1));
     axis_angle.phi = T{2.0} * std::acos(w_clamped);
 
     if (sin_half_angle < epsilon)
@@ -171,9 +172,9 @@ namespace lumos
     }
     else
     {
-      axis_angle.x = q.x_ / sin_half_angle;
-      axis_angle.y = q.y_ / sin_half_angle;
-      axis_angle.z = q.z_ / sin_half_angle;
+      axis_angle.x = q.x / sin_half_angle;
+      axis_angle.y = q.y / sin_half_angle;
+      axis_angle.z = q.z / sin_half_angle;
     }
 
     return axis_angle;
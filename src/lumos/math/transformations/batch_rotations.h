@@ -0,0 +1,536 @@
+#ifndef LUMOS_MATH_TRANSFORMATIONS_BATCH_ROTATIONS_H_
+#define LUMOS_MATH_TRANSFORMATIONS_BATCH_ROTATIONS_H_
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "lumos/logging.h"
+#include "lumos/math/geometry/point_array.h"
+#include "lumos/math/misc/parallel_for.h"
+#include "lumos/math/misc/sin_cos.h"
+#include "lumos/math/transformations/rotation_arrays.h"
+
+// Batch versions of the quaternion, Euler angle and rotation matrix
+// conversions, for long orientation logs. Quaternions and Euler angles are
+// stored as structure of arrays (QuaternionArray, EulerAnglesArray), vectors
+// as PointArray3D. The inner loops have no data dependent branches and use
+// internal::sinCos instead of std::sin / std::cos, so the compiler can
+// vectorize them. Loops with std::sqrt or a comparison also need
+// -fno-math-errno -fno-trapping-math for that, and rotation matrices are
+// arrays of structures, which only get vectorized within one matrix. Functions
+// that need std::acos, std::asin or std::atan2 are noted, those calls stay
+// scalar. Inputs larger than two chunks of
+// kBatchRotationMinChunkSize elements are split over num_threads threads
+// (0 = all cores). Outputs are resized to the input size.
+
+// Outputs can be the same arrays as the inputs but never overlap them with an
+// offset, so there are no dependencies between loop iterations. Without this
+// the compiler gives up on the many runtime alias checks and does not vectorize
+#if defined(__clang__)
+#define LUMOS_BATCH_ROTATION_LOOP _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+#define LUMOS_BATCH_ROTATION_LOOP _Pragma("GCC ivdep")
+#else
+#define LUMOS_BATCH_ROTATION_LOOP
+#endif
+
+namespace lumos
+{
+  namespace internal
+  {
+    constexpr size_t kBatchRotationMinChunkSize = 16384U;
+  } // namespace internal
+
+  // out[i] = a[i] * b[i]
+  template <typename T>
+  void multiplyQuaternions(const QuaternionArray<T> &a, const QuaternionArray<T> &b,
+                           QuaternionArray<T> &out, const size_t num_threads = 0U)
+  {
+    ASSERT(a.size() == b.size()) << "Number of quaternions must be equal!";
+    out.resize(a.size());
+
+    const T *const aw = a.w.data();
+    const T *const ax = a.x.data();
+    const T *const ay = a.y.data();
+    const T *const az = a.z.data();
+    const T *const bw = b.w.data();
+    const T *const bx = b.x.data();
+    const T *const by = b.y.data();
+    const T *const bz = b.z.data();
+    T *const ow = out.w.data();
+    T *const ox = out.x.data();
+    T *const oy = out.y.data();
+    T *const oz = out.z.data();
+
+    internal::parallelFor(
+        0U, a.size(), internal::kBatchRotationMinChunkSize,
+        [&](const size_t begin, const size_t end)
+        {
+          LUMOS_BATCH_ROTATION_LOOP
+          for (size_t i = begin; i < end; i++)
+          {
+            // Temporaries, so that out may alias a or b
+            const T w = aw[i] * bw[i] - ax[i] * bx[i] - ay[i] * by[i] - az[i] * bz[i];
+            const T x = aw[i] * bx[i] + ax[i] * bw[i] + ay[i] * bz[i] - az[i] * by[i];
+            const T y = aw[i] * by[i] - ax[i] * bz[i] + ay[i] * bw[i] + az[i] * bx[i];
+            const T z = aw[i] * bz[i] + ax[i] * by[i] - ay[i] * bx[i] + az[i] * bw[i];
+            ow[i] = w;
+            ox[i] = x;
+            oy[i] = y;
+            oz[i] = z;
+          }
+        },
+        num_threads);
+  }
+
+  // Normalizes every quaternion in place, zero quaternions are left unchanged
+  // like in Quaternion::normalize
+  template <typename T>
+  void normalizeQuaternions(QuaternionArray<T> &q, const size_t num_threads = 0U)
+  {
+    T *const qw = q.w.data();
+    T *const qx = q.x.data();
+    T *const qy = q.y.data();
+    T *const qz = q.z.data();
+
+    internal::parallelFor(
+        0U, q.size(), internal::kBatchRotationMinChunkSize,
+        [&](const size_t begin, const size_t end)
+        {
+          LUMOS_BATCH_ROTATION_LOOP
+          for (size_t i = begin; i < end; i++)
+          {
+            const T norm = std::sqrt(qw[i] * qw[i] + qx[i] * qx[i] + qy[i] * qy[i] + qz[i] * qz[i]);
+            const T scale = T(1) / (norm > T(0) ? norm : T(1));
+            qw[i] *= scale;
+            qx[i] *= scale;
+            qy[i] *= scale;
+            qz[i] *= scale;
+          }
+        },
+        num_threads);
+  }
+
+  // out[i] = q[i] v[i] q[i]^*, for unit quaternions
+  template <typename T>
+  void rotateVectors(const QuaternionArray<T> &q, const PointArray3D<T> &v,
+                     PointArray3D<T> &out, const size_t num_threads = 0U)
+  {
+    ASSERT(q.size() == v.size()) << "Number of quaternions and vectors must be equal!";
+    out.resize(v.size());
+
+    const T *const qw = q.w.data();
+    const T *const qx = q.x.data();
+    const T *const qy = q.y.data();
+    const T *const qz = q.z.data();
+    const T *const vx = v.x.data();
+    const T *const vy = v.y.data();
+    const T *const vz = v.z.data();
+    T *const ox = out.x.data();
+    T *const oy = out.y.data();
+    T *const oz = out.z.data();
+
+    internal::parallelFor(
+        0U, v.size(), internal::kBatchRotationMinChunkSize,
+        [&](const size_t begin, const size_t end)
+        {
+          LUMOS_BATCH_ROTATION_LOOP
+          for (size_t i = begin; i < end; i++)
+          {
+            // v + w t + u x t with t = 2 u x v, same as SO3 * Vec3
+            const T tx = T(2) * (qy[i] * vz[i] - qz[i] * vy[i]);
+            const T ty = T(2) * (qz[i] * vx[i] - qx[i] * vz[i]);
+            const T tz = T(2) * (qx[i] * vy[i] - qy[i] * vx[i]);
+            const T x = vx[i] + qw[i] * tx + (qy[i] * tz - qz[i] * ty);
+            const T y = vy[i] + qw[i] * ty + (qz[i] * tx - qx[i] * tz);
+            const T z = vz[i] + qw[i] * tz + (qx[i] * ty - qy[i] * tx);
+            ox[i] = x;
+            oy[i] = y;
+            oz[i] = z;
+          }
+        },
+        num_threads);
+  }
+
+  // Rotates all vectors by the same quaternion, through its rotation matrix
+  template <typename T>
+  void rotateVectors(const Quaternion<T> &q, const PointArray3D<T> &v,
+                     PointArray3D<T> &out, const size_t num_threads = 0U)
+  {
+    out.resize(v.size());
+    const FixedSizeMatrix<T, 3, 3> m = q.toRotationMatrix();
+    const T m00 = m(0, 0), m01 = m(0, 1), m02 = m(0, 2);
+    const T m10 = m(1, 0), m11 = m(1, 1), m12 = m(1, 2);
+    const T m20 = m(2, 0), m21 = m(2, 1), m22 = m(2, 2);
+
+    const T *const vx = v.x.data();
+    const T *const vy = v.y.data();
+    const T *const vz = v.z.data();
+    T *const ox = out.x.data();
+    T *const oy = out.y.data();
+    T *const oz = out.z.data();
+
+    internal::parallelFor(
+        0U, v.size(), internal::kBatchRotationMinChunkSize,
+        [&](const size_t begin, const size_t end)
+        {
+          LUMOS_BATCH_ROTATION_LOOP
+          for (size_t i = begin; i < end; i++)
+          {
+            const T x = m00 * vx[i] + m01 * vy[i] + m02 * vz[i];
+            const T y = m10 * vx[i] + m11 * vy[i] + m12 * vz[i];
+            const T z = m20 * vx[i] + m21 * vy[i] + m22 * vz[i];
+            ox[i] = x;
+            oy[i] = y;
+            oz[i] = z;
+          }
+        },
+        num_threads);
+  }
+
+  namespace internal
+  {
+    // Shortest path slerp between unit quaternions with weight t_at(i) on b
+    template <typename T, typename TAt>
+    void slerpQuaternions(const QuaternionArray<T> &a, const QuaternionArray<T> &b,
+                          const TAt &t_at, QuaternionArray<T> &out, const size_t num_threads)
+    {
+      ASSERT(a.size() == b.size()) << "Number of quaternions must be equal!";
+      out.resize(a.size());
+
+      const T *const aw = a.w.data();
+      const T *const ax = a.x.data();
+      const T *const ay = a.y.data();
+      const T *const az = a.z.data();
+      const T *const bw = b.w.data();
+      const T *const bx = b.x.data();
+      const T *const by = b.y.data();
+      const T *const bz = b.z.data();
+      T *const ow = out.w.data();
+      T *const ox = out.x.data();
+      T *const oy = out.y.data();
+      T *const oz = out.z.data();
+
+      parallelFor(
+          0U, a.size(), kBatchRotationMinChunkSize,
+          [&](const size_t begin, const size_t end)
+          {
+            LUMOS_BATCH_ROTATION_LOOP
+            for (size_t i = begin; i < end; i++)
+            {
+              const T t = t_at(i);
+              const T dot = aw[i] * bw[i] + ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+              // q and -q are the same rotation, take the one closer to a
+              const T sign = dot < T(0) ? T(-1) : T(1);
+              const T cos_theta = std::min(sign * dot, T(1));
+              const T theta = std::acos(cos_theta);
+
+              T sin_theta, sin_a, sin_b, unused;
+              sinCos(theta, sin_theta, unused);
+              sinCos((T(1) - t) * theta, sin_a, unused);
+              sinCos(t * theta, sin_b, unused);
+
+              // Nearly equal rotations fall back to normalized lerp
+              const bool is_small = sin_theta < T(1e-6);
+              const T inv_sin = T(1) / (is_small ? T(1) : sin_theta);
+              const T weight_a = is_small ? T(1) - t : sin_a * inv_sin;
+              const T weight_b = sign * (is_small ? t : sin_b * inv_sin);
+
+              const T w = weight_a * aw[i] + weight_b * bw[i];
+              const T x = weight_a * ax[i] + weight_b * bx[i];
+              const T y = weight_a * ay[i] + weight_b * by[i];
+              const T z = weight_a * az[i] + weight_b * bz[i];
+              const T inv_norm = T(1) / std::sqrt(w * w + x * x + y * y + z * z);
+              ow[i] = w * inv_norm;
+              ox[i] = x * inv_norm;
+              oy[i] = y * inv_norm;
+              oz[i] = z * inv_norm;
+            }
+          },
+          num_threads);
+    }
+  } // namespace internal
+
+  // Spherical linear interpolation a[i] -> b[i] with the same t for all
+  // samples. Uses std::acos per sample
+  template <typename T>
+  void slerpQuaternions(const QuaternionArray<T> &a, const QuaternionArray<T> &b, const T t,
+                        QuaternionArray<T> &out, const size_t num_threads = 0U)
+  {
+    internal::slerpQuaternions(a, b, [t](const size_t) { return t; }, out, num_threads);
+  }
+
+  // Per sample interpolation parameter t[i]
+  template <typename T>
+  void slerpQuaternions(const QuaternionArray<T> &a, const QuaternionArray<T> &b,
+                        const std::vector<T> &t, QuaternionArray<T> &out,
+                        const size_t num_threads = 0U)
+  {
+    ASSERT(t.size() == a.size()) << "Number of interpolation parameters and quaternions must be equal!";
+    const T *const t_data = t.data();
+    internal::slerpQuaternions(a, b, [t_data](const size_t i) { return t_data[i]; }, out,
+                               num_threads);
+  }
+
+  // Quaternions of EulerAngles::toRotationMatrix, R = Rz(yaw) Ry(pitch) Rx(roll)
+  template <typename T>
+  void eulerAnglesToQuaternions(const EulerAnglesArray<T> &e, QuaternionArray<T> &out,
+                                const size_t num_threads = 0U)
+  {
+    out.resize(e.size());
+
+    const T *const roll = e.roll.data();
+    const T *const pitch = e.pitch.data();
+    const T *const yaw = e.yaw.data();
+    T *const ow = out.w.data();
+    T *const ox = out.x.data();
+    T *const oy = out.y.data();
+    T *const oz = out.z.data();
+
+    internal::parallelFor(
+        0U, e.size(), internal::kBatchRotationMinChunkSize,
+        [&](const size_t begin, const size_t end)
+        {
+          LUMOS_BATCH_ROTATION_LOOP
+          for (size_t i = begin; i < end; i++)
+          {
+            T sr, cr, sp, cp, sy, cy;
+            internal::sinCos(T(0.5) * roll[i], sr, cr);
+            internal::sinCos(T(0.5) * pitch[i], sp, cp);
+            internal::sinCos(T(0.5) * yaw[i], sy, cy);
+
+            ow[i] = cr * cp * cy + sr * sp * sy;
+            ox[i] = sr * cp * cy - cr * sp * sy;
+            oy[i] = cr * sp * cy + sr * cp * sy;
+            oz[i] = cr * cp * sy - sr * sp * cy;
+          }
+        },
+        num_threads);
+  }
+
+  // Inverse of eulerAnglesToQuaternions, pitch in [-pi / 2, pi / 2]. Uses
+  // std::atan2 and std::asin per sample
+  template <typename T>
+  void quaternionsToEulerAngles(const QuaternionArray<T> &q, EulerAnglesArray<T> &out,
+                                const size_t num_threads = 0U)
+  {
+    out.resize(q.size());
+
+    const T *const qw = q.w.data();
+    const T *const qx = q.x.data();
+    const T *const qy = q.y.data();
+    const T *const qz = q.z.data();
+    T *const roll = out.roll.data();
+    T *const pitch = out.pitch.data();
+    T *const yaw = out.yaw.data();
+
+    internal::parallelFor(
+        0U, q.size(), internal::kBatchRotationMinChunkSize,
+        [&](const size_t begin, const size_t end)
+        {
+          LUMOS_BATCH_ROTATION_LOOP
+          for (size_t i = begin; i < end; i++)
+          {
+            const T w = qw[i];
+            const T x = qx[i];
+            const T y = qy[i];
+            const T z = qz[i];
+            roll[i] = std::atan2(T(2) * (w * x + y * z), T(1) - T(2) * (x * x + y * y));
+            pitch[i] = std::asin(std::max(T(-1), std::min(T(1), T(2) * (w * y - z * x))));
+            yaw[i] = std::atan2(T(2) * (w * z + x * y), T(1) - T(2) * (y * y + z * z));
+          }
+        },
+        num_threads);
+  }
+
+  // Same as EulerAngles::toRotationMatrix for every sample
+  template <typename T>
+  void eulerAnglesToRotationMatrices(const EulerAnglesArray<T> &e,
+                                     std::vector<FixedSizeMatrix<T, 3, 3>> &out,
+                                     const size_t num_threads = 0U)
+  {
+    out.resize(e.size());
+
+    const T *const roll = e.roll.data();
+    const T *const pitch = e.pitch.data();
+    const T *const yaw = e.yaw.data();
+    FixedSizeMatrix<T, 3, 3> *const matrices = out.data();
+
+    internal::parallelFor(
+        0U, e.size(), internal::kBatchRotationMinChunkSize,
+        [&](const size_t begin, const size_t end)
+        {
+          LUMOS_BATCH_ROTATION_LOOP
+          for (size_t i = begin; i < end; i++)
+          {
+            T sr, cr, sp, cp, sy, cy;
+            internal::sinCos(roll[i], sr, cr);
+            internal::sinCos(pitch[i], sp, cp);
+            internal::sinCos(yaw[i], sy, cy);
+
+            T *const m = matrices[i].data_;
+            m[0] = cy * cp;
+            m[1] = cy * sp * sr - sy * cr;
+            m[2] = cy * sp * cr + sy * sr;
+            m[3] = sy * cp;
+            m[4] = sy * sp * sr + cy * cr;
+            m[5] = sy * sp * cr - cy * sr;
+            m[6] = -sp;
+            m[7] = cp * sr;
+            m[8] = cp * cr;
+          }
+        },
+        num_threads);
+  }
+
+  // Same as Quaternion::toRotationMatrix for every sample
+  template <typename T>
+  void quaternionsToRotationMatrices(const QuaternionArray<T> &q,
+                                     std::vector<FixedSizeMatrix<T, 3, 3>> &out,
+                                     const size_t num_threads = 0U)
+  {
+    out.resize(q.size());
+
+    const T *const qw = q.w.data();
+    const T *const qx = q.x.data();
+    const T *const qy = q.y.data();
+    const T *const qz = q.z.data();
+    FixedSizeMatrix<T, 3, 3> *const matrices = out.data();
+
+    internal::parallelFor(
+        0U, q.size(), internal::kBatchRotationMinChunkSize,
+        [&](const size_t begin, const size_t end)
+        {
+          LUMOS_BATCH_ROTATION_LOOP
+          for (size_t i = begin; i < end; i++)
+          {
+            const T w = qw[i];
+            const T x = qx[i];
+            const T y = qy[i];
+            const T z = qz[i];
+
+            T *const m = matrices[i].data_;
+            m[0] = w * w + x * x - y * y - z * z;
+            m[1] = T(2) * (x * y - w * z);
+            m[2] = T(2) * (x * z + w * y);
+            m[3] = T(2) * (x * y + w * z);
+            m[4] = w * w - x * x + y * y - z * z;
+            m[5] = T(2) * (y * z - w * x);
+            m[6] = T(2) * (x * z - w * y);
+            m[7] = T(2) * (y * z + w * x);
+            m[8] = w * w - x * x - y * y + z * z;
+          }
+        },
+        num_threads);
+  }
+
+  // Unit quaternions with w >= 0 from rotation matrices
+  template <typename T>
+  void rotationMatricesToQuaternions(const std::vector<FixedSizeMatrix<T, 3, 3>> &m,
+                                     QuaternionArray<T> &out, const size_t num_threads = 0U)
+  {
+    out.resize(m.size());
+
+    const FixedSizeMatrix<T, 3, 3> *const matrices = m.data();
+    T *const ow = out.w.data();
+    T *const ox = out.x.data();
+    T *const oy = out.y.data();
+    T *const oz = out.z.data();
+
+    internal::parallelFor(
+        0U, m.size(), internal::kBatchRotationMinChunkSize,
+        [&](const size_t begin, const size_t end)
+        {
+          LUMOS_BATCH_ROTATION_LOOP
+          for (size_t i = begin; i < end; i++)
+          {
+            const T *const r = matrices[i].data_;
+
+            // 4 w^2, 4 x^2, 4 y^2, 4 z^2 and the products 4 q_i q_j
+            const T d0 = T(1) + r[0] + r[4] + r[8];
+            const T d1 = T(1) + r[0] - r[4] - r[8];
+            const T d2 = T(1) - r[0] + r[4] - r[8];
+            const T d3 = T(1) - r[0] - r[4] + r[8];
+            const T wx = r[7] - r[5];
+            const T wy = r[2] - r[6];
+            const T wz = r[3] - r[1];
+            const T xy = r[1] + r[3];
+            const T xz = r[2] + r[6];
+            const T yz = r[5] + r[7];
+
+            // Shepperd's method without branches: divide the row 4 q_k q of
+            // the largest component k by 4 q_k
+            T dk = d0, pw = d0, px = wx, py = wy, pz = wz;
+            const bool use1 = d1 > dk;
+            dk = use1 ? d1 : dk;
+            pw = use1 ? wx : pw;
+            px = use1 ? d1 : px;
+            py = use1 ? xy : py;
+            pz = use1 ? xz : pz;
+            const bool use2 = d2 > dk;
+            dk = use2 ? d2 : dk;
+            pw = use2 ? wy : pw;
+            px = use2 ? xy : px;
+            py = use2 ? d2 : py;
+            pz = use2 ? yz : pz;
+            const bool use3 = d3 > dk;
+            dk = use3 ? d3 : dk;
+            pw = use3 ? wz : pw;
+            px = use3 ? xz : px;
+            py = use3 ? yz : py;
+            pz = use3 ? d3 : pz;
+
+            const T scale = (pw < T(0) ? T(-0.5) : T(0.5)) / std::sqrt(std::max(dk, T(0)));
+            ow[i] = pw * scale;
+            ox[i] = px * scale;
+            oy[i] = py * scale;
+            oz[i] = pz * scale;
+          }
+        },
+        num_threads);
+  }
+
+  // Quaternions of rotation vectors (axis * angle), same as SO3::exp
+  template <typename T>
+  void rotationVectorsToQuaternions(const PointArray3D<T> &v, QuaternionArray<T> &out,
+                                    const size_t num_threads = 0U)
+  {
+    out.resize(v.size());
+
+    const T *const vx = v.x.data();
+    const T *const vy = v.y.data();
+    const T *const vz = v.z.data();
+    T *const ow = out.w.data();
+    T *const ox = out.x.data();
+    T *const oy = out.y.data();
+    T *const oz = out.z.data();
+
+    internal::parallelFor(
+        0U, v.size(), internal::kBatchRotationMinChunkSize,
+        [&](const size_t begin, const size_t end)
+        {
+          LUMOS_BATCH_ROTATION_LOOP
+          for (size_t i = begin; i < end; i++)
+          {
+            const T theta_sq = vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i];
+            const T theta = std::sqrt(theta_sq);
+            T s, c;
+            internal::sinCos(T(0.5) * theta, s, c);
+
+            // sin(theta / 2) / theta, from its series near zero
+            const bool is_small = theta < T(1e-4);
+            const T sin_over_theta = s / (is_small ? T(1) : theta);
+            const T half_sinc = is_small ? T(0.5) - theta_sq / T(48) : sin_over_theta;
+            ow[i] = c;
+            ox[i] = half_sinc * vx[i];
+            oy[i] = half_sinc * vy[i];
+            oz[i] = half_sinc * vz[i];
+          }
+        },
+        num_threads);
+  }
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_TRANSFORMATIONS_BATCH_ROTATIONS_H_
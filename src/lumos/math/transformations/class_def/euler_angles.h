@@ -29,14 +29,8 @@ namespace lumos
     FixedSizeMatrix<T, 3, 3> toRotationMatrix() const;
 
     FixedSizeMatrix<T, 3, 3> rollMatrix() const;
-    const T cr = std::cos(roll);
-
     FixedSizeMatrix<T, 3, 3> pitchMatrix() const;
-    const T cp = std::cos(pitch);
-
     FixedSizeMatrix<T, 3, 3> yawMatrix() const;
-    const T cy = std::cos(yaw);
-
     FixedSizeMatrix<T, 3, 3> toRotationMatrix(RotationOrder order) const;
   };
 } // namespace lumos
@@ -0,0 +1,60 @@
+#ifndef LUMOS_MATH_TRANSFORMATIONS_CLASS_DEF_ROTATION_ARRAYS_H_
+#define LUMOS_MATH_TRANSFORMATIONS_CLASS_DEF_ROTATION_ARRAYS_H_
+
+#include <vector>
+
+#include "lumos/math/misc/forward_decl.h"
+
+namespace lumos
+{
+  // Structure of arrays quaternion storage, used by the batch rotation
+  // functions so that every component is contiguous in memory
+  template <typename T>
+  struct QuaternionArray
+  {
+    std::vector<T> w;
+    std::vector<T> x;
+    std::vector<T> y;
+    std::vector<T> z;
+
+    QuaternionArray();
+    explicit QuaternionArray(const size_t num_quaternions);
+    explicit QuaternionArray(const std::vector<Quaternion<T>> &quaternions);
+
+    size_t size() const;
+    void resize(const size_t num_quaternions);
+    void reserve(const size_t num_quaternions);
+    void clear();
+    void append(const Quaternion<T> &q);
+
+    Quaternion<T> quaternion(const size_t idx) const;
+    void setQuaternion(const size_t idx, const Quaternion<T> &q);
+    std::vector<Quaternion<T>> toQuaternions() const;
+  };
+
+  // Structure of arrays Euler angles, same ZYX convention as EulerAngles
+  template <typename T>
+  struct EulerAnglesArray
+  {
+    std::vector<T> roll;
+    std::vector<T> pitch;
+    std::vector<T> yaw;
+
+    EulerAnglesArray();
+    explicit EulerAnglesArray(const size_t num_angles);
+    explicit EulerAnglesArray(const std::vector<EulerAngles<T>> &angles);
+
+    size_t size() const;
+    void resize(const size_t num_angles);
+    void reserve(const size_t num_angles);
+    void clear();
+    void append(const EulerAngles<T> &e);
+
+    EulerAngles<T> angles(const size_t idx) const;
+    void setAngles(const size_t idx, const EulerAngles<T> &e);
+    std::vector<EulerAngles<T>> toEulerAngles() const;
+  };
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_TRANSFORMATIONS_CLASS_DEF_ROTATION_ARRAYS_H_
@@ -0,0 +1,73 @@
+#ifndef LUMOS_MATH_TRANSFORMATIONS_CLASS_DEF_SE3_H_
+#define LUMOS_MATH_TRANSFORMATIONS_CLASS_DEF_SE3_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "lumos/math/lin_alg/vector_low_dim/class_def/vec3.h"
+#include "lumos/math/misc/forward_decl.h"
+#include "lumos/math/transformations/class_def/quaternion.h"
+
+namespace lumos
+{
+
+  // Rigid body transformation, a rotation q followed by a translation t.
+  // A pose SE3 is defined as a coordinate system somewhere in space with an
+  // orientation and translation. Consider a pose SE3_0 and a point p0 defined in
+  // that coordinate system. The point p0 is defined as p0 = SE3_0.transform(p)
+  // where p is the point in the world coordinate system. The inverse is
+  // SE3_0.inverse().transform(p0) = p, which transforms the point
+  // p0 back to the world coordinate system.
+  // The tangent vector is xi = [rho; omega], translation part first, and the
+  // Jacobians use the same left perturbation convention as SO3.
+  template <typename T>
+  struct SE3
+  {
+    using Tangent = FixedSizeMatrix<T, 6, 1>;
+
+    Quaternion<T> q;
+    Vec3<T> t;
+
+    SE3();
+    SE3(const Quaternion<T> &q_, const Vec3<T> &t_);
+    SE3(const SO3<T> &r, const Vec3<T> &t_);
+
+    static SE3<T> exp(const Tangent &xi);
+    Tangent log() const;
+
+    SO3<T> rotation() const;
+    FixedSizeMatrix<T, 4, 4> toMatrix() const;
+
+    Vec3<T> transform(const Vec3<T> &p) const;
+    Vec3<T> operator*(const Vec3<T> &p) const;
+    SE3<T> operator*(const SE3<T> &other) const;
+    SE3<T> inverse() const;
+
+    // Batched versions, the rotation matrix is built once per pose instead of
+    // once per point. out may alias points
+    void transform(const Vec3<T> *points, Vec3<T> *out, size_t n) const;
+    std::vector<Vec3<T>> transform(const std::vector<Vec3<T>> &points) const;
+    // out[i] = a[i] * b[i]
+    static void compose(const SE3<T> *a, const SE3<T> *b, SE3<T> *out, size_t n);
+    // out[i] = poses[i].transform(points[i])
+    static void transform(const SE3<T> *poses, const Vec3<T> *points, Vec3<T> *out, size_t n);
+
+    // Adjoint, maps tangent vectors as exp(Ad xi) = T exp(xi) T^-1
+    FixedSizeMatrix<T, 6, 6> adjoint() const;
+
+    // Screw linear interpolation, a * exp(t * log(a^-1 * b)). The rotation
+    // and translation move together along one screw motion
+    static SE3<T> sclerp(const SE3<T> &a, const SE3<T> &b, T t);
+
+    static FixedSizeMatrix<T, 6, 6> leftJacobian(const Tangent &xi);
+    static FixedSizeMatrix<T, 6, 6> leftJacobianInverse(const Tangent &xi);
+    static FixedSizeMatrix<T, 6, 6> rightJacobian(const Tangent &xi);
+    static FixedSizeMatrix<T, 6, 6> rightJacobianInverse(const Tangent &xi);
+  };
+
+  using SE3d = SE3<double>;
+  using SE3f = SE3<float>;
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_TRANSFORMATIONS_CLASS_DEF_SE3_H_
@@ -0,0 +1,62 @@
+#ifndef LUMOS_MATH_TRANSFORMATIONS_CLASS_DEF_SIM3_H_
+#define LUMOS_MATH_TRANSFORMATIONS_CLASS_DEF_SIM3_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "lumos/math/lin_alg/vector_low_dim/class_def/vec3.h"
+#include "lumos/math/misc/forward_decl.h"
+#include "lumos/math/transformations/class_def/quaternion.h"
+
+namespace lumos
+{
+
+  // Similarity transformation p -> s * R * p + t, e.g. for monocular
+  // trajectories with unknown scale. The tangent vector is
+  // [rho; omega; sigma] with s = exp(sigma)
+  template <typename T>
+  struct Sim3
+  {
+    using Tangent = FixedSizeMatrix<T, 7, 1>;
+
+    Quaternion<T> q;
+    Vec3<T> t;
+    T s;
+
+    Sim3();
+    Sim3(const Quaternion<T> &q_, const Vec3<T> &t_, T s_);
+    Sim3(const SO3<T> &r, const Vec3<T> &t_, T s_);
+    explicit Sim3(const SE3<T> &pose);
+
+    static Sim3<T> exp(const Tangent &xi);
+    Tangent log() const;
+
+    SO3<T> rotation() const;
+    FixedSizeMatrix<T, 4, 4> toMatrix() const;
+
+    Vec3<T> transform(const Vec3<T> &p) const;
+    Vec3<T> operator*(const Vec3<T> &p) const;
+    Sim3<T> operator*(const Sim3<T> &other) const;
+    Sim3<T> inverse() const;
+
+    // Batched transform with the scaled rotation matrix built once. out may
+    // alias points
+    void transform(const Vec3<T> *points, Vec3<T> *out, size_t n) const;
+    std::vector<Vec3<T>> transform(const std::vector<Vec3<T>> &points) const;
+
+    FixedSizeMatrix<T, 7, 7> adjoint() const;
+
+    // a * exp(t * log(a^-1 * b))
+    static Sim3<T> interpolate(const Sim3<T> &a, const Sim3<T> &b, T t);
+
+    // Matrix W with t = W rho in exp, the integral of
+    // exp(u * (sigma I + [omega]x)) over u in [0, 1]
+    static FixedSizeMatrix<T, 3, 3> translationJacobian(const Vec3<T> &omega, T sigma);
+  };
+
+  using Sim3d = Sim3<double>;
+  using Sim3f = Sim3<float>;
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_TRANSFORMATIONS_CLASS_DEF_SIM3_H_
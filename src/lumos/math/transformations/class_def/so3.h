@@ -0,0 +1,58 @@
+#ifndef LUMOS_MATH_TRANSFORMATIONS_CLASS_DEF_SO3_H_
+#define LUMOS_MATH_TRANSFORMATIONS_CLASS_DEF_SO3_H_
+
+#include <cstddef>
+
+#include "lumos/math/lin_alg/vector_low_dim/class_def/vec3.h"
+#include "lumos/math/misc/forward_decl.h"
+#include "lumos/math/transformations/class_def/quaternion.h"
+
+namespace lumos
+{
+
+  // Rotation group SO(3), stored as a unit quaternion. The tangent space is
+  // the rotation vector omega (axis * angle), with exp/log in closed form.
+  // Jacobians follow the left perturbation convention,
+  // exp(omega + d) ~ exp(J_l(omega) d) * exp(omega).
+  template <typename T>
+  struct SO3
+  {
+    Quaternion<T> q;
+
+    SO3();
+    explicit SO3(const Quaternion<T> &q_);
+
+    static SO3<T> exp(const Vec3<T> &omega);
+    Vec3<T> log() const;
+
+    static SO3<T> fromRotationMatrix(const FixedSizeMatrix<T, 3, 3> &m);
+    FixedSizeMatrix<T, 3, 3> toRotationMatrix() const;
+
+    SO3<T> operator*(const SO3<T> &other) const;
+    Vec3<T> operator*(const Vec3<T> &p) const;
+    SO3<T> inverse() const;
+
+    // Rotates n points with one rotation matrix built for the whole batch
+    void rotate(const Vec3<T> *points, Vec3<T> *out, size_t n) const;
+
+    // Adjoint, for SO(3) the rotation matrix itself
+    FixedSizeMatrix<T, 3, 3> adjoint() const;
+
+    // Shortest path spherical interpolation, t in [0, 1]
+    static SO3<T> slerp(const SO3<T> &a, const SO3<T> &b, T t);
+
+    static FixedSizeMatrix<T, 3, 3> hat(const Vec3<T> &omega);
+    static Vec3<T> vee(const FixedSizeMatrix<T, 3, 3> &m);
+
+    static FixedSizeMatrix<T, 3, 3> leftJacobian(const Vec3<T> &omega);
+    static FixedSizeMatrix<T, 3, 3> leftJacobianInverse(const Vec3<T> &omega);
+    static FixedSizeMatrix<T, 3, 3> rightJacobian(const Vec3<T> &omega);
+    static FixedSizeMatrix<T, 3, 3> rightJacobianInverse(const Vec3<T> &omega);
+  };
+
+  using SO3d = SO3<double>;
+  using SO3f = SO3<float>;
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_TRANSFORMATIONS_CLASS_DEF_SO3_H_
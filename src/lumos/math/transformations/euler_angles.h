@@ -1,3 +1,6 @@
+#ifndef LUMOS_MATH_TRANSFORMATIONS_EULER_ANGLES_H_
+#define LUMOS_MATH_TRANSFORMATIONS_EULER_ANGLES_H_
+
 #include <cmath>
 
 #include "lumos/math/lin_alg/matrix_fixed/matrix_fixed.h"
@@ -112,3 +115,5 @@ namespace lumos
   }
 
 } // namespace lumos
+
+#endif // LUMOS_MATH_TRANSFORMATIONS_EULER_ANGLES_H_
@@ -1,3 +1,6 @@
+#ifndef LUMOS_MATH_TRANSFORMATIONS_QUATERNION_H_
+#define LUMOS_MATH_TRANSFORMATIONS_QUATERNION_H_
+
 #include "lumos/math/transformations/class_def/quaternion.h"
 
 #include <cmath>
@@ -199,3 +202,5 @@ namespace lumos
   template class Quaternion<double>;
 
 } // namespace lumos
+
+#endif // LUMOS_MATH_TRANSFORMATIONS_QUATERNION_H_
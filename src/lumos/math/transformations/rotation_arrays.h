@@ -0,0 +1,183 @@
+#ifndef LUMOS_MATH_TRANSFORMATIONS_ROTATION_ARRAYS_H_
+#define LUMOS_MATH_TRANSFORMATIONS_ROTATION_ARRAYS_H_
+
+#include <vector>
+
+#include "lumos/math/transformations/class_def/rotation_arrays.h"
+#include "lumos/math/transformations/euler_angles.h"
+#include "lumos/math/transformations/quaternion.h"
+
+namespace lumos
+{
+  template <typename T>
+  QuaternionArray<T>::QuaternionArray() {}
+
+  template <typename T>
+  QuaternionArray<T>::QuaternionArray(const size_t num_quaternions)
+      : w(num_quaternions), x(num_quaternions), y(num_quaternions), z(num_quaternions)
+  {
+  }
+
+  template <typename T>
+  QuaternionArray<T>::QuaternionArray(const std::vector<Quaternion<T>> &quaternions)
+  {
+    resize(quaternions.size());
+    for (size_t k = 0; k < quaternions.size(); k++)
+    {
+      setQuaternion(k, quaternions[k]);
+    }
+  }
+
+  template <typename T>
+  size_t QuaternionArray<T>::size() const
+  {
+    return w.size();
+  }
+
+  template <typename T>
+  void QuaternionArray<T>::resize(const size_t num_quaternions)
+  {
+    w.resize(num_quaternions);
+    x.resize(num_quaternions);
+    y.resize(num_quaternions);
+    z.resize(num_quaternions);
+  }
+
+  template <typename T>
+  void QuaternionArray<T>::reserve(const size_t num_quaternions)
+  {
+    w.reserve(num_quaternions);
+    x.reserve(num_quaternions);
+    y.reserve(num_quaternions);
+    z.reserve(num_quaternions);
+  }
+
+  template <typename T>
+  void QuaternionArray<T>::clear()
+  {
+    w.clear();
+    x.clear();
+    y.clear();
+    z.clear();
+  }
+
+  template <typename T>
+  void QuaternionArray<T>::append(const Quaternion<T> &q)
+  {
+    w.push_back(q.w);
+    x.push_back(q.x);
+    y.push_back(q.y);
+    z.push_back(q.z);
+  }
+
+  template <typename T>
+  Quaternion<T> QuaternionArray<T>::quaternion(const size_t idx) const
+  {
+    return Quaternion<T>(w[idx], x[idx], y[idx], z[idx]);
+  }
+
+  template <typename T>
+  void QuaternionArray<T>::setQuaternion(const size_t idx, const Quaternion<T> &q)
+  {
+    w[idx] = q.w;
+    x[idx] = q.x;
+    y[idx] = q.y;
+    z[idx] = q.z;
+  }
+
+  template <typename T>
+  std::vector<Quaternion<T>> QuaternionArray<T>::toQuaternions() const
+  {
+    std::vector<Quaternion<T>> quaternions(size());
+    for (size_t k = 0; k < quaternions.size(); k++)
+    {
+      quaternions[k] = quaternion(k);
+    }
+    return quaternions;
+  }
+
+  template <typename T>
+  EulerAnglesArray<T>::EulerAnglesArray() {}
+
+  template <typename T>
+  EulerAnglesArray<T>::EulerAnglesArray(const size_t num_angles)
+      : roll(num_angles), pitch(num_angles), yaw(num_angles)
+  {
+  }
+
+  template <typename T>
+  EulerAnglesArray<T>::EulerAnglesArray(const std::vector<EulerAngles<T>> &angles)
+  {
+    resize(angles.size());
+    for (size_t k = 0; k < angles.size(); k++)
+    {
+      setAngles(k, angles[k]);
+    }
+  }
+
+  template <typename T>
+  size_t EulerAnglesArray<T>::size() const
+  {
+    return roll.size();
+  }
+
+  template <typename T>
+  void EulerAnglesArray<T>::resize(const size_t num_angles)
+  {
+    roll.resize(num_angles);
+    pitch.resize(num_angles);
+    yaw.resize(num_angles);
+  }
+
+  template <typename T>
+  void EulerAnglesArray<T>::reserve(const size_t num_angles)
+  {
+    roll.reserve(num_angles);
+    pitch.reserve(num_angles);
+    yaw.reserve(num_angles);
+  }
+
+  template <typename T>
+  void EulerAnglesArray<T>::clear()
+  {
+    roll.clear();
+    pitch.clear();
+    yaw.clear();
+  }
+
+  template <typename T>
+  void EulerAnglesArray<T>::append(const EulerAngles<T> &e)
+  {
+    roll.push_back(e.roll);
+    pitch.push_back(e.pitch);
+    yaw.push_back(e.yaw);
+  }
+
+  template <typename T>
+  EulerAngles<T> EulerAnglesArray<T>::angles(const size_t idx) const
+  {
+    return EulerAngles<T>(roll[idx], pitch[idx], yaw[idx]);
+  }
+
+  template <typename T>
+  void EulerAnglesArray<T>::setAngles(const size_t idx, const EulerAngles<T> &e)
+  {
+    roll[idx] = e.roll;
+    pitch[idx] = e.pitch;
+    yaw[idx] = e.yaw;
+  }
+
+  template <typename T>
+  std::vector<EulerAngles<T>> EulerAnglesArray<T>::toEulerAngles() const
+  {
+    std::vector<EulerAngles<T>> angles(size());
+    for (size_t k = 0; k < angles.size(); k++)
+    {
+      angles[k] = this->angles(k);
+    }
+    return angles;
+  }
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_TRANSFORMATIONS_ROTATION_ARRAYS_H_
@@ -0,0 +1,238 @@
+#ifndef LUMOS_MATH_TRANSFORMATIONS_SE3_H_
+#define LUMOS_MATH_TRANSFORMATIONS_SE3_H_
+
+#include <cmath>
+
+#include "lumos/math/transformations/class_def/se3.h"
+#include "lumos/math/transformations/so3.h"
+
+namespace lumos
+{
+  namespace internal
+  {
+    template <typename T>
+    Vec3<T> tangentBlock(const FixedSizeMatrix<T, 6, 1> &xi, const size_t offset)
+    {
+      return Vec3<T>(xi(offset, 0), xi(offset + 1, 0), xi(offset + 2, 0));
+    }
+
+    // Upper right block Q(rho, phi) of the SE(3) left Jacobian (Barfoot, State
+    // Estimation for Robotics, eq. 7.86), with c2 = (theta^2 / 2 + cos - 1) / theta^4
+    // and c3 = (theta - sin - theta^3 / 6) / theta^5
+    template <typename T>
+    FixedSizeMatrix<T, 3, 3> se3JacobianQ(const Vec3<T> &rho, const Vec3<T> &phi)
+    {
+      const T theta = phi.norm();
+      const T theta_sq = theta * theta;
+
+      T c1;
+      T c2;
+      T c3;
+      if (theta < lieSeriesAngle<T>())
+      {
+        c1 = cubicSeries(theta_sq, T(1) / T(6), T(-1) / T(120), T(1) / T(5040), T(-1) / T(362880));
+        c2 = cubicSeries(theta_sq, T(1) / T(24), T(-1) / T(720), T(1) / T(40320), T(-1) / T(3628800));
+        c3 = cubicSeries(theta_sq, T(-1) / T(120), T(1) / T(5040), T(-1) / T(362880),
+                         T(1) / T(39916800));
+      }
+      else
+      {
+        const T s = std::sin(theta);
+        const T c = std::cos(theta);
+        const T theta_4 = theta_sq * theta_sq;
+        c1 = (theta - s) / (theta_sq * theta);
+        c2 = (theta_sq / T(2) + c - T(1)) / theta_4;
+        c3 = (theta - s - theta_sq * theta / T(6)) / (theta_4 * theta);
+      }
+
+      const FixedSizeMatrix<T, 3, 3> rx = SO3<T>::hat(rho);
+      const FixedSizeMatrix<T, 3, 3> px = SO3<T>::hat(phi);
+      const FixedSizeMatrix<T, 3, 3> px_rx = px * rx;
+      const FixedSizeMatrix<T, 3, 3> rx_px = rx * px;
+      const FixedSizeMatrix<T, 3, 3> px_rx_px = px_rx * px;
+
+      return rx * T(0.5) + (px_rx + rx_px + px_rx_px) * c1 +
+             (px * px_rx + rx_px * px - px_rx_px * T(3)) * c2 +
+             (px_rx_px * px + px * px_rx_px) * (T(0.5) * (c2 + T(3) * c3));
+    }
+  } // namespace internal
+
+  template <typename T>
+  SE3<T>::SE3() : q(), t(T(0), T(0), T(0)) {}
+
+  template <typename T>
+  SE3<T>::SE3(const Quaternion<T> &q_, const Vec3<T> &t_) : q(q_), t(t_)
+  {
+    q.normalize();
+  }
+
+  template <typename T>
+  SE3<T>::SE3(const SO3<T> &r, const Vec3<T> &t_) : q(r.q), t(t_) {}
+
+  template <typename T>
+  SE3<T> SE3<T>::exp(const Tangent &xi)
+  {
+    const Vec3<T> rho = internal::tangentBlock(xi, 0);
+    const Vec3<T> omega = internal::tangentBlock(xi, 3);
+    return SE3<T>(SO3<T>::exp(omega), SO3<T>::leftJacobian(omega) * rho);
+  }
+
+  template <typename T>
+  typename SE3<T>::Tangent SE3<T>::log() const
+  {
+    const Vec3<T> omega = rotation().log();
+    const Vec3<T> rho = SO3<T>::leftJacobianInverse(omega) * t;
+
+    Tangent xi;
+    xi(0, 0) = rho.x;
+    xi(1, 0) = rho.y;
+    xi(2, 0) = rho.z;
+    xi(3, 0) = omega.x;
+    xi(4, 0) = omega.y;
+    xi(5, 0) = omega.z;
+    return xi;
+  }
+
+  template <typename T>
+  SO3<T> SE3<T>::rotation() const
+  {
+    SO3<T> r;
+    r.q = q;
+    return r;
+  }
+
+  template <typename T>
+  FixedSizeMatrix<T, 4, 4> SE3<T>::toMatrix() const
+  {
+    FixedSizeMatrix<T, 4, 4> m = unitMatrix<T, 4, 4>();
+    internal::setBlock(m, 0, 0, q.toRotationMatrix());
+    m(0, 3) = t.x;
+    m(1, 3) = t.y;
+    m(2, 3) = t.z;
+    return m;
+  }
+
+  template <typename T>
+  Vec3<T> SE3<T>::transform(const Vec3<T> &p) const
+  {
+    return rotation() * p + t;
+  }
+
+  template <typename T>
+  Vec3<T> SE3<T>::operator*(const Vec3<T> &p) const
+  {
+    return transform(p);
+  }
+
+  template <typename T>
+  SE3<T> SE3<T>::operator*(const SE3<T> &other) const
+  {
+    const SO3<T> r = rotation();
+    return SE3<T>(r * other.rotation(), r * other.t + t);
+  }
+
+  template <typename T>
+  SE3<T> SE3<T>::inverse() const
+  {
+    const SO3<T> r_inv = rotation().inverse();
+    return SE3<T>(r_inv, -(r_inv * t));
+  }
+
+  template <typename T>
+  void SE3<T>::transform(const Vec3<T> *points, Vec3<T> *out, size_t n) const
+  {
+    const FixedSizeMatrix<T, 3, 3> m = q.toRotationMatrix();
+    for (size_t i = 0; i < n; ++i)
+    {
+      out[i] = m * points[i] + t;
+    }
+  }
+
+  template <typename T>
+  std::vector<Vec3<T>> SE3<T>::transform(const std::vector<Vec3<T>> &points) const
+  {
+    std::vector<Vec3<T>> out(points.size());
+    transform(points.data(), out.data(), points.size());
+    return out;
+  }
+
+  template <typename T>
+  void SE3<T>::compose(const SE3<T> *a, const SE3<T> *b, SE3<T> *out, size_t n)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      out[i] = a[i] * b[i];
+    }
+  }
+
+  template <typename T>
+  void SE3<T>::transform(const SE3<T> *poses, const Vec3<T> *points, Vec3<T> *out, size_t n)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      out[i] = poses[i].transform(points[i]);
+    }
+  }
+
+  template <typename T>
+  FixedSizeMatrix<T, 6, 6> SE3<T>::adjoint() const
+  {
+    const FixedSizeMatrix<T, 3, 3> r = q.toRotationMatrix();
+
+    FixedSizeMatrix<T, 6, 6> ad = zerosMatrix<T, 6, 6>();
+    internal::setBlock(ad, 0, 0, r);
+    internal::setBlock(ad, 0, 3, SO3<T>::hat(t) * r);
+    internal::setBlock(ad, 3, 3, r);
+    return ad;
+  }
+
+  template <typename T>
+  SE3<T> SE3<T>::sclerp(const SE3<T> &a, const SE3<T> &b, T t)
+  {
+    return a * exp((a.inverse() * b).log() * t);
+  }
+
+  template <typename T>
+  FixedSizeMatrix<T, 6, 6> SE3<T>::leftJacobian(const Tangent &xi)
+  {
+    const Vec3<T> rho = internal::tangentBlock(xi, 0);
+    const Vec3<T> omega = internal::tangentBlock(xi, 3);
+    const FixedSizeMatrix<T, 3, 3> j = SO3<T>::leftJacobian(omega);
+
+    FixedSizeMatrix<T, 6, 6> jac = zerosMatrix<T, 6, 6>();
+    internal::setBlock(jac, 0, 0, j);
+    internal::setBlock(jac, 0, 3, internal::se3JacobianQ(rho, omega));
+    internal::setBlock(jac, 3, 3, j);
+    return jac;
+  }
+
+  template <typename T>
+  FixedSizeMatrix<T, 6, 6> SE3<T>::leftJacobianInverse(const Tangent &xi)
+  {
+    const Vec3<T> rho = internal::tangentBlock(xi, 0);
+    const Vec3<T> omega = internal::tangentBlock(xi, 3);
+    const FixedSizeMatrix<T, 3, 3> j_inv = SO3<T>::leftJacobianInverse(omega);
+
+    // Block triangular inverse of [J Q; 0 J]
+    FixedSizeMatrix<T, 6, 6> jac = zerosMatrix<T, 6, 6>();
+    internal::setBlock(jac, 0, 0, j_inv);
+    internal::setBlock(jac, 0, 3, -(j_inv * internal::se3JacobianQ(rho, omega) * j_inv));
+    internal::setBlock(jac, 3, 3, j_inv);
+    return jac;
+  }
+
+  template <typename T>
+  FixedSizeMatrix<T, 6, 6> SE3<T>::rightJacobian(const Tangent &xi)
+  {
+    return leftJacobian(-xi);
+  }
+
+  template <typename T>
+  FixedSizeMatrix<T, 6, 6> SE3<T>::rightJacobianInverse(const Tangent &xi)
+  {
+    return leftJacobianInverse(-xi);
+  }
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_TRANSFORMATIONS_SE3_H_
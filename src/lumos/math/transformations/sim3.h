@@ -0,0 +1,182 @@
+#ifndef LUMOS_MATH_TRANSFORMATIONS_SIM3_H_
+#define LUMOS_MATH_TRANSFORMATIONS_SIM3_H_
+
+#include <cmath>
+
+#include "lumos/math/transformations/class_def/sim3.h"
+#include "lumos/math/transformations/se3.h"
+
+namespace lumos
+{
+
+  template <typename T>
+  Sim3<T>::Sim3() : q(), t(T(0), T(0), T(0)), s(T(1)) {}
+
+  template <typename T>
+  Sim3<T>::Sim3(const Quaternion<T> &q_, const Vec3<T> &t_, T s_) : q(q_), t(t_), s(s_)
+  {
+    q.normalize();
+  }
+
+  template <typename T>
+  Sim3<T>::Sim3(const SO3<T> &r, const Vec3<T> &t_, T s_) : q(r.q), t(t_), s(s_) {}
+
+  template <typename T>
+  Sim3<T>::Sim3(const SE3<T> &pose) : q(pose.q), t(pose.t), s(T(1)) {}
+
+  template <typename T>
+  FixedSizeMatrix<T, 3, 3> Sim3<T>::translationJacobian(const Vec3<T> &omega, T sigma)
+  {
+    // W = A [omega]x + B [omega]x^2 + C I, as in Sophus' Sim3 calcW
+    const T theta = omega.norm();
+    const T theta_sq = theta * theta;
+    const T scale = std::exp(sigma);
+
+    T a;
+    T b;
+    T c;
+    if (std::abs(sigma) < internal::lieSmallAngle<T>())
+    {
+      c = T(1);
+      internal::so3JacobianCoefficients(theta, a, b);
+    }
+    else
+    {
+      const T sigma_sq = sigma * sigma;
+      c = (scale - T(1)) / sigma;
+      if (theta < internal::lieSmallAngle<T>())
+      {
+        a = ((sigma - T(1)) * scale + T(1)) / sigma_sq;
+        b = (scale * T(0.5) * sigma_sq + scale - T(1) - sigma * scale) / (sigma_sq * sigma);
+      }
+      else
+      {
+        const T scale_sin = scale * std::sin(theta);
+        const T scale_cos = scale * std::cos(theta);
+        const T denominator = theta_sq + sigma_sq;
+        a = (scale_sin * sigma + (T(1) - scale_cos) * theta) / (theta * denominator);
+        b = (c - ((scale_cos - T(1)) * sigma + scale_sin * theta) / denominator) / theta_sq;
+      }
+    }
+
+    const FixedSizeMatrix<T, 3, 3> omega_x = SO3<T>::hat(omega);
+    return unitMatrix<T, 3, 3>() * c + omega_x * a + (omega_x * omega_x) * b;
+  }
+
+  template <typename T>
+  Sim3<T> Sim3<T>::exp(const Tangent &xi)
+  {
+    const Vec3<T> rho(xi(0, 0), xi(1, 0), xi(2, 0));
+    const Vec3<T> omega(xi(3, 0), xi(4, 0), xi(5, 0));
+    const T sigma = xi(6, 0);
+    return Sim3<T>(SO3<T>::exp(omega), translationJacobian(omega, sigma) * rho, std::exp(sigma));
+  }
+
+  template <typename T>
+  typename Sim3<T>::Tangent Sim3<T>::log() const
+  {
+    const Vec3<T> omega = rotation().log();
+    const T sigma = std::log(s);
+    // W is invertible for every finite tangent vector
+    const Vec3<T> rho = translationJacobian(omega, sigma).inverse().value() * t;
+
+    Tangent xi;
+    xi(0, 0) = rho.x;
+    xi(1, 0) = rho.y;
+    xi(2, 0) = rho.z;
+    xi(3, 0) = omega.x;
+    xi(4, 0) = omega.y;
+    xi(5, 0) = omega.z;
+    xi(6, 0) = sigma;
+    return xi;
+  }
+
+  template <typename T>
+  SO3<T> Sim3<T>::rotation() const
+  {
+    SO3<T> r;
+    r.q = q;
+    return r;
+  }
+
+  template <typename T>
+  FixedSizeMatrix<T, 4, 4> Sim3<T>::toMatrix() const
+  {
+    FixedSizeMatrix<T, 4, 4> m = unitMatrix<T, 4, 4>();
+    internal::setBlock(m, 0, 0, q.toRotationMatrix() * s);
+    m(0, 3) = t.x;
+    m(1, 3) = t.y;
+    m(2, 3) = t.z;
+    return m;
+  }
+
+  template <typename T>
+  Vec3<T> Sim3<T>::transform(const Vec3<T> &p) const
+  {
+    return (rotation() * p) * s + t;
+  }
+
+  template <typename T>
+  Vec3<T> Sim3<T>::operator*(const Vec3<T> &p) const
+  {
+    return transform(p);
+  }
+
+  template <typename T>
+  Sim3<T> Sim3<T>::operator*(const Sim3<T> &other) const
+  {
+    const SO3<T> r = rotation();
+    return Sim3<T>(r * other.rotation(), (r * other.t) * s + t, s * other.s);
+  }
+
+  template <typename T>
+  Sim3<T> Sim3<T>::inverse() const
+  {
+    const SO3<T> r_inv = rotation().inverse();
+    const T s_inv = T(1) / s;
+    return Sim3<T>(r_inv, (r_inv * t) * (-s_inv), s_inv);
+  }
+
+  template <typename T>
+  void Sim3<T>::transform(const Vec3<T> *points, Vec3<T> *out, size_t n) const
+  {
+    const FixedSizeMatrix<T, 3, 3> m = q.toRotationMatrix() * s;
+    for (size_t i = 0; i < n; ++i)
+    {
+      out[i] = m * points[i] + t;
+    }
+  }
+
+  template <typename T>
+  std::vector<Vec3<T>> Sim3<T>::transform(const std::vector<Vec3<T>> &points) const
+  {
+    std::vector<Vec3<T>> out(points.size());
+    transform(points.data(), out.data(), points.size());
+    return out;
+  }
+
+  template <typename T>
+  FixedSizeMatrix<T, 7, 7> Sim3<T>::adjoint() const
+  {
+    const FixedSizeMatrix<T, 3, 3> r = q.toRotationMatrix();
+
+    FixedSizeMatrix<T, 7, 7> ad = zerosMatrix<T, 7, 7>();
+    internal::setBlock(ad, 0, 0, r * s);
+    internal::setBlock(ad, 0, 3, SO3<T>::hat(t) * r);
+    internal::setBlock(ad, 3, 3, r);
+    ad(0, 6) = -t.x;
+    ad(1, 6) = -t.y;
+    ad(2, 6) = -t.z;
+    ad(6, 6) = T(1);
+    return ad;
+  }
+
+  template <typename T>
+  Sim3<T> Sim3<T>::interpolate(const Sim3<T> &a, const Sim3<T> &b, T t)
+  {
+    return a * exp((a.inverse() * b).log() * t);
+  }
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_TRANSFORMATIONS_SIM3_H_
@@ -0,0 +1,255 @@
+#ifndef LUMOS_MATH_TRANSFORMATIONS_SO3_H_
+#define LUMOS_MATH_TRANSFORMATIONS_SO3_H_
+
+#include <cmath>
+
+#include "lumos/math/lin_alg/matrix_fixed/matrix_fixed.h"
+#include "lumos/math/lin_alg/vector_low_dim/vec3.h"
+#include "lumos/math/transformations/axis_angle.h"
+#include "lumos/math/transformations/class_def/so3.h"
+#include "lumos/math/transformations/euler_angles.h"
+#include "lumos/math/transformations/quaternion.h"
+
+namespace lumos
+{
+  namespace internal
+  {
+    // Angle below which sin(x) / x style quotients are replaced by their series
+    template <typename T>
+    constexpr T lieSmallAngle()
+    {
+      return sizeof(T) == sizeof(float) ? T(1e-3) : T(1e-5);
+    }
+
+    // Angle below which the Jacobian coefficients, whose closed forms cancel
+    // to a few digits near zero, are evaluated by their Taylor series
+    template <typename T>
+    constexpr T lieSeriesAngle()
+    {
+      return sizeof(T) == sizeof(float) ? T(1) : T(0.2);
+    }
+
+    // c0 + c1 x + c2 x^2 + c3 x^3
+    template <typename T>
+    T cubicSeries(const T x, const T c0, const T c1, const T c2, const T c3)
+    {
+      return c0 + x * (c1 + x * (c2 + x * c3));
+    }
+
+    // Coefficients of J_l(omega) = I + a [omega]x + b [omega]x^2,
+    // a = (1 - cos) / theta^2 and b = (theta - sin) / theta^3
+    template <typename T>
+    void so3JacobianCoefficients(const T theta, T &a, T &b)
+    {
+      const T theta_sq = theta * theta;
+      if (theta < lieSeriesAngle<T>())
+      {
+        a = cubicSeries(theta_sq, T(1) / T(2), T(-1) / T(24), T(1) / T(720), T(-1) / T(40320));
+        b = cubicSeries(theta_sq, T(1) / T(6), T(-1) / T(120), T(1) / T(5040), T(-1) / T(362880));
+      }
+      else
+      {
+        a = (T(1) - std::cos(theta)) / theta_sq;
+        b = (theta - std::sin(theta)) / (theta_sq * theta);
+      }
+    }
+
+    // I + a S + b S^2
+    template <typename T>
+    FixedSizeMatrix<T, 3, 3> identityPlusSkew(const FixedSizeMatrix<T, 3, 3> &skew, const T a, const T b)
+    {
+      return unitMatrix<T, 3, 3>() + skew * a + (skew * skew) * b;
+    }
+
+    template <typename T, uint16_t R, uint16_t C>
+    void setBlock(FixedSizeMatrix<T, R, C> &m, const size_t row, const size_t col,
+                  const FixedSizeMatrix<T, 3, 3> &block)
+    {
+      for (size_t r = 0; r < 3; ++r)
+      {
+        for (size_t c = 0; c < 3; ++c)
+        {
+          m(row + r, col + c) = block(r, c);
+        }
+      }
+    }
+
+    template <typename T, uint16_t R, uint16_t C>
+    FixedSizeMatrix<T, 3, 3> getBlock(const FixedSizeMatrix<T, R, C> &m, const size_t row,
+                                      const size_t col)
+    {
+      FixedSizeMatrix<T, 3, 3> block;
+      for (size_t r = 0; r < 3; ++r)
+      {
+        for (size_t c = 0; c < 3; ++c)
+        {
+          block(r, c) = m(row + r, col + c);
+        }
+      }
+      return block;
+    }
+  } // namespace internal
+
+  template <typename T>
+  SO3<T>::SO3() : q() {}
+
+  template <typename T>
+  SO3<T>::SO3(const Quaternion<T> &q_) : q(q_)
+  {
+    q.normalize();
+  }
+
+  template <typename T>
+  SO3<T> SO3<T>::exp(const Vec3<T> &omega)
+  {
+    const T theta_sq = omega.squaredNorm();
+    const T theta = std::sqrt(theta_sq);
+
+    // sin(theta / 2) / theta from its series near zero
+    const T half_sinc = theta < internal::lieSmallAngle<T>() ? T(0.5) - theta_sq / T(48)
+                                                             : std::sin(theta / T(2)) / theta;
+    SO3<T> r;
+    r.q = Quaternion<T>(std::cos(theta / T(2)), half_sinc * omega.x, half_sinc * omega.y,
+                        half_sinc * omega.z);
+    return r;
+  }
+
+  template <typename T>
+  Vec3<T> SO3<T>::log() const
+  {
+    // q and -q are the same rotation, w >= 0 gives the angle in [0, pi]
+    const T sign = q.w < T(0) ? T(-1) : T(1);
+    const T w = sign * q.w;
+    const Vec3<T> v(sign * q.x, sign * q.y, sign * q.z);
+    const T n = v.norm();
+
+    T scale;
+    if (n < internal::lieSmallAngle<T>())
+    {
+      // 2 atan(n / w) / n to second order
+      scale = T(2) / w - T(2) * n * n / (T(3) * w * w * w);
+    }
+    else
+    {
+      scale = T(2) * std::atan2(n, w) / n;
+    }
+    return v * scale;
+  }
+
+  template <typename T>
+  SO3<T> SO3<T>::fromRotationMatrix(const FixedSizeMatrix<T, 3, 3> &m)
+  {
+    return SO3<T>(lumos::fromRotationMatrix(m));
+  }
+
+  template <typename T>
+  FixedSizeMatrix<T, 3, 3> SO3<T>::toRotationMatrix() const
+  {
+    return q.toRotationMatrix();
+  }
+
+  template <typename T>
+  SO3<T> SO3<T>::operator*(const SO3<T> &other) const
+  {
+    SO3<T> r;
+    r.q = q * other.q;
+    // Renormalize so that long chains of products do not drift
+    r.q.normalize();
+    return r;
+  }
+
+  template <typename T>
+  Vec3<T> SO3<T>::operator*(const Vec3<T> &p) const
+  {
+    // p + w * t + v x t with t = 2 v x p, cheaper than building the matrix
+    const Vec3<T> v(q.x, q.y, q.z);
+    const Vec3<T> t = v.crossProduct(p) * T(2);
+    return p + t * q.w + v.crossProduct(t);
+  }
+
+  template <typename T>
+  SO3<T> SO3<T>::inverse() const
+  {
+    SO3<T> r;
+    r.q = q.conjugate();
+    return r;
+  }
+
+  template <typename T>
+  void SO3<T>::rotate(const Vec3<T> *points, Vec3<T> *out, size_t n) const
+  {
+    const FixedSizeMatrix<T, 3, 3> m = toRotationMatrix();
+    for (size_t i = 0; i < n; ++i)
+    {
+      out[i] = m * points[i];
+    }
+  }
+
+  template <typename T>
+  FixedSizeMatrix<T, 3, 3> SO3<T>::adjoint() const
+  {
+    return toRotationMatrix();
+  }
+
+  template <typename T>
+  SO3<T> SO3<T>::slerp(const SO3<T> &a, const SO3<T> &b, T t)
+  {
+    return a * exp(((a.inverse() * b).log()) * t);
+  }
+
+  template <typename T>
+  FixedSizeMatrix<T, 3, 3> SO3<T>::hat(const Vec3<T> &omega)
+  {
+    return omega.toCrossProductMatrix();
+  }
+
+  template <typename T>
+  Vec3<T> SO3<T>::vee(const FixedSizeMatrix<T, 3, 3> &m)
+  {
+    return Vec3<T>(m(2, 1), m(0, 2), m(1, 0));
+  }
+
+  template <typename T>
+  FixedSizeMatrix<T, 3, 3> SO3<T>::leftJacobian(const Vec3<T> &omega)
+  {
+    T a;
+    T b;
+    internal::so3JacobianCoefficients(omega.norm(), a, b);
+    return internal::identityPlusSkew(hat(omega), a, b);
+  }
+
+  template <typename T>
+  FixedSizeMatrix<T, 3, 3> SO3<T>::leftJacobianInverse(const Vec3<T> &omega)
+  {
+    const T theta = omega.norm();
+    const T theta_sq = theta * theta;
+
+    // J_l^-1 = I - [omega]x / 2 + (1 / theta^2 - (1 + cos) / (2 theta sin)) [omega]x^2
+    T b;
+    if (theta < internal::lieSeriesAngle<T>())
+    {
+      b = internal::cubicSeries(theta_sq, T(1) / T(12), T(1) / T(720), T(1) / T(30240),
+                                T(1) / T(1209600));
+    }
+    else
+    {
+      b = T(1) / theta_sq - (T(1) + std::cos(theta)) / (T(2) * theta * std::sin(theta));
+    }
+    return internal::identityPlusSkew(hat(omega), T(-0.5), b);
+  }
+
+  template <typename T>
+  FixedSizeMatrix<T, 3, 3> SO3<T>::rightJacobian(const Vec3<T> &omega)
+  {
+    return leftJacobian(-omega);
+  }
+
+  template <typename T>
+  FixedSizeMatrix<T, 3, 3> SO3<T>::rightJacobianInverse(const Vec3<T> &omega)
+  {
+    return leftJacobianInverse(-omega);
+  }
+
+} // namespace lumos
+
+#endif // LUMOS_MATH_TRANSFORMATIONS_SO3_H_
@@ -0,0 +1,208 @@
+#include <atomic>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <new>
+
+#include "lumos/math/math.h"
+
+// Every heap allocation in this executable goes through these, so a test can
+// count the allocations made by the code between two reads of the counter
+
+namespace
+{
+  std::atomic<size_t> num_allocations{0};
+
+  void *countedAllocation(const size_t size)
+  {
+    ++num_allocations;
+    if (void *const ptr = std::malloc(size == 0 ? 1 : size))
+    {
+      return ptr;
+    }
+    throw std::bad_alloc();
+  }
+} // namespace
+
+void *operator new(size_t size)
+{
+  return countedAllocation(size);
+}
+
+void *operator new[](size_t size)
+{
+  return countedAllocation(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept
+{
+  std::free(ptr);
+}
+
+namespace lumos
+{
+
+  namespace
+  {
+    // Number of heap allocations made by f
+    template <typename F>
+    size_t countAllocations(F &&f)
+    {
+      const size_t before = num_allocations.load();
+      f();
+      return num_allocations.load() - before;
+    }
+
+    // Keeps the compiler from dropping the computations under test
+    template <typename T>
+    void consume(const T &value)
+    {
+      volatile T sink = value;
+      (void)sink;
+    }
+  } // namespace
+
+  TEST(AllocationTest, CounterSeesHeapAllocations)
+  {
+    EXPECT_EQ(countAllocations([] { consume(Vec3<double>(1.0, 2.0, 3.0).toCrossProductMatrix()); }),
+              0U);
+    EXPECT_GE(countAllocations([] { consume(Matrix<double>(3, 3)(0, 0)); }), 1U);
+  }
+
+  TEST(AllocationTest, LowDimensionalVectorsStayOnTheStack)
+  {
+    const Vec3<double> a(0.3, -1.2, 2.0);
+    const Vec3<double> b(1.5, 0.4, -0.7);
+
+    const size_t count = countAllocations(
+        [&]
+        {
+          const FixedSizeMatrix<double, 3, 3> skew = a.toCrossProductMatrix();
+          consume(skew * b);
+          consume(b * skew);
+          consume(a.crossProduct(b));
+          consume(a.toFixedSizeVector());
+          consume(a.toColumnMatrix());
+          consume(diagFixedSizeMatrix(a));
+          consume(unitMatrix<double, 2, 2>() * Vec2<double>(1.0, 2.0));
+          consume(unitMatrix<double, 4, 4>() * Vec4<double>(1.0, 2.0, 3.0, 4.0));
+        });
+    EXPECT_EQ(count, 0U);
+
+    // Arithmetic on Vec3 can be evaluated at compile time
+    constexpr Vec3<double> c = Vec3<double>(1.0, 0.0, 0.0).crossProduct(Vec3<double>(0.0, 1.0, 0.0));
+    static_assert(c == Vec3<double>(0.0, 0.0, 1.0), "e_x x e_y must be e_z");
+    static_assert((c * 2.0 - c).squaredNorm() == 1.0, "constexpr Vec3 arithmetic");
+  }
+
+  TEST(AllocationTest, RotationConversionsStayOnTheStack)
+  {
+    const AxisAngle<double> axis_angle(0.7, 0.2, -0.4, 0.9);
+    const EulerAngles<double> euler(0.1, -0.3, 0.8);
+    const Quaternion<double> q = axis_angle.toQuaternion();
+
+    const size_t count = countAllocations(
+        [&]
+        {
+          consume(axis_angle.toRotationMatrix());
+          consume(axis_angle.toQuaternion());
+          consume(AxisAngle<double>::fromQuaternion(q));
+          consume(AxisAngle<double>::fromRotationMatrix(q.toRotationMatrix()));
+          consume(euler.toRotationMatrix());
+          consume(euler.toRotationMatrix(RotationOrder::XYZ));
+          consume(fromRotationMatrix(euler.toRotationMatrix()));
+          consume(q * q.conjugate());
+        });
+    EXPECT_EQ(count, 0U);
+
+    // The stack versions agree with each other
+    const FixedSizeMatrix<double, 3, 3> from_axis_angle = axis_angle.toRotationMatrix();
+    const FixedSizeMatrix<double, 3, 3> from_quaternion = q.toRotationMatrix();
+    for (size_t r = 0; r < 3; ++r)
+    {
+      for (size_t c = 0; c < 3; ++c)
+      {
+        EXPECT_NEAR(from_axis_angle(r, c), from_quaternion(r, c), 1e-14);
+      }
+    }
+  }
+
+  TEST(AllocationTest, PoseHotPathsStayOnTheStack)
+  {
+    SE3d::Tangent xi;
+    Sim3d::Tangent xi_sim;
+    const double values[7] = {0.5, -1.0, 2.0, 0.3, -0.2, 0.5, 0.1};
+    for (size_t i = 0; i < 7; ++i)
+    {
+      if (i < 6)
+      {
+        xi(i, 0) = values[i];
+      }
+      xi_sim(i, 0) = values[i];
+    }
+
+    const SE3d a = SE3d::exp(xi);
+    const SE3d b = a * a;
+    const Sim3d s = Sim3d::exp(xi_sim);
+    const Vec3<double> omega(0.3, -0.2, 0.5);
+    Vec3<double> points[8];
+    Vec3<double> out[8];
+    SE3d poses[8];
+    SE3d composed[8];
+    for (size_t i = 0; i < 8; ++i)
+    {
+      points[i] = Vec3<double>(static_cast<double>(i), 1.0, -2.0);
+      poses[i] = a;
+    }
+
+    const size_t count = countAllocations(
+        [&]
+        {
+          const SO3d r = SO3d::exp(omega);
+          consume((r * r.inverse()).log());
+          consume(r * points[0]);
+          r.rotate(points, out, 8);
+          consume(SO3d::leftJacobian(omega));
+          consume(SO3d::rightJacobianInverse(omega));
+          consume(SO3d::slerp(r, SO3d(), 0.3).q);
+
+          consume((a * b.inverse()).log());
+          consume(a * points[1]);
+          consume(a.toMatrix());
+          consume(a.adjoint());
+          consume(SE3d::leftJacobian(xi));
+          consume(SE3d::rightJacobianInverse(xi));
+          consume(SE3d::sclerp(a, b, 0.5).t);
+          a.transform(points, out, 8);
+          SE3d::transform(poses, points, out, 8);
+          SE3d::compose(poses, poses, composed, 8);
+
+          consume((s * s.inverse()).log());
+          consume(s * points[2]);
+          consume(s.adjoint());
+          s.transform(points, out, 8);
+        });
+    EXPECT_EQ(count, 0U);
+  }
+
+} // namespace lumos
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,277 @@
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include "lumos/math/math.h"
+
+namespace lumos
+{
+
+  namespace
+  {
+    QuaternionArray<double> randomQuaternions(const size_t n, const unsigned seed)
+    {
+      std::mt19937 gen(seed);
+      std::normal_distribution<double> dist(0.0, 1.0);
+      QuaternionArray<double> q(n);
+      for (size_t i = 0; i < n; ++i)
+      {
+        Quaternion<double> qi(dist(gen), dist(gen), dist(gen), dist(gen));
+        qi.normalize();
+        q.setQuaternion(i, qi);
+      }
+      return q;
+    }
+
+    PointArray3D<double> randomVectors(const size_t n, const unsigned seed)
+    {
+      std::mt19937 gen(seed);
+      std::uniform_real_distribution<double> dist(-2.0, 2.0);
+      PointArray3D<double> v(n);
+      for (size_t i = 0; i < n; ++i)
+      {
+        v.setPoint(i, Vec3<double>(dist(gen), dist(gen), dist(gen)));
+      }
+      return v;
+    }
+
+    EulerAnglesArray<double> randomEulerAngles(const size_t n, const unsigned seed)
+    {
+      std::mt19937 gen(seed);
+      std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+      std::uniform_real_distribution<double> pitch(-M_PI / 2.0 + 1e-3, M_PI / 2.0 - 1e-3);
+      EulerAnglesArray<double> e(n);
+      for (size_t i = 0; i < n; ++i)
+      {
+        e.setAngles(i, EulerAngles<double>(angle(gen), pitch(gen), angle(gen)));
+      }
+      return e;
+    }
+
+    // q and -q are the same rotation, so quaternions are compared through
+    // their rotation matrices
+    void expectSameRotation(const Quaternion<double> &a, const Quaternion<double> &b,
+                            const double tol)
+    {
+      const FixedSizeMatrix<double, 3, 3> ma = a.toRotationMatrix();
+      const FixedSizeMatrix<double, 3, 3> mb = b.toRotationMatrix();
+      for (size_t r = 0; r < 3; ++r)
+      {
+        for (size_t c = 0; c < 3; ++c)
+        {
+          EXPECT_NEAR(ma(r, c), mb(r, c), tol);
+        }
+      }
+    }
+  } // namespace
+
+  TEST(BatchRotationsTest, SinCosMatchesStandardLibrary)
+  {
+    for (double x = -1000.0; x < 1000.0; x += 0.0371)
+    {
+      double s, c;
+      internal::sinCos(x, s, c);
+      EXPECT_NEAR(s, std::sin(x), 1e-15);
+      EXPECT_NEAR(c, std::cos(x), 1e-15);
+
+      float sf, cf;
+      internal::sinCos(static_cast<float>(x), sf, cf);
+      EXPECT_NEAR(sf, std::sin(static_cast<float>(x)), 1e-6f);
+      EXPECT_NEAR(cf, std::cos(static_cast<float>(x)), 1e-6f);
+    }
+  }
+
+  TEST(BatchRotationsTest, MultiplyNormalizeAndRotateMatchScalar)
+  {
+    const size_t n = 257;
+    const QuaternionArray<double> a = randomQuaternions(n, 1);
+    const QuaternionArray<double> b = randomQuaternions(n, 2);
+    const PointArray3D<double> v = randomVectors(n, 3);
+
+    QuaternionArray<double> ab;
+    multiplyQuaternions(a, b, ab);
+    PointArray3D<double> rotated;
+    rotateVectors(a, v, rotated);
+    PointArray3D<double> rotated_by_one;
+    rotateVectors(a.quaternion(0), v, rotated_by_one);
+
+    ASSERT_EQ(ab.size(), n);
+    ASSERT_EQ(rotated.size(), n);
+    for (size_t i = 0; i < n; ++i)
+    {
+      const Quaternion<double> expected = a.quaternion(i) * b.quaternion(i);
+      EXPECT_NEAR(ab.w[i], expected.w, 1e-15);
+      EXPECT_NEAR(ab.x[i], expected.x, 1e-15);
+      EXPECT_NEAR(ab.y[i], expected.y, 1e-15);
+      EXPECT_NEAR(ab.z[i], expected.z, 1e-15);
+
+      const Vec3<double> expected_v = a.quaternion(i).toRotationMatrix() * v.point(i);
+      EXPECT_NEAR(rotated.x[i], expected_v.x, 1e-14);
+      EXPECT_NEAR(rotated.y[i], expected_v.y, 1e-14);
+      EXPECT_NEAR(rotated.z[i], expected_v.z, 1e-14);
+
+      const Vec3<double> expected_one = a.quaternion(0).toRotationMatrix() * v.point(i);
+      EXPECT_NEAR(rotated_by_one.x[i], expected_one.x, 1e-14);
+      EXPECT_NEAR(rotated_by_one.y[i], expected_one.y, 1e-14);
+      EXPECT_NEAR(rotated_by_one.z[i], expected_one.z, 1e-14);
+    }
+
+    // Normalization, zero quaternions stay zero
+    QuaternionArray<double> scaled = a;
+    for (size_t i = 0; i < n; ++i)
+    {
+      scaled.w[i] *= 3.0;
+      scaled.x[i] *= 3.0;
+      scaled.y[i] *= 3.0;
+      scaled.z[i] *= 3.0;
+    }
+    scaled.append(Quaternion<double>(0.0, 0.0, 0.0, 0.0));
+    normalizeQuaternions(scaled);
+    for (size_t i = 0; i < n; ++i)
+    {
+      EXPECT_NEAR(scaled.w[i], a.w[i], 1e-15);
+      EXPECT_NEAR(scaled.z[i], a.z[i], 1e-15);
+    }
+    EXPECT_EQ(scaled.w[n], 0.0);
+  }
+
+  TEST(BatchRotationsTest, EulerAnglesRoundTrip)
+  {
+    const size_t n = 500;
+    const EulerAnglesArray<double> e = randomEulerAngles(n, 4);
+
+    QuaternionArray<double> q;
+    eulerAnglesToQuaternions(e, q);
+    std::vector<FixedSizeMatrix<double, 3, 3>> matrices;
+    eulerAnglesToRotationMatrices(e, matrices);
+    EulerAnglesArray<double> back;
+    quaternionsToEulerAngles(q, back);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+      const FixedSizeMatrix<double, 3, 3> expected = e.angles(i).toRotationMatrix();
+      const FixedSizeMatrix<double, 3, 3> from_q = q.quaternion(i).toRotationMatrix();
+      for (size_t r = 0; r < 3; ++r)
+      {
+        for (size_t c = 0; c < 3; ++c)
+        {
+          EXPECT_NEAR(matrices[i](r, c), expected(r, c), 1e-14);
+          EXPECT_NEAR(from_q(r, c), expected(r, c), 1e-14);
+        }
+      }
+
+      EXPECT_NEAR(back.roll[i], e.roll[i], 1e-10);
+      EXPECT_NEAR(back.pitch[i], e.pitch[i], 1e-10);
+      EXPECT_NEAR(back.yaw[i], e.yaw[i], 1e-10);
+    }
+  }
+
+  TEST(BatchRotationsTest, RotationMatricesRoundTrip)
+  {
+    const size_t n = 300;
+    QuaternionArray<double> q = randomQuaternions(n, 5);
+
+    // Rotations by almost pi, where the trace based formula breaks down
+    q.setQuaternion(0, Quaternion<double>(0.0, 1.0, 0.0, 0.0));
+    q.setQuaternion(1, Quaternion<double>(1e-9, 0.0, 0.0, -1.0));
+    q.setQuaternion(2, Quaternion<double>(0.0, 0.6, 0.8, 0.0));
+    q.setQuaternion(3, Quaternion<double>(1.0, 0.0, 0.0, 0.0));
+
+    std::vector<FixedSizeMatrix<double, 3, 3>> matrices;
+    quaternionsToRotationMatrices(q, matrices);
+    QuaternionArray<double> back;
+    rotationMatricesToQuaternions(matrices, back);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+      const FixedSizeMatrix<double, 3, 3> expected = q.quaternion(i).toRotationMatrix();
+      for (size_t r = 0; r < 3; ++r)
+      {
+        for (size_t c = 0; c < 3; ++c)
+        {
+          EXPECT_NEAR(matrices[i](r, c), expected(r, c), 1e-15);
+        }
+      }
+
+      EXPECT_GE(back.w[i], 0.0);
+      EXPECT_NEAR(back.w[i] * back.w[i] + back.x[i] * back.x[i] + back.y[i] * back.y[i] +
+                      back.z[i] * back.z[i],
+                  1.0, 1e-14);
+      expectSameRotation(back.quaternion(i), q.quaternion(i), 1e-14);
+    }
+  }
+
+  TEST(BatchRotationsTest, SlerpAndExpMatchLieGroups)
+  {
+    const size_t n = 200;
+    const QuaternionArray<double> a = randomQuaternions(n, 6);
+    QuaternionArray<double> b = randomQuaternions(n, 7);
+    // Equal endpoints take the lerp path
+    b.setQuaternion(0, a.quaternion(0));
+
+    QuaternionArray<double> half;
+    slerpQuaternions(a, b, 0.3, half);
+    std::vector<double> t(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+      t[i] = static_cast<double>(i) / static_cast<double>(n - 1);
+    }
+    QuaternionArray<double> per_sample;
+    slerpQuaternions(a, b, t, per_sample);
+
+    PointArray3D<double> omega = randomVectors(n, 8);
+    omega.setPoint(0, Vec3<double>(0.0, 0.0, 0.0));
+    omega.setPoint(1, Vec3<double>(1e-7, -2e-7, 0.0));
+    QuaternionArray<double> exp_q;
+    rotationVectorsToQuaternions(omega, exp_q);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+      const SO3d sa(a.quaternion(i));
+      const SO3d sb(b.quaternion(i));
+      expectSameRotation(half.quaternion(i), SO3d::slerp(sa, sb, 0.3).q, 1e-12);
+      expectSameRotation(per_sample.quaternion(i), SO3d::slerp(sa, sb, t[i]).q, 1e-12);
+
+      const Quaternion<double> expected = SO3d::exp(omega.point(i)).q;
+      EXPECT_NEAR(exp_q.w[i], expected.w, 1e-15);
+      EXPECT_NEAR(exp_q.x[i], expected.x, 1e-15);
+      EXPECT_NEAR(exp_q.y[i], expected.y, 1e-15);
+      EXPECT_NEAR(exp_q.z[i], expected.z, 1e-15);
+    }
+  }
+
+  TEST(BatchRotationsTest, ResultDoesNotDependOnNumberOfThreads)
+  {
+    const size_t n = 2 * internal::kBatchRotationMinChunkSize + 123;
+    const QuaternionArray<double> a = randomQuaternions(n, 9);
+    const QuaternionArray<double> b = randomQuaternions(n, 10);
+    const PointArray3D<double> v = randomVectors(n, 11);
+
+    QuaternionArray<double> ab_single, ab_multi;
+    multiplyQuaternions(a, b, ab_single, 1U);
+    multiplyQuaternions(a, b, ab_multi, 4U);
+    EXPECT_EQ(ab_single.w, ab_multi.w);
+    EXPECT_EQ(ab_single.z, ab_multi.z);
+
+    PointArray3D<double> rotated_single, rotated_multi;
+    rotateVectors(a, v, rotated_single, 1U);
+    rotateVectors(a, v, rotated_multi, 4U);
+    EXPECT_EQ(rotated_single.x, rotated_multi.x);
+    EXPECT_EQ(rotated_single.y, rotated_multi.y);
+    EXPECT_EQ(rotated_single.z, rotated_multi.z);
+
+    QuaternionArray<double> slerp_single, slerp_multi;
+    slerpQuaternions(a, b, 0.75, slerp_single, 1U);
+    slerpQuaternions(a, b, 0.75, slerp_multi, 4U);
+    EXPECT_EQ(slerp_single.w, slerp_multi.w);
+    EXPECT_EQ(slerp_single.x, slerp_multi.x);
+  }
+
+} // namespace lumos
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
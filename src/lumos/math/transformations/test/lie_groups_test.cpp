@@ -0,0 +1,388 @@
+#include <cmath>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "lumos/math/math.h"
+
+namespace lumos
+{
+
+  namespace
+  {
+    void expectVec3Near(const Vec3<double> &a, const Vec3<double> &b, const double tol)
+    {
+      EXPECT_NEAR(a.x, b.x, tol);
+      EXPECT_NEAR(a.y, b.y, tol);
+      EXPECT_NEAR(a.z, b.z, tol);
+    }
+
+    template <uint16_t R, uint16_t C>
+    void expectMatrixNear(const FixedSizeMatrix<double, R, C> &a,
+                          const FixedSizeMatrix<double, R, C> &b, const double tol)
+    {
+      for (size_t r = 0; r < R; ++r)
+      {
+        for (size_t c = 0; c < C; ++c)
+        {
+          EXPECT_NEAR(a(r, c), b(r, c), tol) << "at (" << r << ", " << c << ")";
+        }
+      }
+    }
+
+    // Same rotation, q and -q are equivalent
+    void expectSameRotation(const SO3d &a, const SO3d &b, const double tol)
+    {
+      expectMatrixNear(a.toRotationMatrix(), b.toRotationMatrix(), tol);
+    }
+
+    void expectSamePose(const SE3d &a, const SE3d &b, const double tol)
+    {
+      expectMatrixNear(a.toMatrix(), b.toMatrix(), tol);
+    }
+
+    SE3d::Tangent se3Tangent(const double r0, const double r1, const double r2, const double w0,
+                             const double w1, const double w2)
+    {
+      SE3d::Tangent xi;
+      xi(0, 0) = r0;
+      xi(1, 0) = r1;
+      xi(2, 0) = r2;
+      xi(3, 0) = w0;
+      xi(4, 0) = w1;
+      xi(5, 0) = w2;
+      return xi;
+    }
+
+    // Matrix exponential by scaling and squaring of a truncated Taylor series
+    FixedSizeMatrix<double, 3, 3> matrixExp(const FixedSizeMatrix<double, 3, 3> &m)
+    {
+      const FixedSizeMatrix<double, 3, 3> scaled = m * (1.0 / 1024.0);
+      FixedSizeMatrix<double, 3, 3> term = unitMatrix<double, 3, 3>();
+      FixedSizeMatrix<double, 3, 3> result = unitMatrix<double, 3, 3>();
+      for (int k = 1; k < 12; ++k)
+      {
+        term = (term * scaled) * (1.0 / k);
+        result = result + term;
+      }
+      for (int k = 0; k < 10; ++k)
+      {
+        result = result * result;
+      }
+      return result;
+    }
+  } // namespace
+
+  TEST(SO3Test, ExpLogRoundTrip)
+  {
+    const std::vector<Vec3<double>> omegas = {
+        Vec3<double>(0.0, 0.0, 0.0),       Vec3<double>(1e-9, -2e-9, 3e-9),
+        Vec3<double>(1e-3, 2e-3, -1e-3),   Vec3<double>(0.3, -0.2, 0.5),
+        Vec3<double>(-1.0, 2.0, 0.5),      Vec3<double>(0.0, 0.0, M_PI - 1e-6),
+        Vec3<double>(1.8, -1.8, 1.0) * 0.999};
+
+    for (const Vec3<double> &omega : omegas)
+    {
+      const SO3d r = SO3d::exp(omega);
+      expectVec3Near(r.log(), omega, 1e-9);
+
+      // exp agrees with the series of the matrix exponential of [omega]x
+      expectMatrixNear(r.toRotationMatrix(), matrixExp(SO3d::hat(omega)), 1e-12);
+    }
+
+    const Vec3<double> omega(0.4, 0.1, -0.7);
+    expectVec3Near(SO3d::vee(SO3d::hat(omega)), omega, 0.0);
+  }
+
+  TEST(SO3Test, ComposeInverseAndRotate)
+  {
+    const SO3d a = SO3d::exp(Vec3<double>(0.3, -0.2, 0.5));
+    const SO3d b = SO3d::exp(Vec3<double>(-1.0, 0.4, 0.2));
+    const Vec3<double> p(1.0, -2.0, 3.0);
+
+    expectMatrixNear((a * b).toRotationMatrix(), a.toRotationMatrix() * b.toRotationMatrix(),
+                     1e-14);
+    expectVec3Near(a * p, a.toRotationMatrix() * p, 1e-14);
+    expectSameRotation(a * a.inverse(), SO3d(), 1e-14);
+
+    const std::vector<Vec3<double>> points = {p, Vec3<double>(0.0, 1.0, 0.0),
+                                              Vec3<double>(-4.0, 0.5, 2.0)};
+    std::vector<Vec3<double>> rotated(points.size());
+    a.rotate(points.data(), rotated.data(), points.size());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      expectVec3Near(rotated[i], a * points[i], 1e-14);
+    }
+  }
+
+  TEST(SO3Test, JacobiansMatchNumericalDifferentiation)
+  {
+    const double h = 1e-6;
+    const std::vector<Vec3<double>> omegas = {Vec3<double>(0.0, 0.0, 0.0),
+                                              Vec3<double>(1e-3, -2e-3, 1e-3),
+                                              Vec3<double>(0.1, 0.05, -0.08),
+                                              Vec3<double>(0.9, -1.2, 0.4)};
+
+    for (const Vec3<double> &omega : omegas)
+    {
+      const SO3d r = SO3d::exp(omega);
+      const FixedSizeMatrix<double, 3, 3> jl = SO3d::leftJacobian(omega);
+      const FixedSizeMatrix<double, 3, 3> jr = SO3d::rightJacobian(omega);
+
+      for (size_t k = 0; k < 3; ++k)
+      {
+        Vec3<double> delta(0.0, 0.0, 0.0);
+        (k == 0 ? delta.x : (k == 1 ? delta.y : delta.z)) = h;
+
+        // exp(omega + d) = exp(J_l d) exp(omega) = exp(omega) exp(J_r d)
+        const SO3d perturbed = SO3d::exp(omega + delta);
+        const Vec3<double> left = (perturbed * r.inverse()).log() / h;
+        const Vec3<double> right = (r.inverse() * perturbed).log() / h;
+
+        expectVec3Near(left, Vec3<double>(jl(0, k), jl(1, k), jl(2, k)), 1e-6);
+        expectVec3Near(right, Vec3<double>(jr(0, k), jr(1, k), jr(2, k)), 1e-6);
+      }
+
+      expectMatrixNear(SO3d::leftJacobian(omega) * SO3d::leftJacobianInverse(omega),
+                       unitMatrix<double, 3, 3>(), 1e-12);
+      expectMatrixNear(SO3d::rightJacobian(omega) * SO3d::rightJacobianInverse(omega),
+                       unitMatrix<double, 3, 3>(), 1e-12);
+    }
+  }
+
+  TEST(SO3Test, Slerp)
+  {
+    const SO3d a = SO3d::exp(Vec3<double>(0.1, 0.2, -0.3));
+    const SO3d b = SO3d::exp(Vec3<double>(-0.5, 0.3, 0.9));
+
+    expectSameRotation(SO3d::slerp(a, b, 0.0), a, 1e-12);
+    expectSameRotation(SO3d::slerp(a, b, 1.0), b, 1e-12);
+
+    // The midpoint is half the angle from each end
+    const SO3d mid = SO3d::slerp(a, b, 0.5);
+    const double angle = (a.inverse() * b).log().norm();
+    EXPECT_NEAR((a.inverse() * mid).log().norm(), angle / 2.0, 1e-12);
+    EXPECT_NEAR((mid.inverse() * b).log().norm(), angle / 2.0, 1e-12);
+
+    // Takes the short way even if the quaternions are in opposite hemispheres
+    SO3d b_flipped;
+    b_flipped.q = b.q * -1.0;
+    expectSameRotation(SO3d::slerp(a, b_flipped, 0.5), mid, 1e-12);
+  }
+
+  TEST(SE3Test, ExpLogRoundTrip)
+  {
+    const std::vector<SE3d::Tangent> tangents = {
+        se3Tangent(0.0, 0.0, 0.0, 0.0, 0.0, 0.0), se3Tangent(1.0, -2.0, 0.5, 0.0, 0.0, 0.0),
+        se3Tangent(1.0, 2.0, 3.0, 1e-4, -2e-4, 1e-4), se3Tangent(0.5, -1.0, 2.0, 0.3, -0.2, 0.5),
+        se3Tangent(-1.0, 0.3, 0.2, 0.0, M_PI - 1e-6, 0.0)};
+
+    for (const SE3d::Tangent &xi : tangents)
+    {
+      expectMatrixNear(SE3d::exp(xi).log(), xi, 1e-8);
+    }
+
+    // A pure rotation about an axis through the origin keeps the origin
+    const SE3d rotation = SE3d::exp(se3Tangent(0.0, 0.0, 0.0, 0.2, 0.3, 0.1));
+    expectVec3Near(rotation.t, Vec3<double>(0.0, 0.0, 0.0), 0.0);
+  }
+
+  TEST(SE3Test, MatchesHomogeneousMatrices)
+  {
+    const SE3d a = SE3d::exp(se3Tangent(0.5, -1.0, 2.0, 0.3, -0.2, 0.5));
+    const SE3d b = SE3d::exp(se3Tangent(-0.2, 0.7, 0.1, -1.0, 0.4, 0.2));
+    const Vec3<double> p(1.0, -2.0, 3.0);
+
+    expectMatrixNear((a * b).toMatrix(), a.toMatrix() * b.toMatrix(), 1e-14);
+    expectMatrixNear(a.inverse().toMatrix(), a.toMatrix().inverse().value(), 1e-12);
+    expectSamePose(a * a.inverse(), SE3d(), 1e-14);
+
+    const FixedSizeMatrix<double, 4, 4> m = a.toMatrix();
+    const Vec3<double> expected(m(0, 0) * p.x + m(0, 1) * p.y + m(0, 2) * p.z + m(0, 3),
+                                m(1, 0) * p.x + m(1, 1) * p.y + m(1, 2) * p.z + m(1, 3),
+                                m(2, 0) * p.x + m(2, 1) * p.y + m(2, 2) * p.z + m(2, 3));
+    expectVec3Near(a.transform(p), expected, 1e-14);
+    expectVec3Near(a.inverse() * (a * p), p, 1e-14);
+
+    // Ad(T) xi maps exp(xi) to T exp(xi) T^-1
+    const SE3d::Tangent xi = se3Tangent(0.1, 0.2, -0.3, 0.05, -0.1, 0.2);
+    expectSamePose(SE3d::exp(a.adjoint() * xi), a * SE3d::exp(xi) * a.inverse(), 1e-12);
+  }
+
+  TEST(SE3Test, BatchedOperationsMatchSingle)
+  {
+    std::vector<SE3d> poses;
+    std::vector<SE3d> others;
+    std::vector<Vec3<double>> points;
+    for (size_t i = 0; i < 17; ++i)
+    {
+      const double f = static_cast<double>(i);
+      poses.push_back(SE3d::exp(se3Tangent(f, -0.5 * f, 1.0, 0.1 * f, 0.2, -0.05 * f)));
+      others.push_back(SE3d::exp(se3Tangent(0.3, f, -f, -0.2, 0.03 * f, 0.1)));
+      points.emplace_back(f, 1.0 - f, 0.5 * f);
+    }
+
+    const std::vector<Vec3<double>> transformed = poses[3].transform(points);
+    std::vector<Vec3<double>> in_place = points;
+    poses[3].transform(in_place.data(), in_place.data(), in_place.size());
+
+    std::vector<Vec3<double>> per_pose(points.size());
+    SE3d::transform(poses.data(), points.data(), per_pose.data(), points.size());
+
+    std::vector<SE3d> composed(poses.size());
+    SE3d::compose(poses.data(), others.data(), composed.data(), poses.size());
+
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      expectVec3Near(transformed[i], poses[3] * points[i], 1e-12);
+      expectVec3Near(in_place[i], transformed[i], 0.0);
+      expectVec3Near(per_pose[i], poses[i] * points[i], 1e-12);
+      expectSamePose(composed[i], poses[i] * others[i], 0.0);
+    }
+  }
+
+  TEST(SE3Test, JacobiansMatchNumericalDifferentiation)
+  {
+    const double h = 1e-6;
+    const std::vector<SE3d::Tangent> tangents = {
+        se3Tangent(0.5, -1.0, 2.0, 0.0, 0.0, 0.0), se3Tangent(0.5, -1.0, 2.0, 1e-3, 2e-3, -1e-3),
+        se3Tangent(1.0, 0.2, -0.4, 0.1, -0.15, 0.05), se3Tangent(-0.3, 0.8, 1.5, 0.9, -1.2, 0.4)};
+
+    for (const SE3d::Tangent &xi : tangents)
+    {
+      const SE3d pose = SE3d::exp(xi);
+      const FixedSizeMatrix<double, 6, 6> jl = SE3d::leftJacobian(xi);
+      const FixedSizeMatrix<double, 6, 6> jr = SE3d::rightJacobian(xi);
+
+      for (size_t k = 0; k < 6; ++k)
+      {
+        SE3d::Tangent perturbed_xi = xi;
+        perturbed_xi(k, 0) += h;
+        const SE3d perturbed = SE3d::exp(perturbed_xi);
+
+        const SE3d::Tangent left = (perturbed * pose.inverse()).log() * (1.0 / h);
+        const SE3d::Tangent right = (pose.inverse() * perturbed).log() * (1.0 / h);
+        for (size_t r = 0; r < 6; ++r)
+        {
+          EXPECT_NEAR(left(r, 0), jl(r, k), 2e-6);
+          EXPECT_NEAR(right(r, 0), jr(r, k), 2e-6);
+        }
+      }
+
+      expectMatrixNear(jl * SE3d::leftJacobianInverse(xi), unitMatrix<double, 6, 6>(), 1e-12);
+      expectMatrixNear(jr * SE3d::rightJacobianInverse(xi), unitMatrix<double, 6, 6>(), 1e-12);
+    }
+
+    // The series and the closed form of Q agree where they meet
+    const double edge = internal::lieSeriesAngle<double>();
+    const FixedSizeMatrix<double, 6, 6> below =
+        SE3d::leftJacobian(se3Tangent(0.5, -1.0, 2.0, 0.0, 0.0, edge * (1.0 - 1e-13)));
+    const FixedSizeMatrix<double, 6, 6> above =
+        SE3d::leftJacobian(se3Tangent(0.5, -1.0, 2.0, 0.0, 0.0, edge * (1.0 + 1e-13)));
+    expectMatrixNear(below, above, 1e-12);
+  }
+
+  TEST(SE3Test, Sclerp)
+  {
+    const SE3d a = SE3d::exp(se3Tangent(0.5, -1.0, 2.0, 0.3, -0.2, 0.5));
+    const SE3d b = SE3d::exp(se3Tangent(-0.2, 0.7, 0.1, -1.0, 0.4, 0.2));
+
+    expectSamePose(SE3d::sclerp(a, b, 0.0), a, 1e-12);
+    expectSamePose(SE3d::sclerp(a, b, 1.0), b, 1e-12);
+
+    // Two half steps of the screw motion reach the end
+    const SE3d mid = SE3d::sclerp(a, b, 0.5);
+    const SE3d step = a.inverse() * mid;
+    expectSamePose(a * step * step, b, 1e-12);
+
+    // Rotation is interpolated like slerp
+    expectSameRotation(mid.rotation(), SO3d::slerp(a.rotation(), b.rotation(), 0.5), 1e-12);
+  }
+
+  TEST(Sim3Test, ExpLogAndGroupOperations)
+  {
+    const std::vector<Sim3d::Tangent> tangents = [] {
+      std::vector<Sim3d::Tangent> v;
+      const double values[][7] = {{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+                                  {1.0, -2.0, 0.5, 0.0, 0.0, 0.0, 0.3},
+                                  {1.0, 2.0, 3.0, 0.3, -0.2, 0.5, 0.0},
+                                  {0.5, -1.0, 2.0, 0.3, -0.2, 0.5, -0.4},
+                                  {-1.0, 0.3, 0.2, 1e-7, 0.0, 0.0, 0.7}};
+      for (const auto &row : values)
+      {
+        Sim3d::Tangent xi;
+        for (size_t i = 0; i < 7; ++i)
+        {
+          xi(i, 0) = row[i];
+        }
+        v.push_back(xi);
+      }
+      return v;
+    }();
+
+    for (const Sim3d::Tangent &xi : tangents)
+    {
+      expectMatrixNear(Sim3d::exp(xi).log(), xi, 1e-9);
+    }
+
+    const Sim3d a = Sim3d::exp(tangents[3]);
+    const Sim3d b = Sim3d::exp(tangents[4]);
+    const Vec3<double> p(1.0, -2.0, 3.0);
+
+    expectMatrixNear((a * b).toMatrix(), a.toMatrix() * b.toMatrix(), 1e-13);
+    expectMatrixNear(a.inverse().toMatrix(), a.toMatrix().inverse().value(), 1e-12);
+    expectVec3Near(a * p, a.rotation() * p * a.s + a.t, 1e-14);
+    expectVec3Near(a.inverse() * (a * p), p, 1e-13);
+
+    std::vector<Vec3<double>> points = {p, Vec3<double>(0.0, 1.0, 0.0)};
+    const std::vector<Vec3<double>> transformed = a.transform(points);
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      expectVec3Near(transformed[i], a * points[i], 1e-13);
+    }
+
+    expectMatrixNear(Sim3d::exp(a.adjoint() * tangents[2]).toMatrix(),
+                     (a * Sim3d::exp(tangents[2]) * a.inverse()).toMatrix(), 1e-12);
+
+    expectMatrixNear(Sim3d::interpolate(a, b, 1.0).toMatrix(), b.toMatrix(), 1e-12);
+    EXPECT_NEAR(Sim3d::interpolate(a, b, 0.5).s, std::sqrt(a.s * b.s), 1e-12);
+
+    // A similarity without scale is a rigid body transformation
+    const SE3d pose = SE3d::exp(se3Tangent(0.5, -1.0, 2.0, 0.3, -0.2, 0.5));
+    expectVec3Near(Sim3d(pose) * p, pose * p, 1e-14);
+  }
+
+  TEST(Sim3Test, TranslationJacobianMatchesIntegral)
+  {
+    const std::vector<std::pair<Vec3<double>, double>> cases = {
+        {Vec3<double>(0.3, -0.2, 0.5), 0.4},
+        {Vec3<double>(0.3, -0.2, 0.5), 0.0},
+        {Vec3<double>(0.0, 0.0, 0.0), -0.6},
+        {Vec3<double>(1e-8, 0.0, 0.0), 0.2},
+        {Vec3<double>(-1.0, 2.0, 0.5), -0.3}};
+
+    for (const auto &c : cases)
+    {
+      const FixedSizeMatrix<double, 3, 3> generator =
+          SO3d::hat(c.first) + unitMatrix<double, 3, 3>() * c.second;
+
+      // Simpson's rule over u in [0, 1]
+      const size_t n = 200;
+      FixedSizeMatrix<double, 3, 3> integral = zerosMatrix<double, 3, 3>();
+      for (size_t i = 0; i <= n; ++i)
+      {
+        const double weight = (i == 0 || i == n) ? 1.0 : (i % 2 == 1 ? 4.0 : 2.0);
+        integral = integral + matrixExp(generator * (static_cast<double>(i) / n)) * weight;
+      }
+      integral = integral * (1.0 / (3.0 * n));
+
+      expectMatrixNear(Sim3d::translationJacobian(c.first, c.second), integral, 1e-9);
+    }
+  }
+
+} // namespace lumos
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
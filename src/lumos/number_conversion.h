@@ -0,0 +1,2 @@
+#pragma once
+#include "lumos/number_conversion/number_conversion.h"
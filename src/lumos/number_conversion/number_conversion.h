@@ -0,0 +1,249 @@
+#ifndef LUMOS_NUMBER_CONVERSION_H_
+#define LUMOS_NUMBER_CONVERSION_H_
+
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+// Shared number parsing and formatting used by the csv, json, string and
+// argparse modules. Built on std::from_chars/std::to_chars, which parse and
+// print without locales or streams (libstdc++ and MSVC use the Eisel-Lemire
+// algorithm for floating point parsing). Integers of up to 19 digits take a
+// faster path that converts eight digits at a time with plain 64 bit
+// arithmetic.
+
+namespace lumos
+{
+namespace internal
+{
+
+// True if all eight bytes of chunk are in '0'..'9'. The high nibble of a digit
+// is 3, and adding 6 to the low nibble of a digit does not carry into it
+inline bool isEightDigits(const uint64_t chunk)
+{
+    return (((chunk & 0xF0F0F0F0F0F0F0F0ULL) | (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+            0x3333333333333333ULL);
+}
+
+// Loads eight characters with the first one in the lowest byte, independent of
+// the byte order of the platform. Compiles to a single load on little endian.
+inline uint64_t loadEightChars(const char *const chars)
+{
+    uint64_t chunk = 0;
+    for (size_t k = 0; k < 8; k++)
+    {
+        chunk |= static_cast<uint64_t>(static_cast<unsigned char>(chars[k])) << (8 * k);
+    }
+    return chunk;
+}
+
+// Value of eight ASCII digits loaded with loadEightChars
+inline uint32_t parseEightDigits(uint64_t chunk)
+{
+    constexpr uint64_t kMask = 0x000000FF000000FFULL;
+    constexpr uint64_t kMul1 = 100ULL + (1000000ULL << 32);
+    constexpr uint64_t kMul2 = 1ULL + (10000ULL << 32);
+
+    chunk -= 0x3030303030303030ULL;
+    chunk = (chunk * 10) + (chunk >> 8);
+    chunk = (((chunk & kMask) * kMul1) + (((chunk >> 16) & kMask) * kMul2)) >> 32;
+    return static_cast<uint32_t>(chunk);
+}
+
+// Length of the run of decimal digits at the start of str
+inline size_t countLeadingDigits(const std::string_view str)
+{
+    size_t i = 0;
+    while ((i + 8 <= str.size()) && isEightDigits(loadEightChars(str.data() + i)))
+    {
+        i += 8;
+    }
+    while ((i < str.size()) && (str[i] >= '0') && (str[i] <= '9'))
+    {
+        i++;
+    }
+    return i;
+}
+
+// Value of num_digits (at most 19) decimal digits
+inline uint64_t parseDigits(const char *chars, size_t num_digits)
+{
+    uint64_t result = 0;
+    for (; num_digits >= 8; chars += 8, num_digits -= 8)
+    {
+        result = result * 100000000ULL + parseEightDigits(loadEightChars(chars));
+    }
+    for (; num_digits > 0; chars++, num_digits--)
+    {
+        result = result * 10 + static_cast<uint64_t>(*chars - '0');
+    }
+    return result;
+}
+
+template <typename T> std::errc fromCharsInteger(const std::string_view str, T &value)
+{
+    const char *first = str.data();
+    const char *const last = str.data() + str.size();
+
+    const bool has_plus = (first != last) && (*first == '+');
+    if (has_plus)
+    {
+        first++;
+    }
+    const char *const number_start = first;
+
+    bool negative = false;
+    if (std::is_signed_v<T> && !has_plus && (first != last) && (*first == '-'))
+    {
+        negative = true;
+        first++;
+    }
+
+    const size_t num_digits = countLeadingDigits(std::string_view(first, static_cast<size_t>(last - first)));
+    if ((num_digits == 0) || (first + num_digits != last))
+    {
+        return std::errc::invalid_argument;
+    }
+
+    if (num_digits > 19)
+    {
+        // Too long for the fast path, std::from_chars does the range checks
+        const std::from_chars_result result = std::from_chars(number_start, last, value);
+        return result.ec;
+    }
+
+    const uint64_t magnitude = parseDigits(first, num_digits);
+    const uint64_t max_magnitude =
+        static_cast<uint64_t>(std::numeric_limits<T>::max()) + static_cast<uint64_t>(negative ? 1 : 0);
+    if (magnitude > max_magnitude)
+    {
+        return std::errc::result_out_of_range;
+    }
+
+    if (negative && (magnitude != 0))
+    {
+        value = static_cast<T>(-static_cast<int64_t>(magnitude - 1) - 1);
+    }
+    else
+    {
+        value = static_cast<T>(magnitude);
+    }
+    return std::errc();
+}
+
+template <typename T> std::errc fromCharsFloatingPoint(const std::string_view str, T &value)
+{
+    const char *first = str.data();
+    const char *const last = str.data() + str.size();
+
+    // std::from_chars does not accept a leading '+', the stream based parsing
+    // this replaces did
+    if ((first != last) && (*first == '+'))
+    {
+        first++;
+        if ((first != last) && (*first == '-'))
+        {
+            return std::errc::invalid_argument;
+        }
+    }
+
+    const std::from_chars_result result = std::from_chars(first, last, value);
+    if (result.ec != std::errc())
+    {
+        return result.ec;
+    }
+    return result.ptr == last ? std::errc() : std::errc::invalid_argument;
+}
+
+// Parses all of str as a number of type T. An optional leading '+' is accepted,
+// surrounding whitespace is not. Returns std::errc() on success,
+// std::errc::invalid_argument or std::errc::result_out_of_range otherwise, in
+// which case value is unspecified.
+template <typename T> std::errc fromChars(const std::string_view str, T &value)
+{
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "Only integer and floating point types supported");
+
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        return fromCharsFloatingPoint(str, value);
+    }
+    else
+    {
+        return fromCharsInteger(str, value);
+    }
+}
+
+template <typename T> bool tryParseNumber(const std::string_view str, T &value)
+{
+    return fromChars(str, value) == std::errc();
+}
+
+// Same as fromChars, but throws std::invalid_argument or std::out_of_range like
+// std::stoi and friends do
+template <typename T> T parseNumber(const std::string_view str)
+{
+    T value{};
+    const std::errc ec = fromChars(str, value);
+
+    if (ec == std::errc::result_out_of_range)
+    {
+        throw std::out_of_range("Value out of range: '" + std::string(str) + "'");
+    }
+    else if (ec != std::errc())
+    {
+        throw std::invalid_argument("Invalid number: '" + std::string(str) + "'");
+    }
+
+    return value;
+}
+
+// Appends the shortest representation that parses back to the same value
+template <typename T> void appendNumber(std::string &result, const T value)
+{
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "Only integer and floating point types supported");
+
+    // Enough for any 64 bit integer and for the shortest form of a double
+    char buffer[32];
+    const std::to_chars_result conversion = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    result.append(buffer, conversion.ptr);
+}
+
+// Appends value with a fixed number of decimals, same output as printf("%.*f")
+template <typename T> void appendFixed(std::string &result, const T value, const int precision)
+{
+    static_assert(std::is_floating_point_v<T>, "Only floating point types supported");
+
+    const size_t old_size = result.size();
+    const size_t max_length = static_cast<size_t>(std::numeric_limits<T>::max_exponent10) + 4 +
+                              static_cast<size_t>(precision > 0 ? precision : 0);
+    result.resize(old_size + max_length);
+
+    char *const first = &result[old_size];
+    const std::to_chars_result conversion =
+        std::to_chars(first, first + max_length, value, std::chars_format::fixed, precision);
+    result.resize(old_size + static_cast<size_t>(conversion.ptr - first));
+}
+
+template <typename T> std::string formatNumber(const T value)
+{
+    std::string result;
+    appendNumber(result, value);
+    return result;
+}
+
+template <typename T> std::string formatFixed(const T value, const int precision)
+{
+    std::string result;
+    appendFixed(result, value, precision);
+    return result;
+}
+
+} // namespace internal
+} // namespace lumos
+
+#endif // LUMOS_NUMBER_CONVERSION_H_
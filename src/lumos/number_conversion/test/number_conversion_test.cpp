@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+
+#include "lumos/number_conversion/number_conversion.h"
+
+namespace lumos
+{
+namespace internal
+{
+
+    class NumberConversionTest : public ::testing::Test
+    {
+    };
+
+    TEST_F(NumberConversionTest, CountLeadingDigits)
+    {
+        EXPECT_EQ(countLeadingDigits(""), 0U);
+        EXPECT_EQ(countLeadingDigits("abc"), 0U);
+        EXPECT_EQ(countLeadingDigits("123abc"), 3U);
+        EXPECT_EQ(countLeadingDigits("12345678"), 8U);
+        EXPECT_EQ(countLeadingDigits("1234567/9"), 7U);
+        EXPECT_EQ(countLeadingDigits("12345678:"), 8U);
+        EXPECT_EQ(countLeadingDigits("12345678901234567890.5"), 20U);
+
+        // Bytes just outside '0'..'9' in every position of an eight byte chunk
+        for (size_t k = 0; k < 8; k++)
+        {
+            for (const char c : {'/', ':', '\0', '\xb0', '\xb9'})
+            {
+                std::string str = "99999999";
+                str[k] = c;
+                EXPECT_EQ(countLeadingDigits(str), k);
+            }
+        }
+    }
+
+    TEST_F(NumberConversionTest, ParseIntegers)
+    {
+        EXPECT_EQ(parseNumber<int>("42"), 42);
+        EXPECT_EQ(parseNumber<int>("+42"), 42);
+        EXPECT_EQ(parseNumber<int>("-42"), -42);
+        EXPECT_EQ(parseNumber<int>("-0"), 0);
+        EXPECT_EQ(parseNumber<int8_t>("-128"), INT8_MIN);
+        EXPECT_EQ(parseNumber<uint8_t>("255"), UINT8_MAX);
+        EXPECT_EQ(parseNumber<int64_t>("-9223372036854775808"), INT64_MIN);
+        EXPECT_EQ(parseNumber<int64_t>("9223372036854775807"), INT64_MAX);
+        EXPECT_EQ(parseNumber<uint64_t>("18446744073709551615"), UINT64_MAX);
+        EXPECT_EQ(parseNumber<uint32_t>("000000000000000000000000007"), 7U);
+
+        EXPECT_THROW(parseNumber<int8_t>("128"), std::out_of_range);
+        EXPECT_THROW(parseNumber<int8_t>("-129"), std::out_of_range);
+        EXPECT_THROW(parseNumber<uint64_t>("18446744073709551616"), std::out_of_range);
+        EXPECT_THROW(parseNumber<int64_t>("-9223372036854775809"), std::out_of_range);
+
+        EXPECT_THROW(parseNumber<int>(""), std::invalid_argument);
+        EXPECT_THROW(parseNumber<int>("+"), std::invalid_argument);
+        EXPECT_THROW(parseNumber<int>("-"), std::invalid_argument);
+        EXPECT_THROW(parseNumber<int>("+-1"), std::invalid_argument);
+        EXPECT_THROW(parseNumber<int>("12a"), std::invalid_argument);
+        EXPECT_THROW(parseNumber<int>(" 12"), std::invalid_argument);
+        EXPECT_THROW(parseNumber<int>("1.5"), std::invalid_argument);
+        EXPECT_THROW(parseNumber<unsigned int>("-1"), std::invalid_argument);
+    }
+
+    TEST_F(NumberConversionTest, ParseIntegersRandom)
+    {
+        std::mt19937_64 rng(7);
+
+        for (size_t i = 0; i < 10000; i++)
+        {
+            const int64_t value = static_cast<int64_t>(rng()) >> (rng() % 64);
+            int64_t parsed = 0;
+            ASSERT_TRUE(tryParseNumber(std::to_string(value), parsed));
+            EXPECT_EQ(parsed, value);
+
+            const uint64_t unsigned_value = rng() >> (rng() % 64);
+            uint64_t unsigned_parsed = 0;
+            ASSERT_TRUE(tryParseNumber(std::to_string(unsigned_value), unsigned_parsed));
+            EXPECT_EQ(unsigned_parsed, unsigned_value);
+        }
+    }
+
+    TEST_F(NumberConversionTest, ParseFloatingPoint)
+    {
+        EXPECT_DOUBLE_EQ(parseNumber<double>("3.25"), 3.25);
+        EXPECT_DOUBLE_EQ(parseNumber<double>("+3.25"), 3.25);
+        EXPECT_DOUBLE_EQ(parseNumber<double>("-1e-3"), -1e-3);
+        EXPECT_DOUBLE_EQ(parseNumber<double>("42"), 42.0);
+        EXPECT_FLOAT_EQ(parseNumber<float>("0.1"), 0.1F);
+        EXPECT_EQ(parseNumber<double>("0.1"), 0.1);
+
+        EXPECT_THROW(parseNumber<double>("1e999"), std::out_of_range);
+        EXPECT_THROW(parseNumber<double>(""), std::invalid_argument);
+        EXPECT_THROW(parseNumber<double>("abc"), std::invalid_argument);
+        EXPECT_THROW(parseNumber<double>("1.5x"), std::invalid_argument);
+        EXPECT_THROW(parseNumber<double>("+-1"), std::invalid_argument);
+    }
+
+    TEST_F(NumberConversionTest, FormatRoundTrip)
+    {
+        std::mt19937_64 rng(11);
+        std::uniform_real_distribution<double> exponent(-300.0, 300.0);
+
+        for (size_t i = 0; i < 10000; i++)
+        {
+            const double value = std::pow(10.0, exponent(rng)) * ((i % 2 == 0) ? 1.0 : -1.0);
+            EXPECT_EQ(parseNumber<double>(formatNumber(value)), value);
+        }
+
+        EXPECT_EQ(formatNumber(0.1), "0.1");
+        EXPECT_EQ(formatNumber(-42), "-42");
+        EXPECT_EQ(formatNumber(UINT64_MAX), "18446744073709551615");
+    }
+
+    TEST_F(NumberConversionTest, FormatFixed)
+    {
+        EXPECT_EQ(formatFixed(3.14, 6), std::to_string(3.14));
+        EXPECT_EQ(formatFixed(-2.5, 1), "-2.5");
+        EXPECT_EQ(formatFixed(1e300, 2), std::to_string(1e300).substr(0, 301) + ".00");
+        EXPECT_EQ(formatFixed(std::numeric_limits<double>::lowest(), 6),
+                  std::to_string(std::numeric_limits<double>::lowest()));
+
+        std::string result = "x=";
+        appendFixed(result, 0.5, 3);
+        EXPECT_EQ(result, "x=0.500");
+    }
+
+} // namespace internal
+} // namespace lumos
@@ -0,0 +1,95 @@
+#ifndef LUMOS_PARALLEL_AFFINITY_H_
+#define LUMOS_PARALLEL_AFFINITY_H_
+
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace lumos
+{
+  namespace parallel
+  {
+    // Restricts the calling thread to one CPU. Returns false where thread
+    // affinity is not supported (non-Linux) or the CPU is not available
+    inline bool pinCurrentThread(const int cpu)
+    {
+#if defined(__linux__)
+      if (cpu < 0 || cpu >= CPU_SETSIZE)
+      {
+        return false;
+      }
+      cpu_set_t cpu_set;
+      CPU_ZERO(&cpu_set);
+      CPU_SET(cpu, &cpu_set);
+      return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+#else
+      (void)cpu;
+      return false;
+#endif
+    }
+
+    namespace internal
+    {
+      // Parses a kernel CPU list such as "0-3,8,10-11"
+      inline std::vector<int> parseCpuList(const std::string &list)
+      {
+        std::vector<int> cpus;
+        std::stringstream stream(list);
+        std::string range;
+        while (std::getline(stream, range, ','))
+        {
+          const size_t dash = range.find('-');
+          try
+          {
+            const int first = std::stoi(range.substr(0, dash));
+            const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu)
+            {
+              cpus.push_back(cpu);
+            }
+          }
+          catch (const std::exception &)
+          {
+            // Blank entries, such as the trailing newline
+          }
+        }
+        return cpus;
+      }
+    } // namespace internal
+
+    // CPUs of a NUMA node as reported by the kernel, empty if the node does
+    // not exist or the platform has no sysfs. Pinning the workers of a pool
+    // to them keeps its threads next to memory allocated on that node
+    inline std::vector<int> numaNodeCpus(const int node)
+    {
+      std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+      std::string list;
+      if (!file || !std::getline(file, list))
+      {
+        return std::vector<int>();
+      }
+      return internal::parseCpuList(list);
+    }
+
+    // Number of NUMA nodes, 1 where they cannot be queried
+    inline size_t numNumaNodes()
+    {
+      size_t num_nodes = 0U;
+      while (!numaNodeCpus(static_cast<int>(num_nodes)).empty())
+      {
+        ++num_nodes;
+      }
+      return num_nodes == 0U ? 1U : num_nodes;
+    }
+  } // namespace parallel
+} // namespace lumos
+
+#endif // LUMOS_PARALLEL_AFFINITY_H_
@@ -0,0 +1,9 @@
+#ifndef LUMOS_PARALLEL_PARALLEL_H_
+#define LUMOS_PARALLEL_PARALLEL_H_
+
+#include "lumos/parallel/affinity.h"
+#include "lumos/parallel/parallel_for.h"
+#include "lumos/parallel/task_graph.h"
+#include "lumos/parallel/thread_pool.h"
+
+#endif // LUMOS_PARALLEL_PARALLEL_H_
@@ -0,0 +1,112 @@
+#ifndef LUMOS_PARALLEL_PARALLEL_FOR_H_
+#define LUMOS_PARALLEL_PARALLEL_FOR_H_
+
+#include "lumos/parallel/thread_pool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace lumos
+{
+  namespace parallel
+  {
+    namespace internal
+    {
+      // Chunks per thread when the grain size leaves the choice to the
+      // scheduler, enough for stealing to even out uneven chunks
+      constexpr size_t kChunksPerThread = 4U;
+
+      inline size_t divideRoundingUp(const size_t numerator, const size_t denominator)
+      {
+        return (numerator + denominator - 1U) / denominator;
+      }
+    } // namespace internal
+
+    // Calls f(chunk_begin, chunk_end) for contiguous chunks covering
+    // [begin, end) on the threads of pool and the calling thread. Chunks have
+    // at least grain_size elements (except a shorter range) and there are at
+    // most a few per thread; ranges of at most one grain run on the calling
+    // thread. Rethrows the first exception thrown by f
+    template <typename F>
+    void parallelFor(const size_t begin, const size_t end, const size_t grain_size,
+                     const F &f, ThreadPool &pool = defaultThreadPool())
+    {
+      if (end <= begin)
+      {
+        return;
+      }
+
+      const size_t num_elements = end - begin;
+      const size_t max_chunks = internal::kChunksPerThread * (pool.numThreads() + 1U);
+      const size_t chunk_size =
+          std::max(std::max<size_t>(grain_size, 1U),
+                   internal::divideRoundingUp(num_elements, max_chunks));
+      if (chunk_size >= num_elements)
+      {
+        f(begin, end);
+        return;
+      }
+
+      TaskGroup group(pool);
+      for (size_t chunk_begin = begin + chunk_size; chunk_begin < end; chunk_begin += chunk_size)
+      {
+        const size_t chunk_end = std::min(chunk_begin + chunk_size, end);
+        group.run([&f, chunk_begin, chunk_end]()
+                  { f(chunk_begin, chunk_end); });
+      }
+      group.run([&f, begin, chunk_size]()
+                { f(begin, begin + chunk_size); });
+      group.wait();
+    }
+
+    // Reduces [begin, end) split in chunks of grain_size elements:
+    // combine(...combine(combine(identity, map(c0)), map(c1))..., map(cn)),
+    // where map(chunk_begin, chunk_end) returns the value of one chunk. The
+    // chunks and the order of combination depend only on grain_size, so the
+    // result is the same for any pool (bit for bit with floating point).
+    // grain_size 0 picks one from the pool size, giving up that guarantee
+    template <typename T, typename Map, typename Combine>
+    T parallelReduce(const size_t begin, const size_t end, size_t grain_size, T identity,
+                     const Map &map, const Combine &combine,
+                     ThreadPool &pool = defaultThreadPool())
+    {
+      if (end <= begin)
+      {
+        return identity;
+      }
+
+      const size_t num_elements = end - begin;
+      if (grain_size == 0U)
+      {
+        grain_size = internal::divideRoundingUp(
+            num_elements, internal::kChunksPerThread * (pool.numThreads() + 1U));
+      }
+      const size_t num_chunks = internal::divideRoundingUp(num_elements, grain_size);
+
+      // Chunk values in order, computed by tasks of consecutive chunks
+      std::vector<T> values(num_chunks, identity);
+      parallelFor(
+          0U, num_chunks, 1U,
+          [&](const size_t first_chunk, const size_t last_chunk)
+          {
+            for (size_t chunk = first_chunk; chunk < last_chunk; ++chunk)
+            {
+              const size_t chunk_begin = begin + chunk * grain_size;
+              values[chunk] = map(chunk_begin, std::min(chunk_begin + grain_size, end));
+            }
+          },
+          pool);
+
+      T result = std::move(identity);
+      for (T &value : values)
+      {
+        result = combine(std::move(result), std::move(value));
+      }
+      return result;
+    }
+  } // namespace parallel
+} // namespace lumos
+
+#endif // LUMOS_PARALLEL_PARALLEL_FOR_H_
@@ -0,0 +1,174 @@
+#ifndef LUMOS_PARALLEL_TASK_GRAPH_H_
+#define LUMOS_PARALLEL_TASK_GRAPH_H_
+
+#include "lumos/parallel/thread_pool.h"
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace lumos
+{
+  namespace parallel
+  {
+    // Tasks with dependencies. A task is submitted to the pool as soon as
+    // the last of its predecessors has finished, so independent branches run
+    // in parallel without a global barrier. The graph can be run any number
+    // of times
+    class TaskGraph
+    {
+    public:
+      using TaskId = size_t;
+
+      template <typename F>
+      TaskId addTask(F &&f)
+      {
+        nodes_.push_back(Node{std::function<void()>(std::forward<F>(f)), {}, 0U});
+        return nodes_.size() - 1U;
+      }
+
+      // after starts once before has finished
+      void precede(const TaskId before, const TaskId after)
+      {
+        if (before >= nodes_.size() || after >= nodes_.size() || before == after)
+        {
+          throw std::invalid_argument("Invalid task dependency");
+        }
+        nodes_[before].successors.push_back(after);
+        ++nodes_[after].num_predecessors;
+      }
+
+      size_t size() const
+      {
+        return nodes_.size();
+      }
+
+      // Runs every task once and returns when all have finished. After a
+      // task throws, the tasks that have not started yet are skipped and the
+      // exception is rethrown here
+      void run(ThreadPool &pool = defaultThreadPool())
+      {
+        if (hasCycle())
+        {
+          throw std::invalid_argument("Task graph has a cycle");
+        }
+
+        RunState state(nodes_.size());
+        for (size_t i = 0; i < nodes_.size(); ++i)
+        {
+          state.num_remaining[i].store(nodes_[i].num_predecessors, std::memory_order_relaxed);
+        }
+
+        {
+          TaskGroup group(pool);
+          for (size_t i = 0; i < nodes_.size(); ++i)
+          {
+            if (nodes_[i].num_predecessors == 0U)
+            {
+              group.run([this, &state, &group, i]()
+                        { runTask(i, state, group); });
+            }
+          }
+          group.wait();
+        }
+
+        if (state.exception)
+        {
+          std::rethrow_exception(state.exception);
+        }
+      }
+
+    private:
+      struct Node
+      {
+        std::function<void()> work;
+        std::vector<TaskId> successors;
+        size_t num_predecessors;
+      };
+
+      struct RunState
+      {
+        explicit RunState(const size_t num_tasks)
+            : num_remaining(new std::atomic<size_t>[num_tasks]), has_failed(false)
+        {
+        }
+
+        // Predecessors of each task that have not finished yet
+        std::unique_ptr<std::atomic<size_t>[]> num_remaining;
+        std::atomic<bool> has_failed;
+        std::mutex exception_mutex;
+        std::exception_ptr exception;
+      };
+
+      void runTask(const TaskId id, RunState &state, TaskGroup &group) const
+      {
+        if (!state.has_failed.load(std::memory_order_acquire))
+        {
+          try
+          {
+            nodes_[id].work();
+          }
+          catch (...)
+          {
+            std::lock_guard<std::mutex> lock(state.exception_mutex);
+            if (!state.exception)
+            {
+              state.exception = std::current_exception();
+            }
+            state.has_failed.store(true, std::memory_order_release);
+          }
+        }
+
+        for (const TaskId successor : nodes_[id].successors)
+        {
+          if (state.num_remaining[successor].fetch_sub(1U, std::memory_order_acq_rel) == 1U)
+          {
+            group.run([this, &state, &group, successor]()
+                      { runTask(successor, state, group); });
+          }
+        }
+      }
+
+      // Kahn's algorithm, tasks on a cycle never run out of predecessors
+      bool hasCycle() const
+      {
+        std::vector<size_t> num_remaining(nodes_.size());
+        std::vector<TaskId> ready;
+        for (size_t i = 0; i < nodes_.size(); ++i)
+        {
+          num_remaining[i] = nodes_[i].num_predecessors;
+          if (num_remaining[i] == 0U)
+          {
+            ready.push_back(i);
+          }
+        }
+
+        size_t num_visited = 0U;
+        while (!ready.empty())
+        {
+          const TaskId id = ready.back();
+          ready.pop_back();
+          ++num_visited;
+          for (const TaskId successor : nodes_[id].successors)
+          {
+            if (--num_remaining[successor] == 0U)
+            {
+              ready.push_back(successor);
+            }
+          }
+        }
+        return num_visited != nodes_.size();
+      }
+
+      std::vector<Node> nodes_;
+    };
+  } // namespace parallel
+} // namespace lumos
+
+#endif // LUMOS_PARALLEL_TASK_GRAPH_H_
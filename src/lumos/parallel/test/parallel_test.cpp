@@ -0,0 +1,248 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "lumos/parallel/parallel.h"
+
+namespace lumos
+{
+  namespace parallel
+  {
+    TEST(ThreadPoolTest, RunsAllSubmittedTasks)
+    {
+      std::atomic<int> num_run(0);
+      {
+        ThreadPool pool(3);
+        EXPECT_EQ(pool.numThreads(), 3U);
+        EXPECT_FALSE(pool.isWorkerThread());
+        for (int i = 0; i < 1000; ++i)
+        {
+          pool.submit([&num_run]()
+                      { ++num_run; });
+        }
+      }
+      // The destructor runs the remaining tasks before joining
+      EXPECT_EQ(num_run.load(), 1000);
+    }
+
+    TEST(ThreadPoolTest, TaskGroupsNestAndPropagateExceptions)
+    {
+      ThreadPool pool(2);
+
+      // Recursive fork-join deeper than the number of workers, waiting
+      // threads run tasks instead of blocking
+      std::function<uint64_t(uint64_t)> fibonacci = [&](const uint64_t n) -> uint64_t
+      {
+        if (n < 2U)
+        {
+          return n;
+        }
+        uint64_t a = 0U;
+        TaskGroup group(pool);
+        group.run([&]()
+                  { a = fibonacci(n - 1U); });
+        const uint64_t b = fibonacci(n - 2U);
+        group.wait();
+        return a + b;
+      };
+      EXPECT_EQ(fibonacci(18U), 2584U);
+
+      TaskGroup group(pool);
+      std::atomic<int> num_run(0);
+      for (int i = 0; i < 50; ++i)
+      {
+        group.run([&num_run, i]()
+                  {
+                    ++num_run;
+                    if (i == 17)
+                    {
+                      throw std::runtime_error("task failed");
+                    } });
+      }
+      EXPECT_THROW(group.wait(), std::runtime_error);
+      EXPECT_EQ(num_run.load(), 50);
+
+      // The exception is reported once
+      group.run([]() {});
+      EXPECT_NO_THROW(group.wait());
+    }
+
+    TEST(ParallelForTest, CoversRangeWithGrainSizedChunks)
+    {
+      ThreadPool pool(4);
+      const size_t n = 100003U;
+      std::vector<int> visits(n, 0);
+      std::mutex mutex;
+      std::set<std::pair<size_t, size_t>> chunks;
+
+      parallelFor(
+          7U, n, 1000U,
+          [&](const size_t begin, const size_t end)
+          {
+            for (size_t i = begin; i < end; ++i)
+            {
+              ++visits[i];
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            chunks.emplace(begin, end);
+          },
+          pool);
+
+      for (size_t i = 0; i < n; ++i)
+      {
+        ASSERT_EQ(visits[i], i < 7U ? 0 : 1) << i;
+      }
+      EXPECT_GT(chunks.size(), 1U);
+      EXPECT_LE(chunks.size(), internal::kChunksPerThread * (pool.numThreads() + 1U));
+      for (const std::pair<size_t, size_t> &chunk : chunks)
+      {
+        EXPECT_TRUE(chunk.second - chunk.first >= 1000U || chunk.second == n);
+      }
+
+      // A single grain runs on the calling thread
+      std::thread::id caller;
+      parallelFor(
+          0U, 1000U, 1000U, [&](size_t, size_t)
+          { caller = std::this_thread::get_id(); },
+          pool);
+      EXPECT_EQ(caller, std::this_thread::get_id());
+
+      EXPECT_THROW(parallelFor(
+                       0U, 100U, 1U, [](const size_t begin, size_t)
+                       {
+                         if (begin > 50U)
+                         {
+                           throw std::out_of_range("chunk");
+                         } },
+                       pool),
+                   std::out_of_range);
+    }
+
+    TEST(ParallelForTest, ReduceIsDeterministic)
+    {
+      const size_t n = 1000000U;
+      std::vector<double> values(n);
+      for (size_t i = 0; i < n; ++i)
+      {
+        values[i] = 1.0 / static_cast<double>(i + 1U);
+      }
+
+      const auto sum_chunk = [&values](const size_t begin, const size_t end)
+      {
+        double sum = 0.0;
+        for (size_t i = begin; i < end; ++i)
+        {
+          sum += values[i];
+        }
+        return sum;
+      };
+      const auto add = [](const double a, const double b)
+      { return a + b; };
+
+      ThreadPool one(1);
+      ThreadPool four(4);
+      const double sum_one = parallelReduce(0U, n, 4096U, 0.0, sum_chunk, add, one);
+      const double sum_four = parallelReduce(0U, n, 4096U, 0.0, sum_chunk, add, four);
+      EXPECT_EQ(sum_one, sum_four);
+      EXPECT_NEAR(sum_one, 14.392726722865723631, 1e-9);
+
+      // Non-commutative combination keeps the chunk order
+      const std::vector<size_t> order = parallelReduce(
+          0U, 10U, 3U, std::vector<size_t>(),
+          [](const size_t begin, size_t)
+          { return std::vector<size_t>{begin}; },
+          [](std::vector<size_t> a, const std::vector<size_t> &b)
+          {
+            a.insert(a.end(), b.begin(), b.end());
+            return a;
+          },
+          four);
+      EXPECT_EQ(order, std::vector<size_t>({0U, 3U, 6U, 9U}));
+      EXPECT_EQ(parallelReduce(5U, 5U, 1U, 42.0, sum_chunk, add), 42.0);
+    }
+
+    TEST(TaskGraphTest, RespectsDependencies)
+    {
+      ThreadPool pool(3);
+      TaskGraph graph;
+      std::atomic<int> clock(0);
+      std::vector<int> finished_at(6, -1);
+
+      // 0 -> {1, 2} -> 3 -> 5, 4 independent
+      std::vector<TaskGraph::TaskId> ids;
+      for (int i = 0; i < 6; ++i)
+      {
+        ids.push_back(graph.addTask([&, i]()
+                                    {
+                                      std::this_thread::sleep_for(std::chrono::microseconds(200));
+                                      finished_at[i] = clock++; }));
+      }
+      graph.precede(ids[0], ids[1]);
+      graph.precede(ids[0], ids[2]);
+      graph.precede(ids[1], ids[3]);
+      graph.precede(ids[2], ids[3]);
+      graph.precede(ids[3], ids[5]);
+      EXPECT_EQ(graph.size(), 6U);
+
+      for (int run = 0; run < 3; ++run)
+      {
+        graph.run(pool);
+        for (int i = 0; i < 6; ++i)
+        {
+          EXPECT_GE(finished_at[i], 0);
+        }
+        EXPECT_LT(finished_at[0], finished_at[1]);
+        EXPECT_LT(finished_at[0], finished_at[2]);
+        EXPECT_LT(finished_at[1], finished_at[3]);
+        EXPECT_LT(finished_at[2], finished_at[3]);
+        EXPECT_LT(finished_at[3], finished_at[5]);
+      }
+
+      EXPECT_THROW(graph.precede(ids[0], ids[0]), std::invalid_argument);
+      EXPECT_THROW(graph.precede(ids[0], 17U), std::invalid_argument);
+      graph.precede(ids[5], ids[0]);
+      EXPECT_THROW(graph.run(pool), std::invalid_argument);
+    }
+
+    TEST(TaskGraphTest, FailedTaskSkipsTheRest)
+    {
+      TaskGraph graph;
+      bool later_ran = false;
+      const TaskGraph::TaskId first = graph.addTask([]()
+                                                    { throw std::runtime_error("first"); });
+      const TaskGraph::TaskId later = graph.addTask([&later_ran]()
+                                                    { later_ran = true; });
+      graph.precede(first, later);
+      EXPECT_THROW(graph.run(), std::runtime_error);
+      EXPECT_FALSE(later_ran);
+    }
+
+    TEST(AffinityTest, CpuListsAndPinning)
+    {
+      EXPECT_EQ(internal::parseCpuList("0-3,8,10-11\n"), std::vector<int>({0, 1, 2, 3, 8, 10, 11}));
+      EXPECT_TRUE(internal::parseCpuList("").empty());
+      EXPECT_GE(numNumaNodes(), 1U);
+      EXPECT_FALSE(pinCurrentThread(-1));
+
+      // Pinned workers still run tasks, whether or not pinning is supported
+      ThreadPoolOptions options;
+      options.num_threads = 2U;
+      options.cpus = {0};
+      ThreadPool pool(options);
+      std::atomic<int> num_run(0);
+      parallelFor(
+          0U, 64U, 1U, [&num_run](const size_t begin, const size_t end)
+          { num_run += static_cast<int>(end - begin); },
+          pool);
+      EXPECT_EQ(num_run.load(), 64);
+    }
+  } // namespace parallel
+} // namespace lumos
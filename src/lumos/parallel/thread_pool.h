@@ -0,0 +1,359 @@
+#ifndef LUMOS_PARALLEL_THREAD_POOL_H_
+#define LUMOS_PARALLEL_THREAD_POOL_H_
+
+#include "lumos/concurrency/wait_strategy.h"
+#include "lumos/parallel/affinity.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace lumos
+{
+  namespace parallel
+  {
+    inline size_t hardwareConcurrency()
+    {
+      const unsigned int num_hw_threads = std::thread::hardware_concurrency();
+      return num_hw_threads == 0U ? 1U : static_cast<size_t>(num_hw_threads);
+    }
+
+    struct ThreadPoolOptions
+    {
+      // 0 = one worker per hardware thread
+      size_t num_threads = 0U;
+      // Worker i is pinned to cpus[i % cpus.size()], no pinning when empty.
+      // numaNodeCpus(node) gives the CPUs of one NUMA node
+      std::vector<int> cpus;
+    };
+
+    // Work-stealing thread pool. Every worker has its own task deque: tasks
+    // submitted from a worker go to the back of its deque and the worker
+    // takes them from the back again (most recent first, while their data is
+    // still in cache), idle workers steal from the front of other deques
+    // (oldest first, usually the largest pieces of work). Tasks submitted
+    // from other threads go to a shared injection queue. Idle workers park
+    // with a SpinThenParkWaiter and sleep until a task is submitted or the
+    // pool is destroyed, so an idle pool costs no CPU time.
+    //
+    // Threads that wait for tasks (TaskGroup::wait) run pending tasks in the
+    // meantime, so tasks can submit and wait for tasks of their own without
+    // running out of workers. Tasks given to submit() must not throw, use a
+    // TaskGroup to get their exceptions
+    class ThreadPool
+    {
+    public:
+      using Task = std::function<void()>;
+
+      ThreadPool() : ThreadPool(ThreadPoolOptions()) {}
+
+      explicit ThreadPool(const size_t num_threads)
+          : ThreadPool(ThreadPoolOptions{num_threads, std::vector<int>()})
+      {
+      }
+
+      explicit ThreadPool(const ThreadPoolOptions &options)
+          : num_pending_(0U), is_stopping_(false)
+      {
+        const size_t num_threads =
+            options.num_threads == 0U ? hardwareConcurrency() : options.num_threads;
+        queues_.reserve(num_threads);
+        for (size_t i = 0; i < num_threads; ++i)
+        {
+          queues_.emplace_back(new WorkerQueue());
+        }
+        workers_.reserve(num_threads);
+        for (size_t i = 0; i < num_threads; ++i)
+        {
+          const int cpu = options.cpus.empty() ? -1 : options.cpus[i % options.cpus.size()];
+          workers_.emplace_back([this, i, cpu]()
+                                { workerLoop(i, cpu); });
+        }
+      }
+
+      ThreadPool(const ThreadPool &) = delete;
+      ThreadPool &operator=(const ThreadPool &) = delete;
+
+      // Runs all submitted tasks, then joins the workers
+      ~ThreadPool()
+      {
+        is_stopping_.store(true, std::memory_order_release);
+        work_available_.notifyAll();
+        for (std::thread &worker : workers_)
+        {
+          worker.join();
+        }
+      }
+
+      size_t numThreads() const
+      {
+        return workers_.size();
+      }
+
+      template <typename F>
+      void submit(F &&f)
+      {
+        const size_t worker = currentWorkerIndex();
+        if (worker != kNotAWorker)
+        {
+          WorkerQueue &queue = *queues_[worker];
+          std::lock_guard<std::mutex> lock(queue.mutex);
+          queue.tasks.emplace_back(std::forward<F>(f));
+        }
+        else
+        {
+          std::lock_guard<std::mutex> lock(injection_mutex_);
+          injection_queue_.emplace_back(std::forward<F>(f));
+        }
+        num_pending_.fetch_add(1U, std::memory_order_release);
+        work_available_.notifyOne();
+        // Threads in waitUntil also run pending tasks
+        task_done_.notifyAll();
+      }
+
+      // Runs one pending task on the calling thread, false if there was none
+      bool tryRunPendingTask()
+      {
+        Task task;
+        if (!takeTask(currentWorkerIndex(), task))
+        {
+          return false;
+        }
+        task();
+        task_done_.notifyAll();
+        return true;
+      }
+
+      bool hasPendingTasks() const
+      {
+        return num_pending_.load(std::memory_order_acquire) != 0U;
+      }
+
+      // True on the worker threads of this pool
+      bool isWorkerThread() const
+      {
+        return currentWorkerIndex() != kNotAWorker;
+      }
+
+      // Waits, running pending tasks, until done() is true. done() has to
+      // become true through tasks of this pool
+      template <typename Done>
+      void waitUntil(const Done &done)
+      {
+        while (!done())
+        {
+          if (!tryRunPendingTask())
+          {
+            task_done_.wait([this, &done]()
+                            { return done() || hasPendingTasks(); });
+          }
+        }
+      }
+
+    private:
+      static constexpr size_t kNotAWorker = static_cast<size_t>(-1);
+
+      struct alignas(concurrency::kCacheLineSize) WorkerQueue
+      {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+      };
+
+      struct WorkerIdentity
+      {
+        const ThreadPool *pool;
+        size_t index;
+      };
+
+      static WorkerIdentity &currentWorker()
+      {
+        static thread_local WorkerIdentity identity{nullptr, kNotAWorker};
+        return identity;
+      }
+
+      size_t currentWorkerIndex() const
+      {
+        const WorkerIdentity &identity = currentWorker();
+        return identity.pool == this ? identity.index : kNotAWorker;
+      }
+
+      // Own deque from the back, then the injection queue, then the other
+      // deques from the front
+      bool takeTask(const size_t worker, Task &task)
+      {
+        if (num_pending_.load(std::memory_order_acquire) == 0U)
+        {
+          return false;
+        }
+
+        if (worker != kNotAWorker)
+        {
+          WorkerQueue &queue = *queues_[worker];
+          std::lock_guard<std::mutex> lock(queue.mutex);
+          if (!queue.tasks.empty())
+          {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            num_pending_.fetch_sub(1U, std::memory_order_relaxed);
+            return true;
+          }
+        }
+
+        {
+          std::lock_guard<std::mutex> lock(injection_mutex_);
+          if (!injection_queue_.empty())
+          {
+            task = std::move(injection_queue_.front());
+            injection_queue_.pop_front();
+            num_pending_.fetch_sub(1U, std::memory_order_relaxed);
+            return true;
+          }
+        }
+
+        const size_t num_queues = queues_.size();
+        const size_t first_victim = worker == kNotAWorker ? 0U : worker + 1U;
+        for (size_t k = 0; k < num_queues; ++k)
+        {
+          WorkerQueue &queue = *queues_[(first_victim + k) % num_queues];
+          std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+          if (lock.owns_lock() && !queue.tasks.empty())
+          {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            num_pending_.fetch_sub(1U, std::memory_order_relaxed);
+            return true;
+          }
+        }
+        return false;
+      }
+
+      void workerLoop(const size_t index, const int cpu)
+      {
+        currentWorker() = WorkerIdentity{this, index};
+        if (cpu >= 0)
+        {
+          pinCurrentThread(cpu);
+        }
+
+        while (true)
+        {
+          if (tryRunPendingTask())
+          {
+            continue;
+          }
+          if (is_stopping_.load(std::memory_order_acquire) && !hasPendingTasks())
+          {
+            break;
+          }
+          work_available_.wait([this]()
+                               { return hasPendingTasks() ||
+                                        is_stopping_.load(std::memory_order_acquire); });
+        }
+      }
+
+      std::vector<std::unique_ptr<WorkerQueue>> queues_;
+      std::mutex injection_mutex_;
+      std::deque<Task> injection_queue_;
+
+      alignas(concurrency::kCacheLineSize) std::atomic<size_t> num_pending_;
+      std::atomic<bool> is_stopping_;
+
+      // Parked threads are only woken by notifications, every change of the
+      // conditions they wait for has to notify them
+      concurrency::SpinThenParkWaiter work_available_; // Pending task or stopping
+      concurrency::SpinThenParkWaiter task_done_;      // Finished or pending task
+
+      std::vector<std::thread> workers_;
+    };
+
+    // Pool shared by the library, one worker per hardware thread, created on
+    // first use
+    inline ThreadPool &defaultThreadPool()
+    {
+      static ThreadPool pool;
+      return pool;
+    }
+
+    // Set of tasks that can be waited for together. wait() runs pending tasks
+    // of the pool while it waits and rethrows the first exception thrown by
+    // a task of the group
+    class TaskGroup
+    {
+    public:
+      explicit TaskGroup(ThreadPool &pool = defaultThreadPool())
+          : pool_(pool), num_pending_(0U)
+      {
+      }
+
+      TaskGroup(const TaskGroup &) = delete;
+      TaskGroup &operator=(const TaskGroup &) = delete;
+
+      // Waits for the tasks, their exceptions are dropped
+      ~TaskGroup()
+      {
+        waitForTasks();
+      }
+
+      template <typename F>
+      void run(F &&f)
+      {
+        num_pending_.fetch_add(1U, std::memory_order_relaxed);
+        pool_.submit(
+            [this, f = std::forward<F>(f)]() mutable
+            {
+              try
+              {
+                f();
+              }
+              catch (...)
+              {
+                std::lock_guard<std::mutex> lock(exception_mutex_);
+                if (!exception_)
+                {
+                  exception_ = std::current_exception();
+                }
+              }
+              // The group can be destroyed as soon as the count is zero, so
+              // this is the last access to it. The pool notifies the waiters
+              num_pending_.fetch_sub(1U, std::memory_order_acq_rel);
+            });
+      }
+
+      void wait()
+      {
+        waitForTasks();
+        std::exception_ptr exception;
+        {
+          std::lock_guard<std::mutex> lock(exception_mutex_);
+          std::swap(exception, exception_);
+        }
+        if (exception)
+        {
+          std::rethrow_exception(exception);
+        }
+      }
+
+    private:
+      void waitForTasks()
+      {
+        pool_.waitUntil([this]()
+                        { return num_pending_.load(std::memory_order_acquire) == 0U; });
+      }
+
+      ThreadPool &pool_;
+      std::atomic<size_t> num_pending_;
+      std::mutex exception_mutex_;
+      std::exception_ptr exception_;
+    };
+  } // namespace parallel
+} // namespace lumos
+
+#endif // LUMOS_PARALLEL_THREAD_POOL_H_
@@ -1,11 +1,16 @@
 #ifndef STRING_H
 #define STRING_H
 
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <map>
 #include <string>
+#include <string_view>
 #include <vector>
 
 // Basic string operations
-bool contains(const std::string &str, const std::string &substring);
+bool contains(std::string_view str, std::string_view substring);
 std::string replace(const std::string &input_str, const std::string &old_substr, const std::string &new_substr);
 std::vector<std::string> split(const std::string &str, const std::string &delimiter);
 
@@ -13,12 +18,77 @@ std::vector<std::string> split(const std::string &str, const std::string &delimi
 std::string trim(const std::string &str);
 std::string ltrim(const std::string &str);
 std::string rtrim(const std::string &str);
-bool startsWith(const std::string &str, const std::string &prefix);
-bool endsWith(const std::string &str, const std::string &suffix);
+bool startsWith(std::string_view str, std::string_view prefix);
+bool endsWith(std::string_view str, std::string_view suffix);
 std::string toLowerCase(const std::string &str);
 std::string toUpperCase(const std::string &str);
 std::string reverse(const std::string &str);
 
+// Allocation free variants. Returned views point into the input string and are
+// only valid as long as it is
+std::string_view trimView(std::string_view str);
+std::string_view ltrimView(std::string_view str);
+std::string_view rtrimView(std::string_view str);
+std::vector<std::string_view> splitView(std::string_view str, std::string_view delimiter);
+// Clears tokens and fills it, reusing its capacity. Returns the number of tokens
+size_t splitInto(std::string_view str, std::string_view delimiter, std::vector<std::string_view> &tokens);
+// Clears result and fills it, reusing its capacity
+void joinInto(const std::vector<std::string_view> &strings, std::string_view delimiter, std::string &result);
+
+// Lazy split, tokens are produced one at a time while iterating:
+//     for (std::string_view token : splitLazy(line, ","))
+class SplitRange
+{
+public:
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view *;
+        using reference = const std::string_view &;
+
+        Iterator();
+        Iterator(std::string_view str, std::string_view delimiter);
+
+        reference operator*() const;
+        pointer operator->() const;
+        Iterator &operator++();
+        Iterator operator++(int);
+        bool operator==(const Iterator &other) const;
+        bool operator!=(const Iterator &other) const;
+
+    private:
+        std::string_view remaining_;
+        std::string_view delimiter_;
+        std::string_view token_;
+        bool is_end_;
+
+        void advance();
+    };
+
+    SplitRange(std::string_view str, std::string_view delimiter);
+
+    Iterator begin() const;
+    Iterator end() const;
+
+private:
+    std::string_view str_;
+    std::string_view delimiter_;
+};
+
+SplitRange splitLazy(std::string_view str, std::string_view delimiter);
+
+// In place variants
+void trimInPlace(std::string &str);
+void ltrimInPlace(std::string &str);
+void rtrimInPlace(std::string &str);
+void toLowerCaseInPlace(std::string &str);
+void toUpperCaseInPlace(std::string &str);
+void reverseInPlace(std::string &str);
+void replaceInPlace(std::string &str, std::string_view old_substr, std::string_view new_substr);
+
 // String Joining/Building
 std::string join(const std::vector<std::string> &strings, const std::string &delimiter);
 
@@ -33,16 +103,75 @@ std::string padRight(const std::string &str, size_t total_length, char pad_char
 std::string strip(const std::string &str, const std::string &chars_to_remove);
 std::string replaceFirst(const std::string &input_str, const std::string &old_substr, const std::string &new_substr);
 std::string replaceLast(const std::string &input_str, const std::string &old_substr, const std::string &new_substr);
-size_t find(const std::string &str, const std::string &substring, size_t start_pos = 0);
-size_t findLast(const std::string &str, const std::string &substring);
-size_t count(const std::string &str, const std::string &substring);
+size_t find(std::string_view str, std::string_view substring, size_t start_pos = 0);
+size_t findLast(std::string_view str, std::string_view substring);
+size_t count(std::string_view str, std::string_view substring);
+
+// Multi pattern search. The patterns are compiled once into an Aho-Corasick
+// automaton, so the cost of a scan does not grow with the number of patterns.
+// Matches are reported leftmost first, preferring the longest pattern at the
+// same position, and never overlap, which for a single pattern gives the same
+// result as count() and replace(). Empty patterns never match. A match is only
+// known to be final once the scan has gone up to one longest pattern past its
+// start, and the scan then resumes at its end, so bytes behind a match can be
+// read twice. A text of n bytes costs O(n) without matches and
+// O(n * longest pattern) in the worst case, when matches follow each other.
+class MultiPatternMatcher
+{
+public:
+    struct Match
+    {
+        size_t position;
+        size_t length;
+        size_t pattern_index;
+    };
+
+    MultiPatternMatcher();
+    explicit MultiPatternMatcher(const std::vector<std::string> &patterns);
+
+    size_t numPatterns() const;
+    const std::string &pattern(size_t pattern_index) const;
+
+    bool containsAny(std::string_view str) const;
+    size_t countAll(std::string_view str) const;
+    std::vector<Match> findAll(std::string_view str) const;
+    // replacements[i] is substituted for every match of pattern i
+    std::string replaceAll(std::string_view str, const std::vector<std::string> &replacements) const;
+
+private:
+    static constexpr uint32_t kNoPattern = UINT32_MAX;
+
+    std::vector<std::string> patterns_;
+
+    // Bytes that occur in no pattern share class 0, which keeps the
+    // transition table at num_states * num_classes entries
+    std::array<uint16_t, 256> byte_class_;
+    size_t num_classes_;
+    std::vector<uint32_t> transitions_;
+    std::vector<uint32_t> depth_;
+    // Longest pattern that is a suffix of the state, or kNoPattern
+    std::vector<uint32_t> longest_match_;
+
+    // Prefilter used while in the root state, skips bytes no pattern starts with
+    std::array<bool, 256> is_first_byte_;
+    int single_first_byte_;
+
+    size_t skipToCandidate(std::string_view str, size_t pos) const;
+
+    template <typename F> void scan(std::string_view str, F &&on_match) const;
+};
+
+bool containsAny(std::string_view str, const std::vector<std::string> &patterns);
+size_t countAll(std::string_view str, const std::vector<std::string> &patterns);
+// Replaces every key of replacements by its value in a single pass
+std::string replaceAll(std::string_view str, const std::map<std::string, std::string> &replacements);
 
 // String Validation/Classification
-bool isNumeric(const std::string &str);
-bool isAlpha(const std::string &str);
-bool isAlphaNumeric(const std::string &str);
-bool isEmpty(const std::string &str);
-bool isBlank(const std::string &str);
+bool isNumeric(std::string_view str);
+bool isAlpha(std::string_view str);
+bool isAlphaNumeric(std::string_view str);
+bool isEmpty(std::string_view str);
+bool isBlank(std::string_view str);
 bool isValidEmail(const std::string &str);
 bool isValidUrl(const std::string &str);
 
@@ -2,12 +2,16 @@
 #define STRING_IMPL_H
 
 #include "lumos/string.h"
+#include "lumos/number_conversion.h"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <algorithm>
 #include <cctype>
+#include <cstring>
 #include <regex>
 #include <sstream>
+#include <stdexcept>
 #include <type_traits>
 
 #ifdef LUMOS_BUILD_FILE
@@ -16,14 +20,14 @@
 #define LUMOS_INLINE inline
 #endif
 
-LUMOS_INLINE bool contains(const std::string &str, const std::string &substring)
+LUMOS_INLINE bool contains(std::string_view str, std::string_view substring)
 {
     if (substring.empty())
     {
         return true;
     }
 
-    return str.find(substring) != std::string::npos;
+    return str.find(substring) != std::string_view::npos;
 }
 
 LUMOS_INLINE std::string replace(const std::string &input_str, const std::string &old_substr, const std::string &new_substr)
@@ -33,14 +37,19 @@ LUMOS_INLINE std::string replace(const std::string &input_str, const std::string
         return input_str;
     }
 
-    std::string result = input_str;
+    // Build the result in one pass instead of shifting the tail for every match
+    std::string result;
+    result.reserve(input_str.length());
+    size_t start = 0;
     size_t pos = 0;
 
-    while ((pos = result.find(old_substr, pos)) != std::string::npos)
+    while ((pos = input_str.find(old_substr, start)) != std::string::npos)
     {
-        result.replace(pos, old_substr.length(), new_substr);
-        pos += new_substr.length();
+        result.append(input_str, start, pos - start);
+        result += new_substr;
+        start = pos + old_substr.length();
     }
+    result.append(input_str, start, std::string::npos);
 
     return result;
 }
@@ -104,7 +113,7 @@ LUMOS_INLINE std::string rtrim(const std::string &str)
     return str.substr(0, end + 1);
 }
 
-LUMOS_INLINE bool startsWith(const std::string &str, const std::string &prefix)
+LUMOS_INLINE bool startsWith(std::string_view str, std::string_view prefix)
 {
     if (prefix.length() > str.length())
     {
@@ -113,7 +122,7 @@ LUMOS_INLINE bool startsWith(const std::string &str, const std::string &prefix)
     return str.compare(0, prefix.length(), prefix) == 0;
 }
 
-LUMOS_INLINE bool endsWith(const std::string &str, const std::string &suffix)
+LUMOS_INLINE bool endsWith(std::string_view str, std::string_view suffix)
 {
     if (suffix.length() > str.length())
     {
@@ -143,6 +152,275 @@ LUMOS_INLINE std::string reverse(const std::string &str)
     return result;
 }
 
+// =============================================================================
+// ALLOCATION FREE VARIANTS
+// =============================================================================
+
+LUMOS_INLINE std::string_view trimView(std::string_view str)
+{
+    return rtrimView(ltrimView(str));
+}
+
+LUMOS_INLINE std::string_view ltrimView(std::string_view str)
+{
+    const size_t start = str.find_first_not_of(" \t\n\r\f\v");
+    if (start == std::string_view::npos)
+    {
+        return std::string_view();
+    }
+    return str.substr(start);
+}
+
+LUMOS_INLINE std::string_view rtrimView(std::string_view str)
+{
+    const size_t end = str.find_last_not_of(" \t\n\r\f\v");
+    if (end == std::string_view::npos)
+    {
+        return std::string_view();
+    }
+    return str.substr(0, end + 1);
+}
+
+LUMOS_INLINE size_t splitInto(std::string_view str, std::string_view delimiter, std::vector<std::string_view> &tokens)
+{
+    tokens.clear();
+
+    if (delimiter.empty())
+    {
+        tokens.push_back(str);
+        return tokens.size();
+    }
+
+    size_t start = 0;
+    size_t pos = 0;
+
+    while ((pos = str.find(delimiter, start)) != std::string_view::npos)
+    {
+        tokens.push_back(str.substr(start, pos - start));
+        start = pos + delimiter.length();
+    }
+
+    tokens.push_back(str.substr(start));
+
+    return tokens.size();
+}
+
+LUMOS_INLINE std::vector<std::string_view> splitView(std::string_view str, std::string_view delimiter)
+{
+    std::vector<std::string_view> tokens;
+    splitInto(str, delimiter, tokens);
+    return tokens;
+}
+
+LUMOS_INLINE void joinInto(const std::vector<std::string_view> &strings, std::string_view delimiter, std::string &result)
+{
+    result.clear();
+
+    if (strings.empty())
+    {
+        return;
+    }
+
+    size_t total_length = delimiter.length() * (strings.size() - 1);
+    for (const std::string_view str : strings)
+    {
+        total_length += str.length();
+    }
+    result.reserve(total_length);
+
+    result += strings[0];
+    for (size_t i = 1; i < strings.size(); ++i)
+    {
+        result += delimiter;
+        result += strings[i];
+    }
+}
+
+LUMOS_INLINE SplitRange::Iterator::Iterator() : is_end_(true) {}
+
+LUMOS_INLINE SplitRange::Iterator::Iterator(std::string_view str, std::string_view delimiter)
+    : remaining_(str), delimiter_(delimiter), is_end_(false)
+{
+    advance();
+}
+
+LUMOS_INLINE void SplitRange::Iterator::advance()
+{
+    // remaining_.data() == nullptr marks that the last token has been produced
+    if (remaining_.data() == nullptr)
+    {
+        is_end_ = true;
+        return;
+    }
+
+    const size_t pos = delimiter_.empty() ? std::string_view::npos : remaining_.find(delimiter_);
+    if (pos == std::string_view::npos)
+    {
+        token_ = remaining_;
+        remaining_ = std::string_view();
+    }
+    else
+    {
+        token_ = remaining_.substr(0, pos);
+        // Keep a non null pointer when the delimiter is at the very end, so
+        // that the trailing empty token is still produced
+        remaining_ = std::string_view(remaining_.data() + pos + delimiter_.length(),
+                                      remaining_.length() - pos - delimiter_.length());
+    }
+}
+
+LUMOS_INLINE SplitRange::Iterator::reference SplitRange::Iterator::operator*() const
+{
+    return token_;
+}
+
+LUMOS_INLINE SplitRange::Iterator::pointer SplitRange::Iterator::operator->() const
+{
+    return &token_;
+}
+
+LUMOS_INLINE SplitRange::Iterator &SplitRange::Iterator::operator++()
+{
+    advance();
+    return *this;
+}
+
+LUMOS_INLINE SplitRange::Iterator SplitRange::Iterator::operator++(int)
+{
+    Iterator previous = *this;
+    advance();
+    return previous;
+}
+
+LUMOS_INLINE bool SplitRange::Iterator::operator==(const Iterator &other) const
+{
+    if (is_end_ || other.is_end_)
+    {
+        return is_end_ == other.is_end_;
+    }
+    return (token_.data() == other.token_.data()) && (token_.length() == other.token_.length());
+}
+
+LUMOS_INLINE bool SplitRange::Iterator::operator!=(const Iterator &other) const
+{
+    return !(*this == other);
+}
+
+LUMOS_INLINE SplitRange::SplitRange(std::string_view str, std::string_view delimiter)
+    : str_(str), delimiter_(delimiter)
+{
+}
+
+LUMOS_INLINE SplitRange::Iterator SplitRange::begin() const
+{
+    // An empty input still gives one empty token, same as split()
+    return Iterator(str_.data() == nullptr ? std::string_view("", 0) : str_, delimiter_);
+}
+
+LUMOS_INLINE SplitRange::Iterator SplitRange::end() const
+{
+    return Iterator();
+}
+
+LUMOS_INLINE SplitRange splitLazy(std::string_view str, std::string_view delimiter)
+{
+    return SplitRange(str, delimiter);
+}
+
+LUMOS_INLINE void trimInPlace(std::string &str)
+{
+    rtrimInPlace(str);
+    ltrimInPlace(str);
+}
+
+LUMOS_INLINE void ltrimInPlace(std::string &str)
+{
+    const size_t start = str.find_first_not_of(" \t\n\r\f\v");
+    str.erase(0, start == std::string::npos ? str.length() : start);
+}
+
+LUMOS_INLINE void rtrimInPlace(std::string &str)
+{
+    const size_t end = str.find_last_not_of(" \t\n\r\f\v");
+    str.erase(end == std::string::npos ? 0 : end + 1);
+}
+
+LUMOS_INLINE void toLowerCaseInPlace(std::string &str)
+{
+    for (char &c : str)
+    {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+}
+
+LUMOS_INLINE void toUpperCaseInPlace(std::string &str)
+{
+    for (char &c : str)
+    {
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+}
+
+LUMOS_INLINE void reverseInPlace(std::string &str)
+{
+    std::reverse(str.begin(), str.end());
+}
+
+LUMOS_INLINE void replaceInPlace(std::string &str, std::string_view old_substr, std::string_view new_substr)
+{
+    if (old_substr.empty())
+    {
+        return;
+    }
+
+    if (new_substr.length() <= old_substr.length())
+    {
+        // The result is not longer than the input, so it can be compacted in place
+        size_t read_pos = 0;
+        size_t write_pos = 0;
+        size_t pos = 0;
+
+        while ((pos = str.find(old_substr.data(), read_pos, old_substr.length())) != std::string::npos)
+        {
+            std::copy(str.begin() + read_pos, str.begin() + pos, str.begin() + write_pos);
+            write_pos += pos - read_pos;
+            std::copy(new_substr.begin(), new_substr.end(), str.begin() + write_pos);
+            write_pos += new_substr.length();
+            read_pos = pos + old_substr.length();
+        }
+
+        if (read_pos == 0)
+        {
+            return;
+        }
+
+        std::copy(str.begin() + read_pos, str.end(), str.begin() + write_pos);
+        str.resize(write_pos + (str.length() - read_pos));
+    }
+    else
+    {
+        std::string result;
+        result.reserve(str.length());
+        size_t start = 0;
+        size_t pos = 0;
+
+        while ((pos = str.find(old_substr.data(), start, old_substr.length())) != std::string::npos)
+        {
+            result.append(str, start, pos - start);
+            result += new_substr;
+            start = pos + old_substr.length();
+        }
+
+        if (start == 0)
+        {
+            return;
+        }
+
+        result.append(str, start, std::string::npos);
+        str.swap(result);
+    }
+}
+
 // =============================================================================
 // STRING JOINING/BUILDING
 // =============================================================================
@@ -154,10 +432,19 @@ LUMOS_INLINE std::string join(const std::vector<std::string> &strings, const std
         return "";
     }
 
-    std::string result = strings[0];
+    size_t total_length = delimiter.length() * (strings.size() - 1);
+    for (const std::string &str : strings)
+    {
+        total_length += str.length();
+    }
+
+    std::string result;
+    result.reserve(total_length);
+    result += strings[0];
     for (size_t i = 1; i < strings.size(); ++i)
     {
-        result += delimiter + strings[i];
+        result += delimiter;
+        result += strings[i];
     }
     return result;
 }
@@ -281,17 +568,17 @@ LUMOS_INLINE std::string replaceLast(const std::string &input_str, const std::st
     return result;
 }
 
-LUMOS_INLINE size_t find(const std::string &str, const std::string &substring, size_t start_pos)
+LUMOS_INLINE size_t find(std::string_view str, std::string_view substring, size_t start_pos)
 {
     return str.find(substring, start_pos);
 }
 
-LUMOS_INLINE size_t findLast(const std::string &str, const std::string &substring)
+LUMOS_INLINE size_t findLast(std::string_view str, std::string_view substring)
 {
     return str.rfind(substring);
 }
 
-LUMOS_INLINE size_t count(const std::string &str, const std::string &substring)
+LUMOS_INLINE size_t count(std::string_view str, std::string_view substring)
 {
     if (substring.empty())
     {
@@ -301,7 +588,7 @@ LUMOS_INLINE size_t count(const std::string &str, const std::string &substring)
     size_t count = 0;
     size_t pos = 0;
 
-    while ((pos = str.find(substring, pos)) != std::string::npos)
+    while ((pos = str.find(substring, pos)) != std::string_view::npos)
     {
         count++;
         pos += substring.length();
@@ -311,43 +598,339 @@ LUMOS_INLINE size_t count(const std::string &str, const std::string &substring)
 }
 
 // =============================================================================
-// STRING VALIDATION/CLASSIFICATION
+// MULTI PATTERN SEARCH
 // =============================================================================
 
-LUMOS_INLINE bool isNumeric(const std::string &str)
+LUMOS_INLINE MultiPatternMatcher::MultiPatternMatcher() : MultiPatternMatcher(std::vector<std::string>()) {}
+
+LUMOS_INLINE MultiPatternMatcher::MultiPatternMatcher(const std::vector<std::string> &patterns)
+    : patterns_(patterns), num_classes_(1), single_first_byte_(-1)
 {
-    if (str.empty())
+    byte_class_.fill(0);
+    is_first_byte_.fill(false);
+
+    for (const std::string &pattern : patterns_)
     {
-        return false;
+        for (const char c : pattern)
+        {
+            uint16_t &byte_class = byte_class_[static_cast<unsigned char>(c)];
+            if (byte_class == 0)
+            {
+                byte_class = static_cast<uint16_t>(num_classes_++);
+            }
+        }
     }
 
-    size_t start = 0;
-    if (str[0] == '+' || str[0] == '-')
+    // Trie of all patterns, state 0 is the root. A zero transition means
+    // "missing" while building, as no state can go back to the root
+    transitions_.assign(num_classes_, 0);
+    depth_.assign(1, 0);
+    longest_match_.assign(1, kNoPattern);
+
+    size_t num_first_bytes = 0;
+    for (size_t i = 0; i < patterns_.size(); i++)
     {
-        start = 1;
+        const std::string &pattern = patterns_[i];
+        if (pattern.empty())
+        {
+            continue;
+        }
+
+        uint32_t state = 0;
+        for (const char c : pattern)
+        {
+            const size_t idx = state * num_classes_ + byte_class_[static_cast<unsigned char>(c)];
+            if (transitions_[idx] == 0)
+            {
+                transitions_[idx] = static_cast<uint32_t>(depth_.size());
+                transitions_.resize(transitions_.size() + num_classes_, 0);
+                depth_.push_back(depth_[state] + 1);
+                longest_match_.push_back(kNoPattern);
+            }
+            state = transitions_[idx];
+        }
+
+        // Duplicated patterns report the first index
+        if (longest_match_[state] == kNoPattern)
+        {
+            longest_match_[state] = static_cast<uint32_t>(i);
+        }
+
+        const unsigned char first_byte = static_cast<unsigned char>(pattern[0]);
+        if (!is_first_byte_[first_byte])
+        {
+            is_first_byte_[first_byte] = true;
+            single_first_byte_ = first_byte;
+            num_first_bytes++;
+        }
+    }
+
+    if (num_first_bytes != 1)
+    {
+        single_first_byte_ = -1;
+    }
+
+    // Breadth first pass computing failure links, which turns the trie into a
+    // complete transition table. States are visited in order of depth, so the
+    // row of a failure state is always complete before it is used.
+    std::vector<uint32_t> failure(depth_.size(), 0);
+    std::vector<uint32_t> order;
+    order.reserve(depth_.size());
+
+    for (size_t c = 0; c < num_classes_; c++)
+    {
+        if (transitions_[c] != 0)
+        {
+            order.push_back(transitions_[c]);
+        }
+    }
+
+    for (size_t k = 0; k < order.size(); k++)
+    {
+        const uint32_t state = order[k];
+        const uint32_t fail = failure[state];
+
+        if (longest_match_[state] == kNoPattern)
+        {
+            longest_match_[state] = longest_match_[fail];
+        }
+
+        for (size_t c = 0; c < num_classes_; c++)
+        {
+            uint32_t &next = transitions_[state * num_classes_ + c];
+            if (next != 0)
+            {
+                failure[next] = transitions_[fail * num_classes_ + c];
+                order.push_back(next);
+            }
+            else
+            {
+                next = transitions_[fail * num_classes_ + c];
+            }
+        }
+    }
+}
+
+LUMOS_INLINE size_t MultiPatternMatcher::numPatterns() const
+{
+    return patterns_.size();
+}
+
+LUMOS_INLINE const std::string &MultiPatternMatcher::pattern(size_t pattern_index) const
+{
+    return patterns_.at(pattern_index);
+}
+
+LUMOS_INLINE size_t MultiPatternMatcher::skipToCandidate(std::string_view str, size_t pos) const
+{
+    if (single_first_byte_ >= 0)
+    {
+        const void *const found = std::memchr(str.data() + pos, single_first_byte_, str.size() - pos);
+        return found == nullptr ? str.size() : static_cast<size_t>(static_cast<const char *>(found) - str.data());
+    }
+
+    while ((pos < str.size()) && !is_first_byte_[static_cast<unsigned char>(str[pos])])
+    {
+        pos++;
+    }
+    return pos;
+}
+
+template <typename F> void MultiPatternMatcher::scan(std::string_view str, F &&on_match) const
+{
+    const size_t n = str.size();
+    uint32_t state = 0;
+    size_t pos = 0;
+
+    uint32_t candidate = kNoPattern;
+    size_t candidate_start = 0;
+    size_t candidate_length = 0;
+
+    // A candidate still pending at the end of the text is final. Scanning
+    // resumes after it, the text behind it may hold further matches
+    for (;;)
+    {
+        while (pos < n)
+        {
+            if (state == 0)
+            {
+                pos = skipToCandidate(str, pos);
+                if (pos == n)
+                {
+                    break;
+                }
+            }
+
+            state = transitions_[state * num_classes_ + byte_class_[static_cast<unsigned char>(str[pos])]];
+            pos++;
+
+            const uint32_t match = longest_match_[state];
+            if (match != kNoPattern)
+            {
+                const size_t length = patterns_[match].size();
+                const size_t start = pos - length;
+                if ((candidate == kNoPattern) || (start < candidate_start) ||
+                    ((start == candidate_start) && (length > candidate_length)))
+                {
+                    candidate = match;
+                    candidate_start = start;
+                    candidate_length = length;
+                }
+            }
+
+            // Once the current state no longer reaches back to the candidate, no
+            // earlier or longer match can show up and the candidate is final.
+            // Matches behind it were dropped while it was pending, so the bytes
+            // after its end, at most one longest pattern, are scanned again
+            if ((candidate != kNoPattern) && (pos - depth_[state] > candidate_start))
+            {
+                if (!on_match(candidate_start, candidate_length, static_cast<size_t>(candidate)))
+                {
+                    return;
+                }
+                pos = candidate_start + candidate_length;
+                state = 0;
+                candidate = kNoPattern;
+            }
+        }
+
+        if ((candidate == kNoPattern) ||
+            !on_match(candidate_start, candidate_length, static_cast<size_t>(candidate)))
+        {
+            return;
+        }
+        pos = candidate_start + candidate_length;
+        state = 0;
+        candidate = kNoPattern;
     }
+}
 
-    bool has_decimal = false;
-    for (size_t i = start; i < str.length(); ++i)
+LUMOS_INLINE bool MultiPatternMatcher::containsAny(std::string_view str) const
+{
+    // Any match will do, so the candidate bookkeeping of scan() is not needed
+    uint32_t state = 0;
+    size_t pos = 0;
+
+    while (pos < str.size())
     {
-        if (str[i] == '.')
+        if (state == 0)
         {
-            if (has_decimal)
+            pos = skipToCandidate(str, pos);
+            if (pos == str.size())
             {
-                return false; // Multiple decimal points
+                break;
             }
-            has_decimal = true;
         }
-        else if (!std::isdigit(str[i]))
+
+        state = transitions_[state * num_classes_ + byte_class_[static_cast<unsigned char>(str[pos])]];
+        if (longest_match_[state] != kNoPattern)
         {
-            return false;
+            return true;
         }
+        pos++;
+    }
+
+    return false;
+}
+
+LUMOS_INLINE size_t MultiPatternMatcher::countAll(std::string_view str) const
+{
+    size_t num_matches = 0;
+    scan(str, [&num_matches](size_t, size_t, size_t) {
+        num_matches++;
+        return true;
+    });
+    return num_matches;
+}
+
+LUMOS_INLINE std::vector<MultiPatternMatcher::Match> MultiPatternMatcher::findAll(std::string_view str) const
+{
+    std::vector<Match> matches;
+    scan(str, [&matches](size_t position, size_t length, size_t pattern_index) {
+        matches.push_back(Match{position, length, pattern_index});
+        return true;
+    });
+    return matches;
+}
+
+LUMOS_INLINE std::string MultiPatternMatcher::replaceAll(std::string_view str,
+                                                         const std::vector<std::string> &replacements) const
+{
+    if (replacements.size() != patterns_.size())
+    {
+        throw std::invalid_argument("Number of replacements must match the number of patterns");
     }
 
-    return start < str.length(); // Ensure we have at least one digit
+    std::string result;
+    result.reserve(str.size());
+    size_t start = 0;
+
+    scan(str, [&](size_t position, size_t length, size_t pattern_index) {
+        result.append(str.data() + start, position - start);
+        result += replacements[pattern_index];
+        start = position + length;
+        return true;
+    });
+    result.append(str.data() + start, str.size() - start);
+
+    return result;
 }
 
-LUMOS_INLINE bool isAlpha(const std::string &str)
+LUMOS_INLINE bool containsAny(std::string_view str, const std::vector<std::string> &patterns)
+{
+    return MultiPatternMatcher(patterns).containsAny(str);
+}
+
+LUMOS_INLINE size_t countAll(std::string_view str, const std::vector<std::string> &patterns)
+{
+    return MultiPatternMatcher(patterns).countAll(str);
+}
+
+LUMOS_INLINE std::string replaceAll(std::string_view str, const std::map<std::string, std::string> &replacements)
+{
+    std::vector<std::string> patterns;
+    std::vector<std::string> values;
+    patterns.reserve(replacements.size());
+    values.reserve(replacements.size());
+
+    for (const auto &replacement : replacements)
+    {
+        patterns.push_back(replacement.first);
+        values.push_back(replacement.second);
+    }
+
+    return MultiPatternMatcher(patterns).replaceAll(str, values);
+}
+
+// =============================================================================
+// STRING VALIDATION/CLASSIFICATION
+// =============================================================================
+
+LUMOS_INLINE bool isNumeric(std::string_view str)
+{
+    if (str.empty())
+    {
+        return false;
+    }
+
+    size_t start = 0;
+    if (str[0] == '+' || str[0] == '-')
+    {
+        start = 1;
+    }
+
+    // Digits, optionally followed by a decimal point and more digits
+    size_t pos = start + lumos::internal::countLeadingDigits(str.substr(start));
+    if (pos < str.length() && str[pos] == '.')
+    {
+        ++pos;
+        pos += lumos::internal::countLeadingDigits(str.substr(pos));
+    }
+
+    return (pos == str.length()) && (start < str.length()); // Ensure we have at least one digit
+}
+
+LUMOS_INLINE bool isAlpha(std::string_view str)
 {
     if (str.empty())
     {
@@ -358,7 +941,7 @@ LUMOS_INLINE bool isAlpha(const std::string &str)
                        { return std::isalpha(c); });
 }
 
-LUMOS_INLINE bool isAlphaNumeric(const std::string &str)
+LUMOS_INLINE bool isAlphaNumeric(std::string_view str)
 {
     if (str.empty())
     {
@@ -369,12 +952,12 @@ LUMOS_INLINE bool isAlphaNumeric(const std::string &str)
                        { return std::isalnum(c); });
 }
 
-LUMOS_INLINE bool isEmpty(const std::string &str)
+LUMOS_INLINE bool isEmpty(std::string_view str)
 {
     return str.empty();
 }
 
-LUMOS_INLINE bool isBlank(const std::string &str)
+LUMOS_INLINE bool isBlank(std::string_view str)
 {
     return std::all_of(str.begin(), str.end(), [](char c)
                        { return std::isspace(c); });
@@ -509,21 +1092,16 @@ LUMOS_INLINE std::string toTitleCase(const std::string &str)
 
     for (char &c : result)
     {
-        if (std::isalpha(c))
+        const unsigned char uc = static_cast<unsigned char>(c);
+        if (std::isalpha(uc))
         {
-            if (capitalize_next)
-            {
-                c = std::toupper(c);
-                capitalize_next = false;
-            }
-            else
-            {
-                c = std::tolower(c);
-            }
+            c = static_cast<char>(capitalize_next ? std::toupper(uc) : std::tolower(uc));
+            capitalize_next = false;
         }
         else
         {
-            capitalize_next = std::isspace(c);
+            // Words are separated by anything but letters and digits
+            capitalize_next = !std::isdigit(uc);
         }
     }
     return result;
@@ -0,0 +1,108 @@
+#ifndef STRING_INTERNER_H
+#define STRING_INTERNER_H
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class StringInterner;
+
+// Handle to a string owned by a StringInterner. Equal strings interned in the
+// same interner share storage, so comparing handles is a pointer compare. The
+// handle stays valid for the lifetime of the interner.
+class InternedString
+{
+public:
+    InternedString();
+
+    std::string_view view() const;
+    const char *c_str() const;
+    size_t size() const;
+    bool empty() const;
+    std::string str() const;
+    operator std::string_view() const;
+
+    bool operator==(const InternedString &other) const;
+    bool operator!=(const InternedString &other) const;
+
+private:
+    friend class StringInterner;
+    explicit InternedString(std::string_view view);
+
+    std::string_view view_;
+};
+
+// Thread safe pool of unique strings. Lookups of strings that are already in
+// the pool take no lock, only inserting a new string does.
+class StringInterner
+{
+public:
+    StringInterner();
+    StringInterner(const StringInterner &) = delete;
+    StringInterner &operator=(const StringInterner &) = delete;
+
+    InternedString intern(std::string_view str);
+    // Looks the string up without inserting it
+    std::optional<InternedString> find(std::string_view str) const;
+    size_t size() const;
+
+    // Process wide pool, used by default by the csv module
+    static StringInterner &global();
+
+private:
+    struct Entry
+    {
+        size_t hash;
+        std::string_view view;
+    };
+
+    // Open addressing hash table of entry pointers, a slot is only ever written
+    // once, from null to its final entry
+    struct Table
+    {
+        size_t mask;
+        std::unique_ptr<std::atomic<const Entry *>[]> slots;
+
+        explicit Table(size_t capacity);
+    };
+
+    static constexpr size_t kInitialCapacity = 64;
+    static constexpr size_t kBlockSize = 4096;
+
+    std::atomic<const Table *> table_;
+    std::atomic<size_t> size_;
+
+    // Everything below is only touched while holding mutex_. Tables replaced by
+    // a larger one are kept, as concurrent readers may still be using them.
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<Table>> tables_;
+    std::deque<Entry> entries_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char *block_position_;
+    size_t block_remaining_;
+
+    static const Entry *lookup(const Table &table, std::string_view str, size_t hash);
+    static void insert(const Table &table, const Entry *entry);
+    const char *storeChars(std::string_view str);
+    void grow();
+};
+
+namespace std
+{
+template <> struct hash<InternedString>
+{
+    size_t operator()(const InternedString &str) const
+    {
+        return std::hash<const char *>()(str.c_str());
+    }
+};
+} // namespace std
+
+#endif // STRING_INTERNER_H
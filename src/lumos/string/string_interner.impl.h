@@ -0,0 +1,218 @@
+#ifndef STRING_INTERNER_IMPL_H
+#define STRING_INTERNER_IMPL_H
+
+#include "lumos/string/string_interner.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef LUMOS_BUILD_FILE
+#define LUMOS_INLINE
+#else
+#define LUMOS_INLINE inline
+#endif
+
+// =============================================================================
+// INTERNED STRING
+// =============================================================================
+
+LUMOS_INLINE InternedString::InternedString()
+{
+    // One shared empty string, so default handles compare equal across translation units
+    static const char empty[1] = {'\0'};
+    view_ = std::string_view(empty, 0);
+}
+
+LUMOS_INLINE InternedString::InternedString(std::string_view view) : view_(view) {}
+
+LUMOS_INLINE std::string_view InternedString::view() const
+{
+    return view_;
+}
+
+LUMOS_INLINE const char *InternedString::c_str() const
+{
+    return view_.data();
+}
+
+LUMOS_INLINE size_t InternedString::size() const
+{
+    return view_.size();
+}
+
+LUMOS_INLINE bool InternedString::empty() const
+{
+    return view_.empty();
+}
+
+LUMOS_INLINE std::string InternedString::str() const
+{
+    return std::string(view_);
+}
+
+LUMOS_INLINE InternedString::operator std::string_view() const
+{
+    return view_;
+}
+
+LUMOS_INLINE bool InternedString::operator==(const InternedString &other) const
+{
+    return view_.data() == other.view_.data();
+}
+
+LUMOS_INLINE bool InternedString::operator!=(const InternedString &other) const
+{
+    return view_.data() != other.view_.data();
+}
+
+// =============================================================================
+// STRING INTERNER
+// =============================================================================
+
+LUMOS_INLINE StringInterner::Table::Table(size_t capacity)
+    : mask(capacity - 1), slots(new std::atomic<const Entry *>[capacity])
+{
+    for (size_t i = 0; i < capacity; ++i)
+    {
+        slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+LUMOS_INLINE StringInterner::StringInterner() : size_(0), block_position_(nullptr), block_remaining_(0)
+{
+    tables_.push_back(std::make_unique<Table>(kInitialCapacity));
+    table_.store(tables_.back().get(), std::memory_order_release);
+}
+
+LUMOS_INLINE StringInterner &StringInterner::global()
+{
+    static StringInterner interner;
+    return interner;
+}
+
+LUMOS_INLINE const StringInterner::Entry *StringInterner::lookup(const Table &table, std::string_view str, size_t hash)
+{
+    for (size_t idx = hash & table.mask;; idx = (idx + 1) & table.mask)
+    {
+        const Entry *const entry = table.slots[idx].load(std::memory_order_acquire);
+        if (entry == nullptr)
+        {
+            return nullptr;
+        }
+        if ((entry->hash == hash) && (entry->view == str))
+        {
+            return entry;
+        }
+    }
+}
+
+LUMOS_INLINE void StringInterner::insert(const Table &table, const Entry *entry)
+{
+    size_t idx = entry->hash & table.mask;
+    while (table.slots[idx].load(std::memory_order_relaxed) != nullptr)
+    {
+        idx = (idx + 1) & table.mask;
+    }
+    // Release, so a reader that sees the pointer also sees the entry
+    table.slots[idx].store(entry, std::memory_order_release);
+}
+
+LUMOS_INLINE const char *StringInterner::storeChars(std::string_view str)
+{
+    const size_t length = str.size() + 1; // Null terminated, so c_str() works
+
+    if (length > block_remaining_)
+    {
+        const size_t block_size = std::max(length, kBlockSize);
+        blocks_.push_back(std::unique_ptr<char[]>(new char[block_size]));
+        block_position_ = blocks_.back().get();
+        block_remaining_ = block_size;
+    }
+
+    char *const chars = block_position_;
+    std::memcpy(chars, str.data(), str.size());
+    chars[str.size()] = '\0';
+    block_position_ += length;
+    block_remaining_ -= length;
+
+    return chars;
+}
+
+LUMOS_INLINE void StringInterner::grow()
+{
+    const Table &old_table = *tables_.back();
+    tables_.push_back(std::make_unique<Table>(2 * (old_table.mask + 1)));
+    const Table &new_table = *tables_.back();
+
+    for (const Entry &entry : entries_)
+    {
+        insert(new_table, &entry);
+    }
+    table_.store(&new_table, std::memory_order_release);
+}
+
+LUMOS_INLINE std::optional<InternedString> StringInterner::find(std::string_view str) const
+{
+    if (str.empty())
+    {
+        return InternedString();
+    }
+
+    const size_t hash = std::hash<std::string_view>()(str);
+
+    if (const Entry *const entry = lookup(*table_.load(std::memory_order_acquire), str, hash))
+    {
+        return InternedString(entry->view);
+    }
+
+    // The table may have been replaced while it was searched, in which case
+    // recent insertions are only in the new one
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (const Entry *const entry = lookup(*tables_.back(), str, hash))
+    {
+        return InternedString(entry->view);
+    }
+    return std::nullopt;
+}
+
+LUMOS_INLINE InternedString StringInterner::intern(std::string_view str)
+{
+    if (str.empty())
+    {
+        return InternedString();
+    }
+
+    const size_t hash = std::hash<std::string_view>()(str);
+
+    // Fast path, no lock
+    if (const Entry *const entry = lookup(*table_.load(std::memory_order_acquire), str, hash))
+    {
+        return InternedString(entry->view);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Another thread may have inserted it in the meantime
+    if (const Entry *const entry = lookup(*tables_.back(), str, hash))
+    {
+        return InternedString(entry->view);
+    }
+
+    // Keep the load factor at or below one half
+    if (2 * (entries_.size() + 1) > tables_.back()->mask + 1)
+    {
+        grow();
+    }
+
+    entries_.push_back(Entry{hash, std::string_view(storeChars(str), str.size())});
+    insert(*tables_.back(), &entries_.back());
+    size_.store(entries_.size(), std::memory_order_relaxed);
+
+    return InternedString(entries_.back().view);
+}
+
+LUMOS_INLINE size_t StringInterner::size() const
+{
+    return size_.load(std::memory_order_relaxed);
+}
+
+#endif // STRING_INTERNER_IMPL_H
@@ -1,8 +1,12 @@
 #include <gtest/gtest.h>
+#include <map>
+#include <random>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "lumos/string/string.impl.h"
+#include "lumos/string/string_interner.impl.h"
 
 namespace lumos
 {
@@ -727,4 +731,392 @@ namespace lumos
         EXPECT_TRUE(endsWith(last_replaced, "xyz"));
     }
 
-} // namespace lumos
\ No newline at end of file
+    TEST_F(StringTest, TrimViews)
+    {
+        const std::string test = "  \thello world \n ";
+        EXPECT_EQ(trimView(test), "hello world");
+        EXPECT_EQ(ltrimView(test), "hello world \n ");
+        EXPECT_EQ(rtrimView(test), "  \thello world");
+        EXPECT_EQ(trimView("   "), "");
+        EXPECT_EQ(trimView(""), "");
+
+        // The views point into the original string
+        EXPECT_EQ(trimView(test).data(), test.data() + 3);
+    }
+
+    TEST_F(StringTest, SplitViewMatchesSplit)
+    {
+        const std::vector<std::string> inputs = {"a,b,c", "", ",", "a,,b,", ",a", "abc"};
+        const std::vector<std::string> delimiters = {",", "", ",,", "abc"};
+
+        std::vector<std::string_view> buffer;
+        for (const std::string &input : inputs)
+        {
+            for (const std::string &delimiter : delimiters)
+            {
+                const std::vector<std::string> expected = split(input, delimiter);
+
+                const std::vector<std::string_view> views = splitView(input, delimiter);
+                ASSERT_EQ(views.size(), expected.size());
+                ASSERT_EQ(splitInto(input, delimiter, buffer), expected.size());
+
+                std::vector<std::string> lazy;
+                for (const std::string_view token : splitLazy(input, delimiter))
+                {
+                    lazy.emplace_back(token);
+                }
+                ASSERT_EQ(lazy.size(), expected.size());
+
+                for (size_t i = 0; i < expected.size(); i++)
+                {
+                    EXPECT_EQ(views[i], expected[i]);
+                    EXPECT_EQ(buffer[i], expected[i]);
+                    EXPECT_EQ(lazy[i], expected[i]);
+                }
+            }
+        }
+    }
+
+    TEST_F(StringTest, SplitIntoReusesBuffer)
+    {
+        std::vector<std::string_view> tokens;
+        EXPECT_EQ(splitInto("a b c d", " ", tokens), 4U);
+        EXPECT_EQ(splitInto("x y", " ", tokens), 2U);
+        EXPECT_EQ(tokens[0], "x");
+        EXPECT_EQ(tokens[1], "y");
+    }
+
+    TEST_F(StringTest, SplitLazyIterator)
+    {
+        const std::string test = "one;two;three";
+        SplitRange range = splitLazy(test, ";");
+
+        SplitRange::Iterator it = range.begin();
+        EXPECT_EQ(*it, "one");
+        EXPECT_EQ(it->size(), 3U);
+        SplitRange::Iterator previous = it++;
+        EXPECT_EQ(*previous, "one");
+        EXPECT_EQ(*it, "two");
+        ++it;
+        EXPECT_EQ(*it, "three");
+        EXPECT_NE(it, range.end());
+        ++it;
+        EXPECT_EQ(it, range.end());
+        EXPECT_EQ(std::distance(range.begin(), range.end()), 3);
+    }
+
+    TEST_F(StringTest, JoinInto)
+    {
+        std::string result = "old content";
+        joinInto({"a", "b", "c"}, ", ", result);
+        EXPECT_EQ(result, "a, b, c");
+
+        joinInto({}, ", ", result);
+        EXPECT_EQ(result, "");
+
+        const std::string test = "x|y|z";
+        joinInto(splitView(test, "|"), "-", result);
+        EXPECT_EQ(result, "x-y-z");
+    }
+
+    TEST_F(StringTest, InPlaceVariants)
+    {
+        std::string test = "  Hello World  ";
+        trimInPlace(test);
+        EXPECT_EQ(test, "Hello World");
+
+        test = "  left";
+        ltrimInPlace(test);
+        EXPECT_EQ(test, "left");
+
+        test = "right  ";
+        rtrimInPlace(test);
+        EXPECT_EQ(test, "right");
+
+        test = "   ";
+        trimInPlace(test);
+        EXPECT_EQ(test, "");
+
+        test = "Hello World";
+        toLowerCaseInPlace(test);
+        EXPECT_EQ(test, "hello world");
+        toUpperCaseInPlace(test);
+        EXPECT_EQ(test, "HELLO WORLD");
+
+        test = "abc";
+        reverseInPlace(test);
+        EXPECT_EQ(test, "cba");
+    }
+
+    TEST_F(StringTest, ReplaceInPlaceMatchesReplace)
+    {
+        const std::vector<std::string> inputs = {"foo bar foo", "aaaa", "", "no match", "foofoo"};
+        const std::vector<std::pair<std::string, std::string>> replacements = {
+            {"foo", "x"}, {"foo", "foobar"}, {"a", ""}, {"aa", "b"}, {"", "x"}, {"o", "o"}};
+
+        for (const std::string &input : inputs)
+        {
+            for (const auto &r : replacements)
+            {
+                std::string in_place = input;
+                replaceInPlace(in_place, r.first, r.second);
+                EXPECT_EQ(in_place, replace(input, r.first, r.second));
+            }
+        }
+    }
+
+    TEST_F(StringTest, StringViewArguments)
+    {
+        const std::string str = "hello world";
+        const std::string_view view = str;
+
+        EXPECT_TRUE(contains(view, "world"));
+        EXPECT_TRUE(startsWith(view.substr(6), "wor"));
+        EXPECT_TRUE(endsWith(view, std::string("world")));
+        EXPECT_EQ(count(view, "o"), 2U);
+        EXPECT_EQ(find(view, "o", 5), 7U);
+        EXPECT_EQ(findLast(view, "o"), 7U);
+        EXPECT_TRUE(isAlpha(view.substr(0, 5)));
+        EXPECT_TRUE(isNumeric(std::string_view("123")));
+        EXPECT_TRUE(isBlank(trimView("   ")));
+    }
+
+    TEST_F(StringTest, MultiPatternContainsAny)
+    {
+        const MultiPatternMatcher matcher({"password", "token", "secret"});
+        EXPECT_EQ(matcher.numPatterns(), 3U);
+        EXPECT_EQ(matcher.pattern(1), "token");
+
+        EXPECT_TRUE(matcher.containsAny("user=alice token=abc"));
+        EXPECT_TRUE(matcher.containsAny("secret"));
+        EXPECT_FALSE(matcher.containsAny("user=alice tok=abc"));
+        EXPECT_FALSE(matcher.containsAny(""));
+
+        EXPECT_TRUE(containsAny("a needle in a haystack", {"pin", "needle"}));
+        EXPECT_FALSE(containsAny("a needle in a haystack", {}));
+        EXPECT_FALSE(containsAny("abc", {""}));
+    }
+
+    TEST_F(StringTest, MultiPatternFindAllLeftmostLongest)
+    {
+        const MultiPatternMatcher matcher({"he", "she", "hers", "his"});
+        const std::vector<MultiPatternMatcher::Match> matches = matcher.findAll("ushers and his");
+
+        ASSERT_EQ(matches.size(), 2U);
+        EXPECT_EQ(matches[0].position, 1U);
+        EXPECT_EQ(matches[0].length, 3U);
+        EXPECT_EQ(matches[0].pattern_index, 1U);
+        EXPECT_EQ(matches[1].position, 11U);
+        EXPECT_EQ(matches[1].pattern_index, 3U);
+
+        // Longest pattern wins at the same position, the leftmost wins across positions
+        const MultiPatternMatcher overlapping({"bc", "abcde", "ab", "cdef"});
+        const std::vector<MultiPatternMatcher::Match> m = overlapping.findAll("xabcdefg");
+        ASSERT_EQ(m.size(), 1U);
+        EXPECT_EQ(m[0].position, 1U);
+        EXPECT_EQ(m[0].pattern_index, 1U);
+    }
+
+    TEST_F(StringTest, MultiPatternMatchesSinglePattern)
+    {
+        const std::vector<std::string> texts = {"aaaaa", "abababa", "", "foo bar foo", "xyz"};
+        const std::vector<std::string> patterns = {"a", "aa", "aba", "foo", "z", "xyzw"};
+
+        for (const std::string &text : texts)
+        {
+            for (const std::string &pattern : patterns)
+            {
+                const MultiPatternMatcher matcher({pattern});
+                EXPECT_EQ(matcher.countAll(text), count(text, pattern));
+                EXPECT_EQ(matcher.replaceAll(text, {"#"}), replace(text, pattern, "#"));
+                EXPECT_EQ(matcher.containsAny(text), contains(text, pattern));
+            }
+        }
+    }
+
+    TEST_F(StringTest, MultiPatternCountAll)
+    {
+        EXPECT_EQ(countAll("the cat sat on the mat", {"at", "the"}), 5U);
+        EXPECT_EQ(countAll("aaaa", {"a", "aa"}), 2U);
+        EXPECT_EQ(countAll("", {"a"}), 0U);
+        EXPECT_EQ(countAll("abc", {}), 0U);
+    }
+
+    TEST_F(StringTest, MultiPatternReplaceAll)
+    {
+        const std::map<std::string, std::string> replacements = {
+            {"password=hunter2", "password=***"}, {"token", "[redacted]"}, {"a", "b"}, {"b", "a"}};
+
+        // A single pass, so replaced text is never matched again and the leftmost match wins
+        EXPECT_EQ(replaceAll("ab", replacements), "ba");
+        EXPECT_EQ(replaceAll("login password=hunter2 token", replacements), "login password=*** [redacted]");
+        EXPECT_EQ(replaceAll("", replacements), "");
+        EXPECT_EQ(replaceAll("xyz", {}), "xyz");
+
+        const MultiPatternMatcher matcher({"x", "y"});
+        EXPECT_THROW(matcher.replaceAll("xy", {"1"}), std::invalid_argument);
+    }
+
+    TEST_F(StringTest, MultiPatternMatchesAfterPendingCandidateAtEnd)
+    {
+        // "abcx" keeps the automaton deep in the text until the end, after
+        // the final "a" the scan has to resume for the "c"
+        const MultiPatternMatcher matcher({"abcx", "a", "c"});
+        EXPECT_EQ(matcher.countAll("abc"), 2U);
+        EXPECT_EQ(matcher.replaceAll("abc", {"X", "A", "C"}), "AbC");
+
+        const std::vector<MultiPatternMatcher::Match> matches = matcher.findAll("zabcab");
+        ASSERT_EQ(matches.size(), 3U);
+        EXPECT_EQ(matches[0].position, 1U);
+        EXPECT_EQ(matches[1].position, 3U);
+        EXPECT_EQ(matches[2].position, 4U);
+    }
+
+    TEST_F(StringTest, MultiPatternRandomAgainstBruteForce)
+    {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> letter(0, 3);
+        std::uniform_int_distribution<int> length(1, 4);
+
+        const auto random_string = [&](const size_t n) {
+            std::string str(n, 'a');
+            for (char &c : str)
+            {
+                c = static_cast<char>('a' + letter(rng));
+            }
+            return str;
+        };
+
+        for (size_t trial = 0; trial < 50; trial++)
+        {
+            std::vector<std::string> patterns;
+            for (size_t i = 0; i < 5; i++)
+            {
+                patterns.push_back(random_string(length(rng)));
+            }
+            const std::string text = random_string(200);
+
+            // Leftmost longest non overlapping matches, found the slow way
+            std::vector<MultiPatternMatcher::Match> expected;
+            size_t pos = 0;
+            while (pos < text.size())
+            {
+                size_t best_length = 0;
+                size_t best_index = 0;
+                for (size_t i = 0; i < patterns.size(); i++)
+                {
+                    if ((patterns[i].size() > best_length) && (text.compare(pos, patterns[i].size(), patterns[i]) == 0))
+                    {
+                        best_length = patterns[i].size();
+                        best_index = i;
+                    }
+                }
+                if (best_length > 0)
+                {
+                    expected.push_back(MultiPatternMatcher::Match{pos, best_length, best_index});
+                    pos += best_length;
+                }
+                else
+                {
+                    pos++;
+                }
+            }
+
+            const std::vector<MultiPatternMatcher::Match> matches = MultiPatternMatcher(patterns).findAll(text);
+            ASSERT_EQ(matches.size(), expected.size());
+            for (size_t i = 0; i < expected.size(); i++)
+            {
+                EXPECT_EQ(matches[i].position, expected[i].position);
+                EXPECT_EQ(matches[i].length, expected[i].length);
+                EXPECT_EQ(patterns[matches[i].pattern_index], patterns[expected[i].pattern_index]);
+            }
+        }
+    }
+
+    TEST_F(StringTest, InternerBasic)
+    {
+        StringInterner interner;
+        const std::string name = "velocity";
+
+        const InternedString a = interner.intern(name);
+        const InternedString b = interner.intern(std::string("velo") + "city");
+        const InternedString c = interner.intern("position");
+
+        EXPECT_EQ(a, b);
+        EXPECT_NE(a, c);
+        EXPECT_EQ(a.c_str(), b.c_str());
+        EXPECT_NE(a.c_str(), name.c_str());
+        EXPECT_EQ(a.view(), "velocity");
+        EXPECT_EQ(a.str(), name);
+        EXPECT_EQ(std::strlen(c.c_str()), c.size());
+        EXPECT_EQ(interner.size(), 2U);
+
+        EXPECT_EQ(interner.intern(""), InternedString());
+        EXPECT_TRUE(InternedString().empty());
+
+        ASSERT_TRUE(interner.find("position").has_value());
+        EXPECT_EQ(*interner.find("position"), c);
+        EXPECT_FALSE(interner.find("acceleration").has_value());
+        EXPECT_EQ(interner.size(), 2U);
+    }
+
+    TEST_F(StringTest, InternerGrowsAndKeepsHandles)
+    {
+        StringInterner interner;
+        std::vector<InternedString> handles;
+
+        for (size_t i = 0; i < 10000; i++)
+        {
+            handles.push_back(interner.intern("key_" + std::to_string(i)));
+        }
+        EXPECT_EQ(interner.size(), 10000U);
+
+        for (size_t i = 0; i < 10000; i++)
+        {
+            EXPECT_EQ(interner.intern("key_" + std::to_string(i)), handles[i]);
+            EXPECT_EQ(handles[i].view(), "key_" + std::to_string(i));
+        }
+        EXPECT_EQ(interner.size(), 10000U);
+
+        // A string longer than one storage block
+        const std::string long_string(10000, 'x');
+        EXPECT_EQ(interner.intern(long_string).view(), long_string);
+    }
+
+    TEST_F(StringTest, InternerConcurrent)
+    {
+        StringInterner interner;
+        constexpr size_t kNumThreads = 8;
+        constexpr size_t kNumStrings = 2000;
+
+        std::vector<std::vector<InternedString>> handles(kNumThreads);
+        std::vector<std::thread> threads;
+
+        for (size_t t = 0; t < kNumThreads; t++)
+        {
+            threads.emplace_back([&interner, &handles, t]() {
+                // Every thread interns the same strings, starting at different offsets
+                for (size_t i = 0; i < kNumStrings; i++)
+                {
+                    const size_t k = (i + t * 250) % kNumStrings;
+                    handles[t].push_back(interner.intern("field_" + std::to_string(k)));
+                }
+            });
+        }
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+
+        EXPECT_EQ(interner.size(), kNumStrings);
+        for (size_t i = 0; i < kNumStrings; i++)
+        {
+            const InternedString expected = *interner.find("field_" + std::to_string(i));
+            for (size_t t = 0; t < kNumThreads; t++)
+            {
+                EXPECT_EQ(handles[t][(i + kNumStrings - (t * 250) % kNumStrings) % kNumStrings], expected);
+            }
+        }
+    }
+
+} // namespace lumos
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+#include "lumos/math/fft/fft2d.impl.h"
+#include "lumos/math/fft/stft.impl.h"
+#include "lumos/math/math.h"
+
+namespace lumos
+{
+
+    struct PhaseCorrelationResult
+    {
+        double dx;       // Shift along the columns, in pixels
+        double dy;       // Shift along the rows, in pixels
+        double response; // Height of the correlation peak, close to 1 for a pure translation
+    };
+
+    namespace internal
+    {
+        // Offset of the vertex of the parabola through (-1, left), (0, center), (1, right)
+        inline double parabolaPeakOffset(const double left, const double center, const double right)
+        {
+            const double curvature = left - 2.0 * center + right;
+            if (curvature >= 0.0)
+            {
+                return 0.0;
+            }
+            return std::max(-0.5, std::min(0.5, 0.5 * (left - right) / curvature));
+        }
+    } // namespace internal
+
+    // Estimates the translation between two equally sized images by phase
+    // correlation, such that image(r, c) ~ reference(r - dy, c - dx). Both images
+    // are multiplied by a Hann window against edge effects and zero-padded to
+    // powers of 2, then transformed together in one complex 2D FFT. The integer
+    // peak of the correlation surface is refined to sub-pixel accuracy with a
+    // parabola fit along each axis. Shifts must be less than half the padded size
+    template <typename T>
+    PhaseCorrelationResult phaseCorrelate(const T *const reference, const T *const image,
+                                          const size_t num_rows, const size_t num_cols,
+                                          const bool apply_window = true, const size_t num_threads = 0)
+    {
+        ASSERT((num_rows > 0U) && (num_cols > 0U)) << "Cannot correlate empty images!";
+
+        const size_t padded_rows = fft::next_power_of_2(num_rows);
+        const size_t padded_cols = fft::next_power_of_2(num_cols);
+
+        const RealVector window_rows = fft::make_window(
+            apply_window ? fft::WindowType::Hann : fft::WindowType::Rectangular, num_rows, false);
+        const RealVector window_cols = fft::make_window(
+            apply_window ? fft::WindowType::Hann : fft::WindowType::Rectangular, num_cols, false);
+
+        ComplexVector work(padded_rows * padded_cols, Complex(0.0, 0.0));
+        for (size_t r = 0; r < num_rows; ++r)
+        {
+            for (size_t c = 0; c < num_cols; ++c)
+            {
+                const double w = window_rows[r] * window_cols[c];
+                work[r * padded_cols + c] = Complex(w * static_cast<double>(reference[r * num_cols + c]),
+                                                    w * static_cast<double>(image[r * num_cols + c]));
+            }
+        }
+        fft::fft2d(work.data(), padded_rows, padded_cols, false, num_threads);
+
+        // Normalized cross-power spectrum conj(A) * B / |conj(A) * B|, with the
+        // spectra of the two real images separated by conjugate symmetry
+        ComplexVector cross(work.size());
+        for (size_t r = 0; r < padded_rows; ++r)
+        {
+            const size_t r_neg = (padded_rows - r) & (padded_rows - 1);
+            for (size_t c = 0; c < padded_cols; ++c)
+            {
+                const size_t c_neg = (padded_cols - c) & (padded_cols - 1);
+                const Complex z = work[r * padded_cols + c];
+                const Complex z_conj = std::conj(work[r_neg * padded_cols + c_neg]);
+
+                const Complex a = 0.5 * (z + z_conj);
+                const Complex b = Complex(0.0, -0.5) * (z - z_conj);
+                const Complex product = std::conj(a) * b;
+                const double magnitude = std::abs(product);
+
+                cross[r * padded_cols + c] = magnitude > 0.0 ? product / magnitude : Complex(0.0, 0.0);
+            }
+        }
+        fft::fft2d(cross.data(), padded_rows, padded_cols, true, num_threads);
+
+        size_t peak_idx = 0;
+        for (size_t i = 1; i < cross.size(); ++i)
+        {
+            if (cross[i].real() > cross[peak_idx].real())
+            {
+                peak_idx = i;
+            }
+        }
+
+        const size_t peak_r = peak_idx / padded_cols;
+        const size_t peak_c = peak_idx % padded_cols;
+        const auto value = [&](const size_t r, const size_t c)
+        { return cross[(r & (padded_rows - 1)) * padded_cols + (c & (padded_cols - 1))].real(); };
+
+        const double peak = value(peak_r, peak_c);
+        const double offset_r = internal::parabolaPeakOffset(
+            value(peak_r + padded_rows - 1, peak_c), peak, value(peak_r + 1, peak_c));
+        const double offset_c = internal::parabolaPeakOffset(
+            value(peak_r, peak_c + padded_cols - 1), peak, value(peak_r, peak_c + 1));
+
+        // Peaks in the upper half of the circular surface are negative shifts
+        const double shift_r = peak_r < padded_rows / 2 ? static_cast<double>(peak_r)
+                                                        : static_cast<double>(peak_r) - static_cast<double>(padded_rows);
+        const double shift_c = peak_c < padded_cols / 2 ? static_cast<double>(peak_c)
+                                                        : static_cast<double>(peak_c) - static_cast<double>(padded_cols);
+
+        return {shift_c + offset_c, shift_r + offset_r, peak};
+    }
+
+    template <typename T>
+    PhaseCorrelationResult phaseCorrelate(const ImageGray<T> &reference, const ImageGray<T> &image,
+                                          const bool apply_window = true, const size_t num_threads = 0)
+    {
+        ASSERT((reference.numRows() == image.numRows()) && (reference.numCols() == image.numCols()))
+            << "Images must have the same size!";
+        return phaseCorrelate(reference.data(), image.data(), image.numRows(), image.numCols(),
+                              apply_window, num_threads);
+    }
+
+    template <typename T>
+    PhaseCorrelationResult phaseCorrelate(const Matrix<T> &reference, const Matrix<T> &image,
+                                          const bool apply_window = true, const size_t num_threads = 0)
+    {
+        ASSERT((reference.numRows() == image.numRows()) && (reference.numCols() == image.numCols()))
+            << "Images must have the same size!";
+        return phaseCorrelate(reference.data(), image.data(), image.numRows(), image.numCols(),
+                              apply_window, num_threads);
+    }
+
+} // namespace lumos